@@ -65,6 +65,11 @@
 // If no argument is passed to this function, then the second option   //
 // is used.                                                            //
 //                                                                     //
+// Unless smoothing is used, the iterations and the correlated error   //
+// calculation are performed by AliCFUnfoldingEngine on flat arrays,   //
+// and the randomized distributions are unfolded in ::SetNThreads      //
+// threads. ::UseMatrixEngine(kFALSE) falls back to the THnSparse code //
+//                                                                     //
 // IMPORTANT:                                                          //
 //-----------                                                          //
 // With this approach, the efficiency map must be calculated           //
@@ -85,6 +90,7 @@
 
 
 #include "AliCFUnfolding.h"
+#include "AliCFUnfoldingEngine.h"
 #include "TMath.h"
 #include "TAxis.h"
 #include "TF1.h"
@@ -130,7 +136,10 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fUseMatrixEngine(kTRUE),
+  fNThreads(1),
+  fEngine(0x0)
 {
   //
   // default constructor
@@ -174,7 +183,10 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fUseMatrixEngine(kTRUE),
+  fNThreads(1),
+  fEngine(0x0)
 {
   //
   // named constructor
@@ -239,6 +251,7 @@ AliCFUnfolding::~AliCFUnfolding() {
   if (fRandom3)            delete fRandom3;
   if (fDeltaUnfoldedP)     delete fDeltaUnfoldedP;
   if (fDeltaUnfoldedN)     delete fDeltaUnfoldedN;
+  if (fEngine)             delete fEngine;
  
 }
 
@@ -350,6 +363,11 @@ void AliCFUnfolding::Unfold() {
   // several iterations are performed until a reasonable chi2 or convergence criterion is reached
   //
 
+  if (fUseMatrixEngine && !fUseSmoothing && fNCalcCorrErrors == 0) {
+    UnfoldWithEngine();
+    return;
+  }
+
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
@@ -504,6 +522,133 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
   fNCalcCorrErrors = 2;
 }
 
+//______________________________________________________________
+
+void AliCFUnfolding::UnfoldWithEngine() {
+  //
+  // Same as Unfold() followed by CalculateCorrelatedErrors(), using AliCFUnfoldingEngine :
+  // the conditional matrix is flattened once, the spectra are handled as arrays
+  // and only the results are filled back in the THnSparse objects
+  //
+
+  if (!fEngine) {
+    fEngine = new AliCFUnfoldingEngine();
+    fEngine->Build(fConditional,fNVariables,fPriorOrig);
+  }
+
+  std::vector<Double_t> measured, efficiency, prior, unfolded, estMeasured, inverse;
+  fEngine->FillMeasured(fMeasured,measured);
+  fEngine->FillTrue(fEfficiency,efficiency);
+  fEngine->FillTrue(fPrior,prior);
+  fEngine->FillEntries(fInverseResponse,inverse);
+
+  Double_t convergence = 0.;
+  Int_t iIterBayes = fEngine->Unfold(measured,efficiency,prior,unfolded,estMeasured,inverse,fMaxNumIterations,fMaxConvergence,convergence);
+  AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes<fMaxNumIterations ? iIterBayes : fMaxNumIterations-1,convergence));
+  if (iIterBayes < fMaxNumIterations) {
+    fNRandomIterations = iIterBayes;
+    AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+  }
+
+  fEngine->ExportTrue(unfolded,fUnfolded);
+  fEngine->ExportTrue(prior,fPrior);
+  fEngine->ExportMeasured(estMeasured,fMeasuredEstimate);
+  fEngine->ExportEntries(inverse,fInverseResponse);
+  fUnfoldedFinal = (THnSparse*) fUnfolded->Clone() ;
+
+  AliInfo("\n================================================\nFinished bayes iteration, now calculating errors...\n================================================\n");
+  fNCalcCorrErrors = 1;
+  CalculateCorrelatedErrorsWithEngine(unfolded,inverse);
+
+  AliInfo(Form("\n\n=======================\nFinished at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::CalculateCorrelatedErrorsWithEngine(const std::vector<Double_t>& unfolded, const std::vector<Double_t>& inverse) {
+  //
+  // Same as CalculateCorrelatedErrors(), using AliCFUnfoldingEngine.
+  // The randomized distributions are generated in the same order as by CreateRandomizedDist()
+  // (the randomized response is generated but, as in CalculateCorrelatedErrors(), not used since the
+  // conditional matrix is not recomputed), and are unfolded by groups of fNThreads in parallel.
+  // Each of them starts from the original prior and from the inverse response of the main unfolding.
+  // The internal THnSparse objects (prior, measured, efficiency...) keep the state of the main unfolding.
+  //
+
+  std::vector<Double_t> priorOrig;
+  fEngine->FillTrue(fPriorOrig,priorOrig);
+
+  // position of the bins of the original spectra in the arrays of the engine
+  std::vector<Int_t> coord(fNVariables);
+  std::vector<Int_t> efficiencyIndex(fEfficiencyOrig->GetNbins());
+  for (Long_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+    fEfficiencyOrig->GetBinContent(iBin,&coord[0]);
+    efficiencyIndex[iBin] = fEngine->FindTrue(&coord[0]);
+  }
+  std::vector<Int_t> measuredIndex(fMeasuredOrig->GetNbins());
+  for (Long_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+    fMeasuredOrig->GetBinContent(iBin,&coord[0]);
+    measuredIndex[iBin] = fEngine->FindMeasured(&coord[0]);
+  }
+
+  const Int_t nThreads = fNThreads > 1 ? fNThreads : 1;
+  std::vector<AliCFUnfoldingEngine::Toy> toys(nThreads);
+  std::vector<Double_t> sumDelta(unfolded.size(),0.), sumDelta2(unfolded.size(),0.);
+
+  for (Int_t first=0; first<fNRandomIterations; first+=nThreads) {
+    Int_t nToys = TMath::Min(nThreads,fNRandomIterations-first);
+
+    for (Int_t iToy=0; iToy<nToys; iToy++) {
+      AliCFUnfoldingEngine::Toy& toy = toys[iToy];
+      for (Long_t iBin=0; iBin<fResponseOrig->GetNbins(); iBin++) {
+	fRandom3->Gaus(fResponseOrig->GetBinContent(iBin),fResponseOrig->GetBinError(iBin));
+      }
+      toy.fEfficiency.assign(unfolded.size(),0.);
+      for (Long_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+	Double_t ran = fRandom3->Gaus(fEfficiencyOrig->GetBinContent(iBin),fEfficiencyOrig->GetBinError(iBin));
+	if (efficiencyIndex[iBin] >= 0) toy.fEfficiency[efficiencyIndex[iBin]] = ran;
+      }
+      toy.fMeasured.assign(fEngine->GetNMeasured(),0.);
+      for (Long_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+	Double_t ran = fRandom3->Gaus(fMeasuredOrig->GetBinContent(iBin),fMeasuredOrig->GetBinError(iBin));
+	if (measuredIndex[iBin] >= 0) toy.fMeasured[measuredIndex[iBin]] = ran;
+      }
+    }
+
+    fEngine->UnfoldToys(toys,nToys,priorOrig,inverse,fMaxNumIterations,nThreads);
+
+    // accumulate in the order of the randomized distributions
+    for (Int_t iToy=0; iToy<nToys; iToy++) {
+      for (UInt_t t=0; t<unfolded.size(); t++) {
+	if (!(unfolded[t] > 0.)) continue;
+	Double_t delta = unfolded[t] - toys[iToy].fUnfolded[t];
+	sumDelta[t]  += delta;
+	sumDelta2[t] += delta*delta;
+      }
+    }
+  }
+
+  // fill the delta profile and the errors of the final unfolded spectrum
+  Double_t entriesInBin = fNRandomIterations;
+  for (Long_t iBin=0; iBin<fUnfoldedFinal->GetNbins(); iBin++) {
+    fUnfoldedFinal->GetBinContent(iBin,&coord[0]);
+    Int_t t = fEngine->FindTrue(&coord[0]);
+    Double_t mean = 0., meanx2 = 0., sigma = 0.;
+    if (t >= 0 && entriesInBin > 0.) {
+      mean   = sumDelta[t]  / entriesInBin;
+      meanx2 = sumDelta2[t] / entriesInBin;
+      fDeltaUnfoldedP->SetBinError  (&coord[0],meanx2);
+      fDeltaUnfoldedP->SetBinContent(&coord[0],mean);
+      fDeltaUnfoldedN->SetBinContent(&coord[0],entriesInBin);
+    }
+    if (entriesInBin > 1.) sigma = TMath::Sqrt((entriesInBin/(entriesInBin-1.))*TMath::Abs(meanx2-mean*mean));
+    fUnfoldedFinal->SetBinError(&coord[0],sigma);
+  }
+
+  // now errors are calculated
+  fNCalcCorrErrors = 2;
+}
+
 //______________________________________________________________
 void AliCFUnfolding::CreateRandomizedDist() {
   //
@@ -10,12 +10,14 @@
 // Author : renaud.vernet@cern.ch                                     //
 //--------------------------------------------------------------------//
 
+#include <vector>
 #include "TNamed.h"
 #include "THnSparse.h"
 #include "AliLog.h"
 
 class TF1;
 class TRandom3;
+class AliCFUnfoldingEngine;
 
 class AliCFUnfolding : public TNamed {
 
@@ -36,6 +38,8 @@ class AliCFUnfolding : public TNamed {
   }
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
+  void UseMatrixEngine(Bool_t b = kTRUE)   {fUseMatrixEngine = b;}   // flat-array unfolding (AliCFUnfoldingEngine), not used with smoothing
+  void SetNThreads(Int_t n = 1)            {fNThreads = n;}          // number of threads unfolding the randomized distributions (matrix engine only)
 
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
@@ -112,6 +116,10 @@ class AliCFUnfolding : public TNamed {
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
 
+  Bool_t         fUseMatrixEngine;   // Use the flat-array unfolding engine (default kTRUE)
+  Int_t          fNThreads;          // Number of threads for the correlated error calculation
+  AliCFUnfoldingEngine *fEngine;     //! Conditional matrix flattened for the unfolding engine
+
 
   // functions
   void     Init();                  // initialisation of the internal settings
@@ -132,7 +140,11 @@ class AliCFUnfolding : public TNamed {
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  /* unfolding engine */
+  void     UnfoldWithEngine();                 // Unfold() and CalculateCorrelatedErrors() using AliCFUnfoldingEngine
+  void     CalculateCorrelatedErrorsWithEngine(const std::vector<Double_t>& unfolded, const std::vector<Double_t>& inverse);
+
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
@@ -0,0 +1,374 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//---------------------------------------------------------------------//
+//                                                                     //
+// AliCFUnfoldingEngine Class                                          //
+//                                                                     //
+// Performs the bayesian iterations of AliCFUnfolding on flat arrays.  //
+// The conditional matrix P(M|T) is stored once in compressed sparse   //
+// row format (one row per measured bin), the spectra as arrays        //
+// indexed by the measured or true bins present in the response        //
+// matrix (plus the bins of the prior).                                //
+// Each iteration is then a few loops over the non-empty entries of    //
+// the matrix, with the same operations as the THnSparse based code    //
+// of AliCFUnfolding (same treatment of empty and negative bins).      //
+//                                                                     //
+// Unfold() does not modify the engine and can be called from several //
+// threads : UnfoldToys() unfolds the randomized distributions used    //
+// for the correlated errors in parallel.                              //
+//                                                                     //
+//---------------------------------------------------------------------//
+
+#include <algorithm>
+#include <thread>
+
+#include "AliCFUnfoldingEngine.h"
+#include "THnSparse.h"
+#include "TAxis.h"
+
+ClassImp(AliCFUnfoldingEngine)
+
+//______________________________________________________________
+
+AliCFUnfoldingEngine::AliCFUnfoldingEngine() :
+  fNVariables(0),
+  fMeasuredStrides(),
+  fTrueStrides(),
+  fMeasuredKeys(),
+  fTrueKeys(),
+  fRowStart(),
+  fColumn(),
+  fConditional()
+{
+  //
+  // default constructor
+  //
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingEngine::Build(const THnSparse* conditional, Int_t nVar, const THnSparse* prior) {
+  //
+  // flattens the conditional matrix (dimensions 0 -> N-1 : measured, N -> 2N-1 : true)
+  // the true bins of the prior are added to the true space, since they enter the convergence criterion
+  //
+
+  fNVariables = nVar;
+  fMeasuredStrides.resize(nVar);
+  fTrueStrides.resize(nVar);
+  Long64_t strideM = 1, strideT = 1;
+  for (Int_t iVar=0; iVar<nVar; iVar++) {
+    fMeasuredStrides[iVar] = strideM;
+    fTrueStrides[iVar]     = strideT;
+    strideM *= conditional->GetAxis(iVar)     ->GetNbins() + 2;
+    strideT *= conditional->GetAxis(iVar+nVar)->GetNbins() + 2;
+  }
+
+  const Long64_t nBins = conditional->GetNbins();
+  std::vector<Long64_t> keysM(nBins), keysT(nBins);
+  std::vector<Double_t> values(nBins);
+  std::vector<Int_t> coord(2*nVar);
+  for (Long64_t iBin=0; iBin<nBins; iBin++) {
+    values[iBin] = conditional->GetBinContent(iBin,&coord[0]);
+    keysM[iBin]  = Key(fMeasuredStrides,&coord[0]);
+    keysT[iBin]  = Key(fTrueStrides,&coord[nVar]);
+  }
+
+  fMeasuredKeys = keysM;
+  fTrueKeys     = keysT;
+  if (prior) {
+    for (Long64_t iBin=0; iBin<prior->GetNbins(); iBin++) {
+      prior->GetBinContent(iBin,&coord[0]);
+      fTrueKeys.push_back(Key(fTrueStrides,&coord[0]));
+    }
+  }
+  std::sort(fMeasuredKeys.begin(),fMeasuredKeys.end());
+  fMeasuredKeys.erase(std::unique(fMeasuredKeys.begin(),fMeasuredKeys.end()),fMeasuredKeys.end());
+  std::sort(fTrueKeys.begin(),fTrueKeys.end());
+  fTrueKeys.erase(std::unique(fTrueKeys.begin(),fTrueKeys.end()),fTrueKeys.end());
+
+  // order the entries by measured bin, then by true bin
+  std::vector<std::pair<Long64_t,Long64_t> > order(nBins);
+  for (Long64_t iBin=0; iBin<nBins; iBin++) {
+    Long64_t row = Find(fMeasuredKeys,keysM[iBin]);
+    Long64_t col = Find(fTrueKeys,keysT[iBin]);
+    order[iBin] = std::make_pair(row*(Long64_t)fTrueKeys.size()+col,iBin);
+  }
+  std::sort(order.begin(),order.end());
+
+  fRowStart.assign(fMeasuredKeys.size()+1,0);
+  fColumn.resize(nBins);
+  fConditional.resize(nBins);
+  for (Long64_t k=0; k<nBins; k++) {
+    Long64_t row = order[k].first / (Long64_t)fTrueKeys.size();
+    fColumn[k]      = order[k].first % (Long64_t)fTrueKeys.size();
+    fConditional[k] = values[order[k].second];
+    fRowStart[row+1]++;
+  }
+  for (UInt_t m=0; m<fMeasuredKeys.size(); m++) fRowStart[m+1] += fRowStart[m];
+}
+
+//______________________________________________________________
+
+Long64_t AliCFUnfoldingEngine::Key(const std::vector<Long64_t>& strides, const Int_t* coord) {
+  //
+  // linear index of a bin from its coordinates
+  //
+  Long64_t key = 0;
+  for (UInt_t i=0; i<strides.size(); i++) key += coord[i] * strides[i];
+  return key;
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingEngine::Decode(const std::vector<Long64_t>& strides, Long64_t key, Int_t* coord) {
+  //
+  // coordinates of a bin from its linear index
+  //
+  for (Int_t i=strides.size()-1; i>=0; i--) {
+    coord[i] = key / strides[i];
+    key     %= strides[i];
+  }
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfoldingEngine::Find(const std::vector<Long64_t>& keys, Long64_t key) {
+  //
+  // position of a linear index in a sorted list, -1 if not found
+  //
+  std::vector<Long64_t>::const_iterator it = std::lower_bound(keys.begin(),keys.end(),key);
+  if (it == keys.end() || *it != key) return -1;
+  return it - keys.begin();
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfoldingEngine::FindEntry(Int_t measured, Int_t trueBin) const {
+  //
+  // entry of the matrix for a (measured,true) pair, -1 if empty
+  //
+  if (measured < 0 || trueBin < 0) return -1;
+  std::vector<Int_t>::const_iterator begin = fColumn.begin() + fRowStart[measured];
+  std::vector<Int_t>::const_iterator end   = fColumn.begin() + fRowStart[measured+1];
+  std::vector<Int_t>::const_iterator it    = std::lower_bound(begin,end,trueBin);
+  if (it == end || *it != trueBin) return -1;
+  return it - fColumn.begin();
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingEngine::FillMeasured(const THnSparse* h, std::vector<Double_t>& v) const {
+  //
+  // copies the content of a spectrum in measured space, bins outside the response matrix are ignored
+  //
+  v.assign(GetNMeasured(),0.);
+  std::vector<Int_t> coord(fNVariables);
+  for (Long64_t iBin=0; iBin<h->GetNbins(); iBin++) {
+    Double_t content = h->GetBinContent(iBin,&coord[0]);
+    Int_t index = FindMeasured(&coord[0]);
+    if (index >= 0) v[index] = content;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingEngine::FillTrue(const THnSparse* h, std::vector<Double_t>& v) const {
+  //
+  // copies the content of a spectrum in true space, bins outside the response matrix and the prior are ignored
+  //
+  v.assign(GetNTrue(),0.);
+  std::vector<Int_t> coord(fNVariables);
+  for (Long64_t iBin=0; iBin<h->GetNbins(); iBin++) {
+    Double_t content = h->GetBinContent(iBin,&coord[0]);
+    Int_t index = FindTrue(&coord[0]);
+    if (index >= 0) v[index] = content;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingEngine::FillEntries(const THnSparse* h, std::vector<Double_t>& v) const {
+  //
+  // copies the content of a matrix in (measured,true) space, bins outside the response matrix are ignored
+  //
+  v.assign(GetNEntries(),0.);
+  std::vector<Int_t> coord(2*fNVariables);
+  for (Long64_t iBin=0; iBin<h->GetNbins(); iBin++) {
+    Double_t content = h->GetBinContent(iBin,&coord[0]);
+    Int_t entry = FindEntry(FindMeasured(&coord[0]),FindTrue(&coord[fNVariables]));
+    if (entry >= 0) v[entry] = content;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingEngine::ExportMeasured(const std::vector<Double_t>& v, THnSparse* h) const {
+  //
+  // resets the spectrum and fills the positive bins, with error 0
+  //
+  h->Reset();
+  std::vector<Int_t> coord(fNVariables);
+  for (Int_t m=0; m<GetNMeasured(); m++) {
+    if (!(v[m] > 0.)) continue;
+    Decode(fMeasuredStrides,fMeasuredKeys[m],&coord[0]);
+    h->SetBinContent(&coord[0],v[m]);
+    h->SetBinError  (&coord[0],0.);
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingEngine::ExportTrue(const std::vector<Double_t>& v, THnSparse* h) const {
+  //
+  // resets the spectrum and fills the positive bins, with error 0
+  //
+  h->Reset();
+  std::vector<Int_t> coord(fNVariables);
+  for (Int_t t=0; t<GetNTrue(); t++) {
+    if (!(v[t] > 0.)) continue;
+    Decode(fTrueStrides,fTrueKeys[t],&coord[0]);
+    h->SetBinContent(&coord[0],v[t]);
+    h->SetBinError  (&coord[0],0.);
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingEngine::ExportEntries(const std::vector<Double_t>& v, THnSparse* h) const {
+  //
+  // sets all the entries of a matrix in (measured,true) space, with error 0
+  //
+  std::vector<Int_t> coord(2*fNVariables);
+  for (Int_t m=0; m<GetNMeasured(); m++) {
+    Decode(fMeasuredStrides,fMeasuredKeys[m],&coord[0]);
+    for (Int_t k=fRowStart[m]; k<fRowStart[m+1]; k++) {
+      Decode(fTrueStrides,fTrueKeys[fColumn[k]],&coord[fNVariables]);
+      h->SetBinContent(&coord[0],v[k]);
+      h->SetBinError  (&coord[0],0.);
+    }
+  }
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfoldingEngine::Unfold(const std::vector<Double_t>& measured, const std::vector<Double_t>& efficiency,
+				  std::vector<Double_t>& prior, std::vector<Double_t>& unfolded, std::vector<Double_t>& estMeasured,
+				  std::vector<Double_t>& inverse, Int_t maxNumIterations, Double_t maxConvergence, Double_t& convergence) const {
+  //
+  // Bayesian iterations, as AliCFUnfolding::Unfold() :
+  //
+  // --> M(i)     = SUM_k { COND(i,k) * T(k) * E(k) }             (estimated measured spectrum)
+  // --> INV(i,j) = COND(i,j) * T(j) * E(j) / M(i)                 (inverse response)
+  // --> U(j)     = SUM_i { INV(i,j) * MEAS(i) } / E(j)            (unfolded spectrum)
+  //
+  // only the positive terms enter the sums, and an entry of INV keeps its previous value if both
+  // the new and the previous values are not positive.
+  // The iterations stop when the convergence criterion is below maxConvergence (if > 0), otherwise
+  // the prior is replaced by the unfolded spectrum for the next iteration.
+  // "inverse" holds the inverse response of the previous iteration in input.
+  // Returns the iteration at which the convergence was met, maxNumIterations if it was not.
+  //
+
+  const Int_t nMeasured = GetNMeasured();
+  const Int_t nTrue     = GetNTrue();
+  const Int_t nEntries  = GetNEntries();
+
+  std::vector<Double_t> priorTimesEff(nTrue);
+  std::vector<Double_t> weight(nEntries);
+  estMeasured.assign(nMeasured,0.);
+  unfolded.assign(nTrue,0.);
+  convergence = 0.;
+
+  const Int_t*    column = nEntries > 0 ? &fColumn[0]      : 0;
+  const Double_t* cond   = nEntries > 0 ? &fConditional[0] : 0;
+  Double_t*       inv    = nEntries > 0 ? &inverse[0]      : 0;
+  Double_t*       w      = nEntries > 0 ? &weight[0]       : 0;
+
+  Int_t iIterBayes = 0;
+  for (iIterBayes=0; iIterBayes<maxNumIterations; iIterBayes++) {
+
+    for (Int_t t=0; t<nTrue; t++) priorTimesEff[t] = prior[t] * efficiency[t];
+    for (Int_t k=0; k<nEntries; k++) w[k] = cond[k] * priorTimesEff[column[k]];
+
+    // estimated measured spectrum and inverse response
+    for (Int_t m=0; m<nMeasured; m++) {
+      Double_t est = 0.;
+      for (Int_t k=fRowStart[m]; k<fRowStart[m+1]; k++) if (w[k]>0.) est += w[k];
+      estMeasured[m] = est;
+      for (Int_t k=fRowStart[m]; k<fRowStart[m+1]; k++) {
+	Double_t fill = (est>0. ? w[k] / est : 0.);
+	if (fill>0. || inv[k]>0.) inv[k] = fill;
+      }
+    }
+
+    // unfolded spectrum
+    std::fill(unfolded.begin(),unfolded.end(),0.);
+    for (Int_t m=0; m<nMeasured; m++) {
+      const Double_t meas = measured[m];
+      for (Int_t k=fRowStart[m]; k<fRowStart[m+1]; k++) {
+	const Double_t eff = efficiency[column[k]];
+	Double_t fill = (eff>0. ? inv[k] * meas / eff : 0.);
+	if (fill>0.) unfolded[column[k]] += fill;
+      }
+    }
+
+    // convergence criterion
+    convergence = 0.;
+    for (Int_t t=0; t<nTrue; t++) {
+      if (prior[t] > 0.) convergence += ((prior[t]-unfolded[t])/prior[t])*((prior[t]-unfolded[t])/prior[t]);
+    }
+
+    if (maxConvergence>0. && convergence<maxConvergence) break;
+
+    // update the prior distribution
+    prior = unfolded;
+  }
+
+  return iIterBayes;
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingEngine::UnfoldToy(const AliCFUnfoldingEngine* engine, Toy* toy, const std::vector<Double_t>* prior,
+				     const std::vector<Double_t>* inverse, Int_t maxNumIterations) {
+  //
+  // unfolds a randomized distribution, starting from the given prior and inverse response
+  //
+  std::vector<Double_t> toyPrior(*prior);
+  std::vector<Double_t> toyInverse(*inverse);
+  std::vector<Double_t> estMeasured;
+  Double_t convergence = 0.;
+  engine->Unfold(toy->fMeasured,toy->fEfficiency,toyPrior,toy->fUnfolded,estMeasured,toyInverse,maxNumIterations,0.,convergence);
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingEngine::UnfoldToys(std::vector<Toy>& toys, Int_t nToys, const std::vector<Double_t>& prior,
+				      const std::vector<Double_t>& inverse, Int_t maxNumIterations, Int_t nThreads) const {
+  //
+  // unfolds the first nToys randomized distributions, each one in its own thread if nThreads > 1
+  // the toys are independent : the result does not depend on the number of threads
+  //
+  if (nThreads <= 1 || nToys <= 1) {
+    for (Int_t i=0; i<nToys; i++) UnfoldToy(this,&toys[i],&prior,&inverse,maxNumIterations);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  for (Int_t i=0; i<nToys; i++) threads.push_back(std::thread(UnfoldToy,this,&toys[i],&prior,&inverse,maxNumIterations));
+  for (UInt_t i=0; i<threads.size(); i++) threads[i].join();
+}
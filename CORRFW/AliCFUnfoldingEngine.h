@@ -0,0 +1,74 @@
+#ifndef ALICFUNFOLDINGENGINE_H
+#define ALICFUNFOLDINGENGINE_H
+
+//--------------------------------------------------------------------//
+//                                                                    //
+// AliCFUnfoldingEngine Class                                         //
+// Bayesian unfolding iterations on flat arrays, used by              //
+// AliCFUnfolding                                                     //
+//                                                                    //
+//--------------------------------------------------------------------//
+
+#include <vector>
+#include "Rtypes.h"
+
+class THnSparse;
+
+class AliCFUnfoldingEngine {
+
+ public :
+
+  // randomized inputs and result of an unfolding used for the correlated errors
+  struct Toy {
+    std::vector<Double_t> fMeasured;   // randomized measured spectrum
+    std::vector<Double_t> fEfficiency; // randomized efficiency
+    std::vector<Double_t> fUnfolded;   // unfolded spectrum
+  };
+
+  AliCFUnfoldingEngine();
+  virtual ~AliCFUnfoldingEngine() {}
+
+  void  Build(const THnSparse* conditional, Int_t nVar, const THnSparse* prior);
+
+  Int_t GetNMeasured() const {return fMeasuredKeys.size();}
+  Int_t GetNTrue()     const {return fTrueKeys.size();}
+  Int_t GetNEntries()  const {return fConditional.size();}
+
+  Int_t FindMeasured(const Int_t* coord) const {return Find(fMeasuredKeys,Key(fMeasuredStrides,coord));}
+  Int_t FindTrue    (const Int_t* coord) const {return Find(fTrueKeys,Key(fTrueStrides,coord));}
+
+  void  FillMeasured(const THnSparse* h, std::vector<Double_t>& v) const ; // measured space (N dim) -> array
+  void  FillTrue    (const THnSparse* h, std::vector<Double_t>& v) const ; // true space (N dim)     -> array
+  void  FillEntries (const THnSparse* h, std::vector<Double_t>& v) const ; // response space (2N dim) -> array
+  void  ExportMeasured(const std::vector<Double_t>& v, THnSparse* h) const ;
+  void  ExportTrue    (const std::vector<Double_t>& v, THnSparse* h) const ;
+  void  ExportEntries (const std::vector<Double_t>& v, THnSparse* h) const ;
+
+  Int_t Unfold(const std::vector<Double_t>& measured, const std::vector<Double_t>& efficiency,
+	       std::vector<Double_t>& prior, std::vector<Double_t>& unfolded, std::vector<Double_t>& estMeasured,
+	       std::vector<Double_t>& inverse, Int_t maxNumIterations, Double_t maxConvergence, Double_t& convergence) const ;
+  void  UnfoldToys(std::vector<Toy>& toys, Int_t nToys, const std::vector<Double_t>& prior, const std::vector<Double_t>& inverse,
+		   Int_t maxNumIterations, Int_t nThreads) const ;
+
+ private :
+
+  static Long64_t Key(const std::vector<Long64_t>& strides, const Int_t* coord) ;
+  static Int_t    Find(const std::vector<Long64_t>& keys, Long64_t key) ;
+  static void     Decode(const std::vector<Long64_t>& strides, Long64_t key, Int_t* coord) ;
+  Int_t           FindEntry(Int_t measured, Int_t trueBin) const ;
+  static void     UnfoldToy(const AliCFUnfoldingEngine* engine, Toy* toy, const std::vector<Double_t>* prior,
+			    const std::vector<Double_t>* inverse, Int_t maxNumIterations) ;
+
+  Int_t                  fNVariables;      // number of variables (N)
+  std::vector<Long64_t>  fMeasuredStrides; // strides of the linear index in measured space (under/overflow included)
+  std::vector<Long64_t>  fTrueStrides;     // strides of the linear index in true space (under/overflow included)
+  std::vector<Long64_t>  fMeasuredKeys;    // sorted linear indices of the measured bins of the response
+  std::vector<Long64_t>  fTrueKeys;        // sorted linear indices of the true bins of the response and of the prior
+  std::vector<Int_t>     fRowStart;        // CSR : first entry of each measured bin (size = measured bins + 1)
+  std::vector<Int_t>     fColumn;          // CSR : true bin of each entry (sorted in each row)
+  std::vector<Double_t>  fConditional;     // CSR : conditional probability P(M|T) of each entry
+
+  ClassDef(AliCFUnfoldingEngine,1);
+};
+
+#endif
@@ -28,5 +28,6 @@
 #pragma link C++ class  AliCFPairPidCut+;
 #pragma link C++ class  AliCFV0TopoCuts+;
 #pragma link C++ class  AliCFUnfolding+;
+#pragma link C++ class  AliCFUnfoldingEngine+;
 
 #endif
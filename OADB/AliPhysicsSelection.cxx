@@ -76,6 +76,7 @@
 #include <TPRegexp.h>
 #include <TParameter.h>
 #include <TInterpreter.h>
+#include <cstring>
 
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6,3,0)
 #include <v5/TFormula.h>
@@ -86,6 +87,7 @@
 #include "AliPhysicsSelection.h"
 
 #include "AliTriggerAnalysis.h"
+#include "AliTriggerLogicFormula.h"
 #include "AliLog.h"
 
 #include "AliVEvent.h"
@@ -128,13 +130,20 @@ fPSOADB(0),
 fFillOADB(0),
 fTriggerOADB(0),
 fRegexp(new TPRegexp("([[:alpha:]]\\w*)")),
-fCashedTokens(NULL)
+fCashedTokens(NULL),
+fUseCompiledLogic(kTRUE),
+fValidateLogic(kFALSE),
+fCompiledLogic(),
+fEventStamp(0)
 {
   // constructor
   fCollTrigClasses.SetOwner(1);
   fBGTrigClasses.SetOwner(1);
   fTriggerAnalysis.SetOwner(1);
   fHistList.SetOwner(1);
+  fCompiledLogic.SetOwner(1);
+  memset(fTriggerCacheValues, 0, sizeof(fTriggerCacheValues));
+  memset(fTriggerCacheStamps, 0, sizeof(fTriggerCacheStamps));
   
   AliLog::SetClassDebugLevel("AliPhysicsSelection", AliLog::kWarning);
 }
@@ -158,13 +167,20 @@ fCashedTokens(NULL)
  fFillOADB(0),
  fTriggerOADB(0),
  fRegexp(new TPRegexp("([[:alpha:]]\\w*)")),
- fCashedTokens(NULL)
+ fCashedTokens(NULL),
+ fUseCompiledLogic(kTRUE),
+ fValidateLogic(kFALSE),
+ fCompiledLogic(),
+ fEventStamp(0)
  {
    // constructor
    fCollTrigClasses.SetOwner(1);
    fBGTrigClasses.SetOwner(1);
    fTriggerAnalysis.SetOwner(1);
    fHistList.SetOwner(1);
+   fCompiledLogic.SetOwner(1);
+   memset(fTriggerCacheValues, 0, sizeof(fTriggerCacheValues));
+   memset(fTriggerCacheStamps, 0, sizeof(fTriggerCacheStamps));
 
    AliLog::SetClassDebugLevel("AliPhysicsSelection", AliLog::kWarning);
  }
@@ -310,6 +326,31 @@ Bool_t AliPhysicsSelection::EvaluateTriggerLogic(const AliVEvent* event, AliTrig
   return result;
 }
 
+//______________________________________________________________________________
+Bool_t AliPhysicsSelection::EvaluateCompiledTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, Int_t triggerLogic, Bool_t offline){
+  // evaluates the trigger logic with index triggerLogic from the OADB object.
+  // The logic is compiled on first use in the current run; trigger decisions are shared
+  // between all trigger classes of the event through fTriggerCacheValues
+  Int_t index = 2*triggerLogic + (offline ? 1 : 0);
+  AliTriggerLogicFormula* formula = (index < fCompiledLogic.GetSize()) ? (AliTriggerLogicFormula*) fCompiledLogic.At(index) : 0;
+  if (!formula) {
+    TString logic = offline ? fPSOADB->GetOfflineTrigger(triggerLogic) : fPSOADB->GetHardwareTrigger(triggerLogic);
+    formula = new AliTriggerLogicFormula();
+    if (!formula->Compile(logic, offline, fCashedTokens))
+      AliFatal(Form("Could not compile trigger logic %s: %s", logic.Data(), formula->GetError()));
+    fCompiledLogic.AddAtAndExpand(formula, index);
+    AliDebug(AliLog::kDebug, Form("Compiled trigger logic %s with %d leaves", logic.Data(), formula->GetNLeaves()));
+  }
+  
+  Bool_t result = formula->Eval(event, triggerAnalysis, fTriggerCacheValues, fTriggerCacheStamps, fEventStamp);
+  
+  if (fValidateLogic) {
+    Bool_t reference = EvaluateTriggerLogic(event, triggerAnalysis, formula->GetLogic(), offline);
+    if (reference != result) AliFatal(Form("Compiled trigger logic %s evaluated to %d instead of %d", formula->GetLogic(), result, reference));
+  }
+  return result;
+}
+
 //______________________________________________________________________________
 UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
   // checks if the given event is a collision candidate
@@ -326,6 +367,12 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
     if (eventType != 7) return kFALSE;
   }
   
+  // invalidate trigger decisions cached for the previous event
+  if (++fEventStamp == 0) {
+    memset(fTriggerCacheStamps, 0, sizeof(fTriggerCacheStamps));
+    fEventStamp = 1;
+  }
+  
   UInt_t accept = 0;
   Int_t nColl = fCollTrigClasses.GetEntries();
   Int_t nBG   = fBGTrigClasses.GetEntries();
@@ -339,8 +386,15 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
     Int_t triggerLogic = 0;
     UInt_t singleTriggerResult = CheckTriggerClass(event, triggerClass, triggerLogic);
     if (!singleTriggerResult) continue;
-    Bool_t onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetHardwareTrigger(triggerLogic), kFALSE);
-    Bool_t offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetOfflineTrigger(triggerLogic), kTRUE);
+    Bool_t onlineDecision  = kFALSE;
+    Bool_t offlineDecision = kFALSE;
+    if (fUseCompiledLogic) {
+      onlineDecision  = EvaluateCompiledTriggerLogic(event, triggerAnalysis, triggerLogic, kFALSE);
+      offlineDecision = EvaluateCompiledTriggerLogic(event, triggerAnalysis, triggerLogic, kTRUE);
+    } else {
+      onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetHardwareTrigger(triggerLogic), kFALSE);
+      offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetOfflineTrigger(triggerLogic), kTRUE);
+    }
     triggerAnalysis->FillHistograms(event,onlineDecision,offlineDecision);
     if (!onlineDecision) continue;
     if (!offlineDecision) continue;
@@ -514,6 +568,8 @@ Bool_t AliPhysicsSelection::Initialize(Int_t runNumber){
     fCashedTokens = new TList();
     fCashedTokens->SetOwner();
   }
+  // trigger logics may change with the OADB object, they are recompiled on first use
+  fCompiledLogic.Clear();
   
   fCurrentRun = runNumber;
 
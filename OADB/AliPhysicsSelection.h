@@ -23,6 +23,7 @@
 #include "AliESDEvent.h"
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
+#include "AliTriggerLogicFormula.h"
 
 class AliVEvent;
 class TH2F;
@@ -85,9 +86,12 @@ public:
   void DetectPassName();
   void ReadOCDB(Bool_t val) { fReadOCDB=val; }
   Bool_t IsMC() const { return fMC; }
+  void SetUseCompiledTriggerLogic(Bool_t flag = kTRUE) { fUseCompiledLogic = flag; }
+  void SetValidateTriggerLogic(Bool_t flag = kTRUE) { fValidateLogic = flag; }
 protected:
   UInt_t CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const;
   Bool_t EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, const char* triggerLogic, Bool_t offline);
+  Bool_t EvaluateCompiledTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, Int_t triggerLogic, Bool_t offline);
   const char * GetTriggerString(TObjString * obj);
 
   TString fPassName;          // pass name for current run
@@ -110,8 +114,15 @@ protected:
 
   TPRegexp* fRegexp;        //! regular expression for trigger tokens
   TList* fCashedTokens;     //! trigger token lookup list
+  
+  Bool_t fUseCompiledLogic; // evaluate trigger logics with precompiled AliTriggerLogicFormula objects
+  Bool_t fValidateLogic;    // cross-check compiled trigger logics against the TFormula evaluation
+  TObjArray fCompiledLogic; //! compiled trigger logics of the current run, index 2*triggerLogic+offline
+  UInt_t fEventStamp;       //! event counter used to invalidate the trigger decision cache
+  Int_t  fTriggerCacheValues[AliTriggerLogicFormula::kNCacheSlots]; //! trigger decisions of the current event
+  UInt_t fTriggerCacheStamps[AliTriggerLogicFormula::kNCacheSlots]; //! event stamp of each cached decision
 
-  ClassDef(AliPhysicsSelection, 22)
+  ClassDef(AliPhysicsSelection, 23)
 private:
   AliPhysicsSelection(const AliPhysicsSelection&);
   AliPhysicsSelection& operator=(const AliPhysicsSelection&);
@@ -0,0 +1,309 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//-------------------------------------------------------------------------
+//                      Implementation of   Class AliTriggerLogicFormula
+//
+// Trigger logic strings of the physics selection OADB are compiled once
+// per run into a postfix program:
+//   - identifiers are resolved to AliTriggerAnalysis::Trigger bits
+//     (the same gInterpreter lookup as before, cached in a token list)
+//   - operators follow the ROOT::v5::TFormula precedence
+//       || < && < ==,!= < <,<=,>,>= < +,- < *,/ < unary !,-,+
+// At evaluation time all leaves are evaluated first (as the substitution
+// path did), optionally through an event cache shared between formulas,
+// then the program runs on a preallocated stack.
+//-------------------------------------------------------------------------
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include <TInterpreter.h>
+#include <TList.h>
+#include <TParameter.h>
+
+#include "AliTriggerLogicFormula.h"
+#include "AliTriggerAnalysis.h"
+#include "AliLog.h"
+
+ClassImp(AliTriggerLogicFormula)
+
+//______________________________________________________________________________
+AliTriggerLogicFormula::AliTriggerLogicFormula() :
+TObject(),
+fLogic(""),
+fError(""),
+fCompiled(kFALSE),
+fOffline(kFALSE),
+fOps(),
+fArgs(),
+fConsts(),
+fLeafBits(),
+fLeafSlots(),
+fLeafValues(),
+fStack(),
+fDepth(0),
+fMaxDepth(0),
+fTokenCache(0),
+fPos(0)
+{
+  // default constructor
+}
+
+//______________________________________________________________________________
+Int_t AliTriggerLogicFormula::ResolveToken(const TString& token, TList* tokenCache){
+  // returns the AliTriggerAnalysis::Trigger value of the given token, -1 if unknown
+  TParameter<Int_t>* param = tokenCache ? dynamic_cast<TParameter<Int_t> *>(tokenCache->FindObject(token)) : 0;
+  if (param) return param->GetVal();
+
+  TInterpreter::EErrorCode error;
+  Int_t bit = gInterpreter->ProcessLine(Form("AliTriggerAnalysis::k%s;", token.Data()), &error);
+  if (error > 0) return -1;
+
+  if (tokenCache) tokenCache->Add(new TParameter<Int_t>(token, bit));
+  return bit;
+}
+
+//______________________________________________________________________________
+Bool_t AliTriggerLogicFormula::Compile(const char* triggerLogic, Bool_t offline, TList* tokenCache){
+  // compiles the trigger logic. Returns kFALSE in case of syntax errors or unknown tokens
+  fLogic = triggerLogic;
+  fError = "";
+  fOffline = offline;
+  fCompiled = kFALSE;
+  fOps.clear();
+  fArgs.clear();
+  fConsts.clear();
+  fLeafBits.clear();
+  fLeafSlots.clear();
+  fDepth = 0;
+  fMaxDepth = 0;
+  fTokenCache = tokenCache;
+  fPos = fLogic.Data();
+
+  Bool_t ok = ParseOr();
+  SkipSpaces();
+  if (ok && *fPos != '\0') {
+    fError.Form("unexpected character '%c' at position %d", *fPos, (Int_t) (fPos - fLogic.Data()));
+    ok = kFALSE;
+  }
+  fTokenCache = 0;
+  fPos = 0;
+  if (!ok) return kFALSE;
+
+  fLeafValues.assign(fLeafBits.size(), 0.);
+  fStack.assign(fMaxDepth > 0 ? fMaxDepth : 1, 0.);
+  fCompiled = kTRUE;
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+Double_t AliTriggerLogicFormula::Eval(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, Int_t* cacheValues, UInt_t* cacheStamps, UInt_t stamp){
+  // evaluates the compiled logic for the given event.
+  // If cacheValues/cacheStamps (kNCacheSlots entries each) are given, trigger decisions
+  // already evaluated for the event with the given stamp are reused and new ones stored
+  for (UInt_t i = 0; i < fLeafBits.size(); i++) {
+    Int_t slot = fLeafSlots[i];
+    if (cacheValues && slot >= 0 && cacheStamps[slot] == stamp) {
+      fLeafValues[i] = cacheValues[slot];
+      continue;
+    }
+    Int_t value = triggerAnalysis->EvaluateTrigger(event, (AliTriggerAnalysis::Trigger) fLeafBits[i]);
+    fLeafValues[i] = value;
+    if (cacheValues && slot >= 0) {
+      cacheValues[slot] = value;
+      cacheStamps[slot] = stamp;
+    }
+  }
+
+  Double_t* tab = &fStack[0];
+  Int_t pos = 0;
+  for (UInt_t i = 0; i < fOps.size(); i++) {
+    switch (fOps[i]) {
+      case kPushLeaf:  tab[pos++] = fLeafValues[fArgs[i]]; break;
+      case kPushConst: tab[pos++] = fConsts[fArgs[i]];     break;
+      case kNot:       tab[pos-1] = (tab[pos-1] == 0);     break;
+      case kNeg:       tab[pos-1] = -tab[pos-1];           break;
+      case kOr:        pos--; tab[pos-1] = (tab[pos-1] != 0 || tab[pos] != 0); break;
+      case kAnd:       pos--; tab[pos-1] = (tab[pos-1] != 0 && tab[pos] != 0); break;
+      case kEq:        pos--; tab[pos-1] = (tab[pos-1] == tab[pos]); break;
+      case kNeq:       pos--; tab[pos-1] = (tab[pos-1] != tab[pos]); break;
+      case kLt:        pos--; tab[pos-1] = (tab[pos-1] <  tab[pos]); break;
+      case kLeq:       pos--; tab[pos-1] = (tab[pos-1] <= tab[pos]); break;
+      case kGt:        pos--; tab[pos-1] = (tab[pos-1] >  tab[pos]); break;
+      case kGeq:       pos--; tab[pos-1] = (tab[pos-1] >= tab[pos]); break;
+      case kAdd:       pos--; tab[pos-1] += tab[pos]; break;
+      case kSub:       pos--; tab[pos-1] -= tab[pos]; break;
+      case kMul:       pos--; tab[pos-1] *= tab[pos]; break;
+      case kDiv:       pos--; tab[pos-1] = (tab[pos] == 0) ? 0 : tab[pos-1] / tab[pos]; break; // as in TFormula
+    }
+  }
+  return tab[0];
+}
+
+//______________________________________________________________________________
+void AliTriggerLogicFormula::Emit(Int_t op, Int_t arg){
+  // appends an instruction and keeps track of the stack depth
+  fOps.push_back(op);
+  fArgs.push_back(arg);
+  if (op == kPushLeaf || op == kPushConst) fDepth++;
+  else if (op != kNot && op != kNeg) fDepth--;
+  if (fDepth > fMaxDepth) fMaxDepth = fDepth;
+}
+
+//______________________________________________________________________________
+void AliTriggerLogicFormula::SkipSpaces(){
+  while (*fPos && isspace(*fPos)) fPos++;
+}
+
+//______________________________________________________________________________
+Bool_t AliTriggerLogicFormula::Accept(const char* op){
+  // consumes op if it is next in the input
+  SkipSpaces();
+  Int_t len = strlen(op);
+  if (strncmp(fPos, op, len) != 0) return kFALSE;
+  // do not mistake "<=" for "<", "!=" for "!" etc.
+  if (len == 1 && (op[0] == '<' || op[0] == '>' || op[0] == '!') && fPos[1] == '=') return kFALSE;
+  fPos += len;
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+Bool_t AliTriggerLogicFormula::ParseOr(){
+  if (!ParseAnd()) return kFALSE;
+  while (Accept("||")) { if (!ParseAnd()) return kFALSE; Emit(kOr); }
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+Bool_t AliTriggerLogicFormula::ParseAnd(){
+  if (!ParseEquality()) return kFALSE;
+  while (Accept("&&")) { if (!ParseEquality()) return kFALSE; Emit(kAnd); }
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+Bool_t AliTriggerLogicFormula::ParseEquality(){
+  if (!ParseRelational()) return kFALSE;
+  while (1) {
+    Int_t op = -1;
+    if      (Accept("==")) op = kEq;
+    else if (Accept("!=")) op = kNeq;
+    else break;
+    if (!ParseRelational()) return kFALSE;
+    Emit(op);
+  }
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+Bool_t AliTriggerLogicFormula::ParseRelational(){
+  if (!ParseAdditive()) return kFALSE;
+  while (1) {
+    Int_t op = -1;
+    if      (Accept("<=")) op = kLeq;
+    else if (Accept(">=")) op = kGeq;
+    else if (Accept("<"))  op = kLt;
+    else if (Accept(">"))  op = kGt;
+    else break;
+    if (!ParseAdditive()) return kFALSE;
+    Emit(op);
+  }
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+Bool_t AliTriggerLogicFormula::ParseAdditive(){
+  if (!ParseMultiplicative()) return kFALSE;
+  while (1) {
+    Int_t op = -1;
+    if      (Accept("+")) op = kAdd;
+    else if (Accept("-")) op = kSub;
+    else break;
+    if (!ParseMultiplicative()) return kFALSE;
+    Emit(op);
+  }
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+Bool_t AliTriggerLogicFormula::ParseMultiplicative(){
+  if (!ParseUnary()) return kFALSE;
+  while (1) {
+    Int_t op = -1;
+    if      (Accept("*")) op = kMul;
+    else if (Accept("/")) op = kDiv;
+    else break;
+    if (!ParseUnary()) return kFALSE;
+    Emit(op);
+  }
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+Bool_t AliTriggerLogicFormula::ParseUnary(){
+  if (Accept("!")) { if (!ParseUnary()) return kFALSE; Emit(kNot); return kTRUE; }
+  if (Accept("-")) { if (!ParseUnary()) return kFALSE; Emit(kNeg); return kTRUE; }
+  if (Accept("+")) return ParseUnary();
+  return ParsePrimary();
+}
+
+//______________________________________________________________________________
+Bool_t AliTriggerLogicFormula::ParsePrimary(){
+  SkipSpaces();
+  if (Accept("(")) {
+    if (!ParseOr()) return kFALSE;
+    if (!Accept(")")) { fError = "missing closing parenthesis"; return kFALSE; }
+    return kTRUE;
+  }
+
+  if (isdigit(*fPos) || *fPos == '.') {
+    char* end = 0;
+    Double_t value = strtod(fPos, &end);
+    if (end == fPos) { fError.Form("invalid number at position %d", (Int_t) (fPos - fLogic.Data())); return kFALSE; }
+    fPos = end;
+    fConsts.push_back(value);
+    Emit(kPushConst, fConsts.size() - 1);
+    return kTRUE;
+  }
+
+  if (isalpha(*fPos)) {
+    const char* start = fPos;
+    while (*fPos && (isalnum(*fPos) || *fPos == '_')) fPos++;
+    TString token(start, fPos - start);
+
+    Int_t bit = ResolveToken(token, fTokenCache);
+    if (bit < 0) { fError.Form("trigger token %s unknown", token.Data()); return kFALSE; }
+    if (fOffline) bit |= AliTriggerAnalysis::kOfflineFlag;
+
+    // identical tokens share one leaf
+    Int_t leaf = -1;
+    for (UInt_t i = 0; i < fLeafBits.size(); i++) if (fLeafBits[i] == bit) leaf = i;
+    if (leaf < 0) {
+      UInt_t noFlags = (UInt_t) bit % (UInt_t) AliTriggerAnalysis::kStartOfFlags;
+      Bool_t cacheable = ((UInt_t) bit & ~((UInt_t) AliTriggerAnalysis::kOfflineFlag)) == noFlags;
+      fLeafBits.push_back(bit);
+      fLeafSlots.push_back(cacheable ? (Int_t) (noFlags + (fOffline ? AliTriggerAnalysis::kStartOfFlags : 0)) : -1);
+      leaf = fLeafBits.size() - 1;
+    }
+    Emit(kPushLeaf, leaf);
+    return kTRUE;
+  }
+
+  if (*fPos == '\0') fError = "unexpected end of expression";
+  else fError.Form("unexpected character '%c' at position %d", *fPos, (Int_t) (fPos - fLogic.Data()));
+  return kFALSE;
+}
@@ -0,0 +1,82 @@
+#ifndef ALITRIGGERLOGICFORMULA_H
+#define ALITRIGGERLOGICFORMULA_H
+
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//                      Implementation of   Class AliTriggerLogicFormula
+//
+// Precompiled form of a physics selection trigger logic string such as
+//   "(SPDGFO >= 1 || V0A || V0C) && !V0ABG && !V0CBG"
+// The string is parsed once into a small stack-machine program whose
+// leaves are AliTriggerAnalysis::Trigger bits. Evaluation does not
+// allocate and can share AliTriggerAnalysis::EvaluateTrigger results
+// between several formulas via an event cache.
+// The accepted grammar and the arithmetic follow ROOT::v5::TFormula, so
+// results are identical to the string substitution + TFormula path.
+//-------------------------------------------------------------------------
+
+#include <vector>
+#include <TObject.h>
+#include <TString.h>
+
+class TList;
+class AliVEvent;
+class AliTriggerAnalysis;
+
+class AliTriggerLogicFormula : public TObject {
+public:
+  enum { kNCacheSlots = 0x0200 }; // 2 x AliTriggerAnalysis::kStartOfFlags (online and offline)
+
+  AliTriggerLogicFormula();
+  virtual ~AliTriggerLogicFormula() {}
+
+  Bool_t Compile(const char* triggerLogic, Bool_t offline, TList* tokenCache);
+  Double_t Eval(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, Int_t* cacheValues, UInt_t* cacheStamps, UInt_t stamp);
+  Bool_t IsCompiled() const { return fCompiled; }
+  const char* GetLogic() const { return fLogic.Data(); }
+  const char* GetError() const { return fError.Data(); }
+  Int_t GetNLeaves() const { return fLeafBits.size(); }
+
+  static Int_t ResolveToken(const TString& token, TList* tokenCache);
+
+protected:
+  enum EOpCode { kPushLeaf = 0, kPushConst, kNot, kNeg, kOr, kAnd, kEq, kNeq, kLt, kLeq, kGt, kGeq, kAdd, kSub, kMul, kDiv };
+
+  Bool_t ParseOr();
+  Bool_t ParseAnd();
+  Bool_t ParseEquality();
+  Bool_t ParseRelational();
+  Bool_t ParseAdditive();
+  Bool_t ParseMultiplicative();
+  Bool_t ParseUnary();
+  Bool_t ParsePrimary();
+  void   SkipSpaces();
+  Bool_t Accept(const char* op);
+  void   Emit(Int_t op, Int_t arg = 0);
+
+  TString fLogic;                   // trigger logic as given in the OADB
+  TString fError;                   //! description of the last compilation error
+  Bool_t  fCompiled;                // kTRUE after a successful Compile()
+  Bool_t  fOffline;                 // kTRUE if leaves carry AliTriggerAnalysis::kOfflineFlag
+  std::vector<Int_t>    fOps;       // program: op codes
+  std::vector<Int_t>    fArgs;      // program: op arguments (leaf or constant index)
+  std::vector<Double_t> fConsts;    // numeric literals
+  std::vector<Int_t>    fLeafBits;  // AliTriggerAnalysis::Trigger bit of each leaf (including flags)
+  std::vector<Int_t>    fLeafSlots; // event cache slot of each leaf, -1 if not cacheable
+  std::vector<Double_t> fLeafValues;//! leaf values of the current event
+  std::vector<Double_t> fStack;     //! evaluation stack, sized at compile time
+  Int_t fDepth;                     //! current stack depth while compiling
+  Int_t fMaxDepth;                  // maximum stack depth of the program
+  TList* fTokenCache;               //! token -> bit lookup used while compiling
+  const char* fPos;                 //! parser position while compiling
+
+private:
+  AliTriggerLogicFormula(const AliTriggerLogicFormula&);
+  AliTriggerLogicFormula& operator=(const AliTriggerLogicFormula&);
+
+  ClassDef(AliTriggerLogicFormula, 1)
+};
+
+#endif
@@ -20,6 +20,7 @@
 #pragma link C++ class AliPhysicsSelection+;
 #pragma link C++ class AliPhysicsSelectionTask+;
 #pragma link C++ class AliTriggerAnalysis+;
+#pragma link C++ class AliTriggerLogicFormula+;
 #pragma link C++ class AliCollisionNormalization+;
 #pragma link C++ class AliCollisionNormalizationTask+;
 #pragma link C++ class AliEventCuts+;
@@ -212,6 +212,7 @@ Bool_t AliCaloTrackMCReader::FillInputEvent(Int_t iEntry,
                                             const char * /*currentFileName*/)
 {  
   fEventNumber     = iEntry;
+  fEventGeneration++;
   //fCurrentFileName = TString(currentFileName);
   fTrackMult       = 0;
   
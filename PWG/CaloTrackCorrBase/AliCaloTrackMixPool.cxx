@@ -0,0 +1,214 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// Root
+#include <TMath.h>
+#include <TClonesArray.h>
+
+// AliRoot
+#include "AliLog.h"
+#include "AliAODPWG4Particle.h"
+
+#include "AliCaloTrackMixPool.h"
+
+/// \cond CLASSIMP
+ClassImp(AliCaloTrackMixPool) ;
+/// \endcond
+
+//____________________________________________
+/// Default constructor, call Init() before use.
+//____________________________________________
+AliCaloTrackMixPool::AliCaloTrackMixPool()
+: TObject(),
+  fNBins(0), fDepth(0), fOpenSlot(-1),
+  fHead(), fNEvents(),
+  fPt(), fEta(), fPhi(), fCharge(), fID()
+{
+}
+
+//_____________________________________________________________________________
+/// Constructor.
+///
+/// \param nBins: number of event class bins.
+/// \param depth: maximum number of events kept per bin.
+/// \param nReserve: expected number of particles per event, preallocated for each slot.
+//_____________________________________________________________________________
+AliCaloTrackMixPool::AliCaloTrackMixPool(Int_t nBins, Int_t depth, Int_t nReserve)
+: TObject(),
+  fNBins(0), fDepth(0), fOpenSlot(-1),
+  fHead(), fNEvents(),
+  fPt(), fEta(), fPhi(), fCharge(), fID()
+{
+  Init(nBins, depth, nReserve);
+}
+
+//_____________________________________________________________________________
+/// Allocate the slots of all bins.
+///
+/// \param nBins: number of event class bins.
+/// \param depth: maximum number of events kept per bin.
+/// \param nReserve: expected number of particles per event, preallocated for each slot.
+//_____________________________________________________________________________
+void AliCaloTrackMixPool::Init(Int_t nBins, Int_t depth, Int_t nReserve)
+{
+  fNBins    = nBins > 0 ? nBins : 0;
+  fDepth    = depth > 0 ? depth : 1;
+  fOpenSlot = -1;
+
+  fHead   .assign(fNBins, fDepth-1);
+  fNEvents.assign(fNBins, 0);
+
+  Int_t nSlots = fNBins*fDepth;
+
+  fPt    .assign(nSlots, std::vector<Float_t>());
+  fEta   .assign(nSlots, std::vector<Float_t>());
+  fPhi   .assign(nSlots, std::vector<Float_t>());
+  fCharge.assign(nSlots, std::vector<Char_t> ());
+  fID    .assign(nSlots, std::vector<Int_t>  ());
+
+  if ( nReserve <= 0 ) return;
+
+  for(Int_t islot = 0; islot < nSlots; islot++)
+  {
+    fPt    [islot].reserve(nReserve);
+    fEta   [islot].reserve(nReserve);
+    fPhi   [islot].reserve(nReserve);
+    fCharge[islot].reserve(nReserve);
+    fID    [islot].reserve(nReserve);
+  }
+}
+
+//_____________________________________________________________________________
+/// Forget all stored events, the slot memory is kept.
+//_____________________________________________________________________________
+void AliCaloTrackMixPool::Reset()
+{
+  fHead   .assign(fNBins, fDepth-1);
+  fNEvents.assign(fNBins, 0);
+  fOpenSlot = -1;
+
+  for(UInt_t islot = 0; islot < fPt.size(); islot++)
+  {
+    fPt    [islot].clear();
+    fEta   [islot].clear();
+    fPhi   [islot].clear();
+    fCharge[islot].clear();
+    fID    [islot].clear();
+  }
+}
+
+//_____________________________________________________________________________
+/// Open a new event in the given bin, it becomes event 0 of the bin.
+/// When the bin is full the oldest event is overwritten.
+/// Particles are added afterwards with AddParticle().
+///
+/// \param bin: event class bin.
+//_____________________________________________________________________________
+void AliCaloTrackMixPool::AddEvent(Int_t bin)
+{
+  if ( bin < 0 || bin >= fNBins )
+  {
+    AliWarning(Form("Bin %d out of range [0,%d[, event not added",bin,fNBins));
+    fOpenSlot = -1;
+    return;
+  }
+
+  fHead[bin] = (fHead[bin] + 1) % fDepth;
+  if ( fNEvents[bin] < fDepth ) fNEvents[bin]++;
+
+  fOpenSlot = bin*fDepth + fHead[bin];
+
+  fPt    [fOpenSlot].clear();
+  fEta   [fOpenSlot].clear();
+  fPhi   [fOpenSlot].clear();
+  fCharge[fOpenSlot].clear();
+  fID    [fOpenSlot].clear();
+}
+
+//_____________________________________________________________________________
+/// Add a particle to the event opened last with AddEvent().
+///
+/// \param pt: transverse momentum.
+/// \param eta: pseudorapidity.
+/// \param phi: azimuthal angle, stored in [0,2pi).
+/// \param charge: track charge, 0 for clusters.
+/// \param id: track or cluster ID.
+//_____________________________________________________________________________
+void AliCaloTrackMixPool::AddParticle(Float_t pt, Float_t eta, Float_t phi, Int_t charge, Int_t id)
+{
+  if ( fOpenSlot < 0 ) return;
+
+  if ( phi < 0 ) phi += TMath::TwoPi();
+
+  fPt    [fOpenSlot].push_back(pt);
+  fEta   [fOpenSlot].push_back(eta);
+  fPhi   [fOpenSlot].push_back(phi);
+  fCharge[fOpenSlot].push_back(charge);
+  fID    [fOpenSlot].push_back(id);
+}
+
+//_____________________________________________________________________________
+/// Fill a stored event as AliAODPWG4Particles into an array,
+/// needed by methods expecting particle objects like AliIsolationCut.
+/// The array is cleared first, its memory is reused.
+///
+/// \param bin: event class bin.
+/// \param ev: event index, 0 for the newest.
+/// \param array: array of AliAODPWG4Particles to be filled.
+/// \param detectorTag: detector tag of the particles, see AliFiducialCut.
+//_____________________________________________________________________________
+void AliCaloTrackMixPool::FillParticleArray(Int_t bin, Int_t ev, TClonesArray * array, Int_t detectorTag) const
+{
+  if ( !array ) return;
+
+  array->Delete();
+
+  Int_t islot = Slot(bin,ev);
+  Int_t n     = fPt[islot].size();
+
+  for(Int_t i = 0; i < n; i++)
+  {
+    Float_t pt  = fPt [islot][i];
+    Float_t eta = fEta[islot][i];
+    Float_t phi = fPhi[islot][i];
+
+    AliAODPWG4Particle * part = new((*array)[i]) AliAODPWG4Particle(pt*TMath::Cos(phi), pt*TMath::Sin(phi),
+                                                                     pt*TMath::SinH(eta), pt*TMath::CosH(eta));
+    part->SetDetectorTag(detectorTag);
+    part->SetChargedBit(fCharge[islot][i] > 0);
+  }
+}
+
+//_____________________________________________________________________________
+/// Print the number of stored events and particles per bin.
+//_____________________________________________________________________________
+void AliCaloTrackMixPool::Print(const Option_t * opt) const
+{
+  if(! opt)
+    return;
+
+  printf("**** Print %s %s ****\n", GetName(), GetTitle() ) ;
+  printf("Bins %d, depth %d\n", fNBins, fDepth);
+
+  for(Int_t ibin = 0; ibin < fNBins; ibin++)
+  {
+    if ( fNEvents[ibin] == 0 ) continue;
+
+    Int_t nPart = 0;
+    for(Int_t iev = 0; iev < fNEvents[ibin]; iev++) nPart += GetNParticles(ibin,iev);
+
+    printf("\t bin %d: %d events, %d particles\n", ibin, fNEvents[ibin], nPart);
+  }
+}
@@ -0,0 +1,93 @@
+#ifndef ALICALOTRACKMIXPOOL_H
+#define ALICALOTRACKMIXPOOL_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliCaloTrackMixPool
+/// \brief Fixed depth pool of past events for own event mixing
+///
+/// For each event class bin (centrality, vz, reaction plane) the pool keeps
+/// the last N events in a ring buffer. Only the kinematics needed for the
+/// correlation are stored, as one array per quantity (pT, eta, phi, charge, ID).
+/// The slot arrays are reused when the ring turns over, so once the pool is
+/// filled no memory is allocated anymore.
+///
+/// The pool can be stored in AliCaloTrackReader so that several analyses
+/// executed by the same AliAnaCaloTrackCorrMaker use the same events.
+///
+/// Events are accessed with index 0 for the most recent one.
+///
+//_________________________________________________________________________
+
+class TClonesArray;
+
+#include <TObject.h>
+#include <vector>
+
+class AliCaloTrackMixPool : public TObject {
+
+ public:
+
+  AliCaloTrackMixPool() ;
+
+  AliCaloTrackMixPool(Int_t nBins, Int_t depth, Int_t nReserve = 0) ;
+
+  /// Destructor
+  virtual        ~AliCaloTrackMixPool() { ; }
+
+  void            Init(Int_t nBins, Int_t depth, Int_t nReserve = 0) ;
+
+  void            Reset() ;
+
+  Int_t           GetNBins()                            const { return fNBins                      ; }
+  Int_t           GetDepth()                            const { return fDepth                      ; }
+  Int_t           GetNEvents(Int_t bin)                 const { return fNEvents[bin]               ; }
+
+  void            AddEvent(Int_t bin) ;
+
+  void            AddParticle(Float_t pt, Float_t eta, Float_t phi, Int_t charge = 0, Int_t id = -1) ;
+
+  Int_t           GetNParticles(Int_t bin, Int_t ev)    const { return fPt[Slot(bin,ev)].size()    ; }
+
+  const Float_t * GetPt    (Int_t bin, Int_t ev)        const { return fPt[Slot(bin,ev)].empty() ? 0 : &(fPt    [Slot(bin,ev)][0]) ; }
+  const Float_t * GetEta   (Int_t bin, Int_t ev)        const { return fPt[Slot(bin,ev)].empty() ? 0 : &(fEta   [Slot(bin,ev)][0]) ; }
+  const Float_t * GetPhi   (Int_t bin, Int_t ev)        const { return fPt[Slot(bin,ev)].empty() ? 0 : &(fPhi   [Slot(bin,ev)][0]) ; }
+  const Char_t  * GetCharge(Int_t bin, Int_t ev)        const { return fPt[Slot(bin,ev)].empty() ? 0 : &(fCharge[Slot(bin,ev)][0]) ; }
+  const Int_t   * GetID    (Int_t bin, Int_t ev)        const { return fPt[Slot(bin,ev)].empty() ? 0 : &(fID    [Slot(bin,ev)][0]) ; }
+
+  void            FillParticleArray(Int_t bin, Int_t ev, TClonesArray * array, Int_t detectorTag) const ;
+
+  virtual void    Print(const Option_t * opt) const ;
+
+ private:
+
+  /// \return Index of the slot holding event ev (0 = newest) of bin.
+  Int_t           Slot(Int_t bin, Int_t ev)             const { return bin*fDepth + (fHead[bin] - ev + fDepth) % fDepth ; }
+
+  Int_t                               fNBins ;      ///<  Number of event class bins.
+  Int_t                               fDepth ;      ///<  Maximum number of events kept per bin.
+  Int_t                               fOpenSlot ;   //!<! Slot of the event being filled.
+
+  std::vector<Int_t>                  fHead ;       //!<! Slot position of the newest event in each bin.
+  std::vector<Int_t>                  fNEvents ;    //!<! Number of stored events in each bin.
+
+  std::vector< std::vector<Float_t> > fPt ;         //!<! Transverse momentum per slot.
+  std::vector< std::vector<Float_t> > fEta ;        //!<! Pseudorapidity per slot.
+  std::vector< std::vector<Float_t> > fPhi ;        //!<! Azimuth in [0,2pi) per slot.
+  std::vector< std::vector<Char_t>  > fCharge ;     //!<! Charge per slot, 0 for clusters.
+  std::vector< std::vector<Int_t>   > fID ;         //!<! Track or cluster ID per slot.
+
+  /// Copy constructor not implemented.
+  AliCaloTrackMixPool(              const AliCaloTrackMixPool & p) ;
+
+  /// Assignment operator not implemented.
+  AliCaloTrackMixPool & operator = (const AliCaloTrackMixPool & p) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliCaloTrackMixPool,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALICALOTRACKMIXPOOL_H
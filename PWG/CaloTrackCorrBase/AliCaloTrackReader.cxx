@@ -47,6 +47,7 @@
 // ---- CaloTrackCorr ---
 #include "AliCalorimeterUtils.h"
 #include "AliCaloTrackReader.h"
+#include "AliCaloTrackMixPool.h"
 
 // ---- Jets ----
 #include "AliAODJet.h"
@@ -61,6 +62,7 @@ ClassImp(AliCaloTrackReader) ;
 //________________________________________
 AliCaloTrackReader::AliCaloTrackReader() :
 TObject(),                   fEventNumber(-1), //fCurrentFileName(""),
+fEventGeneration(0),
 fDataType(0),                fDebug(0),
 fFiducialCut(0x0),           fCheckFidCut(kFALSE),
 fComparePtHardAndJetPt(0),   fPtHardAndJetPtFactor(0),
@@ -103,7 +105,7 @@ fEventType(-1),
 fTaskName(""),               fCaloUtils(0x0),
 fWeightUtils(0x0),           fEventWeight(1),
 fMixedEvent(NULL),           fNMixedEvent(0),                 fVertex(NULL),
-fListMixedTracksEvents(),    fListMixedCaloEvents(),
+fMixedTracksPool(0),         fMixedCaloPool(0),
 fLastMixedTracksEvent(-1),   fLastMixedCaloEvent(-1),
 fWriteOutputDeltaAOD(kFALSE),
 fEMCALClustersListName(""),  fZvtxCut(0.),
@@ -218,6 +220,10 @@ void AliCaloTrackReader::DeletePointers()
   fAcceptEventsWithBit.Reset();
   
   if ( fWeightUtils ) delete fWeightUtils ;
+  
+  // Mixing pools shared by the analyses
+  delete fMixedTracksPool ;
+  delete fMixedCaloPool   ;
     
   //  Pointers not owned, done by the analysis frame
   //  if(fInputEvent)  delete fInputEvent ;
@@ -1280,6 +1286,7 @@ Bool_t AliCaloTrackReader::IsPileUpFromNotSPDAndNotEMCal() const
 Bool_t AliCaloTrackReader::FillInputEvent(Int_t iEntry, const char * /*curFileName*/)
 {  
   fEventNumber         = iEntry;
+  fEventGeneration++;
   fTriggerClusterIndex = -1;
   fTriggerClusterId    = -1;
   fIsTriggerMatch      = kFALSE;
@@ -51,6 +51,7 @@ class AliVCluster;
 #include "AliFiducialCut.h"
 class AliCalorimeterUtils;
 #include "AliAnaWeights.h"
+class AliCaloTrackMixPool;
 
 // Jets
 class AliAODJetEventBackground;
@@ -83,6 +84,7 @@ public:
   virtual void    SetDataType(Int_t data )                 { fDataType = data              ; }
 
   virtual Int_t   GetEventNumber()                   const { return fEventNumber           ; }
+  Int_t           GetEventGeneration()               const { return fEventGeneration       ; }
 	
   virtual TObjString *  GetListOfParameters() ;
   
@@ -575,25 +577,27 @@ public:
   Int_t   GetLastCaloMixedEvent()                    const { return fLastMixedCaloEvent          ; }
   Int_t   GetLastTracksMixedEvent ()                 const { return fLastMixedTracksEvent        ; }
   
-  TList * GetListWithMixedEventsForCalo  (Int_t bi)  const { if(fListMixedCaloEvents)   return fListMixedCaloEvents  [bi] ; else return 0 ; }
-  TList * GetListWithMixedEventsForTracks(Int_t bi)  const { if(fListMixedTracksEvents) return fListMixedTracksEvents[bi] ; else return 0 ; }
+  AliCaloTrackMixPool * GetMixedEventsPoolForCalo  () const { return fMixedCaloPool              ; }
+  AliCaloTrackMixPool * GetMixedEventsPoolForTracks() const { return fMixedTracksPool            ; }
    
-  Bool_t  ListWithMixedEventsForCaloExists()         const { if(fListMixedCaloEvents) return kTRUE  ;
-                                                             else                     return kFALSE ; }
+  Bool_t  MixedEventsPoolForCaloExists()             const { if(fMixedCaloPool) return kTRUE  ;
+                                                             else               return kFALSE ; }
 
-  Bool_t  ListWithMixedEventsForTracksExists()       const { if(fListMixedTracksEvents) return kTRUE  ;
-                                                             else                       return kFALSE ; }
+  Bool_t  MixedEventsPoolForTracksExists()           const { if(fMixedTracksPool) return kTRUE  ;
+                                                             else                 return kFALSE ; }
   
   void    SetLastCaloMixedEvent  (Int_t e)                 { fLastMixedCaloEvent    = e          ; }
   void    SetLastTracksMixedEvent(Int_t e)                 { fLastMixedTracksEvent  = e          ; }
   
-  void    SetListWithMixedEventsForCalo (TList ** l)       { 
-            if(fListMixedCaloEvents) printf("AliCaloTrackReader::SetListWithMixedEventsForCalo() - Track Mixing event list already set, nothing done\n");
-            else                        fListMixedCaloEvents    = l ; }
+  /// Pool shared by the analyses, the reader takes ownership.
+  void    SetMixedEventsPoolForCalo  (AliCaloTrackMixPool * p) { 
+            if(fMixedCaloPool)   printf("AliCaloTrackReader::SetMixedEventsPoolForCalo() - Calorimeter mixing event pool already set, nothing done\n");
+            else                 fMixedCaloPool    = p ; }
   
-  void    SetListWithMixedEventsForTracks(TList ** l)      { 
-            if(fListMixedTracksEvents)  printf("AliCaloTrackReader::SetListWithMixedEventsForTracks() - Calorimeter Mixing event list already set, nothing done\n");
-            else                        fListMixedTracksEvents  = l ; }
+  /// Pool shared by the analyses, the reader takes ownership.
+  void    SetMixedEventsPoolForTracks(AliCaloTrackMixPool * p) { 
+            if(fMixedTracksPool) printf("AliCaloTrackReader::SetMixedEventsPoolForTracks() - Track mixing event pool already set, nothing done\n");
+            else                 fMixedTracksPool  = p ; }
   
   //-------------------------------------
   // Other methods
@@ -726,6 +730,7 @@ public:
  protected:
   
   Int_t	           fEventNumber;                   ///<  Event number.
+  Int_t            fEventGeneration;               //!<! Incremented at each FillInputEvent() call, changes whenever the lists are refilled.
   Int_t            fDataType ;                     ///<  Select MC: Kinematics, Data: ESD/AOD, MCData: Both.
   Int_t            fDebug;                         ///<  Debugging level.
   AliFiducialCut * fFiducialCut;                   ///<  Acceptance cuts.
@@ -844,8 +849,8 @@ public:
   Int_t            fNMixedEvent ;                  ///<  Number of events in mixed event buffer.
   Double_t      ** fVertex      ;                  //!<! Vertex array 3 dim for each mixed event buffer.
   
-  TList **         fListMixedTracksEvents;         //!<! Container for tracks stored for different events, used in case of own mixing, set in analysis class.
-  TList **         fListMixedCaloEvents  ;         //!<! Container for photon stored for different events, used in case of own mixing, set in analysis class.
+  AliCaloTrackMixPool * fMixedTracksPool;         //!<! Pool of tracks stored for different events, used in case of own mixing, set in analysis class.
+  AliCaloTrackMixPool * fMixedCaloPool  ;         //!<! Pool of clusters stored for different events, used in case of own mixing, set in analysis class.
   Int_t            fLastMixedTracksEvent ;         ///<  Temporary container with the last event added to the mixing list for tracks.
   Int_t            fLastMixedCaloEvent   ;         ///<  Temporary container with the last event added to the mixing list for photons.
    
@@ -960,7 +965,7 @@ public:
   AliCaloTrackReader & operator = (const AliCaloTrackReader & r) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliCaloTrackReader,76) ;
+  ClassDef(AliCaloTrackReader,78) ;
   /// \endcond
 
 } ;
@@ -15,6 +15,7 @@
 
 // --- ROOT system ---
 #include <TObjArray.h>
+#include <algorithm>
 
 // --- AliRoot system ---
 #include "AliAODPWG4ParticleCorrelation.h"
@@ -54,8 +55,24 @@ fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
 fMomentum(),
-fTrackVector()
+fTrackVector(),
+fUseParticleGrid(kTRUE),
+fGridCellFirst(2), fGridIndex(2), fGridNoCell(2),
+fGridSelected(), fGridParticleCell(),
+fCellTableRun(-1), fCellTableCaloUtils(0x0),
+fCellTableNCols(0), fCellTableNRows(0), fCellTableBadSum(),
+fCellConeSize(-1), fCellConeHalfWidth()
 {
+  for(Int_t igrid = 0; igrid < 2; igrid++)
+  {
+    fGridList      [igrid] = 0x0;
+    fGridGeneration[igrid] = -1;
+    fGridCellSize  [igrid] = -1;
+    fGridEtaMin    [igrid] = 0;
+    fGridNEta      [igrid] = 0;
+    fGridNPhi      [igrid] = 0;
+  }
+
   InitParameters();
 }
 
@@ -164,6 +181,198 @@ Float_t AliIsolationCut::CalculateExcessAreaFraction(Float_t excess) const
   }
 }
 
+//_________________________________________________________________________________
+/// Fill the summed area table of EMCal bad cells, once per run.
+/// Cells are indexed with the absolute (col,row) used in GetCellDensity()
+/// and GetCoeffNormBadCell(), all columns and rows considered in EMCal acceptance
+/// there are included.
+//_________________________________________________________________________________
+void AliIsolationCut::FillCellStatusTable(AliCaloTrackReader * reader) const
+{
+  AliCalorimeterUtils *cu = reader->GetCaloUtils();
+
+  Int_t run = -1;
+  if ( reader->GetInputEvent() ) run = reader->GetInputEvent()->GetRunNumber();
+
+  if ( run == fCellTableRun && cu == fCellTableCaloUtils && !fCellTableBadSum.empty() ) return;
+
+  fCellTableRun       = run;
+  fCellTableCaloUtils = cu;
+
+  fCellTableNCols = AliEMCALGeoParams::fgkEMCALCols*2+1;
+  fCellTableNRows = int(AliEMCALGeoParams::fgkEMCALRows*16./3)+1; //5*nRows+1/3*nRows
+
+  Int_t nColsSum = fCellTableNCols+1;
+  fCellTableBadSum.assign(nColsSum*(fCellTableNRows+1), 0);
+
+  for(Int_t irow = 0; irow < fCellTableNRows; irow++)
+  {
+    for(Int_t icol = 0; icol < fCellTableNCols; icol++)
+    {
+      Int_t cellSM  = -999;
+      Int_t cellEta = -999;
+      Int_t cellPhi = -999;
+      if(icol > AliEMCALGeoParams::fgkEMCALCols-1)
+      {
+        cellSM = 0+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
+        cellEta = icol-AliEMCALGeoParams::fgkEMCALCols;
+        cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
+      }
+      if(icol < AliEMCALGeoParams::fgkEMCALCols)
+      {
+        cellSM = 1+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
+        cellEta = icol;
+        cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
+      }
+
+      Int_t bad = (cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi)==1) ? 1 : 0;
+
+      fCellTableBadSum[(irow+1)*nColsSum+icol+1] = bad +
+        fCellTableBadSum[ irow   *nColsSum+icol+1] +
+        fCellTableBadSum[(irow+1)*nColsSum+icol  ] -
+        fCellTableBadSum[ irow   *nColsSum+icol  ];
+    }
+  }
+
+  AliDebug(1,Form("Bad cell table filled for run %d, %d bad cells",
+                  run,fCellTableBadSum[fCellTableNRows*nColsSum+fCellTableNCols]));
+}
+
+//_________________________________________________________________________________
+/// Fill the eta-phi grid of the tracks (igrid=0) or clusters (igrid=1) of the event.
+/// The grid cells have the size of the isolation cone, each cell keeps the
+/// indices of the list entries inside in increasing order. Nothing is done
+/// if the grid was already filled for this list since the reader last
+/// refilled its lists (AliCaloTrackReader::GetEventGeneration()).
+///
+/// \param igrid: 0 for tracks, 1 for clusters.
+/// \param list: tracks or clusters of the event.
+/// \param reader: pointer to AliCaloTrackReader, needed for the event generation and vertex.
+//_________________________________________________________________________________
+void AliIsolationCut::FillParticleGrid(Int_t igrid, TObjArray * list, AliCaloTrackReader * reader)
+{
+  if ( fGridList      [igrid] == list                          &&
+       fGridGeneration[igrid] == reader->GetEventGeneration() &&
+       fGridCellSize  [igrid] == fConeSize ) return;
+
+  fGridList      [igrid] = list;
+  fGridGeneration[igrid] = reader->GetEventGeneration();
+  fGridCellSize  [igrid] = fConeSize;
+
+  Int_t nEntries = list->GetEntries();
+
+  std::vector<Int_t> & cellFirst = fGridCellFirst[igrid];
+  std::vector<Int_t> & index     = fGridIndex    [igrid];
+  std::vector<Int_t> & noCell    = fGridNoCell   [igrid];
+
+  noCell.clear();
+
+  std::vector<Float_t> etaList(nEntries, 0.);
+  std::vector<Float_t> phiList(nEntries, 0.);
+  fGridParticleCell.assign(nEntries, -1);
+
+  Float_t etaMin =  1e6;
+  Float_t etaMax = -1e6;
+
+  for(Int_t ipr = 0; ipr < nEntries; ipr++)
+  {
+    TObject * obj = list->At(ipr);
+
+    Float_t eta = 0.;
+    Float_t phi = 0.;
+    Bool_t  ok  = kFALSE;
+
+    // Same kinematics as in MakeIsolationCut()
+    AliVTrack   * track = (igrid == 0) ? dynamic_cast<AliVTrack  *>(obj) : 0x0;
+    AliVCluster * calo  = (igrid == 1) ? dynamic_cast<AliVCluster*>(obj) : 0x0;
+
+    if ( track )
+    {
+      fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+      eta = fTrackVector.Eta();
+      phi = fTrackVector.Phi();
+      ok  = kTRUE;
+    }
+    else if ( calo )
+    {
+      Int_t evtIndex = 0 ;
+      if (reader->GetMixedEvent())
+        evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+
+      calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+      eta = fMomentum.Eta();
+      phi = fMomentum.Phi();
+      ok  = kTRUE;
+    }
+    else
+    {
+      AliAODPWG4Particle * partmix = dynamic_cast<AliAODPWG4Particle*>(obj) ;
+      if ( partmix )
+      {
+        eta = partmix->Eta();
+        phi = partmix->Phi();
+        ok  = kTRUE;
+      }
+    }
+
+    if ( phi < 0 ) phi+=TMath::TwoPi();
+
+    // Entries of unknown type or with unphysical direction are always
+    // passed to MakeIsolationCut(), which treats them as before
+    if ( !ok || !TMath::Finite(eta) || !TMath::Finite(phi) || TMath::Abs(eta) > 100 )
+    {
+      noCell.push_back(ipr);
+      continue;
+    }
+
+    etaList[ipr] = eta;
+    phiList[ipr] = phi;
+    fGridParticleCell[ipr] = 0;
+
+    if ( eta < etaMin ) etaMin = eta;
+    if ( eta > etaMax ) etaMax = eta;
+  }
+
+  Int_t nEta = 1;
+  if ( etaMax > etaMin ) nEta = int((etaMax-etaMin)/fConeSize)+1;
+
+  Int_t nPhi = TMath::Max(int(TMath::TwoPi()/fConeSize), 1);
+  Float_t phiCellSize = TMath::TwoPi()/nPhi;
+
+  fGridEtaMin[igrid] = etaMin;
+  fGridNEta  [igrid] = nEta;
+  fGridNPhi  [igrid] = nPhi;
+
+  // Count the entries per cell, then store the indices ordered by cell
+  cellFirst.assign(nEta*nPhi+1, 0);
+
+  for(Int_t ipr = 0; ipr < nEntries; ipr++)
+  {
+    if ( fGridParticleCell[ipr] < 0 ) continue;
+
+    Int_t ieta = TMath::Min(int((etaList[ipr]-etaMin)/fConeSize), nEta-1);
+    Int_t iphi = TMath::Min(int( phiList[ipr]/phiCellSize)      , nPhi-1);
+
+    fGridParticleCell[ipr] = ieta*nPhi+iphi;
+    cellFirst[fGridParticleCell[ipr]+1]++;
+  }
+
+  for(Int_t icell = 0; icell < nEta*nPhi; icell++) cellFirst[icell+1] += cellFirst[icell];
+
+  index.resize(cellFirst[nEta*nPhi]);
+
+  std::vector<Int_t> fill(cellFirst.begin(), cellFirst.end()-1);
+  for(Int_t ipr = 0; ipr < nEntries; ipr++)
+  {
+    if ( fGridParticleCell[ipr] < 0 ) continue;
+
+    index[fill[fGridParticleCell[ipr]]++] = ipr;
+  }
+
+  AliDebug(1,Form("Grid %d filled with %d entries, %d x %d cells, %d without cell",
+                  igrid,nEntries,nEta,nPhi,(Int_t)noCell.size()));
+}
+
 //_________________________________________________________________________________
 /// Get good cell density (number of active cells over all cells in cone).
 //_________________________________________________________________________________
@@ -195,45 +404,36 @@ Float_t AliIsolationCut::GetCellDensity(AliAODPWG4ParticleCorrelation * pCandida
       Int_t rowC = iPhi + AliEMCALGeoParams::fgkEMCALRows*int(nSupMod/2);
 
       Int_t sqrSize = int(fConeSize/0.0143) ; // Size of cell in radians
-      //loop on cells in a square of side fConeSize to check cells in cone
-      for(Int_t icol = colC-sqrSize; icol < colC+sqrSize;icol++)
+
+      FillCellStatusTable(reader);
+
+      //loop on rows of a square of side fConeSize, the cells in cone of each row
+      //are a column interval, count the bad ones with the table of the run
+      for(Int_t irow = rowC-sqrSize; irow < rowC+sqrSize; irow++)
       {
-        for(Int_t irow = rowC-sqrSize; irow < rowC+sqrSize; irow++)
+        Int_t halfWidth = GetConeHalfWidth(sqrSize, rowC-irow);
+        if ( halfWidth < 0 ) continue;
+
+        Int_t colMin = colC-halfWidth;
+        Int_t colMax = colC+halfWidth;
+
+        coneCells += colMax-colMin+1;
+
+        //Count as bad "cells" out of EMCAL acceptance
+        if ( irow < 0 || irow > fCellTableNRows-1 )
         {
-          if (Radius(colC, rowC, icol, irow) < sqrSize)
-          {
-            coneCells += 1.;
-
-            Int_t cellSM  = -999;
-            Int_t cellEta = -999;
-            Int_t cellPhi = -999;
-            if(icol > AliEMCALGeoParams::fgkEMCALCols-1)
-            {
-              cellSM = 0+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
-              cellEta = icol-AliEMCALGeoParams::fgkEMCALCols;
-              cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
-            }
-            if(icol < AliEMCALGeoParams::fgkEMCALCols)
-            {
-              cellSM = 1+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
-              cellEta = icol;
-              cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
-            }
-
-            //Count as bad "cells" out of EMCAL acceptance
-            if(icol < 0 || icol > AliEMCALGeoParams::fgkEMCALCols*2 ||
-               irow < 0 || irow > AliEMCALGeoParams::fgkEMCALRows*16./3) //5*nRows+1/3*nRows
-            {
-              coneCellsBad += 1.;
-            }
-            //Count as bad "cells" marked as bad in the DataBase
-            else if (cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi)==1)
-            {
-              coneCellsBad += 1. ;
-            }
-          }
+          coneCellsBad += colMax-colMin+1;
+          continue;
         }
-      }//end of cells loop
+
+        Int_t colMinAcc = TMath::Max(colMin, 0);
+        Int_t colMaxAcc = TMath::Min(colMax, fCellTableNCols-1);
+
+        coneCellsBad += (colMax-colMin+1) - TMath::Max(colMaxAcc-colMinAcc+1, 0);
+
+        //Count as bad "cells" marked as bad in the DataBase
+        coneCellsBad += GetNBadCells(colMinAcc, colMaxAcc, irow, irow);
+      }//end of rows loop
     }
     else AliWarning("Cluster with bad (eta,phi) in EMCal for energy density calculation");
 
@@ -282,41 +482,56 @@ void AliIsolationCut::GetCoeffNormBadCell(AliAODPWG4ParticleCorrelation * pCandi
       Int_t rowC = iPhi + AliEMCALGeoParams::fgkEMCALRows*int(nSupMod/2);
 
       Int_t sqrSize = int(fConeSize/0.0143) ; // Size of cell in radians
-      for(Int_t icol = 0; icol < 2*AliEMCALGeoParams::fgkEMCALCols-1;icol++)
+
+      FillCellStatusTable(reader);
+
+      // 2 SM in eta times 5 SM in phi, last column and row not considered
+      Int_t nCols = 2*AliEMCALGeoParams::fgkEMCALCols-1;
+      Int_t nRows = 5*AliEMCALGeoParams::fgkEMCALRows-1;
+
+      //cells in cone, column interval per row
+      Int_t coneBad = 0;
+      for(Int_t irow = 0; irow < nRows; irow++)
       {
-        for(Int_t irow = 0; irow < 5*AliEMCALGeoParams::fgkEMCALRows -1; irow++)
-        {
-          //loop on cells in a square of side fConeSize to check cells in cone
-          if     ( Radius(colC, rowC, icol, irow) < sqrSize ) { coneCells    += 1.; }
-          else if( icol>colC-sqrSize  &&  icol<colC+sqrSize ) { phiBandCells += 1 ; }
-          else if( irow>rowC-sqrSize  &&  irow<rowC+sqrSize ) { etaBandCells += 1 ; }
-
-          Int_t cellSM  = -999;
-          Int_t cellEta = -999;
-          Int_t cellPhi = -999;
-          if(icol > AliEMCALGeoParams::fgkEMCALCols-1)
-          {
-            cellSM = 0+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
-            cellEta = icol-AliEMCALGeoParams::fgkEMCALCols;
-            cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
-          }
-          if(icol < AliEMCALGeoParams::fgkEMCALCols)
-          {
-            cellSM = 1+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
-            cellEta = icol;
-            cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
-          }
+        Int_t halfWidth = GetConeHalfWidth(sqrSize, rowC-irow);
+        if ( halfWidth < 0 ) continue;
 
-          if( (icol < 0 || icol > AliEMCALGeoParams::fgkEMCALCols*2-1 ||
-               irow < 0 || irow > AliEMCALGeoParams::fgkEMCALRows*5 - 1) //5*nRows+1/3*nRows //Count as bad "cells" out of EMCAL acceptance
-             || (cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi)==1))  //Count as bad "cells" marked as bad in the DataBase
-          {
-            if     ( Radius(colC, rowC, icol, irow) < sqrSize ) coneBadCellsCoeff    += 1.;
-            else if( icol>colC-sqrSize  &&  icol<colC+sqrSize ) phiBandBadCellsCoeff += 1 ;
-	          else if( irow>rowC-sqrSize  &&  irow<rowC+sqrSize ) etaBandBadCellsCoeff += 1 ;
-          }
-        }
-      }//end of cells loop
+        Int_t colMin = TMath::Max(colC-halfWidth, 0);
+        Int_t colMax = TMath::Min(colC+halfWidth, nCols-1);
+        if ( colMin > colMax ) continue;
+
+        coneCells += colMax-colMin+1;
+        coneBad   += GetNBadCells(colMin, colMax, irow, irow);
+      }
+
+      //phi band: columns closer than sqrSize to the candidate, the cone is inside
+      Int_t bandColMin = TMath::Max(colC-sqrSize+1, 0);
+      Int_t bandColMax = TMath::Min(colC+sqrSize-1, nCols-1);
+      Int_t nBandCols  = TMath::Max(bandColMax-bandColMin+1, 0);
+
+      Int_t phiBandBad = 0;
+      if ( nBandCols > 0 )
+      {
+        phiBandCells = nBandCols*nRows - coneCells;
+        phiBandBad   = GetNBadCells(bandColMin, bandColMax, 0, nRows-1) - coneBad;
+      }
+
+      //eta band: rows closer than sqrSize to the candidate, out of the phi band
+      Int_t bandRowMin = TMath::Max(rowC-sqrSize+1, 0);
+      Int_t bandRowMax = TMath::Min(rowC+sqrSize-1, nRows-1);
+      Int_t nBandRows  = TMath::Max(bandRowMax-bandRowMin+1, 0);
+
+      Int_t etaBandBad = 0;
+      if ( nBandRows > 0 )
+      {
+        etaBandCells = (nCols-nBandCols)*nBandRows;
+        etaBandBad   = GetNBadCells(0, nCols-1, bandRowMin, bandRowMax);
+        if ( nBandCols > 0 ) etaBandBad -= GetNBadCells(bandColMin, bandColMax, bandRowMin, bandRowMax);
+      }
+
+      coneBadCellsCoeff    += coneBad;
+      phiBandBadCellsCoeff += phiBandBad;
+      etaBandBadCellsCoeff += etaBandBad;
     }
     else AliWarning("Cluster with bad (eta,phi) in EMCal for energy density coeff calculation");
 
@@ -343,6 +558,60 @@ void AliIsolationCut::GetCoeffNormBadCell(AliAODPWG4ParticleCorrelation * pCandi
   }
 }
 
+//_________________________________________________________________________________
+/// Cells in cone of GetCellDensity() and GetCoeffNormBadCell() are the ones with
+/// Radius(colC,rowC,icol,irow) < sqrSize, for a given row distance they form
+/// a column interval around the candidate. Its half width is calculated once with
+/// Radius() for each row distance and kept until the cone size changes.
+///
+/// \param sqrSize: cone size in cell units.
+/// \param drow: row of the candidate minus row of the cells.
+/// \return half width in columns, -1 if no cell of the row is in the cone.
+//_________________________________________________________________________________
+Int_t AliIsolationCut::GetConeHalfWidth(Int_t sqrSize, Int_t drow) const
+{
+  if ( sqrSize != fCellConeSize )
+  {
+    fCellConeSize = sqrSize;
+    fCellConeHalfWidth.clear();
+  }
+
+  drow = TMath::Abs(drow);
+
+  while ( (Int_t) fCellConeHalfWidth.size() <= drow )
+  {
+    Int_t irow      = fCellConeHalfWidth.size();
+    Int_t halfWidth = -1;
+
+    for(Int_t icol = 0; icol < sqrSize; icol++)
+    {
+      if ( Radius(icol, irow, 0, 0) < sqrSize ) halfWidth = icol;
+      else break;
+    }
+
+    fCellConeHalfWidth.push_back(halfWidth);
+  }
+
+  return fCellConeHalfWidth[drow];
+}
+
+//_________________________________________________________________________________
+/// \return Number of bad cells in the rectangle of columns [colMin,colMax]
+/// and rows [rowMin,rowMax], from the summed area table of the run.
+/// The rectangle must be inside the table.
+//_________________________________________________________________________________
+Int_t AliIsolationCut::GetNBadCells(Int_t colMin, Int_t colMax, Int_t rowMin, Int_t rowMax) const
+{
+  if ( colMin > colMax || rowMin > rowMax ) return 0;
+
+  Int_t nColsSum = fCellTableNCols+1;
+
+  return fCellTableBadSum[(rowMax+1)*nColsSum+colMax+1] -
+         fCellTableBadSum[ rowMin   *nColsSum+colMax+1] -
+         fCellTableBadSum[(rowMax+1)*nColsSum+colMin  ] +
+         fCellTableBadSum[ rowMin   *nColsSum+colMin  ];
+}
+
 //____________________________________________
 // Put data member values in string to keep
 // in output container.
@@ -457,11 +726,27 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   // Check charged tracks in cone.
   // --------------------------------
   
+  // The UE bands are only needed for the background subtraction method,
+  // otherwise only the particles around the candidate are selected from the grid.
+  Bool_t bands = (fICMethod == kSumBkgSubIC);
+
   if(plCTS &&
      (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
   {
-    for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+    // Grid only for the event tracks, not for mixed events or reference arrays
+    Bool_t useGrid = (fUseParticleGrid && fConeSize > 0 && reader && plCTS == reader->GetCTSTracks());
+    if ( useGrid )
     {
+      FillParticleGrid(0, plCTS, reader);
+      SelectParticlesInGrid(0, etaC, phiC, bands);
+    }
+
+    Int_t nTracks = useGrid ? (Int_t) fGridSelected.size() : plCTS->GetEntries();
+
+    for(Int_t itr = 0; itr < nTracks; itr++ )
+    {
+      Int_t ipr = useGrid ? fGridSelected[itr] : itr;
+
       AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
       
       if(track)
@@ -605,9 +890,21 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   if(plNe &&
      (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
   {
-    
-    for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+    // Grid only for the event clusters, not for mixed events or reference arrays
+    Bool_t useGrid = (fUseParticleGrid && fConeSize > 0 && reader &&
+                      (plNe == reader->GetEMCALClusters() || plNe == reader->GetPHOSClusters()));
+    if ( useGrid )
+    {
+      FillParticleGrid(1, plNe, reader);
+      SelectParticlesInGrid(1, etaC, phiC, bands);
+    }
+
+    Int_t nClusters = useGrid ? (Int_t) fGridSelected.size() : plNe->GetEntries();
+
+    for(Int_t icl = 0; icl < nClusters; icl++ )
     {
+      Int_t ipr = useGrid ? fGridSelected[icl] : icl;
+
       AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
       
       if(calo)
@@ -896,6 +1193,7 @@ void AliIsolationCut::Print(const Option_t * opt) const
   printf("particle type in cone =  %d\n",    fPartInCone ) ;
   printf("using fraction for high pt leading instead of frac ? %i\n",fFracIsThresh);
   printf("minimum distance to candidate, R>%1.2f\n",fDistMinToTrigger);
+  printf("particles in cone selected with eta-phi grid ? %d\n",fUseParticleGrid);
   printf("    \n") ;
 }
 
@@ -918,5 +1216,73 @@ Float_t AliIsolationCut::Radius(Float_t etaC, Float_t phiC,
   return TMath::Sqrt( dEta*dEta + dPhi*dPhi );
 }
 
+//______________________________________________________________
+/// Select from the grid the list entries that can be in the cone of the
+/// candidate, or in its UE bands if requested. The eta and phi ranges
+/// are enlarged by one cell, the exact selection is done afterwards
+/// in MakeIsolationCut(). Entries are stored in fGridSelected in
+/// increasing order, so that sums are done in the same order as
+/// when looping over the full list.
+///
+/// \param igrid: 0 for tracks, 1 for clusters.
+/// \param etaC: pseudorapidity of candidate particle.
+/// \param phiC: azimuthal angle of candidate particle, in [0,2pi).
+/// \param bands: select also the particles in the full eta and phi bands.
+//______________________________________________________________
+void AliIsolationCut::SelectParticlesInGrid(Int_t igrid, Float_t etaC, Float_t phiC, Bool_t bands)
+{
+  const std::vector<Int_t> & cellFirst = fGridCellFirst[igrid];
+  const std::vector<Int_t> & index     = fGridIndex    [igrid];
+
+  fGridSelected = fGridNoCell[igrid];
+
+  Int_t nEta = fGridNEta[igrid];
+  Int_t nPhi = fGridNPhi[igrid];
 
+  // Candidate direction not defined, take all
+  if ( !TMath::Finite(etaC) || !TMath::Finite(phiC) )
+  {
+    fGridSelected.insert(fGridSelected.end(), index.begin(), index.end());
+    std::sort(fGridSelected.begin(), fGridSelected.end());
+    return;
+  }
+
+  Float_t phiCellSize = TMath::TwoPi()/nPhi;
+
+  Double_t etaLow  = (etaC-fConeSize-fGridEtaMin[igrid])/fConeSize;
+  Double_t etaHigh = (etaC+fConeSize-fGridEtaMin[igrid])/fConeSize;
+  Int_t etaBinMin  = int(TMath::Min(TMath::Max(etaLow , -2.), nEta+1.)) - 1;
+  Int_t etaBinMax  = int(TMath::Min(TMath::Max(etaHigh, -2.), nEta+1.)) + 1;
+
+  Int_t phiBinC    = TMath::Min(TMath::Max(int(phiC/phiCellSize), 0), nPhi-1);
+  Int_t phiHalf    = int(fConeSize/phiCellSize) + 2;
+  Bool_t allPhi    = (2*phiHalf+1 >= nPhi);
+
+  for(Int_t ieta = 0; ieta < nEta; ieta++)
+  {
+    Bool_t inEtaRange = (ieta >= etaBinMin && ieta <= etaBinMax);
 
+    if ( !inEtaRange && !bands ) continue;
+
+    // Full phi band, or phi range covering all phi, take the full row
+    if ( allPhi || (inEtaRange && bands) )
+    {
+      fGridSelected.insert(fGridSelected.end(),
+                           index.begin()+cellFirst[ ieta   *nPhi],
+                           index.begin()+cellFirst[(ieta+1)*nPhi]);
+      continue;
+    }
+
+    for(Int_t jphi = -phiHalf; jphi <= phiHalf; jphi++)
+    {
+      Int_t iphi  = (phiBinC+jphi+nPhi) % nPhi;
+      Int_t icell = ieta*nPhi+iphi;
+
+      fGridSelected.insert(fGridSelected.end(),
+                           index.begin()+cellFirst[icell],
+                           index.begin()+cellFirst[icell+1]);
+    }
+  }
+
+  std::sort(fGridSelected.begin(), fGridSelected.end());
+}
@@ -21,11 +21,13 @@
 #include <TObject.h>
 class TObjArray ;
 #include <TLorentzVector.h>
+#include <vector>
 
 // --- ANALYSIS system ---
 class AliAODPWG4ParticleCorrelation ;
 class AliCaloTrackReader ;
 class AliCaloPID;
+class AliCalorimeterUtils;
 
 class AliIsolationCut : public TObject {
 
@@ -108,9 +110,25 @@ class AliIsolationCut : public TObject {
   void       SetFracIsThresh(Bool_t f )                        { fFracIsThresh      = f    ; }
   void       SetTrackMatchedClusterRejectionInCone(Bool_t tm)  { fIsTMClusterInConeRejected = tm ; }
   void       SetMinDistToTrigger(Float_t md)                   { fDistMinToTrigger  = md   ; }
+
+  void       SwitchOnParticleGrid()                            { fUseParticleGrid   = kTRUE  ; }
+  void       SwitchOffParticleGrid()                           { fUseParticleGrid   = kFALSE ; }
+  Bool_t     IsParticleGridOn()       const { return fUseParticleGrid ; }
     
  private:
 
+  // Fast access to particles and cells around the candidate
+
+  void       FillParticleGrid(Int_t igrid, TObjArray * list, AliCaloTrackReader * reader) ;
+
+  void       SelectParticlesInGrid(Int_t igrid, Float_t etaC, Float_t phiC, Bool_t bands) ;
+
+  void       FillCellStatusTable(AliCaloTrackReader * reader) const ;
+
+  Int_t      GetNBadCells(Int_t colMin, Int_t colMax, Int_t rowMin, Int_t rowMax) const ;
+
+  Int_t      GetConeHalfWidth(Int_t sqrSize, Int_t drow) const ;
+
   Float_t    fConeSize ;         ///< Size of the isolation cone
 
   Float_t    fPtThreshold ;      ///< Minimum pt of the particles in the cone or sum in cone (UE pt mean in the forward region cone)
@@ -139,6 +157,44 @@ class AliIsolationCut : public TObject {
 
   TVector3   fTrackVector;       //!<! Track moment, temporal object.
 
+  Bool_t     fUseParticleGrid;   ///<  Select the tracks and clusters close to the candidate with an eta-phi grid filled once per event.
+
+  TObjArray * fGridList[2];      //!<! Track (0) and cluster (1) list used to fill the grid.
+
+  Int_t      fGridGeneration[2]; //!<! AliCaloTrackReader::GetEventGeneration() when the grid was filled.
+
+  Float_t    fGridCellSize[2];   //!<! Eta size of the grid cells, the cone size when the grid was filled.
+
+  Float_t    fGridEtaMin[2];     //!<! Lower eta edge of the grid.
+
+  Int_t      fGridNEta[2];       //!<! Number of grid cells in eta.
+
+  Int_t      fGridNPhi[2];       //!<! Number of grid cells in phi, covering 2 pi.
+
+  std::vector< std::vector<Int_t> > fGridCellFirst; //!<! Per grid, position in fGridIndex of the first particle of each cell.
+
+  std::vector< std::vector<Int_t> > fGridIndex;     //!<! Per grid, list indices ordered by cell.
+
+  std::vector< std::vector<Int_t> > fGridNoCell;    //!<! Per grid, list indices without valid eta-phi, always selected.
+
+  std::vector<Int_t>   fGridSelected;      //!<! List indices selected for the current candidate, ascending.
+
+  std::vector<Int_t>   fGridParticleCell;  //!<! Cell of each list entry, temporal.
+
+  mutable Int_t fCellTableRun;   //!<! Run number of the bad cell table.
+
+  mutable AliCalorimeterUtils * fCellTableCaloUtils; //!<! Calorimeter utils used to fill the bad cell table.
+
+  mutable Int_t fCellTableNCols; //!<! Number of EMCal columns in the bad cell table.
+
+  mutable Int_t fCellTableNRows; //!<! Number of EMCal rows in the bad cell table.
+
+  mutable std::vector<Int_t> fCellTableBadSum;   //!<! Summed area table of bad cells, (nCols+1)*(nRows+1).
+
+  mutable Int_t fCellConeSize;   //!<! Cone size in cell units of fCellConeHalfWidth.
+
+  mutable std::vector<Int_t> fCellConeHalfWidth; //!<! Half width in columns of the cone for each row distance, -1 if row not in cone.
+
   /// Copy constructor not implemented.
   AliIsolationCut(              const AliIsolationCut & g) ;
 
@@ -146,7 +202,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,11) ;
+  ClassDef(AliIsolationCut,12) ;
   /// \endcond
 
 } ;
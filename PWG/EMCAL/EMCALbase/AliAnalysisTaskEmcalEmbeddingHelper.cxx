@@ -17,11 +17,17 @@
 #include <vector>
 #include <algorithm>
 #include <fstream>
+#include <chrono>
 
 #include <TFile.h>
 #include <TMath.h>
-#include <TRandom.h>
+#include <TRandom3.h>
 #include <TChain.h>
+#include <TList.h>
+#include <TClonesArray.h>
+#include <TH1F.h>
+#include <TROOT.h>
+#include <RVersion.h>
 #include <TGrid.h>
 #include <TSystem.h>
 #include <TUUID.h>
@@ -30,6 +36,11 @@
 #include <AliAnalysisManager.h>
 #include <AliVEvent.h>
 #include <AliAODEvent.h>
+#include <AliAODTrack.h>
+#include <AliAODCaloCluster.h>
+#include <AliAODVertex.h>
+#include <AliAODv0.h>
+#include <AliAODcascade.h>
 #include <AliESDEvent.h>
 #include <AliInputEventHandler.h>
 
@@ -58,6 +69,9 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fTriggerMask(AliVEvent::kAny),
   fZVertexCut(10),
   fMaxVertexDist(999),
+  fBranchesToRead(),
+  fCacheSize(0),
+  fPrefetchDepth(0),
   fExternalFile(0),
   fCurrentEntry(0),
   fLowerEntry(0),
@@ -69,7 +83,16 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fInitializedNewFile(false),
   fWrappedAroundTree(false),
   fChain(0),
-  fExternalEvent(0)
+  fExternalEvent(0),
+  fReaderEvent(0),
+  fPrefetchRandom(0),
+  fPrefetchSlots(),
+  fPrefetchHead(0),
+  fPrefetchCount(0),
+  fPrefetchStop(kFALSE),
+  fOutput(0),
+  fHistStallTime(0),
+  fHistPrefetchFill(0)
 {
   if (fgInstance != 0) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -98,6 +121,9 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fTriggerMask(AliVEvent::kAny),
   fZVertexCut(10),
   fMaxVertexDist(999),
+  fBranchesToRead(),
+  fCacheSize(0),
+  fPrefetchDepth(0),
   fExternalFile(0),
   fCurrentEntry(0),
   fLowerEntry(0),
@@ -109,7 +135,16 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fInitializedNewFile(false),
   fWrappedAroundTree(false),
   fChain(0),
-  fExternalEvent(0)
+  fExternalEvent(0),
+  fReaderEvent(0),
+  fPrefetchRandom(0),
+  fPrefetchSlots(),
+  fPrefetchHead(0),
+  fPrefetchCount(0),
+  fPrefetchStop(kFALSE),
+  fOutput(0),
+  fHistStallTime(0),
+  fHistPrefetchFill(0)
 {
   if (fgInstance != 0) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -117,6 +152,8 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   }
 
   fgInstance = this;
+
+  DefineOutput(1, TList::Class());
 }
 
 /**
@@ -126,8 +163,12 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
  */
 AliAnalysisTaskEmcalEmbeddingHelper::~AliAnalysisTaskEmcalEmbeddingHelper()
 {
+  StopPrefetching();
   if (fgInstance == this) fgInstance = 0;
   if (fExternalEvent) delete fExternalEvent;
+  if (fReaderEvent) delete fReaderEvent;
+  for (auto slot : fPrefetchSlots) delete slot;
+  if (fPrefetchRandom) delete fPrefetchRandom;
   if (fExternalFile) {
     fExternalFile->Close();
     delete fExternalFile;
@@ -287,9 +328,7 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::GenerateUniqueFileListFilename(
 
 /**
  * Get the next event (entry) in the TChain to make it available for embedding. The event will be selected
- * according to the conditions determined in IsEventSelected(). If needed it calls InitTree() to setup the
- * next tree within the TChain. In the case of running of out files to embed, an error is thrown and embedding
- * begins again from the start of the file list.
+ * according to the conditions determined in IsEventSelected(). The entries are loaded by LoadNextEntry().
  *
  * @return kTRUE if successful
  */
@@ -298,54 +337,8 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
   Int_t attempts = -1;
 
   do {
-    // Reset to start of tree
-    if (fCurrentEntry == fUpperEntry) {
-      fCurrentEntry = fLowerEntry;
-      fWrappedAroundTree = true;
-    }
-
-    if ((fCurrentEntry < fLowerEntry + fOffset) || !fWrappedAroundTree) {
-      // Continue with GetEntry as normal
-    }
-    else {
-      // NOTE: On transition from one file to the next, this calls the next entry that would be expected.
-      //       However, if it is for the last file, it tries to GetEntry() of one entry past the end of the last file.
-      //       Normally, this would be a problem, however GetEntry() just doesn't fill the fields of an invalid index
-      //       instead of throwing an error. So "invalid values" are filled for a file that doesn't exist, but then 
-      //       they are immediately replaced by the lines below that reset the access values and re-init the tree.
-      //       The benefit of this approach is it simplies file counting (we don't need to carefully increment here
-      //       and in InitTree()) and preserves the desired behavior when we are not at the last file.
-      InitTree();
-    }
-
-    // Load current event
-    // Can be a simple less than, because fFileNumber counts from 0.
-    if (fFileNumber < fMaxNumberOfFiles) {
-      fChain->GetEntry(fCurrentEntry);
-    }
-    else {
-      AliError("====================================================================================================");
-      AliError("== No more files available to embed from the TChain! Restarting from the beginning of the TChain! ==");
-      AliError("== Be careful to check that this is the desired action!                                           ==");
-      AliError("====================================================================================================");
-
-      // Reset the relevant access values
-      // fCurrentEntry and fLowerEntry are automatically reset in InitTree()
-      fFileNumber = 0;
-      fUpperEntry = 0;
-
-      // Re-init back to the start
-      InitTree();
-
-      // Access the relevant entry
-      // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
-      fChain->GetEntry(fCurrentEntry);
-    }
-    AliDebug(4, TString::Format("Loading entry %i between %i-%i, starting with offset %i from the lower bound of %i", fCurrentEntry, fLowerEntry, fUpperEntry, fOffset, fLowerEntry));
+    LoadNextEntry();
 
-    // Increment current entry
-    fCurrentEntry++;
-    
     // Provide a check for number of attempts
     attempts++;
     if (attempts == 1000)
@@ -358,6 +351,64 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
   return kTRUE;
 }
 
+/**
+ * Load the next entry of the TChain into the event connected to it. If needed it calls InitTree() to setup the
+ * next tree within the TChain. In the case of running of out files to embed, an error is thrown and embedding
+ * begins again from the start of the file list.
+ *
+ * When prefetching, it is only called by the prefetch thread.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::LoadNextEntry()
+{
+  // Reset to start of tree
+  if (fCurrentEntry == fUpperEntry) {
+    fCurrentEntry = fLowerEntry;
+    fWrappedAroundTree = true;
+  }
+
+  if ((fCurrentEntry < fLowerEntry + fOffset) || !fWrappedAroundTree) {
+    // Continue with GetEntry as normal
+  }
+  else {
+    // NOTE: On transition from one file to the next, this calls the next entry that would be expected.
+    //       However, if it is for the last file, it tries to GetEntry() of one entry past the end of the last file.
+    //       Normally, this would be a problem, however GetEntry() just doesn't fill the fields of an invalid index
+    //       instead of throwing an error. So "invalid values" are filled for a file that doesn't exist, but then 
+    //       they are immediately replaced by the lines below that reset the access values and re-init the tree.
+    //       The benefit of this approach is it simplies file counting (we don't need to carefully increment here
+    //       and in InitTree()) and preserves the desired behavior when we are not at the last file.
+    InitTree();
+  }
+
+  // Load current event
+  // Can be a simple less than, because fFileNumber counts from 0.
+  if (fFileNumber < fMaxNumberOfFiles) {
+    fChain->GetEntry(fCurrentEntry);
+  }
+  else {
+    AliError("====================================================================================================");
+    AliError("== No more files available to embed from the TChain! Restarting from the beginning of the TChain! ==");
+    AliError("== Be careful to check that this is the desired action!                                           ==");
+    AliError("====================================================================================================");
+
+    // Reset the relevant access values
+    // fCurrentEntry and fLowerEntry are automatically reset in InitTree()
+    fFileNumber = 0;
+    fUpperEntry = 0;
+
+    // Re-init back to the start
+    InitTree();
+
+    // Access the relevant entry
+    // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
+    fChain->GetEntry(fCurrentEntry);
+  }
+  AliDebug(4, TString::Format("Loading entry %i between %i-%i, starting with offset %i from the lower bound of %i", fCurrentEntry, fLowerEntry, fUpperEntry, fOffset, fLowerEntry));
+
+  // Increment current entry
+  fCurrentEntry++;
+}
+
 /**
  * Performs an event selection on the current external event.
  *
@@ -411,11 +462,7 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::IsEventSelected()
     externalVert->GetXYZ(externalVertex);
     inputVert->GetXYZ(inputVertex);
 
-    if (TMath::Abs(externalVertex[2]) > fZVertexCut) {
-      AliDebug(3, Form("Event rejected due to Z vertex selection. Event Z vertex: %f, Z vertex cut: %f",
-       externalVertex[2], fZVertexCut));
-      return kFALSE;
-    }
+    if (!IsExternalEventSelected(fExternalEvent)) return kFALSE;
     Double_t dist = TMath::Sqrt((externalVertex[0]-inputVertex[0])*(externalVertex[0]-inputVertex[0])+(externalVertex[1]-inputVertex[1])*(externalVertex[1]-inputVertex[1])+(externalVertex[2]-inputVertex[2])*(externalVertex[2]-inputVertex[2]));
     if (dist > fMaxVertexDist) {
       AliDebug(3, Form("Event rejected because the distance between the current and embedded vertices is > %f. "
@@ -433,8 +480,170 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::IsEventSelected()
   return kTRUE;
 }
 
+/**
+ * Performs the part of the event selection which only depends on the external event. When prefetching, it is
+ * applied by the prefetch thread, such that rejected events are not buffered.
+ *
+ * @param[in] event External event
+ * @return kTRUE if the event passes the z vertex cut
+ */
+Bool_t AliAnalysisTaskEmcalEmbeddingHelper::IsExternalEventSelected(const AliVEvent * event) const
+{
+  const AliVVertex *externalVert = event->GetPrimaryVertex();
+  if (!externalVert) return kTRUE;
+
+  if (TMath::Abs(externalVert->GetZ()) > fZVertexCut) {
+    AliDebug(3, Form("Event rejected due to Z vertex selection. Event Z vertex: %f, Z vertex cut: %f",
+     externalVert->GetZ(), fZVertexCut));
+    return kFALSE;
+  }
+
+  return kTRUE;
+}
+
+/**
+ * Create an event of the type stored in the external tree.
+ *
+ * @return New event, 0 if the tree name is not recognized
+ */
+AliVEvent* AliAnalysisTaskEmcalEmbeddingHelper::CreateEvent() const
+{
+  if (fTreeName == "aodTree") {
+    return new AliAODEvent();
+  }
+  else if (fTreeName == "esdTree") {
+    return new AliESDEvent();
+  }
+
+  AliError(Form("Tree name %s not recognized!", fTreeName.Data()));
+  return 0;
+}
+
+/**
+ * Copy the content of an external event into another event. The objects already present in the
+ * destination event are kept and overwritten, such that pointers to them stay valid. The TRef links
+ * of the copied AOD objects are cleared, see ClearReferences().
+ *
+ * @param[in] from Event to be copied
+ * @param[out] to Destination event
+ * @return kTRUE if successful
+ */
+Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CopyEvent(const AliVEvent * from, AliVEvent * to) const
+{
+  const AliAODEvent * aodFrom = dynamic_cast<const AliAODEvent*>(from);
+  AliAODEvent * aodTo = dynamic_cast<AliAODEvent*>(to);
+  if (aodFrom && aodTo) {
+    *aodTo = *aodFrom;
+    ClearReferences(aodTo);
+    return kTRUE;
+  }
+
+  const AliESDEvent * esdFrom = dynamic_cast<const AliESDEvent*>(from);
+  AliESDEvent * esdTo = dynamic_cast<AliESDEvent*>(to);
+  if (esdFrom && esdTo) {
+    *esdTo = *esdFrom;
+    return kTRUE;
+  }
+
+  return kFALSE;
+}
+
+/**
+ * Clear the TRef links of the objects of a copied AOD event (production vertex of the tracks, tracks matched
+ * to the clusters, daughters of the vertices and secondary vertex of the V0s and cascades). A TRef resolves to
+ * the object last read with its unique ID, i.e. into the event connected to the TChain, which is overwritten
+ * by the prefetch thread while the copy is still buffered or used.
+ *
+ * @param[in,out] event Copied event
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::ClearReferences(AliVEvent * event) const
+{
+  AliAODEvent * aod = dynamic_cast<AliAODEvent*>(event);
+  if (!aod) return;
+
+  for (Int_t i = 0; i < aod->GetNumberOfTracks(); i++) {
+    AliAODTrack * track = dynamic_cast<AliAODTrack*>(aod->GetTrack(i));
+    if (track) track->SetProdVertex(0);
+  }
+
+  for (Int_t i = 0; i < aod->GetNumberOfCaloClusters(); i++) {
+    AliAODCaloCluster * cluster = aod->GetCaloCluster(i);
+    if (!cluster) continue;
+    // The references still resolve into the event the copy was made from
+    for (Int_t j = cluster->GetNTracksMatched() - 1; j >= 0; j--) {
+      cluster->RemoveTrackMatched(cluster->GetTrackMatched(j));
+    }
+  }
+
+  for (Int_t i = 0; i < aod->GetNumberOfVertices(); i++) {
+    AliAODVertex * vertex = aod->GetVertex(i);
+    if (vertex) vertex->RemoveDaughters();
+  }
+
+  for (Int_t i = 0; i < aod->GetNumberOfV0s(); i++) {
+    AliAODv0 * v0 = aod->GetV0(i);
+    if (v0) v0->SetSecondaryVtx(0);
+  }
+
+  for (Int_t i = 0; i < aod->GetNumberOfCascades(); i++) {
+    AliAODcascade * cascade = aod->GetCascade(i);
+    if (cascade) cascade->SetSecondaryVtx(0);
+  }
+}
+
+/**
+ * Move the content of a prefetched event into the external event. The objects of the arrays are exchanged
+ * between the two events instead of being copied, while the arrays themselves stay in place, such that the
+ * arrays of the external event cached by the containers stay valid. The other objects (header, cells...)
+ * are copied. The source event receives the objects of the previous external event, which are overwritten
+ * when the slot is filled again.
+ *
+ * @param[in,out] from Prefetched event
+ * @param[out] to External event
+ * @return kTRUE if successful
+ */
+Bool_t AliAnalysisTaskEmcalEmbeddingHelper::MoveEvent(AliVEvent * from, AliVEvent * to) const
+{
+  TList * listFrom = from->GetList();
+  TList * listTo = to->GetList();
+  if (!listFrom || !listTo) return kFALSE;
+
+  // The content of the external event is created with the first copy
+  if (listTo->GetEntries() != listFrom->GetEntries()) {
+    return CopyEvent(from, to);
+  }
+
+  TIter next(listFrom);
+  while (TObject * its = next()) {
+    TObject * mine = listTo->FindObject(its->GetName());
+    if (!mine) return CopyEvent(from, to);
+
+    TClonesArray * itsArray = dynamic_cast<TClonesArray*>(its);
+    if (itsArray) {
+      TClonesArray * mineArray = static_cast<TClonesArray*>(mine);
+      TClonesArray tmp(itsArray->GetClass(), itsArray->GetEntriesFast() + 1);
+      tmp.AbsorbObjects(mineArray);
+      mineArray->AbsorbObjects(itsArray);
+      itsArray->AbsorbObjects(&tmp);
+    }
+    else if (!its->InheritsFrom(TCollection::Class())) {
+      its->Copy(*mine);
+    }
+  }
+
+  // The moved tracks still point to the prefetched event
+  AliAODEvent * aod = dynamic_cast<AliAODEvent*>(to);
+  if (aod) aod->ConnectTracks();
+  AliESDEvent * esd = dynamic_cast<AliESDEvent*>(to);
+  if (esd) esd->ConnectTracks();
+
+  return kTRUE;
+}
+
 /**
  * Initialize the external event by creating an event and then reading the event info from the TChain.
+ * When prefetching, the TChain is connected to a separate event, which is copied into the slots of the ring
+ * buffer. The slots are then moved into the external event.
  *
  * @return kTRUE if successful
  */
@@ -443,23 +652,60 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::InitEvent()
   if (!fChain) return kFALSE;
 
   if (!fExternalEvent) {
-    if (fTreeName == "aodTree") {
-      fExternalEvent = new AliAODEvent();
-    }
-    else if (fTreeName == "esdTree") {
-      fExternalEvent = new AliESDEvent();
-    }
-    else {
-      AliError(Form("Tree name %s not recognized!", fTreeName.Data()));
-      return kFALSE;
+    fExternalEvent = CreateEvent();
+    if (!fExternalEvent) return kFALSE;
+  }
+
+  if (fPrefetchDepth > 0) {
+    if (!fReaderEvent) {
+      fReaderEvent = CreateEvent();
+      if (!fReaderEvent) return kFALSE;
     }
+    fReaderEvent->ReadFromTree(fChain, fTreeName);
+  }
+  else {
+    fExternalEvent->ReadFromTree(fChain, fTreeName);
   }
 
-  fExternalEvent->ReadFromTree(fChain, fTreeName);
+  SetupBranches();
 
   return kTRUE;
 }
 
+/**
+ * Restrict the branches read from the TChain to the ones requested with AddBranchToRead(), together with the
+ * header and vertex branches needed by the event selection, and set the size of the TTreeCache. Since the
+ * cache learns which branches are used during the first entries, only the enabled branches are prefetched.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::SetupBranches()
+{
+  if (fCacheSize > 0) {
+    fChain->SetCacheSize(fCacheSize);
+  }
+
+  if (fBranchesToRead.empty()) return;
+
+  fChain->SetBranchStatus("*", 0);
+
+  std::vector<std::string> branches(fBranchesToRead);
+  if (fTreeName == "aodTree") {
+    branches.push_back("header*");
+    branches.push_back("vertices*");
+  }
+  else {
+    branches.push_back("AliESDRun*");
+    branches.push_back("AliESDHeader*");
+    branches.push_back("PrimaryVertex*");
+    branches.push_back("SPDVertex*");
+    branches.push_back("TPCVertex*");
+  }
+
+  for (auto branch : branches) {
+    AliDebug(2, Form("Reading branch %s of the external tree", branch.c_str()));
+    fChain->SetBranchStatus(branch.c_str(), 1);
+  }
+}
+
 /**
  * Performing run-independent initialization to setup embedding.
  *
@@ -467,7 +713,19 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::InitEvent()
  */
 void AliAnalysisTaskEmcalEmbeddingHelper::UserCreateOutputObjects()
 {
+  fOutput = new TList();
+  fOutput->SetOwner();
+
+  fHistStallTime = new TH1F("fHistStallTime", "Time needed to obtain the external event;#it{t} (ms);events", 500, 0, 50);
+  fOutput->Add(fHistStallTime);
+
+  fHistPrefetchFill = new TH1F("fHistPrefetchFill", "Prefetched external events available when requested;events in buffer;events",
+      fPrefetchDepth + 1, -0.5, fPrefetchDepth + 0.5);
+  fOutput->Add(fHistPrefetchFill);
+
   SetupEmbedding();
+
+  PostData(1, fOutput);
 }
 
 /**
@@ -564,6 +822,8 @@ void AliAnalysisTaskEmcalEmbeddingHelper::SetupEmbedding()
   }
   
   fInitializedEmbedding = kTRUE;
+
+  if (fPrefetchDepth > 0) StartPrefetching();
 }
 
 /**
@@ -593,7 +853,8 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   // Jump ahead at random if desired
   // Determines the offset into the tree
   if (fRandomEventNumberAccess) {
-    fOffset = TMath::Nint(gRandom->Rndm()*(fUpperEntry-fLowerEntry))-1;
+    TRandom * random = fPrefetchRandom ? fPrefetchRandom : gRandom;
+    fOffset = TMath::Nint(random->Rndm()*(fUpperEntry-fLowerEntry))-1;
   }
   else {
     fOffset = 0;
@@ -632,11 +893,24 @@ void AliAnalysisTaskEmcalEmbeddingHelper::UserExec(Option_t*)
     SetupEmbedding();
   }
 
-  if (!fInitializedNewFile) {
-    InitTree();
+  auto start = std::chrono::steady_clock::now();
+
+  Bool_t res = kFALSE;
+  if (fPrefetchThread.joinable()) {
+    res = GetNextPrefetchedEntry();
+  }
+  else {
+    if (!fInitializedNewFile) {
+      InitTree();
+    }
+
+    res = GetNextEntry();
   }
 
-  Bool_t res = GetNextEntry();
+  std::chrono::duration<double, std::milli> stall = std::chrono::steady_clock::now() - start;
+  if (fHistStallTime) fHistStallTime->Fill(stall.count());
+
+  PostData(1, fOutput);
 
   if (!res) {
     AliError("Unable to get the event to embed. Nothing will be embedded.");
@@ -644,6 +918,137 @@ void AliAnalysisTaskEmcalEmbeddingHelper::UserExec(Option_t*)
   }
 }
 
+/**
+ * Start the thread reading the external events ahead of time. The ring buffer holds fPrefetchDepth
+ * events. Requires ROOT 6, since the I/O of the prefetch thread runs concurrently to the one of the
+ * analysis manager.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::StartPrefetching()
+{
+  if (fPrefetchThread.joinable() || !fReaderEvent) return;
+
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,0,0)
+  AliWarning("Prefetching the external events requires ROOT 6. The events will be read synchronously.");
+  fExternalEvent->ReadFromTree(fChain, fTreeName);
+  fPrefetchDepth = 0;
+  return;
+#else
+  ROOT::EnableThreadSafety();
+
+  // The random entry point of the files is chosen by the prefetch thread
+  if (!fPrefetchRandom) fPrefetchRandom = new TRandom3(gRandom->Integer(kMaxUInt));
+
+  for (auto slot : fPrefetchSlots) delete slot;
+  fPrefetchSlots.clear();
+  for (Int_t i = 0; i < fPrefetchDepth; i++) fPrefetchSlots.push_back(CreateEvent());
+  fPrefetchHead = 0;
+  fPrefetchCount = 0;
+  fPrefetchStop = kFALSE;
+
+  AliInfo(Form("Prefetching up to %i external events in a background thread", fPrefetchDepth));
+  fPrefetchThread = std::thread(RunPrefetchLoop, this);
+#endif
+}
+
+/**
+ * Stop the prefetch thread, if running, and wait for it to finish.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::StopPrefetching()
+{
+  if (!fPrefetchThread.joinable()) return;
+
+  {
+    std::lock_guard<std::mutex> lock(fPrefetchMutex);
+    fPrefetchStop = kTRUE;
+  }
+  fPrefetchFreed.notify_all();
+  fPrefetchThread.join();
+}
+
+/**
+ * Loop of the prefetch thread: load the entries of the chain, skip the ones failing the selection on the
+ * external event and copy the accepted ones into the free slots of the ring buffer. The thread is the only
+ * user of the chain once started.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::PrefetchLoop()
+{
+  const Int_t nSlots = fPrefetchSlots.size();
+
+  if (!fInitializedNewFile) {
+    InitTree();
+  }
+
+  while (kTRUE) {
+    Int_t slot = 0;
+    {
+      std::unique_lock<std::mutex> lock(fPrefetchMutex);
+      fPrefetchFreed.wait(lock, [this, nSlots] { return fPrefetchStop || fPrefetchCount < nSlots; });
+      if (fPrefetchStop) return;
+      slot = (fPrefetchHead + fPrefetchCount) % nSlots;
+    }
+
+    // The free slot is not accessed by the analysis thread until it is published
+    do {
+      LoadNextEntry();
+    } while (!IsExternalEventSelected(fReaderEvent));
+    CopyEvent(fReaderEvent, fPrefetchSlots[slot]);
+
+    {
+      std::lock_guard<std::mutex> lock(fPrefetchMutex);
+      fPrefetchCount++;
+    }
+    fPrefetchFilled.notify_one();
+  }
+}
+
+/**
+ * Make the next prefetched event available as the external event, waiting for the prefetch thread if
+ * the ring buffer is empty. The selection depending on the internal event is applied here.
+ *
+ * @return kTRUE if successful
+ */
+Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextPrefetchedEntry()
+{
+  const Int_t nSlots = fPrefetchSlots.size();
+  Int_t attempts = -1;
+  Bool_t res = kFALSE;
+
+  do {
+    Int_t slot = 0;
+    {
+      std::unique_lock<std::mutex> lock(fPrefetchMutex);
+      if (attempts == -1) fHistPrefetchFill->Fill(fPrefetchCount);
+      fPrefetchFilled.wait(lock, [this] { return fPrefetchCount > 0; });
+      slot = fPrefetchHead;
+    }
+
+    res = MoveEvent(fPrefetchSlots[slot], fExternalEvent);
+
+    {
+      std::lock_guard<std::mutex> lock(fPrefetchMutex);
+      fPrefetchHead = (fPrefetchHead + 1) % nSlots;
+      fPrefetchCount--;
+    }
+    fPrefetchFreed.notify_one();
+
+    // Provide a check for number of attempts
+    attempts++;
+    if (attempts == 1000)
+      AliWarning("After 1000 attempts no event has been accepted by the event selection (trigger, centrality...)!");
+
+  } while (res && !IsEventSelected());
+
+  return res;
+}
+
+/**
+ * Stop the prefetch thread at the end of the processing of the events.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::FinishTaskOutput()
+{
+  StopPrefetching();
+}
+
 /**
  * This function is called once at the end of the analysis.
  */
@@ -695,16 +1100,16 @@ AliAnalysisTaskEmcalEmbeddingHelper * AliAnalysisTaskEmcalEmbeddingHelper::AddTa
   // Create containers for input/output
   AliAnalysisDataContainer* cInput = mgr->GetCommonInputContainer();
 
-  /*TString outputContainerName(name);
+  TString outputContainerName(name);
   outputContainerName += "_histos";
 
   AliAnalysisDataContainer * cOutput = mgr->CreateContainer(outputContainerName.Data(),
       TList::Class(),
       AliAnalysisManager::kOutputContainer,
-      Form("%s", AliAnalysisManager::GetCommonFileName()));*/
+      Form("%s", AliAnalysisManager::GetCommonFileName()));
 
   mgr->ConnectInput(embeddingHelper, 0, cInput);
-  //mgr->ConnectOutput(embeddingHelper, 1, cOutput);
+  mgr->ConnectOutput(embeddingHelper, 1, cOutput);
 
   return embeddingHelper;
 }
@@ -19,8 +19,17 @@
 class TString;
 class TChain;
 class TFile;
+class TList;
+class TH1;
+class TRandom;
 class AliVEvent;
 
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
 #include <AliAnalysisTaskSE.h>
 
 /**
@@ -42,6 +51,18 @@ class AliVEvent;
  *
  * Note that only one instance of this class is allowed in each train (singleton class).
  *
+ * To reduce the time the event loop spends waiting for the external event:
+ * - Only the branches needed by the embedded input objects can be read (AddBranchToRead()). The header
+ *   and vertex branches required by the event selection are always read.
+ * - The external events can be read ahead of time by a background thread (SetPrefetchDepth()). It
+ *   reads and decompresses the entries, including the opening of the next file, rejects the events failing
+ *   the selection which only depends on the external event (z vertex) and keeps the accepted events in a ring
+ *   buffer. UserExec() then only copies the next buffered event into the external event and applies the
+ *   selection depending on the internal event. The external event object (and the arrays it holds) does
+ *   not change, so the containers pointing to it are unaffected. Requires ROOT 6.
+ * The time needed by UserExec() to obtain the external event (the stall of the event loop) is histogrammed
+ * in the output list.
+ *
  * For the user, most of these details are handled by AliEmcalContainer derived tasks.
  * To access the embedded input objects, the user simply needs to set
  * AliEmcalContainer::SetIsEmbedding(Bool_t). This design ensures that usage is nearly
@@ -67,6 +88,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void      UserCreateOutputObjects()                            ;
   void      SetPtHardBin(Int_t r)                                 { fPtHardBin           = r; }
   void      SetAnchorRun(Int_t r)                                 { fAnchorRun           = r; }
+  void      FinishTaskOutput()                                   ;
   void      Terminate(Option_t *option)                          ;
 
   static const AliAnalysisTaskEmcalEmbeddingHelper* GetInstance() { return fgInstance       ; }
@@ -98,6 +120,14 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetZVertexCut(Double_t zVertex)                            { fZVertexCut = zVertex; }
   void SetMaxVertexDistance(Double_t distance)                    { fMaxVertexDist = distance; }
 
+  /// Read only the given branch (and the branches needed by the event selection). Wildcards as in TTree::SetBranchStatus()
+  void AddBranchToRead(const char * branchName)                   { fBranchesToRead.push_back(branchName); }
+  /// Size of the TTreeCache of the external chain (0 for the ROOT default)
+  void SetCacheSize(Long64_t size)                                { fCacheSize = size; }
+  /// Number of external events read ahead of time in a background thread (0 to read synchronously)
+  void SetPrefetchDepth(Int_t n)                                  { fPrefetchDepth = n; }
+  Int_t GetPrefetchDepth()                                  const { return fPrefetchDepth; }
+
   static AliAnalysisTaskEmcalEmbeddingHelper * AddTaskEmcalEmbeddingHelper();
 
  protected:
@@ -106,13 +136,29 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void            SetupEmbedding()      ;
   Bool_t          SetupInputFiles()     ;
   Bool_t          GetNextEntry()        ;
+  void            LoadNextEntry()       ;
   Bool_t          IsEventSelected()     ;
+  Bool_t          IsExternalEventSelected(const AliVEvent * event) const;
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
+  void            SetupBranches()       ;
+  AliVEvent*      CreateEvent()   const ;
+  Bool_t          CopyEvent(const AliVEvent * from, AliVEvent * to) const;
+  void            ClearReferences(AliVEvent * event) const;
+  Bool_t          MoveEvent(AliVEvent * from, AliVEvent * to) const;
+
+  void            StartPrefetching()    ;
+  void            StopPrefetching()     ;
+  void            PrefetchLoop()        ;
+  Bool_t          GetNextPrefetchedEntry();
+  static void     RunPrefetchLoop(AliAnalysisTaskEmcalEmbeddingHelper * task) { task->PrefetchLoop(); }
 
   UInt_t                                        fTriggerMask;       ///<  Trigger selection mask
   Double_t                                      fZVertexCut;        ///<  Z vertex cut on embedded event
   Double_t                                      fMaxVertexDist;     ///<  Max distance between Z vertex of internal and embedded event
+  std::vector <std::string>                     fBranchesToRead;    ///<  Branches of the external tree to read (all if empty)
+  Long64_t                                      fCacheSize;         ///<  Size of the TTreeCache of the external chain (0 for the ROOT default)
+  Int_t                                         fPrefetchDepth;     ///<  Number of external events read ahead in a background thread
 
   bool                                          fInitializedNewFile; //!<! Notes where the entry indices have been initialized for a new tree in the chain
   bool                                          fInitializedEmbedding; //!<! Notes where the TChain has been initialized for embedding
@@ -137,6 +183,22 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Int_t                                         fMaxNumberOfFiles ; //!<! Max number of files that are in the TChain
   Int_t                                         fFileNumber       ; //!<! File number corresponding to the current tree
   AliVEvent                                    *fExternalEvent    ; //!<! Current external event available for embedding
+  AliVEvent                                    *fReaderEvent      ; //!<! Event connected to the chain when prefetching
+  TRandom                                      *fPrefetchRandom   ; //!<! Random generator of the prefetch thread
+  std::vector <AliVEvent*>                      fPrefetchSlots    ; //!<! Ring buffer of prefetched external events
+  Int_t                                         fPrefetchHead     ; //!<! Index of the next prefetched event to be used
+  Int_t                                         fPrefetchCount    ; //!<! Number of prefetched events available
+  Bool_t                                        fPrefetchStop     ; //!<! Request to stop the prefetch thread
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+  std::thread                                   fPrefetchThread   ; //!<! Prefetch thread
+  std::mutex                                    fPrefetchMutex    ; //!<! Protects the ring buffer
+  std::condition_variable                       fPrefetchFilled   ; //!<! Signals that an event was prefetched
+  std::condition_variable                       fPrefetchFreed    ; //!<! Signals that a slot was freed
+#endif
+
+  TList                                        *fOutput           ; //!<! Output list
+  TH1                                          *fHistStallTime    ; //!<! Time needed to obtain the external event
+  TH1                                          *fHistPrefetchFill ; //!<! Number of prefetched events available when requested
 
   static AliAnalysisTaskEmcalEmbeddingHelper   *fgInstance        ; //!<! Global instance of this class
 
@@ -145,7 +207,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 1);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 2);
   /// \endcond
 };
 #endif
@@ -73,6 +73,41 @@ void AliEmcalCorrectionCellBadChannel::UserCreateOutputObjects()
  * Called for each event to process the event data.
  */
 Bool_t AliEmcalCorrectionCellBadChannel::Run()
+{
+  if (!ConfigureCells())
+    return kFALSE;
+
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistBefore); // "before" QA
+  
+  // CELL RECALIBRATION -------------------------------------------------------
+  // update cell objects
+  UpdateCells();
+  
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistAfter); // "after" QA
+
+  return kTRUE;
+}
+
+/**
+ * Called for each event instead of Run() when the correction task applies the cell corrections
+ * in a single pass. Only the cell table is updated, the cells are not modified.
+ */
+Bool_t AliEmcalCorrectionCellBadChannel::PrepareCellTable()
+{
+  if (!ConfigureCells())
+    return kFALSE;
+
+  UpdateCellTable(fCellEnergyDistBefore, fCellEnergyDistAfter, kFALSE);
+
+  return kTRUE;
+}
+
+/**
+ * Configure the reco utils for the event. Common to Run() and PrepareCellTable().
+ */
+Bool_t AliEmcalCorrectionCellBadChannel::ConfigureCells()
 {
   AliEmcalCorrectionComponent::Run();
   
@@ -98,16 +133,6 @@ Bool_t AliEmcalCorrectionCellBadChannel::Run()
   // mark the cells not recalibrated
   fRecoUtils->ResetCellsCalibrated();
 
-  if(fCreateHisto)
-    FillCellQA(fCellEnergyDistBefore); // "before" QA
-  
-  // CELL RECALIBRATION -------------------------------------------------------
-  // update cell objects
-  UpdateCells();
-  
-  if(fCreateHisto)
-    FillCellQA(fCellEnergyDistAfter); // "after" QA
-
   return kTRUE;
 }
 
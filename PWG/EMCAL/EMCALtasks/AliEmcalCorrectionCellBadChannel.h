@@ -32,12 +32,17 @@ class AliEmcalCorrectionCellBadChannel : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // Fused cell corrections
+  Bool_t SupportsCellTable() const { return kTRUE; }
+  Bool_t PrepareCellTable();
   
 protected:
   TH1F* fCellEnergyDistBefore;              //!<! cell energy distribution, before bad channel correction
   TH1F* fCellEnergyDistAfter;               //!<! cell energy distribution, after bad channel correction
   
 private:
+  Bool_t ConfigureCells();
 
   AliEmcalCorrectionCellBadChannel(const AliEmcalCorrectionCellBadChannel &);             // Not implemented
   AliEmcalCorrectionCellBadChannel &operator=(const AliEmcalCorrectionCellBadChannel &);   // Not implemented
@@ -77,6 +77,49 @@ void AliEmcalCorrectionCellEnergy::UserCreateOutputObjects()
  * Called for each event to process the event data.
  */
 Bool_t AliEmcalCorrectionCellEnergy::Run()
+{
+  if (!ConfigureCells())
+    return kFALSE;
+  
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistBefore); // "before" QA
+  
+  // CELL RECALIBRATION -------------------------------------------------------
+  // update cell objects
+  UpdateCells();
+  
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistAfter); // "after" QA
+  
+  // switch off recalibrations so those are not done multiple times
+  // this is just for safety, the recalibrated flag of cell object
+  // should not allow for farther processing anyways
+  fRecoUtils->SwitchOffRecalibration();
+
+  return kTRUE;
+}
+
+/**
+ * Called for each event instead of Run() when the correction task applies the cell corrections
+ * in a single pass. Only the cell table is updated, the cells are not modified.
+ */
+Bool_t AliEmcalCorrectionCellEnergy::PrepareCellTable()
+{
+  if (!ConfigureCells())
+    return kFALSE;
+
+  UpdateCellTable(fCellEnergyDistBefore, fCellEnergyDistAfter, kFALSE);
+
+  // switch off recalibrations, as at the end of Run()
+  fRecoUtils->SwitchOffRecalibration();
+
+  return kTRUE;
+}
+
+/**
+ * Configure the reco utils for the event. Common to Run() and PrepareCellTable().
+ */
+Bool_t AliEmcalCorrectionCellEnergy::ConfigureCells()
 {
   AliEmcalCorrectionComponent::Run();
   
@@ -100,22 +143,6 @@ Bool_t AliEmcalCorrectionCellEnergy::Run()
   
   // mark the cells not recalibrated
   fRecoUtils->ResetCellsCalibrated();
-  
-  
-  if(fCreateHisto)
-    FillCellQA(fCellEnergyDistBefore); // "before" QA
-  
-  // CELL RECALIBRATION -------------------------------------------------------
-  // update cell objects
-  UpdateCells();
-  
-  if(fCreateHisto)
-    FillCellQA(fCellEnergyDistAfter); // "after" QA
-  
-  // switch off recalibrations so those are not done multiple times
-  // this is just for safety, the recalibrated flag of cell object
-  // should not allow for farther processing anyways
-  fRecoUtils->SwitchOffRecalibration();
 
   return kTRUE;
 }
@@ -32,12 +32,17 @@ class AliEmcalCorrectionCellEnergy : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // Fused cell corrections
+  Bool_t SupportsCellTable() const { return kTRUE; }
+  Bool_t PrepareCellTable();
   
 protected:
   TH1F* fCellEnergyDistBefore;        //!<! cell energy distribution, before energy calibration
   TH1F* fCellEnergyDistAfter;         //!<! cell energy distribution, after energy calibration
 
 private:
+  Bool_t                 ConfigureCells();
   Int_t                  InitRecalib();
   Int_t                  InitRunDepRecalib();
   
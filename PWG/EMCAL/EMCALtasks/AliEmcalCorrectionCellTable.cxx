@@ -0,0 +1,98 @@
+// AliEmcalCorrectionCellTable
+//
+
+#include <TH1F.h>
+
+#include "AliEMCALGeometry.h"
+#include "AliEMCALRecoUtils.h"
+
+#include "AliEmcalCorrectionCellTable.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalCorrectionCellTable);
+/// \endcond
+
+/**
+ * Default constructor
+ */
+AliEmcalCorrectionCellTable::AliEmcalCorrectionCellTable():
+  fRun(-1),
+  fNCells(0),
+  fRecalibrate(kFALSE),
+  fTimeCalib(kFALSE),
+  fL1Phase(kFALSE),
+  fBad(),
+  fEnergyScale(),
+  fTimeShift(),
+  fSuperModule(),
+  fRecoUtils(0),
+  fQABefore(0),
+  fQAAfter(0),
+  fQAFillTime(kFALSE)
+{
+}
+
+/**
+ * Fill the table from the reco utils of a component. The reco utils must be configured
+ * (switches, calibration maps and ResetCellsCalibrated()) as for AliEMCALRecoUtils::RecalibrateCells().
+ *
+ * The time calibration shift is obtained by calibrating a time of 0 for each bunch crossing, such that
+ * adding it to the cell time gives the same result as the subtraction done by the reco utils.
+ * The L1 phase correction is evaluated per cell with the reco utils, since it only depends on the super module.
+ *
+ * @param[in] recoUtils Reco utils of the component
+ * @param[in] geom EMCal geometry
+ * @param[in] run Run number for which the table is filled
+ */
+void AliEmcalCorrectionCellTable::Fill(AliEMCALRecoUtils * recoUtils, AliEMCALGeometry * geom, Int_t run)
+{
+  fRecoUtils = recoUtils;
+  fRun = run;
+  fNCells = geom->GetNCells();
+  fRecalibrate = recoUtils->IsRecalibrationOn();
+  fTimeCalib = recoUtils->IsTimeRecalibrationOn();
+  fL1Phase = recoUtils->IsL1PhaseInTimeRecalibrationOn();
+  const Bool_t removeBad = recoUtils->IsBadChannelsRemovalSwitchedOn();
+
+  fBad.assign(fNCells, 0);
+  fEnergyScale.assign(fNCells, 1.);
+  fTimeShift.assign(4 * fNCells, 0.);
+  fSuperModule.assign(fNCells, 0);
+
+  Int_t imod = -1, iTower = -1, iIphi = -1, iIeta = -1, iphi = -1, ieta = -1;
+  for (Int_t absId = 0; absId < fNCells; absId++)
+  {
+    if (!geom->GetCellIndex(absId, imod, iTower, iIphi, iIeta)) continue;
+    geom->GetCellPhiEtaIndexInSModule(imod, iTower, iIphi, iIeta, iphi, ieta);
+    fSuperModule[absId] = imod;
+
+    if (removeBad && recoUtils->GetEMCALChannelStatus(imod, ieta, iphi)) fBad[absId] = 1;
+    if (fRecalibrate) fEnergyScale[absId] = recoUtils->GetEMCALChannelRecalibrationFactor(imod, ieta, iphi);
+    if (fTimeCalib) {
+      for (Int_t bc = 0; bc < 4; bc++)
+      {
+        Double_t shift = 0;
+        recoUtils->RecalibrateCellTime(absId, bc, shift);
+        fTimeShift[bc * fNCells + absId] = shift;
+      }
+    }
+  }
+}
+
+/**
+ * Apply the L1 phase time correction of the super module of the cell.
+ */
+void AliEmcalCorrectionCellTable::ApplyL1Phase(Short_t absId, Int_t bc, Double_t & time) const
+{
+  fRecoUtils->RecalibrateCellTimeL1Phase(fSuperModule[absId], bc, time);
+}
+
+/**
+ * Apply the correction to a cell and fill the QA histograms before and after.
+ */
+void AliEmcalCorrectionCellTable::ApplyWithQA(Short_t absId, Int_t bc, Double_t & amp, Double_t & time) const
+{
+  if (fQABefore) fQABefore->Fill(fQAFillTime ? time : amp);
+  ApplyCorrection(absId, bc, amp, time);
+  if (fQAAfter) fQAAfter->Fill(fQAFillTime ? time : amp);
+}
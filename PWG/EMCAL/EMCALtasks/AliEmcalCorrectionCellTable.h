@@ -0,0 +1,94 @@
+#ifndef ALIEMCALCORRECTIONCELLTABLE_H
+#define ALIEMCALCORRECTIONCELLTABLE_H
+
+#include <vector>
+
+#include <Rtypes.h>
+
+class TH1F;
+class AliEMCALGeometry;
+class AliEMCALRecoUtils;
+
+/**
+ * @class AliEmcalCorrectionCellTable
+ * @ingroup EMCALCOREFW
+ * @brief Flat per-cell calibration of a cell correction component
+ *
+ * Holds the bad channel flag, the energy calibration factor and the time calibration shift
+ * (for each bunch crossing modulo 4) of every cell, indexed by the absolute cell ID. The table
+ * is filled once per run from the AliEMCALRecoUtils of a cell correction component, as configured
+ * by the component. Apply() then performs the same operations on a cell as
+ * AliEMCALRecoUtils::RecalibrateCells() does, without looking up the calibration histograms and
+ * without accessing the cells object. It is used by AliEmcalCorrectionTask to run all cell
+ * corrections in a single pass over the cells.
+ *
+ * The time shift is the one AliEMCALRecoUtils::RecalibrateCellTime() gives without gain information,
+ * i.e. the high gain calibration. It must not be applied to low gain cells: AliEmcalCorrectionTask runs
+ * the components one after the other in events with low gain cells when HasTimeCalib() is set.
+ */
+class AliEmcalCorrectionCellTable {
+ public:
+  AliEmcalCorrectionCellTable();
+  virtual ~AliEmcalCorrectionCellTable() {}
+
+  void Fill(AliEMCALRecoUtils * recoUtils, AliEMCALGeometry * geom, Int_t run);
+  void Reset() { fRun = -1; }
+  /// Run for which the table was filled (-1 if not filled)
+  Int_t GetRun() const { return fRun; }
+  /// The table applies the (high gain) time calibration
+  Bool_t HasTimeCalib() const { return fTimeCalib; }
+  /// Histograms filled with the cell energy (or time) before and after applying the table
+  void SetQAHistograms(TH1F * before, TH1F * after, Bool_t fillTime) { fQABefore = before; fQAAfter = after; fQAFillTime = fillTime; }
+
+  /**
+   * Correct a single cell, as AliEMCALRecoUtils::RecalibrateCells() with the settings used to fill the table.
+   *
+   * @param[in] absId Absolute ID of the cell
+   * @param[in] bc Bunch crossing number of the event
+   * @param[in,out] amp Cell energy
+   * @param[in,out] time Cell time
+   */
+  void Apply(Short_t absId, Int_t bc, Double_t & amp, Double_t & time) const
+  {
+    if (fQABefore || fQAAfter) { ApplyWithQA(absId, bc, amp, time); return; }
+    ApplyCorrection(absId, bc, amp, time);
+  }
+
+ private:
+  void ApplyCorrection(Short_t absId, Int_t bc, Double_t & amp, Double_t & time) const
+  {
+    if (absId < 0 || absId >= fNCells) return;
+    if (fBad[absId]) {
+      amp = 0;
+      time = -1;
+      return;
+    }
+    if (fRecalibrate) amp *= fEnergyScale[absId];
+    if (bc >= 0) {
+      if (fTimeCalib) time += fTimeShift[(bc % 4) * fNCells + absId];
+      if (fL1Phase) ApplyL1Phase(absId, bc, time);
+    }
+  }
+  void ApplyL1Phase(Short_t absId, Int_t bc, Double_t & time) const;
+  void ApplyWithQA(Short_t absId, Int_t bc, Double_t & amp, Double_t & time) const;
+
+  Int_t                   fRun;                 //!<! Run for which the table was filled
+  Int_t                   fNCells;              //!<! Number of cells in the geometry
+  Bool_t                  fRecalibrate;         //!<! Energy calibration is applied
+  Bool_t                  fTimeCalib;           //!<! Time calibration is applied
+  Bool_t                  fL1Phase;             //!<! L1 phase time calibration is applied
+  std::vector<UChar_t>    fBad;                 //!<! Per cell: 1 if the cell is removed
+  std::vector<Float_t>    fEnergyScale;         //!<! Per cell: energy calibration factor
+  std::vector<Double_t>   fTimeShift;           //!<! Per bunch crossing modulo 4 and cell: time calibration shift
+  std::vector<Short_t>    fSuperModule;         //!<! Per cell: super module (for the L1 phase)
+  AliEMCALRecoUtils      *fRecoUtils;           //!<! Reco utils of the component (L1 phase)
+  TH1F                   *fQABefore;            //!<! QA histogram before the correction
+  TH1F                   *fQAAfter;             //!<! QA histogram after the correction
+  Bool_t                  fQAFillTime;          //!<! Fill the cell time instead of the energy in the QA histograms
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalCorrectionCellTable, 1); // EMCal flat cell calibration table
+  /// \endcond
+};
+
+#endif /* ALIEMCALCORRECTIONCELLTABLE_H */
@@ -79,6 +79,41 @@ void AliEmcalCorrectionCellTimeCalib::UserCreateOutputObjects()
  * Called for each event to process the event data.
  */
 Bool_t AliEmcalCorrectionCellTimeCalib::Run()
+{
+  if (!ConfigureCells())
+    return kFALSE;
+  
+  if(fCreateHisto)
+    FillCellQA(fCellTimeDistBefore); // "before" QA
+  
+  // CELL RECALIBRATION -------------------------------------------------------
+  // cell objects will be updated
+  UpdateCells();
+  
+  if(fCreateHisto)
+    FillCellQA(fCellTimeDistAfter); // "after" QA
+  
+  return kTRUE;
+}
+
+/**
+ * Called for each event instead of Run() when the correction task applies the cell corrections
+ * in a single pass. Only the cell table is updated, the cells are not modified.
+ */
+Bool_t AliEmcalCorrectionCellTimeCalib::PrepareCellTable()
+{
+  if (!ConfigureCells())
+    return kFALSE;
+
+  UpdateCellTable(fCellTimeDistBefore, fCellTimeDistAfter, kTRUE);
+
+  return kTRUE;
+}
+
+/**
+ * Configure the reco utils for the event. Common to Run() and PrepareCellTable().
+ */
+Bool_t AliEmcalCorrectionCellTimeCalib::ConfigureCells()
 {
   AliEmcalCorrectionComponent::Run();
   
@@ -114,16 +149,6 @@ Bool_t AliEmcalCorrectionCellTimeCalib::Run()
   // mark the cells not recalibrated
   fRecoUtils->ResetCellsCalibrated();
   
-  if(fCreateHisto)
-    FillCellQA(fCellTimeDistBefore); // "before" QA
-  
-  // CELL RECALIBRATION -------------------------------------------------------
-  // cell objects will be updated
-  UpdateCells();
-  
-  if(fCreateHisto)
-    FillCellQA(fCellTimeDistAfter); // "after" QA
-  
   return kTRUE;
 }
 
@@ -32,12 +32,17 @@ class AliEmcalCorrectionCellTimeCalib : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // Fused cell corrections
+  Bool_t SupportsCellTable() const { return kTRUE; }
+  Bool_t PrepareCellTable();
   
 protected:
   TH1F* fCellTimeDistBefore;            //!<! cell energy distribution, before time calibration
   TH1F* fCellTimeDistAfter;             //!<! cell energy distribution, after time calibration
 
 private:
+  Bool_t     ConfigureCells();
   Int_t      InitTimeCalibration();
   Int_t      InitTimeCalibrationL1Phase();
   
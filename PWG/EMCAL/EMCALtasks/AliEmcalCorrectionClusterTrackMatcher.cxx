@@ -3,8 +3,11 @@
 
 #include "AliEmcalCorrectionClusterTrackMatcher.h"
 
+#include <algorithm>
+
 #include <TH1.h>
 #include <TList.h>
+#include <TVector2.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
@@ -15,6 +18,7 @@
 #include "AliEmcalParticle.h"
 #include "AliEMCALGeometry.h"
 #include "AliMCEvent.h"
+#include "AliEmcalCorrectionPositionCache.h"
 
 /// \cond CLASSIMP
 ClassImp(AliEmcalCorrectionClusterTrackMatcher);
@@ -45,6 +49,20 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0),
+  fTrackEta(),
+  fTrackPhi(),
+  fClusterEta(),
+  fClusterPhi(),
+  fGridNEta(0),
+  fGridNPhi(0),
+  fGridEtaMin(0),
+  fGridEtaWidth(0),
+  fGridPhiWidth(0),
+  fTrackCell(),
+  fGridOffset(),
+  fGridTracks(),
+  fUnbinnedTracks(),
+  fCandidates(),
   fMCGenerToAcceptForTrack(1),
   fNMCGenerToAccept(0)
 {
@@ -332,8 +350,11 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
           if ( !generOK ) continue;
         }
         
-        // Propagate the track
-        AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA);
+        // Propagate the track, unless another component already did it with the same settings in this event
+        if (!fPositionCache || !fPositionCache->IsTrackPropagated(track, fPropDist, mass, fUseDCA)) {
+          AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA);
+          if (fPositionCache) fPositionCache->SetTrackPropagated(track, fPropDist, mass, fUseDCA);
+        }
       }
       
       // Create AliEmcalParticle objects to handle the matching
@@ -352,49 +373,187 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
 
 /**
  * Set the links between tracks and clusters.
+ *
+ * The tracks are binned in an \f$\eta\f$-\f$\phi\f$ grid on the EMCal surface, with cells at least as
+ * large as the maximum matching distance, such that each cluster is only tested against the tracks in the
+ * neighbouring cells. The candidates of a cluster are tested in increasing track index and the clusters
+ * in increasing index, with the same distance as GetEtaPhiDiff(): the matched objects are therefore added
+ * to the tracks and clusters in the same order as when testing all track-cluster pairs, and the matches
+ * are identical.
  */
 void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  fTrackEta.resize(fNEmcalTracks);
+  fTrackPhi.resize(fNEmcalTracks);
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
-    AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
-    AliVTrack* track = emcalTrack->GetTrack();
+    AliVTrack* track = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack))->GetTrack();
+    fTrackEta[itrack] = track->GetTrackEtaOnEMCal();
+    fTrackPhi[itrack] = track->GetTrackPhiOnEMCal();
+  }
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
-      AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
-      AliVCluster* cluster = emcalCluster->GetCluster();
-      
-      Double_t deta = 999;
-      Double_t dphi = 999;
-      GetEtaPhiDiff(track, cluster, dphi, deta);
-      Double_t d2 = deta * deta + dphi * dphi;
+  Double_t etaMin = TMath::Infinity();
+  Double_t etaMax = -TMath::Infinity();
+  fClusterEta.resize(fNEmcalClusters);
+  fClusterPhi.resize(fNEmcalClusters);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliVCluster* cluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster))->GetCluster();
+    GetClusterEtaPhi(cluster, fClusterEta[icluster], fClusterPhi[icluster]);
+    if (!TMath::Finite(fClusterEta[icluster]) || !TMath::Finite(fClusterPhi[icluster])) continue;
+    etaMin = TMath::Min(etaMin, fClusterEta[icluster]);
+    etaMax = TMath::Max(etaMax, fClusterEta[icluster]);
+  }
 
-      if (d2 > maxd2) continue;
-      
-      Double_t d = TMath::Sqrt(d2);
-      emcalCluster->AddMatchedObj(itrack, d);
-      emcalTrack->AddMatchedObj(icluster, d);
-      AliDebug(2, Form("Now matching cluster E = %.3f, pT = %.3f, eta = %.3f, phi = %.3f "
-                       "with track pT = %.3f, eta = %.3f, phi = %.3f"
-                       "Track eta, phi on EMCal = %.3f, %.3f, d = %.3f",
-                       cluster->GetNonLinCorrEnergy(), emcalCluster->Pt(), emcalCluster->Eta(), emcalCluster->Phi(),
-                       emcalTrack->Pt(), emcalTrack->Eta(), emcalTrack->Phi(),
-                       track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), d));
-      
-      if (fCreateHisto) {
-        Int_t mombin = GetMomBin(track->P());
-        Int_t centbinch = fCentBin;
-        if (track->Charge() < 0) centbinch += fNcentBins;
-        Int_t etabin = 0;
-        if(track->Eta() > 0) etabin = 1;
-
-        fHistMatchEta[centbinch][mombin][etabin]->Fill(deta);
-        fHistMatchPhi[centbinch][mombin][etabin]->Fill(dphi);
-        fHistMatchEtaAll->Fill(deta);
-        fHistMatchPhiAll->Fill(dphi);
+  if (!(fMaxDistance > 0) || !TMath::Finite(fMaxDistance) || etaMin > etaMax) {
+    DoMatchingAllPairs();
+    return;
+  }
+
+  BuildTrackGrid(etaMin, etaMax);
+
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    const Double_t eta = fClusterEta[icluster];
+    const Double_t phi = fClusterPhi[icluster];
+
+    fCandidates.clear();
+    if (!TMath::Finite(eta) || !TMath::Finite(phi)) {
+      for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) fCandidates.push_back(itrack);
+    }
+    else {
+      Int_t ieta = TMath::FloorNint((eta - fGridEtaMin) / fGridEtaWidth);
+      ieta = TMath::Max(0, TMath::Min(fGridNEta - 1, ieta));
+      const Double_t phiNorm = phi - TMath::TwoPi() * TMath::Floor(phi / TMath::TwoPi());
+      const Int_t iphi = TMath::Max(0, TMath::Min(fGridNPhi - 1, Int_t(phiNorm / fGridPhiWidth)));
+
+      for (Int_t jeta = TMath::Max(0, ieta - 1); jeta <= TMath::Min(fGridNEta - 1, ieta + 1); jeta++) {
+        // With less than three phi cells, the neighbouring cells are all cells
+        const Int_t nphi = fGridNPhi < 3 ? fGridNPhi : 3;
+        for (Int_t k = 0; k < nphi; k++) {
+          const Int_t jphi = fGridNPhi < 3 ? k : (iphi + k - 1 + fGridNPhi) % fGridNPhi;
+          const Int_t cell = jeta * fGridNPhi + jphi;
+          fCandidates.insert(fCandidates.end(), fGridTracks.begin() + fGridOffset[cell], fGridTracks.begin() + fGridOffset[cell + 1]);
+        }
       }
+      fCandidates.insert(fCandidates.end(), fUnbinnedTracks.begin(), fUnbinnedTracks.end());
+      std::sort(fCandidates.begin(), fCandidates.end());
+    }
+
+    for (std::vector<Int_t>::const_iterator itrack = fCandidates.begin(); itrack != fCandidates.end(); ++itrack) {
+      MatchPair(*itrack, icluster, maxd2);
+    }
+  }
+}
+
+/**
+ * Set the links between tracks and clusters, testing all track-cluster pairs.
+ * Used if the matching distance does not allow to bin the tracks.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::DoMatchingAllPairs()
+{
+  const Double_t maxd2 = fMaxDistance*fMaxDistance;
+
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
+      MatchPair(itrack, icluster, maxd2);
+    }
+  }
+}
+
+/**
+ * Bin the tracks in an \f$\eta\f$-\f$\phi\f$ grid covering the clusters. The cells are at least as
+ * large as the maximum matching distance (up to 1000 cells in each direction), and the grid extends by
+ * one cell beyond the clusters in \f$\eta\f$: tracks outside of it cannot be matched to any cluster
+ * and are not binned. Tracks without a finite position are kept in a separate list.
+ * @param[in] etaMin Minimum \f$\eta\f$ of the clusters
+ * @param[in] etaMax Maximum \f$\eta\f$ of the clusters
+ */
+void AliEmcalCorrectionClusterTrackMatcher::BuildTrackGrid(Double_t etaMin, Double_t etaMax)
+{
+  const Int_t maxCells = 1000;
+  // Small margin, such that rounding cannot place a match beyond the neighbouring cell
+  const Double_t width = fMaxDistance * 1.001;
+
+  fGridEtaWidth = TMath::Max(width, (etaMax - etaMin) / maxCells);
+  fGridEtaMin = etaMin - fGridEtaWidth;
+  fGridNEta = TMath::FloorNint((etaMax - etaMin) / fGridEtaWidth) + 3;
+  fGridNPhi = TMath::Max(1, TMath::Min(maxCells, Int_t(TMath::TwoPi() / width)));
+  fGridPhiWidth = TMath::TwoPi() / fGridNPhi;
+
+  const Int_t nCells = fGridNEta * fGridNPhi;
+  fGridOffset.assign(nCells + 1, 0);
+  fTrackCell.assign(fNEmcalTracks, -1);
+  fUnbinnedTracks.clear();
+
+  for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
+    const Double_t eta = fTrackEta[itrack];
+    const Double_t phi = fTrackPhi[itrack];
+    if (!TMath::Finite(eta) || !TMath::Finite(phi)) {
+      fUnbinnedTracks.push_back(itrack);
+      continue;
     }
+    const Double_t x = (eta - fGridEtaMin) / fGridEtaWidth;
+    if (x < 0 || x >= fGridNEta) continue;
+    const Int_t ieta = TMath::Min(fGridNEta - 1, Int_t(x));
+    const Double_t phiNorm = phi - TMath::TwoPi() * TMath::Floor(phi / TMath::TwoPi());
+    const Int_t iphi = TMath::Max(0, TMath::Min(fGridNPhi - 1, Int_t(phiNorm / fGridPhiWidth)));
+    fTrackCell[itrack] = ieta * fGridNPhi + iphi;
+    fGridOffset[fTrackCell[itrack] + 1]++;
+  }
+
+  for (Int_t cell = 0; cell < nCells; cell++) fGridOffset[cell + 1] += fGridOffset[cell];
+
+  // Fill in increasing track index, using the offsets as insertion points, then restore the offsets
+  fGridTracks.resize(fGridOffset[nCells]);
+  for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
+    if (fTrackCell[itrack] < 0) continue;
+    fGridTracks[fGridOffset[fTrackCell[itrack]]++] = itrack;
+  }
+  for (Int_t cell = nCells; cell > 0; cell--) fGridOffset[cell] = fGridOffset[cell - 1];
+  fGridOffset[0] = 0;
+}
+
+/**
+ * Test a track-cluster pair and link them if they are within the maximum distance.
+ * @param[in] itrack Index of the track in fEmcalTracks
+ * @param[in] icluster Index of the cluster in fEmcalClusters
+ * @param[in] maxd2 Square of the maximum distance
+ */
+void AliEmcalCorrectionClusterTrackMatcher::MatchPair(Int_t itrack, Int_t icluster, Double_t maxd2)
+{
+  // Same as GetEtaPhiDiff(), with the positions computed once per event
+  const Double_t deta = fTrackEta[itrack] - fClusterEta[icluster];
+  const Double_t dphi = TVector2::Phi_mpi_pi(fTrackPhi[itrack] - fClusterPhi[icluster]);
+  const Double_t d2 = deta * deta + dphi * dphi;
+
+  if (d2 > maxd2) return;
+
+  AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
+  AliVTrack* track = emcalTrack->GetTrack();
+  AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+  AliVCluster* cluster = emcalCluster->GetCluster();
+
+  Double_t d = TMath::Sqrt(d2);
+  emcalCluster->AddMatchedObj(itrack, d);
+  emcalTrack->AddMatchedObj(icluster, d);
+  AliDebug(2, Form("Now matching cluster E = %.3f, pT = %.3f, eta = %.3f, phi = %.3f "
+                   "with track pT = %.3f, eta = %.3f, phi = %.3f"
+                   "Track eta, phi on EMCal = %.3f, %.3f, d = %.3f",
+                   cluster->GetNonLinCorrEnergy(), emcalCluster->Pt(), emcalCluster->Eta(), emcalCluster->Phi(),
+                   emcalTrack->Pt(), emcalTrack->Eta(), emcalTrack->Phi(),
+                   track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), d));
+
+  if (fCreateHisto) {
+    Int_t mombin = GetMomBin(track->P());
+    Int_t centbinch = fCentBin;
+    if (track->Charge() < 0) centbinch += fNcentBins;
+    Int_t etabin = 0;
+    if(track->Eta() > 0) etabin = 1;
+
+    fHistMatchEta[centbinch][mombin][etabin]->Fill(deta);
+    fHistMatchPhi[centbinch][mombin][etabin]->Fill(dphi);
+    fHistMatchEtaAll->Fill(deta);
+    fHistMatchPhiAll->Fill(dphi);
   }
 }
 
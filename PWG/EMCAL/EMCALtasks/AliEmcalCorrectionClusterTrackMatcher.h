@@ -1,6 +1,8 @@
 #ifndef ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
@@ -69,6 +71,9 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Int_t         GetMomBin(Double_t p) const;
   void          GenerateEmcalParticles();
   void          DoMatching();
+  void          DoMatchingAllPairs();
+  void          BuildTrackGrid(Double_t etaMin, Double_t etaMax);
+  void          MatchPair(Int_t itrack, Int_t icluster, Double_t maxd2);
   void          UpdateTracks();
   void          UpdateClusters();
   Bool_t        IsTrackInEmcalAcceptance(AliVParticle* part, Double_t edges=0.9) const;
@@ -102,6 +107,22 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!<!deta distribution
   TH1          *fHistMatchPhi[10][9][2]; //!<!dphi distribution
+
+  // Positions on the EMCal surface and eta-phi grid of the tracks used by DoMatching()
+  std::vector<Double_t> fTrackEta;      //!<!track eta on the EMCal surface
+  std::vector<Double_t> fTrackPhi;      //!<!track phi on the EMCal surface
+  std::vector<Double_t> fClusterEta;    //!<!cluster eta
+  std::vector<Double_t> fClusterPhi;    //!<!cluster phi
+  Int_t         fGridNEta;              //!<!number of eta cells of the grid
+  Int_t         fGridNPhi;              //!<!number of phi cells of the grid
+  Double_t      fGridEtaMin;            //!<!lower eta edge of the grid
+  Double_t      fGridEtaWidth;          //!<!eta width of a grid cell
+  Double_t      fGridPhiWidth;          //!<!phi width of a grid cell
+  std::vector<Int_t> fTrackCell;        //!<!grid cell of each track (-1 if not in the grid)
+  std::vector<Int_t> fGridOffset;       //!<!first entry of each grid cell in fGridTracks
+  std::vector<Int_t> fGridTracks;       //!<!track indices ordered by grid cell, ascending within a cell
+  std::vector<Int_t> fUnbinnedTracks;   //!<!tracks without a finite position, tested against all clusters
+  std::vector<Int_t> fCandidates;       //!<!candidate tracks of a cluster
   
   Int_t      fNMCGenerToAccept;          ///<  Number of MC generators that should not be included in analysis
   TString    fMCGenerToAccept[5];        ///<  List with name of generators that should not be included
@@ -115,7 +136,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 4); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
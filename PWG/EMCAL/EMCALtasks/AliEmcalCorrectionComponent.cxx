@@ -15,6 +15,8 @@
 #include "AliParticleContainer.h"
 #include "AliMCParticleContainer.h"
 #include "AliOADBContainer.h"
+#include "AliEmcalCorrectionCellTable.h"
+#include "AliEmcalCorrectionPositionCache.h"
 
 /// \cond CLASSIMP
 ClassImp(AliEmcalCorrectionComponent);
@@ -51,6 +53,8 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent() :
   fCaloCells(0),
   fRecoUtils(0),
   fOutput(0),
+  fCellTable(0),
+  fPositionCache(0),
   fBasePath("")
 
 {
@@ -87,6 +91,8 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
   fCaloCells(0),
   fRecoUtils(0),
   fOutput(0),
+  fCellTable(0),
+  fPositionCache(0),
   fBasePath("")
 {
   fVertex[0] = 0;
@@ -99,6 +105,7 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
  */
 AliEmcalCorrectionComponent::~AliEmcalCorrectionComponent()
 {
+  delete fCellTable;
 }
 
 /**
@@ -180,15 +187,26 @@ void AliEmcalCorrectionComponent::GetEtaPhiDiff(const AliVTrack *t, const AliVCl
   Double_t veta = t->GetTrackEtaOnEMCal();
   Double_t vphi = t->GetTrackPhiOnEMCal();
   
-  Float_t pos[3] = {0};
-  v->GetPosition(pos);
-  TVector3 cpos(pos);
-  Double_t ceta     = cpos.Eta();
-  Double_t cphi     = cpos.Phi();
+  Double_t ceta = 0;
+  Double_t cphi = 0;
+  GetClusterEtaPhi(v, ceta, cphi);
   etadiff=veta-ceta;
   phidiff=TVector2::Phi_mpi_pi(vphi-cphi);
 }
 
+/**
+ * Get \f$\eta\f$ and \f$\phi\f$ of the cluster position, from the per-event position cache
+ * of the correction task if available.
+ * @param[in] v Cluster
+ * @param[out] eta Pseudorapidity of the cluster position
+ * @param[out] phi Azimuth of the cluster position
+ */
+void AliEmcalCorrectionComponent::GetClusterEtaPhi(const AliVCluster *v, Double_t &eta, Double_t &phi)
+{
+  if (fPositionCache) fPositionCache->GetClusterEtaPhi(v, eta, phi);
+  else AliEmcalCorrectionPositionCache::ComputeClusterEtaPhi(v, eta, phi);
+}
+
 /**
  * Remove bad cells from the cell list
  * Recalibrate energy and time cells
@@ -206,6 +224,34 @@ void AliEmcalCorrectionComponent::UpdateCells()
   fCaloCells->Sort();
 }
 
+/**
+ * Update the flat cell calibration table used by the fused cell corrections in place of
+ * UpdateCells(). The table is refilled from the reco utils whenever the run changed, so the
+ * reco utils must be configured as for UpdateCells().
+ *
+ * @param[in] before QA histogram to be filled before the correction (only used if fCreateHisto)
+ * @param[in] after QA histogram to be filled after the correction (only used if fCreateHisto)
+ * @param[in] fillTime Fill the cell time instead of the cell energy into the QA histograms
+ */
+void AliEmcalCorrectionComponent::UpdateCellTable(TH1F* before, TH1F* after, Bool_t fillTime)
+{
+  if (!fCellTable)
+    fCellTable = new AliEmcalCorrectionCellTable();
+
+  if (fCellTable->GetRun() != fRun)
+    fCellTable->Fill(fRecoUtils, fGeom, fRun);
+
+  // The cells are corrected by the task and not by the reco utils: flag them as recalibrated in the
+  // reco utils as RecalibrateCells() would
+  if (fRecoUtils)
+    fRecoUtils->SetCellsRecalibrated(kTRUE);
+
+  if (fCreateHisto)
+    fCellTable->SetQAHistograms(before, after, fillTime);
+  else
+    fCellTable->SetQAHistograms(0, 0, fillTime);
+}
+
 /**
  * Check whether the run changed.
  */
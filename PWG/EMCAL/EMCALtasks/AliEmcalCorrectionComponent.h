@@ -18,6 +18,8 @@ class AliVCaloCells;
 class AliVTrack;
 class AliVCluster;
 class AliVEvent;
+class AliEmcalCorrectionCellTable;
+class AliEmcalCorrectionPositionCache;
 #include <AliLog.h>
 #include "AliEmcalContainerUtils.h"
 #include "AliParticleContainer.h"
@@ -56,11 +58,20 @@ class AliEmcalCorrectionComponent : public TNamed {
   virtual Bool_t Run();
   virtual Bool_t UserNotify();
   virtual Bool_t CheckIfRunChanged();
+
+  // Fused cell corrections (see AliEmcalCorrectionTask)
+  /// True if the component can provide its cell correction as a flat table instead of running UpdateCells()
+  virtual Bool_t SupportsCellTable() const { return kFALSE; }
+  /// Configure the component for the event and update the cell table instead of correcting the cells
+  virtual Bool_t PrepareCellTable() { return kFALSE; }
+  const AliEmcalCorrectionCellTable *GetCellTable() const { return fCellTable; }
   
   void GetEtaPhiDiff(const AliVTrack *t, const AliVCluster *v, Double_t &phidiff, Double_t &etadiff);
+  void GetClusterEtaPhi(const AliVCluster *v, Double_t &eta, Double_t &phi);
   void UpdateCells();
   void GetPass();
   void FillCellQA(TH1F* h);
+  void UpdateCellTable(TH1F* before, TH1F* after, Bool_t fillTime);
   Int_t InitBadChannels();
 
   // Containers and cells
@@ -96,6 +107,8 @@ class AliEmcalCorrectionComponent : public TNamed {
   void SetCentrality(Double_t cent) { fCent = cent; }
   void SetNcentralityBins(Int_t n) { fNcentBins = n; }
   void SetIsESD(Bool_t isESD) {fEsdMode = isESD; }
+  /// Per-event cache of the positions on the EMCal surface, shared by the components of a correction task
+  void SetPositionCache(AliEmcalCorrectionPositionCache * cache) { fPositionCache = cache; }
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   /// Make copy to ensure that the nodes do not point to each other (?)
@@ -145,6 +158,8 @@ class AliEmcalCorrectionComponent : public TNamed {
   AliVCaloCells          *fCaloCells;                     //!<! Pointer to CaloCells
   AliEMCALRecoUtils      *fRecoUtils;                     ///<  Pointer to RecoUtils
   TList                  *fOutput;                        //!<! List of output histograms
+  AliEmcalCorrectionCellTable *fCellTable;                //!<! Flat cell calibration for the fused cell corrections
+  AliEmcalCorrectionPositionCache *fPositionCache;        //!<! Per-event position cache (not owned)
   
   TString                fBasePath;                       ///< Base folder path to get root files
 
@@ -153,7 +168,7 @@ class AliEmcalCorrectionComponent : public TNamed {
   AliEmcalCorrectionComponent &operator=(const AliEmcalCorrectionComponent &);    // Not implemented
   
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionComponent, 2); // EMCal correction component
+  ClassDef(AliEmcalCorrectionComponent, 4); // EMCal correction component
   /// \endcond
 };
 
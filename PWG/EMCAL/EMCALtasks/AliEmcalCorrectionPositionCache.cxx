@@ -0,0 +1,115 @@
+// AliEmcalCorrectionPositionCache
+//
+
+#include <TVector3.h>
+
+#include "AliVCluster.h"
+#include "AliVTrack.h"
+
+#include "AliEmcalCorrectionPositionCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalCorrectionPositionCache);
+/// \endcond
+
+/**
+ * Default constructor
+ */
+AliEmcalCorrectionPositionCache::AliEmcalCorrectionPositionCache():
+  fClusters(),
+  fTracks()
+{
+}
+
+/**
+ * Clear the cache. Called at the beginning of each event, the allocated buckets are kept.
+ */
+void AliEmcalCorrectionPositionCache::Reset()
+{
+  fClusters.clear();
+  fTracks.clear();
+}
+
+/**
+ * Compute \f$\eta\f$ and \f$\phi\f$ of the cluster position.
+ *
+ * @param[in] cluster Cluster
+ * @param[out] eta Pseudorapidity of the cluster position
+ * @param[out] phi Azimuth of the cluster position
+ */
+void AliEmcalCorrectionPositionCache::ComputeClusterEtaPhi(const AliVCluster * cluster, Double_t & eta, Double_t & phi)
+{
+  Float_t pos[3] = {0};
+  cluster->GetPosition(pos);
+  TVector3 cpos(pos);
+  eta = cpos.Eta();
+  phi = cpos.Phi();
+}
+
+/**
+ * Get \f$\eta\f$ and \f$\phi\f$ of the cluster position, computing them only if the cluster
+ * was not seen before in the event or if its position changed since.
+ *
+ * @param[in] cluster Cluster
+ * @param[out] eta Pseudorapidity of the cluster position
+ * @param[out] phi Azimuth of the cluster position
+ */
+void AliEmcalCorrectionPositionCache::GetClusterEtaPhi(const AliVCluster * cluster, Double_t & eta, Double_t & phi)
+{
+  Float_t pos[3] = {0};
+  cluster->GetPosition(pos);
+
+  auto found = fClusters.find(cluster);
+  if (found != fClusters.end() && found->second.fPos[0] == pos[0] && found->second.fPos[1] == pos[1] && found->second.fPos[2] == pos[2]) {
+    eta = found->second.fEta;
+    phi = found->second.fPhi;
+    return;
+  }
+
+  TVector3 cpos(pos);
+  ClusterEntry & entry = fClusters[cluster];
+  entry.fPos[0] = pos[0];
+  entry.fPos[1] = pos[1];
+  entry.fPos[2] = pos[2];
+  entry.fEta = eta = cpos.Eta();
+  entry.fPhi = phi = cpos.Phi();
+}
+
+/**
+ * Check whether a track was already propagated to the EMCal surface in this event with the given settings,
+ * and still holds the position obtained by that propagation.
+ *
+ * @param[in] track Track
+ * @param[in] dist Distance of the EMCal surface
+ * @param[in] mass Mass hypothesis (-1 for the PID mass)
+ * @param[in] useDCA Whether the DCA was used as starting point
+ * @return True if propagating the track again would give the same result
+ */
+Bool_t AliEmcalCorrectionPositionCache::IsTrackPropagated(const AliVTrack * track, Double_t dist, Double_t mass, Bool_t useDCA) const
+{
+  auto entry = fTracks.find(track);
+  if (entry == fTracks.end()) return kFALSE;
+
+  const TrackEntry & t = entry->second;
+  return (t.fDist == dist && t.fMass == mass && t.fUseDCA == useDCA &&
+          t.fEta == track->GetTrackEtaOnEMCal() && t.fPhi == track->GetTrackPhiOnEMCal() && t.fPt == track->GetTrackPtOnEMCal());
+}
+
+/**
+ * Record that a track was propagated to the EMCal surface with the given settings.
+ *
+ * @param[in] track Track
+ * @param[in] dist Distance of the EMCal surface
+ * @param[in] mass Mass hypothesis (-1 for the PID mass)
+ * @param[in] useDCA Whether the DCA was used as starting point
+ */
+void AliEmcalCorrectionPositionCache::SetTrackPropagated(const AliVTrack * track, Double_t dist, Double_t mass, Bool_t useDCA)
+{
+  TrackEntry & t = fTracks[track];
+  t.fDist = dist;
+  t.fMass = mass;
+  t.fUseDCA = useDCA;
+  t.fEta = track->GetTrackEtaOnEMCal();
+  t.fPhi = track->GetTrackPhiOnEMCal();
+  t.fPt = track->GetTrackPtOnEMCal();
+}
@@ -0,0 +1,67 @@
+#ifndef ALIEMCALCORRECTIONPOSITIONCACHE_H
+#define ALIEMCALCORRECTIONPOSITIONCACHE_H
+
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+#include <unordered_map>
+#endif
+
+#include <Rtypes.h>
+
+class AliVCluster;
+class AliVTrack;
+
+/**
+ * @class AliEmcalCorrectionPositionCache
+ * @ingroup EMCALCOREFW
+ * @brief Per-event cache of cluster and track positions on the EMCal surface
+ *
+ * Shared by the correction components of an AliEmcalCorrectionTask and reset by the task at the
+ * beginning of each event. It holds
+ *  - the \f$\eta\f$ and \f$\phi\f$ of the cluster positions, as used by
+ *    AliEmcalCorrectionComponent::GetEtaPhiDiff(). An entry is only used as long as the cluster position
+ *    is unchanged, so components modifying the clusters do not need to invalidate the cache.
+ *  - the tracks which were already propagated to the EMCal surface in the event, with the propagation
+ *    settings and the resulting position, such that further cluster-track matchers running on the same
+ *    tracks with the same settings do not propagate them again.
+ */
+class AliEmcalCorrectionPositionCache {
+ public:
+  AliEmcalCorrectionPositionCache();
+  virtual ~AliEmcalCorrectionPositionCache() {}
+
+  void Reset();
+
+  void GetClusterEtaPhi(const AliVCluster * cluster, Double_t & eta, Double_t & phi);
+  static void ComputeClusterEtaPhi(const AliVCluster * cluster, Double_t & eta, Double_t & phi);
+
+  Bool_t IsTrackPropagated(const AliVTrack * track, Double_t dist, Double_t mass, Bool_t useDCA) const;
+  void SetTrackPropagated(const AliVTrack * track, Double_t dist, Double_t mass, Bool_t useDCA);
+
+ private:
+  /// Cluster position and the corresponding \f$\eta\f$, \f$\phi\f$
+  struct ClusterEntry {
+    Float_t  fPos[3];
+    Double_t fEta;
+    Double_t fPhi;
+  };
+  /// Propagation settings and resulting position on the EMCal surface of a track
+  struct TrackEntry {
+    Double_t fDist;
+    Double_t fMass;
+    Bool_t   fUseDCA;
+    Double_t fEta;
+    Double_t fPhi;
+    Double_t fPt;
+  };
+
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+  std::unordered_map<const AliVCluster *, ClusterEntry> fClusters; //!<! Cluster positions of the event
+  std::unordered_map<const AliVTrack *, TrackEntry>     fTracks;   //!<! Tracks propagated in the event
+#endif
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalCorrectionPositionCache, 1); // EMCal per-event position cache
+  /// \endcond
+};
+
+#endif /* ALIEMCALCORRECTIONPOSITIONCACHE_H */
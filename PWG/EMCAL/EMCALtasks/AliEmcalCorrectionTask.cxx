@@ -5,6 +5,7 @@
 
 #include "AliEmcalCorrectionTask.h"
 #include "AliEmcalCorrectionComponent.h"
+#include "AliEmcalCorrectionCellTable.h"
 
 #include <vector>
 #include <set>
@@ -12,11 +13,13 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <chrono>
 
 #include <TChain.h>
 #include <TSystem.h>
 #include <TGrid.h>
 #include <TFile.h>
+#include <TProfile.h>
 
 #include "AliVEventHandler.h"
 #include "AliEMCALGeometry.h"
@@ -86,7 +89,16 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask() :
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
-  fOutput(0)
+  fFuseCellCorrections(kFALSE),
+  fCellBufferAbsId(),
+  fCellBufferAmplitude(),
+  fCellBufferTime(),
+  fCellBufferMCLabel(),
+  fCellBufferEFrac(),
+  fCellBufferHighGain(),
+  fOutput(0),
+  fComponentTiming(0),
+  fPositionCache()
 {
   // Default constructor
   AliDebug(3, Form("%s", __PRETTY_FUNCTION__));
@@ -134,7 +146,16 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const char * name) :
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
-  fOutput(0)
+  fFuseCellCorrections(kFALSE),
+  fCellBufferAbsId(),
+  fCellBufferAmplitude(),
+  fCellBufferTime(),
+  fCellBufferMCLabel(),
+  fCellBufferEFrac(),
+  fCellBufferHighGain(),
+  fOutput(0),
+  fComponentTiming(0),
+  fPositionCache()
 {
   // Standard constructor
   AliDebug(3, Form("%s", __PRETTY_FUNCTION__));
@@ -181,7 +202,16 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const AliEmcalCorrectionTask & ta
   fGeom(task.fGeom),
   fParticleCollArray(*(static_cast<TObjArray *>(task.fParticleCollArray.Clone()))),
   fClusterCollArray(*(static_cast<TObjArray *>(task.fClusterCollArray.Clone()))),
-  fOutput(task.fOutput)                           // TODO: More care is needed here!
+  fFuseCellCorrections(task.fFuseCellCorrections),
+  fCellBufferAbsId(),
+  fCellBufferAmplitude(),
+  fCellBufferTime(),
+  fCellBufferMCLabel(),
+  fCellBufferEFrac(),
+  fCellBufferHighGain(),
+  fOutput(task.fOutput),                          // TODO: More care is needed here!
+  fComponentTiming(task.fComponentTiming),
+  fPositionCache()
 {
   // Vertex position
   std::copy(std::begin(task.fVertex), std::end(task.fVertex), std::begin(fVertex));
@@ -248,7 +278,15 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
   swap(first.fParticleCollArray, second.fParticleCollArray);
   swap(first.fClusterCollArray, second.fClusterCollArray);
   swap(first.fCellCollArray, second.fCellCollArray);
+  swap(first.fFuseCellCorrections, second.fFuseCellCorrections);
+  swap(first.fCellBufferAbsId, second.fCellBufferAbsId);
+  swap(first.fCellBufferAmplitude, second.fCellBufferAmplitude);
+  swap(first.fCellBufferTime, second.fCellBufferTime);
+  swap(first.fCellBufferMCLabel, second.fCellBufferMCLabel);
+  swap(first.fCellBufferEFrac, second.fCellBufferEFrac);
+  swap(first.fCellBufferHighGain, second.fCellBufferHighGain);
   swap(first.fOutput, second.fOutput);
+  swap(first.fComponentTiming, second.fComponentTiming);
 }
 
 /**
@@ -1069,6 +1107,15 @@ void AliEmcalCorrectionTask::UserCreateOutputObjects()
 
   UserCreateOutputObjectsComponents();
 
+  // Average time per event spent in each component. The last bin is the single pass over the cells
+  // of the fused cell corrections, which is not included in the time of the cell correction components.
+  fComponentTiming = new TProfile("fComponentTiming", "Time per event;component;t (#mus)", fCorrectionComponents.size() + 1, 0, fCorrectionComponents.size() + 1);
+  for (std::size_t i = 0; i < fCorrectionComponents.size(); i++) {
+    fComponentTiming->GetXaxis()->SetBinLabel(i + 1, fCorrectionComponents[i]->GetName());
+  }
+  fComponentTiming->GetXaxis()->SetBinLabel(fCorrectionComponents.size() + 1, "FusedCellPass");
+  fOutput->Add(fComponentTiming);
+
   PostData(1, fOutput);
 }
 
@@ -1327,15 +1374,30 @@ Bool_t AliEmcalCorrectionTask::RetrieveEventObjects()
  */
 Bool_t AliEmcalCorrectionTask::Run()
 {
-  // Run the initialization for all derived classes.
-  for (auto component : fCorrectionComponents)
+  fPositionCache.Reset();
+
+  const std::size_t nComponents = fCorrectionComponents.size();
+  for (std::size_t iComponent = 0; iComponent < nComponents; iComponent++)
   {
-    component->SetEvent(InputEvent());
-    component->SetMCEvent(MCEvent());
-    component->SetCentralityBin(fCentBin);
-    component->SetCentrality(fCent);
+    AliEmcalCorrectionComponent * component = fCorrectionComponents[iComponent];
+
+    // Consecutive cell corrections on the same cells are applied together in a single pass
+    if (fFuseCellCorrections && component->SupportsCellTable()) {
+      std::size_t lastComponent = iComponent;
+      while (lastComponent + 1 < nComponents && fCorrectionComponents[lastComponent + 1]->SupportsCellTable() &&
+             fCorrectionComponents[lastComponent + 1]->GetCaloCells() == component->GetCaloCells()) {
+        lastComponent++;
+      }
+      RunFusedCellCorrections(iComponent, lastComponent);
+      iComponent = lastComponent;
+      continue;
+    }
 
+    SetEventPropertiesInComponent(component);
+
+    auto start = std::chrono::steady_clock::now();
     component->Run();
+    fComponentTiming->Fill(iComponent, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
   }
 
   PostData(1, fOutput);
@@ -1343,6 +1405,111 @@ Bool_t AliEmcalCorrectionTask::Run()
   return kTRUE;
 }
 
+/**
+ * Sets the event properties in a component before it is run.
+ *
+ * @param[in] component Component to be run
+ */
+void AliEmcalCorrectionTask::SetEventPropertiesInComponent(AliEmcalCorrectionComponent * component)
+{
+  component->SetEvent(InputEvent());
+  component->SetMCEvent(MCEvent());
+  component->SetCentralityBin(fCentBin);
+  component->SetCentrality(fCent);
+  component->SetPositionCache(&fPositionCache);
+}
+
+/**
+ * Applies the cell corrections of the components firstComponent to lastComponent, which all act on the
+ * same cells, in a single pass over the cells. Instead of running each component over the cells
+ * (each looking up its calibration histograms and accessing the cells object), the components only
+ * update their flat per-run cell tables. The cells are gathered once into contiguous arrays, the
+ * tables are applied to each cell in the order of the components, and the cells are written back
+ * and sorted once. The result is the same as running the components one after the other. The time
+ * calibration table only holds the high gain calibration (see AliEmcalCorrectionCellTable), so in events
+ * with low gain cells and an active time calibration the components are run one after the other instead.
+ * The fusion is off by default.
+ *
+ * @param[in] firstComponent Index of the first cell correction component
+ * @param[in] lastComponent Index of the last cell correction component
+ */
+void AliEmcalCorrectionTask::RunFusedCellCorrections(std::size_t firstComponent, std::size_t lastComponent)
+{
+  std::vector <const AliEmcalCorrectionCellTable *> tables;
+  for (std::size_t iComponent = firstComponent; iComponent <= lastComponent; iComponent++)
+  {
+    AliEmcalCorrectionComponent * component = fCorrectionComponents[iComponent];
+    SetEventPropertiesInComponent(component);
+
+    auto start = std::chrono::steady_clock::now();
+    if (component->PrepareCellTable()) {
+      tables.push_back(component->GetCellTable());
+    }
+    fComponentTiming->Fill(iComponent, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+  }
+
+  if (tables.empty()) {
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  AliVCaloCells * cells = fCorrectionComponents[firstComponent]->GetCaloCells();
+  const Int_t bunchCrossNo = InputEvent()->GetBunchCrossNumber();
+  const Int_t nCells = cells->GetNumberOfCells();
+
+  Bool_t timeCalib = kFALSE;
+  for (auto table : tables)
+  {
+    if (table->HasTimeCalib()) timeCalib = kTRUE;
+  }
+
+  // Gather
+  Bool_t lowGain = kFALSE;
+  fCellBufferAbsId.resize(nCells);
+  fCellBufferAmplitude.resize(nCells);
+  fCellBufferTime.resize(nCells);
+  fCellBufferMCLabel.resize(nCells);
+  fCellBufferEFrac.resize(nCells);
+  fCellBufferHighGain.resize(nCells);
+  for (Int_t iCell = 0; iCell < nCells; iCell++)
+  {
+    cells->GetCell(iCell, fCellBufferAbsId[iCell], fCellBufferAmplitude[iCell], fCellBufferTime[iCell], fCellBufferMCLabel[iCell], fCellBufferEFrac[iCell]);
+    fCellBufferHighGain[iCell] = cells->GetHighGain(iCell);
+    if (!fCellBufferHighGain[iCell]) lowGain = kTRUE;
+  }
+
+  // The time calibration table only holds the high gain calibration: with low gain cells in the
+  // event, run the components one after the other (the cells were not modified so far)
+  if (timeCalib && lowGain) {
+    for (std::size_t iComponent = firstComponent; iComponent <= lastComponent; iComponent++)
+    {
+      auto startComponent = std::chrono::steady_clock::now();
+      fCorrectionComponents[iComponent]->Run();
+      fComponentTiming->Fill(iComponent, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startComponent).count());
+    }
+    return;
+  }
+
+  // Correct
+  for (Int_t iCell = 0; iCell < nCells; iCell++)
+  {
+    for (auto table : tables)
+    {
+      table->Apply(fCellBufferAbsId[iCell], bunchCrossNo, fCellBufferAmplitude[iCell], fCellBufferTime[iCell]);
+    }
+  }
+
+  // Write back, as AliEMCALRecoUtils::RecalibrateCells()
+  for (Int_t iCell = 0; iCell < nCells; iCell++)
+  {
+    cells->SetCell(iCell, fCellBufferAbsId[iCell], fCellBufferAmplitude[iCell], fCellBufferTime[iCell], fCellBufferMCLabel[iCell], fCellBufferEFrac[iCell], fCellBufferHighGain[iCell]);
+  }
+  cells->Sort();
+
+  fComponentTiming->Fill(fCorrectionComponents.size(), std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+}
+
 /**
  * Executed when the file is changed. Also calls UserNotify() for each component.
  */
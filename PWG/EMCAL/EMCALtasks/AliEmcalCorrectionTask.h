@@ -10,6 +10,7 @@ class AliEmcalCorrectionCellContainer;
 class AliEmcalCorrectionComponent;
 class AliEMCALGeometry;
 class AliVEvent;
+class TProfile;
 
 #include <iosfwd>
 
@@ -22,6 +23,7 @@ class AliVEvent;
 #include "AliTrackContainer.h"
 #include "AliClusterContainer.h"
 #include "AliEmcalTrackSelection.h"
+#include "AliEmcalCorrectionPositionCache.h"
 
 /**
  * @class AliEmcalCorrectionTask
@@ -97,6 +99,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Set
   void                        SetForceBeamType(BeamType f)                          { fForceBeamType     = f                              ; }
   void                        SetNeedEmcalGeometry(Bool_t b)                        { fNeedEmcalGeom = b; }
+  /// Apply consecutive cell corrections on the same cells in a single pass over the cells (off by default; events with low gain cells and time calibration are corrected component by component)
+  void                        SetFuseCellCorrections(Bool_t b)                      { fFuseCellCorrections = b; }
   // Centrality options
   void                        SetUseNewCentralityEstimation(Bool_t b)               { fUseNewCentralityEstimation = b                     ; }
   virtual void                SetNCentBins(Int_t n)                                 { fNcentBins         = n                              ; }
@@ -167,6 +171,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Execute component functions
   void UserCreateOutputObjectsComponents();
   void ExecOnceComponents();
+  void SetEventPropertiesInComponent(AliEmcalCorrectionComponent * component);
+  void RunFusedCellCorrections(std::size_t firstComponent, std::size_t lastComponent);
 
   // Initialization functions
   void InitializeConfiguration();
@@ -231,11 +237,22 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   TObjArray                   fParticleCollArray;          ///< Particle/track collection array
   TObjArray                   fClusterCollArray;           ///< Cluster collection array
   std::vector <AliEmcalCorrectionCellContainer *> fCellCollArray; ///< Cells collection array
+
+  Bool_t                      fFuseCellCorrections;        ///< Apply consecutive cell corrections in a single pass over the cells
+  // Cells gathered for the fused cell corrections (structure of arrays)
+  std::vector <Short_t>       fCellBufferAbsId;            //!<! Cell absolute IDs
+  std::vector <Double_t>      fCellBufferAmplitude;        //!<! Cell energies
+  std::vector <Double_t>      fCellBufferTime;             //!<! Cell times
+  std::vector <Int_t>         fCellBufferMCLabel;          //!<! Cell MC labels
+  std::vector <Double_t>      fCellBufferEFrac;            //!<! Cell embedded energy fractions
+  std::vector <Bool_t>        fCellBufferHighGain;         //!<! Cell high gain flags
   
   TList *                     fOutput;                     //!<! Output for histograms
+  TProfile *                  fComponentTiming;            //!<! Average time per event spent in each component
+  AliEmcalCorrectionPositionCache fPositionCache;          //!<! Per-event cluster and track positions shared by the components
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionTask, 4); // EMCal correction task
+  ClassDef(AliEmcalCorrectionTask, 6); // EMCal correction task
   /// \endcond
 };
 
@@ -37,6 +37,8 @@
 #pragma link C++ class  AliEmcalCorrectionCellContainer+;
 #pragma link C++ class  std::vector<AliEmcalCorrectionCellContainer *>+;
 #pragma link C++ class  AliEmcalCorrectionComponent+;
+#pragma link C++ class  AliEmcalCorrectionCellTable+;
+#pragma link C++ class  AliEmcalCorrectionPositionCache+;
 #pragma link C++ class  AliEmcalCorrectionCellBadChannel+;
 #pragma link C++ class  AliEmcalCorrectionCellEnergy+;
 #pragma link C++ class  AliEmcalCorrectionCellTimeCalib+;
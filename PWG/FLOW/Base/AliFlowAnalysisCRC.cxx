@@ -45,6 +45,7 @@
 #include "AliFlowVector.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisCRC.h"
+#include "AliFlowQVectorEngine.h"
 #include "AliLog.h"
 #include "TRandom.h"
 #include "TF1.h"
@@ -145,6 +146,7 @@ fUseQvectorTerms(kFALSE),
 fReQ(NULL),
 fImQ(NULL),
 fSpk(NULL),
+fQVectorEngine(NULL),
 fIntFlowCorrelationsEBE(NULL),
 fIntFlowEventWeightsForCorrelationsEBE(NULL),
 fIntFlowCorrelationsAllEBE(NULL),
@@ -398,6 +400,7 @@ AliFlowAnalysisCRC::~AliFlowAnalysisCRC()
   delete[] fCorrMap;
   delete[] fchisqVA;
   delete[] fchisqVC;
+  delete fQVectorEngine;
 } // end of AliFlowAnalysisCRC::~AliFlowAnalysisCRC()
 
 //================================================================================================================
@@ -774,28 +777,14 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
           //          wPhiEta *= 1./fEtaWeightsHist[fCenBin][ptbin][cw]->GetBinContent(fEtaWeightsHist[fCenBin][ptbin][cw]->FindBin(dEta));
         }
         
-        // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-        for(Int_t m=0;m<12;m++) // to be improved - hardwired 6
-        {
-          for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-          {
-            (*fReQ)(m,k)+=pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi);
-            (*fImQ)(m,k)+=pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi);
-          }
-        }
-        // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-        for(Int_t p=0;p<8;p++)
-        {
-          for(Int_t k=0;k<9;k++)
-          {
-            (*fSpk)(p,k)+=pow(wPhiEta*wPhi*wPt*wEta*wTrack,k);
-          }
-        }
+        // Collect RP for Re[Q_{m*n,k}], Im[Q_{m*n,k}] and S_{p,k}, which are accumulated after the loop over data:
+        fQVectorEngine->AddToBatch(dPhi,dPt,dEta,wPhiEta*wPhi*wPt*wEta*wTrack);
         // Differential flow:
         if(fCalculateDiffFlow || fCalculate2DDiffFlow)
         {
           ptEta[0] = dPt;
           ptEta[1] = dEta;
+          fQVectorEngine->SetTrack(n*dPhi,wPhiEta*wPhi*wPt*wEta*wTrack); // cos((m+1)*n*dPhi), sin((m+1)*n*dPhi) and w^k tables
           // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs):
           for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
           {
@@ -805,21 +794,21 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
               {
                 for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
                 {
-                  fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                  fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+                  fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+                  fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);
                   if(m==0) // s_{p,k} does not depend on index m
                   {
-                    fs1dEBE[0][pe][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
+                    fs1dEBE[0][pe][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k),1.);
                   } // end of if(m==0) // s_{p,k} does not depend on index m
                 } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
               } // end of if(fCalculateDiffFlow)
               if(fCalculate2DDiffFlow)
               {
-                fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+                fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+                fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);
                 if(m==0) // s_{p,k} does not depend on index m
                 {
-                  fs2dEBE[0][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
+                  fs2dEBE[0][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k),1.);
                 } // end of if(m==0) // s_{p,k} does not depend on index m
               } // end of if(fCalculate2DDiffFlow)
             } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
@@ -836,21 +825,21 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
                 {
                   for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
                   {
-                    fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                    fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+                    fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+                    fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);
                     if(m==0) // s_{p,k} does not depend on index m
                     {
-                      fs1dEBE[2][pe][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
+                      fs1dEBE[2][pe][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k),1.);
                     } // end of if(m==0) // s_{p,k} does not depend on index m
                   } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
                 } // end of if(fCalculateDiffFlow)
                 if(fCalculate2DDiffFlow)
                 {
-                  fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                  fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+                  fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+                  fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);
                   if(m==0) // s_{p,k} does not depend on index m
                   {
-                    fs2dEBE[2][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
+                    fs2dEBE[2][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k),1.);
                   } // end of if(m==0) // s_{p,k} does not depend on index m
                 } // end of if(fCalculate2DDiffFlow)
               } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
@@ -948,6 +937,10 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
         
         ptEta[0] = dPt;
         ptEta[1] = dEta;
+        if(fCalculateDiffFlow || fCalculate2DDiffFlow)
+        {
+          fQVectorEngine->SetTrack(n*dPhi,wPhiEta*wPhi*wPt*wEta*wTrack); // cos((m+1)*n*dPhi), sin((m+1)*n*dPhi) and w^k tables
+        }
         // Calculate p_{m*n,k} ('p-vector' for POIs):
         for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
         {
@@ -957,46 +950,49 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
             {
               for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
               {
-                fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+                fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+                fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);
               } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
             } // end of if(fCalculateDiffFlow)
             if(fCalculate2DDiffFlow)
             {
-              fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-              fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+              fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+              fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);
             } // end of if(fCalculate2DDiffFlow)
           } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
         } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
         
+        // cos((h+1)*dPhi), sin((h+1)*dPhi) and wPhiEta^k tables for the Q-vectors below:
+        fQVectorEngine->SetTrack(dPhi,wPhiEta);
+        
         // Charge-Rapidity Correlations
         for (Int_t h=0;h<fCRCnHar;h++) {
           
-          fCRCQRe[cw][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-          fCRCQIm[cw][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
+          fCRCQRe[cw][h]->Fill(dEta,wPhiEta*fQVectorEngine->Cos(h+1));
+          fCRCQIm[cw][h]->Fill(dEta,wPhiEta*fQVectorEngine->Sin(h+1));
           fCRCMult[cw][h]->Fill(dEta,wPhiEta);
           
-          fCRC2QRe[cw][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-          fCRC2QIm[cw][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
+          fCRC2QRe[cw][h]->Fill(dEta,wPhiEta*fQVectorEngine->Cos(h+1));
+          fCRC2QIm[cw][h]->Fill(dEta,wPhiEta*fQVectorEngine->Sin(h+1));
           fCRC2Mul[cw][h]->Fill(dEta,wPhiEta);
           
-          fCRCZDCQRe[cw][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-          fCRCZDCQIm[cw][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
+          fCRCZDCQRe[cw][h]->Fill(dEta,wPhiEta*fQVectorEngine->Cos(h+1));
+          fCRCZDCQIm[cw][h]->Fill(dEta,wPhiEta*fQVectorEngine->Sin(h+1));
           fCRCZDCMult[cw][h]->Fill(dEta,wPhiEta);
           
           if(fRandom->Integer(2)>0.5) {
-            fCRC2QRe[2][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-            fCRC2QIm[2][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
+            fCRC2QRe[2][h]->Fill(dEta,wPhiEta*fQVectorEngine->Cos(h+1));
+            fCRC2QIm[2][h]->Fill(dEta,wPhiEta*fQVectorEngine->Sin(h+1));
             fCRC2Mul[2][h]->Fill(dEta,wPhiEta);
           }
           
           if(fRandom->Integer(2)>0.5) {
-            fCRCZDCQRe[2][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-            fCRCZDCQIm[2][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
+            fCRCZDCQRe[2][h]->Fill(dEta,wPhiEta*fQVectorEngine->Cos(h+1));
+            fCRCZDCQIm[2][h]->Fill(dEta,wPhiEta*fQVectorEngine->Sin(h+1));
             fCRCZDCMult[2][h]->Fill(dEta,wPhiEta);
           } else {
-            fCRCZDCQRe[3][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-            fCRCZDCQIm[3][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
+            fCRCZDCQRe[3][h]->Fill(dEta,wPhiEta*fQVectorEngine->Cos(h+1));
+            fCRCZDCQIm[3][h]->Fill(dEta,wPhiEta*fQVectorEngine->Sin(h+1));
             fCRCZDCMult[3][h]->Fill(dEta,wPhiEta);
           }
           
@@ -1006,11 +1002,11 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
               Double_t weraw = fZDCESESpecWeightsHist[fZDCESEclEbE]->GetBinContent(fZDCESESpecWeightsHist[fZDCESEclEbE]->FindBin(fCentralityEBE,dPt));
               if(weraw > 0.) SpecWeig = 1./weraw;
             }
-            fCMEQRe[cw][h]->Fill(dEta,SpecWeig*wPhiEta*TMath::Cos((h+1.)*dPhi));
-            fCMEQIm[cw][h]->Fill(dEta,SpecWeig*wPhiEta*TMath::Sin((h+1.)*dPhi));
+            fCMEQRe[cw][h]->Fill(dEta,SpecWeig*wPhiEta*fQVectorEngine->Cos(h+1));
+            fCMEQIm[cw][h]->Fill(dEta,SpecWeig*wPhiEta*fQVectorEngine->Sin(h+1));
             fCMEMult[cw][h]->Fill(dEta,SpecWeig*wPhiEta);
-            fCMEQRe[2+cw][h]->Fill(dEta,pow(SpecWeig*wPhiEta,2.)*TMath::Cos((h+1.)*dPhi));
-            fCMEQIm[2+cw][h]->Fill(dEta,pow(SpecWeig*wPhiEta,2.)*TMath::Sin((h+1.)*dPhi));
+            fCMEQRe[2+cw][h]->Fill(dEta,pow(SpecWeig*wPhiEta,2.)*fQVectorEngine->Cos(h+1));
+            fCMEQIm[2+cw][h]->Fill(dEta,pow(SpecWeig*wPhiEta,2.)*fQVectorEngine->Sin(h+1));
             fCMEMult[2+cw][h]->Fill(dEta,pow(SpecWeig*wPhiEta,2.));
             
             // spectra
@@ -1027,38 +1023,38 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
             
             if(fFlowQCDeltaEta>0.) {
               
-              fPOIPtDiffQRe[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-              fPOIPtDiffQIm[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-              fPOIPtDiffMul[k][h]->Fill(dPt,pow(wPhiEta,k));
+              fPOIPtDiffQRe[k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(h+1));
+              fPOIPtDiffQIm[k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(h+1));
+              fPOIPtDiffMul[k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k));
               
-              fPOIPtDiffQReCh[cw][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-              fPOIPtDiffQImCh[cw][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-              fPOIPtDiffMulCh[cw][k][h]->Fill(dPt,pow(wPhiEta,k));
+              fPOIPtDiffQReCh[cw][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(h+1));
+              fPOIPtDiffQImCh[cw][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(h+1));
+              fPOIPtDiffMulCh[cw][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k));
               
-              fPOIPhiDiffQRe[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-              fPOIPhiDiffQIm[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-              fPOIPhiDiffMul[k][h]->Fill(dPhi,pow(wPhiEta,k));
+              fPOIPhiDiffQRe[k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(h+1));
+              fPOIPhiDiffQIm[k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(h+1));
+              fPOIPhiDiffMul[k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k));
               
               if(fabs(dEta)>fFlowQCDeltaEta/2.) {
                 Int_t keta = (dEta<0.?0:1);
-                fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k));
-                fPOIPhiDiffQReEG[keta][k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPhiDiffQImEG[keta][k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPhiDiffMulEG[keta][k][h]->Fill(dPhi,pow(wPhiEta,k));
+                fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(h+1));
+                fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(h+1));
+                fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k));
+                fPOIPhiDiffQReEG[keta][k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(h+1));
+                fPOIPhiDiffQImEG[keta][k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(h+1));
+                fPOIPhiDiffMulEG[keta][k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k));
               }
               
             } else if(fFlowQCDeltaEta<0. && fFlowQCDeltaEta>-1.) {
               
               if(dEta>0.) {
-                fPOIPtDiffQRe[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPtDiffQIm[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPtDiffMul[k][h]->Fill(dPt,pow(wPhiEta,k));
+                fPOIPtDiffQRe[k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(h+1));
+                fPOIPtDiffQIm[k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(h+1));
+                fPOIPtDiffMul[k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k));
                 
-                fPOIPhiDiffQRe[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPhiDiffQIm[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPhiDiffMul[k][h]->Fill(dPhi,pow(wPhiEta,k));
+                fPOIPhiDiffQRe[k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(h+1));
+                fPOIPhiDiffQIm[k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(h+1));
+                fPOIPhiDiffMul[k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k));
                 
                 Double_t boundetagap = fabs(fFlowQCDeltaEta);
                 
@@ -1066,9 +1062,9 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
                   Int_t keta;
                   if(dEta>0. && dEta<0.4-boundetagap/2.) keta = 0;
                   else keta = 1;
-                  fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                  fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                  fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k));
+                  fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(h+1));
+                  fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(h+1));
+                  fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k));
                 }
               } else {
                 bFillDis = kFALSE;
@@ -1078,13 +1074,13 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
             } else if(fFlowQCDeltaEta<-1. && fFlowQCDeltaEta>-2.) {
               
               if(dEta<0.) {
-                fPOIPtDiffQRe[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPtDiffQIm[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPtDiffMul[k][h]->Fill(dPt,pow(wPhiEta,k));
+                fPOIPtDiffQRe[k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(h+1));
+                fPOIPtDiffQIm[k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(h+1));
+                fPOIPtDiffMul[k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k));
                 
-                fPOIPhiDiffQRe[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPhiDiffQIm[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPhiDiffMul[k][h]->Fill(dPhi,pow(wPhiEta,k));
+                fPOIPhiDiffQRe[k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(h+1));
+                fPOIPhiDiffQIm[k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(h+1));
+                fPOIPhiDiffMul[k][h]->Fill(dPhi,fQVectorEngine->WeightToPower(k));
                 
                 Double_t boundetagap = fabs(fFlowQCDeltaEta)-1.;
                 
@@ -1092,9 +1088,9 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
                   Int_t keta;
                   if(dEta<0. && dEta>-0.4+boundetagap/2.) keta = 0;
                   else keta = 1;
-                  fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                  fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                  fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k));
+                  fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(h+1));
+                  fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(h+1));
+                  fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,fQVectorEngine->WeightToPower(k));
                 }
               } else {
                 bFillDis = kFALSE;
@@ -1106,8 +1102,8 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
         }
         
         for (Int_t h=0;h<fFlowNHarmMax;h++) {
-          fEtaDiffQRe[cw][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-          fEtaDiffQIm[cw][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
+          fEtaDiffQRe[cw][h]->Fill(dEta,wPhiEta*fQVectorEngine->Cos(h+1));
+          fEtaDiffQIm[cw][h]->Fill(dEta,wPhiEta*fQVectorEngine->Sin(h+1));
           fEtaDiffMul[cw][h]->Fill(dEta,wPhiEta);
         }
         
@@ -1129,6 +1125,11 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
   // ************************************************************************************************************
   
   
+  // Accumulate Q_{m*n,k} and S_{p,k} over the collected RPs:
+  fQVectorEngine->AccumulateQ(fReQ,fImQ,n);
+  fQVectorEngine->AccumulateWeightPowerSums(fSpk);
+  fQVectorEngine->ClearBatch();
+  
   // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
   for(Int_t p=0;p<8;p++)
   {
@@ -2510,6 +2511,8 @@ void AliFlowAnalysisCRC::BookEverythingForIntegratedFlow()
   fReQ = new TMatrixD(12,9);
   fImQ = new TMatrixD(12,9);
   fSpk = new TMatrixD(8,9);
+  // engine accumulating the above, with single track tables for harmonics up to fFlowNHarmMax and weight powers up to 8:
+  fQVectorEngine = new AliFlowQVectorEngine(TMath::Max(4,fFlowNHarmMax),9);
   // average correlations <2>, <4>, <6> and <8> for single event (bining is the same as in fIntFlowCorrelationsPro and fIntFlowCorrelationsHist):
   TString intFlowCorrelationsEBEName = "fIntFlowCorrelationsEBE";
   intFlowCorrelationsEBEName += fAnalysisLabel->Data();
@@ -24,6 +24,7 @@
 #define AliFlowAnalysisWithMultiparticleCorrelations_cxx
 
 #include "AliFlowAnalysisWithMultiparticleCorrelations.h"
+#include "AliFlowQVectorEngine.h"
 
 using std::endl;
 using std::cout;
@@ -64,6 +65,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
  fQvectorFlagsPro(NULL),
  fCalculateQvector(kFALSE),
  fCalculateDiffQvectors(kFALSE),
+ fQVectorEngine(NULL),
  // 3.) Correlations:
  fCorrelationsList(NULL),
  fCorrelationsFlagsPro(NULL),
@@ -169,6 +171,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleC
  // Destructor.
  
  delete fHistList;
+ delete fQVectorEngine;
 
 } // end of AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleCorrelations()
 
@@ -1994,11 +1997,18 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
 {
  // Fill Q-vector components.
 
+ // cos(h*phi), sin(h*phi) and w^p are obtained from one sincos and repeated multiplication per track in AliFlowQVectorEngine.
+ Int_t nHarmonics = fMaxHarmonic*fMaxCorrelator+1;
+ Int_t nPowers = fMaxCorrelator+1;
+ if(!fQVectorEngine){fQVectorEngine = new AliFlowQVectorEngine(nHarmonics-1,nPowers);}
+ fQVectorEngine->ClearBatch();
+ Bool_t bUseRPWeights = fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2];
+ Bool_t bUsePOIWeights = fUseWeights[1][0]||fUseWeights[1][1]||fUseWeights[1][2];
+
  Int_t nTracks = anEvent->NumberOfTracks(); // TBI shall I promote this to data member?
  Double_t dPhi = 0., wPhi = 1.; // azimuthal angle and corresponding phi weight
  Double_t dPt = 0., wPt = 1.; // transverse momentum and corresponding pT weight
  Double_t dEta = 0., wEta = 1.; // pseudorapidity and corresponding eta weight
- Double_t wToPowerP = 1.; // weight raised to power p
  Int_t nCounterRPs = 0;
  for(Int_t t=0;t<nTracks;t++) // loop over all tracks
  {
@@ -2023,7 +2033,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
    nCounterRPs++;
    if(fSelectRandomlyRPs && nCounterRPs == fnSelectedRandomlyRPs){break;} // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
 
-   wPhi = 1.; wPt = 1.; wEta = 1.; wToPowerP = 1.; // TBI this shall go somewhere else, for performance sake
+   wPhi = 1.; wPt = 1.; wEta = 1.;
 
    // Access kinematic variables for RP and corresponding weights:
    dPhi = pTrack->Phi(); // azimuthal angle
@@ -2035,22 +2045,15 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
    dEta = pTrack->Eta();
    if(fUseWeights[0][2]){wEta = Weight(dEta,"RP","eta");} // corresponding eta weight
 
-   // Calculate Q-vector components:
-   for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
-   {
-    for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
-    {
-     if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-     fQvector[h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
-    } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
-   } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+   // Collect RP for Q-vector components, which are accumulated after the loop over all tracks:
+   fQVectorEngine->AddToBatch(dPhi,dPt,dEta,bUseRPWeights ? wPhi*wPt*wEta : 1.);
   } // if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
 
   // Differential Q-vectors (a.k.a. p-vector and q-vector):
   if(!fCalculateDiffQvectors){continue;}
   if(pTrack->InPOISelection()) 
   {
-   wPhi = 1.; wPt = 1.; wEta = 1.; wToPowerP = 1.; // TBI this shall go somewhere else, for performance sake
+   wPhi = 1.; wPt = 1.; wEta = 1.;
 
    // Access kinematic variables for POI and corresponding weights:
    dPhi = pTrack->Phi(); // azimuthal angle
@@ -2071,39 +2074,53 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
      {
       binNo = fDiffCorrelationsPro[0][0]->FindBin(dEta); // TBI: hardwired [0][0]
      }
-   // Calculate p-vector components:
-   for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+
+   if(!pTrack->InRPSelection())
    {
-    for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
+    // Calculate p-vector components:
+    fQVectorEngine->SetTrack(dPhi,bUsePOIWeights ? wPhi*wPt*wEta : 1.);
+    for(Int_t h=0;h<nHarmonics;h++)
     {
-     if(fUseWeights[1][0]||fUseWeights[1][1]||fUseWeights[1][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-     fpvector[binNo-1][h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
-
-     if(pTrack->InRPSelection()) 
+     for(Int_t wp=0;wp<nPowers;wp++) // weight power
      {
-      // Fill q-vector components:
-      wPhi = 1.; wPt = 1.; wEta = 1.; wToPowerP = 1.; // TBI this shall go somewhere else, for performance sake
-
-      if(fUseWeights[0][0]){wPhi = Weight(dPhi,"RP","phi");} // corresponding phi weight
-      //if(dPhi < 0.){dPhi += TMath::TwoPi();} TBI
-      //if(dPhi > TMath::TwoPi()){dPhi -= TMath::TwoPi();} TBI
-      if(fUseWeights[0][1]){wPt = Weight(dPt,"RP","pt");} // corresponding pT weight
-      if(fUseWeights[0][2]){wEta = Weight(dEta,"RP","eta");} // corresponding eta weight
-      if(fUseWeights[1][0]){wPhi = Weight(dPhi,"POI","phi");} // corresponding phi weight
-      //if(dPhi < 0.){dPhi += TMath::TwoPi();} TBI
-      //if(dPhi > TMath::TwoPi()){dPhi -= TMath::TwoPi();} TBI
-      if(fUseWeights[1][1]){wPt = Weight(dPt,"POI","pt");} // corresponding pT weight
-      if(fUseWeights[1][2]){wEta = Weight(dEta,"POI","eta");} // corresponding eta weight
-      if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]||fUseWeights[1][0]||fUseWeights[1][1]||fUseWeights[1][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-      fqvector[binNo-1][h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
-     } // if(pTrack->InRPSelection()) 
-
-    } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
-   } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+      Double_t wToPowerP = fQVectorEngine->WeightToPower(wp); // weight raised to power p
+      fpvector[binNo-1][h][wp] += TComplex(wToPowerP*fQVectorEngine->Cos(h),wToPowerP*fQVectorEngine->Sin(h));
+     } // for(Int_t wp=0;wp<nPowers;wp++)
+    } // for(Int_t h=0;h<nHarmonics;h++)
+    continue;
+   } // if(!pTrack->InRPSelection())
+
+   // q-vector weights: RP weight, replaced by POI weight where the latter is used:
+   Double_t qPhi = fUseWeights[1][0] ? wPhi : (fUseWeights[0][0] ? Weight(dPhi,"RP","phi") : 1.);
+   Double_t qPt = fUseWeights[1][1] ? wPt : (fUseWeights[0][1] ? Weight(dPt,"RP","pt") : 1.);
+   Double_t qEta = fUseWeights[1][2] ? wEta : (fUseWeights[0][2] ? Weight(dEta,"RP","eta") : 1.);
+   fQVectorEngine->SetTrack(dPhi,(bUseRPWeights||bUsePOIWeights) ? qPhi*qPt*qEta : 1.);
+
+   // Calculate p-vector and q-vector components:
+   for(Int_t h=0;h<nHarmonics;h++)
+   {
+    for(Int_t wp=0;wp<nPowers;wp++) // weight power
+    {
+     Double_t dCos = fQVectorEngine->Cos(h);
+     Double_t dSin = fQVectorEngine->Sin(h);
+     Double_t wToPowerP = fQVectorEngine->WeightToPower(wp); // weight raised to power p
+     fqvector[binNo-1][h][wp] += TComplex(wToPowerP*dCos,wToPowerP*dSin);
+     // TBI the p-vector of particles which are both RP and POI is filled with the q-vector weight, as it always was.
+     //     Without POI weights the power also lags by one step (the weight left over from the previous q-vector term):
+     Double_t wToPowerPForP = 1.;
+     if(bUsePOIWeights){wToPowerPForP = wToPowerP;}
+     else if(bUseRPWeights && (h>0||wp>0)){wToPowerPForP = fQVectorEngine->WeightToPower(wp>0 ? wp-1 : nPowers-1);}
+     fpvector[binNo-1][h][wp] += TComplex(wToPowerPForP*dCos,wToPowerPForP*dSin);
+    } // for(Int_t wp=0;wp<nPowers;wp++)
+   } // for(Int_t h=0;h<nHarmonics;h++)
   } // if(pTrack->InPOISelection()) 
 
  } // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
 
+ // Calculate Q-vector components:
+ fQVectorEngine->AccumulateQ(&fQvector[0][0],nHarmonics,nPowers,(Int_t)(sizeof(fQvector[0])/sizeof(fQvector[0][0])));
+ fQVectorEngine->ClearBatch();
+
 } // void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimple *anEvent)
 
 //=======================================================================================================================
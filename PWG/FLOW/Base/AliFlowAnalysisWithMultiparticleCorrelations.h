@@ -31,6 +31,8 @@
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
 
+class AliFlowQVectorEngine;
+
 class AliFlowAnalysisWithMultiparticleCorrelations{
  public:
   AliFlowAnalysisWithMultiparticleCorrelations();
@@ -385,6 +387,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t fCalculateDiffQvectors; // to calculate or not to calculate p- and q-vector components, that's a Boolean...  
   TComplex fpvector[100][49][9]; // p-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
   TComplex fqvector[100][49][9]; // q-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
+  AliFlowQVectorEngine *fQVectorEngine; //! cos/sin(h*phi) and weight power tables, accumulates fQvector
 
   // 3.) Correlations:
   TList *fCorrelationsList;           // list to hold all correlations objects
@@ -476,7 +479,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Int_t fHighestHarmonicEtaGaps;      // 2-p correlations with eta gaps will be calculated for harmonics [fLowestHarmonicEtaGaps,fHighestHarmonicEtaGaps]
   TProfile *fEtaGapsPro[6];           // [harmonic] different eta gaps are different bins
 
-  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,6);
+  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,7);
 
 };
 
@@ -41,11 +41,13 @@
 #include "TPaveLabel.h"
 #include "TCanvas.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventColumns.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisWithQCumulants.h"
 #include "TArrayD.h"
 #include "TRandom.h"
 #include "TF1.h"
+#include "AliFlowQVectorEngine.h"
 
 class TH1;
 class TH2;
@@ -137,6 +139,7 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fReQ(NULL),
  fImQ(NULL),
  fSpk(NULL),
+ fQVectorEngine(NULL),
  fIntFlowCorrelationsEBE(NULL),
  fIntFlowEventWeightsForCorrelationsEBE(NULL),
  fIntFlowCorrelationsAllEBE(NULL),
@@ -271,6 +274,7 @@ AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
  // destructor
  
  delete fHistList;
+ delete fQVectorEngine;
 
 } // end of AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
 
@@ -409,28 +413,14 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     {
      wTrack = aftsTrack->Weight(); 
     }
-    // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
-    {
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
-    }
-    // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
-    {
-     for(Int_t k=0;k<9;k++)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
-     }
-    } 
+    // Collect RP for Re[Q_{m*n,k}], Im[Q_{m*n,k}] and S_{p,k}, which are accumulated after the loop over data:
+    fQVectorEngine->AddToBatch(dPhi,dPt,dEta,wPhi*wPt*wEta*wTrack);
     // Differential flow:
     if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
      ptEta[0] = dPt; 
      ptEta[1] = dEta; 
+     fQVectorEngine->SetTrack(n*dPhi,wPhi*wPt*wEta*wTrack); // cos((m+1)*n*dPhi), sin((m+1)*n*dPhi) and w^k tables
      // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs): 
      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
      {
@@ -440,21 +430,21 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
        {
         for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
         {
-         fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
+         fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+         fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);          
          if(m==0) // s_{p,k} does not depend on index m
          {
-          fs1dEBE[0][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
+          fs1dEBE[0][pe][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k),1.);
          } // end of if(m==0) // s_{p,k} does not depend on index m
         } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
        } // end of if(fCalculateDiffFlow) 
        if(fCalculate2DDiffFlow)
        {
-        fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
+        fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+        fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);      
         if(m==0) // s_{p,k} does not depend on index m
         {
-         fs2dEBE[0][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
+         fs2dEBE[0][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k),1.);
         } // end of if(m==0) // s_{p,k} does not depend on index m
        } // end of if(fCalculate2DDiffFlow)
       } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
@@ -471,21 +461,21 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
         {
          for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
          {
-          fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-          fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
+          fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+          fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);          
           if(m==0) // s_{p,k} does not depend on index m
           {
-           fs1dEBE[2][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
+           fs1dEBE[2][pe][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k),1.);
           } // end of if(m==0) // s_{p,k} does not depend on index m
          } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
         } // end of if(fCalculateDiffFlow) 
         if(fCalculate2DDiffFlow)
         {
-         fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
+         fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+         fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);      
          if(m==0) // s_{p,k} does not depend on index m
          {
-          fs2dEBE[2][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
+          fs2dEBE[2][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k),1.);
          } // end of if(m==0) // s_{p,k} does not depend on index m
         } // end of if(fCalculate2DDiffFlow)
        } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
@@ -521,6 +511,10 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     }
     ptEta[0] = dPt;
     ptEta[1] = dEta;
+    if(fCalculateDiffFlow || fCalculate2DDiffFlow)
+    {
+     fQVectorEngine->SetTrack(n*dPhi,wPhi*wPt*wEta*wTrack); // cos((m+1)*n*dPhi), sin((m+1)*n*dPhi) and w^k tables
+    }
     // Calculate p_{m*n,k} ('p-vector' for POIs): 
     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
     {
@@ -530,14 +524,14 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
       {
        for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
        {
-        fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
+        fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+        fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);          
        } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
       } // end of if(fCalculateDiffFlow) 
       if(fCalculate2DDiffFlow)
       {
-       fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-       fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
+       fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Cos(m+1),1.);
+       fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,fQVectorEngine->WeightToPower(k)*fQVectorEngine->Sin(m+1),1.);      
       } // end of if(fCalculate2DDiffFlow)
      } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
@@ -548,47 +542,14 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     }
  } // end of for(Int_t i=0;i<nPrim;i++) 
 
- // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
- for(Int_t p=0;p<8;p++)
- {
-  for(Int_t k=0;k<9;k++)
-  {
-   (*fSpk)(p,k)=pow((*fSpk)(p,k),p+1);
-   // ... for the time being s_{p,k} dosn't need higher powers, so no need to finalize it here ...
-  } // end of for(Int_t k=0;k<9;k++)  
- } // end of for(Int_t p=0;p<8;p++)
- 
+ // Accumulate Q_{m*n,k} and S_{p,k} over the collected RPs:
+ fQVectorEngine->AccumulateQ(fReQ,fImQ,n);
+ fQVectorEngine->AccumulateWeightPowerSums(fSpk);
+ fQVectorEngine->ClearBatch();
+
+ // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!);
  // f) Call the methods which calculate correlations for reference flow:
- if(!fEvaluateIntFlowNestedLoops)
- {
-  if(!(fUsePhiWeights||fUsePtWeights||fUseEtaWeights||fUseTrackWeights))
-  {
-   if(fNumberOfRPsEBE>1){this->CalculateIntFlowCorrelations();} // without using particle weights
-  } else // to if(!(fUsePhiWeights||fUsePtWeights||fUseEtaWeights||fUseTrackWeights))
-    {
-     if(fNumberOfRPsEBE>1){this->CalculateIntFlowCorrelationsUsingParticleWeights();} // with using particle weights   
-    }        
-  // Whether or not using particle weights the following is calculated in the same way:  
-  if(fNumberOfRPsEBE>3){this->CalculateIntFlowProductOfCorrelations();}
-  if(fNumberOfRPsEBE>1){this->CalculateIntFlowSumOfEventWeights();}
-  if(fNumberOfRPsEBE>1){this->CalculateIntFlowSumOfProductOfEventWeights();}  
-  // Non-isotropic terms:
-  if(!(fUsePhiWeights||fUsePtWeights||fUseEtaWeights||fUseTrackWeights))
-  {
-   if(fNumberOfRPsEBE>0){this->CalculateIntFlowCorrectionsForNUASinTerms();}
-   if(fNumberOfRPsEBE>0){this->CalculateIntFlowCorrectionsForNUACosTerms();}
-  } else // to if(!(fUsePhiWeights||fUsePtWeights||fUseEtaWeights||fUseTrackWeights))
-    {
-     if(fNumberOfRPsEBE>0){this->CalculateIntFlowCorrectionsForNUASinTermsUsingParticleWeights();}
-     if(fNumberOfRPsEBE>0){this->CalculateIntFlowCorrectionsForNUACosTermsUsingParticleWeights();}     
-    }      
-  // Whether or not using particle weights the following is calculated in the same way:  
-  if(fNumberOfRPsEBE>0){this->CalculateIntFlowProductOfCorrectionTermsForNUA();}     
-  if(fNumberOfRPsEBE>0){this->CalculateIntFlowSumOfEventWeightsNUA();}     
-  if(fNumberOfRPsEBE>0){this->CalculateIntFlowSumOfProductOfEventWeightsNUA();}     
-  // Mixed harmonics:
-  if(fCalculateMixedHarmonics){this->CalculateMixedHarmonics();}
- } // end of if(!fEvaluateIntFlowNestedLoops)
+ this->CalculateIntFlowFromQVectors();
 
  // g) Call the methods which calculate correlations for differential flow:
  if(!fEvaluateDiffFlowNestedLoops && fCalculateDiffFlow)
@@ -700,6 +661,158 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithQCumulants::Make(AliFlowEventColumns* anEvent)
+{
+ // Running over data in columnar form (AliFlowEventColumns), reference flow only.
+ 
+ // The RPs are read straight from the contiguous phi/pt/eta/weight arrays of the event,
+ // without AliFlowTrackSimple objects. Everything which needs the track objects is not 
+ // supported here: differential flow (1D and 2D), nested loops, the phi distribution 
+ // for one event and the per-track common control histograms (only their RP and POI
+ // multiplicities are filled). Particle weights are applied as in Make(AliFlowEventSimple*).
+ 
+ // a) Check all pointers used in this method and the settings supported for columnar input;
+ // b) Define local variables;
+ // c) Fill the multiplicity control histograms and call the method to fill fAvMultiplicity;
+ // d) Loop over RPs and collect them for Q_{n,k} and S_{p,k};
+ // e) Calculate the final expressions for S_{p,k};
+ // f) Call the methods which calculate correlations for reference flow;
+ // g) Distributions of correlations;
+ // h) Reset all event-by-event quantities (very important !!!!). 
+
+ // a) Check all pointers used in this method and the settings supported for columnar input:
+ this->CheckPointersUsedInMake();
+ if(fCalculateDiffFlow || fCalculate2DDiffFlow || fEvaluateIntFlowNestedLoops || fEvaluateDiffFlowNestedLoops || fStorePhiDistributionForOneEvent)
+ {
+  printf("\n WARNING (QC): Differential flow, nested loops and phi distribution for one event are not supported for AliFlowEventColumns input in Make() !!!!\n\n");
+  exit(0);
+ }
+ 
+ // b) Define local variables:
+ Double_t dPhi = 0.; // azimuthal angle in the laboratory frame
+ Double_t dPt  = 0.; // transverse momentum
+ Double_t dEta = 0.; // pseudorapidity
+ Double_t wPhi = 1.; // phi weight
+ Double_t wPt  = 1.; // pt weight
+ Double_t wEta = 1.; // eta weight
+ Double_t wTrack = 1.; // track weight
+ Int_t nCounterNoRPs = 0; // needed only for fExactNoRPs
+ fNumberOfRPsEBE = anEvent->GetNumberOfRPs(); // number of RPs (i.e. number of reference particles)
+ if(fExactNoRPs > 0 && fNumberOfRPsEBE<fExactNoRPs){return;}
+ fNumberOfPOIsEBE = anEvent->GetNumberOfPOIs(); // number of POIs (i.e. number of particles of interest)
+ fReferenceMultiplicityEBE = anEvent->GetReferenceMultiplicity(); // reference multiplicity for current event
+ 
+ // c) Fill the multiplicity control histograms and call the method to fill fAvMultiplicity:
+ fCommonHists->GetHistMultRP()->Fill(fNumberOfRPsEBE);
+ fCommonHists->GetHistMultPOI()->Fill(fNumberOfPOIsEBE);
+ this->FillAverageMultiplicities((Int_t)(fNumberOfRPsEBE)); 
+ if(fStoreControlHistograms)
+ {
+  fCorrelationNoRPsVsRefMult->Fill(fNumberOfRPsEBE,fReferenceMultiplicityEBE);
+  fCorrelationNoPOIsVsRefMult->Fill(fNumberOfPOIsEBE,fReferenceMultiplicityEBE);
+  fCorrelationNoRPsVsNoPOIs->Fill(fNumberOfRPsEBE,fNumberOfPOIsEBE);
+ }
+ 
+ // d) Loop over RPs and collect them for Q_{n,k} and S_{p,k}:
+ Int_t nPrim = anEvent->NumberOfTracks();
+ const Double_t *phi = anEvent->GetPhiArray();
+ const Double_t *pt = anEvent->GetPtArray();
+ const Double_t *eta = anEvent->GetEtaArray();
+ const Double_t *weight = anEvent->GetWeightArray();
+ const UInt_t *flags = anEvent->GetPOIFlagsArray();
+ for(Int_t i=0;i<nPrim;i++) 
+ { 
+  if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){break;}
+  if(!(flags[i] & 1u)){continue;} // RP condition
+  nCounterNoRPs++;
+  dPhi = phi[i];
+  dPt  = pt[i];
+  dEta = eta[i];
+  if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
+  {
+   wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
+  }
+  if(fUsePtWeights && fPtWeights && fnBinsPt) // determine pt weight for this particle:
+  {
+   wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
+  }              
+  if(fUseEtaWeights && fEtaWeights && fEtaBinWidth) // determine eta weight for this particle: 
+  {
+   wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
+  }      
+  if(fUseTrackWeights){wTrack = weight[i];}
+  fQVectorEngine->AddToBatch(dPhi,dPt,dEta,wPhi*wPt*wEta*wTrack);
+ } // end of for(Int_t i=0;i<nPrim;i++) 
+
+ // Accumulate Q_{m*n,k} and S_{p,k} over the collected RPs:
+ fQVectorEngine->AccumulateQ(fReQ,fImQ,fHarmonic);
+ fQVectorEngine->AccumulateWeightPowerSums(fSpk);
+ fQVectorEngine->ClearBatch();
+
+ // e) Calculate the final expressions for S_{p,k};
+ // f) Call the methods which calculate correlations for reference flow:
+ this->CalculateIntFlowFromQVectors();
+
+ // g) Distributions of correlations:
+ if(fStoreDistributions){this->StoreDistributionsOfCorrelations();}
+ 
+ // h) Reset all event-by-event quantities (very important !!!!):
+ this->ResetEventByEventQuantities();
+ 
+} // end of AliFlowAnalysisWithQCumulants::Make(AliFlowEventColumns* anEvent)
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::CalculateIntFlowFromQVectors()
+{
+ // Reference flow from the accumulated Q_{n,k} and S_{p,k} of the current event.
+
+ // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
+ for(Int_t p=0;p<8;p++)
+ {
+  for(Int_t k=0;k<9;k++)
+  {
+   (*fSpk)(p,k)=pow((*fSpk)(p,k),p+1);
+   // ... for the time being s_{p,k} dosn't need higher powers, so no need to finalize it here ...
+  } // end of for(Int_t k=0;k<9;k++)  
+ } // end of for(Int_t p=0;p<8;p++)
+ 
+ // f) Call the methods which calculate correlations for reference flow:
+ if(!fEvaluateIntFlowNestedLoops)
+ {
+  if(!(fUsePhiWeights||fUsePtWeights||fUseEtaWeights||fUseTrackWeights))
+  {
+   if(fNumberOfRPsEBE>1){this->CalculateIntFlowCorrelations();} // without using particle weights
+  } else // to if(!(fUsePhiWeights||fUsePtWeights||fUseEtaWeights||fUseTrackWeights))
+    {
+     if(fNumberOfRPsEBE>1){this->CalculateIntFlowCorrelationsUsingParticleWeights();} // with using particle weights   
+    }        
+  // Whether or not using particle weights the following is calculated in the same way:  
+  if(fNumberOfRPsEBE>3){this->CalculateIntFlowProductOfCorrelations();}
+  if(fNumberOfRPsEBE>1){this->CalculateIntFlowSumOfEventWeights();}
+  if(fNumberOfRPsEBE>1){this->CalculateIntFlowSumOfProductOfEventWeights();}  
+  // Non-isotropic terms:
+  if(!(fUsePhiWeights||fUsePtWeights||fUseEtaWeights||fUseTrackWeights))
+  {
+   if(fNumberOfRPsEBE>0){this->CalculateIntFlowCorrectionsForNUASinTerms();}
+   if(fNumberOfRPsEBE>0){this->CalculateIntFlowCorrectionsForNUACosTerms();}
+  } else // to if(!(fUsePhiWeights||fUsePtWeights||fUseEtaWeights||fUseTrackWeights))
+    {
+     if(fNumberOfRPsEBE>0){this->CalculateIntFlowCorrectionsForNUASinTermsUsingParticleWeights();}
+     if(fNumberOfRPsEBE>0){this->CalculateIntFlowCorrectionsForNUACosTermsUsingParticleWeights();}     
+    }      
+  // Whether or not using particle weights the following is calculated in the same way:  
+  if(fNumberOfRPsEBE>0){this->CalculateIntFlowProductOfCorrectionTermsForNUA();}     
+  if(fNumberOfRPsEBE>0){this->CalculateIntFlowSumOfEventWeightsNUA();}     
+  if(fNumberOfRPsEBE>0){this->CalculateIntFlowSumOfProductOfEventWeightsNUA();}     
+  // Mixed harmonics:
+  if(fCalculateMixedHarmonics){this->CalculateMixedHarmonics();}
+ } // end of if(!fEvaluateIntFlowNestedLoops)
+
+} // end of void AliFlowAnalysisWithQCumulants::CalculateIntFlowFromQVectors()
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithQCumulants::Finish()
 {
  // Calculate the final results.
@@ -1773,6 +1886,8 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForIntegratedFlow()
  fReQ = new TMatrixD(12,9);
  fImQ = new TMatrixD(12,9);
  fSpk = new TMatrixD(8,9);
+ // engine accumulating the above, with single track tables for harmonics up to 4n and weight powers up to 8:
+ fQVectorEngine = new AliFlowQVectorEngine(4,9);
  // average correlations <2>, <4>, <6> and <8> for single event (bining is the same as in fIntFlowCorrelationsPro and fIntFlowCorrelationsHist):
  TString intFlowCorrelationsEBEName = "fIntFlowCorrelationsEBE";
  intFlowCorrelationsEBEName += fAnalysisLabel->Data();
@@ -24925,6 +25040,11 @@ void AliFlowAnalysisWithQCumulants::CheckPointersUsedInMake()
   printf("\n WARNING (QC): fAvMultiplicity is NULL in CheckPointersUsedInMake() !!!!\n\n");
   exit(0);
  }
+ if(!fQVectorEngine)
+ {
+  printf("\n WARNING (QC): fQVectorEngine is NULL in CheckPointersUsedInMake() !!!!\n\n");
+  exit(0);
+ }
  if((fUsePhiWeights||fUsePtWeights||fUseEtaWeights||fUseTrackWeights) && !fIntFlowExtraCorrelationsPro) 
  {
   printf("\n WARNING (QC): fIntFlowExtraCorrelationsPro is NULL in CheckPointersUsedInMake() !!!!\n\n");
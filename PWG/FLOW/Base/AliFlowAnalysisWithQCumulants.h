@@ -30,7 +30,9 @@ class TProfile2D;
 class TDirectoryFile;
 
 class AliFlowEventSimple;
+class AliFlowEventColumns;
 class AliFlowVector;
+class AliFlowQVectorEngine;
 
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
@@ -76,6 +78,7 @@ class AliFlowAnalysisWithQCumulants{
     virtual void StoreBootstrapFlags();
   // 2.) method Make() and methods called within Make():
   virtual void Make(AliFlowEventSimple *anEvent);
+  virtual void Make(AliFlowEventColumns *anEvent); // reference flow only
     // 2a.) Common:
     virtual void CheckPointersUsedInMake();     
     virtual void FillAverageMultiplicities(Int_t nRP);
@@ -83,6 +86,7 @@ class AliFlowAnalysisWithQCumulants{
     virtual void FillControlHistograms(AliFlowEventSimple *anEvent);
     virtual void ResetEventByEventQuantities();
     // 2b.) Reference flow:
+    virtual void CalculateIntFlowFromQVectors();
     virtual void CalculateIntFlowCorrelations(); 
     virtual void CalculateIntFlowCorrelationsUsingParticleWeights();
     virtual void CalculateIntFlowProductOfCorrelations();
@@ -632,6 +636,7 @@ class AliFlowAnalysisWithQCumulants{
   TMatrixD *fReQ; //! fReQ[m][k] = sum_{i=1}^{M} w_{i}^{k} cos(m*phi_{i})
   TMatrixD *fImQ; //! fImQ[m][k] = sum_{i=1}^{M} w_{i}^{k} sin(m*phi_{i})
   TMatrixD *fSpk; //! fSM[p][k] = (sum_{i=1}^{M} w_{i}^{k})^{p+1}
+  AliFlowQVectorEngine *fQVectorEngine; //! accumulates fReQ, fImQ and fSpk, cos/sin and weight power tables for differential flow
   TH1D *fIntFlowCorrelationsEBE; // 1st bin: <2>, 2nd bin: <4>, 3rd bin: <6>, 4th bin: <8>
   TH1D *fIntFlowEventWeightsForCorrelationsEBE; // 1st bin: eW_<2>, 2nd bin: eW_<4>, 3rd bin: eW_<6>, 4th bin: eW_<8>
   TH1D *fIntFlowCorrelationsAllEBE; // to be improved (add comment)
@@ -847,7 +852,7 @@ class AliFlowAnalysisWithQCumulants{
   TH2D *fBootstrapCumulants; // x-axis => QC{2}, QC{4}, QC{6}, QC{8}; y-axis => subsample # 
   TH2D *fBootstrapCumulantsVsM[4]; // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity; y-axis => subsample # 
 
-  ClassDef(AliFlowAnalysisWithQCumulants, 4);
+  ClassDef(AliFlowAnalysisWithQCumulants, 5);
 
 };
 
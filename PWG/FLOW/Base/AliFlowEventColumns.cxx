@@ -0,0 +1,182 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/*****************************************************************
+  AliFlowEventColumns: columnar (structure of arrays) flow event.
+  All per-track quantities live in contiguous arrays which are
+  reused from event to event; see the header for the interface.
+*****************************************************************/
+
+#include "TBits.h"
+#include "AliFlowTrackSimple.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowEventColumns.h"
+
+ClassImp(AliFlowEventColumns)
+
+//-----------------------------------------------------------------------
+AliFlowEventColumns::AliFlowEventColumns():
+  TObject(),
+  fPhi(),
+  fEta(),
+  fPt(),
+  fWeight(),
+  fCharge(),
+  fID(),
+  fPOIFlags(),
+  fSubevents(),
+  fReferenceMultiplicity(0),
+  fCentrality(-1.),
+  fRun(0),
+  fMCReactionPlaneAngle(0.),
+  fMCReactionPlaneAngleIsSet(kFALSE)
+{
+  //constructor
+  for (Int_t i=0; i<kMaxPOItypes; i++) fNumberOfPOIs[i]=0;
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEventColumns::Clear(Option_t* /*option*/)
+{
+  //empty the event, the arrays keep their capacity for the next event
+  fPhi.clear();
+  fEta.clear();
+  fPt.clear();
+  fWeight.clear();
+  fCharge.clear();
+  fID.clear();
+  fPOIFlags.clear();
+  fSubevents.clear();
+  for (Int_t i=0; i<kMaxPOItypes; i++) fNumberOfPOIs[i]=0;
+  fReferenceMultiplicity = 0;
+  fCentrality = -1.;
+  fRun = 0;
+  fMCReactionPlaneAngle = 0.;
+  fMCReactionPlaneAngleIsSet = kFALSE;
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEventColumns::Reserve(Int_t n)
+{
+  //reserve space for n tracks
+  fPhi.reserve(n);
+  fEta.reserve(n);
+  fPt.reserve(n);
+  fWeight.reserve(n);
+  fCharge.reserve(n);
+  fID.reserve(n);
+  fPOIFlags.reserve(n);
+  fSubevents.reserve(n);
+}
+
+//-----------------------------------------------------------------------
+Int_t AliFlowEventColumns::AddTrack(Double_t phi, Double_t eta, Double_t pt, Double_t weight, Int_t charge, UInt_t poiFlags, UChar_t subevents, Int_t id)
+{
+  //append a track, returns its index
+  fPhi.push_back(phi);
+  fEta.push_back(eta);
+  fPt.push_back(pt);
+  fWeight.push_back(weight);
+  fCharge.push_back(charge);
+  fID.push_back(id);
+  fPOIFlags.push_back(poiFlags);
+  fSubevents.push_back(subevents);
+  for (Int_t t=0; poiFlags; t++, poiFlags>>=1)
+  {
+    if (poiFlags & 1u) fNumberOfPOIs[t]++;
+  }
+  return (Int_t)fPhi.size()-1;
+}
+
+//-----------------------------------------------------------------------
+Int_t AliFlowEventColumns::AddTrack(const AliFlowTrackSimple* track)
+{
+  //append a copy of the kinematics and the selection of a flow track
+  const TBits* bits = track->GetPOItype();
+  UInt_t nbits = bits->GetNbits();
+  if (nbits > (UInt_t)kMaxPOItypes) nbits = kMaxPOItypes;
+  UInt_t poiFlags = 0;
+  for (UInt_t t=0; t<nbits; t++)
+  {
+    if (bits->TestBitNumber(t)) poiFlags |= (1u<<t);
+  }
+  UChar_t subevents = 0;
+  for (Int_t s=0; s<kMaxSubevents; s++)
+  {
+    if (track->InSubevent(s)) subevents |= (1u<<s);
+  }
+  return AddTrack(track->Phi(),track->Eta(),track->Pt(),track->Weight(),track->Charge(),poiFlags,subevents,track->GetID());
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEventColumns::Fill(AliFlowEventSimple* event)
+{
+  //refill from an AliFlowEventSimple (the tracks are taken in the order
+  //GetTrack() serves them, i.e. shuffled if the event shuffles tracks)
+  Clear();
+  if (!event) return;
+  Int_t nTracks = event->NumberOfTracks();
+  Reserve(nTracks);
+  for (Int_t i=0; i<nTracks; i++)
+  {
+    AliFlowTrackSimple* track = event->GetTrack(i);
+    if (!track) continue;
+    AddTrack(track);
+  }
+  fReferenceMultiplicity = event->GetReferenceMultiplicity();
+  fCentrality = event->GetCentrality();
+  fRun = event->GetRun();
+  if (event->IsSetMCReactionPlaneAngle()) SetMCReactionPlaneAngle(event->GetMCReactionPlaneAngle());
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEventColumns::DefineDeadZone(Double_t etaMin, Double_t etaMax, Double_t phiMin, Double_t phiMax)
+{
+  //mark tracks in given eta-phi region as dead by resetting the
+  //selection flags (as AliFlowEventSimple::DefineDeadZone)
+  Int_t nTracks = NumberOfTracks();
+  for (Int_t i=0; i<nTracks; i++)
+  {
+    if (!(fEta[i]>etaMin && fEta[i]<etaMax && fPhi[i]>phiMin && fPhi[i]<phiMax)) continue;
+    UInt_t poiFlags = fPOIFlags[i];
+    for (Int_t t=0; poiFlags; t++, poiFlags>>=1)
+    {
+      if (poiFlags & 1u) fNumberOfPOIs[t]--;
+    }
+    fPOIFlags[i] = 0;
+  }
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEventColumns::TagSubeventsInEta(Double_t etaMinA, Double_t etaMaxA, Double_t etaMinB, Double_t etaMaxB)
+{
+  //flag two subevents in given eta ranges (as AliFlowEventSimple::TagSubeventsInEta)
+  Int_t nTracks = NumberOfTracks();
+  for (Int_t i=0; i<nTracks; i++)
+  {
+    UChar_t subevents = 0;
+    if (fEta[i] >= etaMinA && fEta[i] <= etaMaxA) subevents |= 1u;
+    if (fEta[i] >= etaMinB && fEta[i] <= etaMaxB) subevents |= 2u;
+    fSubevents[i] = subevents;
+  }
+}
+
+//-----------------------------------------------------------------------
+Int_t AliFlowEventColumns::GetNumberOfPOIs(Int_t poiType) const
+{
+  //number of tracks of the given POI type (0 = RP)
+  if (poiType<0 || poiType>=kMaxPOItypes) return 0;
+  return fNumberOfPOIs[poiType];
+}
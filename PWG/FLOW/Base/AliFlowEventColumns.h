@@ -0,0 +1,97 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+/*****************************************************************
+  AliFlowEventColumns: columnar (structure of arrays) flow event.
+  Holds the phi, eta, pt, weight, charge and selection flags of
+  all tracks in contiguous arrays instead of one AliFlowTrackSimple
+  object per track. The arrays keep their capacity on Clear(), so
+  one instance can be refilled for every event without allocating.
+  Filled either directly (AddTrack) or from an AliFlowEventSimple.
+*****************************************************************/
+
+#ifndef ALIFLOWEVENTCOLUMNS_H
+#define ALIFLOWEVENTCOLUMNS_H
+
+#include <vector>
+#include "TObject.h"
+
+class AliFlowEventSimple;
+class AliFlowTrackSimple;
+
+class AliFlowEventColumns: public TObject {
+
+ public:
+
+  enum { kMaxPOItypes = 32, kMaxSubevents = 8 };
+
+  AliFlowEventColumns();
+  virtual ~AliFlowEventColumns() {}
+
+  virtual void Clear(Option_t* option = "");
+  void    Reserve(Int_t n);
+  void    Fill(AliFlowEventSimple* event);
+  Int_t   AddTrack(Double_t phi, Double_t eta, Double_t pt, Double_t weight=1., Int_t charge=0, UInt_t poiFlags=0, UChar_t subevents=0, Int_t id=-1);
+  Int_t   AddTrack(const AliFlowTrackSimple* track);
+  void    DefineDeadZone(Double_t etaMin, Double_t etaMax, Double_t phiMin, Double_t phiMax);
+  void    TagSubeventsInEta(Double_t etaMinA, Double_t etaMaxA, Double_t etaMinB, Double_t etaMaxB);
+
+  Int_t    NumberOfTracks() const            { return (Int_t)fPhi.size(); }
+  Double_t Phi(Int_t i) const                { return fPhi[i]; }
+  Double_t Eta(Int_t i) const                { return fEta[i]; }
+  Double_t Pt(Int_t i) const                 { return fPt[i]; }
+  Double_t Weight(Int_t i) const             { return fWeight[i]; }
+  Int_t    Charge(Int_t i) const             { return fCharge[i]; }
+  Int_t    GetID(Int_t i) const              { return fID[i]; }
+  UInt_t   GetPOIFlags(Int_t i) const        { return fPOIFlags[i]; }
+  Bool_t   InRPSelection(Int_t i) const      { return fPOIFlags[i] & 1u; }
+  Bool_t   InPOISelection(Int_t i, Int_t poiType=1) const { return (fPOIFlags[i] >> poiType) & 1u; }
+  Bool_t   InSubevent(Int_t i, Int_t s) const { return (fSubevents[i] >> s) & 1u; }
+  void     SetPOIFlags(Int_t i, UInt_t flags) { fPOIFlags[i] = flags; }
+  void     SetWeight(Int_t i, Double_t w)     { fWeight[i] = w; }
+
+  // direct access to the contiguous arrays
+  const Double_t* GetPhiArray() const        { return fPhi.empty() ? 0 : &fPhi[0]; }
+  const Double_t* GetEtaArray() const        { return fEta.empty() ? 0 : &fEta[0]; }
+  const Double_t* GetPtArray() const         { return fPt.empty() ? 0 : &fPt[0]; }
+  const Double_t* GetWeightArray() const     { return fWeight.empty() ? 0 : &fWeight[0]; }
+  const Int_t*    GetChargeArray() const     { return fCharge.empty() ? 0 : &fCharge[0]; }
+  const UInt_t*   GetPOIFlagsArray() const   { return fPOIFlags.empty() ? 0 : &fPOIFlags[0]; }
+
+  Int_t    GetNumberOfRPs() const            { return GetNumberOfPOIs(0); }
+  Int_t    GetNumberOfPOIs(Int_t poiType=1) const;
+
+  Int_t    GetReferenceMultiplicity() const          { return fReferenceMultiplicity; }
+  void     SetReferenceMultiplicity(Int_t m)         { fReferenceMultiplicity = m; }
+  Double_t GetCentrality() const                     { return fCentrality; }
+  void     SetCentrality(Double_t c)                 { fCentrality = c; }
+  Int_t    GetRun() const                            { return fRun; }
+  void     SetRun(Int_t run)                         { fRun = run; }
+  Double_t GetMCReactionPlaneAngle() const           { return fMCReactionPlaneAngle; }
+  void     SetMCReactionPlaneAngle(Double_t phiRP)   { fMCReactionPlaneAngle = phiRP; fMCReactionPlaneAngleIsSet = kTRUE; }
+  Bool_t   IsSetMCReactionPlaneAngle() const         { return fMCReactionPlaneAngleIsSet; }
+
+ private:
+  AliFlowEventColumns(const AliFlowEventColumns& event);
+  AliFlowEventColumns& operator=(const AliFlowEventColumns& event);
+
+  std::vector<Double_t> fPhi;                  // azimuthal angles
+  std::vector<Double_t> fEta;                  // pseudorapidities
+  std::vector<Double_t> fPt;                   // transverse momenta
+  std::vector<Double_t> fWeight;               // track weights
+  std::vector<Int_t>    fCharge;               // charges
+  std::vector<Int_t>    fID;                   // track IDs (point back to the input tracks)
+  std::vector<UInt_t>   fPOIFlags;             // bit t set if the track is of POI type t (bit 0 = RP)
+  std::vector<UChar_t>  fSubevents;            // bit s set if the track belongs to subevent s
+  Int_t                 fNumberOfPOIs[kMaxPOItypes]; // number of tracks of each POI type
+  Int_t                 fReferenceMultiplicity;      // reference multiplicity
+  Double_t              fCentrality;                 // centrality
+  Int_t                 fRun;                        // run number
+  Double_t              fMCReactionPlaneAngle;       // the angle of the reaction plane from the MC truth
+  Bool_t                fMCReactionPlaneAngleIsSet;  // did we set it from MC?
+
+  ClassDef(AliFlowEventColumns,1)
+};
+
+#endif
@@ -0,0 +1,277 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowQVectorEngine.h"
+#include "AliFlowEventColumns.h"
+#include "TMath.h"
+#include "TMatrixD.h"
+#include "TComplex.h"
+
+//********************************************************************
+// AliFlowQVectorEngine:                                             *
+// Shared Q-vector accumulation for AliFlowAnalysisWithQCumulants,   *
+// AliFlowAnalysisCRC and                                            *
+// AliFlowAnalysisWithMultiparticleCorrelations.                     *
+// cos(h*x) and sin(h*x) are obtained from cos(x) and sin(x) by      *
+// complex multiplication, so the results agree with the direct      *
+// TMath::Cos/Sin evaluation up to rounding (relative ~1e-14 for the *
+// harmonics used in the flow analyses).                             *
+//********************************************************************
+
+ClassImp(AliFlowQVectorEngine)
+
+//________________________________________________________________________
+
+AliFlowQVectorEngine::AliFlowQVectorEngine():
+  fMaxHarmonic(0),
+  fNPowers(0),
+  fCos(),
+  fSin(),
+  fWeightPowers(),
+  fPhi(),
+  fPt(),
+  fEta(),
+  fWeight()
+{
+  // default constructor
+  SetDimensions(0,1);
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorEngine::AliFlowQVectorEngine(Int_t maxHarmonic, Int_t nPowers):
+  fMaxHarmonic(0),
+  fNPowers(0),
+  fCos(),
+  fSin(),
+  fWeightPowers(),
+  fPhi(),
+  fPt(),
+  fEta(),
+  fWeight()
+{
+  // constructor with the size of the single track tables
+  SetDimensions(maxHarmonic,nPowers);
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::SetDimensions(Int_t maxHarmonic, Int_t nPowers)
+{
+  // set the size of the single track tables
+  fMaxHarmonic = (maxHarmonic>0 ? maxHarmonic : 0);
+  fNPowers = (nPowers>1 ? nPowers : 1);
+  fCos.assign(fMaxHarmonic+1,0.);
+  fSin.assign(fMaxHarmonic+1,0.);
+  fWeightPowers.assign(fNPowers,1.);
+  fCos[0] = 1.;
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::SetAngle(Double_t x)
+{
+  // fill cos(h*x) and sin(h*x) for h = 0,...,fMaxHarmonic from a single sincos
+  Double_t c1 = TMath::Cos(x);
+  Double_t s1 = TMath::Sin(x);
+  Double_t c = 1., s = 0.;
+  fCos[0] = 1.;
+  fSin[0] = 0.;
+  for(Int_t h=1;h<=fMaxHarmonic;h++)
+  {
+    Double_t cNext = c*c1-s*s1;
+    s = s*c1+c*s1;
+    c = cNext;
+    fCos[h] = c;
+    fSin[h] = s;
+  }
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::SetWeight(Double_t w)
+{
+  // fill w^p for p = 0,...,fNPowers-1
+  Double_t wp = 1.;
+  for(Int_t p=0;p<fNPowers;p++)
+  {
+    fWeightPowers[p] = wp;
+    wp *= w;
+  }
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::ClearBatch()
+{
+  // empty the batch, keeping the allocated capacity for the next event
+  fPhi.clear();
+  fPt.clear();
+  fEta.clear();
+  fWeight.clear();
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::AddToBatch(Double_t phi, Double_t pt, Double_t eta, Double_t w)
+{
+  // append one track to the batch
+  fPhi.push_back(phi);
+  fPt.push_back(pt);
+  fEta.push_back(eta);
+  fWeight.push_back(w);
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::AddToBatch(const AliFlowEventColumns* event, Int_t poiType)
+{
+  // append all tracks of a columnar flow event of the given POI type (0 = RP), weighted with the track weight
+  if(!event) return;
+  const Int_t nTracks = event->NumberOfTracks();
+  const Double_t *phi = event->GetPhiArray();
+  const Double_t *pt = event->GetPtArray();
+  const Double_t *eta = event->GetEtaArray();
+  const Double_t *w = event->GetWeightArray();
+  const UInt_t *flags = event->GetPOIFlagsArray();
+  const UInt_t mask = 1u<<poiType;
+  for(Int_t i=0;i<nTracks;i++)
+  {
+    if(flags[i] & mask) AddToBatch(phi[i],pt[i],eta[i],w[i]);
+  }
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::AccumulateQ(TMatrixD *reQ, TMatrixD *imQ, Int_t n) const
+{
+  // reQ(m,p) += sum w^p cos((m+1)*n*phi), imQ(m,p) += sum w^p sin((m+1)*n*phi)
+
+  if(!reQ || !imQ) return;
+  const Int_t nRows = reQ->GetNrows();
+  const Int_t nCols = reQ->GetNcols();
+  if(imQ->GetNrows() != nRows || imQ->GetNcols() != nCols) return;
+
+  // sums are collected in local row-major buffers and added to the matrices once
+  std::vector<Double_t> re(nRows*nCols,0.), im(nRows*nCols,0.);
+  std::vector<Double_t> wPow(nCols,1.);
+  const Int_t nTracks = GetBatchSize();
+  for(Int_t i=0;i<nTracks;i++)
+  {
+    Double_t wp = 1.;
+    for(Int_t p=0;p<nCols;p++)
+    {
+      wPow[p] = wp;
+      wp *= fWeight[i];
+    }
+    const Double_t c1 = TMath::Cos(n*fPhi[i]);
+    const Double_t s1 = TMath::Sin(n*fPhi[i]);
+    Double_t c = c1, s = s1;
+    for(Int_t m=0;m<nRows;m++)
+    {
+      Double_t *reRow = &re[m*nCols];
+      Double_t *imRow = &im[m*nCols];
+      for(Int_t p=0;p<nCols;p++)
+      {
+        reRow[p] += wPow[p]*c;
+        imRow[p] += wPow[p]*s;
+      }
+      Double_t cNext = c*c1-s*s1;
+      s = s*c1+c*s1;
+      c = cNext;
+    }
+  }
+  for(Int_t m=0;m<nRows;m++)
+  {
+    for(Int_t p=0;p<nCols;p++)
+    {
+      (*reQ)(m,p) += re[m*nCols+p];
+      (*imQ)(m,p) += im[m*nCols+p];
+    }
+  }
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::AccumulateWeightPowerSums(TMatrixD *spk) const
+{
+  // spk(r,p) += sum w^p for every row r
+
+  if(!spk) return;
+  const Int_t nRows = spk->GetNrows();
+  const Int_t nCols = spk->GetNcols();
+  std::vector<Double_t> sums(nCols,0.);
+  const Int_t nTracks = GetBatchSize();
+  for(Int_t i=0;i<nTracks;i++)
+  {
+    Double_t wp = 1.;
+    for(Int_t p=0;p<nCols;p++)
+    {
+      sums[p] += wp;
+      wp *= fWeight[i];
+    }
+  }
+  for(Int_t r=0;r<nRows;r++)
+  {
+    for(Int_t p=0;p<nCols;p++)
+    {
+      (*spk)(r,p) += sums[p];
+    }
+  }
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::AccumulateQ(TComplex *q, Int_t nHarmonics, Int_t nPowers, Int_t rowStride) const
+{
+  // q[h*rowStride+p] += sum w^p exp(i*h*phi), h = 0,...,nHarmonics-1, p = 0,...,nPowers-1
+
+  if(!q || nHarmonics<=0 || nPowers<=0) return;
+  std::vector<Double_t> re(nHarmonics*nPowers,0.), im(nHarmonics*nPowers,0.);
+  std::vector<Double_t> wPow(nPowers,1.);
+  const Int_t nTracks = GetBatchSize();
+  for(Int_t i=0;i<nTracks;i++)
+  {
+    Double_t wp = 1.;
+    for(Int_t p=0;p<nPowers;p++)
+    {
+      wPow[p] = wp;
+      wp *= fWeight[i];
+    }
+    const Double_t c1 = TMath::Cos(fPhi[i]);
+    const Double_t s1 = TMath::Sin(fPhi[i]);
+    Double_t c = 1., s = 0.;
+    for(Int_t h=0;h<nHarmonics;h++)
+    {
+      Double_t *reRow = &re[h*nPowers];
+      Double_t *imRow = &im[h*nPowers];
+      for(Int_t p=0;p<nPowers;p++)
+      {
+        reRow[p] += wPow[p]*c;
+        imRow[p] += wPow[p]*s;
+      }
+      Double_t cNext = c*c1-s*s1;
+      s = s*c1+c*s1;
+      c = cNext;
+    }
+  }
+  for(Int_t h=0;h<nHarmonics;h++)
+  {
+    for(Int_t p=0;p<nPowers;p++)
+    {
+      q[h*rowStride+p] += TComplex(re[h*nPowers+p],im[h*nPowers+p]);
+    }
+  }
+}
@@ -0,0 +1,81 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWQVECTORENGINE_H
+#define ALIFLOWQVECTORENGINE_H
+
+#include <vector>
+#include "Rtypes.h"
+
+class TMatrixD;
+class AliFlowEventColumns;
+class TComplex;
+
+//********************************************************************
+// AliFlowQVectorEngine:                                             *
+// Accumulates weighted Q-vectors Q_{h,p} = sum w^p exp(i h phi)      *
+// for many harmonics h and weight powers p. Higher harmonics follow *
+// from one sincos per track by the recurrence                       *
+//   exp(i (h+1) x) = exp(i h x) exp(i x)                            *
+// and weight powers by repeated multiplication, instead of one      *
+// cos, sin and pow call per harmonic and power.                     *
+// Tracks are either processed one by one (SetTrack) or collected in *
+// a structure-of-arrays batch of phi/pt/eta/weight (AddToBatch) and *
+// accumulated at once.                                              *
+//********************************************************************
+
+class AliFlowQVectorEngine {
+ public:
+  AliFlowQVectorEngine();
+  AliFlowQVectorEngine(Int_t maxHarmonic, Int_t nPowers);
+  virtual ~AliFlowQVectorEngine() {}
+
+  void SetDimensions(Int_t maxHarmonic, Int_t nPowers);
+  Int_t GetMaxHarmonic() const {return fMaxHarmonic;}
+  Int_t GetNPowers() const {return fNPowers;}
+
+  // Single track: tables of cos(h*x), sin(h*x) for h = 0,...,maxHarmonic and w^p for p = 0,...,nPowers-1
+  void SetAngle(Double_t x);
+  void SetWeight(Double_t w);
+  void SetTrack(Double_t x, Double_t w) {SetAngle(x); SetWeight(w);}
+  Double_t Cos(Int_t h) const {return fCos[h];}
+  Double_t Sin(Int_t h) const {return fSin[h];}
+  Double_t WeightToPower(Int_t p) const {return fWeightPowers[p];}
+
+  // Batch of tracks (structure of arrays)
+  void ClearBatch();
+  void AddToBatch(Double_t phi, Double_t pt, Double_t eta, Double_t w);
+  void AddToBatch(const AliFlowEventColumns* event, Int_t poiType=0);
+  Int_t GetBatchSize() const {return (Int_t)fPhi.size();}
+  Double_t GetBatchPhi(Int_t i) const {return fPhi[i];}
+  Double_t GetBatchPt(Int_t i) const {return fPt[i];}
+  Double_t GetBatchEta(Int_t i) const {return fEta[i];}
+  Double_t GetBatchWeight(Int_t i) const {return fWeight[i];}
+
+  // reQ(m,p) += w^p cos((m+1)*n*phi), imQ(m,p) += w^p sin((m+1)*n*phi) over the batch,
+  // for all rows m and columns p of the matrices (QC/CRC layout)
+  void AccumulateQ(TMatrixD *reQ, TMatrixD *imQ, Int_t n) const;
+  // spk(r,p) += sum over the batch of w^p, for all rows r (QC/CRC S_{p,k} before the final power)
+  void AccumulateWeightPowerSums(TMatrixD *spk) const;
+  // q[h*rowStride+p] += w^p exp(i h phi) over the batch, h = 0,...,nHarmonics-1, p = 0,...,nPowers-1 (MPC layout)
+  void AccumulateQ(TComplex *q, Int_t nHarmonics, Int_t nPowers, Int_t rowStride) const;
+
+ private:
+  AliFlowQVectorEngine(const AliFlowQVectorEngine& other);
+  AliFlowQVectorEngine& operator=(const AliFlowQVectorEngine& other);
+
+  Int_t fMaxHarmonic;                  // highest harmonic of the single track tables
+  Int_t fNPowers;                      // number of weight powers of the single track tables
+  std::vector<Double_t> fCos;          //! cos(h*x), h = 0,...,fMaxHarmonic
+  std::vector<Double_t> fSin;          //! sin(h*x), h = 0,...,fMaxHarmonic
+  std::vector<Double_t> fWeightPowers; //! w^p, p = 0,...,fNPowers-1
+  std::vector<Double_t> fPhi;          //! batch: azimuthal angles
+  std::vector<Double_t> fPt;           //! batch: transverse momenta
+  std::vector<Double_t> fEta;          //! batch: pseudorapidities
+  std::vector<Double_t> fWeight;       //! batch: track weights
+
+  ClassDef(AliFlowQVectorEngine,1);
+};
+
+#endif
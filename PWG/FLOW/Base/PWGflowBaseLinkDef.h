@@ -8,8 +8,10 @@
 #pragma link C++ namespace AliFlowLYZConstants;
 
 #pragma link C++ class AliFlowVector+;
+#pragma link C++ class AliFlowQVectorEngine+;
 #pragma link C++ class AliFlowTrackSimple+;
 #pragma link C++ class AliFlowEventSimple+;
+#pragma link C++ class AliFlowEventColumns+;
 
 #pragma link C++ class AliStarTrack+;
 #pragma link C++ class AliStarEvent+;
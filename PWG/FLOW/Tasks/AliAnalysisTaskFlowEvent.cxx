@@ -68,6 +68,7 @@
 
 // Interface to make the Flow Event Simple used in the flow analysis methods
 #include "AliFlowEvent.h"
+#include "AliFlowEventColumns.h"
 #include "AliFlowTrackCuts.h"
 #include "AliFlowEventCuts.h"
 #include "AliFlowCommonConstants.h"
@@ -137,14 +138,16 @@ AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent() :
   fDifferentialV2(0),
   fFlowEvent(NULL),
   fShuffleTracks(kFALSE),
-  fMyTRandom3(NULL)
+  fMyTRandom3(NULL),
+  fFillColumns(kFALSE),
+  fFlowEventColumns(NULL)
 {
   // Constructor
   AliDebug(2,"AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent()");
 }
 
 //________________________________________________________________________
-AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent(const char *name, TString RPtype, Bool_t on, UInt_t iseed, Bool_t bCandidates) :
+AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent(const char *name, TString RPtype, Bool_t on, UInt_t iseed, Bool_t bCandidates, Bool_t bColumns) :
   AliAnalysisTaskSE(name),
   //  fOutputFile(NULL),
   fAnalysisType("AUTOMATIC"),
@@ -198,7 +201,9 @@ AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent(const char *name, TString RPt
   fDifferentialV2(0),
   fFlowEvent(NULL),
   fShuffleTracks(kFALSE),
-  fMyTRandom3(NULL)
+  fMyTRandom3(NULL),
+  fFillColumns(bColumns),
+  fFlowEventColumns(NULL)
 {
   // Constructor
   AliDebug(2,"AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent(const char *name, Bool_t on, UInt_t iseed)");
@@ -218,6 +223,9 @@ AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent(const char *name, TString RPt
   // Define here the flow event output
   DefineOutput(1, AliFlowEventSimple::Class());
   DefineOutput(2, TList::Class());
+  // columnar flow event output
+  if (fFillColumns)
+    DefineOutput(3, AliFlowEventColumns::Class());
 
   // and for testing open an output file
   //  fOutputFile = new TFile("FlowEvents.root","RECREATE");
@@ -232,6 +240,7 @@ AliAnalysisTaskFlowEvent::~AliAnalysisTaskFlowEvent()
   //
   delete fMyTRandom3;
   delete fFlowEvent;
+  delete fFlowEventColumns;
   delete fCutsEvent;
   delete fQAList;
   if (fCutContainer) fCutContainer->Delete(); delete fCutContainer;
@@ -289,6 +298,11 @@ void AliAnalysisTaskFlowEvent::UserCreateOutputObjects()
   cc->SetHistWeightvsPhiMin(fHistWeightvsPhiMin);
 
   fFlowEvent = new AliFlowEvent(10000);
+  if (fFillColumns)
+  {
+    fFlowEventColumns = new AliFlowEventColumns();
+    fFlowEventColumns->Reserve(10000);
+  }
 
   if (fQAon)
   {
@@ -575,8 +589,17 @@ void AliAnalysisTaskFlowEvent::UserExec(Option_t *)
   //fListHistos->Print();
   //fOutputFile->WriteObject(fFlowEvent,"myFlowEventSimple");
   PostData(1,fFlowEvent);
+
+  // same event in columnar form, for methods which loop over contiguous arrays;
+  // derived from the flow event served on slot 1, which keeps its tracks
+  if (fFlowEventColumns)
+  {
+    fFlowEventColumns->Fill(fFlowEvent);
+    PostData(3,fFlowEventColumns);
+  }
 }
 
+
 //________________________________________________________________________
 void AliAnalysisTaskFlowEvent::Terminate(Option_t *)
 {
@@ -18,17 +18,19 @@ class AliFlowEventCuts;
 class AliFlowTrackCuts;
 class AliFlowEventSimpleMaker;
 class AliFlowEvent;
+class AliFlowEventColumns;
 class TList;
 class TF1;
 class TRandom3;
 class AliAnalysisTaskSE;
 class TString;
 class AliESDpid;
+class AliMCEvent;
 
 class AliAnalysisTaskFlowEvent : public AliAnalysisTaskSE {
  public:
   AliAnalysisTaskFlowEvent();
-  AliAnalysisTaskFlowEvent(const char *name, TString RPtype = "", Bool_t QAon = kFALSE, UInt_t seed=666, Bool_t bCandidates=kFALSE);
+  AliAnalysisTaskFlowEvent(const char *name, TString RPtype = "", Bool_t QAon = kFALSE, UInt_t seed=666, Bool_t bCandidates=kFALSE, Bool_t bColumns=kFALSE);
   virtual ~AliAnalysisTaskFlowEvent();
   
   virtual void   UserCreateOutputObjects();
@@ -183,8 +185,11 @@ class AliAnalysisTaskFlowEvent : public AliAnalysisTaskSE {
     
   TRandom3* fMyTRandom3;     // TRandom3 generator
   // end afterburner
+
+  Bool_t fFillColumns;                      // serve the flow event also in columnar form on output slot 3
+  AliFlowEventColumns* fFlowEventColumns;   //! columnar flow event, reused across events
   
-  ClassDef(AliAnalysisTaskFlowEvent, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFlowEvent, 2); // example of analysis
 };
 
 #endif
@@ -31,6 +31,7 @@ class AliAnalysisTaskSE;
  
 #include "Riostream.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventColumns.h"
 #include "AliAnalysisTaskQCumulants.h"
 #include "AliFlowAnalysisWithQCumulants.h"
 
@@ -42,9 +43,11 @@ ClassImp(AliAnalysisTaskQCumulants)
 
 //================================================================================================================
 
-AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t useParticleWeights): 
+AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t useParticleWeights, Bool_t useColumns): 
  AliAnalysisTaskSE(name), 
  fEvent(NULL),
+ fUseColumns(useColumns),
+ fEventColumns(NULL),
  fQC(NULL), 
  fListHistos(NULL),
  fBookOnlyBasicCCH(kTRUE),
@@ -87,11 +90,18 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t us
  fnSubsamples(10)
 {
  // constructor
- AliDebug(2,"AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t useParticleWeights)");
+ AliDebug(2,"AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t useParticleWeights, Bool_t useColumns)");
  
  // Define input and output slots here
- // Input slot #0 works with an AliFlowEventSimple
- DefineInput(0, AliFlowEventSimple::Class());  
+ // Input slot #0 works with an AliFlowEventSimple, or with an AliFlowEventColumns
+ // (columnar output of AliAnalysisTaskFlowEvent, reference flow only):
+ if(useColumns)
+ {
+  DefineInput(0, AliFlowEventColumns::Class());
+ } else
+   {
+    DefineInput(0, AliFlowEventSimple::Class());
+   }
  // Input slot #1 is needed for the weights input file:
  if(useParticleWeights)
  {
@@ -143,6 +153,8 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t us
 AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(): 
  AliAnalysisTaskSE(),
  fEvent(NULL),
+ fUseColumns(kFALSE),
+ fEventColumns(NULL),
  fQC(NULL),
  fListHistos(NULL),
  fBookOnlyBasicCCH(kFALSE),
@@ -337,10 +349,19 @@ void AliAnalysisTaskQCumulants::UserCreateOutputObjects()
 void AliAnalysisTaskQCumulants::UserExec(Option_t *) 
 {
  // main loop (called for each event)
- fEvent = dynamic_cast<AliFlowEventSimple*>(GetInputData(0));
+ if(fUseColumns)
+ {
+  fEventColumns = dynamic_cast<AliFlowEventColumns*>(GetInputData(0));
+ } else
+   {
+    fEvent = dynamic_cast<AliFlowEventSimple*>(GetInputData(0));
+   }
 
  // Q-cumulants
- if(fEvent) 
+ if(fEventColumns) 
+ {
+  fQC->Make(fEventColumns);
+ } else if(fEvent) 
  {
   fQC->Make(fEvent);
  } else 
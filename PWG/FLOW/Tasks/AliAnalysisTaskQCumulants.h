@@ -24,6 +24,7 @@
 class TString;
 class TList;
 class AliFlowEventSimple;
+class AliFlowEventColumns;
 class AliFlowAnalysisWithQCumulants;
 
 //================================================================================================================
@@ -31,7 +32,7 @@ class AliFlowAnalysisWithQCumulants;
 class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
  public:
   AliAnalysisTaskQCumulants();
-  AliAnalysisTaskQCumulants(const char *name, Bool_t useParticleWeights=kFALSE);
+  AliAnalysisTaskQCumulants(const char *name, Bool_t useParticleWeights=kFALSE, Bool_t useColumns=kFALSE);
   virtual ~AliAnalysisTaskQCumulants(){}; 
   
   virtual void UserCreateOutputObjects();
@@ -138,6 +139,8 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   AliAnalysisTaskQCumulants& operator=(const AliAnalysisTaskQCumulants& aatqc);
   
   AliFlowEventSimple *fEvent;         // the input event
+  Bool_t fUseColumns;                 // input slot #0 serves an AliFlowEventColumns (reference flow only)
+  AliFlowEventColumns *fEventColumns; // the input event in columnar form
   AliFlowAnalysisWithQCumulants *fQC; // Q-cumulant object
   TList *fListHistos;                 // collection of output 
   // Common:
@@ -192,7 +195,7 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   Bool_t fUseBootstrapVsM; // use bootstrap to estimate statistical spread for results vs M
   Int_t fnSubsamples; // number of subsamples (SS), by default 10
   
-  ClassDef(AliAnalysisTaskQCumulants, 2); 
+  ClassDef(AliAnalysisTaskQCumulants, 3); 
 };
 
 //================================================================================================================
@@ -47,6 +47,7 @@
 #include "AliMultSelection.h"
 #include "AliFlowTrackCuts.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventColumns.h"
 #include "AliFlowTrack.h"
 #include "AliFlowVector.h"
 #include "AliFlowEvent.h"
@@ -873,7 +874,85 @@ void AliFlowEvent::Fill( AliFlowTrackCuts* rpCuts,
   AliFlowTrackCuts::trackParameterType sourcePOI = poiCuts->GetParamType();
   AliFlowTrack* pTrack=NULL;
  
-  //set run
+  SetCalibrationForTrackCuts(rpCuts,poiCuts);
+
+  if (sourceRP==sourcePOI)
+  {
+    //loop over tracks
+    Int_t numberOfInputObjects = rpCuts->GetNumberOfInputObjects();
+    for (Int_t i=0; i<numberOfInputObjects; i++)
+    {
+      //get input object (particle)
+      TObject* particle = rpCuts->GetInputObject(i);
+
+      Bool_t rp = rpCuts->IsSelected(particle,i);
+      Bool_t poi = poiCuts->IsSelected(particle,i);
+
+      if (!(rp||poi)) continue;
+
+      //make new AliFlowTrack
+      if (rp)
+      {
+        pTrack = rpCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
+        if (!pTrack) continue;
+        pTrack->Tag(0); IncrementNumberOfPOIs(0);
+        if (poi) {pTrack->Tag(1); IncrementNumberOfPOIs(1);}
+        if (pTrack->GetNDaughters()>0) fMothersCollection->Add(pTrack);
+      }
+      else if (poi)
+      {
+        pTrack = poiCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
+        if (!pTrack) continue;
+        pTrack->Tag(1); IncrementNumberOfPOIs(1);
+        if (pTrack->GetNDaughters()>0) fMothersCollection->Add(pTrack);
+      }
+      fNumberOfTracks++;
+    }//end of while (i < numberOfTracks)
+  }
+  else if (sourceRP!=sourcePOI)
+  {
+    //here we have two different sources of particles, so we fill
+    //them independently
+    //POI
+    for (Int_t i=0; i<poiCuts->GetNumberOfInputObjects(); i++)
+    {
+      TObject* particle = poiCuts->GetInputObject(i);
+      Bool_t poi = poiCuts->IsSelected(particle,i);
+      if (!poi) continue;
+      pTrack = poiCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
+      if (!pTrack) continue;
+      pTrack->Tag(1);
+      IncrementNumberOfPOIs(1);
+      fNumberOfTracks++;
+      if (pTrack->GetNDaughters()>0) fMothersCollection->Add(pTrack);
+    }
+    //RP
+    Int_t numberOfInputObjects = rpCuts->GetNumberOfInputObjects();
+    for (Int_t i=0; i<numberOfInputObjects; i++)
+      {
+      TObject* particle = rpCuts->GetInputObject(i);
+      Bool_t rp = rpCuts->IsSelected(particle,i);
+      if (!rp) continue;
+      pTrack = rpCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
+      if (!pTrack) continue;
+      pTrack->Tag(0);
+      IncrementNumberOfPOIs(0);
+      fNumberOfTracks++;
+      if (pTrack->GetNDaughters()>0) fMothersCollection->Add(pTrack);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEvent::SetCalibrationForTrackCuts( AliFlowTrackCuts* rpCuts,
+                                               AliFlowTrackCuts* poiCuts )
+{
+  //set the run and, if the source for rp's or poi's is the VZERO detector,
+  //get the calibration and set the calibration parameters
+  AliFlowTrackCuts::trackParameterType sourceRP = rpCuts->GetParamType();
+  AliFlowTrackCuts::trackParameterType sourcePOI = poiCuts->GetParamType();
+
+ //set run
  if(rpCuts->GetRun()) fRun = rpCuts->GetRun();
  
   // if the source for rp's or poi's is the VZERO detector, get the calibration 
@@ -945,70 +1024,71 @@ void AliFlowEvent::Fill( AliFlowTrackCuts* rpCuts,
       // probably no-one will choose vzero tracks as poi's ...
       SetVZEROCalibrationForTrackCuts(poiCuts); 
   }
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEvent::Fill( AliFlowTrackCuts* rpCuts,
+                         AliFlowTrackCuts* poiCuts,
+                         AliFlowEventColumns* columns )
+{
+  //Fills the columnar event with the tracks selected by the cuts, the
+  //same selection as Fill(rpCuts,poiCuts) but without keeping one
+  //AliFlowTrack per particle: all particles go through one scratch track.
+  //Event level calibration (VZERO) is set up on this event as in Fill().
+  //Daughters of mothers are not tracked in the columnar event.
+  //NOTE: this event is cleared and receives no tracks, it only keeps the
+  //event level state (run, calibration) - the tracks are in the columns.
+
+  if (!columns) return;
+  columns->Clear();
+  ClearFast(); //no tracks of a previous event must survive in this event
+  if (!rpCuts || !poiCuts) return;
+  AliFlowTrackCuts::trackParameterType sourceRP = rpCuts->GetParamType();
+  AliFlowTrackCuts::trackParameterType sourcePOI = poiCuts->GetParamType();
+  AliFlowTrack* pTrack=NULL;
+  TObjArray scratch(1);
+  scratch.SetOwner(kTRUE);
+  const UInt_t rpFlag = 1u<<AliFlowTrackSimple::kRP;
+  const UInt_t poiFlag = 1u<<AliFlowTrackSimple::kPOI;
+
+  SetCalibrationForTrackCuts(rpCuts,poiCuts);
+  columns->SetRun(fRun);
 
   if (sourceRP==sourcePOI)
   {
-    //loop over tracks
     Int_t numberOfInputObjects = rpCuts->GetNumberOfInputObjects();
+    columns->Reserve(numberOfInputObjects);
     for (Int_t i=0; i<numberOfInputObjects; i++)
     {
-      //get input object (particle)
       TObject* particle = rpCuts->GetInputObject(i);
-
       Bool_t rp = rpCuts->IsSelected(particle,i);
       Bool_t poi = poiCuts->IsSelected(particle,i);
-
       if (!(rp||poi)) continue;
-
-      //make new AliFlowTrack
-      if (rp)
-      {
-        pTrack = rpCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
-        if (!pTrack) continue;
-        pTrack->Tag(0); IncrementNumberOfPOIs(0);
-        if (poi) {pTrack->Tag(1); IncrementNumberOfPOIs(1);}
-        if (pTrack->GetNDaughters()>0) fMothersCollection->Add(pTrack);
-      }
-      else if (poi)
-      {
-        pTrack = poiCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
-        if (!pTrack) continue;
-        pTrack->Tag(1); IncrementNumberOfPOIs(1);
-        if (pTrack->GetNDaughters()>0) fMothersCollection->Add(pTrack);
-      }
-      fNumberOfTracks++;
-    }//end of while (i < numberOfTracks)
+      pTrack = (rp) ? rpCuts->FillFlowTrack(&scratch,0) : poiCuts->FillFlowTrack(&scratch,0);
+      if (!pTrack) continue;
+      columns->AddTrack(pTrack->Phi(),pTrack->Eta(),pTrack->Pt(),pTrack->Weight(),pTrack->Charge(),
+                        (rp?rpFlag:0u)|(poi?poiFlag:0u),0,pTrack->GetID());
+    }
   }
-  else if (sourceRP!=sourcePOI)
+  else
   {
-    //here we have two different sources of particles, so we fill
-    //them independently
-    //POI
+    //two different sources of particles, filled independently (POIs first, as in Fill())
     for (Int_t i=0; i<poiCuts->GetNumberOfInputObjects(); i++)
     {
       TObject* particle = poiCuts->GetInputObject(i);
-      Bool_t poi = poiCuts->IsSelected(particle,i);
-      if (!poi) continue;
-      pTrack = poiCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
+      if (!poiCuts->IsSelected(particle,i)) continue;
+      pTrack = poiCuts->FillFlowTrack(&scratch,0);
       if (!pTrack) continue;
-      pTrack->Tag(1);
-      IncrementNumberOfPOIs(1);
-      fNumberOfTracks++;
-      if (pTrack->GetNDaughters()>0) fMothersCollection->Add(pTrack);
+      columns->AddTrack(pTrack->Phi(),pTrack->Eta(),pTrack->Pt(),pTrack->Weight(),pTrack->Charge(),poiFlag,0,pTrack->GetID());
     }
-    //RP
     Int_t numberOfInputObjects = rpCuts->GetNumberOfInputObjects();
     for (Int_t i=0; i<numberOfInputObjects; i++)
-      {
+    {
       TObject* particle = rpCuts->GetInputObject(i);
-      Bool_t rp = rpCuts->IsSelected(particle,i);
-      if (!rp) continue;
-      pTrack = rpCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
+      if (!rpCuts->IsSelected(particle,i)) continue;
+      pTrack = rpCuts->FillFlowTrack(&scratch,0);
       if (!pTrack) continue;
-      pTrack->Tag(0);
-      IncrementNumberOfPOIs(0);
-      fNumberOfTracks++;
-      if (pTrack->GetNDaughters()>0) fMothersCollection->Add(pTrack);
+      columns->AddTrack(pTrack->Phi(),pTrack->Eta(),pTrack->Pt(),pTrack->Weight(),pTrack->Charge(),rpFlag,0,pTrack->GetID());
     }
   }
 }
@@ -14,6 +14,7 @@
 
 class AliFlowTrackCuts;
 class AliFlowTrack;
+class AliFlowEventColumns;
 class AliCFManager;
 class AliVEvent;
 class AliMCEvent;
@@ -76,6 +77,10 @@ public:
   
   void Fill( AliFlowTrackCuts* rpCuts,
              AliFlowTrackCuts* poiCuts );
+  //fills the tracks into the columns only, this event is cleared
+  void Fill( AliFlowTrackCuts* rpCuts,
+             AliFlowTrackCuts* poiCuts,
+             AliFlowEventColumns* columns );
 
   void FindDaughters(Bool_t keepDaughtersInRPselection=kFALSE);
 
@@ -99,6 +104,8 @@ public:
 
 protected:
   AliFlowTrack* ReuseTrack( Int_t i);
+  void SetCalibrationForTrackCuts( AliFlowTrackCuts* rpCuts,
+                                   AliFlowTrackCuts* poiCuts );
 
 private:
   Int_t         fApplyRecentering;      // apply recentering of q-vectors? 2010 is 10h style, 2011 is 11h style
@@ -26,6 +26,7 @@
 #include "TParticle.h"
 #include "AliFlowEventSimpleMaker.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventColumns.h"
 #include "AliFlowTrackSimple.h"
 #include "AliMCEvent.h"
 #include "AliMCParticle.h"
@@ -758,6 +759,74 @@ AliFlowEventSimple* AliFlowEventSimpleMaker::FillTracks(AliAODEvent* anInput)
   return pEvent;
 }
 
+//-----------------------------------------------------------------------   
+void AliFlowEventSimpleMaker::FillColumns(AliMCEvent* anInput, AliFlowEventColumns* columns)
+{
+  //Fills the columnar event from the MC kinematic information,
+  //no track objects are created
+  
+  if (!anInput || !columns) return;
+  columns->Clear();
+  Int_t iNumberOfInputTracks = anInput->GetNumberOfTracks() ;
+  columns->Reserve(iNumberOfInputTracks);
+  
+  for (Int_t itrkN=0; itrkN<iNumberOfInputTracks; itrkN++) {
+    AliMCParticle* pParticle = (AliMCParticle*) anInput->GetTrack(itrkN);   //get input particle
+    //cut on tracks
+    if (!(TMath::Abs(pParticle->Eta()) < 0.9)) continue;
+    if (TMath::Abs(pParticle->Particle()->GetPdgCode()) != 211) continue;
+    //RP and POI
+    columns->AddTrack(pParticle->Phi(),pParticle->Eta(),pParticle->Pt(),1.,0,(1u<<AliFlowTrackSimple::kRP)|(1u<<AliFlowTrackSimple::kPOI));
+  }
+  
+  columns->SetMCReactionPlaneAngle(fMCReactionPlaneAngle);
+}
+
+//-----------------------------------------------------------------------   
+void AliFlowEventSimpleMaker::FillColumns(AliESDEvent* anInput, AliFlowEventColumns* columns)
+{
+  //Fills the columnar event from the ESD,
+  //no track objects are created
+  
+  if (!anInput || !columns) return;
+  columns->Clear();
+  Int_t iNumberOfInputTracks = anInput->GetNumberOfTracks() ;
+  columns->Reserve(iNumberOfInputTracks);
+  
+  for (Int_t itrkN=0; itrkN<iNumberOfInputTracks; itrkN++) {
+    AliESDtrack* pParticle = anInput->GetTrack(itrkN);   //get input particle
+    //cut on tracks
+    if (!(TMath::Abs(pParticle->Eta()) < 0.9)) continue;
+    //RP and POI
+    columns->AddTrack(pParticle->Phi(),pParticle->Eta(),pParticle->Pt(),1.,0,(1u<<AliFlowTrackSimple::kRP)|(1u<<AliFlowTrackSimple::kPOI));
+  }
+  
+  columns->SetMCReactionPlaneAngle(fMCReactionPlaneAngle);
+}
+
+//-----------------------------------------------------------------------   
+void AliFlowEventSimpleMaker::FillColumns(AliAODEvent* anInput, AliFlowEventColumns* columns)
+{
+  //Fills the columnar event from the AOD,
+  //no track objects are created
+  
+  if (!anInput || !columns) return;
+  columns->Clear();
+  Int_t iNumberOfInputTracks = anInput->GetNumberOfTracks() ;
+  columns->Reserve(iNumberOfInputTracks);
+  
+  for (Int_t itrkN=0; itrkN<iNumberOfInputTracks; itrkN++) {
+    AliAODTrack* pParticle = dynamic_cast<AliAODTrack*>(anInput->GetTrack(itrkN));
+    assert((pParticle)&&"Not a standard AOD");   //get input particle
+    //cut on tracks
+    if (!(TMath::Abs(pParticle->Eta()) < 0.9)) continue;
+    //RP and POI
+    columns->AddTrack(pParticle->Phi(),pParticle->Eta(),pParticle->Pt(),1.,0,(1u<<AliFlowTrackSimple::kRP)|(1u<<AliFlowTrackSimple::kPOI));
+  }
+  
+  columns->SetMCReactionPlaneAngle(fMCReactionPlaneAngle);
+}
+
 //-----------------------------------------------------------------------   
 AliFlowEventSimple*  AliFlowEventSimpleMaker::FillTracks(AliESDEvent* anInput, const AliMCEvent* anInputMc, Int_t anOption)
 {
@@ -12,6 +12,7 @@
 #define ALIFLOWEVENTSIMPLEMAKER_H
 
 class AliFlowEventSimple;
+class AliFlowEventColumns;
 class AliFlowTrackSimpleCuts;
 class TTree;
 class AliCFManager;
@@ -43,6 +44,10 @@ class AliFlowEventSimpleMaker {
   //AliAODEvent
   AliFlowEventSimple* FillTracks(AliAODEvent* anInput); //use own cuts
   AliFlowEventSimple* FillTracks(AliAODEvent* anInput, const AliCFManager* rpCFManager, const AliCFManager* poiCFManager);  //use CF(2x)
+  //columnar event, reused across events (own cuts, same selection as the corresponding FillTracks)
+  void FillColumns(AliMCEvent* anInput, AliFlowEventColumns* columns);
+  void FillColumns(AliESDEvent* anInput, AliFlowEventColumns* columns);
+  void FillColumns(AliAODEvent* anInput, AliFlowEventColumns* columns);
   
   void  SetNoOfLoops(Int_t noofl) {this->fNoOfLoops = noofl;}
   Int_t GetNoOfLoops() const      {return this->fNoOfLoops;} 
@@ -32,6 +32,11 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TF1.h>
+#include <TRandom3.h>
+#include <algorithm>
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
 
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
@@ -172,7 +177,12 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   fOmega(0),
   fSig0(0),
   fLambda(0),
-  fSigFluc(0)
+  fSigFluc(0),
+  fRandom(0),
+  fSigFlucCDF(),
+  fGridStart(),
+  fGridNucleons(),
+  fGridCandidates()
 {
   //ctor
   for (UInt_t i=0; i<(sizeof(fdNdEtaParam)/sizeof(fdNdEtaParam[0])); i++)
@@ -322,7 +332,12 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fOmega(in.fOmega),
   fSig0(in.fSig0),
   fLambda(in.fLambda),
-  fSigFluc(in.fSigFluc)
+  fSigFluc(in.fSigFluc),
+  fRandom(in.fRandom),
+  fSigFlucCDF(in.fSigFlucCDF),
+  fGridStart(),
+  fGridNucleons(),
+  fGridCandidates()
 {
   //copy ctor
   memcpy(fdNdEtaParam,in.fdNdEtaParam,sizeof(fdNdEtaParam));
@@ -457,17 +472,73 @@ AliGlauberMC& AliGlauberMC::operator=(const AliGlauberMC& in)
 }
 
 //______________________________________________________________________________
-Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
+void AliGlauberMC::InitSigFluc()
 {
-  // prepare event
+  // book the parameterization of the fluctuating cross section
+  if (!fSigFluc) {
+    fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
+    fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
+    cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
+  }
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberMC::RandomSigNN()
+{
+  // random nucleon-nucleon cross section (fluctuating sigNN)
+  if (fRandom && !fSigFlucCDF.empty())
+    return AliGlauberNucleus::SampleCDF(fSigFlucCDF,fSigFluc->GetXmin(),fSigFluc->GetXmax(),fRandom->Rndm());
+  return fSigFluc->GetRandom();
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::SetRandom(TRandom* rnd)
+{
+  // Use rnd instead of gRandom for this generator and its nuclei (rnd is not owned).
+  // The radial densities and the fluctuating cross section are then sampled from
+  // tables prepared here instead of TF1::GetRandom, so that instances with their own
+  // generators can run in parallel threads. Call after SetDoFluc.
+  fRandom = rnd;
+  fANucleus.SetRandom(rnd);
+  fBNucleus.SetRandom(rnd);
+  fSigFlucCDF.clear();
+  if (fRandom && fDoFluc) {
+    InitSigFluc();
+    AliGlauberNucleus::TabulateCDF(fSigFluc,fSigFlucCDF);
+  }
+}
 
+//______________________________________________________________________________
+void AliGlauberMC::CollidePair(AliGlauberNucleon* nucleonA, AliGlauberNucleon* nucleonB, Double_t& d2,
+                               Double_t& bNN, Double_t& nco, Double_t& ncohc)
+{
+  // check whether the nucleons collide
+  Double_t dx = nucleonB->GetX()-nucleonA->GetX();
+  Double_t dy = nucleonB->GetY()-nucleonA->GetY();
+  Double_t dij = dx*dx+dy*dy;
   if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
+    //fXSect = nucleonA->GetSigNN();
+    //fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
+    fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
+    d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
   }
+  if (dij < d2)
+  {
+    bNN += dij;
+    ++nco;
+    nucleonB->Collide();
+    nucleonA->Collide();
+    if (dij<d2/4)
+      ++ncohc;
+  }
+}
+
+//______________________________________________________________________________
+Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
+{
+  // prepare event
+
+  if (fDoFluc) InitSigFluc();
 
   fANucleus.ThrowNucleons(-bgen/2.);
   fNucleonsA = fANucleus.GetNucleons();
@@ -480,7 +551,7 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
     nucleonA->SetInNucleusA();
     nucleonA->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonA->SetSigNN(fSigFluc->GetRandom());
+      nucleonA->SetSigNN(RandomSigNN());
   }
   fBNucleus.ThrowNucleons(bgen/2.);
   fNucleonsB = fBNucleus.GetNucleons();
@@ -493,16 +564,12 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
     nucleonB->SetInNucleusB();
     nucleonB->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonB->SetSigNN(fSigFluc->GetRandom());
+      nucleonB->SetSigNN(RandomSigNN());
   }
 
   if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-    fXSect = fSigFluc->GetRandom();
+    InitSigFluc();
+    fXSect = RandomSigNN();
   }
   // "ball" diameter = distance at which two balls interact
   Double_t d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
@@ -511,31 +578,97 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
   Double_t Nco   = 0;
   Double_t Ncohc = 0; // hard core
 
-  // for each of the A nucleons in nucleus B
-  for (Int_t i = 0; i<fBN; i++)
-  {
-    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-    for (Int_t j = 0 ; j < fAN ; j++)
+  if (fAN*fBN < 400) {
+    // for each of the A nucleons in nucleus B
+    for (Int_t i = 0; i<fBN; i++)
     {
-      AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
-      Double_t dx = nucleonB->GetX()-nucleonA->GetX();
-      Double_t dy = nucleonB->GetY()-nucleonA->GetY();
-      Double_t dij = dx*dx+dy*dy;
-      if (fDoFluc) {
-	//fXSect = nucleonA->GetSigNN();
-	//fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
-	fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
-	d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
+      AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
+      for (Int_t j = 0 ; j < fAN ; j++)
+      {
+        AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+        CollidePair(nucleonA,nucleonB,d2,bNN,Nco,Ncohc);
       }
-      if (dij < d2)
+    }
+  } else {
+    // Large nuclei: the nucleons of A are sorted into a transverse grid with cells
+    // of the largest interaction distance, and each nucleon of B is only tested
+    // against the nucleons of A in its own and the 8 neighbouring cells. The
+    // candidates are visited in increasing index, i.e. in the same order as the
+    // full loop above, so the results are identical.
+    Double_t d2Max = d2;
+    if (fDoFluc) {
+      Double_t sigMax = 0;
+      for (Int_t j = 0; j<fAN; j++)
+        sigMax = TMath::Max(sigMax,((AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j)))->GetSigNN());
+      for (Int_t i = 0; i<fBN; i++)
+        sigMax = TMath::Max(sigMax,((AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i)))->GetSigNN());
+      d2Max = sigMax/(TMath::Pi()*10);
+    }
+    if (d2Max > 0) {
+      Double_t xMin = 1e30, xMax = -1e30, yMin = 1e30, yMax = -1e30;
+      for (Int_t j = 0; j<fAN; j++)
+      {
+        AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+        xMin = TMath::Min(xMin,nucleonA->GetX());
+        xMax = TMath::Max(xMax,nucleonA->GetX());
+        yMin = TMath::Min(yMin,nucleonA->GetY());
+        yMax = TMath::Max(yMax,nucleonA->GetY());
+      }
+      const Int_t maxCells = 256; // per dimension
+      Double_t cell = TMath::Sqrt(d2Max)*(1+1e-9);
+      cell = TMath::Max(cell,TMath::Max(xMax-xMin,yMax-yMin)/(maxCells-1));
+      Int_t nx = (Int_t)((xMax-xMin)/cell)+1;
+      Int_t ny = (Int_t)((yMax-yMin)/cell)+1;
+
+      // counting sort of the nucleons of A by cell, ascending index within a cell
+      fGridStart.assign(nx*ny+1,0);
+      fGridNucleons.resize(fAN);
+      for (Int_t j = 0; j<fAN; j++)
       {
-	bNN += dij;
-	++Nco;
-        nucleonB->Collide();
-        nucleonA->Collide();
-	if (dij<d2/4)
-	  ++Ncohc;
+        AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+        Int_t c = (Int_t)((nucleonA->GetY()-yMin)/cell)*nx+(Int_t)((nucleonA->GetX()-xMin)/cell);
+        ++fGridStart[c+1];
       }
+      for (Int_t c = 0; c<nx*ny; c++)
+        fGridStart[c+1] += fGridStart[c];
+      fGridCandidates.assign(fGridStart.begin(),fGridStart.end()-1); // fill position per cell
+      for (Int_t j = 0; j<fAN; j++)
+      {
+        AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+        Int_t c = (Int_t)((nucleonA->GetY()-yMin)/cell)*nx+(Int_t)((nucleonA->GetX()-xMin)/cell);
+        fGridNucleons[fGridCandidates[c]++] = j;
+      }
+
+      for (Int_t i = 0; i<fBN; i++)
+      {
+        AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
+        Double_t fx = (nucleonB->GetX()-xMin)/cell;
+        Double_t fy = (nucleonB->GetY()-yMin)/cell;
+        if (fx < -1 || fy < -1 || fx >= nx+1 || fy >= ny+1) continue;
+        Int_t cx = (Int_t)TMath::Floor(fx);
+        Int_t cy = (Int_t)TMath::Floor(fy);
+        fGridCandidates.clear();
+        for (Int_t iy = TMath::Max(cy-1,0); iy <= TMath::Min(cy+1,ny-1); iy++)
+        {
+          for (Int_t ix = TMath::Max(cx-1,0); ix <= TMath::Min(cx+1,nx-1); ix++)
+          {
+            Int_t c = iy*nx+ix;
+            for (Int_t k = fGridStart[c]; k<fGridStart[c+1]; k++)
+              fGridCandidates.push_back(fGridNucleons[k]);
+          }
+        }
+        std::sort(fGridCandidates.begin(),fGridCandidates.end());
+        for (UInt_t k = 0; k<fGridCandidates.size(); k++)
+        {
+          AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(fGridCandidates[k]));
+          CollidePair(nucleonA,nucleonB,d2,bNN,Nco,Ncohc);
+        }
+      }
+    }
+    if (fDoFluc) {
+      // the full loop leaves fXSect at the value of the last pair
+      fXSect = TMath::Max(((AliGlauberNucleon*)(fNucleonsA->UncheckedAt(fAN-1)))->GetSigNN(),
+                          ((AliGlauberNucleon*)(fNucleonsB->UncheckedAt(fBN-1)))->GetSigNN());
     }
   }
 
@@ -569,6 +702,9 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
   fMeanX2=0.;
   fMeanY2=0.;
   fMeanXY=0.;
+  fMeanX2Parts=0.;
+  fMeanY2Parts=0.;
+  fMeanXYParts=0.;
   fMeanXParts=0.;
   fMeanYParts=0.;
   fMeanOXParts=0.;
@@ -1267,7 +1403,7 @@ Int_t AliGlauberMC::NegativeBinomialRandom(Int_t k, Double_t nmean) const
   {
     array[i] = NegativeBinomialDistribution(i,k,nmean) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = (fRandom ? fRandom : gRandom)->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 
 }
@@ -1278,7 +1414,7 @@ Int_t AliGlauberMC::NegativeBinomialRandomSV(Double_t k, Double_t nbar) const
   // negative binomial distribution generator, S. Voloshin, 09-May-2007
   Double_t sum=0.;
   Int_t i=0;
-  Double_t ran=gRandom->Rndm();
+  Double_t ran=(fRandom ? fRandom : gRandom)->Rndm();
   Double_t trm=1./pow(1.+nbar/k,k);
   if (trm==0.)
   {
@@ -1308,7 +1444,7 @@ Int_t AliGlauberMC::DoubleNegativeBinomialRandom( Int_t k,
   {
     array[i] = alpha*NegativeBinomialDistribution(i,k,nmean)+(1-alpha)*NegativeBinomialDistribution(i,k2,nmean2) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = (fRandom ? fRandom : gRandom)->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 }
 
@@ -1506,7 +1642,7 @@ Bool_t AliGlauberMC::NextEvent(Double_t bgen)
   {
     if(bgen<0||!succes) //get impactparameter
     {
-      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*gRandom->Rndm()+fBMin*fBMin);
+      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*(fRandom ? fRandom : gRandom)->Rndm()+fBMin*fBMin);
     }
     if ( (succes=CalcEvent(bgen)) ) break; //ends if we have particparts
   }
@@ -1682,18 +1818,90 @@ Double_t AliGlauberMC::GetPsi4m2() const
 }
 */
 //______________________________________________________________________________
-void AliGlauberMC::Run(Int_t nevents)
+void AliGlauberMC::BookNtuple()
 {
-  //example run
-  cout << "Generating " << nevents << " events..." << endl;
+  //create the result ntuple
+  if (fnt) return;
   TString name(Form("nt_%s_%s",fANucleus.GetName(),fBNucleus.GetName()));
   TString title(Form("%s + %s (x-sect = %d mb)",fANucleus.GetName(),fBNucleus.GetName(),(Int_t) fXSect));
-  if (fnt == 0)
+  fnt = new TNtuple(name,title,
+                    "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
+  fnt->SetDirectory(0);
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::FillNtupleRow(Float_t* v)
+{
+  //ntuple variables of the current event, v has kNNtupleVars entries
+  v[0]  = GetNpart();
+  v[1]  = GetNcoll();
+  v[2]  = fBMC;
+  v[3]  = fMeanXParts;
+  v[4]  = fMeanYParts;
+  v[5]  = fMeanX2Parts;
+  v[6]  = fMeanY2Parts;
+  v[7]  = fMeanXYParts;
+  v[8]  = fSx2Parts;
+  v[9]  = fSy2Parts;
+  v[10] = fSxyParts;
+  v[11] = fMeanXSystem;
+  v[12] = fMeanYSystem;
+  v[13] = fMeanXA;
+  v[14] = fMeanYA;
+  v[15] = fMeanXB;
+  v[16] = fMeanYB;
+  v[17] = GetEccentricity();
+  v[18] = GetStoa();
+  v[19] = GetEccentricityColl();
+  v[20] = GetEccentricityCom();
+  v[21] = GetEccentricityPart();
+  v[22] = GetEccentricityPartColl();
+  v[23] = GetEccentricityPartCom();
+  if (fDoPartProd)
+  {
+    v[24] = GetdNdEta();
+    v[25] = GetdNdEta();
+    v[26] = v[24]+v[25];
+  }
+  else
   {
-    fnt = new TNtuple(name,title,
-                      "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
-    fnt->SetDirectory(0);
+    v[24] = 0;
+    v[25] = 0;
+    v[26] = 0;
   }
+  v[27]=fXSect;
+
+  Float_t mytAA=-999;
+  if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
+  v[28]=mytAA;
+  //_____________epsilon2,3,4,4_______
+  v[29] = GetEpsilon2Part();
+  v[30] = GetEpsilon3Part();
+  v[31] = GetEpsilon4Part();
+  v[32] = GetEpsilon5Part();
+  v[33] = GetEpsilon2Coll();
+  v[34] = GetEpsilon3Coll();
+  v[35] = GetEpsilon4Coll();
+  v[36] = GetEpsilon5Coll();
+  v[37] = GetEpsilon2Com();
+  v[38] = GetEpsilon3Com();
+  v[39] = GetEpsilon4Com();
+  v[40] = GetEpsilon5Com();
+  v[41] = GetPsi2();
+  v[42] = GetPsi3();
+  v[43] = GetPsi4();
+  v[44] = GetPsi5();
+  v[45] = fBNN;
+  v[46] = fXSect;
+  v[47] = fNcollw;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::Run(Int_t nevents)
+{
+  //example run
+  cout << "Generating " << nevents << " events..." << endl;
+  BookNtuple();
   Int_t q = 0;
   Int_t u = 0;
   for (Int_t i = 0; i<nevents; i++)
@@ -1706,73 +1914,156 @@ void AliGlauberMC::Run(Int_t nevents)
     }
 
     q++;
-    Float_t v[48];
-    v[0]  = GetNpart();
-    v[1]  = GetNcoll();
-    v[2]  = fBMC;
-    v[3]  = fMeanXParts;
-    v[4]  = fMeanYParts;
-    v[5]  = fMeanX2Parts;
-    v[6]  = fMeanY2Parts;
-    v[7]  = fMeanXYParts;
-    v[8]  = fSx2Parts;
-    v[9]  = fSy2Parts;
-    v[10] = fSxyParts;
-    v[11] = fMeanXSystem;
-    v[12] = fMeanYSystem;
-    v[13] = fMeanXA;
-    v[14] = fMeanYA;
-    v[15] = fMeanXB;
-    v[16] = fMeanYB;
-    v[17] = GetEccentricity();
-    v[18] = GetStoa();
-    v[19] = GetEccentricityColl();
-    v[20] = GetEccentricityCom();
-    v[21] = GetEccentricityPart();
-    v[22] = GetEccentricityPartColl();
-    v[23] = GetEccentricityPartCom();
-    if (fDoPartProd)
+    Float_t v[kNNtupleVars];
+    FillNtupleRow(v);
+
+    //always at the end
+    fnt->Fill(v);
+
+    if ((i%100)==0) std::cout << "Generating Event # " << i << "... \r" << flush;
+  }
+  std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+}
+
+//______________________________________________________________________________
+Int_t AliGlauberMC::GenerateEvents(Int_t nevents, std::vector<Float_t>& rows)
+{
+  //generate nevents events like Run, but append the ntuple rows (kNNtupleVars
+  //values per successful event) to rows instead of filling the ntuple.
+  //Touches no global ROOT state when a generator was given with SetRandom.
+  //Returns the number of discarded events.
+  Int_t u = 0;
+  for (Int_t i = 0; i<nevents; i++)
+  {
+    if(!NextEvent())
     {
-      v[24] = GetdNdEta();
-      v[25] = GetdNdEta();
-      v[26] = v[24]+v[25];
+      u++;
+      continue;
     }
-    else
+    rows.resize(rows.size()+kNNtupleVars);
+    FillNtupleRow(&rows[rows.size()-kNNtupleVars]);
+  }
+  return u;
+}
+
+namespace {
+  struct AliGlauberMCChunk {
+    AliGlauberMC*        fWorker;     // generator of the chunk
+    TRandom3*            fRandom;     // generator's random number stream
+    UInt_t               fSeed;       // seed of the chunk
+    Int_t                fNEvents;    // events to generate
+    Int_t                fNDiscarded; // events without collision
+    std::vector<Float_t> fRows;       // ntuple rows
+  };
+
+  UInt_t ChunkSeed(UInt_t seed, Int_t chunk)
+  {
+    // mix seed and chunk index (splitmix64 finalizer); never 0, for which TRandom3 would seed from the clock
+    ULong64_t z = (((ULong64_t)seed)<<32) + (ULong64_t)chunk + 0x9E3779B97F4A7C15ULL;
+    z = (z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+    z = (z^(z>>27))*0x94D049BB133111EBULL;
+    z ^= z>>31;
+    UInt_t s = (UInt_t)(z^(z>>32));
+    return s ? s : 1;
+  }
+
+  void GenerateChunk(AliGlauberMCChunk* chunk)
+  {
+    chunk->fRows.clear();
+    chunk->fRandom->SetSeed(chunk->fSeed);
+    chunk->fNDiscarded = chunk->fWorker->GenerateEvents(chunk->fNEvents,chunk->fRows);
+  }
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::RunParallel(Int_t nevents, Int_t nthreads, UInt_t seed, Int_t neventsPerChunk)
+{
+  //Generate nevents events with nthreads threads.
+  //The events are split into chunks of neventsPerChunk events. Chunk k is
+  //generated with its own TRandom3 seeded from (seed,k), and the chunks are
+  //appended to the ntuple in the order of k, so the output for a given seed
+  //and chunk size does not depend on nthreads. Each thread uses its own copy
+  //of the generator with the settings of this one; a round of nthreads chunks
+  //is generated at a time to bound the memory of the unmerged rows.
+  //Without C++11 the chunks are generated one after the other.
+  if (nthreads<1) nthreads = 1;
+  if (neventsPerChunk<1) neventsPerChunk = 1;
+  Int_t nchunks = (nevents+neventsPerChunk-1)/neventsPerChunk;
+  if (nthreads>nchunks) nthreads = TMath::Max(nchunks,1);
+  cout << "Generating " << nevents << " events in " << nchunks << " chunks with " << nthreads << " threads..." << endl;
+  BookNtuple();
+
+  // workers are set up here, all TF1s and nucleons are created before the threads start
+  std::vector<AliGlauberMCChunk> chunks(nthreads);
+  for (Int_t k = 0; k<nthreads; k++)
+  {
+    AliGlauberMC *worker = new AliGlauberMC(fANucleus.GetName(),fBNucleus.GetName(),fXSect);
+    AliGlauberNucleus *nuc[2]  = {&worker->fANucleus,&worker->fBNucleus};
+    AliGlauberNucleus *from[2] = {&fANucleus,&fBNucleus};
+    for (Int_t n = 0; n<2; n++)
     {
-      v[24] = 0;
-      v[25] = 0;
-      v[26] = 0;
+      nuc[n]->SetN(from[n]->GetN());
+      nuc[n]->SetR(from[n]->GetR());
+      nuc[n]->SetA(from[n]->GetA());
+      nuc[n]->SetW(from[n]->GetW());
+      nuc[n]->SetMinDist(from[n]->GetMinDist());
     }
-    v[27]=fXSect;
-
-    Float_t mytAA=-999;
-    if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
-    v[28]=mytAA;
-    //_____________epsilon2,3,4,4_______
-    v[29] = GetEpsilon2Part();
-    v[30] = GetEpsilon3Part();
-    v[31] = GetEpsilon4Part();
-    v[32] = GetEpsilon5Part();
-    v[33] = GetEpsilon2Coll();
-    v[34] = GetEpsilon3Coll();
-    v[35] = GetEpsilon4Coll();
-    v[36] = GetEpsilon5Coll();
-    v[37] = GetEpsilon2Com();
-    v[38] = GetEpsilon3Com();
-    v[39] = GetEpsilon4Com();
-    v[40] = GetEpsilon5Com();
-    v[41] = GetPsi2();
-    v[42] = GetPsi3();
-    v[43] = GetPsi4();
-    v[44] = GetPsi5();
-    v[45] = fBNN;
-    v[46] = fXSect;
-    v[47] = fNcollw;
+    worker->fBMin = fBMin;
+    worker->fBMax = fBMax;
+    worker->fMultType = fMultType;
+    memcpy(worker->fdNdEtaParam,fdNdEtaParam,sizeof(fdNdEtaParam));
+    worker->fX = fX;
+    worker->fNpp = fNpp;
+    worker->fDoPartProd = fDoPartProd;
+    worker->SetDoFluc(fOmega,fSig0,fLambda,fDoFluc);
+    chunks[k].fWorker = worker;
+    chunks[k].fRandom = new TRandom3(1);
+    worker->SetRandom(chunks[k].fRandom);
+    worker->fANucleus.ThrowNucleons(0);
+    worker->fBNucleus.ThrowNucleons(0);
+  }
 
-    //always at the end
-    fnt->Fill(v);
+  Int_t q = 0;
+  Int_t u = 0;
+  for (Int_t first = 0; first<nchunks; first += nthreads)
+  {
+    Int_t nround = TMath::Min(nthreads,nchunks-first);
+    for (Int_t k = 0; k<nround; k++)
+    {
+      chunks[k].fSeed = ChunkSeed(seed,first+k);
+      chunks[k].fNEvents = TMath::Min(neventsPerChunk,nevents-(first+k)*neventsPerChunk);
+    }
+#if __cplusplus >= 201103L
+    std::vector<std::thread> threads;
+    for (Int_t k = 1; k<nround; k++)
+      threads.push_back(std::thread(GenerateChunk,&chunks[k]));
+    GenerateChunk(&chunks[0]);
+    for (UInt_t t = 0; t<threads.size(); t++)
+      threads[t].join();
+#else
+    for (Int_t k = 0; k<nround; k++)
+      GenerateChunk(&chunks[k]);
+#endif
+    for (Int_t k = 0; k<nround; k++)
+    {
+      Int_t nrows = chunks[k].fRows.size()/kNNtupleVars;
+      for (Int_t r = 0; r<nrows; r++)
+        fnt->Fill(&chunks[k].fRows[r*kNNtupleVars]);
+      q += nrows;
+      u += chunks[k].fNDiscarded;
+      chunks[k].fRows.clear();
+    }
+    std::cout << "Generating Event # " << TMath::Min(nevents,(first+nround)*neventsPerChunk) << "... \r" << flush;
+  }
 
-    if ((i%100)==0) std::cout << "Generating Event # " << i << "... \r" << flush;
+  for (Int_t k = 0; k<nthreads; k++)
+  {
+    AliGlauberMC *worker = chunks[k].fWorker;
+    fEvents += worker->fEvents;
+    fTotalEvents += worker->fTotalEvents;
+    if (worker->fMaxNpartFound > fMaxNpartFound) fMaxNpartFound = worker->fMaxNpartFound;
+    delete worker;
+    delete chunks[k].fRandom;
   }
   std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
 }
@@ -15,10 +15,13 @@
 
 #include "AliGlauberNucleus.h"
 #include <Riostream.h>
+#include <vector>
 #include <TNamed.h>
 
 class TObjArray;
 class TNtuple;
+class TRandom;
+class AliGlauberNucleon;
 
 using std::cout;
 using std::endl;
@@ -39,6 +42,8 @@ public:
    void         Draw(Option_t* option);
 
    void         Run(Int_t nevents);
+   void         RunParallel(Int_t nevents, Int_t nthreads, UInt_t seed, Int_t neventsPerChunk=10000);
+   Int_t        GenerateEvents(Int_t nevents, std::vector<Float_t>& rows);
    Bool_t       NextEvent(Double_t bgen=-1);
    Bool_t       CalcEvent(Double_t bgen);
 
@@ -100,6 +105,7 @@ public:
    void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
    void   SetDoFluc(Double_t omega, Double_t sig0, Double_t lam, Bool_t on=kTRUE) 
             {fDoFluc=on;fOmega=omega;fSig0=sig0;fLambda=lam;}
+   void   SetRandom(TRandom* rnd);
    static void       PrintVersion()         {cout << "AliGlauberMC " << Version() << endl;}
    static const char *Version()             {return "v1.2";}
    static void       RunAndSaveNtuple( Int_t n,
@@ -251,9 +257,22 @@ private:
    Double_t     fSig0;           //regularization parameter 
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
+   TRandom     *fRandom;         //!generator used instead of gRandom (not owned)
+   std::vector<Double_t> fSigFlucCDF;    //!tabulated cumulative of fSigFluc, used with fRandom
+   std::vector<Int_t>    fGridStart;     //!collision search: first entry of each cell in fGridNucleons
+   std::vector<Int_t>    fGridNucleons;  //!collision search: nucleons of A ordered by cell
+   std::vector<Int_t>    fGridCandidates;//!collision search: nucleons of A near the current nucleon of B
    Bool_t       CalcResults(Double_t bgen);
+   void         InitSigFluc();
+   Double_t     RandomSigNN();
+   void         CollidePair(AliGlauberNucleon* nucleonA, AliGlauberNucleon* nucleonB, Double_t& d2,
+                            Double_t& bNN, Double_t& nco, Double_t& ncohc);
+   void         BookNtuple();
+   void         FillNtupleRow(Float_t* v);
 
-   ClassDef(AliGlauberMC,4)
+   enum { kNNtupleVars = 48 };
+
+   ClassDef(AliGlauberMC,5)
 };
 
 #endif
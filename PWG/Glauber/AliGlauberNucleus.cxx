@@ -30,6 +30,7 @@
 #include <TObjArray.h>
 #include <TF1.h>
 #include <TRandom.h>
+#include <algorithm>
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
 
@@ -49,7 +50,9 @@ AliGlauberNucleus::AliGlauberNucleus(Option_t* iname, Int_t iN, Double_t iR, Dou
   fF(0),
   fTrials(0),
   fFunction(ifunc),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fRandom(0),
+  fRadiusCDF()
 {
    if (fN==0) {
       cout << "Setting up nucleus " << iname << endl;
@@ -77,7 +80,9 @@ AliGlauberNucleus::AliGlauberNucleus(const AliGlauberNucleus& in):
   fF(in.fF),
   fTrials(in.fTrials),
   fFunction(in.fFunction),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fRandom(in.fRandom),
+  fRadiusCDF(in.fRadiusCDF)
 {
   //copy ctor
   if (in.fNucleons)
@@ -97,6 +102,8 @@ AliGlauberNucleus& AliGlauberNucleus::operator=(const AliGlauberNucleus& in)
   fF=in.fF;
   fTrials=in.fTrials;
   fFunction=in.fFunction;
+  fRandom=in.fRandom;
+  fRadiusCDF=in.fRadiusCDF;
   delete fNucleons;
   fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
   fNucleons->SetOwner();
@@ -189,6 +196,7 @@ void AliGlauberNucleus::SetR(Double_t ir)
          fFunction->SetParameter(0,fR);
          break;
    }
+   if (fRandom) TabulateRadius();
 }
 
 //______________________________________________________________________________
@@ -206,6 +214,7 @@ void AliGlauberNucleus::SetA(Double_t ia)
          fFunction->SetParameter(1,fA);
          break;
    }
+   if (fRandom) TabulateRadius();
 }
 
 //______________________________________________________________________________
@@ -223,6 +232,67 @@ void AliGlauberNucleus::SetW(Double_t iw)
          fFunction->SetParameter(2,fW);
          break;
    }
+   if (fRandom) TabulateRadius();
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::SetRandom(TRandom* rnd)
+{
+   // Use rnd instead of gRandom. The radius is then sampled from a table of
+   // the cumulative of fFunction instead of TF1::GetRandom (which always uses
+   // gRandom and fills its integral lazily), so nuclei with their own generator
+   // can be thrown concurrently.
+   fRandom = rnd;
+   fRadiusCDF.clear();
+   if (fRandom) TabulateRadius();
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::TabulateRadius()
+{
+   TabulateCDF(fFunction,fRadiusCDF);
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::RandomRadius()
+{
+   if (!fRandom || fRadiusCDF.empty()) return fFunction->GetRandom();
+   return SampleCDF(fRadiusCDF,fFunction->GetXmin(),fFunction->GetXmax(),fRandom->Rndm());
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::TabulateCDF(TF1* f, std::vector<Double_t>& cdf, Int_t nbins)
+{
+   // cumulative integral of f over its range at nbins+1 equidistant points
+   // (Simpson rule per bin, negative values of f are treated as 0)
+   cdf.clear();
+   if (!f || nbins<1) return;
+   Double_t xmin = f->GetXmin();
+   Double_t dx = (f->GetXmax()-xmin)/nbins;
+   cdf.resize(nbins+1);
+   cdf[0] = 0;
+   Double_t f0 = TMath::Max(0.,f->Eval(xmin));
+   for (Int_t i=0; i<nbins; i++) {
+      Double_t fm = TMath::Max(0.,f->Eval(xmin+(i+0.5)*dx));
+      Double_t f1 = TMath::Max(0.,f->Eval(xmin+(i+1)*dx));
+      cdf[i+1] = cdf[i] + (f0+4*fm+f1)*dx/6.;
+      f0 = f1;
+   }
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::SampleCDF(const std::vector<Double_t>& cdf, Double_t xmin, Double_t xmax, Double_t u)
+{
+   // inverse of the tabulated cumulative at u in [0,1), linear within a bin
+   Int_t nbins = (Int_t)cdf.size()-1;
+   if (nbins<1 || cdf[nbins]<=0) return xmin;
+   Double_t target = u*cdf[nbins];
+   Int_t k = (Int_t)(std::upper_bound(cdf.begin(),cdf.end(),target)-cdf.begin())-1;
+   if (k<0) k = 0;
+   if (k>=nbins) k = nbins-1;
+   Double_t width = cdf[k+1]-cdf[k];
+   Double_t frac = (width>0) ? (target-cdf[k])/width : 0.;
+   return xmin + (k+frac)*(xmax-xmin)/nbins;
 }
 
 //______________________________________________________________________________
@@ -243,12 +313,13 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
    Double_t sumy=0;       
    Double_t sumz=0;       
 
+   TRandom *rnd = fRandom ? fRandom : gRandom;
    Bool_t hulthen = (TString(GetName())=="dh");
    if (fN==2 && hulthen) { //special treatmeant for Hulten
 
-      Double_t r = fFunction->GetRandom()/2;
-      Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-      Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+      Double_t r = RandomRadius()/2;
+      Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+      Double_t ctheta = 2*rnd->Rndm() - 1 ;
       Double_t stheta = sqrt(1-ctheta*ctheta);
      
       AliGlauberNucleon *nucleon1=(AliGlauberNucleon*)(fNucleons->UncheckedAt(0));
@@ -270,9 +341,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
       nucleon->Reset();
       while(1) {
          fTrials++;
-         Double_t r = fFunction->GetRandom();
-         Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-         Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+         Double_t r = RandomRadius();
+         Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+         Double_t ctheta = 2*rnd->Rndm() - 1 ;
          Double_t stheta = TMath::Sqrt(1-ctheta*ctheta);
          Double_t x = r * stheta * cos(phi) + xshift;
          Double_t y = r * stheta * sin(phi);      
@@ -15,9 +15,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 //class TNamed;
+#include <vector>
 #include <TNamed.h>
 class TObjArray;
 class TF1;
+class TRandom;
 
 class AliGlauberNucleus : public TNamed {
 private:
@@ -30,8 +32,12 @@ private:
    Int_t      fTrials;     //Store trials needed to complete nucleus
    TF1*       fFunction;   //Probability density function rho(r)
    TObjArray* fNucleons;   //Array of nucleons
+   TRandom*   fRandom;     //!Generator used instead of gRandom (not owned)
+   std::vector<Double_t> fRadiusCDF; //!Tabulated cumulative of fFunction, used with fRandom
 
    void       Lookup(Option_t* name);
+   void       TabulateRadius();
+   Double_t   RandomRadius();
 
 public:
    AliGlauberNucleus(Option_t* iname="Au", Int_t iN=0, Double_t iR=0, Double_t ia=0, Double_t iw=0, TF1* ifunc=0);
@@ -47,14 +53,20 @@ public:
    Double_t   GetW()             const {return fW;}
    TObjArray *GetNucleons()      const {return fNucleons;}
    Int_t      GetTrials()        const {return fTrials;}
+   Double_t   GetMinDist()       const {return fMinDist;}
+   TRandom   *GetRandom()        const {return fRandom;}
    void       SetN(Int_t in)           {fN=in;}
    void       SetR(Double_t ir);
    void       SetA(Double_t ia);
    void       SetW(Double_t iw);
    void       SetMinDist(Double_t min) {fMinDist=min;}
+   void       SetRandom(TRandom* rnd);
    void       ThrowNucleons(Double_t xshift=0.);
 
-   ClassDef(AliGlauberNucleus,1)
+   static void     TabulateCDF(TF1* f, std::vector<Double_t>& cdf, Int_t nbins=2000);
+   static Double_t SampleCDF(const std::vector<Double_t>& cdf, Double_t xmin, Double_t xmax, Double_t u);
+
+   ClassDef(AliGlauberNucleus,2)
 };
 
 #endif
@@ -354,7 +354,7 @@ THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, in
   return hsparse;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
+TProfile *THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -362,9 +362,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTProfile", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xmin, xmax, opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
+TProfile *THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -372,9 +373,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xbins, opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
+TProfile *THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -382,16 +384,17 @@ void THistManager::CreateTProfile(const char* name, const char* title, const TAr
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname.Data(), title, xbins.GetSize()-1, xbins.GetArray(), opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
+TProfile *THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
   TArrayD myxbins;
   try{
     xbins.CreateBinEdges(myxbins);
   } catch (std::exception &e){
     Fatal("THistManager::CreateProfile", "Exception raised: %s", e.what());
   }
-  CreateTProfile(name, title, myxbins, opt);
+  return CreateTProfile(name, title, myxbins, opt);
 }
 
 void THistManager::SetObject(TObject * const o, const char *group) {
@@ -409,195 +412,105 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 }
 
 void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH1", "Parnt group %s does not exist", dirname.Data());
-		return;
-	}
-	TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
-	  // use bin width as weight
-	  Int_t bin = hist->GetXaxis()->FindBin(x);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
-	}
-	hist->Fill(x, weight);
+	FillTH1(GetHistogram<TH1>(name, "THistManager::FillTH1"), x, weight, opt);
 }
 
 void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH1", "Parnt group %s does not exist", dirname.Data());
-    return;
-  }
-  TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
-	  // use bin width as weight
-	  // get bin for label
-	  Int_t bin = hist->GetXaxis()->FindBin(label);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
-	}
-  hist->Fill(label, weight);
+	FillTH1(GetHistogram<TH1>(name, "THistManager::FillTH1"), label, weight, opt);
 }
 
 void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	hist->Fill(x, y, myweight);
+	FillTH2(GetHistogram<TH2>(name, "THistManager::FillTH2"), x, y, weight, opt);
 }
 
 void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	hist->Fill(point[0], point[1], weight);
+	FillTH2(GetHistogram<TH2>(name, "THistManager::FillTH2"), point, weight, opt);
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(z);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
-	hist->Fill(x, y, z, weight);
+	FillTH3(GetHistogram<TH3>(name, "THistManager::FillTH3"), x, y, z, weight, opt);
 }
 
 void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(point[2]);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
-	hist->Fill(point[0], point[1], point[2], weight);
+	FillTH3(GetHistogram<TH3>(name, "THistManager::FillTH3"), point, weight, opt);
 }
 
 void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTHnSparse", "Parent group %s does not exist", dirname.Data());
-		return;
+	FillTHnSparse(GetHistogram<THnSparseD>(name, "THistManager::FillTHnSparse"), x, weight, opt);
+}
+
+void THistManager::FillProfile(const char* name, double x, double y, double weight){
+	FillProfile(GetHistogram<TProfile>(name, "THistManager::FillTProfile"), x, y, weight);
+}
+
+void THistManager::FillTH1(TH1 *hist, double x, double weight, Option_t *opt) {
+	if(opt && opt[0]){
+		TString optionstring(opt);
+		if(optionstring.Contains("w")){
+			// use bin width as weight
+			Int_t bin = hist->GetXaxis()->FindBin(x);
+			// check if not overflow or underflow bin
+			if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
+				weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+		}
 	}
-	THnSparseD *hist = dynamic_cast<THnSparseD *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
+	hist->Fill(x, weight);
+}
+
+void THistManager::FillTH1(TH1 *hist, const char *label, double weight, Option_t *opt) {
+	if(opt && opt[0]){
+		TString optionstring(opt);
+		if(optionstring.Contains("w")){
+			// use bin width as weight
+			// get bin for label
+			Int_t bin = hist->GetXaxis()->FindBin(label);
+			// check if not overflow or underflow bin
+			if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
+				weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+		}
 	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
-	  std::stringstream weighthandler;
-	  weighthandler << "w" << iaxis;
-	  if(optstring.Contains(weighthandler.str().c_str())){
-	    Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
-	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
-	  }
+	hist->Fill(label, weight);
+}
+
+void THistManager::FillTH2(TH2 *hist, double x, double y, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(opt && opt[0]){
+		TString optstring(opt);
+		if(optstring.Contains("w")) myweight = 1.;
+		if(optstring.Contains("wx")){
+			Int_t binx = hist->GetXaxis()->FindBin(x);
+			if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+		}
+		if(optstring.Contains("wy")){
+			Int_t biny = hist->GetYaxis()->FindBin(y);
+			if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+		}
 	}
+	hist->Fill(x, y, myweight);
+}
 
+void THistManager::FillTH2(TH2 *hist, double *point, double weight, Option_t *) {
+	// Bin width options are not applied for the array interface (as before)
+	hist->Fill(point[0], point[1], weight);
+}
+
+void THistManager::FillTH3(TH3 *hist, double x, double y, double z, double weight, Option_t *) {
+	// Bin width options are not applied for TH3 (as before)
+	hist->Fill(x, y, z, weight);
+}
+
+void THistManager::FillTH3(TH3 *hist, const double *point, double weight, Option_t *) {
+	// Bin width options are not applied for TH3 (as before)
+	hist->Fill(point[0], point[1], point[2], weight);
+}
+
+void THistManager::FillTHnSparse(THnSparse *hist, const double *x, double weight, Option_t *) {
+	// Bin width options are not applied for THnSparse (as before)
 	hist->Fill(x, weight);
 }
 
-void THistManager::FillProfile(const char* name, double x, double y, double weight){
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent)
-		Fatal("THistManager::FillTProfile", "Parent group %s does not exist", dirname.Data());
-  TProfile *hist = dynamic_cast<TProfile *>(parent->FindObject(hname));
-  if(!hist)
-		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-  hist->Fill(x, y, weight);
+void THistManager::FillProfile(TProfile *hist, double x, double y, double weight){
+	hist->Fill(x, y, weight);
 }
 
 TObject *THistManager::FindObject(const char *name) const {
@@ -1005,6 +918,67 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandles(){
+    THistManager testmgr("testmgr");
+
+    // Fill the same histograms by name and via handle, the handle fill needs to give the same result
+    TH1 *h1 = testmgr.CreateTH1("Group1/Test1", "Test handle fill 1D", 10, 0., 10.);
+    TH2 *h2 = testmgr.CreateTH2("Group1/Test2", "Test handle fill 2D", 10, 0., 10., 10, 0., 10.);
+    TH3 *h3 = testmgr.CreateTH3("Group2/Test3", "Test handle fill 3D", 10, 0., 10., 10, 0., 10., 10, 0., 10.);
+    int nbins[3] = {10,10,10}; double min[3] = {0.,0.,0.}, max[3] = {10.,10.,10.};
+    THnSparse *hn = testmgr.CreateTHnSparse("Group2/TestN", "Test handle fill THnSparse", 3, nbins, min, max);
+    TProfile *hp = testmgr.CreateTProfile("Group3/Subgroup1/TestProfile", "Test handle fill profile", 10, 0., 10.);
+    TH1 *r1 = testmgr.CreateTH1("Reference/Test1", "Reference 1D", 10, 0., 10.);
+    TH2 *r2 = testmgr.CreateTH2("Reference/Test2", "Reference 2D", 10, 0., 10., 10, 0., 10.);
+    TH3 *r3 = testmgr.CreateTH3("Reference/Test3", "Reference 3D", 10, 0., 10., 10, 0., 10., 10, 0., 10.);
+    THnSparse *rn = testmgr.CreateTHnSparse("Reference/TestN", "Reference THnSparse", 3, nbins, min, max);
+    TProfile *rp = testmgr.CreateTProfile("Reference/TestProfile", "Reference profile", 10, 0., 10.);
+
+    for(int i = 0; i < 100; i++){
+      double point[3] = {0.1 * i, 0.05 * i, 0.025 * i};
+      testmgr.FillTH1(h1, point[0], 1., "w");
+      testmgr.FillTH2(h2, point[0], point[1], 2., "wx");
+      testmgr.FillTH3(h3, point, 3.);
+      testmgr.FillTHnSparse(hn, point, 4.);
+      testmgr.FillProfile(hp, point[0], point[1]);
+      testmgr.FillTH1("Reference/Test1", point[0], 1., "w");
+      testmgr.FillTH2("Reference/Test2", point[0], point[1], 2., "wx");
+      testmgr.FillTH3("Reference/Test3", point, 3.);
+      testmgr.FillTHnSparse("Reference/TestN", point, 4.);
+      testmgr.FillProfile("Reference/TestProfile", point[0], point[1]);
+    }
+
+    // Evaluate test
+    bool success(true);
+    for(int ib = 0; ib <= 11; ib++){
+      if(TMath::Abs(h1->GetBinContent(ib) - r1->GetBinContent(ib)) > DBL_EPSILON){
+        std::cout << "Test1: Mismatch in bin " << ib << ": handle " << h1->GetBinContent(ib) << ", name " << r1->GetBinContent(ib) << std::endl;
+        success = false;
+      }
+      if(TMath::Abs(hp->GetBinContent(ib) - rp->GetBinContent(ib)) > DBL_EPSILON){
+        std::cout << "TestProfile: Mismatch in bin " << ib << ": handle " << hp->GetBinContent(ib) << ", name " << rp->GetBinContent(ib) << std::endl;
+        success = false;
+      }
+      for(int jb = 0; jb <= 11; jb++){
+        if(TMath::Abs(h2->GetBinContent(ib, jb) - r2->GetBinContent(ib, jb)) > DBL_EPSILON){
+          std::cout << "Test2: Mismatch in bin (" << ib << "," << jb << ")" << std::endl;
+          success = false;
+        }
+        for(int kb = 0; kb <= 11; kb++){
+          if(TMath::Abs(h3->GetBinContent(ib, jb, kb) - r3->GetBinContent(ib, jb, kb)) > DBL_EPSILON){
+            std::cout << "Test3: Mismatch in bin (" << ib << "," << jb << "," << kb << ")" << std::endl;
+            success = false;
+          }
+        }
+      }
+    }
+    if(hn->GetNbins() != rn->GetNbins() || TMath::Abs(hn->GetSumw() - rn->GetSumw()) > DBL_EPSILON){
+      std::cout << "TestN: Mismatch in number of filled bins or sum of weights" << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1025,6 +999,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handles" << std::endl;
+    testresult += testsuite.TestFillHandles();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1047,4 +1025,9 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandles(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandles();
+  }
 }
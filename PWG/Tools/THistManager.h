@@ -88,6 +88,17 @@ class TProfile;
  * }
  * ~~~
  *
+ * ## Handle-based filling
+ * Looking up histograms by name in every Fill call can be expensive for
+ * cheap fills inside track loops. The Create methods return the histogram,
+ * which can be kept as handle and passed to the Fill methods directly:
+ * ~~~{.cxx}
+ * TH1 *hPt = mgr.CreateTH1("tracks/hPt", "pt-distribution", TLinearBinning(100, 0., 100.));
+ * ...
+ * mgr.FillTH1(hPt, pt);
+ * ~~~
+ * The histograms are owned by the histogram manager, so the handles remain
+ * valid as long as the histogram manager exists.
  * ## Optional automatic correction of the bin width
  *
  * Correction for the bin width can be automatically handled by the histogram
@@ -480,8 +491,9 @@ public:
 	 * @param[in] xmin min. value in x-direction
 	 * @param[in] xmax max. value in x-direction
 	 * @param[in] opt Further options
+	 * @return the new profile histogram
 	 */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -493,8 +505,9 @@ public:
    * @param[in] nbinsX Number of bins in x-direction
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
+   * @return the new profile histogram
    */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -505,8 +518,9 @@ public:
    * @param[in] title Title of the profile histogram
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
+   * @return the new profile histogram
    */
-  void CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -517,8 +531,9 @@ public:
    * @param[in] title Title of the profile histogram
    * @param[in] xbins User binning
    * @param[in] opt Further options
+   * @return the new profile histogram
    */
-  void CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
 
   /**
    * @brief Set a new group into the container into the parent group
@@ -621,6 +636,86 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+	/**
+	 * @brief Fill a 1D histogram via its handle.
+	 *
+	 * Handle-based fill: the histogram pointer returned by CreateTH1
+	 * is resolved once (i.e. in UserCreateOutputObjects) and used
+	 * directly in the event loop, avoiding the lookup by name.
+	 * Options are handled in the same way as for the name-based fill.
+	 * @param[in] hist Histogram handle (as returned by CreateTH1)
+	 * @param[in] x x-coordinate
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH1(TH1 *hist, double x, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 1D histogram with a label via its handle.
+	 * @param[in] hist Histogram handle (as returned by CreateTH1)
+	 * @param[in] label the label of the bin
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH1(TH1 *hist, const char *label, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 2D histogram via its handle.
+	 * @param[in] hist Histogram handle (as returned by CreateTH2)
+	 * @param[in] x x-coordinate
+	 * @param[in] y y-coordinate
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH2(TH2 *hist, double x, double y, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 2D histogram via its handle.
+	 * @param[in] hist Histogram handle (as returned by CreateTH2)
+	 * @param[in] point coordinates of the data
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH2(TH2 *hist, double *point, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 3D histogram via its handle.
+	 * @param[in] hist Histogram handle (as returned by CreateTH3)
+	 * @param[in] x x-coordinate
+	 * @param[in] y y-coordinate
+	 * @param[in] z z-coordinate
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH3(TH3 *hist, double x, double y, double z, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 3D histogram via its handle.
+	 * @param[in] hist Histogram handle (as returned by CreateTH3)
+	 * @param[in] point 3D-coordinate (x,y,z) of the point to be filled
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH3(TH3 *hist, const double *point, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a nD histogram via its handle.
+	 * @param[in] hist Histogram handle (as returned by CreateTHnSparse)
+	 * @param[in] x coordinates of the data
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTHnSparse(THnSparse *hist, const double *x, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a profile histogram via its handle.
+	 * @param[in] hist Histogram handle (as returned by CreateTProfile)
+	 * @param[in] x x-coordinate
+	 * @param[in] y y-coordinate
+	 * @param[in] weight optional weight of the entry (default 1)
+	 */
+	void FillProfile(TProfile *hist, double x, double y, double weight = 1.);
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -706,6 +801,29 @@ private:
 	 */
 	TString histname(const TString &path) const;
 
+	/**
+	 * @brief Find histogram of a given type by its full path.
+	 *
+	 * Raises a fatal error if the parent group or the histogram
+	 * does not exist.
+	 * @param[in] name Path of the histogram
+	 * @param[in] caller Name of the calling method (for error messages)
+	 * @return the histogram
+	 */
+	template<class T>
+	T *GetHistogram(const char *name, const char *caller) const {
+		TString dirname(basename(name)), hname(histname(name));
+		THashList *parent(FindGroup(dirname));
+		if(!parent){
+			Fatal(caller, "Parent group %s does not exist", dirname.Data());
+			return NULL;
+		}
+		T *hist = dynamic_cast<T *>(parent->FindObject(hname));
+		if(!hist)
+			Fatal(caller, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		return hist;
+	}
+
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
 
@@ -832,6 +950,19 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether handle-based filling gives the same result as filling by name
+   * Relies on: TestFillSimpleHistograms, TestFillGroupedHistograms
+   *
+   * Creating histograms of all types in groups, once to be filled via handle and once to be filled
+   * by name, with identical values, weights and options.
+   *
+   * Test passed:
+   * - Content of handle-filled and name-filled histograms is identical in all bins
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandles();
 };
 
 /**
@@ -869,5 +1000,12 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandles();
+
 }
 #endif
@@ -25,6 +25,7 @@
 #include "AliUEHistograms.h"
 
 #include "AliCFContainer.h"
+#include "AliTHn.h"
 #include "AliBasicParticle.h"
 #include "AliVParticle.h"
 #include "AliAODTrack.h"
@@ -37,8 +38,111 @@
 #include "TMath.h"
 #include "TLorentzVector.h"
 
+#include <vector>
+
 ClassImp(AliUEHistograms)
 
+//____________________________________________________________________
+class AliUEPairBuffers
+{
+  // Packed (structure-of-arrays) kinematics of the trigger (index 0) and associated (index 1) particles
+  // used in AliUEHistograms::FillCorrelations. The buffers are kept between events so that the pair
+  // loop runs without allocations. The values are stored with the types returned by the AliVParticle
+  // getters (Eta() is converted to Float_t as before) to keep the results identical.
+  
+ public:
+  AliUEPairBuffers() : fRadiiMin(-1) { }
+  
+  void Pack(Int_t which, TObjArray* list, Bool_t eventIndex)
+  {
+    // fills the buffers of particle list which
+    Int_t n = list->GetEntriesFast();
+    fParticle[which].resize(n);
+    fPt[which].resize(n);
+    fEta[which].resize(n);
+    fPhi[which].resize(n);
+    fCharge[which].resize(n);
+    fBendingFilled[which].assign(n, kFALSE);
+    for (Int_t i=0; i<n; i++)
+    {
+      AliVParticle* particle = (AliVParticle*) list->UncheckedAt(i);
+      fParticle[which][i] = particle;
+      fPt[which][i] = particle->Pt();
+      fEta[which][i] = particle->Eta();
+      fPhi[which][i] = particle->Phi();
+      fCharge[which][i] = particle->Charge();
+    }
+    if (eventIndex)
+    {
+      fIsBasic[which].resize(n);
+      fEventIndex[which].resize(n);
+      for (Int_t i=0; i<n; i++)
+      {
+        AliBasicParticle* basic = dynamic_cast<AliBasicParticle*> (fParticle[which][i]);
+        fIsBasic[which][i] = (basic != 0);
+        fEventIndex[which][i] = (basic) ? basic->GetEventIndex() : 0;
+      }
+    }
+  }
+  
+  void PackFlags(Int_t which, UInt_t bit)
+  {
+    // reads back the resonance daughter flags of particle list which
+    Int_t n = fParticle[which].size();
+    fResonanceDaughter[which].resize(n);
+    for (Int_t i=0; i<n; i++)
+      fResonanceDaughter[which][i] = fParticle[which][i]->TestBit(bit);
+  }
+  
+  void SetRadii(Float_t minRadius)
+  {
+    // radii of the dphi* scan of the two-track efficiency cut (same steps as the scan loop used before)
+    if (minRadius == fRadiiMin)
+      return;
+    fRadii.clear();
+    for (Double_t rad=minRadius; rad<2.51; rad+=0.01)
+      fRadii.push_back(rad);
+    fRadiiMin = minRadius;
+    fBendingFilled[0].assign(fBendingFilled[0].size(), kFALSE);
+    fBendingFilled[1].assign(fBendingFilled[1].size(), kFALSE);
+  }
+  
+  const Double_t* GetBending(Int_t which, Int_t i, Float_t pt)
+  {
+    // returns asin(0.075 r / pT) for all radii of particle i, computed on first use
+    const Int_t nRadii = fRadii.size();
+    if (fBending[which].size() < fParticle[which].size() * nRadii)
+      fBending[which].resize(fParticle[which].size() * nRadii);
+    Double_t* bending = &fBending[which][i * nRadii];
+    if (!fBendingFilled[which][i])
+    {
+      for (Int_t k=0; k<nRadii; k++)
+        bending[k] = TMath::ASin(0.075 * fRadii[k] / pt);
+      fBendingFilled[which][i] = kTRUE;
+    }
+    return bending;
+  }
+  
+  std::vector<AliVParticle*> fParticle[2];     // particles
+  std::vector<Double_t>      fPt[2];           // pT
+  std::vector<Float_t>       fEta[2];          // eta
+  std::vector<Double_t>      fPhi[2];          // phi
+  std::vector<Short_t>       fCharge[2];       // charge
+  std::vector<Char_t>        fIsBasic[2];      // particle is a AliBasicParticle
+  std::vector<UInt_t>        fEventIndex[2];   // event index (only for AliBasicParticle)
+  std::vector<Char_t>        fResonanceDaughter[2]; // flagged as resonance daughter
+  std::vector<Double_t>      fBending[2];      // asin(0.075 r / pT) per particle and radius
+  std::vector<Char_t>        fBendingFilled[2];// fBending has been computed for the particle
+  std::vector<Float_t>       fRadii;           // radii of the dphi* scan
+  Float_t                    fRadiiMin;        // min radius for which fRadii has been computed
+  
+  std::vector<Float_t>       fDEta;            // delta eta of one trigger with all associated particles
+  std::vector<Double_t>      fDPhi;            // delta phi of one trigger with all associated particles
+  std::vector<Char_t>        fAccept;          // associated particle passed the cheap pair selection
+  std::vector<Double_t>      fVars;            // variables of the accepted pairs (6 per pair) for the bulk fill
+  std::vector<Double_t>      fWeights;         // weights of the accepted pairs for the bulk fill
+};
+
 const Int_t AliUEHistograms::fgkUEHists = 3;
 
 AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const char* binning) : 
@@ -77,7 +181,8 @@ AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
   fRunNumber(0),
-  fMergeCount(1)
+  fMergeCount(1),
+  fPairBuffers(0)
 {
   // Constructor
   //
@@ -248,7 +353,8 @@ AliUEHistograms::AliUEHistograms(const AliUEHistograms &c) :
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
   fRunNumber(0),
-  fMergeCount(1)
+  fMergeCount(1),
+  fPairBuffers(0)
 {
   //
   // AliUEHistograms copy constructor
@@ -266,6 +372,9 @@ AliUEHistograms::~AliUEHistograms()
   // Destructor
   
   DeleteContainers();
+  
+  delete fPairBuffers;
+  fPairBuffers = 0;
 }
 
 void AliUEHistograms::DeleteContainers()
@@ -566,18 +675,34 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
     TH1::AddDirectory(oldStatus);
   }
 
-  // Eta() is extremely time consuming, therefore cache it for the inner loop here:
-  TObjArray* input = (mixed) ? mixed : particles;
-  TArrayF eta(input->GetEntriesFast());
-  for (Int_t i=0; i<input->GetEntriesFast(); i++)
-    eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
-  
   // if particles is not set, just fill event statistics
   if (particles)
   {
-    Int_t jMax = particles->GetEntriesFast();
+    // The virtual getters (in particular Eta()) are time consuming, therefore the kinematics of
+    // trigger and associated particles are packed into contiguous arrays first.
+    // The packed values keep the types returned by the getters, so that the results are identical.
+    if (!fPairBuffers)
+      fPairBuffers = new AliUEPairBuffers;
+    AliUEPairBuffers& buf = *fPairBuffers;
+    
+    const Int_t kTrig = 0;
+    const Int_t kAssoc = (mixed) ? 1 : 0;
+    
+    buf.Pack(kTrig, particles, fCheckEventNumberInCorrelation);
     if (mixed)
-      jMax = mixed->GetEntriesFast();
+      buf.Pack(kAssoc, mixed, fCheckEventNumberInCorrelation);
+    
+    const Int_t iMax = particles->GetEntriesFast();
+    const Int_t jMax = (mixed) ? mixed->GetEntriesFast() : iMax;
+    
+    const Double_t* trigPt    = (iMax > 0) ? &buf.fPt[kTrig][0] : 0;
+    const Float_t*  trigEta   = (iMax > 0) ? &buf.fEta[kTrig][0] : 0;
+    const Double_t* trigPhi   = (iMax > 0) ? &buf.fPhi[kTrig][0] : 0;
+    const Short_t*  trigCharge = (iMax > 0) ? &buf.fCharge[kTrig][0] : 0;
+    const Double_t* assocPt   = (jMax > 0) ? &buf.fPt[kAssoc][0] : 0;
+    const Float_t*  assocEta  = (jMax > 0) ? &buf.fEta[kAssoc][0] : 0;
+    const Double_t* assocPhi  = (jMax > 0) ? &buf.fPhi[kAssoc][0] : 0;
+    const Short_t*  assocCharge = (jMax > 0) ? &buf.fCharge[kAssoc][0] : 0;
     
     TH1* triggerWeighting = 0;
     if (fWeightPerEvent)
@@ -585,12 +710,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       TAxis* axis = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->GetGrid(0)->GetGrid()->GetAxis(2);
       triggerWeighting = new TH1F("triggerWeighting", "", axis->GetNbins(), axis->GetXbins()->GetArray());
     
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+      for (Int_t i=0; i<iMax; i++)
       {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-	
 	// some optimization
-	Float_t triggerEta = triggerParticle->Eta();
+	Float_t triggerEta = trigEta[i];
 
 	if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
 	  continue;
@@ -602,10 +725,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	if (fTriggerSelectCharge != 0)
-	  if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
+	  if (trigCharge[i] * fTriggerSelectCharge < 0)
 	    continue;
 	
-	triggerWeighting->Fill(triggerParticle->Pt());
+	triggerWeighting->Fill(trigPt[i]);
       }
     }
     
@@ -627,52 +750,46 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	default: AliFatal(Form("Invalid setting %d", fRejectResonanceDaughters));
       }
 
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
-	particles->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
+      for (Int_t i=0; i<iMax; i++)
+	buf.fParticle[kTrig][i]->ResetBit(kResonanceDaughterFlag);
       if (mixed)
-	for (Int_t i=0; i<jMax; i++)
-	  mixed->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
+	for (Int_t j=0; j<jMax; j++)
+	  buf.fParticle[kAssoc][j]->ResetBit(kResonanceDaughterFlag);
       
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+      for (Int_t i=0; i<iMax; i++)
       {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+	AliVParticle* triggerParticle = buf.fParticle[kTrig][i];
 	
 	for (Int_t j=0; j<jMax; j++)
 	{
 	  if (!mixed && i == j)
 	    continue;
 	
-	  AliVParticle* particle = 0;
-	  if (!mixed)
-	    particle = (AliVParticle*) particles->UncheckedAt(j);
-	  else
-	    particle = (AliVParticle*) mixed->UncheckedAt(j);
+	  AliVParticle* particle = buf.fParticle[kAssoc][j];
 	  
 	  // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
 	  if (mixed && triggerParticle->IsEqual(particle))
 	    continue;
 	  if (fCheckEventNumberInCorrelation)
 	  {
-	    AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
-	    AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
-	    if(!triggerParticleBasic || !particleBasic)
+	    if (!buf.fIsBasic[kTrig][i] || !buf.fIsBasic[kAssoc][j])
 	    {
 	      AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
 	      continue;
 	    }
 	
-	    if(triggerParticleBasic->IsInSameEvent(particleBasic))
+	    if (buf.fEventIndex[kTrig][i] == buf.fEventIndex[kAssoc][j])
 	      continue;
 	  }
 	  
-	  if (triggerParticle->Charge() * particle->Charge() > 0)
+	  if (trigCharge[i] * assocCharge[j] > 0)
 	    continue;
       
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
+	  Float_t mass = GetInvMassSquaredCheap(trigPt[i], trigEta[i], trigPhi[i], assocPt[j], assocEta[j], assocPhi[j], massDaughter1, massDaughter2);
 	      
 	  if (TMath::Abs(mass - resonanceMass*resonanceMass) < interval*5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
+	    mass = GetInvMassSquared(trigPt[i], trigEta[i], trigPhi[i], assocPt[j], assocEta[j], assocPhi[j], massDaughter1, massDaughter2);
 
 	    if (mass > (resonanceMass-interval)*(resonanceMass-interval) && mass < (resonanceMass+interval)*(resonanceMass+interval))
 	    {
@@ -684,14 +801,41 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	}
       }
+      
+      // the flags are read back once per particle (trigger and associated may be the same objects)
+      buf.PackFlags(kTrig, kResonanceDaughterFlag);
+      if (mixed)
+	buf.PackFlags(kAssoc, kResonanceDaughterFlag);
     }
     
-    for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+    // radii for the dphi* scan of the two-track efficiency cut
+    if (twoTrackEfficiencyCut)
+      buf.SetRadii(fTwoTrackCutMinRadius);
+    
+    // bulk filling of the pair container if it is a AliTHn
+    AliCFContainer* trackHist = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward);
+    AliTHnBase* trackHistTHn = dynamic_cast<AliTHnBase*> (trackHist);
+    
+    buf.fDEta.resize(jMax);
+    buf.fDPhi.resize(jMax);
+    buf.fAccept.resize(jMax);
+    buf.fVars.resize(6 * jMax);
+    buf.fWeights.resize(jMax);
+    Float_t*  dEta = (jMax > 0) ? &buf.fDEta[0] : 0;
+    Double_t* dPhi = (jMax > 0) ? &buf.fDPhi[0] : 0;
+    Char_t*   accept = (jMax > 0) ? &buf.fAccept[0] : 0;
+    
+    const Double_t kOneAndHalfPi = 1.5 * TMath::Pi();
+    const Double_t kMinusHalfPi = -0.5 * TMath::Pi();
+    const Double_t kTwoPi = TMath::TwoPi();
+    
+    for (Int_t i=0; i<iMax; i++)
     {
-      AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-      
       // some optimization
-      Float_t triggerEta = triggerParticle->Eta();
+      const Float_t triggerEta = trigEta[i];
+      const Double_t triggerPt = trigPt[i];
+      const Double_t triggerPhi = trigPhi[i];
+      const Short_t triggerCharge = trigCharge[i];
       
       if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
 	continue;
@@ -703,83 +847,122 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
       
       if (fTriggerSelectCharge != 0)
-	if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
+	if (triggerCharge * fTriggerSelectCharge < 0)
 	  continue;
 	
       if (fRejectResonanceDaughters > 0)
-	if (triggerParticle->TestBit(kResonanceDaughterFlag))
+	if (buf.fResonanceDaughter[kTrig][i])
 	{
 // 	  Printf("Skipped i=%d", i);
 	  continue;
 	}
-	
+      
+      // pass 1: delta eta and delta phi for all associated particles (no branches on the particles, vectorisable)
+      for (Int_t j=0; j<jMax; j++)
+	dEta[j] = triggerEta - assocEta[j];
+      for (Int_t j=0; j<jMax; j++)
+      {
+        Double_t dphi = triggerPhi - assocPhi[j];
+        if (dphi > kOneAndHalfPi)
+          dphi -= kTwoPi;
+        if (dphi < kMinusHalfPi)
+          dphi += kTwoPi;
+        dPhi[j] = dphi;
+      }
+      
+      // pass 2: cheap selections which do not have side effects
+      AliVParticle* triggerParticle = buf.fParticle[kTrig][i];
       for (Int_t j=0; j<jMax; j++)
       {
+        accept[j] = kFALSE;
+        
         if (!mixed && i == j)
           continue;
       
-        AliVParticle* particle = 0;
-        if (!mixed)
-          particle = (AliVParticle*) particles->UncheckedAt(j);
-        else
-          particle = (AliVParticle*) mixed->UncheckedAt(j);
-        
         // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
-        if (mixed && triggerParticle->IsEqual(particle))
+        if (mixed && triggerParticle->IsEqual(buf.fParticle[kAssoc][j]))
           continue;
         if (fCheckEventNumberInCorrelation)
         {
-          AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
-          AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
-          if(!triggerParticleBasic || !particleBasic)
+          if (!buf.fIsBasic[kTrig][i] || !buf.fIsBasic[kAssoc][j])
             AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
       
-          if(triggerParticleBasic->IsInSameEvent(particleBasic))
+          if (buf.fEventIndex[kTrig][i] == buf.fEventIndex[kAssoc][j])
             continue;
         }
         
         if (fPtOrder)
-	  if (particle->Pt() >= triggerParticle->Pt())
+	  if (assocPt[j] >= triggerPt)
 	    continue;
 	
 	if (fAssociatedSelectCharge != 0)
-	  if (particle->Charge() * fAssociatedSelectCharge < 0)
+	  if (assocCharge[j] * fAssociatedSelectCharge < 0)
 	    continue;
 
         if (fSelectCharge > 0)
         {
           // skip like sign
-          if (fSelectCharge == 1 && particle->Charge() * triggerParticle->Charge() > 0)
+          if (fSelectCharge == 1 && assocCharge[j] * triggerCharge > 0)
             continue;
             
           // skip unlike sign
-          if (fSelectCharge == 2 && particle->Charge() * triggerParticle->Charge() < 0)
+          if (fSelectCharge == 2 && assocCharge[j] * triggerCharge < 0)
             continue;
         }
         
 	if (fEtaOrdering)
 	{
-	  if (triggerEta < 0 && eta[j] < triggerEta)
+	  if (triggerEta < 0 && assocEta[j] < triggerEta)
 	    continue;
-	  if (triggerEta > 0 && eta[j] > triggerEta)
+	  if (triggerEta > 0 && assocEta[j] > triggerEta)
 	    continue;
 	}
 
 	if (fRejectResonanceDaughters > 0)
-	  if (particle->TestBit(kResonanceDaughterFlag))
+	  if (buf.fResonanceDaughter[kAssoc][j])
 	  {
 // 	    Printf("Skipped j=%d", j);
 	    continue;
 	  }
+	
+	accept[j] = kTRUE;
+      }
+      
+      // per-trigger factors of the pair weight
+      Double_t triggerEfficiency = 1;
+      if (applyEfficiency && fEfficiencyCorrectionTriggers)
+      {
+	Int_t effVars[4];
 
+	effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
+	effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(triggerPt); //pt
+	effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(centrality); //centrality
+	effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(zVtx); //zVtx
+	triggerEfficiency = fEfficiencyCorrectionTriggers->GetBinContent(effVars);
+      }
+      Double_t triggerWeight = 1;
+      if (fWeightPerEvent)
+      {
+	Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(triggerPt);
+// 	Printf("Using weight %f", triggerWeighting->GetBinContent(weightBin));
+	triggerWeight = triggerWeighting->GetBinContent(weightBin);
+      }
+      
+      // pass 3: pair cuts with control histograms and filling of the accepted pairs into the bulk buffer
+      Int_t nPairs = 0;
+      for (Int_t j=0; j<jMax; j++)
+      {
+	if (!accept[j])
+	  continue;
+	
 	// conversions
-	if (fCutConversionsV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutConversionsV > 0 && assocCharge[j] * triggerCharge < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.510e-3, 0.510e-3);
 	  
 	  if (mass < fCutConversionsV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.510e-3, 0.510e-3);
 	    
 	    fControlConvResoncances->Fill(0.0, mass);
 
@@ -789,15 +972,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// K0s
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && assocCharge[j] * triggerCharge < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.1396, 0.1396);
 	  
 	  const Float_t kK0smass = 0.4976;
 	  
 	  if (TMath::Abs(mass - kK0smass*kK0smass) < fCutResonancesV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.1396, 0.1396);
 	    
 	    fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
 
@@ -807,16 +990,16 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// Lambda
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && assocCharge[j] * triggerCharge < 0)
 	{
-	  Float_t mass1 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-	  Float_t mass2 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	  Float_t mass1 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.1396, 0.9383);
+	  Float_t mass2 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.9383, 0.1396);
 	  
 	  const Float_t kLambdaMass = 1.115;
 
 	  if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass1 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
+	    mass1 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.1396, 0.9383);
 
 	    fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
 	    
@@ -825,7 +1008,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	  if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass2 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	    mass2 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.9383, 0.1396);
 
 	    fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
 
@@ -839,15 +1022,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
 
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
+	  Float_t phi1 = triggerPhi;
+	  Float_t pt1 = triggerPt;
+	  Float_t charge1 = triggerCharge;
 	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
+	  Float_t phi2 = assocPhi[j];
+	  Float_t pt2 = assocPt[j];
+	  Float_t charge2 = assocCharge[j];
 	      
-	  Float_t deta = triggerEta - eta[j];
+	  Float_t deta = dEta[j];
 	      
 	  // optimization
 	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
@@ -862,9 +1045,13 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	    Float_t dphistarmin = 1e5;
 	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
 	    {
-	      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
+	      // the bending terms asin(0.075 r / pT) are tabulated per particle for all radii
+	      const Double_t* bending1 = buf.GetBending(kTrig, i, pt1);
+	      const Double_t* bending2 = buf.GetBending(kAssoc, j, pt2);
+	      const Int_t nRadii = buf.fRadii.size();
+	      for (Int_t k=0; k<nRadii; k++) 
 	      {
-		Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
+		Float_t dphistar = GetDPhiStarTabulated(phi1, charge1, bending1[k], phi2, charge2, bending2[k], bSign);
 
 		Float_t dphistarabs = TMath::Abs(dphistar);
 		
@@ -888,20 +1075,16 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	}
         
-        Double_t vars[6];
-        vars[0] = triggerEta - eta[j];
-        vars[1] = particle->Pt();
-        vars[2] = triggerParticle->Pt();
+        Double_t* vars = &buf.fVars[6 * nPairs];
+        vars[0] = dEta[j];
+        vars[1] = assocPt[j];
+        vars[2] = triggerPt;
         vars[3] = centrality;
-        vars[4] = triggerParticle->Phi() - particle->Phi();
-        if (vars[4] > 1.5 * TMath::Pi()) 
-          vars[4] -= TMath::TwoPi();
-        if (vars[4] < -0.5 * TMath::Pi())
-          vars[4] += TMath::TwoPi();
+        vars[4] = dPhi[j];
 	vars[5] = zVtx;
 	
 	if (fillpT)
-	  weight = particle->Pt();
+	  weight = assocPt[j];
 	
 	Double_t useWeight = weight;
 	if (applyEfficiency)
@@ -910,7 +1093,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  {
 	    Int_t effVars[4];
 	    // associated particle
-	    effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(eta[j]);
+	    effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(assocEta[j]);
 	    effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(vars[1]); //pt
 	    effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(vars[3]); //centrality
 	    effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin(vars[5]); //zVtx
@@ -920,35 +1103,27 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	    useWeight *= fEfficiencyCorrectionAssociated->GetBinContent(effVars);
 	  }
 	  if (fEfficiencyCorrectionTriggers)
-	  {
-	    Int_t effVars[4];
-
-	    effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
-	    effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(vars[2]); //pt
-	    effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(vars[3]); //centrality
-	    effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(vars[5]); //zVtx
-	    useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
-	  }
+	    useWeight *= triggerEfficiency;
 	}
 
 	if (fWeightPerEvent)
-	{
-	  Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[2]);
-// 	  Printf("Using weight %f", triggerWeighting->GetBinContent(weightBin));
-	  useWeight /= triggerWeighting->GetBinContent(weightBin);
-	}
+	  useWeight /= triggerWeight;
     
-        // fill all in toward region and do not use the other regions
-	fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->Fill(vars, step, useWeight);
-
-// 	Printf("%.2f %.2f --> %.2f", triggerEta, eta[j], vars[0]);
+	buf.fWeights[nPairs++] = useWeight;
       }
+      
+      // fill all in toward region and do not use the other regions
+      if (trackHistTHn)
+	trackHistTHn->FillN(nPairs, (nPairs > 0) ? &buf.fVars[0] : 0, step, (nPairs > 0) ? &buf.fWeights[0] : 0);
+      else
+	for (Int_t k=0; k<nPairs; k++)
+	  trackHist->Fill(&buf.fVars[6 * k], step, buf.fWeights[k]);
  
       if (firstTime)
       {
         // once per trigger particle
         Double_t vars[3];
-        vars[0] = triggerParticle->Pt();
+        vars[0] = triggerPt;
         vars[1] = centrality;
 	vars[2] = zVtx;
 
@@ -965,8 +1140,8 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
 	}
 
-	if (TMath::Abs(triggerEta) < 0.8 && triggerParticle->Pt() > 0)
-	  fInvYield2->Fill(centrality, triggerParticle->Pt(), useWeight / triggerParticle->Pt());
+	if (TMath::Abs(triggerEta) < 0.8 && triggerPt > 0)
+	  fInvYield2->Fill(centrality, triggerPt, useWeight / triggerPt);
 
 	if (fWeightPerEvent)
 	{
@@ -979,10 +1154,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
         fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
 
 	// QA
-        fCorrelationpT->Fill(centrality, triggerParticle->Pt());
+        fCorrelationpT->Fill(centrality, triggerPt);
         fCorrelationEta->Fill(centrality, triggerEta);
-        fCorrelationPhi->Fill(centrality, triggerParticle->Phi());
-	fYields->Fill(centrality, triggerParticle->Pt(), triggerEta);
+        fCorrelationPhi->Fill(centrality, triggerPhi);
+	fYields->Fill(centrality, triggerPt, triggerEta);
 	
 /*        if (dynamic_cast<AliAODTrack*>(triggerParticle))
           fITSClusterMap->Fill(((AliAODTrack*) triggerParticle)->GetITSClusterMap(), centrality, triggerParticle->Pt());*/
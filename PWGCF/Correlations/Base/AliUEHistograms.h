@@ -14,6 +14,7 @@
 #include "THn.h" // in cxx file causes .../THn.h:257: error: conflicting declaration ‘typedef class THnT<float> THnF’
 
 class AliVParticle;
+class AliUEPairBuffers;
 
 class TList;
 class TSeqCollection;
@@ -113,6 +114,7 @@ protected:
   inline Float_t GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetInvMassSquaredCheap(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign);
+  inline Float_t GetDPhiStarTabulated(Float_t phi1, Float_t charge1, Double_t bending1, Float_t phi2, Float_t charge2, Double_t bending2, Float_t bSign);
   
   static const Int_t fgkUEHists; // number of histograms
 
@@ -163,7 +165,9 @@ protected:
   
   Int_t fMergeCount;		// counts how many objects have been merged together
   
-  ClassDef(AliUEHistograms, 31)  // underlying event histogram container
+  AliUEPairBuffers* fPairBuffers; //! packed particle kinematics and pair buffers used in FillCorrelations (reused between events)
+  
+  ClassDef(AliUEHistograms, 32)  // underlying event histogram container
 };
 
 Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign)
@@ -192,6 +196,26 @@ Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1,
   return dphistar;
 }
 
+Float_t AliUEHistograms::GetDPhiStarTabulated(Float_t phi1, Float_t charge1, Double_t bending1, Float_t phi2, Float_t charge2, Double_t bending2, Float_t bSign)
+{ 
+  //
+  // calculates dphistar as GetDPhiStar, with the bending terms asin(0.075 * radius / pt) precomputed
+  //
+  
+  Float_t dphistar = phi1 - phi2 - charge1 * bSign * bending1 + charge2 * bSign * bending2;
+  
+  static const Double_t kPi = TMath::Pi();
+  
+  if (dphistar > kPi)
+    dphistar = kPi * 2 - dphistar;
+  if (dphistar < -kPi)
+    dphistar = -kPi * 2 - dphistar;
+  if (dphistar > kPi) // might look funny but is needed
+    dphistar = kPi * 2 - dphistar;
+  
+  return dphistar;
+}
+
 Float_t AliUEHistograms::GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2)
 {
   // calculate inv mass squared
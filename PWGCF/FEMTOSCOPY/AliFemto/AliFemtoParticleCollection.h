@@ -8,6 +8,9 @@
  * Description: part of STAR HBT Framework: AliFemtoMaker package
  *   The ParticleCollection is the main component of the picoEvent
  *   It points to the particle objects in the picoEvent.
+ *   The pointers are stored contiguously (std::vector) so that the pair
+ *   loops stream through memory; the particles themselves are normally
+ *   allocated from the arena of the owning AliFemtoPicoEvent.
  *
  ***************************************************************************
  *
@@ -29,20 +32,20 @@
 #ifndef AliFemtoParticleCollection_hh
 #define AliFemtoParticleCollection_hh
 #include "AliFemtoParticle.h"
-#include <list>
+#include <vector>
 
 #if !defined(ST_NO_NAMESPACES)
-using std::list;
+using std::vector;
 #endif
 
 #ifdef ST_NO_TEMPLATE_DEF_ARGS
-typedef list<AliFemtoParticle *, allocator<AliFemtoParticle *> >            AliFemtoParticleCollection;
-typedef list<AliFemtoParticle *, allocator<AliFemtoParticle *> >::iterator  AliFemtoParticleIterator;
-typedef list<AliFemtoParticle *, allocator<AliFemtoParticle *> >::const_iterator  AliFemtoParticleConstIterator;
+typedef vector<AliFemtoParticle *, allocator<AliFemtoParticle *> >            AliFemtoParticleCollection;
+typedef vector<AliFemtoParticle *, allocator<AliFemtoParticle *> >::iterator  AliFemtoParticleIterator;
+typedef vector<AliFemtoParticle *, allocator<AliFemtoParticle *> >::const_iterator  AliFemtoParticleConstIterator;
 #else
-typedef list<AliFemtoParticle *>            AliFemtoParticleCollection;
-typedef list<AliFemtoParticle *>::iterator  AliFemtoParticleIterator;
-typedef list<AliFemtoParticle *>::const_iterator  AliFemtoParticleConstIterator;
+typedef vector<AliFemtoParticle *>            AliFemtoParticleCollection;
+typedef vector<AliFemtoParticle *>::iterator  AliFemtoParticleIterator;
+typedef vector<AliFemtoParticle *>::const_iterator  AliFemtoParticleConstIterator;
 #endif
 
 #endif
@@ -67,7 +67,9 @@
 AliFemtoPicoEvent::AliFemtoPicoEvent() :
   fFirstParticleCollection(0),
   fSecondParticleCollection(0),
-  fThirdParticleCollection(0)
+  fThirdParticleCollection(0),
+  fArenaBlocks(),
+  fArenaUsed(0)
 {
   // Default constructor
   fFirstParticleCollection = new AliFemtoParticleCollection;
@@ -78,121 +80,115 @@ AliFemtoPicoEvent::AliFemtoPicoEvent() :
 AliFemtoPicoEvent::AliFemtoPicoEvent(const AliFemtoPicoEvent& aPicoEvent) :
   fFirstParticleCollection(0),
   fSecondParticleCollection(0),
-  fThirdParticleCollection(0)
+  fThirdParticleCollection(0),
+  fArenaBlocks(),
+  fArenaUsed(0)
 {
-  // Copy constructor
-  AliFemtoParticleIterator iter;
-
+  // Copy constructor - the particles are copied into the arena of the new
+  // event, so the two events can be deleted independently
   fFirstParticleCollection = new AliFemtoParticleCollection;
-  if (aPicoEvent.fFirstParticleCollection) {
-    for (iter=aPicoEvent.fFirstParticleCollection->begin();iter!=aPicoEvent.fFirstParticleCollection->end();iter++){
-      fFirstParticleCollection->push_back(*iter);
-    }
-  }
   fSecondParticleCollection = new AliFemtoParticleCollection;
-  if (aPicoEvent.fSecondParticleCollection) {
-    for (iter=aPicoEvent.fSecondParticleCollection->begin();iter!=aPicoEvent.fSecondParticleCollection->end();iter++){
-      fSecondParticleCollection->push_back(*iter);
-    }
-  }
   fThirdParticleCollection = new AliFemtoParticleCollection;
-  if (aPicoEvent.fThirdParticleCollection) {
-    for (iter=aPicoEvent.fThirdParticleCollection->begin();iter!=aPicoEvent.fThirdParticleCollection->end();iter++){
-      fThirdParticleCollection->push_back(*iter);
-    }
-  }
+  CopyCollection(aPicoEvent.fFirstParticleCollection, fFirstParticleCollection);
+  CopyCollection(aPicoEvent.fSecondParticleCollection, fSecondParticleCollection);
+  CopyCollection(aPicoEvent.fThirdParticleCollection, fThirdParticleCollection);
 }
 //_________________
 AliFemtoPicoEvent::~AliFemtoPicoEvent(){
   // Destructor
-  AliFemtoParticleIterator iter;
-  
-  if (fFirstParticleCollection){
-    for (iter=fFirstParticleCollection->begin();iter!=fFirstParticleCollection->end();iter++){
-      delete *iter;
-    }
-    fFirstParticleCollection->clear();
-    delete fFirstParticleCollection;
-    fFirstParticleCollection = 0;
-  }
-  
-  if (fSecondParticleCollection){
-    for (iter=fSecondParticleCollection->begin();iter!=fSecondParticleCollection->end();iter++){
-      delete *iter;
-    }
-    fSecondParticleCollection->clear();
-    delete fSecondParticleCollection;
-    fSecondParticleCollection = 0;
-  }
-
-  if (fThirdParticleCollection){
-    if (fThirdParticleCollection->size() != 0 ) {
-      for (iter=fThirdParticleCollection->begin();iter!=fThirdParticleCollection->end();iter++){
-	delete *iter;
-      }
-    }
-    fThirdParticleCollection->clear();
-    delete fThirdParticleCollection;
-    fThirdParticleCollection = 0;
-  }
+  Reset();
+  delete fFirstParticleCollection;
+  fFirstParticleCollection = 0;
+  delete fSecondParticleCollection;
+  fSecondParticleCollection = 0;
+  delete fThirdParticleCollection;
+  fThirdParticleCollection = 0;
+  ReleaseArena();
 }
 //_________________
-AliFemtoPicoEvent& AliFemtoPicoEvent::operator=(const AliFemtoPicoEvent& aPicoEvent) 
+AliFemtoPicoEvent& AliFemtoPicoEvent::operator=(const AliFemtoPicoEvent& aPicoEvent)
 {
   // Assignment operator
-  if (this == &aPicoEvent) 
+  if (this == &aPicoEvent)
     return *this;
 
-  AliFemtoParticleIterator iter;
-   
-  if (fFirstParticleCollection){
-      for (iter=fFirstParticleCollection->begin();iter!=fFirstParticleCollection->end();iter++){
-	delete *iter;
-      }
-      fFirstParticleCollection->clear();
-      delete fFirstParticleCollection;
-      fFirstParticleCollection = 0;
-  }
+  Reset();
+  CopyCollection(aPicoEvent.fFirstParticleCollection, fFirstParticleCollection);
+  CopyCollection(aPicoEvent.fSecondParticleCollection, fSecondParticleCollection);
+  CopyCollection(aPicoEvent.fThirdParticleCollection, fThirdParticleCollection);
 
-  if (fSecondParticleCollection){
-    for (iter=fSecondParticleCollection->begin();iter!=fSecondParticleCollection->end();iter++){
-      delete *iter;
-    }
-    fSecondParticleCollection->clear();
-    delete fSecondParticleCollection;
-    fSecondParticleCollection = 0;
-  }
+  return *this;
+}
+//_________________
+void AliFemtoPicoEvent::Reset()
+{
+  // Destroy all particles; collections and arena blocks are kept for reuse
+  ClearCollection(fFirstParticleCollection);
+  ClearCollection(fSecondParticleCollection);
+  ClearCollection(fThirdParticleCollection);
 
-  if (fThirdParticleCollection){
-    if (fThirdParticleCollection->size() != 0 ) {
-      for (iter=fThirdParticleCollection->begin();iter!=fThirdParticleCollection->end();iter++){
-	delete *iter;
-      }
-    }
-    fThirdParticleCollection->clear();
-    delete fThirdParticleCollection;
-    fThirdParticleCollection = 0;
+  for (unsigned int i = 0; i < fArenaUsed; i++) {
+    AliFemtoParticle *part = fArenaBlocks[i / kArenaBlockSize] + i % kArenaBlockSize;
+    part->~AliFemtoParticle();
   }
-
-  fFirstParticleCollection = new AliFemtoParticleCollection;
-  if (aPicoEvent.fFirstParticleCollection) {
-    for (iter=aPicoEvent.fFirstParticleCollection->begin();iter!=aPicoEvent.fFirstParticleCollection->end();iter++){
-      fFirstParticleCollection->push_back(*iter);
-    }
+  fArenaUsed = 0;
+}
+//_________________
+bool AliFemtoPicoEvent::OwnsParticle(const AliFemtoParticle* particle) const
+{
+  // True if the particle was constructed with NewParticle() by this event
+  for (unsigned int ib = 0; ib < fArenaBlocks.size(); ib++) {
+    if (ib * kArenaBlockSize >= fArenaUsed)
+      break;
+    const AliFemtoParticle *first = fArenaBlocks[ib];
+    if (particle >= first && particle < first + kArenaBlockSize)
+      return true;
   }
-  fSecondParticleCollection = new AliFemtoParticleCollection;
-  if (aPicoEvent.fSecondParticleCollection) {
-    for (iter=aPicoEvent.fSecondParticleCollection->begin();iter!=aPicoEvent.fSecondParticleCollection->end();iter++){
-      fSecondParticleCollection->push_back(*iter);
-    }
+  return false;
+}
+//_________________
+void* AliFemtoPicoEvent::AllocateParticle()
+{
+  // Next free arena slot; blocks are never moved so particle addresses
+  // stay valid while the event lives
+  const unsigned int block = fArenaUsed / kArenaBlockSize;
+  if (block == fArenaBlocks.size()) {
+    void *storage = ::operator new(kArenaBlockSize * sizeof(AliFemtoParticle));
+    fArenaBlocks.push_back(static_cast<AliFemtoParticle*>(storage));
   }
-  fThirdParticleCollection = new AliFemtoParticleCollection;
-  if (aPicoEvent.fThirdParticleCollection) {
-    for (iter=aPicoEvent.fThirdParticleCollection->begin();iter!=aPicoEvent.fThirdParticleCollection->end();iter++){
-      fThirdParticleCollection->push_back(*iter);
-    }
+  return fArenaBlocks[block] + fArenaUsed++ % kArenaBlockSize;
+}
+//_________________
+void AliFemtoPicoEvent::ClearCollection(AliFemtoParticleCollection* collection)
+{
+  // Delete the heap particles of a collection and empty it. Arena particles
+  // are destroyed in Reset().
+  if (!collection)
+    return;
+  for (AliFemtoParticleIterator iter = collection->begin(); iter != collection->end(); iter++) {
+    if (!OwnsParticle(*iter))
+      delete *iter;
   }
-
-  return *this;
+  collection->clear();
+}
+//_________________
+void AliFemtoPicoEvent::CopyCollection(const AliFemtoParticleCollection* from, AliFemtoParticleCollection* to)
+{
+  // Deep copy of the particles of a collection into the arena
+  if (!from || !to)
+    return;
+  to->reserve(to->size() + from->size());
+  for (AliFemtoParticleConstIterator iter = from->begin(); iter != from->end(); iter++) {
+    to->push_back(new (AllocateParticle()) AliFemtoParticle(**iter));
+  }
+}
+//_________________
+void AliFemtoPicoEvent::ReleaseArena()
+{
+  // Give back the arena storage; all particles must be destroyed already
+  for (unsigned int ib = 0; ib < fArenaBlocks.size(); ib++) {
+    ::operator delete(fArenaBlocks[ib]);
+  }
+  fArenaBlocks.clear();
+  fArenaUsed = 0;
 }
-
@@ -42,6 +42,9 @@
 #ifndef ALIFEMTOPICOEVENT_H
 #define ALIFEMTOPICOEVENT_H
 
+#include <new>
+#include <vector>
+
 #include "AliFemtoParticleCollection.h"
 
 class AliFemtoPicoEvent{
@@ -58,14 +61,45 @@ public:
   AliFemtoParticleCollection* SecondParticleCollection();
   AliFemtoParticleCollection* ThirdParticleCollection();
 
+  /// Construct a particle in the arena of this pico event. The particle
+  /// is destroyed together with the event (or by Reset()) and must not be
+  /// deleted by the caller. Particles created with plain new may still be
+  /// added to the collections, they are deleted as before.
+  template <class T>
+  AliFemtoParticle* NewParticle(const T* item, const double& mass);
+
+  /// Destroy all particles and empty the collections, keeping the arena
+  /// and collection storage so the event can be refilled without
+  /// allocating. Used by the analyses to recycle events leaving the
+  /// mixing buffer.
+  void Reset();
+
+  bool OwnsParticle(const AliFemtoParticle* particle) const;
+
 private:
+  enum { kArenaBlockSize = 64 };  // particles per arena block
+
+  void* AllocateParticle();
+  void ClearCollection(AliFemtoParticleCollection* collection);
+  void CopyCollection(const AliFemtoParticleCollection* from, AliFemtoParticleCollection* to);
+  void ReleaseArena();
+
   AliFemtoParticleCollection* fFirstParticleCollection;  // Collection of particles of type 1
   AliFemtoParticleCollection* fSecondParticleCollection; // Collection of particles of type 2
   AliFemtoParticleCollection* fThirdParticleCollection;  // Collection of particles of type 3
+
+  std::vector<AliFemtoParticle*> fArenaBlocks;            // raw storage blocks of kArenaBlockSize particles
+  unsigned int fArenaUsed;                                // number of arena slots in use
 };
 
 inline AliFemtoParticleCollection* AliFemtoPicoEvent::FirstParticleCollection(){return fFirstParticleCollection;}
 inline AliFemtoParticleCollection* AliFemtoPicoEvent::SecondParticleCollection(){return fSecondParticleCollection;}
 inline AliFemtoParticleCollection* AliFemtoPicoEvent::ThirdParticleCollection(){return fThirdParticleCollection;}
 
+template <class T>
+inline AliFemtoParticle* AliFemtoPicoEvent::NewParticle(const T* item, const double& mass)
+{
+  return new (AllocateParticle()) AliFemtoParticle(item, mass);
+}
+
 #endif
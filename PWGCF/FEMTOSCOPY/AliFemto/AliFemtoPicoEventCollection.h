@@ -8,6 +8,8 @@
  * Description: part of STAR HBT Framework: AliFemtoMaker package
  *   A Collection of PicoEvents is what makes up the EventMixingBuffer
  *   of each Analysis
+ *   Stored in a std::deque: the buffer is filled at the front and
+ *   emptied at the back, without a heap node per stored event.
  *
  ***************************************************************************
  *
@@ -30,18 +32,18 @@
 #ifndef AliFemtoPicoEventCollection_hh
 #define AliFemtoPicoEventCollection_hh
 #include "AliFemtoPicoEvent.h"
-#include <list>
+#include <deque>
 
 #if !defined(ST_NO_NAMESPACES)
-using std::list;
+using std::deque;
 #endif
 
 #ifdef ST_NO_TEMPLATE_DEF_ARGS
-typedef list<AliFemtoPicoEvent*, allocator<AliFemtoPicoEvent*> >            AliFemtoPicoEventCollection;
-typedef list<AliFemtoPicoEvent*, allocator<AliFemtoPicoEvent*> >::iterator  AliFemtoPicoEventIterator;
+typedef deque<AliFemtoPicoEvent*, allocator<AliFemtoPicoEvent*> >            AliFemtoPicoEventCollection;
+typedef deque<AliFemtoPicoEvent*, allocator<AliFemtoPicoEvent*> >::iterator  AliFemtoPicoEventIterator;
 #else
-typedef list<AliFemtoPicoEvent*>            AliFemtoPicoEventCollection;
-typedef list<AliFemtoPicoEvent*>::iterator  AliFemtoPicoEventIterator;
+typedef deque<AliFemtoPicoEvent*>            AliFemtoPicoEventCollection;
+typedef deque<AliFemtoPicoEvent*>::iterator  AliFemtoPicoEventIterator;
 #endif
 
 #endif
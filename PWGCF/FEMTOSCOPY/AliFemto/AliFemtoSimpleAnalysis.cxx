@@ -12,6 +12,7 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
 #include <iterator>
 
 #ifdef __ROOT__
@@ -35,7 +36,9 @@ AliFemtoCorrFctn*    copyTheCorrFctn(AliFemtoCorrFctn*);
 /// dereferencing the container's iterator) and the cut's expected mass.
 ///
 /// This templated function accepts a track cut, track collection, and an
-/// AliFemtoParticleCollection (which points to the output) as input. The types
+/// AliFemtoParticleCollection (which points to the output) as input. If the
+/// pico event owning the output is given, the particles are constructed in
+/// its arena instead of being allocated one by one on the heap. The types
 /// of the tracks are determined by the template paramters, which should be
 /// automatically detected by argument inspection (you don't need to specify).
 ///
@@ -48,18 +51,22 @@ AliFemtoCorrFctn*    copyTheCorrFctn(AliFemtoCorrFctn*);
 template <class TrackCollectionType, class TrackCutType>
 void DoFillParticleCollection(TrackCutType *cut,
                               TrackCollectionType *track_collection,
-                              AliFemtoParticleCollection *output)
+                              AliFemtoParticleCollection *output,
+                              AliFemtoPicoEvent *picoEvent)
 {
   // lets's just name the iterator type
   typedef typename TrackCollectionType::iterator TrackCollectionIterType;
 
+  output->reserve(output->size() + track_collection->size());
+
   for (TrackCollectionIterType pIter = track_collection->begin();
                                pIter != track_collection->end();
                                pIter++) {
     const Bool_t track_passes = cut->Pass(*pIter);
     cut->FillCutMonitor(*pIter, track_passes);
     if (track_passes) {
-      output->push_back(new AliFemtoParticle(*pIter, cut->Mass()));
+      output->push_back(picoEvent ? picoEvent->NewParticle(*pIter, cut->Mass())
+                                  : new AliFemtoParticle(*pIter, cut->Mass()));
     }
   }
 }
@@ -70,13 +77,15 @@ void DoFillParticleCollection(TrackCutType *cut,
 //
 // The actual loop implementation has been moved to the collection-generic
 // DoFillParticleCollection() function
-void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
-                               AliFemtoEvent *hbtEvent,
-                               AliFemtoParticleCollection *partCollection,
-                               bool performSharedDaughterCut=kFALSE)
+static void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
+                                      AliFemtoEvent *hbtEvent,
+                                      AliFemtoParticleCollection *partCollection,
+                                      bool performSharedDaughterCut,
+                                      AliFemtoPicoEvent *picoEvent)
 {
   /// Fill particle collection with all particles in the event which pass
-  /// the provided cut
+  /// the provided cut. Particles are placed in the arena of picoEvent,
+  /// if given.
 
   // determine which track collection to use based on the particle type.
   switch (partCut->Type()) {
@@ -87,7 +96,8 @@ void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
     DoFillParticleCollection(
       (AliFemtoTrackCut*)partCut,
       hbtEvent->TrackCollection(),
-      partCollection
+      partCollection,
+      picoEvent
     );
 
     break;
@@ -102,14 +112,16 @@ void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
       AliFemtoV0SharedDaughterCut shared_daughter_cut;
       AliFemtoV0Collection v0_coll = shared_daughter_cut.AliFemtoV0SharedDaughterCutCollection(hbtEvent->V0Collection(), v0_cut);
       for (AliFemtoV0Iterator pIter = v0_coll.begin(); pIter != v0_coll.end(); ++pIter) {
-        partCollection->push_back(new AliFemtoParticle(*pIter, v0_cut->Mass()));
+        partCollection->push_back(picoEvent ? picoEvent->NewParticle(*pIter, v0_cut->Mass())
+                                            : new AliFemtoParticle(*pIter, v0_cut->Mass()));
       }
     } else {
 
       DoFillParticleCollection(
         v0_cut,
         hbtEvent->V0Collection(),
-        partCollection
+        partCollection,
+        picoEvent
       );
 
     }
@@ -123,7 +135,8 @@ void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
     DoFillParticleCollection(
       (AliFemtoXiTrackCut*)partCut,
       hbtEvent->XiCollection(),
-      partCollection
+      partCollection,
+      picoEvent
     );
 
     break;
@@ -134,7 +147,8 @@ void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
     DoFillParticleCollection(
       (AliFemtoKinkCut*)partCut,
       hbtEvent->KinkCollection(),
-      partCollection
+      partCollection,
+      picoEvent
     );
 
     break;
@@ -146,6 +160,16 @@ void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
 
   partCut->FillCutMonitor(hbtEvent, partCollection);
 }
+
+// Heap allocating version, used by the analyses which manage their own
+// pico events
+void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
+                               AliFemtoEvent *hbtEvent,
+                               AliFemtoParticleCollection *partCollection,
+                               bool performSharedDaughterCut=kFALSE)
+{
+  FillHbtParticleCollection(partCut, hbtEvent, partCollection, performSharedDaughterCut, NULL);
+}
 //____________________________
 AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fPicoEventCollectionVectorHideAway(NULL),
@@ -156,6 +180,7 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fSecondParticleCut(NULL),
   fMixingBuffer(NULL),
   fPicoEvent(NULL),
+  fSparePicoEvent(NULL),
   fNumEventsToMix(0),
   fNeventsProcessed(0),
   fMinSizePartCollection(0),
@@ -178,6 +203,7 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fSecondParticleCut(NULL),
   fMixingBuffer(NULL),
   fPicoEvent(NULL),
+  fSparePicoEvent(NULL),
   fNumEventsToMix(a.fNumEventsToMix),
   fNeventsProcessed(0),
   fMinSizePartCollection(a.fMinSizePartCollection),
@@ -294,6 +320,8 @@ AliFemtoSimpleAnalysis::~AliFemtoSimpleAnalysis()
     }
     delete fMixingBuffer;
   }
+
+  delete fSparePicoEvent;
 }
 //______________________
 AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAnalysis& aAna)
@@ -449,9 +477,9 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
   // Analysis likes the event -- build a pico event from it, using tracks the
   // analysis likes. This is what we will make pairs from and put in Mixing
   // Buffer.
-  // No memory leak: we will delete picoevents when they come out of the
+  // No memory leak: picoevents are recycled when they come out of the
   // mixing buffer
-  fPicoEvent = new AliFemtoPicoEvent;
+  fPicoEvent = NewPicoEvent();
 
   AliFemtoParticleCollection *collection1 = fPicoEvent->FirstParticleCollection(),
                              *collection2 = fPicoEvent->SecondParticleCollection();
@@ -460,7 +488,8 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
   if (collection1 == NULL || collection2 == NULL) {
     cout << "E-AliFemtoSimpleAnalysis::ProcessEvent: new PicoEvent is missing particle collections!\n";
     EventEnd(hbtEvent);  // cleanup for EbyE
-    delete fPicoEvent;
+    RecyclePicoEvent(fPicoEvent);
+    fPicoEvent = NULL;
     return;
   }
 
@@ -470,14 +499,16 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
   FillHbtParticleCollection(fFirstParticleCut,
                             (AliFemtoEvent*)hbtEvent,
                             fPicoEvent->FirstParticleCollection(),
-                            fPerformSharedDaughterCut);
+                            fPerformSharedDaughterCut,
+                            fPicoEvent);
 
   // fill second particle cut if not analyzing identical particles
   if ( !AnalyzeIdenticalParticles() ) {
       FillHbtParticleCollection(fSecondParticleCut,
                                 (AliFemtoEvent*)hbtEvent,
                                 fPicoEvent->SecondParticleCollection(),
-                                fPerformSharedDaughterCut);
+                                fPerformSharedDaughterCut,
+                                fPicoEvent);
   }
 
   const UInt_t coll_1_size = collection1->size(),
@@ -504,7 +535,8 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
 
   if (!tmpPassEvent) {
     EventEnd(hbtEvent);
-    delete fPicoEvent;
+    RecyclePicoEvent(fPicoEvent);
+    fPicoEvent = NULL;
     return;
   }
 
@@ -544,9 +576,9 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
     cout << " - mixed done   " << endl;
   }
 
-  //--------- If mixing buffer is full, delete oldest event ---------//
+  //--------- If mixing buffer is full, recycle oldest event ---------//
   if ( MixingBufferFull() ) {
-    delete MixingBuffer()->back();
+    RecyclePicoEvent(MixingBuffer()->back());
     MixingBuffer()->pop_back();
   }
 
@@ -566,8 +598,15 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
 /// Build pairs, check pair cuts, and call CFs' AddRealPair() or
 /// AddMixedPair() methods. If no second particle collection is
 /// specfied, make pairs within first particle collection.
+///
+/// The collections are contiguous arrays of particles which themselves
+/// live in the arena of their pico event, so both loops walk memory
+/// sequentially. The pairing order is the same as with the former list
+/// iteration.
 
   const string type = typeIn;
+  const bool isReal = (type == "real"),
+             isMixed = (type == "mixed");
 
   //  int swpart = ((long int) partCollection1) % 2;
 
@@ -576,60 +615,57 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
   // "Seed" this here.
   bool swpart = fNeventsProcessed % 2;
 
-  // Setup iterator ranges
+  // Setup index ranges
   //
   // The outer loop alway starts at beginning of particle collection 1.
   // * If we are iterating over both particle collections, then the loop simply
   // runs through both from beginning to end.
   // * If we are only iterating over one particle collection, the inner loop
-  // loops over all particles between the outer iterator and the end of the
+  // loops over all particles between the outer index and the end of the
   // collection. The outer loop must skip the last entry of the list.
-  AliFemtoParticleConstIterator tStartOuterLoop = partCollection1->begin(),
-                                tEndOuterLoop = partCollection1->end(),
-                                tStartInnerLoop,
-                                tEndInnerLoop;
+  const UInt_t nOuter = partCollection1->size(),
+               nInner = partCollection2 ? partCollection2->size() : nOuter;
 
-  if (partCollection2) {                         // Two collections:
-    tStartInnerLoop = partCollection2->begin();  //   Full inner & outer loops
-    tEndInnerLoop   = partCollection2->end();    //
-  }
-  else {                                         // One collection:
-    tEndOuterLoop--;                             //   Outer loop goes to next-to-last particle
-    tEndInnerLoop = partCollection1->end() ;     //   Inner loop goes to last particle
+  if (nOuter == 0 || nInner == 0 || (!partCollection2 && nOuter < 2)) {
+    return;
   }
 
+  AliFemtoParticle *const *particles1 = &partCollection1->front(),
+                   *const *particles2 = partCollection2 ? &partCollection2->front() : particles1;
+
+  const UInt_t tEndOuterLoop = partCollection2 ? nOuter : nOuter - 1;
+
+  // Flat copy of the correlation functions - avoids walking the list for
+  // every accepted pair
+  std::vector<AliFemtoCorrFctn*> corrFctns(fCorrFctnCollection->begin(),
+                                           fCorrFctnCollection->end());
+  const UInt_t nCorrFctns = corrFctns.size();
+
   // Create the pair outside the loop - only allocate once
   AliFemtoPair* tPair = new AliFemtoPair;
 
   // Begin the outer loop
-  for (AliFemtoParticleConstIterator tPartIter1 = tStartOuterLoop;
-                                     tPartIter1 != tEndOuterLoop;
-                                     ++tPartIter1) {
+  for (UInt_t i1 = 0; i1 < tEndOuterLoop; ++i1) {
 
     // If analyzing identical particles, start inner loop at the particle
     // after the current outer loop position, (loops until end)
-    if (!partCollection2) {
-      tStartInnerLoop = tPartIter1;
-      tStartInnerLoop++;
-    }
+    const UInt_t tStartInnerLoop = partCollection2 ? 0 : i1 + 1;
 
     // If we have two collections - set the first track
     if (partCollection2 != NULL) {
-      tPair->SetTrack1(*tPartIter1);
+      tPair->SetTrack1(particles1[i1]);
     }
 
     // Begin the inner loop
-    for (AliFemtoParticleConstIterator tPartIter2 = tStartInnerLoop;
-                                       tPartIter2 != tEndInnerLoop;
-                                     ++tPartIter2) {
+    for (UInt_t i2 = tStartInnerLoop; i2 < nInner; ++i2) {
       // If we have two collections - only set the second track
       if (partCollection2 != NULL) {
-        tPair->SetTrack2(*tPartIter2);
+        tPair->SetTrack2(particles2[i2]);
 
       // Swap between first and second particles to avoid biased ordering
       } else {
-        tPair->SetTrack1(swpart ? *tPartIter2 : *tPartIter1);
-        tPair->SetTrack2(swpart ? *tPartIter1 : *tPartIter2);
+        tPair->SetTrack1(swpart ? particles2[i2] : particles1[i1]);
+        tPair->SetTrack2(swpart ? particles1[i1] : particles2[i2]);
         swpart = !swpart;
       }
 
@@ -643,15 +679,13 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
 
       // If pair passes cut, loop over CF's and add pair to real/mixed
       if (tmpPassPair) {
-        for (AliFemtoCorrFctnIterator tCorrFctnIter = fCorrFctnCollection->begin();
-                                      tCorrFctnIter != fCorrFctnCollection->end();
-                                    ++tCorrFctnIter) {
+        for (UInt_t ic = 0; ic < nCorrFctns; ++ic) {
 
-          AliFemtoCorrFctn* tCorrFctn = *tCorrFctnIter;
+          AliFemtoCorrFctn* tCorrFctn = corrFctns[ic];
 
-          if (type == "real")
+          if (isReal)
             tCorrFctn->AddRealPair(tPair);
-          else if(type == "mixed")
+          else if (isMixed)
             tCorrFctn->AddMixedPair(tPair);
           else
             cout << "Problem with pair type, type = " << type << endl;
@@ -664,6 +698,28 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
   delete tPair;
 }
 //_________________________
+AliFemtoPicoEvent* AliFemtoSimpleAnalysis::NewPicoEvent()
+{
+  /// Spare pico event if there is one, a new one otherwise
+
+  AliFemtoPicoEvent *picoEvent = fSparePicoEvent;
+  fSparePicoEvent = NULL;
+  return picoEvent ? picoEvent : new AliFemtoPicoEvent;
+}
+//_________________________
+void AliFemtoSimpleAnalysis::RecyclePicoEvent(AliFemtoPicoEvent* picoEvent)
+{
+  /// Keep the event as the spare one (emptied), or delete it if there is
+  /// already a spare
+
+  if (fSparePicoEvent) {
+    delete picoEvent;
+    return;
+  }
+  picoEvent->Reset();
+  fSparePicoEvent = picoEvent;
+}
+//_________________________
 void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
 {
   /// Perform initialization operations at the beginning of the event processing
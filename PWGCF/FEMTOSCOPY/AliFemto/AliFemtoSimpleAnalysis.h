@@ -158,6 +158,15 @@ protected:
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// Pico event to be filled with the next event - the spare one, if an
+  /// event was recycled, otherwise a new one.
+  AliFemtoPicoEvent* NewPicoEvent();
+
+  /// Hand back a pico event that is no longer needed (rejected, or pushed
+  /// out of the mixing buffer). One event is kept as a spare, so its
+  /// particle arena and collections are reused instead of reallocated.
+  void RecyclePicoEvent(AliFemtoPicoEvent* picoEvent);
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
@@ -167,6 +176,7 @@ protected:
   AliFemtoParticleCut*         fSecondParticleCut;   ///< select particles of type #2
   AliFemtoPicoEventCollection* fMixingBuffer;        ///< mixing buffer used in this simplest analysis
   AliFemtoPicoEvent*           fPicoEvent;           //!<! The current event, in the small (pico) form
+  AliFemtoPicoEvent*           fSparePicoEvent;      //!<! Recycled pico event, reused by NewPicoEvent()
 
   unsigned int fNumEventsToMix;                      ///< How many "previous" events get mixed with this one, to make background
   unsigned int fNeventsProcessed;                    ///< How many events processed so far
@@ -16,6 +16,7 @@
 #pragma link C++ class AliDielectronMC+;
 #pragma link C++ class AliDielectronQnEPcorrection+;
 #pragma link C++ class AliDielectronVarManager+;
+#pragma link C++ class AliDielectronVarContext+;
 #pragma link C++ class AliAnalysisTaskDielectronFilter+;
 #pragma link C++ class AliAnalysisTaskMultiDielectron+;
 #pragma link C++ class AliAnalysisTaskRandomRejection+;
@@ -42,6 +43,7 @@
 #pragma link C++ class AliDielectronBtoJPSItoEle+;
 #pragma link C++ class AliDielectronSignalMC+;
 #pragma link C++ class AliDielectronEvent+;
+#pragma link C++ class AliDielectronMixedTrack+;
 #pragma link C++ class AliDielectronMixingHandler+;
 #pragma link C++ class AliAnalysisTask_Syst_PtDistributionsData+;
 #pragma link C++ class AliAnalysisTask_Syst_PtDistributionsMC+;
@@ -391,10 +391,13 @@ void AliAnalysisTaskDielectronFilter::UserExec(Option_t *)
 			}
 		}
 
+			//the pooled pairs are reused in the next event, write owning copies
+		fDielectron->CopyPairArraysForExport();
+
 			//replace the references of the legs with the AOD references
 		TObjArray *obj = 0x0;
 		for(Int_t i=0; i < 11; i++ ){
-			obj = (TObjArray*)((*(fDielectron->GetPairArraysPointer()))->UncheckedAt(i));
+			obj = (TObjArray*)((*(fDielectron->GetExportPairArraysPointer()))->UncheckedAt(i));
 			if(!obj) continue;
 			for(int j=0;j<obj->GetEntriesFast();j++){
 				AliDielectronPair *pairObj = (AliDielectronPair*)obj->UncheckedAt(j);
@@ -420,7 +423,7 @@ void AliAnalysisTaskDielectronFilter::UserExec(Option_t *)
 			t->Branch(aod->GetList());
 
 		if (!t->GetBranch("dielectrons"))
-			t->Bronch("dielectrons","TObjArray",fDielectron->GetPairArraysPointer());
+			t->Bronch("dielectrons","TObjArray",fDielectron->GetExportPairArraysPointer());
 
 
 			// store positive and negative tracks
@@ -47,6 +47,8 @@ The names are available via the function PairClassName(Int_t i)
 #include <TMath.h>
 #include <TObject.h>
 #include <TGrid.h>
+#include <TDatabasePDG.h>
+#include <TParticlePDG.h>
 
 #include <AliKFParticle.h>
 
@@ -68,6 +70,9 @@ The names are available via the function PairClassName(Int_t i)
 #include "AliDielectronSignalMC.h"
 #include "AliDielectronMixingHandler.h"
 #include "AliDielectronPairLegCuts.h"
+#include "AliDielectronVarCuts.h"
+#include "AliDielectronCutGroup.h"
+#include "AliDielectronEventCuts.h"
 #include "AliDielectronV0Cuts.h"
 #include "AliDielectronPID.h"
 #include "AliDielectronHistos.h"
@@ -97,6 +102,147 @@ const char* AliDielectron::fgkPairClassNames[11] = {
   "ev1+_ev1-_TR"
 };
 
+namespace {
+  void SetVarContext(AliAnalysisFilter &filter, AliDielectronVarContext *ctx);
+
+  //________________________________________________________________
+  void SetVarContext(AliAnalysisCuts *cut, AliDielectronVarContext *ctx)
+  {
+    //
+    // hand the variable manager context to variable cuts, also inside cut groups and leg cuts
+    //
+    if (!cut) return;
+    if (cut->InheritsFrom(AliDielectronVarCuts::Class())) {
+      static_cast<AliDielectronVarCuts*>(cut)->SetVarContext(ctx);
+    } else if (cut->InheritsFrom(AliDielectronCutGroup::Class())) {
+      AliDielectronCutGroup *group=static_cast<AliDielectronCutGroup*>(cut);
+      for (Int_t i=0; i<group->GetNCuts(); ++i) SetVarContext(const_cast<AliAnalysisCuts*>(group->GetCut(i)),ctx);
+    } else if (cut->InheritsFrom(AliDielectronPairLegCuts::Class())) {
+      AliDielectronPairLegCuts *legCuts=static_cast<AliDielectronPairLegCuts*>(cut);
+      SetVarContext(legCuts->GetLeg1Filter(),ctx);
+      SetVarContext(legCuts->GetLeg2Filter(),ctx);
+    }
+  }
+
+  //________________________________________________________________
+  void SetVarContext(AliAnalysisFilter &filter, AliDielectronVarContext *ctx)
+  {
+    //
+    // hand the variable manager context to all cuts of a filter
+    //
+    TIter next(filter.GetCuts());
+    while (AliAnalysisCuts *cut=static_cast<AliAnalysisCuts*>(next())) SetVarContext(cut,ctx);
+  }
+
+  void AddUsedVars(AliAnalysisFilter &filter, TBits *vars);
+
+  //________________________________________________________________
+  void AddUsedVars(AliAnalysisCuts *cut, TBits *vars)
+  {
+    //
+    // add the variables a cut fills through the variable manager
+    //
+    if (!cut) return;
+    TBits *used=0x0;
+    if (cut->InheritsFrom(AliDielectronVarCuts::Class())) {
+      used=static_cast<AliDielectronVarCuts*>(cut)->GetUsedVars();
+    } else if (cut->InheritsFrom(AliDielectronPID::Class())) {
+      used=static_cast<AliDielectronPID*>(cut)->GetUsedVars();
+    } else if (cut->InheritsFrom(AliDielectronEventCuts::Class())) {
+      used=static_cast<AliDielectronEventCuts*>(cut)->GetUsedVars();
+    } else if (cut->InheritsFrom(AliDielectronCutGroup::Class())) {
+      AliDielectronCutGroup *group=static_cast<AliDielectronCutGroup*>(cut);
+      for (Int_t i=0; i<group->GetNCuts(); ++i) AddUsedVars(const_cast<AliAnalysisCuts*>(group->GetCut(i)),vars);
+    } else if (cut->InheritsFrom(AliDielectronPairLegCuts::Class())) {
+      AliDielectronPairLegCuts *legCuts=static_cast<AliDielectronPairLegCuts*>(cut);
+      AddUsedVars(legCuts->GetLeg1Filter(),vars);
+      AddUsedVars(legCuts->GetLeg2Filter(),vars);
+    }
+    if (used) (*vars)|=(*used);
+  }
+
+  //________________________________________________________________
+  void AddUsedVars(AliAnalysisFilter &filter, TBits *vars)
+  {
+    //
+    // add the variables used by all cuts of a filter
+    //
+    TIter next(filter.GetCuts());
+    while (AliAnalysisCuts *cut=static_cast<AliAnalysisCuts*>(next())) AddUsedVars(cut,vars);
+  }
+
+  //________________________________________________________________
+  Double_t LegMass2(Int_t pdg)
+  {
+    //
+    // squared mass of a leg hypothesis
+    //
+    TParticlePDG *part=TDatabasePDG::Instance()->GetParticle(pdg);
+    if (!part) return 0.;
+    return part->Mass()*part->Mass();
+  }
+
+  //________________________________________________________________
+  void PackLegKinematics(const TObjArray &arr, std::vector<Double_t> &kin)
+  {
+    //
+    // px, py, pz and p of all tracks of the array, four values per track
+    //
+    const Int_t ntracks=arr.GetEntriesFast();
+    kin.resize(4*ntracks);
+    for (Int_t itrack=0; itrack<ntracks; ++itrack){
+      Double_t *k=&kin[4*itrack];
+      const AliVParticle *track=static_cast<const AliVParticle*>(arr.UncheckedAt(itrack));
+      if (!track) { k[0]=k[1]=k[2]=k[3]=0.; continue; }
+      k[0]=track->Px();
+      k[1]=track->Py();
+      k[2]=track->Pz();
+      k[3]=TMath::Sqrt(k[0]*k[0]+k[1]*k[1]+k[2]*k[2]);
+    }
+  }
+
+  //________________________________________________________________
+  void LegKinematicsWindow(Double_t minMass, Double_t maxMass, Double_t minOpAngle, Double_t maxOpAngle, Double_t window[4])
+  {
+    //
+    // translate a mass and opening angle window to the bounds used by PassLegKinematics:
+    // squared mass min/max and cosine of the opening angle min/max; negative max means no limit
+    //
+    window[0]=minMass>0. ? minMass*minMass : -1.;
+    window[1]=maxMass>=0. ? maxMass*maxMass : -1.;
+    window[2]=maxOpAngle>=0. ? TMath::Cos(maxOpAngle) : -2.;
+    window[3]=minOpAngle>0. ? TMath::Cos(minOpAngle) : 2.;
+  }
+
+  //________________________________________________________________
+  Bool_t PassLegKinematics(const Double_t *k1, Double_t m12, const Double_t *k2, Double_t m22, const Double_t window[4])
+  {
+    //
+    // mass and opening angle window on the four-momenta of the legs, see LegKinematicsWindow
+    //
+    const Double_t dot=k1[0]*k2[0]+k1[1]*k2[1]+k1[2]*k2[2];
+    const Double_t pp=k1[3]*k2[3];
+    if (dot<window[2]*pp || dot>window[3]*pp) return kFALSE;
+    if (window[0]<0. && window[1]<0.) return kTRUE;
+    const Double_t e=TMath::Sqrt(k1[3]*k1[3]+m12)+TMath::Sqrt(k2[3]*k2[3]+m22);
+    const Double_t m2=e*e-(k1[3]*k1[3]+k2[3]*k2[3]+2.*dot);
+    if (m2<window[0]) return kFALSE;
+    if (window[1]>=0. && m2>window[1]) return kFALSE;
+    return kTRUE;
+  }
+
+  //________________________________________________________________
+  void CopyTrackArray(const TObjArray &src, TObjArray &dst)
+  {
+    //
+    // copy the track pointers, keeping the storage of the destination
+    //
+    dst.Clear();
+    const Int_t ntracks=src.GetEntriesFast();
+    for (Int_t itrack=0; itrack<ntracks; ++itrack) dst.AddAtAndExpand(src.UncheckedAt(itrack),itrack);
+  }
+}
+
 //________________________________________________________________
 AliDielectron::AliDielectron() :
   TNamed("AliDielectron","AliDielectron"),
@@ -131,6 +277,8 @@ AliDielectron::AliDielectron() :
   fHistoArray(0x0),
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fVarContext(new AliDielectronVarContext),
+  fRequiredVars(0x0),
   fPairCandidates(new TObjArray(11)),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
@@ -156,6 +304,16 @@ AliDielectron::AliDielectron() :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fPairPreSelection(kFALSE),
+  fPreFilterPreSelection(kFALSE),
+  fPreFilterPreSelMass(0.),
+  fPreFilterPreSelOpAngle(-1.),
+  fPairPool(0x0),
+  fNPooledPairs(0),
+  fExportPairCandidates(0x0),
+  fPairTracks(),
+  fLegKinematics(),
+  fMCConnected(kTRUE),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -167,7 +325,11 @@ AliDielectron::AliDielectron() :
   //
   // Default constructor
   //
-
+  fVarContext->SetCaching(kTRUE);
+  for (Int_t i=0; i<2; ++i) {
+    fPairPreSelMass[i]=0.;
+    fPairPreSelOpAngle[i]=-1.;
+  }
 }
 
 //________________________________________________________________
@@ -204,6 +366,8 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fHistoArray(0x0),
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fVarContext(new AliDielectronVarContext),
+  fRequiredVars(0x0),
   fPairCandidates(new TObjArray(11)),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
@@ -229,6 +393,16 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fPairPreSelection(kFALSE),
+  fPreFilterPreSelection(kFALSE),
+  fPreFilterPreSelMass(0.),
+  fPreFilterPreSelOpAngle(-1.),
+  fPairPool(0x0),
+  fNPooledPairs(0),
+  fExportPairCandidates(0x0),
+  fPairTracks(),
+  fLegKinematics(),
+  fMCConnected(kTRUE),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -239,7 +413,11 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   //
   // Named constructor
   //
-
+  fVarContext->SetCaching(kTRUE);
+  for (Int_t i=0; i<2; ++i) {
+    fPairPreSelMass[i]=0.;
+    fPairPreSelOpAngle[i]=-1.;
+  }
 }
 
 //________________________________________________________________
@@ -259,7 +437,11 @@ AliDielectron::~AliDielectron()
   if (fPairEffMap) delete fPairEffMap;
   if (fHistos) delete fHistos;
   if (fUsedVars) delete fUsedVars;
+  if (fVarContext) delete fVarContext;
+  if (fRequiredVars) delete fRequiredVars;
   if (fPairCandidates && fEventProcess) delete fPairCandidates;
+  if (fPairPool) delete fPairPool;
+  if (fExportPairCandidates) delete fExportPairCandidates;
   if (fDebugTree) delete fDebugTree;
   if (fMixing) delete fMixing;
   if (fSignalsMC) delete fSignalsMC;
@@ -280,6 +462,7 @@ void AliDielectron::Init()
   if (fCfManagerPair) {
     fCfManagerPair->SetSignalsMC(fSignalsMC);
     fCfManagerPair->InitialiseContainer(fPairFilter);
+    fCfManagerPair->SetVarContext(fVarContext);
   }
   if (fTrackRotator)  {
     if(fRotatePP){
@@ -332,6 +515,59 @@ void AliDielectron::Init()
     (*fUsedVars)|= (*fHistos->GetUsedVars());
   }
 
+  // let the variable cuts use the event information of this instance
+  SetVarContext(fEventFilter,fVarContext);
+  SetVarContext(fTrackFilter,fVarContext);
+  SetVarContext(fPairPreFilter1,fVarContext);
+  SetVarContext(fPairPreFilterLegs1,fVarContext);
+  SetVarContext(fPairPreFilter2,fVarContext);
+  SetVarContext(fPairPreFilterLegs2,fVarContext);
+  SetVarContext(fPairFilter,fVarContext);
+  SetVarContext(fEventPlanePreFilter,fVarContext);
+  SetVarContext(fEventPlanePOIPreFilter,fVarContext);
+
+  // collect the variables needed by this instance; they are computed together
+  // once per track and event, with everything they are derived from
+  if (!fRequiredVars) fRequiredVars=new TBits(AliDielectronVarManager::kNMaxValues);
+  fRequiredVars->ResetAllBits();
+  (*fRequiredVars)|=(*fUsedVars);
+  if (fHistoArray && fHistoArray->GetUsedVars()) (*fRequiredVars)|=(*fHistoArray->GetUsedVars());
+  if (fCfManagerPair && fCfManagerPair->GetUsedVars()) (*fRequiredVars)|=(*fCfManagerPair->GetUsedVars());
+  if (fDebugTree && fDebugTree->GetUsedVars()) (*fRequiredVars)|=(*fDebugTree->GetUsedVars());
+  if (fMixing) fMixing->AddUsedVars(fRequiredVars);
+  AddUsedVars(fEventFilter,fRequiredVars);
+  AddUsedVars(fTrackFilter,fRequiredVars);
+  AddUsedVars(fPairPreFilter1,fRequiredVars);
+  AddUsedVars(fPairPreFilterLegs1,fRequiredVars);
+  AddUsedVars(fPairPreFilter2,fRequiredVars);
+  AddUsedVars(fPairPreFilterLegs2,fRequiredVars);
+  AddUsedVars(fPairFilter,fRequiredVars);
+  AddUsedVars(fEventPlanePreFilter,fRequiredVars);
+  AddUsedVars(fEventPlanePOIPreFilter,fRequiredVars);
+  AliDielectronVarManager::AddEffMapVars(fLegEffMap,fRequiredVars);
+  AliDielectronVarManager::AddEffMapVars(fPairEffMap,fRequiredVars);
+  AliDielectronVarManager::AddDependencies(fRequiredVars);
+  fVarContext->SetRequiredVars(fRequiredVars);
+  AliInfo(Form("%u variables required",fRequiredVars->CountBits()));
+  if (fMixing) fMixing->InitCompactPools(this);
+}
+
+//________________________________________________________________
+void AliDielectron::SetVarCaching(Bool_t cache/*=kTRUE*/)
+{
+  //
+  // reuse the variables of a track for all cuts, histograms and CF steps of an event
+  //
+  fVarContext->SetCaching(cache);
+}
+
+//________________________________________________________________
+void AliDielectron::SetVarProfiling(Bool_t prof/*=kTRUE*/)
+{
+  //
+  // collect fill statistics of the variable manager, see AliDielectronVarContext::Print
+  //
+  fVarContext->SetProfiling(prof);
 }
 
 //________________________________________________________________
@@ -342,6 +578,9 @@ void AliDielectron::Process(TObjArray *arr)
   // Process the pair array
   //
 
+  AliDielectronVarContextScope varContext(fVarContext);
+  AliDielectronVarManager::ResetCache();
+
   // set pair arrays
   fPairCandidates = arr;
 
@@ -365,6 +604,8 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
   // Process the events
   //
 
+  AliDielectronVarContextScope varContext(fVarContext);
+
   //at least first event is needed!
   if (!ev1){
     AliError("At least first event must be set!");
@@ -400,8 +641,8 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
   if(fPostPIDCntrdCorrITS)  AliDielectronPID::SetCentroidCorrFunctionITS(fPostPIDCntrdCorrITS);
   if(fPostPIDWdthCorrITS)   AliDielectronPID::SetWidthCorrFunctionITS(fPostPIDWdthCorrITS);
 
-  // set event
-  AliDielectronVarManager::SetFillMap(fUsedVars);
+  // set event, the event data are needed by all cuts and histograms
+  AliDielectronVarManager::SetFillMap(fRequiredVars ? fRequiredVars : fUsedVars);
   AliDielectronVarManager::SetEvent(ev1);
   if (fMixing){
     //set mixing bin to event data
@@ -415,7 +656,8 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
 
   //in case we have MC load the MC event and process the MC particles
   // why do not apply the event cuts first ????
-  if (AliDielectronMC::Instance()->ConnectMCEvent()){
+  fMCConnected=AliDielectronMC::Instance()->ConnectMCEvent();
+  if (fMCConnected){
     ProcessMC(ev1);
   }
 
@@ -1180,6 +1422,17 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
   UInt_t selectedMask= (1<<pairPreFilter->GetCuts()->GetEntries())-1 ;
   UInt_t selectedMaskPair=(1<<fPairFilter.GetCuts()->GetEntries())-1;
 
+  //leg kinematics for the pre-selection before the KF pair is built
+  Double_t window[4]={0.,0.,0.,0.};
+  Double_t m12=0., m22=0.;
+  if (fPreFilterPreSelection) {
+    LegKinematicsWindow(0.,fPreFilterPreSelMass,0.,fPreFilterPreSelOpAngle,window);
+    m12=LegMass2(fPdgLeg1);
+    m22=LegMass2(fPdgLeg2);
+    PackLegKinematics(arrTracks1,fLegKinematics[0]);
+    PackLegKinematics(arrTracks2,fLegKinematics[1]);
+  }
+
   Int_t nRejPasses = 1; //for fPreFilterUnlikeOnly and no set flag
   if (prefilterAllSigns) nRejPasses = 3;
 
@@ -1206,6 +1459,8 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
     }
     Int_t ntrack1RP=(*arrTracks1RP).GetEntriesFast();
     Int_t ntrack2RP=(*arrTracks2RP).GetEntriesFast();
+    const std::vector<Double_t> &kin1RP = fLegKinematics[arrTracks1RP==&arrTracks1 ? 0 : 1];
+    const std::vector<Double_t> &kin2RP = fLegKinematics[arrTracks2RP==&arrTracks1 ? 0 : 1];
 
     Int_t pairIndex=GetPairIndex(arr1RP,arr2RP);
 
@@ -1229,6 +1484,8 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
           TObject *track2=(*arrTracks2RP).UncheckedAt(itrack2);
           if (!track1 || !track2) continue;
           maxLikelihood2[itrack2] = -999.;
+          if (fPreFilterPreSelection &&
+              !PassLegKinematics(&kin1RP[4*itrack1],m12,&kin2RP[4*itrack2],m22,window)) continue;
           //create the pair
           if(prefilterPhotons){
             candidate.SetGammaTracks(static_cast<AliVTrack*>(track1), fPdgLeg1,
@@ -1240,7 +1497,7 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
           }
 
           candidate.SetType(pairIndex);
-          candidate.SetLabel(AliDielectronMC::Instance()->GetLabelMotherWithPdg(&candidate,fPdgMother));
+          candidate.SetLabel(fMCConnected ? AliDielectronMC::Instance()->GetLabelMotherWithPdg(&candidate,fPdgMother) : -1);
           //relate to the production vertex
           //       if (AliDielectronVarManager::GetKFVertex()) candidate.SetProductionVertex(*AliDielectronVarManager::GetKFVertex());
 
@@ -1281,6 +1538,8 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
           TObject *track1=(*arrTracks1RP).UncheckedAt(itrack1);
           TObject *track2=(*arrTracks2RP).UncheckedAt(itrack2);
           if (!track1 || !track2) continue;
+          if (fPreFilterPreSelection &&
+              !PassLegKinematics(&kin1RP[4*itrack1],m12,&kin2RP[4*itrack2],m22,window)) continue;
           //create the pair
           if(prefilterPhotons){
             candidate.SetGammaTracks(static_cast<AliVTrack*>(track1), fPdgLeg1,
@@ -1292,7 +1551,7 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
           }
 
           candidate.SetType(pairIndex);
-          candidate.SetLabel(AliDielectronMC::Instance()->GetLabelMotherWithPdg(&candidate,fPdgMother));
+          candidate.SetLabel(fMCConnected ? AliDielectronMC::Instance()->GetLabelMotherWithPdg(&candidate,fPdgMother) : -1);
           //relate to the production vertex
           //       if (AliDielectronVarManager::GetKFVertex()) candidate.SetProductionVertex(*AliDielectronVarManager::GetKFVertex());
 
@@ -1377,21 +1636,38 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
   // select pairs and fill pair candidate arrays
   //
 
-  TObjArray arrTracks1=fTracks[arr1];
-  TObjArray arrTracks2=fTracks[arr2];
-
-  //process pre filter if set
-  if ((!fPreFilterAllSigns1) && (!fPreFilterUnlikeOnly1) && (!fPreFilterLikeOnly1) && ( fPairPreFilter1.GetCuts()->GetEntries()>0 ))  PairPreFilter(arr1, arr2, arrTracks1, arrTracks2, ev, 1);
-
-  if ((!fPreFilterAllSigns2) && (!fPreFilterUnlikeOnly2) && (!fPreFilterLikeOnly2) && ( fPairPreFilter2.GetCuts()->GetEntries()>0 ))  PairPreFilter(arr1, arr2, arrTracks1, arrTracks2, ev, 2);
+  Bool_t preFilter1=(!fPreFilterAllSigns1) && (!fPreFilterUnlikeOnly1) && (!fPreFilterLikeOnly1) && ( fPairPreFilter1.GetCuts()->GetEntries()>0 );
+  Bool_t preFilter2=(!fPreFilterAllSigns2) && (!fPreFilterUnlikeOnly2) && (!fPreFilterLikeOnly2) && ( fPairPreFilter2.GetCuts()->GetEntries()>0 );
+
+  //the pre filter removes tracks, it works on copies of the track arrays
+  TObjArray *arrTracks1=&fTracks[arr1];
+  TObjArray *arrTracks2=&fTracks[arr2];
+  if (preFilter1 || preFilter2) {
+    CopyTrackArray(fTracks[arr1],fPairTracks[0]);
+    CopyTrackArray(fTracks[arr2],fPairTracks[1]);
+    arrTracks1=&fPairTracks[0];
+    arrTracks2=&fPairTracks[1];
+    //process pre filter if set
+    if (preFilter1) PairPreFilter(arr1, arr2, *arrTracks1, *arrTracks2, ev, 1);
+    if (preFilter2) PairPreFilter(arr1, arr2, *arrTracks1, *arrTracks2, ev, 2);
+  }
 
   Int_t pairIndex=GetPairIndex(arr1,arr2);
-
-  Int_t ntrack1=arrTracks1.GetEntriesFast();
-  Int_t ntrack2=arrTracks2.GetEntriesFast();
-
-  AliDielectronPair *candidate=new AliDielectronPair;
-  candidate->SetKFUsage(fUseKF);
+  TObjArray *pairArray=PairArray(pairIndex);
+
+  Int_t ntrack1=arrTracks1->GetEntriesFast();
+  Int_t ntrack2=arrTracks2->GetEntriesFast();
+
+  //leg kinematics for the pre-selection before the KF pair is built
+  Double_t window[4]={0.,0.,0.,0.};
+  Double_t m12=0., m22=0.;
+  if (fPairPreSelection) {
+    LegKinematicsWindow(fPairPreSelMass[0],fPairPreSelMass[1],fPairPreSelOpAngle[0],fPairPreSelOpAngle[1],window);
+    m12=LegMass2(fPdgLeg1);
+    m22=LegMass2(fPdgLeg2);
+    PackLegKinematics(*arrTracks1,fLegKinematics[0]);
+    PackLegKinematics(*arrTracks2,fLegKinematics[1]);
+  }
 
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
 
@@ -1399,22 +1675,32 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
     Int_t end=ntrack2;
     if (arr1==arr2) end=itrack1;
     for (Int_t itrack2=0; itrack2<end; ++itrack2){
-      //create the pair (direct pointer to the memory by this daughter reference are kept also for ME)
-      candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1))), fPdgLeg1,
-                           &(*static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2))), fPdgLeg2);
+      if (fPairPreSelection &&
+          !PassLegKinematics(&fLegKinematics[0][4*itrack1],m12,&fLegKinematics[1][4*itrack2],m22,window)) continue;
+
+      //create the pair in the next free pool entry (direct pointer to the memory by this daughter reference are kept also for ME)
+      AliDielectronPair *candidate=PooledPair();
+      candidate->SetKFUsage(fUseKF);
+      candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1->UncheckedAt(itrack1))), fPdgLeg1,
+                           &(*static_cast<AliVTrack*>(arrTracks2->UncheckedAt(itrack2))), fPdgLeg2);
       candidate->SetType(pairIndex);
 
-      Int_t label=AliDielectronMC::Instance()->GetLabelMotherWithPdg(candidate,fPdgMother);
-      candidate->SetLabel(label);
-      if (label>-1) candidate->SetPdgCode(fPdgMother);
-      else candidate->SetPdgCode(0);
-
-      // check for gamma kf particle
-      label=AliDielectronMC::Instance()->GetLabelMotherWithPdg(candidate,22);
-      if (label>-1 && fUseGammaTracks) {
-        candidate->SetGammaTracks(static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1)), fPdgLeg1,
-                                  static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2)), fPdgLeg2);
-      // should we set the pdgmothercode and the label
+      if (fMCConnected) {
+        Int_t label=AliDielectronMC::Instance()->GetLabelMotherWithPdg(candidate,fPdgMother);
+        candidate->SetLabel(label);
+        if (label>-1) candidate->SetPdgCode(fPdgMother);
+        else candidate->SetPdgCode(0);
+
+        // check for gamma kf particle
+        label=AliDielectronMC::Instance()->GetLabelMotherWithPdg(candidate,22);
+        if (label>-1 && fUseGammaTracks) {
+          candidate->SetGammaTracks(static_cast<AliVTrack*>(arrTracks1->UncheckedAt(itrack1)), fPdgLeg1,
+                                    static_cast<AliVTrack*>(arrTracks2->UncheckedAt(itrack2)), fPdgLeg2);
+        // should we set the pdgmothercode and the label
+        }
+      } else {
+        candidate->SetLabel(-1);
+        candidate->SetPdgCode(0);
       }
 
       //pair cuts
@@ -1429,21 +1715,17 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
         fQAmonitor->Fill(cutMask,candidate);
       }
 
-      //apply cut
+      //apply cut, a rejected candidate is overwritten by the next one
       if (cutMask!=selectedMask) continue;
 
       //histogram array for the pair
       if (fHistoArray) fHistoArray->Fill(pairIndex,candidate);
 
-      //add the candidate to the candidate array
-      PairArray(pairIndex)->Add(candidate);
-      //get a new candidate
-      candidate=new AliDielectronPair;
-      candidate->SetKFUsage(fUseKF);
+      //add the candidate to the candidate array and keep its pool entry
+      pairArray->Add(candidate);
+      ++fNPooledPairs;
     }
   }
-  //delete the surplus candidate
-  delete candidate;
 }
 
 //________________________________________________________________
@@ -1454,10 +1736,10 @@ void AliDielectron::FillPairArrayTR()
   //
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
 
+  AliDielectronPair candidate;
+  candidate.SetKFUsage(fUseKF);
   while ( fTrackRotator->NextCombination() ){
     if(fTrackRotator->SameTracks() ) continue;
-    AliDielectronPair candidate;
-    candidate.SetKFUsage(fUseKF);
     candidate.SetTracks(&fTrackRotator->GetKFTrackP(), &fTrackRotator->GetKFTrackN(),
                         fTrackRotator->GetVTrackP(),fTrackRotator->GetVTrackN());
     candidate.SetType(kEv1PMRot);
@@ -1475,11 +1757,91 @@ void AliDielectron::FillPairArrayTR()
       if (fHistoArray) fHistoArray->Fill((Int_t)kEv1PMRot,&candidate);
 
       if(fHistos) FillHistogramsPair(&candidate);
-      if(fStoreRotatedPairs) PairArray(kEv1PMRot)->Add(new AliDielectronPair(candidate));
+      if(fStoreRotatedPairs) {
+        AliDielectronPair *pair=PooledPair();
+        *pair=candidate;
+        PairArray(kEv1PMRot)->Add(pair);
+        ++fNPooledPairs;
+      }
+    }
+  }
+}
+
+//________________________________________________________________
+AliDielectronPair* AliDielectron::PooledPair()
+{
+  //
+  // next free pair of the pool, it stays free until fNPooledPairs is increased
+  // all entries are released by ClearArrays
+  //
+  if (!fPairPool) {
+    fPairPool=new TObjArray(100);
+    fPairPool->SetOwner();
+  }
+  AliDielectronPair *pair=static_cast<AliDielectronPair*>(fPairPool->At(fNPooledPairs));
+  if (!pair) {
+    pair=new AliDielectronPair;
+    fPairPool->AddAtAndExpand(pair,fNPooledPairs);
+  }
+  return pair;
+}
+
+//________________________________________________________________
+void AliDielectron::CopyPairArraysForExport()
+{
+  //
+  // copy the pair candidates of the event out of the pair pool into owning arrays
+  // (GetExportPairArraysPointer) for output written to file or kept beyond the event;
+  // the ownership of the arrays is streamed, the pooled arrays must not be written out
+  //
+  if (!fExportPairCandidates) {
+    fExportPairCandidates=new TObjArray(11);
+    fExportPairCandidates->SetOwner();
+    for (Int_t i=0;i<11;++i){
+      TObjArray *arr=new TObjArray;
+      arr->SetOwner();
+      fExportPairCandidates->AddAt(arr,i);
+    }
+  }
+  for (Int_t i=0;i<11;++i){
+    TObjArray *arr=static_cast<TObjArray*>(fExportPairCandidates->UncheckedAt(i));
+    arr->Delete();
+    const TObjArray *pairs=PairArray(i);
+    if (!pairs) continue;
+    const Int_t npairs=pairs->GetEntriesFast();
+    for (Int_t ipair=0;ipair<npairs;++ipair){
+      arr->Add(new AliDielectronPair(*static_cast<AliDielectronPair*>(pairs->UncheckedAt(ipair))));
     }
   }
 }
 
+//________________________________________________________________
+void AliDielectron::SetPairPreSelection(Double_t minMass, Double_t maxMass, Double_t minOpeningAngle/*=0.*/, Double_t maxOpeningAngle/*=-1.*/)
+{
+  //
+  // reject pairs on the leg four-momenta before the KF pair is built, the cuts, CF and QA do not see them
+  // mass and opening angle are computed without vertex fit, the windows should be looser than the pair cuts
+  // maxMass or maxOpeningAngle <0: no upper limit
+  //
+  fPairPreSelection=kTRUE;
+  fPairPreSelMass[0]=minMass;
+  fPairPreSelMass[1]=maxMass;
+  fPairPreSelOpAngle[0]=minOpeningAngle;
+  fPairPreSelOpAngle[1]=maxOpeningAngle;
+}
+
+//________________________________________________________________
+void AliDielectron::SetPreFilterPreSelection(Double_t maxMass, Double_t maxOpeningAngle/*=-1.*/)
+{
+  //
+  // only pairs below maxMass and maxOpeningAngle (leg four-momenta) are tested by the pair prefilters
+  // maxOpeningAngle <0: no limit
+  //
+  fPreFilterPreSelection=kTRUE;
+  fPreFilterPreSelMass=maxMass;
+  fPreFilterPreSelOpAngle=maxOpeningAngle;
+}
+
 //________________________________________________________________
 void AliDielectron::FillDebugTree()
 {
@@ -2017,6 +2379,8 @@ void AliDielectron::FillHistogramsFromPairArray(Bool_t pairInfoOnly/*=kFALSE*/)
   // Fill Histogram information for tracks and pairs
   //
 
+  AliDielectronVarContextScope varContext(fVarContext);
+
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
   AliDielectronVarManager::SetFillMap(fUsedVars);
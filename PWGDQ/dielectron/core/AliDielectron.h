@@ -16,6 +16,8 @@
 //#####################################################
 
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TObjArray.h>
 #include <THnBase.h>
@@ -38,6 +40,7 @@ class AliDielectronTrackRotator;
 class AliDielectronPair;
 class AliDielectronSignalMC;
 class AliDielectronMixingHandler;
+class AliDielectronVarContext;
 
 //________________________________________________________________
 class AliDielectron : public TNamed {
@@ -89,7 +92,11 @@ public:
   const TObjArray* GetPairArray(Int_t i)  const {return (i>=0&&i<11)?
       static_cast<TObjArray*>(fPairCandidates->UncheckedAt(i)):0;}
 
+  // the pairs in the pair arrays belong to the pair pool and are reused in the next event;
+  // output which is written to file or kept beyond the event uses the owning export copies
   TObjArray** GetPairArraysPointer() { return &fPairCandidates; }
+  void CopyPairArraysForExport();
+  TObjArray** GetExportPairArraysPointer() { return &fExportPairCandidates; }
   void SetPairArraysPointer( TObjArray *arr) { fPairCandidates=arr; }
   void SetHistogramArray(AliDielectronHF * const histoarray) { fHistoArray=histoarray; }
   const TObjArray * GetHistogramArray() const { return fHistoArray?fHistoArray->GetHistArray():0x0; }
@@ -107,6 +114,10 @@ public:
   Bool_t HasCandidatesTR() const {return GetPairArray(10)?GetPairArray(10)->GetEntriesFast()>0:0;}
   void SetCFManagerPair(AliDielectronCF * const cf) { fCfManagerPair=cf; }
   AliDielectronCF* GetCFManagerPair() const { return fCfManagerPair; }
+  AliDielectronVarContext* GetVarContext() const { return fVarContext; }
+  TBits* GetRequiredVars() const { return fRequiredVars; }
+  void SetVarCaching(Bool_t cache=kTRUE);
+  void SetVarProfiling(Bool_t prof=kTRUE);
 
   void SetPreFilterEventPlane(Bool_t setValue=kTRUE){fPreFilterEventPlane=setValue;};
   void SetLikeSignSubEvents(Bool_t setValue=kTRUE){fLikeSignSubEvents=setValue;};
@@ -122,6 +133,9 @@ public:
   void SetPreFilterAllSigns2(Bool_t setValue=kTRUE){fPreFilterAllSigns2=setValue;};
   void SetPreFilterPhotons2(Bool_t setValue=kTRUE){fPreFilterPhotons2=setValue;};
   void SetPreFilterOnlyOnePair2(Bool_t setValue=kTRUE){fPreFilterOnlyOnePair2=setValue;};
+  // loose windows on the leg four-momenta (no vertex fit), checked before the pair is built
+  void SetPairPreSelection(Double_t minMass, Double_t maxMass, Double_t minOpeningAngle=0., Double_t maxOpeningAngle=-1.);
+  void SetPreFilterPreSelection(Double_t maxMass, Double_t maxOpeningAngle=-1.);
 
   void SetTrackRotator(AliDielectronTrackRotator * const rot) { fTrackRotator=rot; }
   AliDielectronTrackRotator* GetTrackRotator() const { return fTrackRotator; }
@@ -223,6 +237,8 @@ private:
                                   //  Streaming and merging should be handled
                                   //  by the analysis framework
   TBits *fUsedVars;               // used variables
+  AliDielectronVarContext *fVarContext; //! event information of the variable manager for this instance
+  TBits *fRequiredVars;           //! variables needed by cuts, histograms, CF, mixing and debug tree (set in Init)
 
   TObjArray fTracks[4];           //! Selected track candidates
                                   //  0: Event1, positive particles
@@ -258,6 +274,19 @@ private:
   Bool_t fDontClearArrays;      //Don't clear the arrays at the end of the Process function, needed for external use of pair and tracks
   Bool_t fEventProcess;         //Process event (or pair array)
   Bool_t fUseGammaTracks;       // use function SetGammaTracks for MCtruth photons
+  Bool_t fPairPreSelection;     // pre-select pairs on the leg kinematics in FillPairArrays
+  Double_t fPairPreSelMass[2];      // mass window of the pair pre-selection
+  Double_t fPairPreSelOpAngle[2];   // opening angle window of the pair pre-selection (max<0: no limit)
+  Bool_t fPreFilterPreSelection;    // pre-select pairs on the leg kinematics in the pair prefilter
+  Double_t fPreFilterPreSelMass;    // maximum mass of the prefilter pre-selection
+  Double_t fPreFilterPreSelOpAngle; // maximum opening angle of the prefilter pre-selection (<0: no limit)
+
+  TObjArray *fPairPool;         //! pair candidates reused from event to event, owner of the pairs in the pair arrays
+  Int_t fNPooledPairs;          //! pool entries in use in the current event
+  TObjArray *fExportPairCandidates; //! owning copies of the pair arrays, see CopyPairArraysForExport
+  TObjArray fPairTracks[2];     //! track arrays of FillPairArrays after the pair prefilter
+  std::vector<Double_t> fLegKinematics[2]; //! packed px, py, pz, p of the legs
+  Bool_t fMCConnected;          //! MC event connected for the current event
 
   void FillTrackArrays(AliVEvent * const ev, Int_t eventNr=0);
   void EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTracks1, TObjArray arrTracks2, const AliVEvent *ev);
@@ -271,6 +300,7 @@ private:
   void ClearArrays();
 
   TObjArray* PairArray(Int_t i);
+  AliDielectronPair* PooledPair();
   TObject* InitEffMap(TString filename, TString generatedname, TString foundname);
 
   static const char* fgkTrackClassNames[4];   //Names for track arrays
@@ -297,7 +327,7 @@ private:
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,17);
+  ClassDef(AliDielectron,21);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
@@ -307,9 +337,9 @@ inline void AliDielectron::InitPairCandidateArrays()
   //
   fPairCandidates->SetOwner();
   for (Int_t i=0;i<11;++i){
+    // the pairs are owned by the pair pool
     TObjArray *arr=new TObjArray;
     fPairCandidates->AddAt(arr,i);
-    arr->SetOwner();
   }
 }
 
@@ -330,8 +360,9 @@ inline void AliDielectron::ClearArrays()
     fTracks[i].Clear();
   }
   for (Int_t i=0;i<11;++i){
-    if (PairArray(i)) PairArray(i)->Delete();
+    if (PairArray(i)) PairArray(i)->Clear();
   }
+  fNPooledPairs=0;
 }
 
 #endif
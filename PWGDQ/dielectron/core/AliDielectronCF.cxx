@@ -75,7 +75,8 @@ AliDielectronCF::AliDielectronCF() :
   fSignalsMC(0x0),
   fCfContainer(0x0),
   fHasMC(kFALSE),
-  fNAddSteps(0)
+  fNAddSteps(0),
+  fVarContext(0x0)
 {
   //
   // Default constructor
@@ -116,7 +117,8 @@ AliDielectronCF::AliDielectronCF(const char* name, const char* title) :
   fSignalsMC(0x0),
   fCfContainer(0x0),
   fHasMC(kFALSE),
-  fNAddSteps(0)
+  fNAddSteps(0),
+  fVarContext(0x0)
 {
   //
   // Named constructor
@@ -455,6 +457,7 @@ void AliDielectronCF::Fill(UInt_t mask, const AliDielectronPair *particle)
   }
   
   Double_t valuesPair[AliDielectronVarManager::kNMaxValues];
+  AliDielectronVarContextScope varContext(fVarContext);
   AliDielectronVarManager::SetFillMap(fUsedVars);
   AliDielectronVarManager::Fill(particle,valuesPair);
 
@@ -656,6 +659,7 @@ void AliDielectronCF::FillMC(const TObject *particle)
   if (!fStepForMCtruth) return;
   
   Double_t valuesPair[AliDielectronVarManager::kNMaxValues];
+  AliDielectronVarContextScope varContext(fVarContext);
   AliDielectronVarManager::SetFillMap(fUsedVars);
   AliDielectronVarManager::Fill(particle,valuesPair);
 
@@ -713,6 +717,7 @@ void AliDielectronCF::FillMC(Int_t label1, Int_t label2, Int_t nSignal) {
   if(sigMC->GetMothersRelation()==AliDielectronSignalMC::kSame && mLabel1!=mLabel2) return;
   if(sigMC->GetMothersRelation()==AliDielectronSignalMC::kDifferent && mLabel1==mLabel2) return;
 
+  AliDielectronVarContextScope varContext(fVarContext);
   AliDielectronVarManager::SetFillMap(fUsedVars);
   // fill the leg variables
   if (fNVarsLeg>0){
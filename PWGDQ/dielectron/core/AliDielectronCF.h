@@ -75,6 +75,8 @@ public:
   void FillMC(Int_t label1, Int_t label2, Int_t nSignal);
 
   AliCFContainer* GetContainer() const { return fCfContainer; }
+  TBits* GetUsedVars() const { return fUsedVars; }
+  void SetVarContext(AliDielectronVarContext *ctx) { fVarContext=ctx; }
   
 private:
   TBits     *fUsedVars;             // list of used variables
@@ -115,6 +117,7 @@ private:
 
   Bool_t fHasMC;                         //if MC info is available
   Int_t  fNAddSteps;                     //number of additional MC related steps per cut step
+  AliDielectronVarContext *fVarContext;  //! variable manager context used when filling (not owned, active one if 0x0)
 
   TVectorD* MakeLogBinning(Int_t nbinsX, Double_t xmin, Double_t xmax) const;
   TVectorD* MakeLinBinning(Int_t nbinsX, Double_t xmin, Double_t xmax) const;
@@ -122,7 +125,7 @@ private:
   AliDielectronCF(const AliDielectronCF &c);
   AliDielectronCF &operator=(const AliDielectronCF &c);
   
-  ClassDef(AliDielectronCF,5)  //Dielectron Correction Framework handler
+  ClassDef(AliDielectronCF,6)  //Dielectron Correction Framework handler
 };
 
 #endif
@@ -32,6 +32,9 @@ Detailed description
 #include <AliVTrack.h>
 #include <AliESDtrack.h>
 #include <AliAODTrack.h>
+#include <AliAODVertex.h>
+
+#include "AliDielectronMixedTrack.h"
 
 #include "AliDielectronEvent.h"
 
@@ -46,6 +49,7 @@ AliDielectronEvent::AliDielectronEvent() :
   fNTracksP(0),
   fNTracksN(0),
   fIsAOD(kFALSE),
+  fIsCompact(kFALSE),
   fEventData(),
   fPID(0x0),
   fPIDIndex(0)
@@ -66,6 +70,7 @@ AliDielectronEvent::AliDielectronEvent(const char* name, const char* title) :
   fNTracksP(0),
   fNTracksN(0),
   fIsAOD(kFALSE),
+  fIsCompact(kFALSE),
   fEventData(),
   fPID(0x0),
   fPIDIndex(0)
@@ -183,12 +188,70 @@ void AliDielectronEvent::SetTracks(const TObjArray &arrP, const TObjArray &arrN,
   //TODO: pair arrays
 }
 
+//______________________________________________
+void AliDielectronEvent::SetCompactTracks(const TObjArray &arrP, const TObjArray &arrN, Int_t nvars, const UShort_t *vars)
+{
+  //
+  // Store compact copies of the tracks with the values of the variables 'vars'
+  // the AliDielectronMixedTrack objects are kept and overwritten for the next event
+  //
+  fArrTrackP.Clear("C");
+  fArrTrackN.Clear("C");
+  fNTracksP=0;
+  fNTracksN=0;
+
+  Double_t values[AliDielectronVarManager::kNMaxValues];
+  for (Int_t iarr=0; iarr<2; ++iarr){
+    const TObjArray &arr=(iarr==0) ? arrP : arrN;
+    TClonesArray &arrTracks=(iarr==0) ? fArrTrackP : fArrTrackN;
+    Int_t tracks=0;
+    for (Int_t itrack=0; itrack<arr.GetEntriesFast(); ++itrack){
+      AliVTrack *track=static_cast<AliVTrack*>(arr.At(itrack));
+      if (!track) continue;
+      AliDielectronVarManager::Fill(track,values);
+      AliDielectronMixedTrack *ctrack=static_cast<AliDielectronMixedTrack*>(arrTracks.ConstructedAt(tracks));
+      ctrack->Set(track,values,nvars,vars);
+      ++tracks;
+    }
+    if (iarr==0) fNTracksP=tracks;
+    else fNTracksN=tracks;
+  }
+}
+
+//______________________________________________
+Long64_t AliDielectronEvent::GetMemorySize() const
+{
+  //
+  // approximate memory used by the stored tracks in bytes
+  // (for full copies without the memory allocated by the tracks themselves)
+  //
+  Long64_t size=sizeof(AliDielectronEvent);
+  if (fIsCompact){
+    for (Int_t i=0; i<fArrTrackP.GetEntriesFast(); ++i)
+      size+=static_cast<const AliDielectronMixedTrack*>(fArrTrackP.UncheckedAt(i))->GetMemorySize();
+    for (Int_t i=0; i<fArrTrackN.GetEntriesFast(); ++i)
+      size+=static_cast<const AliDielectronMixedTrack*>(fArrTrackN.UncheckedAt(i))->GetMemorySize();
+    return size;
+  }
+  const Long64_t trackSize=fIsAOD ? sizeof(AliAODTrack) : sizeof(AliESDtrack);
+  size+=(fArrTrackP.GetEntriesFast()+fArrTrackN.GetEntriesFast())*trackSize;
+  size+=fArrVertex.GetEntriesFast()*sizeof(AliAODVertex);
+  return size;
+}
+
 //______________________________________________
 void AliDielectronEvent::Clear(Option_t *opt)
 {
   //
   // clear arrays
   //
+  if (fIsCompact){
+    // the compact tracks are kept for reuse
+    fArrTrackP.Clear("C");
+    fArrTrackN.Clear("C");
+    fArrPairs.Clear(opt);
+    return;
+  }
 //   fArrTrackP.Clear(opt);
 //   fArrTrackN.Clear(opt);
 
@@ -235,6 +298,17 @@ void AliDielectronEvent::SetESD(Int_t sizeP, Int_t sizeN)
   fIsAOD=kFALSE;
 }
 
+//______________________________________________
+void AliDielectronEvent::SetCompact(Int_t sizeP, Int_t sizeN)
+{
+  //
+  // store compact tracks (AliDielectronMixedTrack), independent of the input type
+  //
+  fArrTrackP.SetClass("AliDielectronMixedTrack",sizeP);
+  fArrTrackN.SetClass("AliDielectronMixedTrack",sizeN);
+  fIsCompact=kTRUE;
+}
+
 //______________________________________________
 void AliDielectronEvent::SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues])
 {
@@ -60,6 +60,7 @@ public:
   //Analysis cuts interface
   //
   virtual Bool_t IsSelected(TObject* event);
+  TBits *GetUsedVars() const { return fUsedVars; }
   Bool_t IsSelectedESD(TObject* event);
   Bool_t IsSelectedAOD(TObject* event);
   virtual Bool_t IsSelected(TList*   /* list */ ) {return kFALSE;}
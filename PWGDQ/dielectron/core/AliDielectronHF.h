@@ -97,6 +97,7 @@ public:
   Bool_t IsPairTypeSelected(Int_t itype);
 
   Int_t GetNumberOfBins() const;
+  TBits *GetUsedVars() const { return fUsedVars; }
   const TObjArray * GetHistArray() const { return &fArrPairType; }
   Bool_t GetStepForMCGenerated()   const { return fStepGenerated; }
   Bool_t IsEventArray()           const { return fEventArray; }
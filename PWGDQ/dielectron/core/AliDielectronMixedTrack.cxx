@@ -0,0 +1,122 @@
+/*************************************************************************
+* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+///////////////////////////////////////////////////////////////////////////
+//                Dielectron MixedTrack                                  //
+//                                                                       //
+//                                                                       //
+/*
+Compact track stored in the event mixing pools instead of a full copy
+of the ESD/AOD track.
+
+The KF pair is built from position, momentum, covariance and charge,
+which are copied as they are, so mixed pairs are identical to pairs built
+from the original track. All track variables required by the
+AliDielectron instance are stored with their values at the time the
+event was pooled; AliDielectronVarManager::Fill returns these values.
+
+*/
+//                                                                       //
+///////////////////////////////////////////////////////////////////////////
+
+#include "AliDielectronMixedTrack.h"
+
+ClassImp(AliDielectronMixedTrack)
+
+AliDielectronMixedTrack::AliDielectronMixedTrack() :
+  AliVTrack(),
+  fCharge(0),
+  fLabel(-1),
+  fID(-1),
+  fStatus(0),
+  fITSClusterMap(0),
+  fNValues(0),
+  fVars(0x0),
+  fValues(0x0)
+{
+  //
+  // Default Constructor
+  //
+  for (Int_t i=0; i<3; ++i) fXYZ[i]=fV[i]=fP[i]=0.;
+  for (Int_t i=0; i<21; ++i) fCov[i]=0.;
+}
+
+//______________________________________________
+AliDielectronMixedTrack::~AliDielectronMixedTrack()
+{
+  //
+  // Default Destructor
+  //
+  delete [] fVars;
+  delete [] fValues;
+}
+
+//______________________________________________
+void AliDielectronMixedTrack::Set(const AliVTrack *track, const Double_t *values, Int_t nvars, const UShort_t *vars)
+{
+  //
+  // copy the track parameters and the values of the variables 'vars'
+  // the value arrays are only reallocated if the number of variables changes
+  //
+  track->GetXYZ(fXYZ);
+  track->XvYvZv(fV);
+  track->PxPyPz(fP);
+  track->GetCovarianceXYZPxPyPz(fCov);
+  fCharge        = track->Charge();
+  fLabel         = track->GetLabel();
+  fID            = track->GetID();
+  fStatus        = track->GetStatus();
+  fITSClusterMap = track->GetITSClusterMap();
+
+  if (nvars!=fNValues){
+    delete [] fVars;
+    delete [] fValues;
+    fVars   = nvars>0 ? new UShort_t[nvars] : 0x0;
+    fValues = nvars>0 ? new Double_t[nvars] : 0x0;
+    fNValues=nvars;
+  }
+  for (Int_t i=0; i<fNValues; ++i){
+    fVars[i]=vars[i];
+    fValues[i]=values[vars[i]];
+  }
+}
+
+//______________________________________________
+void AliDielectronMixedTrack::FillValues(Double_t * const values) const
+{
+  //
+  // copy the stored variables to the array
+  //
+  for (Int_t i=0; i<fNValues; ++i) values[fVars[i]]=fValues[i];
+}
+
+//______________________________________________
+Bool_t AliDielectronMixedTrack::GetCovarianceXYZPxPyPz(Double_t cv[21]) const
+{
+  //
+  // covariance matrix of the original track
+  //
+  for (Int_t i=0; i<21; ++i) cv[i]=fCov[i];
+  return kTRUE;
+}
+
+//______________________________________________
+Long64_t AliDielectronMixedTrack::GetMemorySize() const
+{
+  //
+  // memory used by this track in bytes
+  //
+  return sizeof(AliDielectronMixedTrack)+fNValues*(sizeof(UShort_t)+sizeof(Double_t));
+}
@@ -0,0 +1,91 @@
+#ifndef ALIDIELECTRONMIXEDTRACK_H
+#define ALIDIELECTRONMIXEDTRACK_H
+
+/* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//#############################################################
+//#                                                           #
+//#         Class AliDielectronMixedTrack                     #
+//#                                                           #
+//#  Compact copy of a track for the event mixing pools:     #
+//#  the parameters needed to build the KF pair (position,    #
+//#  momentum, covariance, charge) and the values of the      #
+//#  track variables required by the pair cuts, histograms    #
+//#  and CF. AliDielectronVarManager::Fill copies the stored  #
+//#  values back instead of recomputing them.                 #
+//#                                                           #
+//#############################################################
+
+#include <TMath.h>
+
+#include <AliVTrack.h>
+
+class AliVVertex;
+
+class AliDielectronMixedTrack : public AliVTrack {
+public:
+  AliDielectronMixedTrack();
+  virtual ~AliDielectronMixedTrack();
+
+  void Set(const AliVTrack *track, const Double_t *values, Int_t nvars, const UShort_t *vars);
+  void FillValues(Double_t * const values) const;
+  Int_t GetNValues() const { return fNValues; }
+  Long64_t GetMemorySize() const;
+
+  // kinematics
+  virtual Double_t Px() const { return fP[0]; }
+  virtual Double_t Py() const { return fP[1]; }
+  virtual Double_t Pz() const { return fP[2]; }
+  virtual Double_t Pt() const { return TMath::Sqrt(fP[0]*fP[0]+fP[1]*fP[1]); }
+  virtual Double_t P()  const { return TMath::Sqrt(fP[0]*fP[0]+fP[1]*fP[1]+fP[2]*fP[2]); }
+  virtual Bool_t   PxPyPz(Double_t p[3]) const { p[0]=fP[0]; p[1]=fP[1]; p[2]=fP[2]; return kTRUE; }
+
+  virtual Double_t Xv() const { return fV[0]; }
+  virtual Double_t Yv() const { return fV[1]; }
+  virtual Double_t Zv() const { return fV[2]; }
+  virtual Bool_t   XvYvZv(Double_t x[3]) const { x[0]=fV[0]; x[1]=fV[1]; x[2]=fV[2]; return kTRUE; }
+
+  virtual Double_t OneOverPt() const { return Pt()>0. ? 1./Pt() : 0.; }
+  virtual Double_t Phi()   const { return TMath::Pi()+TMath::ATan2(-fP[1],-fP[0]); }
+  virtual Double_t Theta() const { return TMath::ATan2(Pt(),fP[2]); }
+  virtual Double_t E()     const { return -999.; }
+  virtual Double_t M()     const { return -999.; }
+  virtual Double_t Eta()   const { return -TMath::Log(TMath::Tan(0.5*Theta())); }
+  virtual Double_t Y()     const { return -999.; }
+
+  virtual Short_t Charge()   const { return fCharge; }
+  virtual Int_t   GetLabel() const { return fLabel; }
+  virtual Int_t   PdgCode()  const { return 0; }
+  virtual const Double_t *PID() const { return 0x0; }
+
+  // track interface
+  virtual Int_t   GetID() const { return fID; }
+  virtual UChar_t GetITSClusterMap() const { return fITSClusterMap; }
+  virtual ULong_t GetStatus() const { return fStatus; }
+  virtual Bool_t  GetXYZ(Double_t *p) const { p[0]=fXYZ[0]; p[1]=fXYZ[1]; p[2]=fXYZ[2]; return kTRUE; }
+  virtual Bool_t  GetCovarianceXYZPxPyPz(Double_t cv[21]) const;
+  virtual Bool_t  PropagateToDCA(const AliVVertex*, Double_t, Double_t, Double_t*, Double_t*) { return kFALSE; }
+
+private:
+  Double_t fXYZ[3];        // track position (GetXYZ)
+  Double_t fV[3];          // track vertex (XvYvZv)
+  Double_t fP[3];          // momentum
+  Double_t fCov[21];       // covariance in x, y, z, px, py, pz
+  Short_t  fCharge;        // charge
+  Int_t    fLabel;         // MC label
+  Int_t    fID;            // track ID
+  ULong_t  fStatus;        // status flags
+  UChar_t  fITSClusterMap; // ITS cluster map
+
+  Int_t     fNValues;      // number of stored variables
+  UShort_t *fVars;         //[fNValues] variable indices
+  Double_t *fValues;       //[fNValues] variable values
+
+  AliDielectronMixedTrack(const AliDielectronMixedTrack &c);
+  AliDielectronMixedTrack &operator=(const AliDielectronMixedTrack &c);
+
+  ClassDef(AliDielectronMixedTrack,1)         // Compact track for event mixing
+};
+
+#endif
@@ -36,6 +36,9 @@ Detailed description
 #include "AliDielectronHelper.h"
 #include "AliDielectronHistos.h"
 #include "AliDielectronEvent.h"
+#include "AliDielectronVarCuts.h"
+#include "AliDielectronCutGroup.h"
+#include "AliDielectronPairLegCuts.h"
 
 #include "AliDielectronMixingHandler.h"
 
@@ -50,7 +53,11 @@ AliDielectronMixingHandler::AliDielectronMixingHandler() :
   fMixIncomplete(kTRUE),
   fMoveToSameVertex(kFALSE),
   fSkipFirstEvt(kFALSE),
-  fPID(0x0)
+  fCompactPools(kFALSE),
+  fPID(0x0),
+  fCompactState(-1),
+  fCompactPossible(kFALSE),
+  fCompactVars()
 {
   //
   // Default Constructor
@@ -71,7 +78,11 @@ AliDielectronMixingHandler::AliDielectronMixingHandler(const char* name, const c
   fMixIncomplete(kTRUE),
   fMoveToSameVertex(kFALSE),
   fSkipFirstEvt(kFALSE),
-  fPID(0x0)
+  fCompactPools(kFALSE),
+  fPID(0x0),
+  fCompactState(-1),
+  fCompactPossible(kFALSE),
+  fCompactVars()
 {
   //
   // Named Constructor
@@ -148,6 +159,134 @@ void AliDielectronMixingHandler::AddVariable(AliDielectronVarManager::ValueTypes
   fAxes.Add(bins);
 }
 
+//______________________________________________
+void AliDielectronMixingHandler::AddUsedVars(TBits *vars) const
+{
+  //
+  // add the event variables of the mixing binning
+  //
+  for (Int_t i=0; i<fAxes.GetEntriesFast(); ++i) vars->SetBitNumber(fEventCuts[i]);
+}
+
+//______________________________________________
+void AliDielectronMixingHandler::InitCompactPools(const AliDielectron *diele)
+{
+  //
+  // check if compact tracks can be used and collect the track variables to store with them.
+  // Mixed tracks are combined by the pair (pre)filters and filled by the pair CF,
+  // histograms and debug tree. This works with compact tracks if
+  //  - all cuts which see the tracks are variable cuts
+  //  - no pair variable needs the full legs (pair DCA)
+  //  - no leg variable depends on the event the track is mixed into (impact parameters, TRD/TPC geometry)
+  //  - the tracks are not moved to the same vertex and no auto correlation removal is done
+  // The MC information is checked with the first pooled event.
+  //
+  fCompactPossible=kFALSE;
+  fCompactState=-1;
+  fCompactVars.clear();
+  if (!fCompactPools || !diele) return;
+
+  TBits *required=diele->GetRequiredVars();
+  if (!required || fMoveToSameVertex || diele->fACremovalIsSetted) return;
+
+  const UShort_t fullLegVars[]={AliDielectronVarManager::kPairDCAsigXY,    AliDielectronVarManager::kPairDCAsigZ,
+                                AliDielectronVarManager::kPairDCAabsXY,    AliDielectronVarManager::kPairDCAabsZ,
+                                AliDielectronVarManager::kPairLinDCAsigXY, AliDielectronVarManager::kPairLinDCAsigZ,
+                                AliDielectronVarManager::kPairLinDCAabsXY, AliDielectronVarManager::kPairLinDCAabsZ};
+  for (UInt_t i=0; i<sizeof(fullLegVars)/sizeof(fullLegVars[0]); ++i){
+    if (required->TestBitNumber(fullLegVars[i])) return;
+  }
+  // leg variables which full track copies recompute with the current event (vertex, B-field, run)
+  const UShort_t eventLegVars[]={AliDielectronVarManager::kImpactParXY,    AliDielectronVarManager::kImpactParZ,
+                                 AliDielectronVarManager::kTRDphi,         AliDielectronVarManager::kTRDeta,
+                                 AliDielectronVarManager::kTRDpidEffLeg,   AliDielectronVarManager::kTPCActiveLength,
+                                 AliDielectronVarManager::kTPCGeomLength,  AliDielectronVarManager::kInTRDacceptance};
+  for (UInt_t i=0; i<sizeof(eventLegVars)/sizeof(eventLegVars[0]); ++i){
+    if (required->TestBitNumber(eventLegVars[i])) return;
+  }
+
+  if (!CompactCompatible(diele->fPairFilter,kFALSE)) return;
+  if (!CompactCompatible(diele->fPairPreFilter1,kFALSE) || !CompactCompatible(diele->fPairPreFilterLegs1,kTRUE)) return;
+  if (!CompactCompatible(diele->fPairPreFilter2,kFALSE) || !CompactCompatible(diele->fPairPreFilterLegs2,kTRUE)) return;
+
+  for (UShort_t ivar=0; ivar<AliDielectronVarManager::kParticleMax; ++ivar){
+    if (required->TestBitNumber(ivar)) fCompactVars.push_back(ivar);
+  }
+  fCompactPossible=kTRUE;
+  AliInfo(Form("Compact mixing pools with %d track variables",(Int_t)fCompactVars.size()));
+}
+
+//______________________________________________
+Bool_t AliDielectronMixingHandler::CompactCompatible(const AliAnalysisCuts *cut, Bool_t onTracks) const
+{
+  //
+  // variable cuts take the stored values of compact tracks; other cuts are only
+  // known to work on pairs if they are variable cuts, cut groups or leg cuts
+  //
+  if (!cut) return kTRUE;
+  if (cut->InheritsFrom(AliDielectronVarCuts::Class())) return kTRUE;
+  if (cut->InheritsFrom(AliDielectronCutGroup::Class())) {
+    AliDielectronCutGroup *group=const_cast<AliDielectronCutGroup*>(static_cast<const AliDielectronCutGroup*>(cut));
+    for (Int_t i=0; i<group->GetNCuts(); ++i){
+      if (!CompactCompatible(group->GetCut(i),onTracks)) return kFALSE;
+    }
+    return kTRUE;
+  }
+  if (!onTracks && cut->InheritsFrom(AliDielectronPairLegCuts::Class())) {
+    AliDielectronPairLegCuts *legCuts=const_cast<AliDielectronPairLegCuts*>(static_cast<const AliDielectronPairLegCuts*>(cut));
+    return CompactCompatible(legCuts->GetLeg1Filter(),kTRUE) && CompactCompatible(legCuts->GetLeg2Filter(),kTRUE);
+  }
+  return kFALSE;
+}
+
+//______________________________________________
+Bool_t AliDielectronMixingHandler::CompactCompatible(const AliAnalysisFilter &filter, Bool_t onTracks) const
+{
+  //
+  // check all cuts of a filter
+  //
+  TIter next(filter.GetCuts());
+  while (AliAnalysisCuts *cut=static_cast<AliAnalysisCuts*>(next())){
+    if (!CompactCompatible(cut,onTracks)) return kFALSE;
+  }
+  return kTRUE;
+}
+
+//______________________________________________
+Long64_t AliDielectronMixingHandler::GetPoolMemory(Int_t bin) const
+{
+  //
+  // approximate memory used by the events stored in the pool of mixing bin 'bin' in bytes
+  //
+  const TClonesArray *poolp=static_cast<const TClonesArray*>(fArrPools.At(bin));
+  if (!poolp) return 0;
+  Long64_t size=0;
+  for (Int_t i=0; i<poolp->GetEntriesFast(); ++i){
+    const AliDielectronEvent *event=static_cast<const AliDielectronEvent*>(poolp->UncheckedAt(i));
+    if (event) size+=event->GetMemorySize();
+  }
+  return size;
+}
+
+//______________________________________________
+void AliDielectronMixingHandler::Print(Option_t */*option*/) const
+{
+  //
+  // print the pool format and the memory used per mixing bin
+  //
+  printf("AliDielectronMixingHandler %s: %s track copies, depth %d\n",GetName(),
+         fCompactState==1 ? "compact" : (fCompactState==0 ? "full" : "undecided"),fDepth);
+  Long64_t total=0;
+  for (Int_t bin=0; bin<fArrPools.GetEntriesFast(); ++bin){
+    const TClonesArray *poolp=static_cast<const TClonesArray*>(fArrPools.At(bin));
+    if (!poolp) continue;
+    const Long64_t size=GetPoolMemory(bin);
+    total+=size;
+    printf("  bin %5d: %3d events, %10.1f kB\n",bin,poolp->GetEntriesFast(),size/1024.);
+  }
+  printf("  total: %.1f MB\n",total/1024./1024.);
+}
+
 //______________________________________________
 void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
 {
@@ -169,6 +308,12 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
     return;
   }
 
+  // the pool format is fixed with the first pooled event; no MC information for compact tracks
+  if (fCompactState<0) {
+    fCompactState=(fCompactPossible && !diele->fMCConnected) ? 1 : 0;
+    if (fCompactPools && fCompactState==0) AliWarning("Compact mixing pools not possible with this configuration, storing full track copies");
+  }
+
   // get mixing pool, create it if it does not yet exist.
   TClonesArray *poolp=static_cast<TClonesArray*>(fArrPools.At(bin));
 
@@ -198,7 +343,9 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
     AliDebug(10,Form("new event at %d: %d",bin,index1));
      //printf("new event at %d: %d\n",bin,index1);
     event = new(pool[index1]) AliDielectronEvent();
-    if(ev->IsA() == AliAODEvent::Class()) {
+    if (fCompactState==1) {
+      event->SetCompact(diele->GetTrackArray(0)->GetEntriesFast(),diele->GetTrackArray(1)->GetEntriesFast());
+    } else if(ev->IsA() == AliAODEvent::Class()) {
       event->SetAOD(diele->GetTrackArray(0)->GetEntriesFast(),diele->GetTrackArray(1)->GetEntriesFast());
     } else {
         event->SetESD(diele->GetTrackArray(0)->GetEntriesFast(),diele->GetTrackArray(1)->GetEntriesFast());
@@ -209,8 +356,18 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
      //printf("use event at %d: %d\n",bin,index1);
   }
   
-  event->SetTracks(*diele->GetTrackArray(0), *diele->GetTrackArray(1), *diele->GetPairArray(1));
+  if (event->IsCompact()) {
+    // store the values of the tracks as they are used for the pairing
+    TBits *fillMap=AliDielectronVarManager::GetContext()->GetFillMap();
+    AliDielectronVarManager::SetFillMap(diele->GetRequiredVars());
+    event->SetCompactTracks(*diele->GetTrackArray(0), *diele->GetTrackArray(1), (Int_t)fCompactVars.size(), fCompactVars.empty() ? 0x0 : &fCompactVars[0]);
+    AliDielectronVarManager::SetFillMap(fillMap);
+  } else {
+    event->SetTracks(*diele->GetTrackArray(0), *diele->GetTrackArray(1), *diele->GetPairArray(1));
+  }
   event->SetEventData(AliDielectronVarManager::GetData());
+  // the pool tracks were overwritten in place
+  AliDielectronVarManager::ResetCache();
 
   //set current event position in ring buffer
   pool.SetUniqueID(index1);
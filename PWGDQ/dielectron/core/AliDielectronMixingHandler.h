@@ -13,6 +13,8 @@
 //#                                                           #
 //#############################################################
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TObjArray.h>
 #include <TClonesArray.h>
@@ -22,6 +24,9 @@
 class AliDielectron;
 class AliVTrack;
 class AliVEvent;
+class TBits;
+class AliAnalysisCuts;
+class AliAnalysisFilter;
 
 class AliDielectronMixingHandler : public TNamed {
 public:
@@ -55,6 +60,14 @@ public:
 
   void SetSkipFirstEvent(Bool_t skip) { fSkipFirstEvt=skip; }
 
+  // store only the track parameters and variables needed for the pairing instead of full track copies
+  void SetCompactPools(Bool_t compact=kTRUE) { fCompactPools=compact; }
+  Bool_t GetCompactPools() const { return fCompactPools; }
+  Bool_t UseCompactPools() const { return fCompactState==1; }
+
+  Long64_t GetPoolMemory(Int_t bin) const;
+  virtual void Print(Option_t *option="") const;
+
   Int_t GetNumberOfBins() const;
   Int_t FindBin(const Double_t values[], TString *dim=0x0);
   void Fill(const AliVEvent *ev, AliDielectron *diele);
@@ -62,6 +75,8 @@ public:
   Bool_t MixRemaining(AliDielectron *diele, Int_t ipool);
 
   void Init(const AliDielectron *diele=0x0);
+  void AddUsedVars(TBits *vars) const;
+  void InitCompactPools(const AliDielectron *diele);
   static void MoveToSameVertex(AliVTrack * const vtrack, const Double_t vFirst[3], const Double_t vMix[3]);
 
 private:
@@ -76,16 +91,22 @@ private:
   Bool_t fMixIncomplete;  // whether to mix uncomplete bins at the end of the processing
   Bool_t fMoveToSameVertex; //whether to move the mixed tracks to the same vertex position
   Bool_t fSkipFirstEvt;   //whether to skip the first event in the pool
+  Bool_t fCompactPools;   //whether to store compact tracks in the pools
 
   TProcessID *fPID;             //! internal PID for references to buffered objects
-  
+  Int_t fCompactState;          //! -1: not yet decided, 0: full track copies, 1: compact tracks
+  Bool_t fCompactPossible;      //! the configuration allows compact tracks
+  std::vector<UShort_t> fCompactVars; //! track variables stored with the compact tracks
+
   void DoMixing(TClonesArray &pool, AliDielectron *diele);
+  Bool_t CompactCompatible(const AliAnalysisCuts *cut, Bool_t onTracks) const;
+  Bool_t CompactCompatible(const AliAnalysisFilter &filter, Bool_t onTracks) const;
 
   AliDielectronMixingHandler(const AliDielectronMixingHandler &c);
   AliDielectronMixingHandler &operator=(const AliDielectronMixingHandler &c);
 
   
-  ClassDef(AliDielectronMixingHandler,1)         // Dielectron MixingHandler
+  ClassDef(AliDielectronMixingHandler,2)         // Dielectron MixingHandler
 };
 
 
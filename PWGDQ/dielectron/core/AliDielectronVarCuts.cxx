@@ -44,7 +44,8 @@ AliDielectronVarCuts::AliDielectronVarCuts() :
   fActiveCutsMask(0),
   fSelectedCutsMask(0),
   fCutOnMCtruth(kFALSE),
-  fCutType(kAll)
+  fCutType(kAll),
+  fVarContext(0x0)
 {
   //
   // Default costructor
@@ -68,7 +69,8 @@ AliDielectronVarCuts::AliDielectronVarCuts(const char* name, const char* title)
   fActiveCutsMask(0),
   fSelectedCutsMask(0),
   fCutOnMCtruth(kFALSE),
-  fCutType(kAll)
+  fCutType(kAll),
+  fVarContext(0x0)
 {
   //
   // Named contructor
@@ -115,6 +117,7 @@ Bool_t AliDielectronVarCuts::IsSelected(TObject* track)
 
   //Fill values
   Double_t values[AliDielectronVarManager::kNMaxValues];
+  AliDielectronVarContextScope varContext(fVarContext);
   AliDielectronVarManager::SetFillMap(fUsedVars);
   AliDielectronVarManager::Fill(track,values);
   Double_t opResultValue = 0.;
@@ -53,12 +53,14 @@ public:
   // setters
   void    SetCutOnMCtruth(Bool_t mc=kTRUE) { fCutOnMCtruth=mc; }
   void    SetCutType(CutType type)         { fCutType=type;    }
+  void    SetVarContext(AliDielectronVarContext *ctx) { fVarContext=ctx; }
 
   // getters
   Bool_t  GetCutOnMCtruth() const { return fCutOnMCtruth; }
   CutType GetCutType()      const { return fCutType;      }
 
   Int_t GetNCuts() { return fNActiveCuts; }
+  TBits *GetUsedVars() const { return fUsedVars; }
 
   //
   //Analysis cuts interface
@@ -93,6 +95,8 @@ public:
 
   CutType  fCutType;                          // type of the cut: any, all
 
+  AliDielectronVarContext *fVarContext;       //! variable manager context used in IsSelected (not owned, active one if 0x0)
+
   Double_t fCutMin[AliDielectronVarManager::kNMaxValues];           // minimum values for the cuts
   Double_t fCutMax[AliDielectronVarManager::kNMaxValues];           // maximum values for the cuts
   Bool_t fCutExclude[AliDielectronVarManager::kNMaxValues];         // inverse cut logic?
@@ -103,7 +107,7 @@ public:
   AliDielectronVarCuts(const AliDielectronVarCuts &c);
   AliDielectronVarCuts &operator=(const AliDielectronVarCuts &c);
 
-  ClassDef(AliDielectronVarCuts,6)         //Cut class providing cuts to all infomation available for the AliVParticle interface
+  ClassDef(AliDielectronVarCuts,7)         //Cut class providing cuts to all infomation available for the AliVParticle interface
 };
 
 
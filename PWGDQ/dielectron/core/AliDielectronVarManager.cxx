@@ -22,9 +22,12 @@
 //                                                                       //
 ///////////////////////////////////////////////////////////////////////////
 
+#include <TTimeStamp.h>
+
 #include "AliDielectronVarManager.h"
 
 ClassImp(AliDielectronVarManager)
+ClassImp(AliDielectronVarContext)
 
 const char* AliDielectronVarManager::fgkParticleNames[AliDielectronVarManager::kNMaxValues][3] = {
   {"Px",                     "#it{p}_{x}",                                         "(GeV/#it{c})"},
@@ -638,14 +641,10 @@ const char* AliDielectronVarManager::fgkParticleNames[AliDielectronVarManager::k
 };
 
 AliPIDResponse* AliDielectronVarManager::fgPIDResponse      = 0x0;
-AliVEvent*      AliDielectronVarManager::fgEvent            = 0x0;
-AliEventplane*  AliDielectronVarManager::fgTPCEventPlane    = 0x0;
-AliKFVertex*    AliDielectronVarManager::fgKFVertex         = 0x0;
 TProfile*       AliDielectronVarManager::fgMultEstimatorAvg[6][9] = {{0x0}};
 TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
 TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
 TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
-TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
 TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
@@ -653,11 +652,7 @@ TString         AliDielectronVarManager::fgZDCRecenteringFile = "";
 TProfile2D*     AliDielectronVarManager::fgVZEROCalib[64] = {0x0};
 TProfile2D*     AliDielectronVarManager::fgVZERORecentering[2][2] = {{0x0,0x0},{0x0,0x0}};
 TProfile3D*     AliDielectronVarManager::fgZDCRecentering[3][2] = {{0x0,0x0},{0x0,0x0},{0x0,0x0}};
-AliDielectronQnEPcorrection* AliDielectronVarManager::fgQnEPacRemoval = 0x0;
-Bool_t          AliDielectronVarManager::fgEventPlaneACremoval = kFALSE;
-TString         AliDielectronVarManager::fgQnVectorNorm = "";
 Int_t           AliDielectronVarManager::fgCurrentRun = -1;
-Double_t        AliDielectronVarManager::fgData[AliDielectronVarManager::kNMaxValues] = {0.};
 //________________________________________________________________
 AliDielectronVarManager::AliDielectronVarManager() :
   TNamed("AliDielectronVarManager","AliDielectronVarManager")
@@ -740,3 +735,339 @@ UInt_t AliDielectronVarManager::GetValueType(const char* valname) {
   }
   return -1;
 }
+
+//________________________________________________________________
+namespace {
+  // context used by the static interface unless another one is set,
+  // and the context active in the current thread
+  // variables which are computed from other variables: {variable, input}
+  const Int_t kVarDependencies[][2] = {
+    {AliDielectronVarManager::kNclsSFracTPC,     AliDielectronVarManager::kNclsTPC},
+    {AliDielectronVarManager::kNclsSFracTPC,     AliDielectronVarManager::kNclsSTPC},
+    {AliDielectronVarManager::kNclsSFracITS,     AliDielectronVarManager::kNclsITS},
+    {AliDielectronVarManager::kNclsSFracITS,     AliDielectronVarManager::kNclsSITS},
+    {AliDielectronVarManager::kNFclsTPCfCross,   AliDielectronVarManager::kNFclsTPC},
+    {AliDielectronVarManager::kNFclsTPCfCross,   AliDielectronVarManager::kNFclsTPCr},
+    {AliDielectronVarManager::kTPCsignalNfrac,   AliDielectronVarManager::kTPCsignalN},
+    {AliDielectronVarManager::kTPCsignalNfrac,   AliDielectronVarManager::kNclsTPC},
+    {AliDielectronVarManager::kTPCclsDiff,       AliDielectronVarManager::kTPCsignalN},
+    {AliDielectronVarManager::kTPCclsDiff,       AliDielectronVarManager::kNclsTPC},
+    {AliDielectronVarManager::kTPCGeomLength,    AliDielectronVarManager::kTPCActiveLength},
+    {AliDielectronVarManager::kInTRDacceptance,  AliDielectronVarManager::kTRDeta},
+    {AliDielectronVarManager::kInTRDacceptance,  AliDielectronVarManager::kPhi},
+    {AliDielectronVarManager::kInTRDacceptance,  AliDielectronVarManager::kCharge},
+    {AliDielectronVarManager::kTRDpidEffLeg,     AliDielectronVarManager::kEta},
+    {AliDielectronVarManager::kTRDpidEffLeg,     AliDielectronVarManager::kTRDphi},
+    {AliDielectronVarManager::kTRDpidEffLeg,     AliDielectronVarManager::kPOut},
+    {AliDielectronVarManager::kEMCALE,           AliDielectronVarManager::kEMCALEoverP},
+    {AliDielectronVarManager::kEMCALE,           AliDielectronVarManager::kP},
+    {AliDielectronVarManager::kOneOverLegEff,    AliDielectronVarManager::kLegEff},
+    {AliDielectronVarManager::kOneOverPairEff,   AliDielectronVarManager::kPairEff},
+    {AliDielectronVarManager::kOneOverPairEffSq, AliDielectronVarManager::kPairEff},
+    {AliDielectronVarManager::kPairEff,          AliDielectronVarManager::kLegEff}
+  };
+  const Int_t kNVarDependencies = sizeof(kVarDependencies)/sizeof(kVarDependencies[0]);
+
+  // current time in seconds, for the fill statistics
+  Double_t Now()
+  {
+    TTimeStamp now;
+    return now.GetSec()+1.e-9*now.GetNanoSec();
+  }
+
+  AliDielectronVarContext *DefaultVarContext()
+  {
+    static AliDielectronVarContext defaultContext;
+    return &defaultContext;
+  }
+#if __cplusplus >= 201103L
+  thread_local AliDielectronVarContext *gActiveVarContext = 0x0;
+#else
+  AliDielectronVarContext *gActiveVarContext = 0x0;
+#endif
+}
+
+//________________________________________________________________
+AliDielectronVarContext* AliDielectronVarManager::GetContext()
+{
+  //
+  // Context the static interface currently acts on
+  //
+  return gActiveVarContext ? gActiveVarContext : DefaultVarContext();
+}
+
+//________________________________________________________________
+AliDielectronVarContext* AliDielectronVarManager::SetContext(AliDielectronVarContext *context)
+{
+  //
+  // Make context the active one in this thread (0x0 selects the default context),
+  // returns the previously active context
+  //
+  AliDielectronVarContext *previous=gActiveVarContext;
+  gActiveVarContext=context;
+  return previous;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::AddDependencies(TBits *vars)
+{
+  //
+  // Add the variables needed to compute the ones set in vars
+  //
+  if (!vars) return;
+  Bool_t added=kTRUE;
+  while (added) {
+    added=kFALSE;
+    for (Int_t i=0; i<kNVarDependencies; ++i) {
+      if (vars->TestBitNumber(kVarDependencies[i][0]) && !vars->TestBitNumber(kVarDependencies[i][1])) {
+        vars->SetBitNumber(kVarDependencies[i][1]);
+        added=kTRUE;
+      }
+    }
+  }
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::AddEffMapVars(const TObject *map, TBits *vars)
+{
+  //
+  // Add the variables an efficiency map is looked up in
+  //
+  if (!map || !vars) return;
+  if (map->InheritsFrom(THnBase::Class())) {
+    const THnBase *eff=static_cast<const THnBase*>(map);
+    for (Int_t idim=0; idim<eff->GetNdimensions(); ++idim) {
+      UInt_t var=GetValueType(eff->GetAxis(idim)->GetName());
+      if (var<kNMaxValues) vars->SetBitNumber(var);
+    }
+  } else if (map->IsA()==TSpline3::Class()) {
+    TSpline3 *eff=const_cast<TSpline3*>(static_cast<const TSpline3*>(map));
+    if (!eff->GetHistogram()) return;
+    UInt_t var=GetValueType(eff->GetHistogram()->GetXaxis()->GetName());
+    if (var<kNMaxValues) vars->SetBitNumber(var);
+  }
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::FillCached(AliDielectronVarContext *ctx, const TObject* object, Double_t * const values)
+{
+  //
+  // Fill with the bookkeeping of the context:
+  // a track is computed once per event for the union of the requested variables and the
+  // ones required by the owner of the context, later fills of the same track only copy the
+  // requested values from its cache entry. The cache is reset whenever the event data change.
+  // kRndm is drawn for every fill, as without the cache.
+  //
+  TBits *map=ctx->fFillMap;
+  const AliDielectronVarContext::EFillType type=AliDielectronVarContext::GetFillType(object);
+  const Bool_t cacheable=ctx->fCaching && type<=AliDielectronVarContext::kAODMCParticle;
+  Int_t entry=(cacheable ? ctx->FindCacheEntry(object) : -1);
+
+  if (entry>=0 && ctx->CacheCovers(entry,map)) {
+    const Double_t *cached=ctx->GetCacheValues(entry);
+    if (!map) {
+      memcpy(values,cached,kNMaxValues*sizeof(Double_t));
+    } else {
+      const UInt_t nbits=TMath::Min(map->GetNbits(),(UInt_t)kNMaxValues);
+      for (UInt_t i=map->FirstSetBit(); i<nbits; i=map->FirstSetBit(i+1)) values[i]=cached[i];
+    }
+    values[kRndm]=gRandom->Rndm();
+    ++ctx->fNCacheHits;
+    return;
+  }
+
+  const Double_t start=(ctx->fProfiling ? Now() : 0.);
+  if (cacheable) {
+    // compute into the cache entry, starting from the caller's values as without caching;
+    // an entry which misses variables is recomputed for the union with the ones it held
+    if (entry<0) {
+      entry=ctx->AddCacheEntry(object);
+      ctx->fCacheVars[entry].ResetAllBits();
+    }
+    TBits &vars=ctx->fCacheVars[entry];
+    ctx->fCacheAll[entry]=(map==0x0);
+    if (map) {
+      vars|=*map;
+      if (ctx->fRequiredVars) vars|=*ctx->fRequiredVars;
+      ctx->fFillMap=&vars;
+    }
+    Double_t *cached=ctx->GetCacheValues(entry);
+    memcpy(cached,values,kNMaxValues*sizeof(Double_t));
+    FillObject(object,cached);
+    ctx->fFillMap=map;
+    memcpy(values,cached,kNMaxValues*sizeof(Double_t));
+  } else {
+    FillObject(object,values);
+  }
+
+  if (!ctx->fProfiling) return;
+  ctx->fFillTime[type]+=Now()-start;
+  ++ctx->fNFills[type];
+  const TBits *computed=(cacheable ? (ctx->fCacheAll[entry] ? 0x0 : &ctx->fCacheVars[entry]) : map);
+  if (!computed) {
+    for (Int_t i=0; i<kNMaxValues; ++i) ++ctx->fNComputed[i];
+  } else {
+    const UInt_t nbits=TMath::Min(computed->GetNbits(),(UInt_t)kNMaxValues);
+    for (UInt_t i=computed->FirstSetBit(); i<nbits; i=computed->FirstSetBit(i+1)) ++ctx->fNComputed[i];
+  }
+}
+
+//________________________________________________________________
+AliDielectronVarContext::AliDielectronVarContext() :
+  TObject(),
+  fEvent(0x0),
+  fTPCEventPlane(0x0),
+  fKFVertex(0x0),
+  fFillMap(0x0),
+  fQnEPacRemoval(0x0),
+  fEventPlaneACremoval(kFALSE),
+  fQnVectorNorm(""),
+  fRequiredVars(0x0),
+  fCaching(kFALSE),
+  fCacheIndex(),
+  fNCacheEntries(0),
+  fCacheValues(),
+  fCacheMomentum(),
+  fCacheVars(),
+  fCacheAll(),
+  fProfiling(kFALSE),
+  fNCacheHits(0)
+{
+  //
+  // Default constructor
+  //
+  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues; ++i) fData[i]=0.;
+  ResetStatistics();
+}
+
+//________________________________________________________________
+AliDielectronVarContext::~AliDielectronVarContext()
+{
+  //
+  // Default destructor
+  //
+  if (gActiveVarContext==this) gActiveVarContext=0x0;
+  delete fKFVertex;
+}
+
+//________________________________________________________________
+void AliDielectronVarContext::ResetStatistics()
+{
+  //
+  // Reset the fill statistics
+  //
+  for (Int_t i=0; i<kNFillTypes; ++i) {
+    fNFills[i]=0;
+    fFillTime[i]=0.;
+  }
+  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues; ++i) fNComputed[i]=0;
+  fNCacheHits=0;
+}
+
+//________________________________________________________________
+void AliDielectronVarContext::ResetCache()
+{
+  //
+  // Forget all cached tracks, the entries keep their memory for the next event
+  //
+  if (fNCacheEntries) fCacheIndex.Delete();
+  fNCacheEntries=0;
+}
+
+//________________________________________________________________
+Int_t AliDielectronVarContext::FindCacheEntry(const TObject *object) const
+{
+  //
+  // Cache entry of a track in the current event (-1 if not cached). The momentum
+  // is compared as well, so that a track created at the address of a deleted one
+  // is not served the values of its predecessor
+  //
+  const Long64_t key=(Long64_t)object;
+  const Int_t entry=(Int_t)const_cast<TExMap&>(fCacheIndex).GetValue(key)-1;
+  if (entry<0) return -1;
+  const AliVParticle *part=static_cast<const AliVParticle*>(object);
+  const Double_t *p=&fCacheMomentum[3*entry];
+  if (p[0]!=part->Px() || p[1]!=part->Py() || p[2]!=part->Pz()) {
+    const_cast<TExMap&>(fCacheIndex).Remove(key);
+    return -1;
+  }
+  return entry;
+}
+
+//________________________________________________________________
+Int_t AliDielectronVarContext::AddCacheEntry(const TObject *object)
+{
+  //
+  // New cache entry for a track, the storage grows with the largest event seen
+  //
+  const Int_t entry=fNCacheEntries++;
+  if ((Int_t)fCacheAll.size()<fNCacheEntries) {
+    fCacheValues.resize(fNCacheEntries*AliDielectronVarManager::kNMaxValues);
+    fCacheMomentum.resize(3*fNCacheEntries);
+    fCacheVars.resize(fNCacheEntries,TBits(AliDielectronVarManager::kNMaxValues));
+    fCacheAll.resize(fNCacheEntries);
+  }
+  const AliVParticle *part=static_cast<const AliVParticle*>(object);
+  Double_t *p=&fCacheMomentum[3*entry];
+  p[0]=part->Px();
+  p[1]=part->Py();
+  p[2]=part->Pz();
+  fCacheIndex.Add((Long64_t)object,(Long64_t)entry+1);
+  return entry;
+}
+
+//________________________________________________________________
+Bool_t AliDielectronVarContext::CacheCovers(Int_t entry, const TBits *map) const
+{
+  //
+  // Whether the cache entry holds all variables requested in map (0x0: all variables)
+  //
+  if (fCacheAll[entry]) return kTRUE;
+  if (!map) return kFALSE;
+  const TBits &vars=fCacheVars[entry];
+  const UInt_t nbits=map->GetNbits();
+  for (UInt_t i=map->FirstSetBit(); i<nbits; i=map->FirstSetBit(i+1)) {
+    if (!vars.TestBitNumber(i)) return kFALSE;
+  }
+  return kTRUE;
+}
+
+//________________________________________________________________
+AliDielectronVarContext::EFillType AliDielectronVarContext::GetFillType(const TObject *object)
+{
+  //
+  // Object type for the fill statistics and the cache
+  //
+  const TClass *cl=object->IsA();
+  if (cl==AliESDtrack::Class())       return kESDtrack;
+  if (cl==AliAODTrack::Class())       return kAODTrack;
+  if (cl==AliMCParticle::Class())     return kMCParticle;
+  if (cl==AliAODMCParticle::Class())  return kAODMCParticle;
+  if (cl==AliDielectronPair::Class()) return kPair;
+  if (cl==AliKFParticle::Class())     return kKFParticle;
+  if (object->InheritsFrom(AliVEvent::Class()) || cl==AliEventplane::Class()) return kEvent;
+  return kOther;
+}
+
+//________________________________________________________________
+void AliDielectronVarContext::Print(Option_t * /*option*/) const
+{
+  //
+  // Print the fill statistics
+  //
+  static const char* typeNames[kNFillTypes]={"ESD track","AOD track","MC particle","AOD MC particle",
+                                             "pair","KF particle","event","other"};
+  printf("AliDielectronVarContext: caching %s, %lld fills served from the cache\n",
+         fCaching ? "on" : "off", fNCacheHits);
+  if (!fProfiling) return;
+  printf("  %-16s %12s %12s %12s\n","object","fills","time (s)","us/fill");
+  for (Int_t i=0; i<kNFillTypes; ++i) {
+    if (!fNFills[i]) continue;
+    printf("  %-16s %12lld %12.3f %12.3f\n",typeNames[i],fNFills[i],fFillTime[i],1.e6*fFillTime[i]/fNFills[i]);
+  }
+  printf("  %-24s %12s\n","variable","computed");
+  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues; ++i) {
+    if (!fNComputed[i]) continue;
+    printf("  %-24s %12lld\n",AliDielectronVarManager::GetValueName(i),fNComputed[i]);
+  }
+}
@@ -22,6 +22,8 @@
 //#                                                           #
 //#############################################################
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TProfile.h>
 #include <TProfile2D.h>
@@ -33,6 +35,7 @@
 #include <TDatabasePDG.h>
 #include <TKey.h>
 #include <TBits.h>
+#include <TExMap.h>
 #include <TRandom3.h>
 
 #include <AliLog.h>
@@ -69,6 +72,7 @@
 #include <AliESDtrackCuts.h>
 
 #include "AliDielectronPair.h"
+#include "AliDielectronMixedTrack.h"
 #include "AliDielectronMC.h"
 #include "AliDielectronPID.h"
 #include "AliDielectronHelper.h"
@@ -87,6 +91,7 @@
 #include "assert.h"
 
 class AliVEvent;
+class AliDielectronVarContext;
 
 //________________________________________________________________
 class AliDielectronVarManager : public TNamed {
@@ -672,6 +677,7 @@ public:
   AliDielectronVarManager(const char* name, const char* title);
   virtual ~AliDielectronVarManager();
   static void Fill(const TObject* particle, Double_t * const values);
+  static void Fill(const TObject* particle, Double_t * const values, AliDielectronVarContext *context);
   static void FillVarMCParticle2(const AliVParticle *p1, const AliVParticle *p2, Double_t * const values);
   static void FillVarVParticle(const AliVParticle *particle,         Double_t * const values);
 
@@ -682,7 +688,7 @@ public:
   static void InitTRDpidEffHistograms(const Char_t* filename);
   static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
   static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
-  static void SetFillMap(   TBits   *map) { fgFillMap=map; }
+  static void SetFillMap(   TBits   *map);
   static void SetVZEROCalibrationFile(const Char_t* filename) {fgVZEROCalibrationFile = filename;}
 
   static void SetVZERORecenteringFile(const Char_t* filename) {fgVZERORecenteringFile = filename;}
@@ -693,8 +699,8 @@ public:
   static void SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues]);
   static Bool_t GetDCA(const AliAODTrack *track, Double_t* d0z0, Double_t* covd0z0=0);
   static void SetTPCEventPlane(AliEventplane *const evplane);
-  static void SetTPCEventPlaneACremoval(AliDielectronQnEPcorrection *acCuts) {fgQnEPacRemoval = acCuts; fgEventPlaneACremoval = kTRUE;}
-  static void SetQnVectorNormalisation(TString qnNorm) {fgQnVectorNorm = qnNorm;}
+  static void SetTPCEventPlaneACremoval(AliDielectronQnEPcorrection *acCuts);
+  static void SetQnVectorNormalisation(TString qnNorm);
   static void GetVzeroRP(const AliVEvent* event, Double_t* qvec, Int_t sideOption);      // 0- V0A; 1- V0C; 2- V0A+V0C
   static void GetZDCRP(const AliVEvent* event, Double_t qvec[][2]);
   static AliAODVertex* GetVertex(const AliAODEvent *event, AliAODVertex::AODVtx_t vtype);
@@ -703,30 +709,43 @@ public:
   static Double_t GetSingleLegEff(Double_t * const values);
   static Double_t GetPairEff(Double_t * const values);
 
-  static const AliKFVertex* GetKFVertex() {return fgKFVertex;}
+  static const AliKFVertex* GetKFVertex();
 
   static const char* GetValueName(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][0]:""; }
   static const char* GetValueLabel(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][1]:""; }
   static const char* GetValueUnit(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][2]:""; }
   static UInt_t GetValueType(const char* valname);
-  static const Double_t* GetData() {return fgData;}
-  static AliVEvent* GetCurrentEvent() {return fgEvent;}
+  static const Double_t* GetData();
+  static AliVEvent* GetCurrentEvent();
+
+  static Double_t GetValue(ValueTypes var);
+  static void SetValue(ValueTypes var, Double_t val);
 
-  static Double_t GetValue(ValueTypes var) {return fgData[var];}
-  static void SetValue(ValueTypes var, Double_t val) { fgData[var]=val; }
+  // per-event state (event, vertex, event data, fill map) is kept in a context;
+  // the static interface acts on the context active in the calling thread
+  static AliDielectronVarContext* GetContext();
+  static AliDielectronVarContext* SetContext(AliDielectronVarContext *context);
+  static void ResetCache();
+
+  // add the variables the given ones are computed from, and the axis variables of an efficiency map
+  static void AddDependencies(TBits *vars);
+  static void AddEffMapVars(const TObject *map, TBits *vars);
 
 
 private:
 
   static const char* fgkParticleNames[kNMaxValues][3];  //variable names
 
-  static Bool_t Req(ValueTypes var) { return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
+  static Bool_t Req(ValueTypes var);
+  static void FillObject(const TObject* object, Double_t * const values);
+  static void FillCached(AliDielectronVarContext *ctx, const TObject* object, Double_t * const values);
   static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
   static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
   static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
   static void FillVarMCParticle(const AliMCParticle *particle,       Double_t * const values);
   static void FillVarAODMCParticle(const AliAODMCParticle *particle, Double_t * const values);
   static void FillVarDielectronPair(const AliDielectronPair *pair,   Double_t * const values);
+  static void FillVarMixedTrack(const AliDielectronMixedTrack *track, Double_t * const values);
   static void FillVarKFParticle(const AliKFParticle *pair,           Double_t * const values);
 
   static void FillVarVEvent(const AliVEvent *event,                  Double_t * const values);
@@ -741,15 +760,11 @@ private:
   static void InitZDCRecenteringHistograms(Int_t runNo);
 
   static AliPIDResponse  *fgPIDResponse;        // PID response object
-  static AliVEvent       *fgEvent;              // current event pointer
-  static AliEventplane   *fgTPCEventPlane;      // current event tpc plane pointer
-  static AliKFVertex     *fgKFVertex;           // kf vertex
   static TProfile        *fgMultEstimatorAvg[6][9];  // multiplicity estimator averages (6 periods x 18 estimators)
   static Double_t         fgTRDpidEffCentRanges[10][4];   // centrality ranges for the TRD pid efficiency histograms
   static TH3D            *fgTRDpidEff[10][4];   // TRD pid efficiencies from conversion electrons
   static TObject         *fgLegEffMap;             // single electron efficiencies
   static TObject         *fgPairEffMap;             // pair efficiencies
-  static TBits           *fgFillMap;             // map for requested variable filling
   static TString          fgVZEROCalibrationFile;  // file with VZERO channel-by-channel calibrations
   static TString          fgVZERORecenteringFile;  // file with VZERO Q-vector averages needed for event plane recentering
   static TProfile2D      *fgVZEROCalib[64];           // 1 histogram per VZERO channel
@@ -759,16 +774,11 @@ private:
   static TString          fgZDCRecenteringFile; // file with ZDC Q-vector averages needed for event plane recentering
   static TProfile3D      *fgZDCRecentering[3][2];   // 2 VZERO sides x 2 Q-vector components
 
-  static AliDielectronQnEPcorrection *fgQnEPacRemoval; //! filter for auto correlation removal within Qn Framework
-  static Bool_t fgEventPlaneACremoval;
-  static TString fgQnVectorNorm;                       // String containing the normalisation for the QnVector if the non-default AddTask is used
 
 
   static Double_t CalculateEPDiff(Double_t detArp, Double_t detBrp);
 
 
-  static Double_t fgData[kNMaxValues];        //! data
-
   AliDielectronVarManager(const AliDielectronVarManager &c);
   AliDielectronVarManager &operator=(const AliDielectronVarManager &c);
 
@@ -776,19 +786,166 @@ private:
 };
 
 
+//________________________________________________________________
+class AliDielectronVarContext : public TObject {
+  //
+  // Per-event state of AliDielectronVarManager: current event, its primary
+  // vertex and event data, TPC event plane, Qn settings and fill map.
+  // Each AliDielectron owns one, so that several instances (or threads)
+  // do not overwrite each other's event information.
+  //
+  friend class AliDielectronVarManager;
+
+public:
+  // object types for the fill statistics
+  enum EFillType { kESDtrack=0, kAODTrack, kMCParticle, kAODMCParticle, kPair, kKFParticle, kEvent, kOther, kNFillTypes };
+
+  AliDielectronVarContext();
+  virtual ~AliDielectronVarContext();
+
+  AliVEvent*         GetEvent()         const { return fEvent; }
+  AliEventplane*     GetTPCEventPlane() const { return fTPCEventPlane; }
+  const AliKFVertex* GetKFVertex()      const { return fKFVertex; }
+  TBits*             GetFillMap()       const { return fFillMap; }
+  const Double_t*    GetData()          const { return fData; }
+
+  // Each track is filled once per event for the union of the requested and the
+  // required variables; further fills of the same track in the same event copy
+  // the cached values. kRndm is not cached, it is drawn again for every fill.
+  void   SetRequiredVars(TBits *vars)  { fRequiredVars=vars; ResetCache(); }
+  TBits* GetRequiredVars()       const { return fRequiredVars; }
+  void   SetCaching(Bool_t cache=kTRUE) { fCaching=cache; ResetCache(); }
+  Bool_t GetCaching()            const { return fCaching; }
+  void   ResetCache();
+
+  // fill statistics: calls and time per object type, computations per variable
+  void     SetProfiling(Bool_t prof=kTRUE) { fProfiling=prof; }
+  Bool_t   GetProfiling()           const { return fProfiling; }
+  void     ResetStatistics();
+  Long64_t GetNFills(EFillType type)  const { return fNFills[type]; }
+  Double_t GetFillTime(EFillType type) const { return fFillTime[type]; }
+  Long64_t GetNComputed(Int_t var)    const { return fNComputed[var]; }
+  Long64_t GetNCacheHits()            const { return fNCacheHits; }
+  virtual void Print(Option_t *option="") const;
+
+private:
+  AliVEvent       *fEvent;              //! current event pointer
+  AliEventplane   *fTPCEventPlane;      //! current event tpc plane pointer
+  AliKFVertex     *fKFVertex;           //! kf vertex (owned)
+  TBits           *fFillMap;            //! map for requested variable filling (not owned)
+  AliDielectronQnEPcorrection *fQnEPacRemoval; //! filter for auto correlation removal within Qn Framework
+  Bool_t           fEventPlaneACremoval;       //! use the auto correlation removal
+  TString          fQnVectorNorm;              //! normalisation for the QnVector if the non-default AddTask is used
+  Double_t         fData[AliDielectronVarManager::kNMaxValues]; //! event data
+
+  TBits           *fRequiredVars;       //! variables needed by the owner of the context (not owned)
+  Bool_t           fCaching;            //! reuse the values of tracks filled before in the event
+  TExMap           fCacheIndex;         //! track address -> 1 + its cache entry
+  Int_t            fNCacheEntries;      //! cache entries used in the current event
+  std::vector<Double_t> fCacheValues;   //! cached values, kNMaxValues per entry
+  std::vector<Double_t> fCacheMomentum; //! px, py, pz per entry (guards against reused addresses)
+  std::vector<TBits>    fCacheVars;     //! variables held by each entry
+  std::vector<Bool_t>   fCacheAll;      //! entry holds all variables
+
+  Bool_t           fProfiling;          //! collect fill statistics
+  Long64_t         fNFills[kNFillTypes];     //! number of computations per object type
+  Double_t         fFillTime[kNFillTypes];   //! time (s) spent per object type
+  Long64_t         fNComputed[AliDielectronVarManager::kNMaxValues]; //! computations per variable
+  Long64_t         fNCacheHits;         //! fills served from the cache
+
+  Int_t  FindCacheEntry(const TObject *object) const;
+  Int_t  AddCacheEntry(const TObject *object);
+  Bool_t CacheCovers(Int_t entry, const TBits *map) const;
+  Double_t* GetCacheValues(Int_t entry) { return &fCacheValues[entry*AliDielectronVarManager::kNMaxValues]; }
+  static EFillType GetFillType(const TObject *object);
+
+  AliDielectronVarContext(const AliDielectronVarContext &c);
+  AliDielectronVarContext &operator=(const AliDielectronVarContext &c);
+
+  ClassDef(AliDielectronVarContext,3)  // per-event state of AliDielectronVarManager
+};
+
+//________________________________________________________________
+class AliDielectronVarContextScope {
+  //
+  // Makes a context the active one for the lifetime of the scope
+  // and restores the previous one afterwards; a null context
+  // leaves the active context unchanged
+  //
+public:
+  AliDielectronVarContextScope(AliDielectronVarContext *context) :
+    fPrevious(context ? AliDielectronVarManager::SetContext(context) : 0x0), fSet(context!=0x0) {}
+  ~AliDielectronVarContextScope() { if (fSet) AliDielectronVarManager::SetContext(fPrevious); }
+
+private:
+  AliDielectronVarContext *fPrevious;  // context active before the scope
+  Bool_t                   fSet;       // whether a context was installed
+
+  AliDielectronVarContextScope(const AliDielectronVarContextScope &c);
+  AliDielectronVarContextScope &operator=(const AliDielectronVarContextScope &c);
+};
+
+
 //Inline functions
+inline void AliDielectronVarManager::SetFillMap(TBits *map) { GetContext()->fFillMap=map; }
+inline void AliDielectronVarManager::SetTPCEventPlaneACremoval(AliDielectronQnEPcorrection *acCuts)
+{
+  AliDielectronVarContext *ctx=GetContext();
+  ctx->fQnEPacRemoval = acCuts;
+  ctx->fEventPlaneACremoval = kTRUE;
+}
+inline void AliDielectronVarManager::SetQnVectorNormalisation(TString qnNorm) { GetContext()->fQnVectorNorm = qnNorm; }
+inline const AliKFVertex* AliDielectronVarManager::GetKFVertex() { return GetContext()->fKFVertex; }
+inline const Double_t* AliDielectronVarManager::GetData() { return GetContext()->fData; }
+inline AliVEvent* AliDielectronVarManager::GetCurrentEvent() { return GetContext()->fEvent; }
+inline Double_t AliDielectronVarManager::GetValue(ValueTypes var) { return GetContext()->fData[var]; }
+inline void AliDielectronVarManager::SetValue(ValueTypes var, Double_t val)
+{
+  AliDielectronVarContext *ctx=GetContext();
+  ctx->fData[var]=val;
+  ctx->ResetCache();
+}
+inline void AliDielectronVarManager::ResetCache() { GetContext()->ResetCache(); }
+inline Bool_t AliDielectronVarManager::Req(ValueTypes var)
+{
+  TBits *map=GetContext()->fFillMap;
+  return (map ? map->TestBitNumber(var) : kTRUE);
+}
+
+inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * const values, AliDielectronVarContext *context)
+{
+  //
+  // Fill the variables using the event information of the given context
+  // (the active context if 0x0)
+  //
+  AliDielectronVarContextScope scope(context);
+  Fill(object, values);
+}
+
 inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * const values)
 {
   //
-  // Main function to fill all available variables according to the type of particle
+  // Main function to fill all available variables according to the type of particle;
+  // caching and fill statistics are handled by FillCached if switched on in the context
   //
   if (!object) return;
+  AliDielectronVarContext *ctx=GetContext();
+  if (ctx->fCaching || ctx->fProfiling) FillCached(ctx, object, values);
+  else                                  FillObject(object, values);
+}
+
+inline void AliDielectronVarManager::FillObject(const TObject* object, Double_t * const values)
+{
+  //
+  // Fill the variables according to the type of the object
+  //
   if      (object->IsA() == AliESDtrack::Class())       FillVarESDtrack(static_cast<const AliESDtrack*>(object), values);
   else if (object->IsA() == AliAODTrack::Class())       FillVarAODTrack(static_cast<const AliAODTrack*>(object), values);
   else if (object->IsA() == AliMCParticle::Class())     FillVarMCParticle(static_cast<const AliMCParticle*>(object), values);
   else if (object->IsA() == AliAODMCParticle::Class())  FillVarAODMCParticle(static_cast<const AliAODMCParticle*>(object), values);
   else if (object->IsA() == AliDielectronPair::Class()) FillVarDielectronPair(static_cast<const AliDielectronPair*>(object), values);
   else if (object->IsA() == AliKFParticle::Class())     FillVarKFParticle(static_cast<const AliKFParticle*>(object),values);
+  else if (object->IsA() == AliDielectronMixedTrack::Class()) FillVarMixedTrack(static_cast<const AliDielectronMixedTrack*>(object),values);
   // Main function to fill all available variables according to the type of event
 
   else if (object->IsA() == AliVEvent::Class())         FillVarVEvent(static_cast<const AliVEvent*>(object), values);
@@ -799,6 +956,17 @@ inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * cons
 //   else printf(Form("AliDielectronVarManager::Fill: Type %s is not supported by AliDielectronVarManager!", object->ClassName())); //TODO: implement without object needed
 }
 
+inline void AliDielectronVarManager::FillVarMixedTrack(const AliDielectronMixedTrack *track, Double_t * const values)
+{
+  //
+  // Fill the track variables stored with a track of the mixing pools
+  // Also fill event information from local buffer into the array
+  //
+  track->FillValues(values);
+  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
+    values[i]=GetContext()->fData[i];
+}
+
 inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *particle, Double_t * const values)
 {
   ///
@@ -846,9 +1014,9 @@ inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *partic
     }
   }
 
-//   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
+//   if ( GetContext()->fEvent ) AliDielectronVarManager::Fill(GetContext()->fEvent, values);
   for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+    values[i]=GetContext()->fData[i];
 }
 
 inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle, Double_t * const values)
@@ -954,7 +1122,8 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   values[AliDielectronVarManager::kNumberOfDaughters]=-999;
 
   AliDielectronMC *mc=AliDielectronMC::Instance();
-  if (mc->HasMC()){
+  if (mc->HasMC() && (Req(kPdgCode) || Req(kHasCocktailMother) || Req(kPdgCodeMother) || Req(kPdgCodeGrandMother) ||
+                      Req(kDistPrimToSecVtxXYMC) || Req(kDistPrimToSecVtxZMC) || Req(kNumberOfDaughters))){
     if (mc->GetMCTrack(particle)) {
       Int_t trkLbl = TMath::Abs(mc->GetMCTrack(particle)->GetLabel());
       values[AliDielectronVarManager::kPdgCode]           =mc->GetMCTrack(particle)->PdgCode();
@@ -1009,15 +1178,15 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   const AliExternalTrackParam *out=particle->GetOuterParam();
   if(out) values[AliDielectronVarManager::kPOut] = out->GetP();
   else values[AliDielectronVarManager::kPOut] = mom;
-  if(out && fgEvent) {
+  if(out && GetContext()->fEvent && (Req(kTRDphi) || Req(kTRDpidEffLeg))) {
     Double_t localCoord[3]={0.0};
-    Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)fgEvent)->GetMagneticField(), localCoord);
+    Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)GetContext()->fEvent)->GetMagneticField(), localCoord);
     values[AliDielectronVarManager::kTRDphi] = (localCoordGood && TMath::Abs(localCoord[0])>1.0e-6 && TMath::Abs(localCoord[1])>1.0e-6 ? TMath::ATan2(localCoord[1], localCoord[0]) : -999.);
   }
-  if(mc->HasMC() && fgTRDpidEff[0][0]) {
-    Int_t runNo = (fgEvent ? fgEvent->GetRunNumber() : -1);
+  if(mc->HasMC() && fgTRDpidEff[0][0] && Req(kTRDpidEffLeg)) {
+    Int_t runNo = (GetContext()->fEvent ? GetContext()->fEvent->GetRunNumber() : -1);
     Float_t centrality=-1.0;
-    AliCentrality *esdCentrality = (fgEvent ? fgEvent->GetCentrality() : 0x0);
+    AliCentrality *esdCentrality = (GetContext()->fEvent ? GetContext()->fEvent->GetCentrality() : 0x0);
     if(esdCentrality) centrality = esdCentrality->GetCentralityPercentile("V0M");
     Double_t effErr=0.0;
     values[kTRDpidEffLeg] = GetTRDpidEfficiency(runNo, centrality, values[AliDielectronVarManager::kEta],
@@ -1033,58 +1202,62 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
 
   values[AliDielectronVarManager::kTOFsignal]=particle->GetTOFsignal();
 
-  Double_t l = particle->GetIntegratedLength();  // cm
-  Double_t t = particle->GetTOFsignal();
-  Double_t t0 = fgPIDResponse->GetTOFResponse().GetTimeZero(); // ps
+  if(Req(kTOFbeta)) {
+    Double_t l = particle->GetIntegratedLength();  // cm
+    Double_t t = particle->GetTOFsignal();
+    Double_t t0 = fgPIDResponse->GetTOFResponse().GetTimeZero(); // ps
 
-  if( (l < 360. || l > 800.) || (t <= 0.) || (t0 >999990.0) ) {
-	values[AliDielectronVarManager::kTOFbeta]=0.0;
-  }
-  else {
-	t -= t0; // subtract the T0
-	l *= 0.01;  // cm ->m
-	t *= 1e-12; //ps -> s
+    if( (l < 360. || l > 800.) || (t <= 0.) || (t0 >999990.0) ) {
+      values[AliDielectronVarManager::kTOFbeta]=0.0;
+    }
+    else {
+      t -= t0; // subtract the T0
+      l *= 0.01;  // cm ->m
+      t *= 1e-12; //ps -> s
 
-	Double_t v = l / t;
-	Float_t beta = v / TMath::C();
-	values[AliDielectronVarManager::kTOFbeta]=beta;
+      Double_t v = l / t;
+      Float_t beta = v / TMath::C();
+      values[AliDielectronVarManager::kTOFbeta]=beta;
+    }
   }
   values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
 
-  values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
+  if(Req(kTOFmismProb)) values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
 
   // nsigma to Electron band
   // TODO: for the moment we set the bethe bloch parameters manually
   //       this should be changed in future!
-  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
-
-  values[AliDielectronVarManager::kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
-
-  values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron)
-                                                     -AliDielectronPID::GetCntrdCorrITS(particle)
-                                                     ) / AliDielectronPID::GetWdthCorrITS(particle);
-
-  values[AliDielectronVarManager::kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
-
-  values[AliDielectronVarManager::kTOFnSigmaEle]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
+  if(Req(kTPCnSigmaEleRaw)) values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
+  if(Req(kTPCnSigmaEle))    values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
+
+  if(Req(kTPCnSigmaPio)) values[AliDielectronVarManager::kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
+  if(Req(kTPCnSigmaMuo)) values[AliDielectronVarManager::kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
+  if(Req(kTPCnSigmaKao)) values[AliDielectronVarManager::kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
+  if(Req(kTPCnSigmaPro)) values[AliDielectronVarManager::kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
+
+  if(Req(kITSnSigmaEleRaw)) values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
+  if(Req(kITSnSigmaEle))    values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron)
+                                                                              -AliDielectronPID::GetCntrdCorrITS(particle)
+                                                                              ) / AliDielectronPID::GetWdthCorrITS(particle);
+
+  if(Req(kITSnSigmaPio)) values[AliDielectronVarManager::kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
+  if(Req(kITSnSigmaMuo)) values[AliDielectronVarManager::kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
+  if(Req(kITSnSigmaKao)) values[AliDielectronVarManager::kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
+  if(Req(kITSnSigmaPro)) values[AliDielectronVarManager::kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
+
+  if(Req(kTOFnSigmaEle)) values[AliDielectronVarManager::kTOFnSigmaEle]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
+  if(Req(kTOFnSigmaPio)) values[AliDielectronVarManager::kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
+  if(Req(kTOFnSigmaMuo)) values[AliDielectronVarManager::kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
+  if(Req(kTOFnSigmaKao)) values[AliDielectronVarManager::kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
+  if(Req(kTOFnSigmaPro)) values[AliDielectronVarManager::kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
 
   //EMCAL PID information
   Double_t eop=0;
   Double_t showershape[4]={0.,0.,0.,0.};
 //   values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
+  if(Req(kEMCALnSigmaEle) || Req(kEMCALE) || Req(kEMCALEoverP) ||
+     Req(kEMCALNCells) || Req(kEMCALM02) || Req(kEMCALM20) || Req(kEMCALDispersion))
+    values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
   values[AliDielectronVarManager::kEMCALEoverP]     = eop;
   values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
   values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
@@ -1092,8 +1265,10 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   values[AliDielectronVarManager::kEMCALM20]        = showershape[2];
   values[AliDielectronVarManager::kEMCALDispersion] = showershape[3];
 
-  values[AliDielectronVarManager::kLegEff]        = GetSingleLegEff(values);
-  values[AliDielectronVarManager::kOneOverLegEff] = (values[AliDielectronVarManager::kLegEff]>0.0 ? 1./values[AliDielectronVarManager::kLegEff] : 0.0);
+  if(Req(kLegEff) || Req(kOneOverLegEff)) {
+    values[AliDielectronVarManager::kLegEff]        = GetSingleLegEff(values);
+    values[AliDielectronVarManager::kOneOverLegEff] = (values[AliDielectronVarManager::kLegEff]>0.0 ? 1./values[AliDielectronVarManager::kLegEff] : 0.0);
+  }
   //restore TPC signal if it was changed
   if (esdTrack) esdTrack->SetTPCsignal(origdEdx,esdTrack->GetTPCsignalSigma(),esdTrack->GetTPCsignalN());
 
@@ -1101,19 +1276,20 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   if(Req(kTRDonlineA)||Req(kTRDonlineLayerMask)||Req(kTRDonlinePID)||Req(kTRDonlinePt)||Req(kTRDonlineStack)||Req(kTRDonlineTrackInTime)||Req(kTRDonlineSector)||Req(kTRDonlineFlagsTiming)||Req(kTRDonlineLabel)||Req(kTRDonlineNTracklets)||Req(kTRDonlineFirstLayer))
     FillVarVTrdTrack(particle,values);
 
-  if( fgEvent && fgEvent->GetMagneticField() ){
+  if( GetContext()->fEvent && GetContext()->fEvent->GetMagneticField() &&
+      (Req(kTRDeta) || Req(kTPCActiveLength) || Req(kTPCGeomLength) || Req(kInTRDacceptance)) ){
     if(out){
       AliExternalTrackParam out_tmp(*out);
-      out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+      out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), GetContext()->fEvent->GetMagneticField());
       values[AliDielectronVarManager::kTRDeta] = out_tmp.Eta();
     }
     else{
       AliESDtrack particle_tmp(*particle);
-      particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+      particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), GetContext()->fEvent->GetMagneticField());
       values[AliDielectronVarManager::kTRDeta] = particle_tmp.Eta();
     }
     int mode = particle->GetInnerParam() ? 1:0;
-    values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., fgEvent->GetMagneticField());
+    values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., GetContext()->fEvent->GetMagneticField());
     values[kTPCGeomLength] = values[kTPCActiveLength] / ( 130 - TMath::Power( TMath::Abs( particle->GetSigned1Pt() ),1.5 ) );
     values[AliDielectronVarManager::kInTRDacceptance] = TMath::Abs( values[AliDielectronVarManager::kTRDeta] )<0.85 && (  (values[AliDielectronVarManager::kCharge]<0&&(  values[AliDielectronVarManager::kPhi]<1.32 || (values[AliDielectronVarManager::kPhi]>1.98 && values[AliDielectronVarManager::kPhi]<4.10)||  ( values[AliDielectronVarManager::kPhi]>5.12  && values[AliDielectronVarManager::kPhi]<5.48  && TMath::Abs( values[AliDielectronVarManager::kTRDeta] )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.48 )) ||   (values[AliDielectronVarManager::kCharge]>0&&(  values[AliDielectronVarManager::kPhi]<1.52 || (values[AliDielectronVarManager::kPhi]>2.20 && values[AliDielectronVarManager::kPhi]<4.32)||  ( values[AliDielectronVarManager::kPhi]>5.32  && values[AliDielectronVarManager::kPhi]<5.68  && TMath::Abs( values[AliDielectronVarManager::kTRDeta]  )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.68 )) )  ? 1: 0;
   }
@@ -1267,7 +1443,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
       Double_t l  = TMath::C()* expt[0]*1e-12;    // m
       Double_t t  = pid->GetTOFsignal();          // ps start time subtracted (until v5-02-Rev09)
       AliTOFHeader* tofH=0x0;                     // from v5-02-Rev10 on subtract the start time
-      if(fgEvent) tofH = (AliTOFHeader*)fgEvent->GetTOFHeader();
+      if(GetContext()->fEvent) tofH = (AliTOFHeader*)GetContext()->fEvent->GetTOFHeader();
       if(tofH) t -= fgPIDResponse->GetTOFResponse().GetStartTime(particle->P()); // ps
 
     if( (l < 360.e-2 || l > 800.e-2) || (t <= 0.) ) {
@@ -1364,7 +1540,8 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   values[AliDielectronVarManager::kNumberOfDaughters]=-1;
 
   AliDielectronMC *mc=AliDielectronMC::Instance();
-  if (mc->HasMC()){
+  if (mc->HasMC() && (Req(kPdgCode) || Req(kHasCocktailMother) || Req(kPdgCodeMother) ||
+                      Req(kPdgCodeGrandMother) || Req(kNumberOfDaughters))){
     if (mc->GetMCTrack(particle)) {
       Int_t trkLbl = TMath::Abs(mc->GetMCTrack(particle)->GetLabel());
       values[AliDielectronVarManager::kPdgCode]           =mc->GetMCTrack(particle)->PdgCode();
@@ -1627,7 +1804,7 @@ inline void AliDielectronVarManager::FillVarMCParticle2(const AliVParticle *p1,
   values[AliDielectronVarManager::kMMC] = values[AliDielectronVarManager::kM];
   values[AliDielectronVarManager::kPtMC] = values[AliDielectronVarManager::kPt];
 
-  if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
+  if ( GetContext()->fEvent ) AliDielectronVarManager::Fill(GetContext()->fEvent, values);
 
   values[AliDielectronVarManager::kThetaHE]   = AliDielectronPair::ThetaPhiCM(p1,p2,kTRUE,  kTRUE);
   values[AliDielectronVarManager::kPhiHE]     = AliDielectronPair::ThetaPhiCM(p1,p2,kTRUE,  kFALSE);
@@ -1701,7 +1878,7 @@ inline void AliDielectronVarManager::FillVarAODMCParticle(const AliAODMCParticle
   values[AliDielectronVarManager::kNumberOfDaughters]=mc->NumberOfDaughters(particle);
 
   // using AODMCHEader information
-  AliAODMCHeader *mcHeader = (AliAODMCHeader*)fgEvent->FindListObject(AliAODMCHeader::StdBranchName());
+  AliAODMCHeader *mcHeader = (AliAODMCHeader*)GetContext()->fEvent->FindListObject(AliAODMCHeader::StdBranchName());
   if(mcHeader) {
     values[AliDielectronVarManager::kImpactParZ]  = mcHeader->GetVtxZ()-particle->Zv();
     values[AliDielectronVarManager::kImpactParXY] = TMath::Sqrt(TMath::Power(mcHeader->GetVtxX()-particle->Xv(),2) +
@@ -1767,7 +1944,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if(Req(kOpeningAngle))     values[AliDielectronVarManager::kOpeningAngle]     = pair->OpeningAngle();
   if(Req(kOpeningAngleXY))     values[AliDielectronVarManager::kOpeningAngleXY] = pair->OpeningAngleXY();
   if(Req(kOpeningAngleRZ))     values[AliDielectronVarManager::kOpeningAngleRZ] = pair->OpeningAngleRZ();
-  if(Req(kCosPointingAngle)) values[AliDielectronVarManager::kCosPointingAngle] = fgEvent ? pair->GetCosPointingAngle(fgEvent->GetPrimaryVertex()) : -1;
+  if(Req(kCosPointingAngle)) values[AliDielectronVarManager::kCosPointingAngle] = GetContext()->fEvent ? pair->GetCosPointingAngle(GetContext()->fEvent->GetPrimaryVertex()) : -1;
 
   if(Req(kLegDist))   values[AliDielectronVarManager::kLegDist]      = pair->DistanceDaughters();
   if(Req(kLegDistXY)) values[AliDielectronVarManager::kLegDistXY]    = pair->DistanceDaughtersXY();
@@ -1780,20 +1957,20 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if(Req(kArmAlpha)) values[AliDielectronVarManager::kArmAlpha]     = pair->GetArmAlpha();
   if(Req(kArmPt))    values[AliDielectronVarManager::kArmPt]        = pair->GetArmPt();
 
-  if(Req(kPsiPair))  values[AliDielectronVarManager::kPsiPair]      = fgEvent ? pair->PsiPair(fgEvent->GetMagneticField()) : -5;
-  if(Req(kPhivPair)) values[AliDielectronVarManager::kPhivPair]      = fgEvent ? pair->PhivPair(fgEvent->GetMagneticField()) : -5;
+  if(Req(kPsiPair))  values[AliDielectronVarManager::kPsiPair]      = GetContext()->fEvent ? pair->PsiPair(GetContext()->fEvent->GetMagneticField()) : -5;
+  if(Req(kPhivPair)) values[AliDielectronVarManager::kPhivPair]      = GetContext()->fEvent ? pair->PhivPair(GetContext()->fEvent->GetMagneticField()) : -5;
   if(Req(kDeltaCotTheta)) values[kDeltaCotTheta] =  pair->DeltaCotTheta();
-  if(Req(kTriangularConversionCut)) values[AliDielectronVarManager::kTriangularConversionCut] = fgEvent ? pair->PhivPair(fgEvent->GetMagneticField()) - 21. * pair->M() : -999.;
+  if(Req(kTriangularConversionCut)) values[AliDielectronVarManager::kTriangularConversionCut] = GetContext()->fEvent ? pair->PhivPair(GetContext()->fEvent->GetMagneticField()) - 21. * pair->M() : -999.;
   if(Req(kPseudoProperTime) || Req(kPseudoProperTimeErr)) {
     values[AliDielectronVarManager::kPseudoProperTime] =
-      fgEvent ? kfPair.GetPseudoProperDecayTime(*(fgEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
-  // values[AliDielectronVarManager::kPseudoProperTime] = fgEvent ? pair->GetPseudoProperTime(fgEvent->GetPrimaryVertex()): -1e10;
+      GetContext()->fEvent ? kfPair.GetPseudoProperDecayTime(*(GetContext()->fEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
+  // values[AliDielectronVarManager::kPseudoProperTime] = GetContext()->fEvent ? pair->GetPseudoProperTime(GetContext()->fEvent->GetPrimaryVertex()): -1e10;
     values[AliDielectronVarManager::kPseudoProperTimeErr] = (errPseudoProperTime2 > 0) ? TMath::Sqrt(errPseudoProperTime2) : -1e10;
   }
 
   // impact parameter
   Double_t d0z0[2]={-999., -999.};
-  if( (Req(kImpactParXY) || Req(kImpactParZ)) && fgEvent) pair->GetDCA(fgEvent->GetPrimaryVertex(), d0z0);
+  if( (Req(kImpactParXY) || Req(kImpactParZ)) && GetContext()->fEvent) pair->GetDCA(GetContext()->fEvent->GetPrimaryVertex(), d0z0);
   values[AliDielectronVarManager::kImpactParXY]   = d0z0[0];
   values[AliDielectronVarManager::kImpactParZ]    = d0z0[1];
 
@@ -1962,7 +2139,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
 	values[AliDielectronVarManager::kDeltaEta]     = TMath::Abs(feta1 -feta2 );
 	values[AliDielectronVarManager::kDeltaPhi]     = lv1.DeltaPhi(lv2);
 
-       if( Req(kDeltaPhiChargeOrdered) && fgEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = fD1.GetQ() * fgEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
+       if( Req(kDeltaPhiChargeOrdered) && GetContext()->fEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = fD1.GetQ() * GetContext()->fEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
 	values[AliDielectronVarManager::kPairType]     = pair->GetType();
 
         // Calculate pair variables for corresponding generated pair
@@ -2037,15 +2214,15 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if(Req(kSinPhiH2)) values[AliDielectronVarManager::kSinPhiH2] = TMath::Sin(2*phi);
   Double_t delta=0.0;
   // v2 with respect to VZERO-A event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0ArpH2]);
+  delta = TVector2::Phi_mpi_pi(phi - GetContext()->fData[AliDielectronVarManager::kV0ArpH2]);
   if(Req(kV0ArpH2FlowV2))   values[AliDielectronVarManager::kV0ArpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
   if(Req(kDeltaPhiV0ArpH2)) values[AliDielectronVarManager::kDeltaPhiV0ArpH2] = delta;
   // v2 with respect to VZERO-C event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0CrpH2]);
+  delta = TVector2::Phi_mpi_pi(phi - GetContext()->fData[AliDielectronVarManager::kV0CrpH2]);
   if(Req(kV0CrpH2FlowV2))   values[AliDielectronVarManager::kV0CrpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
   if(Req(kDeltaPhiV0CrpH2)) values[AliDielectronVarManager::kDeltaPhiV0CrpH2] = delta;
   // v2 with respect to the combined VZERO-A and VZERO-C event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0ACrpH2]);
+  delta = TVector2::Phi_mpi_pi(phi - GetContext()->fData[AliDielectronVarManager::kV0ACrpH2]);
   if(Req(kV0ACrpH2FlowV2))   values[AliDielectronVarManager::kV0ACrpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
   if(Req(kDeltaPhiV0ACrpH2)) values[AliDielectronVarManager::kDeltaPhiV0ACrpH2] = delta;
 
@@ -2095,15 +2272,15 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
 
   // Calculate v2 of Jpsi using the EP from the 2016 est. qVecQnFramework
   Double_t qnTPCeventplane = values[AliDielectronVarManager::kQnTPCrpH2];
-  if(fgEventPlaneACremoval)
-    if(fgQnEPacRemoval->IsSelected(pair)){
+  if(GetContext()->fEventPlaneACremoval)
+    if(GetContext()->fQnEPacRemoval->IsSelected(pair)){
       AliAnalysisManager *man=AliAnalysisManager::GetAnalysisManager();
       if( AliAnalysisTaskFlowVectorCorrections *flowQnVectorTask = dynamic_cast<AliAnalysisTaskFlowVectorCorrections*> (man->GetTask("FlowQnVectorCorrections")) ){
         if(flowQnVectorTask != NULL){
           AliQnCorrectionsManager *flowQnVectorMgr = flowQnVectorTask->GetAliQnCorrectionsManager();
           TList *qnlist = flowQnVectorMgr->GetQnVectorList();
           if(qnlist != NULL){
-            qnTPCeventplane = fgQnEPacRemoval->GetACcorrectedQnTPCEventplane(pair, qnlist); // Remove auto correlations from the eventplane for the given pair
+            qnTPCeventplane = GetContext()->fQnEPacRemoval->GetACcorrectedQnTPCEventplane(pair, qnlist); // Remove auto correlations from the eventplane for the given pair
           }
           if(qnTPCeventplane == -999.) qnTPCeventplane = values[AliDielectronVarManager::kQnTPCrpH2];
         }
@@ -2132,11 +2309,11 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
     // fill kPseudoProperTimeResolution
     values[AliDielectronVarManager::kPseudoProperTimeResolution] = -1e10;
     // values[AliDielectronVarManager::kPseudoProperTimePull] = -1e10;
-    if(samemother && fgEvent) {
+    if(samemother && GetContext()->fEvent) {
       if(pair->GetFirstDaughterP()->GetLabel() > 0) {
         const AliVParticle *motherMC = 0x0;
-        if(fgEvent->IsA() == AliESDEvent::Class())  motherMC = (AliMCParticle*)mc->GetMCTrackMother((AliESDtrack*)pair->GetFirstDaughterP());
-        else if(fgEvent->IsA() == AliAODEvent::Class())  motherMC = (AliAODMCParticle*)mc->GetMCTrackMother((AliAODTrack*)pair->GetFirstDaughterP());
+        if(GetContext()->fEvent->IsA() == AliESDEvent::Class())  motherMC = (AliMCParticle*)mc->GetMCTrackMother((AliESDtrack*)pair->GetFirstDaughterP());
+        else if(GetContext()->fEvent->IsA() == AliAODEvent::Class())  motherMC = (AliAODMCParticle*)mc->GetMCTrackMother((AliAODTrack*)pair->GetFirstDaughterP());
         Double_t vtxX, vtxY, vtxZ;
 	if(motherMC && mc->GetPrimaryVertex(vtxX,vtxY,vtxZ)) {
 	  Int_t motherLbl = motherMC->GetLabel();
@@ -2183,20 +2360,21 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   values[AliDielectronVarManager::kPairEff]=0.0;
   values[AliDielectronVarManager::kOneOverPairEff]=0.0;
   values[AliDielectronVarManager::kOneOverPairEffSq]=0.0;
-  if (leg1 && leg2 && fgLegEffMap) {
+  const Bool_t reqPairEff=(Req(kPairEff) || Req(kOneOverPairEff) || Req(kOneOverPairEffSq));
+  if (reqPairEff && leg1 && leg2 && fgLegEffMap) {
     Fill(leg1, valuesLeg1);
     Fill(leg2, valuesLeg2);
     values[AliDielectronVarManager::kPairEff] = valuesLeg1[AliDielectronVarManager::kLegEff] *valuesLeg2[AliDielectronVarManager::kLegEff];
   }
-  else if(fgPairEffMap) {
+  else if(reqPairEff && fgPairEffMap) {
     values[AliDielectronVarManager::kPairEff] = GetPairEff(values);
   }
-  if(fgLegEffMap || fgPairEffMap) {
+  if(reqPairEff && (fgLegEffMap || fgPairEffMap)) {
     values[AliDielectronVarManager::kOneOverPairEff] = (values[AliDielectronVarManager::kPairEff]>0.0 ? 1./values[AliDielectronVarManager::kPairEff] : 1.0);
     values[AliDielectronVarManager::kOneOverPairEffSq] = (values[AliDielectronVarManager::kPairEff]>0.0 ? 1./values[AliDielectronVarManager::kPairEff]/values[AliDielectronVarManager::kPairEff] : 1.0);
   }
 
-  if(kRndmPair) values[AliDielectronVarManager::kRndmPair] = gRandom->Rndm();
+  if(Req(kRndmPair)) values[AliDielectronVarManager::kRndmPair] = gRandom->Rndm();
 }
 
 inline void AliDielectronVarManager::FillVarKFParticle(const AliKFParticle *particle, Double_t * const values)
@@ -2264,9 +2442,9 @@ inline void AliDielectronVarManager::FillVarKFParticle(const AliKFParticle *part
   values[AliDielectronVarManager::kHasCocktailMother]=0;
   values[AliDielectronVarManager::kHasCocktailGrandMother]=0;
 
-//   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
+//   if ( GetContext()->fEvent ) AliDielectronVarManager::Fill(GetContext()->fEvent, values);
   for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+    values[i]=GetContext()->fData[i];
 
 }
 
@@ -3234,20 +3412,24 @@ inline Double_t AliDielectronVarManager::GetTRDpidEfficiency(Int_t runNo, Double
 inline void AliDielectronVarManager::SetEvent(AliVEvent * const ev)
 {
 
-  fgEvent = ev;
-  if (fgKFVertex) delete fgKFVertex;
-  fgKFVertex=0x0;
+  AliDielectronVarContext *ctx=GetContext();
+  ctx->fEvent = ev;
+  ctx->ResetCache();
+  if (ctx->fKFVertex) delete ctx->fKFVertex;
+  ctx->fKFVertex=0x0;
   if (!ev) return;
-  if (ev->GetPrimaryVertex()) fgKFVertex=new AliKFVertex(*ev->GetPrimaryVertex());
+  if (ev->GetPrimaryVertex()) ctx->fKFVertex=new AliKFVertex(*ev->GetPrimaryVertex());
 
-  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
-  AliDielectronVarManager::Fill(fgEvent, fgData);
+  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) ctx->fData[i]=0.;
+  AliDielectronVarManager::Fill(ctx->fEvent, ctx->fData);
 }
 
 inline void AliDielectronVarManager::SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues])
 {
-  for (Int_t i=0; i<kNMaxValues;++i) fgData[i]=0.;
-  for (Int_t i=kPairMax; i<kNMaxValues;++i) fgData[i]=data[i];
+  GetContext()->ResetCache();
+  Double_t *ctxData=GetContext()->fData;
+  for (Int_t i=0; i<kNMaxValues;++i) ctxData[i]=0.;
+  for (Int_t i=kPairMax; i<kNMaxValues;++i) ctxData[i]=data[i];
 }
 
 
@@ -3262,7 +3444,7 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
   }
 
   Bool_t ok=kFALSE;
-  if(fgEvent) {
+  if(GetContext()->fEvent) {
     AliExternalTrackParam etp; etp.CopyFromVTrack(track);
 
     Float_t xstart = etp.GetX();
@@ -3272,8 +3454,8 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
       return kFALSE;
     }
 
-    AliAODVertex *vtx =(AliAODVertex*)(fgEvent->GetPrimaryVertex());
-    Double_t fBzkG = fgEvent->GetMagneticField(); // z componenent of field in kG
+    AliAODVertex *vtx =(AliAODVertex*)(GetContext()->fEvent->GetPrimaryVertex());
+    Double_t fBzkG = GetContext()->fEvent->GetMagneticField(); // z componenent of field in kG
     ok = etp.PropagateToDCA(vtx,fBzkG,kVeryBig,d0z0,covd0z0);
   }
   if(!ok){
@@ -3286,10 +3468,12 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
 inline void AliDielectronVarManager::SetTPCEventPlane(AliEventplane *const evplane)
 {
 
-  fgTPCEventPlane = evplane;
-  FillVarTPCEventPlane(evplane,fgData);
-  //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
-  //  AliDielectronVarManager::Fill(fgEvent, fgData);
+  AliDielectronVarContext *ctx=GetContext();
+  ctx->fTPCEventPlane = evplane;
+  ctx->ResetCache();
+  FillVarTPCEventPlane(evplane,ctx->fData);
+  //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) GetContext()->fData[i]=0.;
+  //  AliDielectronVarManager::Fill(GetContext()->fEvent, GetContext()->fData);
 }
 
 
@@ -3541,7 +3725,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   }
   TString qnListDetector;
   // TPC Eventplane q-Vector
-  qnListDetector = "TPC" + fgQnVectorNorm;
+  qnListDetector = "TPC" + GetContext()->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkTPC = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorTPC = new TVector2(-200.,-200.);
   if(qVecQnFrameworkTPC != NULL){
@@ -3554,7 +3738,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorTPC;
 
   // TPC A-Side/Neg. Eta Eventplane q-Vector
-  qnListDetector = "TPCNegEta" + fgQnVectorNorm;
+  qnListDetector = "TPCNegEta" + GetContext()->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkTPCaSide = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorTPCaSide = new TVector2(-200.,-200.);
   if(qVecQnFrameworkTPCaSide != NULL){
@@ -3567,7 +3751,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorTPCaSide;
 
   // TPC C-Side/Pos. Eta Eventplane q-Vector
-  qnListDetector = "TPCPosEta" + fgQnVectorNorm;
+  qnListDetector = "TPCPosEta" + GetContext()->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkTPCcSide = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorTPCcSide = new TVector2(-200.,-200.);
   if(qVecQnFrameworkTPCcSide != NULL){
@@ -3580,7 +3764,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorTPCcSide;
 
   // VZEROA Eventplane q-Vector
-  qnListDetector = "VZEROA" + fgQnVectorNorm;
+  qnListDetector = "VZEROA" + GetContext()->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkV0A = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorV0A = new TVector2(-200.,-200.);
   if(qVecQnFrameworkV0A != NULL){
@@ -3593,7 +3777,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorV0A;
 
   // VZEROC Eventplane q-Vector
-  qnListDetector = "VZEROC" + fgQnVectorNorm;
+  qnListDetector = "VZEROC" + GetContext()->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkV0C = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorV0C = new TVector2(-200.,-200.);
   if(qVecQnFrameworkV0C != NULL){
@@ -3606,7 +3790,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorV0C;
 
   // VZERO Eventplane q-Vector only accessible with NewDetConfig AddTask for QnFramework
-  qnListDetector = "VZERO" + fgQnVectorNorm;
+  qnListDetector = "VZERO" + GetContext()->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkV0 = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorV0 = new TVector2(-200.,-200.);
   if(qVecQnFrameworkV0 != NULL){
@@ -3619,7 +3803,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorV0;
 
   // SPD Eventplane q-Vector
-  qnListDetector = "SPD" + fgQnVectorNorm;
+  qnListDetector = "SPD" + GetContext()->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkSPD = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorSPD = new TVector2(-200.,-200.);
   if(qVecQnFrameworkSPD != NULL){
@@ -3632,7 +3816,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorSPD;
 
   // FMDA Eventplane q-Vector
-  qnListDetector = "FMDA" + fgQnVectorNorm;
+  qnListDetector = "FMDA" + GetContext()->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkFMDA = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorFMDA = new TVector2(-200.,-200.);
   if(qVecQnFrameworkFMDA != NULL){
@@ -3645,7 +3829,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorFMDA;
 
   // FMDC Eventplane q-Vector
-  qnListDetector = "FMDC" + fgQnVectorNorm;
+  qnListDetector = "FMDC" + GetContext()->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkFMDC = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorFMDC = new TVector2(-200.,-200.);
   if(qVecQnFrameworkFMDC != NULL){
@@ -27,6 +27,7 @@
 #include "AliNeutralMesonSelection.h"
 #include "AliAnaParticleHadronCorrelation.h"
 #include "AliCaloTrackReader.h"
+#include "AliCaloTrackMixPool.h"
 #include "AliAODPWG4ParticleCorrelation.h"
 #include "AliFiducialCut.h"
 #include "AliVTrack.h"
@@ -70,8 +71,10 @@ fMakeAbsoluteLeading(0),        fMakeNearSideLeading(0),
 fLeadingTriggerIndex(-1),       fHMPIDCorrelation(0),  fFillBradHisto(0),
 fNAssocPtBins(0),               fAssocPtBinLimit(),
 fCorrelVzBin(0),
-fListMixTrackEvents(),          fListMixCaloEvents(),
+fMixTrackPool(0),               fMixCaloPool(0),
 fUseMixStoredInReader(0),       fFillNeutralEventMixPool(0),
+fNReservedInMixPool(100),
+fMixIsoTracks(0),               fMixIsoCalo(0),
 fM02MaxCut(0),                  fM02MinCut(0),
 fSelectLeadingHadronAngle(0),   fFillLeadHadOppositeHisto(0),
 fMinLeadHadPhi(0),              fMaxLeadHadPhi(0),
@@ -228,41 +231,24 @@ AliAnaParticleHadronCorrelation::~AliAnaParticleHadronCorrelation()
 {
   if(DoOwnMix())
   {
-    if(fListMixTrackEvents)
+    // Pools stored in the reader are deleted by the reader
+    if(!fUseMixStoredInReader)
     {
-      for(Int_t iz=0; iz < GetNZvertBin(); iz++)
-      {
-        for(Int_t ic=0; ic < GetNCentrBin(); ic++)
-        {
-          for(Int_t irp=0; irp<GetNRPBin(); irp++)
-          {
-            Int_t bin = GetEventMixBin(ic, iz, irp);
-            fListMixTrackEvents[bin]->Delete() ;
-            delete fListMixTrackEvents[bin] ;
-          }
-        }
-      }
+      delete fMixTrackPool ;
+      delete fMixCaloPool  ;
     }
     
-    delete[] fListMixTrackEvents;
-    
-    if(fListMixCaloEvents)
+    if(fMixIsoTracks)
     {
-      for(Int_t iz=0; iz < GetNZvertBin(); iz++)
-      {
-        for(Int_t ic=0; ic < GetNCentrBin(); ic++)
-        {
-          for(Int_t irp=0; irp<GetNRPBin(); irp++)
-          {
-            Int_t bin = GetEventMixBin(ic, iz, irp);
-            fListMixCaloEvents[bin]->Delete() ;
-            delete fListMixCaloEvents[bin] ;
-          }
-        }
-      }
+      fMixIsoTracks->Delete() ;
+      delete fMixIsoTracks ;
     }
     
-    delete[] fListMixCaloEvents;
+    if(fMixIsoCalo)
+    {
+      fMixIsoCalo->Delete() ;
+      delete fMixIsoCalo ;
+    }
   }
 }
 
@@ -1193,19 +1179,17 @@ void AliAnaParticleHadronCorrelation::FillChargedEventMixPool()
   
   fhEventMBBin->Fill(eventBin, GetEventWeight());
   
-  TObjArray * mixEventTracks = new TObjArray;
+  AliCaloTrackMixPool * pool = fMixTrackPool;
+  if(fUseMixStoredInReader) pool = GetReader()->GetMixedEventsPoolForTracks();
   
-  if(fUseMixStoredInReader)
-  {
-    fListMixTrackEvents[eventBin] = GetReader()->GetListWithMixedEventsForTracks(eventBin);
-  }
-  
-  if(!fListMixTrackEvents[eventBin]) fListMixTrackEvents[eventBin] = new TList();
+  if(!pool) return;
   
   //printf("%s ***** Pool Event bin : %d - nTracks %d\n",GetInputAODName().Data(),eventBin, GetCTSTracks()->GetEntriesFast());
   
-  TList * pool = fListMixTrackEvents[eventBin];
+  // Open a new event in the bin, the oldest one is overwritten if the pool is full
+  pool->AddEvent(eventBin);
   
+  Int_t nMixTracks = 0;
   for(Int_t ipr = 0;ipr < GetCTSTracks()->GetEntriesFast() ; ipr ++ )
   {
     AliVTrack * track = (AliVTrack *) (GetCTSTracks()->At(ipr)) ;
@@ -1216,30 +1200,16 @@ void AliAnaParticleHadronCorrelation::FillChargedEventMixPool()
     // Select only hadrons in pt range
     if(pt < fMinAssocPt || pt > fMaxAssocPt) continue ;
     
-    AliAODPWG4Particle * mixedTrack = new AliAODPWG4Particle(track->Px(),track->Py(),track->Pz(),0);
-    mixedTrack->SetDetectorTag(kCTS);
-    mixedTrack->SetChargedBit(track->Charge()>0);
-    mixEventTracks->Add(mixedTrack);
+    pool->AddParticle(pt, fTrackVector.Eta(), fTrackVector.Phi(), track->Charge(), GetReader()->GetTrackID(track));
+    nMixTracks++;
   }
   
-  fhNtracksMB->Fill(mixEventTracks->GetEntriesFast(), eventBin, GetEventWeight());
+  fhNtracksMB->Fill(nMixTracks, eventBin, GetEventWeight());
   
   // Set the event number where the last event was added, to avoid double pool filling
   GetReader()->SetLastTracksMixedEvent(GetEventNumber());
   
-  //printf("Add event to pool with %d tracks \n ",mixEventTracks->GetEntries());
-  pool->AddFirst(mixEventTracks);
-  mixEventTracks = 0;
-  
-  //printf("Pool size %d, max %d\n",pool->GetSize(), GetNMaxEvMix());
-  
-  if(pool->GetSize() > GetNMaxEvMix())
-  {
-    // Remove last event
-    TClonesArray * tmp = static_cast<TClonesArray*>(pool->Last()) ;
-    pool->RemoveLast() ;
-    delete tmp ;
-  }
+  //printf("Pool size %d, max %d\n",pool->GetNEvents(eventBin), pool->GetDepth());
 }
 
 //_____________________________________________________________
@@ -1273,17 +1243,15 @@ void AliAnaParticleHadronCorrelation::FillNeutralEventMixPool()
   // Check that the bin exists, if not (bad determination of RP, centrality or vz bin) do nothing
   if(eventBin < 0) return;
   
-  TObjArray * mixEventCalo = new TObjArray;
-  
-  if(fUseMixStoredInReader)
-  {
-    fListMixCaloEvents[eventBin] = GetReader()->GetListWithMixedEventsForCalo(eventBin);
-  }
+  AliCaloTrackMixPool * poolCalo = fMixCaloPool;
+  if(fUseMixStoredInReader) poolCalo = GetReader()->GetMixedEventsPoolForCalo();
   
-  if(!fListMixCaloEvents[eventBin]) fListMixCaloEvents[eventBin] = new TList();
+  if(!poolCalo) return;
   
-  TList * poolCalo = fListMixCaloEvents[eventBin];
+  // Open a new event in the bin, the oldest one is overwritten if the pool is full
+  poolCalo->AddEvent(eventBin);
   
+  Int_t nMixClusters = 0;
   for(Int_t ipr = 0;ipr <  pl->GetEntriesFast() ; ipr ++ )
   {
     AliVCluster * calo = (AliVCluster *) (pl->At(ipr)) ;
@@ -1307,29 +1275,16 @@ void AliAnaParticleHadronCorrelation::FillNeutralEventMixPool()
     // Select only clusters in pt range
     if(pt < fMinAssocPt || pt > fMaxAssocPt) continue ;
     
-    AliAODPWG4Particle * mixedCalo = new AliAODPWG4Particle(fMomentum);
-    mixedCalo->SetDetectorTag(kEMCAL);
-    mixEventCalo->Add(mixedCalo);
+    poolCalo->AddParticle(pt, fMomentum.Eta(), fMomentum.Phi(), 0, calo->GetID());
+    nMixClusters++;
   }
   
-  fhNclustersMB->Fill(mixEventCalo->GetEntriesFast(), eventBin, GetEventWeight());
+  fhNclustersMB->Fill(nMixClusters, eventBin, GetEventWeight());
   
   // Set the event number where the last event was added, to avoid double pool filling
   GetReader()->SetLastCaloMixedEvent(GetEventNumber());
   
-  //printf("Add event to pool with %d clusters \n ",mixEventCalo->GetEntries());
-  poolCalo->AddFirst(mixEventCalo);
-  mixEventCalo = 0;
-  
-  //printf("Pool size %d, max %d\n",poolCalo->GetSize(), GetNMaxEvMix());
-  
-  if(poolCalo->GetSize() > GetNMaxEvMix())
-  {
-    // Remove last event
-    TClonesArray * tmp = static_cast<TClonesArray*>(poolCalo->Last()) ;
-    poolCalo->RemoveLast() ;
-    delete tmp ;
-  }
+  //printf("Pool size %d, max %d\n",poolCalo->GetNEvents(eventBin), poolCalo->GetDepth());
 }
 
 //_________________________________________________________________________________________________________________
@@ -3027,30 +2982,10 @@ TList *  AliAnaParticleHadronCorrelation::GetCreateOutputObjects()
   {
     // Create event containers
     
-    if(!fUseMixStoredInReader || (fUseMixStoredInReader && !GetReader()->ListWithMixedEventsForTracksExists()))
+    if(!fUseMixStoredInReader || (fUseMixStoredInReader && !GetReader()->MixedEventsPoolForTracksExists()))
     {
-      Int_t nvz = GetNZvertBin();
-      Int_t nrp = GetNRPBin();
-      Int_t nce = GetNCentrBin();
-      
-      fListMixTrackEvents= new TList*[nvz*nrp*nce] ;
-      
-      for( Int_t ice = 0 ; ice < nce ; ice++ )
-      {
-        for( Int_t ivz = 0 ; ivz < nvz ; ivz++ )
-        {
-          for( Int_t irp = 0 ; irp < nrp ; irp++ )
-          {
-            Int_t bin = GetEventMixBin(ice,ivz,irp); //ic*nvz*nrp+iz*nrp+irp;
-            
-            //printf("GetCreateOutputObjects - Bins : cent %d, vz %d, RP %d, event %d/%d\n",
-            //       ic,iz, irp, bin);
-            
-            fListMixTrackEvents[bin] = new TList() ;
-            fListMixTrackEvents[bin]->SetOwner(kFALSE);
-          }
-        }
-      }
+      // One ring of GetNMaxEvMix() events per bin(cen,vz,rp)
+      fMixTrackPool = new AliCaloTrackMixPool(GetNCentrBin()*GetNZvertBin()*GetNRPBin(), GetNMaxEvMix(), fNReservedInMixPool) ;
     }
     
     fhPtTriggerMixed  = new TH1F ("hPtTriggerMixed","#it{p}_{T} distribution of trigger particles, used for mixing", nptbins,ptmin,ptmax);
@@ -3080,40 +3015,19 @@ TList *  AliAnaParticleHadronCorrelation::GetCreateOutputObjects()
     outputContainer->Add(fhEtaTriggerMixed);
     
     // Fill the cluster pool only in isolation analysis or if requested
-    if( neutralMix && (!fUseMixStoredInReader || (fUseMixStoredInReader && !GetReader()->ListWithMixedEventsForCaloExists())))
+    if( neutralMix && (!fUseMixStoredInReader || (fUseMixStoredInReader && !GetReader()->MixedEventsPoolForCaloExists())))
     {
-      Int_t nvz = GetNZvertBin();
-      Int_t nrp = GetNRPBin();
-      Int_t nce = GetNCentrBin();
-      
-      fListMixCaloEvents= new TList*[nvz*nrp*nce] ;
-      
-      for( Int_t ice = 0 ; ice < nce ; ice++ )
-      {
-        for( Int_t ivz = 0 ; ivz < nvz ; ivz++ )
-        {
-          for( Int_t irp = 0 ; irp < nrp ; irp++ )
-          {
-            Int_t bin = GetEventMixBin(ice,ivz,irp); //ic*nvz*nrp+iz*nrp+irp;
-            
-            //printf("GetCreateOutputObjects - Bins : cent %d, vz %d, RP %d, event %d/%d\n",
-            //       ic,iz, irp, bin);
-            
-            fListMixCaloEvents[bin] = new TList() ;
-            fListMixCaloEvents[bin]->SetOwner(kFALSE);
-          }
-        }
-      }
+      fMixCaloPool = new AliCaloTrackMixPool(GetNCentrBin()*GetNZvertBin()*GetNRPBin(), GetNMaxEvMix(), fNReservedInMixPool) ;
     }
     
-    // Init the list in the reader if not done previously
+    // Init the pools in the reader if not done previously, the reader owns them
     if(fUseMixStoredInReader)
     {
-      if( !GetReader()->ListWithMixedEventsForTracksExists() )
-        GetReader()->SetListWithMixedEventsForTracks(fListMixTrackEvents);
+      if( !GetReader()->MixedEventsPoolForTracksExists() )
+        GetReader()->SetMixedEventsPoolForTracks(fMixTrackPool);
       
-      if( !GetReader()->ListWithMixedEventsForCaloExists()   )
-        GetReader()->SetListWithMixedEventsForCalo  (fListMixCaloEvents );
+      if( !GetReader()->MixedEventsPoolForCaloExists()   )
+        GetReader()->SetMixedEventsPoolForCalo  (fMixCaloPool );
     }
     
     fhEventBin=new TH1I("hEventBin","Number of triggers per bin(cen,vz,rp)",
@@ -4260,17 +4174,17 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliAODPWG4Partic
   Bool_t isoCase = OnlyIsolated() && (GetIsolationCut()->GetParticleTypeInCone() != AliIsolationCut::kOnlyCharged);
   Bool_t neutralMix = fFillNeutralEventMixPool || isoCase ;
   
-  TList * pool     = 0;
-  TList * poolCalo = 0;
+  AliCaloTrackMixPool * pool     = 0;
+  AliCaloTrackMixPool * poolCalo = 0;
   if(fUseMixStoredInReader)
   {
-    pool     = GetReader()->GetListWithMixedEventsForTracks(eventBin);
-    if(neutralMix) poolCalo = GetReader()->GetListWithMixedEventsForCalo  (eventBin);
+    pool     = GetReader()->GetMixedEventsPoolForTracks();
+    if(neutralMix) poolCalo = GetReader()->GetMixedEventsPoolForCalo  ();
   }
   else
   {
-    pool     = fListMixTrackEvents[eventBin];
-    if(neutralMix) poolCalo = fListMixCaloEvents [eventBin];
+    pool     = fMixTrackPool;
+    if(neutralMix) poolCalo = fMixCaloPool;
   }
   
   if(!pool) return ;
@@ -4283,8 +4197,18 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliAODPWG4Partic
   Double_t phiTrig = aodParticle->Phi();
   if(phiTrig < 0.) phiTrig+=TMath::TwoPi();
   
+  Int_t nEvents     = pool->GetNEvents(eventBin);
+  Int_t nEventsCalo = (poolCalo ? poolCalo->GetNEvents(eventBin) : 0);
+  
   AliDebug(1,Form("Pool bin %d size %d, trigger trigger pt=%f, phi=%f, eta=%f",
-                  eventBin,pool->GetSize(), ptTrig,phiTrig,etaTrig));
+                  eventBin,nEvents, ptTrig,phiTrig,etaTrig));
+  
+  // Particle arrays of the pool events, needed by the isolation
+  if( OnlyIsolated() && !fMixIsoTracks )
+  {
+    fMixIsoTracks = new TClonesArray("AliAODPWG4Particle",fNReservedInMixPool);
+    if(neutralMix) fMixIsoCalo = new TClonesArray("AliAODPWG4Particle",fNReservedInMixPool);
+  }
   
   Double_t ptAssoc  = -999.;
   Double_t phiAssoc = -999.;
@@ -4297,23 +4221,35 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliAODPWG4Partic
   Int_t ev0 = 0;
   if(GetReader()->GetLastTracksMixedEvent() == GetEventNumber()) ev0 = 1;
   
-  for(Int_t ev=ev0; ev < pool->GetSize(); ev++)
+  for(Int_t ev=ev0; ev < nEvents; ev++)
   {
     //
-    // Recover the lists of tracks or clusters
+    // Recover the tracks or clusters of the pool event
     //
-    TObjArray* bgTracks = static_cast<TObjArray*>(pool->At(ev));
-    TObjArray* bgCalo   = 0;
+    Int_t          nTracks      = pool->GetNParticles(eventBin,ev);
+    const Float_t* bgTracksPt   = pool->GetPt (eventBin,ev);
+    const Float_t* bgTracksEta  = pool->GetEta(eventBin,ev);
+    const Float_t* bgTracksPhi  = pool->GetPhi(eventBin,ev);
     
-    // Recover the clusters list if requested
+    Bool_t         hasBgCalo    = kFALSE;
+    Int_t          nClusters    = 0;
+    const Float_t* bgCaloPt     = 0;
+    const Float_t* bgCaloPhi    = 0;
+    
+    // Recover the clusters if requested
     if( neutralMix && poolCalo )
     {
-      if(pool->GetSize()!=poolCalo->GetSize())
+      if(nEvents!=nEventsCalo)
         AliWarning("Different size of calo and track pools");
       
-      bgCalo = static_cast<TObjArray*>(poolCalo->At(ev));
-      
-      if(!bgCalo) AliDebug(1,Form("Event %d in calo pool not available?",ev));
+      if(ev < nEventsCalo)
+      {
+        hasBgCalo = kTRUE;
+        nClusters = poolCalo->GetNParticles(eventBin,ev);
+        bgCaloPt  = poolCalo->GetPt (eventBin,ev);
+        bgCaloPhi = poolCalo->GetPhi(eventBin,ev);
+      }
+      else AliDebug(1,Form("Event %d in calo pool not available?",ev));
     }
     
     //
@@ -4321,10 +4257,13 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliAODPWG4Partic
     //
     if( OnlyIsolated() )
     {
+      pool->FillParticleArray(eventBin, ev, fMixIsoTracks, kCTS);
+      if(hasBgCalo && fMixIsoCalo) poolCalo->FillParticleArray(eventBin, ev, fMixIsoCalo, kEMCAL);
+      
       Int_t   n=0, nfrac = 0;
       Bool_t  isolated = kFALSE;
       Float_t coneptsum = 0, coneptlead = 0;
-      GetIsolationCut()->MakeIsolationCut(bgTracks,bgCalo,
+      GetIsolationCut()->MakeIsolationCut(fMixIsoTracks,(hasBgCalo ? fMixIsoCalo : 0),
                                           GetReader(), GetCaloPID(),
                                           kFALSE, aodParticle, "",
                                           n,nfrac,coneptsum,coneptlead,isolated);
@@ -4340,18 +4279,13 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliAODPWG4Partic
     //
     // Check if the trigger is leading of mixed event
     //
-    Int_t nTracks=bgTracks->GetEntriesFast();
-    
     if(fMakeNearSideLeading || fMakeAbsoluteLeading)
     {
       Bool_t leading = kTRUE;
       for(Int_t jlead = 0;jlead < nTracks; jlead++ )
       {
-        AliAODPWG4Particle *track = (AliAODPWG4Particle*) bgTracks->At(jlead) ;
-        
-        ptAssoc  = track->Pt();
-        phiAssoc = track->Phi() ;
-        if(phiAssoc < 0) phiAssoc+=TMath::TwoPi();
+        ptAssoc  = bgTracksPt [jlead];
+        phiAssoc = bgTracksPhi[jlead];
         
         if (fMakeNearSideLeading)
         {
@@ -4379,16 +4313,12 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliAODPWG4Partic
       if( !neutralMix && fCheckLeadingWithNeutralClusters )
         AliWarning("Leading of clusters requested but no clusters in mixed event");
       
-      if(neutralMix && fCheckLeadingWithNeutralClusters && bgCalo)
+      if(neutralMix && fCheckLeadingWithNeutralClusters && hasBgCalo)
       {
-        Int_t nClusters=bgCalo->GetEntriesFast();
         for(Int_t jlead = 0;jlead <nClusters; jlead++ )
         {
-          AliAODPWG4Particle *cluster= (AliAODPWG4Particle*) bgCalo->At(jlead) ;
-          
-          ptAssoc  = cluster->Pt();
-          phiAssoc = cluster->Phi() ;
-          if(phiAssoc < 0) phiAssoc+=TMath::TwoPi();
+          ptAssoc  = bgCaloPt [jlead];
+          phiAssoc = bgCaloPhi[jlead];
           
           if (fMakeNearSideLeading)
           {
@@ -4437,14 +4367,10 @@ void AliAnaParticleHadronCorrelation::MakeChargedMixCorrelation(AliAODPWG4Partic
     //
     for(Int_t j1 = 0;j1 <nTracks; j1++ )
     {
-      AliAODPWG4Particle *track = (AliAODPWG4Particle*) bgTracks->At(j1) ;
-      
-      if(!track) continue;
-      
-      ptAssoc  = track->Pt();
-      etaAssoc = track->Eta();
-      phiAssoc = track->Phi() ;
-      if(phiAssoc < 0) phiAssoc+=TMath::TwoPi();
+      // Pool azimuth is already in [0,2pi)
+      ptAssoc  = bgTracksPt [j1];
+      etaAssoc = bgTracksEta[j1];
+      phiAssoc = bgTracksPhi[j1];
       
       deltaPhi = phiTrig-phiAssoc;
       if(deltaPhi < -TMath::PiOver2())  deltaPhi+=TMath::TwoPi();
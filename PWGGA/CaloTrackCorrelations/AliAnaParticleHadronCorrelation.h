@@ -22,6 +22,7 @@
 
 #include "AliAnaCaloTrackCorrBaseClass.h"
 class AliAODPWG4ParticleCorrelation ;
+class AliCaloTrackMixPool ;
 
 class AliAnaParticleHadronCorrelation : public AliAnaCaloTrackCorrBaseClass {
   
@@ -220,6 +221,8 @@ public:
   void         SwitchOnFillNeutralInMixedEvent() { fFillNeutralEventMixPool = kTRUE  ; }
   void         SwitchOffFillNeutralInMixedEvent(){ fFillNeutralEventMixPool = kFALSE ; }
   
+  void         SetNReservedParticlesInMixPool(Int_t n) { fNReservedInMixPool = n ; }
+  
   void         SetM02Cut(Float_t min=0, Float_t max=10)  { fM02MinCut   = min ; fM02MaxCut  = max ; }
   
   void         SwitchOnCorrelationVzBin()        { fCorrelVzBin          = kTRUE  ; }
@@ -292,16 +295,20 @@ private:
   
   Bool_t       fCorrelVzBin ;                            ///<  Fill one histogram per vz bin.
   
-  /// Containers for tracks in stored events for mixing.
-  TList **     fListMixTrackEvents ;                     //![GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+  AliCaloTrackMixPool * fMixTrackPool ;                  //!<! Pool of tracks in stored events for mixing, per event bin.
   
-  /// Containers for calo clusters in stored events for mixing.
-  TList **     fListMixCaloEvents ;                      //![GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+  AliCaloTrackMixPool * fMixCaloPool ;                   //!<! Pool of calo clusters in stored events for mixing, per event bin.
   
   Bool_t       fUseMixStoredInReader;                    ///<  Signal if in the current event the pool was filled.
   
   Bool_t       fFillNeutralEventMixPool;                 ///<  Add clusters to pool if requested.
   
+  Int_t        fNReservedInMixPool;                      ///<  Number of particles per event preallocated in the mixing pools.
+  
+  TClonesArray * fMixIsoTracks;                          //!<! Tracks of a pool event, input for the isolation in mixed events.
+  
+  TClonesArray * fMixIsoCalo;                            //!<! Clusters of a pool event, input for the isolation in mixed events.
+  
   Float_t      fM02MaxCut   ;                            ///<  Study photon clusters with l0 smaller than cut.
   Float_t      fM02MinCut   ;                            ///<  Study photon clusters with l0 larger than cut.
   
@@ -653,7 +660,7 @@ private:
   AliAnaParticleHadronCorrelation & operator = (const AliAnaParticleHadronCorrelation & ph) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaParticleHadronCorrelation,36) ;
+  ClassDef(AliAnaParticleHadronCorrelation,37) ;
   /// \endcond
   
 } ;
@@ -344,7 +344,10 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(): AliAnalysisTaskSE(
   fDoPrimaryTrackMatching(kFALSE),
   fDoInvMassShowerShapeTree(kFALSE),
   tBrokenFiles(NULL),
-  fFileNameBroken(NULL)
+  fFileNameBroken(NULL),
+  fSharePhotonCutDecisions(kFALSE),
+  fPhotonCutDecisions(NULL),
+  fMesonCutDecisions(NULL)
 {
   
 }
@@ -633,7 +636,10 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(const char *name):
   fDoPrimaryTrackMatching(kFALSE),
   fDoInvMassShowerShapeTree(kFALSE),
   tBrokenFiles(NULL),
-  fFileNameBroken(NULL)
+  fFileNameBroken(NULL),
+  fSharePhotonCutDecisions(kFALSE),
+  fPhotonCutDecisions(NULL),
+  fMesonCutDecisions(NULL)
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -665,6 +671,14 @@ AliAnalysisTaskGammaConvCalo::~AliAnalysisTaskGammaConvCalo()
     delete[] fBGClusHandlerRP;
     fBGClusHandlerRP = 0x0;
   }
+  if(fPhotonCutDecisions){
+    delete fPhotonCutDecisions;
+    fPhotonCutDecisions = 0x0;
+  }
+  if(fMesonCutDecisions){
+    delete fMesonCutDecisions;
+    fMesonCutDecisions = 0x0;
+  }
 }
 //___________________________________________________________
 void AliAnalysisTaskGammaConvCalo::InitBack(){
@@ -760,6 +774,35 @@ void AliAnalysisTaskGammaConvCalo::UserCreateOutputObjects(){
   fV0Reader = (AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data());
   if(!fV0Reader){printf("Error: No V0 Reader");return;}// GetV0Reader
 
+  // map the selection stages of configurations with identical photon selections (cut digits and
+  // settings used by the stage, see AliConversionPhotonCuts::GetSelectionKey) onto one entry of the
+  // decision table, the same for the meson selection together with the event and cluster cut numbers (rapidity shift, cluster energy)
+  if(fSharePhotonCutDecisions){
+    fPhotonCutDecisions = new AliConversionCutDecisionTable();
+    for(Int_t iCut = 0; iCut<fnCuts;iCut++){
+      fPhotonCutDecisions->AddConfiguration(((AliConversionPhotonCuts*)fCutArray->At(iCut))->GetSelectionKeys());
+    }
+    if(!fPhotonCutDecisions->HasSharedAtoms()){
+      delete fPhotonCutDecisions;
+      fPhotonCutDecisions = NULL;
+    } else {
+      fPhotonCutDecisions->Print();
+    }
+    if(fDoMesonAnalysis){
+      fMesonCutDecisions = new AliConversionCutDecisionTable();
+      for(Int_t iCut = 0; iCut<fnCuts;iCut++){
+        fMesonCutDecisions->AddConfiguration(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->GetSelectionKey()+"_"+
+                                             ((AliConvEventCuts*)fEventCutArray->At(iCut))->GetCutNumber()+"_"+((AliCaloPhotonCuts*)fClusterCutArray->At(iCut))->GetCutNumber());
+      }
+      if(!fMesonCutDecisions->HasSharedAtoms()){
+        delete fMesonCutDecisions;
+        fMesonCutDecisions = NULL;
+      } else {
+        fMesonCutDecisions->Print();
+      }
+    }
+  }
+
   
   if (fIsMC > 1){
     fDoPhotonQA       = 0;
@@ -2227,6 +2270,8 @@ void AliAnalysisTaskGammaConvCalo::UserExec(Option_t *)
   }
   
   fReaderGammas = fV0Reader->GetReconstructedGammas(); // Gammas from default Cut
+  if(fPhotonCutDecisions) fPhotonCutDecisions->ResetEvent(fReaderGammas->GetEntriesFast());
+  if(fMesonCutDecisions) fMesonCutDecisions->ResetEvent(fReaderGammas->GetEntriesFast()*fInputEvent->GetNumberOfCaloClusters());
 
   // ------------------- BeginEvent ----------------------------
   AliEventplane *EventPlane = fInputEvent->GetEventplane();
@@ -2814,6 +2859,15 @@ void AliAnalysisTaskGammaConvCalo::ProcessTrueClusterCandidatesAOD(AliAODConvers
   return;
 }
 
+//________________________________________________________________________
+Bool_t AliAnalysisTaskGammaConvCalo::IsPhotonSelected(AliAODConversionPhoton *photon, Int_t index)
+{
+  // photon selection of the current cut, configurations with identical photon
+  // cuts in a selection stage share one evaluation per candidate and event
+  AliConversionPhotonCuts *photonCuts = (AliConversionPhotonCuts*)fCutArray->At(fiCut);
+  return photonCuts->PhotonIsSelected(photon,fInputEvent,fPhotonCutDecisions,index,fiCut);
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskGammaConvCalo::ProcessPhotonCandidates()
 {
@@ -2833,7 +2887,7 @@ void AliAnalysisTaskGammaConvCalo::ProcessPhotonCandidates()
       if( (isNegFromMBHeader+isPosFromMBHeader) != 4) fIsFromMBHeader = kFALSE;
     }
     
-    if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->PhotonIsSelected(PhotonCandidate,fInputEvent)) continue;
+    if(!IsPhotonSelected(PhotonCandidate,i)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->InPlaneOutOfPlaneCut(PhotonCandidate->GetPhotonPhi(),fEventPlaneAngle)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseElecSharingCut() &&
     !((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseToCloseV0sCut()){
@@ -3612,6 +3666,7 @@ void AliAnalysisTaskGammaConvCalo::CalculatePi0Candidates(){
     for(Int_t firstGammaIndex=0;firstGammaIndex<fGammaCandidates->GetEntries();firstGammaIndex++){
       AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fGammaCandidates->At(firstGammaIndex));
       if (gamma0==NULL) continue;
+      Int_t readerIndex = fMesonCutDecisions ? fReaderGammas->IndexOf(gamma0) : -1;
       
       for(Int_t secondGammaIndex=0;secondGammaIndex<fClusterCandidates->GetEntries();secondGammaIndex++){
         Bool_t matched = kFALSE;
@@ -3640,8 +3695,12 @@ void AliAnalysisTaskGammaConvCalo::CalculatePi0Candidates(){
 
         AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
         pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
+        // a pair of reader photon and cluster is one entry of the meson decision table
+        Int_t mesonIndex = -1;
+        if(fMesonCutDecisions && readerIndex >= 0 && gamma1->GetIsCaloPhoton() && gamma1->GetCaloClusterRef() >= 0)
+          mesonIndex = readerIndex*fInputEvent->GetNumberOfCaloClusters()+gamma1->GetCaloClusterRef();
         
-        if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
+        if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),fMesonCutDecisions,mesonIndex,fiCut))){
           if (matched){
             if(!fDoLightOutput) fHistoMotherMatchedInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
           }else {
@@ -11,6 +11,7 @@
 #include "AliConvEventCuts.h"
 #include "AliConversionPhotonCuts.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionCutDecisionTable.h"
 #include "AliAnalysisManager.h"
 #include "TProfile2D.h"
 #include "TH3.h"
@@ -40,6 +41,7 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     // base functions for selecting photon and meson candidates in reconstructed data
     void ProcessClusters();
     void ProcessPhotonCandidates();
+    Bool_t IsPhotonSelected(AliAODConversionPhoton *photon, Int_t index);
     void CalculatePi0Candidates();
     
     // MC functions
@@ -75,6 +77,7 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     void SetPlotHistsExtQA              ( Bool_t flag )                                     { fSetPlotHistsExtQA = flag                   ;}
     void SetDoTreeConvGammaShowerShape  ( Bool_t flag )                                     { fDoConvGammaShowerShapeTree = flag          ;}
     void SetDoTreeInvMassShowerShape    ( Bool_t flag )                                     { fDoInvMassShowerShapeTree = flag            ;}
+    void SetSharePhotonCutDecisions     ( Bool_t flag )                                     { fSharePhotonCutDecisions = flag             ;}
 
 
     // Setting the cut lists for the conversion photons
@@ -445,13 +448,16 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     Bool_t                  fDoInvMassShowerShapeTree;                          // flag for producing tree tESDInvMassShowerShape
     TTree*                  tBrokenFiles;                                       // tree for keeping track of broken files
     TObjString*             fFileNameBroken;                                    // string object for broken file name
+    Bool_t                  fSharePhotonCutDecisions;                           // evaluate identical photon and meson cuts only once per candidate
+    AliConversionCutDecisionTable* fPhotonCutDecisions;                         //! photon cut decisions shared between cut configurations
+    AliConversionCutDecisionTable* fMesonCutDecisions;                          //! meson cut decisions shared between cut configurations
     
     
   private:
     AliAnalysisTaskGammaConvCalo(const AliAnalysisTaskGammaConvCalo&); // Prevent copy-construction
     AliAnalysisTaskGammaConvCalo &operator=(const AliAnalysisTaskGammaConvCalo&); // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaConvCalo, 38);
+    ClassDef(AliAnalysisTaskGammaConvCalo, 40);
 };
 
 #endif
@@ -264,7 +264,10 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fEnableClusterCutsForTrigger(kFALSE),
   fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE),
   tBrokenFiles(NULL),
-  fFileNameBroken(NULL)
+  fFileNameBroken(NULL),
+  fSharePhotonCutDecisions(kFALSE),
+  fPhotonCutDecisions(NULL),
+  fMesonCutDecisions(NULL)
 {
 
 }
@@ -474,7 +477,10 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fEnableClusterCutsForTrigger(kFALSE),
   fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE),
   tBrokenFiles(NULL),
-  fFileNameBroken(NULL)
+  fFileNameBroken(NULL),
+  fSharePhotonCutDecisions(kFALSE),
+  fPhotonCutDecisions(NULL),
+  fMesonCutDecisions(NULL)
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -499,6 +505,14 @@ AliAnalysisTaskGammaConvV1::~AliAnalysisTaskGammaConvV1()
     delete[] fWeightCentrality; 
     fWeightCentrality = 0x0; 
   }
+  if(fPhotonCutDecisions){
+    delete fPhotonCutDecisions;
+    fPhotonCutDecisions = 0x0;
+  }
+  if(fMesonCutDecisions){
+    delete fMesonCutDecisions;
+    fMesonCutDecisions = 0x0;
+  }
     
 }
 //___________________________________________________________
@@ -1521,6 +1535,35 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
   fV0Reader=(AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data());
   if(!fV0Reader){printf("Error: No V0 Reader");return;} // GetV0Reader
 
+  // map the selection stages of configurations with identical photon selections (cut digits and
+  // settings used by the stage, see AliConversionPhotonCuts::GetSelectionKey) onto one entry of the
+  // decision table, the same for the meson selection together with the event cut number (rapidity shift)
+  if(fSharePhotonCutDecisions){
+    fPhotonCutDecisions = new AliConversionCutDecisionTable();
+    for(Int_t iCut = 0; iCut<fnCuts;iCut++){
+      fPhotonCutDecisions->AddConfiguration(((AliConversionPhotonCuts*)fCutArray->At(iCut))->GetSelectionKeys());
+    }
+    if(!fPhotonCutDecisions->HasSharedAtoms()){
+      delete fPhotonCutDecisions;
+      fPhotonCutDecisions = NULL;
+    } else {
+      fPhotonCutDecisions->Print();
+    }
+    if(fDoMesonAnalysis){
+      fMesonCutDecisions = new AliConversionCutDecisionTable();
+      for(Int_t iCut = 0; iCut<fnCuts;iCut++){
+        fMesonCutDecisions->AddConfiguration(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->GetSelectionKey()+"_"+
+                                             ((AliConvEventCuts*)fEventCutArray->At(iCut))->GetCutNumber());
+      }
+      if(!fMesonCutDecisions->HasSharedAtoms()){
+        delete fMesonCutDecisions;
+        fMesonCutDecisions = NULL;
+      } else {
+        fMesonCutDecisions->Print();
+      }
+    }
+  }
+
   if(fV0Reader)
     if((AliConvEventCuts*)fV0Reader->GetEventCuts())
       if(((AliConvEventCuts*)fV0Reader->GetEventCuts())->GetCutHistograms())
@@ -1643,6 +1686,8 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
   }
 
   fReaderGammas = fV0Reader->GetReconstructedGammas(); // Gammas from default Cut
+  if(fPhotonCutDecisions) fPhotonCutDecisions->ResetEvent(fReaderGammas->GetEntriesFast());
+  if(fMesonCutDecisions) fMesonCutDecisions->ResetEvent(fReaderGammas->GetEntriesFast()*fReaderGammas->GetEntriesFast());
   
   // ------------------- BeginEvent ----------------------------
 
@@ -1839,6 +1884,15 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
   
   PostData(1, fOutputContainer);
 }
+//________________________________________________________________________
+Bool_t AliAnalysisTaskGammaConvV1::IsPhotonSelected(AliAODConversionPhoton *photon, Int_t index)
+{
+  // photon selection of the current cut, configurations with identical photon
+  // cuts in a selection stage share one evaluation per candidate and event
+  AliConversionPhotonCuts *photonCuts = (AliConversionPhotonCuts*)fCutArray->At(fiCut);
+  return photonCuts->PhotonIsSelected(photon,fInputEvent,fPhotonCutDecisions,index,fiCut);
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskGammaConvV1::ProcessPhotonCandidates()
 {
@@ -1861,7 +1915,7 @@ void AliAnalysisTaskGammaConvV1::ProcessPhotonCandidates()
       if( (isNegFromMBHeader+isPosFromMBHeader) != 4) fIsFromSelectedHeader = kFALSE;
     }
   
-    if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->PhotonIsSelected(PhotonCandidate,fInputEvent)) continue;
+    if(!IsPhotonSelected(PhotonCandidate,i)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->InPlaneOutOfPlaneCut(PhotonCandidate->GetPhotonPhi(),fEventPlaneAngle)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseElecSharingCut() &&
       !((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseToCloseV0sCut()){
@@ -2860,6 +2914,11 @@ void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
 
   // Conversion Gammas
   if(fGammaCandidates->GetEntries()>1){
+    // position of the candidates in the reader list, a pair of reader photons is one entry of the meson decision table
+    std::vector<Int_t> readerIndex;
+    if(fMesonCutDecisions){
+      for(Int_t i=0;i<fGammaCandidates->GetEntries();i++) readerIndex.push_back(fReaderGammas->IndexOf(fGammaCandidates->At(i)));
+    }
     for(Int_t firstGammaIndex=0;firstGammaIndex<fGammaCandidates->GetEntries()-1;firstGammaIndex++){
       AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fGammaCandidates->At(firstGammaIndex));
       if (gamma0==NULL) continue;
@@ -2875,8 +2934,11 @@ void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
         AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
         pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
         pi0cand->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+        Int_t mesonIndex = -1;
+        if(fMesonCutDecisions && readerIndex[firstGammaIndex] >= 0 && readerIndex[secondGammaIndex] >= 0)
+          mesonIndex = readerIndex[firstGammaIndex]*fReaderGammas->GetEntriesFast()+readerIndex[secondGammaIndex];
         
-        if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
+        if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),fMesonCutDecisions,mesonIndex,fiCut))){
           if(fDoCentralityFlat > 0){
             fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
             if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[fiCut]->Fill(pi0cand->M(),pi0cand->E(), fWeightCentrality[fiCut]*fWeightJetJetMC);
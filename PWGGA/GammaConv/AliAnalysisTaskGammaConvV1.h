@@ -10,6 +10,7 @@
 #include "AliGammaConversionAODBGHandler.h"
 #include "AliConversionAODBGHandlerRP.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionCutDecisionTable.h"
 #include "AliAnalysisManager.h"
 #include "TProfile2D.h"
 #include "TH3.h"
@@ -43,7 +44,9 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     void SetDoPlotVsCentrality(Bool_t flag)                       { fDoPlotVsCentrality         = flag    ;}
     void SetDoTHnSparse(Bool_t flag)                              { fDoTHnSparse                = flag    ;}
     void SetDoCentFlattening(Int_t flag)                          { fDoCentralityFlat           = flag    ;}
+    void SetSharePhotonCutDecisions(Bool_t flag)                  { fSharePhotonCutDecisions    = flag    ;}
     void ProcessPhotonCandidates();
+    Bool_t IsPhotonSelected(AliAODConversionPhoton *photon, Int_t index);
     void ProcessClusters();
     void CalculatePi0Candidates();
     void CalculateBackground();
@@ -302,12 +305,15 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     Bool_t                            fDoMaterialBudgetWeightingOfGammasForTrueMesons;
     TTree*                            tBrokenFiles;                               // tree for keeping track of broken files
     TObjString*                       fFileNameBroken;                            // string object for broken file name
+    Bool_t                            fSharePhotonCutDecisions;                   // evaluate identical photon and meson cuts only once per candidate
+    AliConversionCutDecisionTable*    fPhotonCutDecisions;                        //! photon cut decisions shared between cut configurations
+    AliConversionCutDecisionTable*    fMesonCutDecisions;                         //! meson cut decisions shared between cut configurations
 
   private:
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 40);
+    ClassDef(AliAnalysisTaskGammaConvV1, 42);
 };
 
 #endif
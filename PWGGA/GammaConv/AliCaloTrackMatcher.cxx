@@ -36,6 +36,7 @@
 #include "TH1F.h"
 #include "TF1.h"
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <utility>
@@ -47,6 +48,131 @@ using namespace std;
 
 ClassImp(AliCaloTrackMatcher)
 
+//________________________________________________________________________
+// Flat table of the track <-> cluster matches of one event (structure of
+// arrays). Entries are appended while matching; the lookups by cluster ID
+// and by track go through (key, entry) index arrays which are sorted on the
+// first lookup after an insertion. Entries with equal key stay in insertion
+// order, i.e. in the order the former multimaps returned them.
+class AliCaloTrackMatchTable {
+  public:
+    AliCaloTrackMatchTable() : fTrackKey(), fTrackID(), fClusterID(), fDEta(), fDPhi(), fTrackPt(), fTrackCharge(), fByCluster(), fByTrack(), fSorted(kTRUE) {}
+
+    void Clear(){
+      fTrackKey.clear(); fTrackID.clear(); fClusterID.clear();
+      fDEta.clear(); fDPhi.clear(); fTrackPt.clear(); fTrackCharge.clear();
+      fByCluster.clear(); fByTrack.clear();
+      fSorted = kTRUE;
+    }
+
+    void Add(Int_t trackKey, Int_t trackID, Int_t clusterID, Float_t dEta, Float_t dPhi, Double_t trackPt, Short_t trackCharge){
+      fTrackKey.push_back(trackKey); fTrackID.push_back(trackID); fClusterID.push_back(clusterID);
+      fDEta.push_back(dEta); fDPhi.push_back(dPhi); fTrackPt.push_back(trackPt); fTrackCharge.push_back(trackCharge);
+      fSorted = kFALSE;
+    }
+
+    Int_t GetNEntries() const {return fClusterID.size();}
+
+    // range of entries of a cluster resp. of a track in fByCluster resp. fByTrack, returns number of entries
+    Int_t FindCluster(Int_t clusterID, Int_t &first){Sort(); return FindKey(fByCluster, clusterID, first);}
+    Int_t FindTrack(Int_t trackKey, Int_t &first){Sort(); return FindKey(fByTrack, trackKey, first);}
+
+    // residuals of a (track ID, cluster ID) combination; the last inserted entry wins, as for the former index map
+    Bool_t GetResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
+      Int_t first = 0;
+      for(Int_t i = FindCluster(clusterID, first) - 1; i >= 0; i--){
+        Int_t entry = fByCluster[first+i].second;
+        if(fTrackID[entry] != trackID) continue;
+        dEta = fDEta[entry];
+        dPhi = fDPhi[entry];
+        return kTRUE;
+      }
+      return kFALSE;
+    }
+
+    vector<Int_t>    fTrackKey;     // track position in event (AOD) or track ID (ESD), as used for the lookups by track
+    vector<Int_t>    fTrackID;      // track ID
+    vector<Int_t>    fClusterID;    // cluster ID
+    vector<Float_t>  fDEta;         // matching residual in eta
+    vector<Float_t>  fDPhi;         // matching residual in phi
+    vector<Double_t> fTrackPt;      // track pT, for the pT dependent matching windows
+    vector<Short_t>  fTrackCharge;  // track charge
+    vector<pair<Int_t,Int_t> > fByCluster; // (cluster ID, entry) sorted
+    vector<pair<Int_t,Int_t> > fByTrack;   // (track key, entry) sorted
+
+    void Sort(){
+      if(fSorted) return;
+      Int_t n = fClusterID.size();
+      fByCluster.resize(n);
+      fByTrack.resize(n);
+      for(Int_t i = 0; i < n; i++){
+        fByCluster[i] = make_pair(fClusterID[i],i);
+        fByTrack[i] = make_pair(fTrackKey[i],i);
+      }
+      sort(fByCluster.begin(),fByCluster.end());
+      sort(fByTrack.begin(),fByTrack.end());
+      fSorted = kTRUE;
+    }
+
+  private:
+    static Int_t FindKey(const vector<pair<Int_t,Int_t> > &index, Int_t key, Int_t &first){
+      vector<pair<Int_t,Int_t> >::const_iterator it = lower_bound(index.begin(),index.end(),make_pair(key,-1));
+      first = it - index.begin();
+      Int_t n = 0;
+      for(; it != index.end() && it->first == key; ++it) n++;
+      return n;
+    }
+
+    Bool_t fSorted;                 // index arrays are up to date
+};
+
+//________________________________________________________________________
+// Matching windows of the GetNMatched.../GetMatched... methods
+enum EMatchWindow { kWindowEtaPhi = 0, kWindowPtDep, kWindowR };
+
+//________________________________________________________________________
+// Apply a matching window to a range of entries of the index array of a match
+// table. Residuals are taken from resTable for the (track ID, cluster ID) of
+// each entry - the primary table, also for V0-tracks, as before. Returns the
+// number of accepted entries and, if ids is given, fills their cluster IDs
+// (returnClusters) or track keys.
+// The flip of the phi window for negative tracks is applied to the window
+// itself and so carries over to the following entries, as in the original
+// per-method loops.
+static Int_t SelectMatches(AliCaloTrackMatchTable *table, const vector<pair<Int_t,Int_t> > &index, Int_t first, Int_t n,
+                           AliCaloTrackMatchTable *resTable, Bool_t returnClusters, EMatchWindow window,
+                           Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin,
+                           TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, Float_t dR, vector<Int_t> *ids){
+  Int_t matched = 0;
+  for(Int_t i = first; i < first + n; i++){
+    Int_t entry = index[i].second;
+    Float_t tempDEta, tempDPhi;
+    if(!resTable->GetResidual(table->fTrackID[entry],table->fClusterID[entry],tempDEta,tempDPhi)) continue;
+
+    Bool_t match = kFALSE;
+    if(window == kWindowEtaPhi){
+      Short_t charge = table->fTrackCharge[entry];
+      if(charge>0){
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) match = kTRUE;
+      }else if(charge<0){
+        dPhiMin*=-1;
+        dPhiMax*=-1;
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) match = kTRUE;
+      }
+    }else if(window == kWindowPtDep){
+      Double_t pt = table->fTrackPt[entry];
+      match = TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(pt) && TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(pt);
+    }else{
+      match = TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR;
+    }
+    if(!match) continue;
+
+    matched++;
+    if(ids) ids->push_back(returnClusters ? table->fClusterID[entry] : table->fTrackKey[entry]);
+  }
+  return matched;
+}
+
 //________________________________________________________________________
 AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType) : AliAnalysisTaskSE(name),
   fClusterType(clusterType),
@@ -56,16 +182,10 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType) :
   fRunNumber(-1),
   fGeomEMCAL(NULL),
   fGeomPHOS(NULL),
-  fMapTrackToCluster(),
-  fMapClusterToTrack(),
-  fNEntries(1),
-  fVectorDeltaEtaDeltaPhi(0),
-  fMap_TrID_ClID_ToIndex(),
-  fSecMapTrackToCluster(),
-  fSecMapClusterToTrack(),
-  fSecNEntries(1),
-  fSecVectorDeltaEtaDeltaPhi(0),
-  fSecMap_TrID_ClID_ToIndex(),
+  fMatchTable(NULL),
+  fTrackIDToPosition(),
+  fHasTrackPositions(kFALSE),
+  fSecMatchTable(NULL),
   fSecMap_TrID_ClID_AlreadyTried(),
   fListHistos(NULL),
   fHistControlMatches(NULL),
@@ -73,20 +193,17 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType) :
 {
     // Default constructor
     DefineInput(0, TChain::Class());
+    fMatchTable = new AliCaloTrackMatchTable();
+    fSecMatchTable = new AliCaloTrackMatchTable();
 }
 
 //________________________________________________________________________
 AliCaloTrackMatcher::~AliCaloTrackMatcher(){
     // default deconstructor
-    fMapTrackToCluster.clear();
-    fMapClusterToTrack.clear();
-    fVectorDeltaEtaDeltaPhi.clear();
-    fMap_TrID_ClID_ToIndex.clear();
-
-    fSecMapTrackToCluster.clear();
-    fSecMapClusterToTrack.clear();
-    fSecVectorDeltaEtaDeltaPhi.clear();
-    fSecMap_TrID_ClID_ToIndex.clear();
+    delete fMatchTable;
+    fTrackIDToPosition.clear();
+
+    delete fSecMatchTable;
     fSecMap_TrID_ClID_AlreadyTried.clear();
 
     if(fHistControlMatches) delete fHistControlMatches;
@@ -98,15 +215,11 @@ AliCaloTrackMatcher::~AliCaloTrackMatcher(){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::Terminate(Option_t *){
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
-  fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
-
-  fSecMapTrackToCluster.clear();
-  fSecMapClusterToTrack.clear();
-  fSecVectorDeltaEtaDeltaPhi.clear();
-  fSecMap_TrID_ClID_ToIndex.clear();
+  fMatchTable->Clear();
+  fTrackIDToPosition.clear();
+  fHasTrackPositions = kFALSE;
+
+  fSecMatchTable->Clear();
   fSecMap_TrID_ClID_AlreadyTried.clear();
 }
 
@@ -151,17 +264,11 @@ void AliCaloTrackMatcher::UserCreateOutputObjects(){
 //________________________________________________________________________
 void AliCaloTrackMatcher::Initialize(Int_t runNumber){
   // Initialize function to be called once before analysis
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
-  fNEntries = 1;
-  fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
-
-  fSecMapTrackToCluster.clear();
-  fSecMapClusterToTrack.clear();
-  fSecNEntries = 1;
-  fSecVectorDeltaEtaDeltaPhi.clear();
-  fSecMap_TrID_ClID_ToIndex.clear();
+  fMatchTable->Clear();
+  fTrackIDToPosition.clear();
+  fHasTrackPositions = kFALSE;
+
+  fSecMatchTable->Clear();
   fSecMap_TrID_ClID_AlreadyTried.clear();
 
   if(fRunNumber == -1 || fRunNumber != runNumber){
@@ -226,6 +333,7 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     } else if(aodev) {
       inTrack = dynamic_cast<AliVTrack*>(aodev->GetTrack(itr));
       if(!inTrack) continue;
+      fTrackIDToPosition.push_back(make_pair(inTrack->GetID(),itr));
       fHistControlMatches->Fill(0.,inTrack->Pt());
       AliAODTrack *aodt = dynamic_cast<AliAODTrack*>(inTrack);
 
@@ -322,25 +430,44 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       if(dR2 > fMatchingResidual) continue;
 //cout << "MATCHED!!!!!!!" << endl;
       nClusterMatchesToTrack++;
-      if(aodev){
-        fMapTrackToCluster.insert(make_pair(itr,cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),itr));
-      }else{
-        fMapTrackToCluster.insert(make_pair(inTrack->GetID(),cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),inTrack->GetID()));
-      }
-      fVectorDeltaEtaDeltaPhi.push_back(make_pair(dEta,dPhi));
-      fMap_TrID_ClID_ToIndex[make_pair(inTrack->GetID(),cluster->GetID())] = fNEntries++;
-      if( (Int_t)fVectorDeltaEtaDeltaPhi.size() != (fNEntries-1)) AliFatal("Fatal error in AliCaloTrackMatcher, vector and map are not in sync!");
+      fMatchTable->Add(aodev ? itr : inTrack->GetID(), inTrack->GetID(), cluster->GetID(), dEta, dPhi, inTrack->Pt(), inTrack->Charge());
     }
     if(nClusterMatchesToTrack == 0) fHistControlMatches->Fill(5.,inTrack->Pt());
     else fHistControlMatches->Fill(6.,inTrack->Pt());
     delete trackParam;
   }
 
+  if(aodev){
+    sort(fTrackIDToPosition.begin(),fTrackIDToPosition.end());
+    fHasTrackPositions = kTRUE;
+  }
+
   return;
 }
 
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetTrackPosition(AliVEvent *event, Int_t trackID, const char *caller){
+  // position of a track in the event; for ESD this is the track ID, for AOD
+  // the first track with this ID
+  if(event->IsA()!=AliAODEvent::Class()) return trackID;
+
+  Int_t TrackPos = -1;
+  if(fHasTrackPositions){
+    vector<pairInt>::const_iterator it = lower_bound(fTrackIDToPosition.begin(),fTrackIDToPosition.end(),make_pair(trackID,-1));
+    if(it != fTrackIDToPosition.end() && it->first == trackID) TrackPos = it->second;
+  }else{
+    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
+      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
+      if(currTrack->GetID() == trackID){
+        TrackPos = iTrack;
+        break;
+      }
+    }
+  }
+  if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: %s - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",caller,trackID));
+  return TrackPos;
+}
+
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliVTrack* inSecTrack, AliVCluster* cluster, AliVEvent* event, Float_t &dEta, Float_t &dPhi){
 
@@ -480,26 +607,9 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
     }
 //cout << "MATCHED!!!!!!!" << endl;
 
-    if(aodev){
-      //need to search for position in case of AOD
-      Int_t TrackPos = -1;
-      for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-        AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-        if(currTrack->GetID() == inSecTrack->GetID()){
-          TrackPos = iTrack;
-          break;
-        }
-      }
-      if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: PropagateV0TrackToClusterAndGetMatchingResidual - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",inSecTrack->GetID()));
-      fSecMapTrackToCluster.insert(make_pair(TrackPos,cluster->GetID()));
-      fSecMapClusterToTrack.insert(make_pair(cluster->GetID(),TrackPos));
-    }else{
-      fSecMapTrackToCluster.insert(make_pair(inSecTrack->GetID(),cluster->GetID()));
-      fSecMapClusterToTrack.insert(make_pair(cluster->GetID(),inSecTrack->GetID()));
-    }
-    fSecVectorDeltaEtaDeltaPhi.push_back(make_pair(dEtaTemp,dPhiTemp));
-    fSecMap_TrID_ClID_ToIndex[make_pair(inSecTrack->GetID(),cluster->GetID())] = fSecNEntries++;
-    if( (Int_t)fSecVectorDeltaEtaDeltaPhi.size() != (fSecNEntries-1)) AliFatal("Fatal error in AliCaloTrackMatcher, vector and map are not in sync!");
+    //need to search for position in case of AOD
+    Int_t TrackPos = aodev ? GetTrackPosition(event,inSecTrack->GetID(),"PropagateV0TrackToClusterAndGetMatchingResidual") : inSecTrack->GetID();
+    fSecMatchTable->Add(TrackPos, inSecTrack->GetID(), cluster->GetID(), dEtaTemp, dPhiTemp, inSecTrack->Pt(), inSecTrack->Charge());
 
     fSecHistControlMatches->Fill(6.,inSecTrack->Pt());
     dEta = dEtaTemp;
@@ -519,348 +629,107 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
-
-  pairFloat tempEtaPhi = fVectorDeltaEtaDeltaPhi.at(position-1);
-  dEta = tempEtaPhi.first;
-  dPhi = tempEtaPhi.second;
-  return kTRUE;
+  return fMatchTable->GetResidual(trackID, clusterID, dEta, dPhi);
 }
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
-    }
-  }
-
-  return matched;
+Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindCluster(clusterID, first);
+  return SelectMatches(fMatchTable, fMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowEtaPhi, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL, NULL, 0., NULL);
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-        
-        if (match_dPhi && match_dEta )matched++;
-      }
-    }
-  }
-  return matched;
+Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindCluster(clusterID, first);
+  return SelectMatches(fMatchTable, fMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowPtDep, 0., 0., 0., 0., fFuncPtDepEta, fFuncPtDepPhi, 0., NULL);
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
-    }
-  }
-  return matched;
+Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *, Int_t clusterID, Float_t dR){
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindCluster(clusterID, first);
+  return SelectMatches(fMatchTable, fMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowR, 0., 0., 0., 0., NULL, NULL, dR, NULL);
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
-    }
-  }
-  return matched;
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindTrack(TrackPos, first);
+  return SelectMatches(fMatchTable, fMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowEtaPhi, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL, NULL, 0., NULL);
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-        
-        if (match_dPhi && match_dEta )matched++;
-
-      }
-    }
-  }
-  return matched;
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindTrack(TrackPos, first);
+  return SelectMatches(fMatchTable, fMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowPtDep, 0., 0., 0., 0., fFuncPtDepEta, fFuncPtDepPhi, 0., NULL);
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
-    }
-  }
-  return matched;
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindTrack(TrackPos, first);
+  return SelectMatches(fMatchTable, fMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowR, 0., 0., 0., 0., NULL, NULL, dR, NULL);
 }
 
 //________________________________________________________________________
-vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
+vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }
-      }
-    }
-  }
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindCluster(clusterID, first);
+  SelectMatches(fMatchTable, fMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowEtaPhi, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL, NULL, 0., &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
-vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
+vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-        
-        if (match_dPhi && match_dEta )tempMatchedTracks.push_back(it->second);
-
-      }
-    }
-  }
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindCluster(clusterID, first);
+  SelectMatches(fMatchTable, fMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowPtDep, 0., 0., 0., 0., fFuncPtDepEta, fFuncPtDepPhi, 0., &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
-vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  Float_t dR){
+vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *, Int_t clusterID, Float_t dR){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(it->second);
-      }
-    }
-  }
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindCluster(clusterID, first);
+  SelectMatches(fMatchTable, fMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowR, 0., 0., 0., 0., NULL, NULL, dR, &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }
-      }
-    }
-  }
-
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindTrack(TrackPos, first);
+  SelectMatches(fMatchTable, fMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowEtaPhi, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL, NULL, 0., &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-        
-        if (match_dPhi && match_dEta )tempMatchedClusters.push_back(it->second);
-      }
-    }
-  }
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindTrack(TrackPos, first);
+  SelectMatches(fMatchTable, fMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowPtDep, 0., 0., 0., 0., fFuncPtDepEta, fFuncPtDepPhi, 0., &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(it->second);
-      }
-    }
-  }
+  Int_t first = 0;
+  Int_t n = fMatchTable->FindTrack(TrackPos, first);
+  SelectMatches(fMatchTable, fMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowR, 0., 0., 0., 0., NULL, NULL, dR, &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
@@ -870,362 +739,113 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetSecTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fSecMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
-
-  pairFloat tempEtaPhi = fSecVectorDeltaEtaDeltaPhi.at(position-1);
-  dEta = tempEtaPhi.first;
-  dPhi = tempEtaPhi.second;
-  return kTRUE;
+  return fSecMatchTable->GetResidual(trackID, clusterID, dEta, dPhi);
 }
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::IsSecTrackClusterAlreadyTried(Int_t trackID, Int_t clusterID){
-  Int_t position = fSecMap_TrID_ClID_AlreadyTried[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  mapT::const_iterator it = fSecMap_TrID_ClID_AlreadyTried.find(make_pair(trackID,clusterID));
+  if(it == fSecMap_TrID_ClID_AlreadyTried.end() || it->second == 0) return kFALSE;
   else return kTRUE;
 }
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
-    }
-  }
-
-  return matched;
+Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindCluster(clusterID, first);
+  return SelectMatches(fSecMatchTable, fSecMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowEtaPhi, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL, NULL, 0., NULL);
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-        
-        if (match_dPhi && match_dEta )matched++;
-      }
-    }
-  }
-
-  return matched;
+Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindCluster(clusterID, first);
+  return SelectMatches(fSecMatchTable, fSecMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowPtDep, 0., 0., 0., 0., fFuncPtDepEta, fFuncPtDepPhi, 0., NULL);
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
-    }
-  }
-
-  return matched;
+Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *, Int_t clusterID, Float_t dR){
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindCluster(clusterID, first);
+  return SelectMatches(fSecMatchTable, fSecMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowR, 0., 0., 0., 0., NULL, NULL, dR, NULL);
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
-    }
-  }
-
-  return matched;
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindTrack(TrackPos, first);
+  return SelectMatches(fSecMatchTable, fSecMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowEtaPhi, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL, NULL, 0., NULL);
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-        
-        if (match_dPhi && match_dEta )matched++;
-
-      }
-    }
-  }
-
-  return matched;
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindTrack(TrackPos, first);
+  return SelectMatches(fSecMatchTable, fSecMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowPtDep, 0., 0., 0., 0., fFuncPtDepEta, fFuncPtDepPhi, 0., NULL);
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
-    }
-  }
-
-  return matched;
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindTrack(TrackPos, first);
+  return SelectMatches(fSecMatchTable, fSecMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowR, 0., 0., 0., 0., NULL, NULL, dR, NULL);
 }
 
 //________________________________________________________________________
-vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
+vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }
-      }
-    }
-  }
-
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindCluster(clusterID, first);
+  SelectMatches(fSecMatchTable, fSecMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowEtaPhi, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL, NULL, 0., &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
-vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
+vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-        
-        if (match_dPhi && match_dEta )tempMatchedTracks.push_back(it->second);
-      }
-    }
-  }
-
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindCluster(clusterID, first);
+  SelectMatches(fSecMatchTable, fSecMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowPtDep, 0., 0., 0., 0., fFuncPtDepEta, fFuncPtDepPhi, 0., &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
-vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
+vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *, Int_t clusterID, Float_t dR){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(it->second);
-      }
-    }
-  }
-
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindCluster(clusterID, first);
+  SelectMatches(fSecMatchTable, fSecMatchTable->fByCluster, first, n, fMatchTable, kFALSE, kWindowR, 0., 0., 0., 0., NULL, NULL, dR, &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }
-      }
-    }
-  }
-
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindTrack(TrackPos, first);
+  SelectMatches(fSecMatchTable, fSecMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowEtaPhi, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL, NULL, 0., &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-        
-        if (match_dPhi && match_dEta )tempMatchedClusters.push_back(it->second);
-      }
-    }
-  }
-
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindTrack(TrackPos, first);
+  SelectMatches(fSecMatchTable, fSecMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowPtDep, 0., 0., 0., 0., fFuncPtDepEta, fFuncPtDepPhi, 0., &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+  Int_t TrackPos = GetTrackPosition(event, trackID, "GetNMatchedClusterIDsForTrack");
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(it->second);
-      }
-    }
-  }
-
+  Int_t first = 0;
+  Int_t n = fSecMatchTable->FindTrack(TrackPos, first);
+  SelectMatches(fSecMatchTable, fSecMatchTable->fByTrack, first, n, fMatchTable, kTRUE, kWindowR, 0., 0., 0., 0., NULL, NULL, dR, &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
@@ -1263,18 +883,16 @@ void AliCaloTrackMatcher::SetLogBinningYTH2(TH2* histoRebin){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::DebugV0Matching(){
-  if(fSecVectorDeltaEtaDeltaPhi.size()>0){
+  if(fSecMatchTable->GetNEntries()>0){
     cout << "******************************" << endl;
     cout << "******************************" << endl;
     cout << "NEW EVENT !" << endl;
-    cout << "vector etaphi:" << endl;
-    cout << fSecVectorDeltaEtaDeltaPhi.size() << endl;
-    cout << "multimap" << endl;
-    mapT::iterator iter = fSecMap_TrID_ClID_ToIndex.begin();
-    for (iter = fSecMap_TrID_ClID_ToIndex.begin(); iter != fSecMap_TrID_ClID_ToIndex.end(); ++iter){
-      Float_t dEta, dPhi = 0;
-      if(!GetSecTrackClusterMatchingResidual(iter->first.first,iter->first.second,dEta,dPhi)) continue;
-      cout << "  [" << iter->first.first << "/" << iter->first.second << ", " << iter->second << "] - (" << dEta << "/" << dPhi << ")" << endl;
+    cout << "match table:" << endl;
+    cout << fSecMatchTable->GetNEntries() << endl;
+    for (Int_t i = 0; i < fSecMatchTable->GetNEntries(); i++){
+      Float_t dEta = 0, dPhi = 0;
+      if(!GetSecTrackClusterMatchingResidual(fSecMatchTable->fTrackID[i],fSecMatchTable->fClusterID[i],dEta,dPhi)) continue;
+      cout << "  [" << fSecMatchTable->fTrackID[i] << "/" << fSecMatchTable->fClusterID[i] << ", " << i << "] - (" << dEta << "/" << dPhi << ")" << endl;
     }
     cout << "mapTrackToCluster" << endl;
     AliESDEvent *esdev = dynamic_cast<AliESDEvent*>(fInputEvent);
@@ -1287,13 +905,13 @@ void AliCaloTrackMatcher::DebugV0Matching(){
       cout << itr << " (" << tCharge << ") - " << GetNMatchedClusterIDsForSecTrack(fInputEvent,inTrack->GetID(),5,-5,0.2,-0.4) << "\t\t";
     }
     cout << endl;
-    multimap<Int_t,Int_t>::iterator it;
-    for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    fSecMatchTable->Sort();
+    for (Int_t i = 0; i < fSecMatchTable->GetNEntries(); i++) cout << fSecMatchTable->fByTrack[i].first << " => " << fSecMatchTable->fClusterID[fSecMatchTable->fByTrack[i].second] << '\n';
     cout << "mapClusterToTrack" << endl;
-    Int_t tempClus = it->second;
-    for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    Int_t tempClus = fSecMatchTable->fByCluster[0].first;
+    for (Int_t i = 0; i < fSecMatchTable->GetNEntries(); i++) cout << fSecMatchTable->fByCluster[i].first << " => " << fSecMatchTable->fTrackKey[fSecMatchTable->fByCluster[i].second] << '\n';
     vector<Int_t> tempTracks = GetMatchedSecTrackIDsForCluster(fInputEvent,tempClus, 5, -5, 0.2, -0.4);
-    for(Int_t iJ=0; iJ<tempTracks.size();iJ++){
+    for(Int_t iJ=0; iJ<(Int_t)tempTracks.size();iJ++){
       cout << tempClus << " - " << tempTracks.at(iJ) << endl;
     }
   }
@@ -1302,18 +920,16 @@ void AliCaloTrackMatcher::DebugV0Matching(){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::DebugMatching(){
-  if(fVectorDeltaEtaDeltaPhi.size()>0){
+  if(fMatchTable->GetNEntries()>0){
     cout << "******************************" << endl;
     cout << "******************************" << endl;
     cout << "NEW EVENT !" << endl;
-    cout << "vector etaphi:" << endl;
-    cout << fVectorDeltaEtaDeltaPhi.size() << endl;
-    cout << "multimap" << endl;
-    mapT::iterator iter = fMap_TrID_ClID_ToIndex.begin();
-    for (iter = fMap_TrID_ClID_ToIndex.begin(); iter != fMap_TrID_ClID_ToIndex.end(); ++iter){
-      Float_t dEta, dPhi = 0;
-      if(!GetTrackClusterMatchingResidual(iter->first.first,iter->first.second,dEta,dPhi)) continue;
-      cout << "  [" << iter->first.first << "/" << iter->first.second << ", " << iter->second << "] - (" << dEta << "/" << dPhi << ")" << endl;
+    cout << "match table:" << endl;
+    cout << fMatchTable->GetNEntries() << endl;
+    for (Int_t i = 0; i < fMatchTable->GetNEntries(); i++){
+      Float_t dEta = 0, dPhi = 0;
+      if(!GetTrackClusterMatchingResidual(fMatchTable->fTrackID[i],fMatchTable->fClusterID[i],dEta,dPhi)) continue;
+      cout << "  [" << fMatchTable->fTrackID[i] << "/" << fMatchTable->fClusterID[i] << ", " << i << "] - (" << dEta << "/" << dPhi << ")" << endl;
     }
     cout << "mapTrackToCluster" << endl;
     AliESDEvent *esdev = dynamic_cast<AliESDEvent*>(fInputEvent);
@@ -1326,13 +942,13 @@ void AliCaloTrackMatcher::DebugMatching(){
       cout << itr << " (" << tCharge << ") - " << GetNMatchedClusterIDsForTrack(fInputEvent,inTrack->GetID(),5,-5,0.2,-0.4) << "\t\t";
     }
     cout << endl;
-    multimap<Int_t,Int_t>::iterator it;
-    for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    fMatchTable->Sort();
+    for (Int_t i = 0; i < fMatchTable->GetNEntries(); i++) cout << fMatchTable->fByTrack[i].first << " => " << fMatchTable->fClusterID[fMatchTable->fByTrack[i].second] << '\n';
     cout << "mapClusterToTrack" << endl;
-    Int_t tempClus = it->second;
-    for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    Int_t tempClus = fMatchTable->fByCluster[0].first;
+    for (Int_t i = 0; i < fMatchTable->GetNEntries(); i++) cout << fMatchTable->fByCluster[i].first << " => " << fMatchTable->fTrackKey[fMatchTable->fByCluster[i].second] << '\n';
     vector<Int_t> tempTracks = GetMatchedTrackIDsForCluster(fInputEvent,tempClus, 5, -5, 0.2, -0.4);
-    for(Int_t iJ=0; iJ<tempTracks.size();iJ++){
+    for(Int_t iJ=0; iJ<(Int_t)tempTracks.size();iJ++){
       cout << tempClus << " - " << tempTracks.at(iJ) << endl;
     }
   }
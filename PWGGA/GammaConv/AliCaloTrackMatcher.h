@@ -9,6 +9,7 @@
 #include <utility>
 
 class TF1;
+class AliCaloTrackMatchTable;
 
 using namespace std;
 
@@ -86,6 +87,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     void Initialize(Int_t runNumber);
     void ProcessEvent(AliVEvent *event);
     void SetLogBinningYTH2(TH2* histoRebin);
+    Int_t GetTrackPosition(AliVEvent *event, Int_t trackID, const char *caller);
 
     // debug methods
     void DebugMatching();
@@ -101,20 +103,13 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     AliEMCALGeometry*     fGeomEMCAL;              // pointer to EMCAL geometry
     AliPHOSGeometry*      fGeomPHOS;               // pointer to PHOS geometry
 
-    multimap<Int_t,Int_t> fMapTrackToCluster;      // connects a given track ID with all associated cluster IDs
-    multimap<Int_t,Int_t> fMapClusterToTrack;      // connects a given cluster ID with all associated track IDs
-
-    Int_t                 fNEntries;               // number of current TrackID/ClusterID -> Eta/Phi connections
-    vector<pairFloat>     fVectorDeltaEtaDeltaPhi; // vector of all matching residuals for a specific TrackID/ClusterID
-    mapT                  fMap_TrID_ClID_ToIndex;  // map tuple of (trackID,clusterID) to index in vector fVectorDeltaEtaDeltaPhi
+    // track <-> cluster matches of the current event, as flat table sorted by cluster ID and by track
+    AliCaloTrackMatchTable* fMatchTable;           //! matches with residuals, track pT and charge
+    vector<pairInt>       fTrackIDToPosition;      //! (track ID, position in event) of all AOD tracks, sorted by ID
+    Bool_t                fHasTrackPositions;      //! fTrackIDToPosition is filled for the current event
 
     // for cluster <-> V0-track matching (running with different mass hypthesis)
-    multimap<Int_t,Int_t> fSecMapTrackToCluster;      // connects a given secondary track ID with all associated cluster IDs
-    multimap<Int_t,Int_t> fSecMapClusterToTrack;      // connects a given cluster ID with all associated secondary track IDs
-
-    Int_t                 fSecNEntries;               // number of current V0-trackIDs/clusterID -> Eta/Phi connections
-    vector<pairFloat>     fSecVectorDeltaEtaDeltaPhi; // vector of all matching residuals for a specific V0-trackIDs/clusterID
-    mapT                  fSecMap_TrID_ClID_ToIndex;  // map tuple of (V0-trackID,clusterID) to index in vector fSecVectorDeltaEtaDeltaPhi
+    AliCaloTrackMatchTable* fSecMatchTable;        //! matches of V0-tracks, filled on demand
     mapT                  fSecMap_TrID_ClID_AlreadyTried;  // map tuple of (V0-trackID,clusterID) to matching outcome, successful or not
 
     //histos
@@ -122,7 +117,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     TH2F*                 fHistControlMatches;     // bookkeeping for processed tracks/clusters and succesful matches
     TH2F*                 fSecHistControlMatches;  // bookkeeping for processed V0-tracks/clusters and succesful matches
 
-    ClassDef(AliCaloTrackMatcher,2)
+    ClassDef(AliCaloTrackMatcher,3)
 };
 
 #endif
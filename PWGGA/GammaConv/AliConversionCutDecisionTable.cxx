@@ -0,0 +1,167 @@
+/****************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.   *
+ *                                                                          *
+ * Authors: PWGGA GammaConv group                                           *
+ * Version 1.0                                                              *
+ *                                                                          *
+ * Permission to use, copy, modify and distribute this software and its     *
+ * documentation strictly for non-commercial purposes is hereby granted     *
+ * without fee, provided that the above copyright notice appears in all     *
+ * copies and that both the copyright notice and this permission notice     *
+ * appear in the supporting documentation. The authors make no claims       *
+ * about the suitability of this software for any purpose. It is            *
+ * provided "as is" without express or implied warranty.                    *
+ ***************************************************************************/
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Decision table for cut-variation sweeps:
+// each selection stage of a cut configuration
+// is mapped onto a cut atom, configurations with
+// the same stage key share the atom; decision,
+// detail and QA fills of an atom are cached per
+// candidate and event
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "AliConversionCutDecisionTable.h"
+#include "AliLog.h"
+
+ClassImp(AliConversionCutDecisionTable)
+
+//________________________________________________________________________
+AliConversionCutDecisionTable::AliConversionCutDecisionTable() :
+  TObject(),
+  fNStages(0),
+  fAtomOfConfig(),
+  fAtomStage(),
+  fAtomKey(),
+  fAtomMultiplicity(),
+  fDecisions(),
+  fDetails(),
+  fFillBegin(),
+  fFillEnd(),
+  fFillSlot(),
+  fFillX(),
+  fFillY(),
+  fRecordStart(0),
+  fNCandidates(0)
+{
+  // Default constructor
+}
+
+//________________________________________________________________________
+void AliConversionCutDecisionTable::Reset(){
+  // remove all configurations
+  fNStages = 0;
+  fAtomOfConfig.clear();
+  fAtomStage.clear();
+  fAtomKey.clear();
+  fAtomMultiplicity.clear();
+  ResetEvent(0);
+}
+
+//________________________________________________________________________
+Int_t AliConversionCutDecisionTable::AddConfiguration(const TString& key){
+  // register the next configuration with a single selection stage
+  std::vector<TString> stageKeys(1,key);
+  return AddConfiguration(stageKeys);
+}
+
+//________________________________________________________________________
+Int_t AliConversionCutDecisionTable::AddConfiguration(const std::vector<TString>& stageKeys){
+  // register the next configuration, returns its index
+  // a stage shares the atom of another configuration if it has exactly the same key
+  if (fNStages == 0) fNStages = stageKeys.size();
+  if ((Int_t)stageKeys.size() != fNStages || fNStages == 0){
+    AliError(Form("configuration with %d stages, table expects %d",(Int_t)stageKeys.size(),fNStages));
+    return -1;
+  }
+  for (Int_t iStage = 0; iStage < fNStages; iStage++){
+    Int_t atom = -1;
+    for (Int_t i = 0; i < GetNAtoms(); i++){
+      if (fAtomStage[i] == iStage && fAtomKey[i].CompareTo(stageKeys[iStage]) == 0){
+        atom = i;
+        break;
+      }
+    }
+    if (atom < 0){
+      atom = GetNAtoms();
+      fAtomStage.push_back(iStage);
+      fAtomKey.push_back(stageKeys[iStage]);
+      fAtomMultiplicity.push_back(0);
+    }
+    fAtomMultiplicity[atom]++;
+    fAtomOfConfig.push_back(atom);
+  }
+  return GetNConfigurations()-1;
+}
+
+//________________________________________________________________________
+Bool_t AliConversionCutDecisionTable::IsShared(Int_t iConfig) const {
+  // true if any stage of the configuration is shared with another one
+  for (Int_t iStage = 0; iStage < fNStages; iStage++){
+    if (fAtomMultiplicity[GetAtom(iConfig,iStage)] > 1) return kTRUE;
+  }
+  return kFALSE;
+}
+
+//________________________________________________________________________
+Bool_t AliConversionCutDecisionTable::HasSharedAtoms() const {
+  // true if at least one atom is used by more than one configuration
+  return GetNAtoms() < (Int_t)fAtomOfConfig.size();
+}
+
+//________________________________________________________________________
+void AliConversionCutDecisionTable::ResetEvent(Int_t nCandidates){
+  // forget the decisions and fills of the previous event
+  fNCandidates = nCandidates > 0 ? nCandidates : 0;
+  fDecisions.assign(fNCandidates*GetNAtoms(), (Short_t)kUnknown);
+  fDetails.assign(fNCandidates*GetNAtoms(), 0);
+  fFillBegin.assign(fNCandidates*GetNAtoms(), 0);
+  fFillEnd.assign(fNCandidates*GetNAtoms(), 0);
+  fFillSlot.clear();
+  fFillX.clear();
+  fFillY.clear();
+  fRecordStart = 0;
+}
+
+//________________________________________________________________________
+void AliConversionCutDecisionTable::SetDecision(Int_t iCand, Int_t iConfig, Bool_t accepted, Int_t iStage, Int_t detail){
+  // store the decision of the atom, the fills recorded since the previous decision belong to it
+  if (iCand < 0 || iCand >= fNCandidates){
+    fFillSlot.resize(fRecordStart);
+    fFillX.resize(fRecordStart);
+    fFillY.resize(fRecordStart);
+    return;
+  }
+  Int_t entry = GetEntry(iCand,iConfig,iStage);
+  fDecisions[entry] = accepted ? kAccepted : kRejected;
+  fDetails[entry]   = detail;
+  fFillBegin[entry] = fRecordStart;
+  fFillEnd[entry]   = fFillSlot.size();
+  fRecordStart      = fFillSlot.size();
+}
+
+//________________________________________________________________________
+void AliConversionCutDecisionTable::GetAcceptedMask(Int_t iCand, TBits& mask) const {
+  // set the bits of all configurations which accepted the candidate in all stages
+  mask.ResetAllBits();
+  if (iCand < 0 || iCand >= fNCandidates) return;
+  for (Int_t i = 0; i < GetNConfigurations(); i++){
+    Bool_t accepted = kTRUE;
+    for (Int_t iStage = 0; iStage < fNStages && accepted; iStage++){
+      if (fDecisions[GetEntry(iCand,i,iStage)] != kAccepted) accepted = kFALSE;
+    }
+    if (accepted) mask.SetBitNumber(i);
+  }
+}
+
+//________________________________________________________________________
+void AliConversionCutDecisionTable::Print(Option_t *) const {
+  // print the mapping of configurations onto atoms
+  AliInfo(Form("%d configurations with %d stages mapped onto %d cut atoms", GetNConfigurations(), fNStages, GetNAtoms()));
+  for (Int_t i = 0; i < GetNAtoms(); i++){
+    AliInfo(Form("atom %d (stage %d): %s used by %d configurations", i, fAtomStage[i], fAtomKey[i].Data(), fAtomMultiplicity[i]));
+  }
+}
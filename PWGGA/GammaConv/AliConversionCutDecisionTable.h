@@ -0,0 +1,114 @@
+#ifndef ALICONVERSIONCUTDECISIONTABLE_H
+#define ALICONVERSIONCUTDECISIONTABLE_H
+
+// Decision table shared between the cut configurations of a
+// cut-variation task. A selection is split into stages, each stage of
+// a configuration is mapped onto a cut atom keyed on the cut digits
+// (and settings) it depends on. Configurations differing in a digit of
+// one stage thus still share the atoms of the other stages, and each
+// candidate is evaluated only once per distinct atom in an event.
+// Per atom the table keeps the decision, a detail (e.g. the rejection
+// reason) and the QA histogram fills made while evaluating it, which
+// are replayed for the other configurations of the atom.
+
+#include "TObject.h"
+#include "TString.h"
+#include "TBits.h"
+#include <vector>
+
+class AliConversionCutDecisionTable : public TObject {
+
+  public:
+    enum EDecision_t {
+      kUnknown  = -1,
+      kRejected = 0,
+      kAccepted = 1
+    };
+
+    AliConversionCutDecisionTable();
+    virtual ~AliConversionCutDecisionTable() {}
+
+    void    Reset();
+    Int_t   AddConfiguration(const TString& key);
+    Int_t   AddConfiguration(const std::vector<TString>& stageKeys);
+    void    ResetEvent(Int_t nCandidates);
+
+    Int_t   GetNConfigurations() const        { return fNStages > 0 ? fAtomOfConfig.size()/fNStages : 0; }
+    Int_t   GetNStages() const                { return fNStages; }
+    Int_t   GetNAtoms() const                 { return fAtomKey.size(); }
+    Int_t   GetNCandidates() const            { return fNCandidates; }
+    Int_t   GetAtom(Int_t iConfig, Int_t iStage=0) const { return fAtomOfConfig[iConfig*fNStages+iStage]; }
+    Bool_t  IsShared(Int_t iConfig) const;
+    Bool_t  HasSharedAtoms() const;
+
+    Int_t   GetDecision(Int_t iCand, Int_t iConfig, Int_t iStage=0) const;
+    Int_t   GetDetail(Int_t iCand, Int_t iConfig, Int_t iStage=0) const;
+    void    SetDecision(Int_t iCand, Int_t iConfig, Bool_t accepted, Int_t iStage=0, Int_t detail=0);
+    void    GetAcceptedMask(Int_t iCand, TBits& mask) const;
+
+    // QA fills made while evaluating an atom, they are assigned to the next SetDecision
+    void    RecordFill(Int_t slot, Double_t x, Double_t y=0.);
+    Int_t   GetFillsBegin(Int_t iCand, Int_t iConfig, Int_t iStage=0) const;
+    Int_t   GetFillsEnd(Int_t iCand, Int_t iConfig, Int_t iStage=0) const;
+    Int_t   GetFillSlot(Int_t iFill) const    { return fFillSlot[iFill]; }
+    Double_t GetFillX(Int_t iFill) const      { return fFillX[iFill]; }
+    Double_t GetFillY(Int_t iFill) const      { return fFillY[iFill]; }
+
+    virtual void Print(Option_t* option = "") const;
+
+  private:
+    AliConversionCutDecisionTable(const AliConversionCutDecisionTable&);
+    AliConversionCutDecisionTable& operator=(const AliConversionCutDecisionTable&);
+
+    Int_t   GetEntry(Int_t iCand, Int_t iConfig, Int_t iStage) const { return iCand*GetNAtoms()+fAtomOfConfig[iConfig*fNStages+iStage]; }
+
+    Int_t                 fNStages;            //! number of selection stages per configuration
+    std::vector<Int_t>    fAtomOfConfig;       //! atom index for each configuration and stage
+    std::vector<Int_t>    fAtomStage;          //! stage of each atom
+    std::vector<TString>  fAtomKey;            //! selection key of each atom
+    std::vector<Int_t>    fAtomMultiplicity;   //! number of configurations per atom
+    std::vector<Short_t>  fDecisions;          //! decisions (EDecision_t) of current event, candidate major
+    std::vector<Short_t>  fDetails;            //! detail of each decision of current event
+    std::vector<Int_t>    fFillBegin;          //! first recorded fill of each decision
+    std::vector<Int_t>    fFillEnd;            //! end of the recorded fills of each decision
+    std::vector<Short_t>  fFillSlot;           //! histogram slot of each recorded fill
+    std::vector<Double_t> fFillX;              //! x value of each recorded fill
+    std::vector<Double_t> fFillY;              //! y value of each recorded fill
+    Int_t                 fRecordStart;        //! first fill not yet assigned to a decision
+    Int_t                 fNCandidates;        //! number of candidates in current event
+
+    ClassDef(AliConversionCutDecisionTable,2)
+};
+
+//________________________________________________________________________
+inline Int_t AliConversionCutDecisionTable::GetDecision(Int_t iCand, Int_t iConfig, Int_t iStage) const {
+  if (iCand < 0 || iCand >= fNCandidates) return kUnknown;
+  return fDecisions[GetEntry(iCand,iConfig,iStage)];
+}
+
+//________________________________________________________________________
+inline Int_t AliConversionCutDecisionTable::GetDetail(Int_t iCand, Int_t iConfig, Int_t iStage) const {
+  if (iCand < 0 || iCand >= fNCandidates) return 0;
+  return fDetails[GetEntry(iCand,iConfig,iStage)];
+}
+
+//________________________________________________________________________
+inline void AliConversionCutDecisionTable::RecordFill(Int_t slot, Double_t x, Double_t y) {
+  fFillSlot.push_back(slot);
+  fFillX.push_back(x);
+  fFillY.push_back(y);
+}
+
+//________________________________________________________________________
+inline Int_t AliConversionCutDecisionTable::GetFillsBegin(Int_t iCand, Int_t iConfig, Int_t iStage) const {
+  if (iCand < 0 || iCand >= fNCandidates) return 0;
+  return fFillBegin[GetEntry(iCand,iConfig,iStage)];
+}
+
+//________________________________________________________________________
+inline Int_t AliConversionCutDecisionTable::GetFillsEnd(Int_t iCand, Int_t iConfig, Int_t iStage) const {
+  if (iCand < 0 || iCand >= fNCandidates) return 0;
+  return fFillEnd[GetEntry(iCand,iConfig,iStage)];
+}
+
+#endif
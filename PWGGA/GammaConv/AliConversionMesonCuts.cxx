@@ -42,6 +42,7 @@
 #include "TPDGCode.h"
 #include "TDatabasePDG.h"
 #include "AliAODMCParticle.h"
+#include "AliConversionCutDecisionTable.h"
 
 class iostream;
 
@@ -130,7 +131,8 @@ AliConversionMesonCuts::AliConversionMesonCuts(const char *name,const char *titl
   fHistoDCAZMesonPrimVtxAfter(NULL),
   fHistoDCARMesonPrimVtxAfter(NULL),
   fHistoInvMassBefore(NULL),
-  fHistoInvMassAfter(NULL)
+  fHistoInvMassAfter(NULL),
+  fDecisionRecorder(NULL)
 {
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=0;}
   fCutString=new TObjString((GetCutNumber()).Data());
@@ -204,7 +206,8 @@ AliConversionMesonCuts::AliConversionMesonCuts(const AliConversionMesonCuts &ref
   fHistoDCAZMesonPrimVtxAfter(NULL),
   fHistoDCARMesonPrimVtxAfter(NULL),
   fHistoInvMassBefore(NULL),
-  fHistoInvMassAfter(NULL)
+  fHistoInvMassAfter(NULL),
+  fDecisionRecorder(NULL)
 {
   // Copy Constructor
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=ref.fCuts[jj];}
@@ -798,18 +801,19 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   // Use flag IsSignal in order to fill Fill different
   // histograms for Signal and Background
   TH2 *hist=0x0;
+  Int_t histSlot=kQAMesonCuts;
 
   if(IsSignal){hist=fHistoMesonCuts;}
-  else{hist=fHistoMesonBGCuts;}
+  else{hist=fHistoMesonBGCuts; histSlot=kQAMesonBGCuts;}
 
   Int_t cutIndex=0;
 
-  if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
   cutIndex++;
 
   // Undefined Rapidity -> Floating Point exception
   if((pi0->E()+pi0->Pz())/(pi0->E()-pi0->Pz())<=0){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+    if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
     cutIndex++;
     if (!IsSignal)cout << "undefined rapidity" << endl;
     return kFALSE;
@@ -818,13 +822,13 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
     // PseudoRapidity Cut --> But we cut on Rapidity !!!
     cutIndex++;
     if(TMath::Abs(pi0->Rapidity()-fRapidityShift)>fRapidityCutMeson){
-      if(hist)hist->Fill(cutIndex, pi0->Pt());
+      if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
       return kFALSE;
     }
   }
   cutIndex++;
 
-  if (fHistoInvMassBefore) fHistoInvMassBefore->Fill(pi0->M());
+  if (fHistoInvMassBefore) FillQAHisto(kQAInvMassBefore,pi0->M());
   // Mass cut
   if (fIsMergedClusterCut == 1 ){
     if (fEnableMassCut){
@@ -832,7 +836,7 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
       Double_t massMax = FunctionMaxMassCut(pi0->E());
   //     cout << "Min mass: " << massMin << "\t max Mass: " << massMax << "\t mass current: " <<  pi0->M()<< "\t E current: " << pi0->E() << endl;
       if (pi0->M() > massMax || pi0->M() < massMin ){
-        if(hist)hist->Fill(cutIndex, pi0->Pt());
+        if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
         return kFALSE;
       }
     }  
@@ -842,7 +846,7 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   // Opening Angle Cut
   //fOpeningAngle=2*TMath::ATan(0.134/pi0->P());// physical minimum opening angle
   if( fEnableMinOpeningAngleCut && pi0->GetOpeningAngle() < fOpeningAngle){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+    if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
     return kFALSE;
   }
 
@@ -850,7 +854,7 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   if (fMinOpanPtDepCut == kTRUE) fMinOpanCutMeson = fFMinOpanCut->Eval(pi0->Pt());
 
   if (pi0->GetOpeningAngle() < fMinOpanCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+    if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
     return kFALSE;
   }
 
@@ -858,7 +862,7 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   if (fMaxOpanPtDepCut == kTRUE) fMaxOpanCutMeson = fFMaxOpanCut->Eval(pi0->Pt());
 
   if( pi0->GetOpeningAngle() > fMaxOpanCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+    if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
     return kFALSE;
   }
   cutIndex++;
@@ -868,27 +872,27 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   else if (fAlphaPtDepCut == kTRUE) fAlphaCutMeson = fFAlphaCut->Eval(pi0->Pt());
   
   if(TMath::Abs(pi0->GetAlpha())>fAlphaCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+    if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
     return kFALSE;
   }
   cutIndex++;
 
   // Alpha Min Cut
   if(TMath::Abs(pi0->GetAlpha())<fAlphaMinCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+    if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
     return kFALSE;
   }
   cutIndex++;
 
-  if (fHistoInvMassAfter) fHistoInvMassAfter->Fill(pi0->M());
+  if (fHistoInvMassAfter) FillQAHisto(kQAInvMassAfter,pi0->M());
   
   if (fIsMergedClusterCut == 0){ 
-    if (fHistoDCAGGMesonBefore)fHistoDCAGGMesonBefore->Fill(pi0->GetDCABetweenPhotons());
-    if (fHistoDCARMesonPrimVtxBefore)fHistoDCARMesonPrimVtxBefore->Fill(pi0->GetDCARMotherPrimVtx());
+    if (fHistoDCAGGMesonBefore)FillQAHisto(kQADCAGGMesonBefore,pi0->GetDCABetweenPhotons());
+    if (fHistoDCARMesonPrimVtxBefore)FillQAHisto(kQADCARMesonPrimVtxBefore,pi0->GetDCARMotherPrimVtx());
 
     if (fDCAGammaGammaCutOn){
       if (pi0->GetDCABetweenPhotons() > fDCAGammaGammaCut){
-        if(hist)hist->Fill(cutIndex, pi0->Pt());
+        if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
         return kFALSE;
       }
     }  
@@ -896,31 +900,85 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
 
     if (fDCARMesonPrimVtxCutOn){
       if (pi0->GetDCARMotherPrimVtx() > fDCARMesonPrimVtxCut){
-        if(hist)hist->Fill(cutIndex, pi0->Pt());
+        if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
         return kFALSE;
       }
     }  
     cutIndex++;
 
-    if (fHistoDCAZMesonPrimVtxBefore)fHistoDCAZMesonPrimVtxBefore->Fill(pi0->GetDCAZMotherPrimVtx());
+    if (fHistoDCAZMesonPrimVtxBefore)FillQAHisto(kQADCAZMesonPrimVtxBefore,pi0->GetDCAZMotherPrimVtx());
 
     if (fDCAZMesonPrimVtxCutOn){
       if (TMath::Abs(pi0->GetDCAZMotherPrimVtx()) > fDCAZMesonPrimVtxCut){
-        if(hist)hist->Fill(cutIndex, pi0->Pt());
+        if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
         return kFALSE;
       }
     }
     cutIndex++;
 
-    if (fHistoDCAGGMesonAfter)fHistoDCAGGMesonAfter->Fill(pi0->GetDCABetweenPhotons());
-    if (fHistoDCARMesonPrimVtxAfter)fHistoDCARMesonPrimVtxAfter->Fill(pi0->GetDCARMotherPrimVtx());
-    if (fHistoDCAZMesonPrimVtxAfter)fHistoDCAZMesonPrimVtxAfter->Fill(pi0->M(),pi0->GetDCAZMotherPrimVtx());
+    if (fHistoDCAGGMesonAfter)FillQAHisto(kQADCAGGMesonAfter,pi0->GetDCABetweenPhotons());
+    if (fHistoDCARMesonPrimVtxAfter)FillQAHisto(kQADCARMesonPrimVtxAfter,pi0->GetDCARMotherPrimVtx());
+    if (fHistoDCAZMesonPrimVtxAfter)FillQAHisto(kQADCAZMesonPrimVtxAfter,pi0->M(),pi0->GetDCAZMotherPrimVtx());
   } 
   
-  if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if(hist)FillQAHisto(histSlot,cutIndex, pi0->Pt());
   return kTRUE;
 }
 
+//________________________________________________________________________
+Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0, Double_t fRapidityShift, AliConversionCutDecisionTable *decisions, Int_t iCand, Int_t iConfig)
+{
+  // Selection of reconstructed signal meson candidates with decisions shared between
+  // cut configurations: a candidate already decided by a configuration with the same
+  // selection key is not rerun, the decision and QA fills are taken from the table
+  if(!decisions || iCand < 0 || iCand >= decisions->GetNCandidates()) return MesonIsSelected(pi0,kTRUE,fRapidityShift);
+
+  Int_t decision = decisions->GetDecision(iCand,iConfig);
+  if(decision == AliConversionCutDecisionTable::kUnknown){
+    fDecisionRecorder = decisions;
+    Bool_t accepted = MesonIsSelected(pi0,kTRUE,fRapidityShift);
+    fDecisionRecorder = NULL;
+    decisions->SetDecision(iCand,iConfig,accepted);
+    return accepted;
+  }
+  Int_t end = decisions->GetFillsEnd(iCand,iConfig);
+  for(Int_t iFill = decisions->GetFillsBegin(iCand,iConfig); iFill < end; iFill++){
+    FillQAHisto(decisions->GetFillSlot(iFill),decisions->GetFillX(iFill),decisions->GetFillY(iFill));
+  }
+  return decision == AliConversionCutDecisionTable::kAccepted;
+}
+
+//________________________________________________________________________
+TH1* AliConversionMesonCuts::GetQAHisto(Int_t slot) const
+{
+  // QA histogram of the given slot, NULL if it is not booked
+  switch(slot){
+    case kQAMesonCuts:                return fHistoMesonCuts;
+    case kQAMesonBGCuts:              return fHistoMesonBGCuts;
+    case kQADCAGGMesonBefore:         return fHistoDCAGGMesonBefore;
+    case kQADCAZMesonPrimVtxBefore:   return fHistoDCAZMesonPrimVtxBefore;
+    case kQADCARMesonPrimVtxBefore:   return fHistoDCARMesonPrimVtxBefore;
+    case kQADCAGGMesonAfter:          return fHistoDCAGGMesonAfter;
+    case kQADCAZMesonPrimVtxAfter:    return fHistoDCAZMesonPrimVtxAfter;
+    case kQADCARMesonPrimVtxAfter:    return fHistoDCARMesonPrimVtxAfter;
+    case kQAInvMassBefore:            return fHistoInvMassBefore;
+    case kQAInvMassAfter:             return fHistoInvMassAfter;
+    default:                          return NULL;
+  }
+}
+
+//________________________________________________________________________
+void AliConversionMesonCuts::FillQAHisto(Int_t slot, Double_t x, Double_t y)
+{
+  // fill a QA histogram of the meson selection, the fill is recorded
+  // if the decision is shared with other cut configurations
+  TH1 *hist = GetQAHisto(slot);
+  if(!hist) return;
+  if(hist->GetDimension() > 1) ((TH2*)hist)->Fill(x,y);
+  else hist->Fill(x);
+  if(fDecisionRecorder) fDecisionRecorder->RecordFill(slot,x,y);
+}
+
 
 
 //________________________________________________________________________
@@ -2415,6 +2473,18 @@ TString AliConversionMesonCuts::GetCutNumber(){
   return a;
 }
 
+//________________________________________________________________________
+TString AliConversionMesonCuts::GetSelectionKey(){
+  // returns the cut number extended by the settings outside of it which change the
+  // outcome of MesonIsSelected and by the booked QA histograms: two cut objects
+  // with the same key take the same decision and fill the same QA
+  Int_t qaMask = 0;
+  for(Int_t slot = 0; slot < kNQAHistograms; slot++){
+    if(GetQAHisto(slot)) qaMask |= 1<<slot;
+  }
+  return Form("%s_%d_%d_%g_%x",GetCutNumber().Data(),fIsMergedClusterCut,(Int_t)fEnableMinOpeningAngleCut,fOpeningAngle,qaMask);
+}
+
 //________________________________________________________________________
 void AliConversionMesonCuts::FillElectonLabelArray(AliAODConversionPhoton* photon, Int_t nV0){
 
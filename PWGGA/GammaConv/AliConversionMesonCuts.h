@@ -27,6 +27,7 @@ class AliAnalysisCuts;
 class iostream;
 class TList;
 class AliAnalysisManager;
+class AliConversionCutDecisionTable;
 
 
 using namespace std;
@@ -56,6 +57,21 @@ class AliConversionMesonCuts : public AliAnalysisCuts {
       kNCuts
     };
 
+    // QA histograms filled inside MesonIsSelected
+    enum qaHistograms {
+      kQAMesonCuts=0,
+      kQAMesonBGCuts,
+      kQADCAGGMesonBefore,
+      kQADCAZMesonPrimVtxBefore,
+      kQADCARMesonPrimVtxBefore,
+      kQADCAGGMesonAfter,
+      kQADCAZMesonPrimVtxAfter,
+      kQADCARMesonPrimVtxAfter,
+      kQAInvMassBefore,
+      kQAInvMassAfter,
+      kNQAHistograms
+    };
+
     Bool_t  SetCutIds(TString cutString);
     Int_t   fCuts[kNCuts];
     Bool_t  SetCut(cutIds cutID, Int_t cut);
@@ -76,9 +92,11 @@ class AliConversionMesonCuts : public AliAnalysisCuts {
     virtual Bool_t IsSelected(TList* /*list*/) {return kTRUE;}
 
     TString GetCutNumber();
+    TString GetSelectionKey();
 
     // Cut Selection
     Bool_t MesonIsSelected(AliAODConversionMother *pi0,Bool_t IsSignal=kTRUE, Double_t fRapidityShift=0.);
+    Bool_t MesonIsSelected(AliAODConversionMother *pi0, Double_t fRapidityShift, AliConversionCutDecisionTable *decisions, Int_t iCand, Int_t iConfig);
     Bool_t MesonIsSelectedMC(TParticle *fMCMother,AliStack *fMCStack, Double_t fRapidityShift=0.);
     Bool_t MesonIsSelectedAODMC(AliAODMCParticle *MCMother,TClonesArray *AODMCArray, Double_t fRapidityShift=0.);
     Bool_t MesonIsSelectedMCDalitz(TParticle *fMCMother,AliStack *fMCStack, Int_t &labelelectron, Int_t &labelpositron, Int_t &labelgamma,Double_t fRapidityShift=0.);
@@ -210,10 +228,13 @@ class AliConversionMesonCuts : public AliAnalysisCuts {
     TH1F*       fHistoDCARMesonPrimVtxAfter;    //
     TH1F*       fHistoInvMassBefore;            //
     TH1F*       fHistoInvMassAfter;             //
+    AliConversionCutDecisionTable* fDecisionRecorder; //! table recording the QA fills of a shared meson selection
 
   private:
+    TH1* GetQAHisto(Int_t slot) const;
+    void FillQAHisto(Int_t slot, Double_t x, Double_t y=0.);
 
-    ClassDef(AliConversionMesonCuts,16)
+    ClassDef(AliConversionMesonCuts,17)
 };
 
 
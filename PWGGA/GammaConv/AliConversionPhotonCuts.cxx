@@ -54,6 +54,7 @@
 #include "AliAODMCParticle.h"
 #include "AliAODMCHeader.h"
 #include "AliTRDTriggerAnalysis.h"
+#include "AliConversionCutDecisionTable.h"
 
 class iostream;
 
@@ -216,6 +217,7 @@ AliConversionPhotonCuts::AliConversionPhotonCuts(const char *name,const char *ti
   fPreSelCut(kFALSE),
   fProcessAODCheck(kFALSE),
   fProfileContainingMaterialBudgetWeights(NULL),
+  fDecisionRecorder(NULL),
   fMaterialBudgetWeightsInitialized(kFALSE)
 {
   InitPIDResponse();
@@ -349,6 +351,7 @@ AliConversionPhotonCuts::AliConversionPhotonCuts(const AliConversionPhotonCuts &
   fPreSelCut(ref.fPreSelCut),
   fProcessAODCheck(ref.fProcessAODCheck),
   fProfileContainingMaterialBudgetWeights(ref.fProfileContainingMaterialBudgetWeights),
+  fDecisionRecorder(NULL),
   fMaterialBudgetWeightsInitialized(ref.fMaterialBudgetWeightsInitialized)
 {
   // Copy Constructor
@@ -788,17 +791,17 @@ Bool_t AliConversionPhotonCuts::PhotonIsSelectedAODMC(AliAODMCParticle *particle
 Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVEvent *event){   // Specific Photon Cuts
 
   Int_t cutIndex = 0;
-  if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt());
+  if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt());
   cutIndex++;
 
   // Fill Histos before Cuts
-  if(fHistoInvMassbefore)fHistoInvMassbefore->Fill(photon->GetMass());
-  if(fHistoArmenterosbefore)fHistoArmenterosbefore->Fill(photon->GetArmenterosAlpha(),photon->GetArmenterosQt());
+  if(fHistoInvMassbefore)FillQAHisto(kQAInvMassbefore,photon->GetMass());
+  if(fHistoArmenterosbefore)FillQAHisto(kQAArmenterosbefore,photon->GetArmenterosAlpha(),photon->GetArmenterosQt());
 
   // Gamma selection based on QT from Armenteros
   if(fDoQtGammaSelection == kTRUE){
     if(!ArmenterosQtCut(photon)){
-      if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //1
+      if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //1
       return kFALSE;
     }
   }
@@ -807,7 +810,7 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
   // Chi Cut
   if(photon->GetChi2perNDF() > fChi2CutConversion || photon->GetChi2perNDF() <=0){
     {
-      if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //2
+      if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //2
       return kFALSE;
     }
   }
@@ -815,7 +818,7 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
 
   // Reconstruction Acceptance Cuts
   if(!AcceptanceCuts(photon)){
-    if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //3
+    if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //3
     return kFALSE;
   }
 
@@ -823,7 +826,7 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
   // Asymmetry Cut
   if(fDoPhotonAsymmetryCut == kTRUE){
     if(!AsymmetryCut(photon,event)){
-      if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //4
+      if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //4
       return kFALSE;
     }
   }
@@ -831,13 +834,13 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
   //Check the pid probability
   cutIndex++; //5
   if(!PIDProbabilityCut(photon, event)) {
-    if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //5
+    if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //5
     return kFALSE;
   }
 
   cutIndex++; //6
   if(!CorrectedTPCClusterCut(photon, event)) {
-    if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //6
+    if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //6
     return kFALSE;
   }
 
@@ -854,13 +857,13 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
 
   cutIndex++; //7
   if(!PsiPairCut(photon)) {
-    if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //7
+    if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //7
     return kFALSE;
   }
 
   cutIndex++; //8
   if(!CosinePAngleCut(photon, event)) {
-    if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //8
+    if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //8
     return kFALSE;
   }
 
@@ -870,13 +873,13 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
 
     cutIndex++; //9
     if(photonAOD->GetDCArToPrimVtx() > fDCARPrimVtxCut) { //DCA R cut of photon to primary vertex
-      if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //9
+      if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //9
       return kFALSE;
     }
 
     cutIndex++; //10
     if(TMath::Abs(photonAOD->GetDCAzToPrimVtx()) > fDCAZPrimVtxCut) { //DCA Z cut of photon to primary vertex
-      if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //10
+      if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //10
       return kFALSE;
     }
   } else {
@@ -894,20 +897,20 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
         photonQuality = photonAOD->GetPhotonQuality();
       }	
       if (fDoPhotonQualitySelectionCut && photonQuality != fPhotonQualityCut){
-        if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //11
+        if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //11
         return kFALSE;
       }	
   } 
   cutIndex++; //12
-  if(fHistoPhotonCuts)fHistoPhotonCuts->Fill(cutIndex, photon->GetPhotonPt()); //11
+  if(fHistoPhotonCuts)FillQAHisto(kQAPhotonCuts,cutIndex, photon->GetPhotonPt()); //11
 
   // Histos after Cuts
-  if(fHistoInvMassafter)fHistoInvMassafter->Fill(photon->GetMass());
-  if(fHistoArmenterosafter)fHistoArmenterosafter->Fill(photon->GetArmenterosAlpha(),photon->GetArmenterosQt());
-  if(fHistoPsiPairDeltaPhiafter)fHistoPsiPairDeltaPhiafter->Fill(deltaPhi,photon->GetPsiPair());
-  if(fHistoKappaafter)fHistoKappaafter->Fill(photon->GetPhotonPt(), GetKappaTPC(photon, event));
+  if(fHistoInvMassafter)FillQAHisto(kQAInvMassafter,photon->GetMass());
+  if(fHistoArmenterosafter)FillQAHisto(kQAArmenterosafter,photon->GetArmenterosAlpha(),photon->GetArmenterosQt());
+  if(fHistoPsiPairDeltaPhiafter)FillQAHisto(kQAPsiPairDeltaPhiafter,deltaPhi,photon->GetPsiPair());
+  if(fHistoKappaafter)FillQAHisto(kQAKappaafter,photon->GetPhotonPt(), GetKappaTPC(photon, event));
   if(fHistoAsymmetryafter){
-    if(photon->GetPhotonP()!=0 && electronCandidate->P()!=0)fHistoAsymmetryafter->Fill(photon->GetPhotonP(),electronCandidate->P()/photon->GetPhotonP());
+    if(photon->GetPhotonP()!=0 && electronCandidate->P()!=0)FillQAHisto(kQAAsymmetryafter,photon->GetPhotonP(),electronCandidate->P()/photon->GetPhotonP());
   }
   return kTRUE;
 
@@ -953,68 +956,179 @@ Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon
 
   FillPhotonCutIndex(kPhotonIn);
 
-  if(event->IsA()==AliESDEvent::Class()) {
-    if(!SelectV0Finder( ( ((AliESDEvent*)event)->GetV0(photon->GetV0Index()))->GetOnFlyStatus() ) ){
-      FillPhotonCutIndex(kOnFly);
+  AliVTrack * negTrack = NULL;
+  AliVTrack * posTrack = NULL;
+  for(Int_t stage = 0; stage < kNSelectionStages; stage++){
+    Int_t photonCut = RunSelectionStage(stage, photon, event, negTrack, posTrack);
+    if(photonCut != kPhotonOut){
+      FillPhotonCutIndex(photonCut);
       return kFALSE;
     }
   }
 
-  // Get Tracks
-  AliVTrack * negTrack = GetTrack(event, photon->GetTrackLabelNegative());
-  AliVTrack * posTrack = GetTrack(event, photon->GetTrackLabelPositive());
+  // Photon passed cuts
+  FillPhotonCutIndex(kPhotonOut);
+  return kTRUE;
+}
 
-  if(!negTrack || !posTrack) {
-    FillPhotonCutIndex(kNoTracks);
-    return kFALSE;
+///________________________________________________________________________
+Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon, AliVEvent * event, AliConversionCutDecisionTable *decisions, Int_t iCand, Int_t iConfig){
+  // Selection of Reconstructed Photons with decisions shared between cut configurations:
+  // a stage already decided by a configuration with the same stage key is not rerun,
+  // its rejection reason and QA fills are taken from the decision table instead
+
+  if(!decisions) return PhotonIsSelected(photon, event);
+
+  FillPhotonCutIndex(kPhotonIn);
+
+  AliVTrack * negTrack = NULL;
+  AliVTrack * posTrack = NULL;
+  for(Int_t stage = 0; stage < kNSelectionStages; stage++){
+    Int_t photonCut = kPhotonOut;
+    if(decisions->GetDecision(iCand, iConfig, stage) == AliConversionCutDecisionTable::kUnknown){
+      fDecisionRecorder = decisions;
+      photonCut = RunSelectionStage(stage, photon, event, negTrack, posTrack);
+      fDecisionRecorder = NULL;
+      decisions->SetDecision(iCand, iConfig, photonCut == kPhotonOut, stage, photonCut);
+    } else {
+      ReplayQAFills(decisions, iCand, iConfig, stage);
+      photonCut = decisions->GetDetail(iCand, iConfig, stage);
+    }
+    if(photonCut != kPhotonOut){
+      FillPhotonCutIndex(photonCut);
+      return kFALSE;
+    }
   }
 
-  // check if V0 from AliAODGammaConversion.root is actually contained in AOD by checking if V0 exists with same tracks
-  if(event->IsA()==AliAODEvent::Class() && fPreSelCut && ( fIsHeavyIon != 1 || (fIsHeavyIon == 1 && fProcessAODCheck) )) {
-    AliAODEvent* aodEvent = dynamic_cast<AliAODEvent*>(event);
+  // Photon passed cuts
+  FillPhotonCutIndex(kPhotonOut);
+  return kTRUE;
+}
 
-    Bool_t bFound = kFALSE;
-    Int_t v0PosID = posTrack->GetID();
-    Int_t v0NegID = negTrack->GetID();
-    AliAODv0* v0 = NULL;
-    for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
-      v0 = aodEvent->GetV0(iV);
-      if(!v0) continue;
-      if( (v0PosID == v0->GetPosID() && v0NegID == v0->GetNegID()) || (v0PosID == v0->GetNegID() && v0NegID == v0->GetPosID()) ){
-        bFound = kTRUE;
-        break;
+///________________________________________________________________________
+Int_t AliConversionPhotonCuts::RunSelectionStage(Int_t stage, AliConversionPhotonBase *photon, AliVEvent *event, AliVTrack *&negTrack, AliVTrack *&posTrack){
+  // Runs one stage of PhotonIsSelected, returns kPhotonOut if the photon passed it
+  // and the photon cut index of the rejection otherwise. The tracks are looked up
+  // once and passed on to the following stages.
+
+  if(stage == kStageV0){
+    if(event->IsA()==AliESDEvent::Class()) {
+      if(!SelectV0Finder( ( ((AliESDEvent*)event)->GetV0(photon->GetV0Index()))->GetOnFlyStatus() ) ){
+        return kOnFly;
       }
     }
-    if(!bFound){
-      FillPhotonCutIndex(kNoV0);
-      return kFALSE;
+
+    // Get Tracks
+    negTrack = GetTrack(event, photon->GetTrackLabelNegative());
+    posTrack = GetTrack(event, photon->GetTrackLabelPositive());
+
+    if(!negTrack || !posTrack) {
+      return kNoTracks;
     }
+
+    // check if V0 from AliAODGammaConversion.root is actually contained in AOD by checking if V0 exists with same tracks
+    if(event->IsA()==AliAODEvent::Class() && fPreSelCut && ( fIsHeavyIon != 1 || (fIsHeavyIon == 1 && fProcessAODCheck) )) {
+      AliAODEvent* aodEvent = dynamic_cast<AliAODEvent*>(event);
+
+      Bool_t bFound = kFALSE;
+      Int_t v0PosID = posTrack->GetID();
+      Int_t v0NegID = negTrack->GetID();
+      AliAODv0* v0 = NULL;
+      for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
+        v0 = aodEvent->GetV0(iV);
+        if(!v0) continue;
+        if( (v0PosID == v0->GetPosID() && v0NegID == v0->GetNegID()) || (v0PosID == v0->GetNegID() && v0NegID == v0->GetPosID()) ){
+          bFound = kTRUE;
+          break;
+        }
+      }
+      if(!bFound){
+        return kNoV0;
+      }
+    }
+    return kPhotonOut;
   }
 
-  photon->DeterminePhotonQuality(negTrack,posTrack);
-  // Track Cuts
-  if(!TracksAreSelected(negTrack, posTrack)){
-    FillPhotonCutIndex(kTrackCuts);
-    return kFALSE;
+  // the V0 stage was taken from the decision table, the tracks exist
+  if(!negTrack || !posTrack){
+    negTrack = GetTrack(event, photon->GetTrackLabelNegative());
+    posTrack = GetTrack(event, photon->GetTrackLabelPositive());
   }
-  if (fHistoEtaDistV0s)fHistoEtaDistV0s->Fill(photon->GetPhotonEta());
-  // dEdx Cuts
-  
-  if(!KappaCuts(photon, event) || !dEdxCuts(negTrack) || !dEdxCuts(posTrack)) {
-    FillPhotonCutIndex(kdEdxCuts);
-    return kFALSE;
+
+  if(stage == kStageTracks){
+    photon->DeterminePhotonQuality(negTrack,posTrack);
+    // Track Cuts
+    if(!TracksAreSelected(negTrack, posTrack)){
+      return kTrackCuts;
+    }
+    if (fHistoEtaDistV0s)FillQAHisto(kQAEtaDistV0s,photon->GetPhotonEta());
+    return kPhotonOut;
   }
-    
-  if (fHistoEtaDistV0sAfterdEdxCuts)fHistoEtaDistV0sAfterdEdxCuts->Fill(photon->GetPhotonEta());
+
+  if(stage == kStagePID){
+    // dEdx Cuts
+    if(!KappaCuts(photon, event) || !dEdxCuts(negTrack) || !dEdxCuts(posTrack)) {
+      return kdEdxCuts;
+    }
+    if (fHistoEtaDistV0sAfterdEdxCuts)FillQAHisto(kQAEtaDistV0sAfterdEdxCuts,photon->GetPhotonEta());
+    return kPhotonOut;
+  }
+
   // Photon Cuts
   if(!PhotonCuts(photon,event)){
-    FillPhotonCutIndex(kPhotonCuts);
-    return kFALSE;
+    return kPhotonCuts;
+  }
+  return kPhotonOut;
+}
+
+///________________________________________________________________________
+TH1* AliConversionPhotonCuts::GetQAHisto(Int_t slot) const {
+  // QA histogram of the given slot, NULL if it is not booked
+  switch(slot){
+    case kQAEtaDistV0s:               return fHistoEtaDistV0s;
+    case kQAEtaDistV0sAfterdEdxCuts:  return fHistoEtaDistV0sAfterdEdxCuts;
+    case kQAdEdxCuts:                 return fHistodEdxCuts;
+    case kQATPCdEdxbefore:            return fHistoTPCdEdxbefore;
+    case kQATPCdEdxafter:             return fHistoTPCdEdxafter;
+    case kQATPCdEdxSigbefore:         return fHistoTPCdEdxSigbefore;
+    case kQATPCdEdxSigafter:          return fHistoTPCdEdxSigafter;
+    case kQAKappaafter:               return fHistoKappaafter;
+    case kQATOFbefore:                return fHistoTOFbefore;
+    case kQATOFSigbefore:             return fHistoTOFSigbefore;
+    case kQATOFSigafter:              return fHistoTOFSigafter;
+    case kQAITSSigbefore:             return fHistoITSSigbefore;
+    case kQAITSSigafter:              return fHistoITSSigafter;
+    case kQAPsiPairDeltaPhiafter:     return fHistoPsiPairDeltaPhiafter;
+    case kQATrackCuts:                return fHistoTrackCuts;
+    case kQAPhotonCuts:               return fHistoPhotonCuts;
+    case kQAInvMassbefore:            return fHistoInvMassbefore;
+    case kQAArmenterosbefore:         return fHistoArmenterosbefore;
+    case kQAInvMassafter:             return fHistoInvMassafter;
+    case kQAArmenterosafter:          return fHistoArmenterosafter;
+    case kQAAsymmetryafter:           return fHistoAsymmetryafter;
+    case kQAAcceptanceCuts:           return fHistoAcceptanceCuts;
+    default:                          return NULL;
+  }
+}
+
+///________________________________________________________________________
+void AliConversionPhotonCuts::FillQAHisto(Int_t slot, Double_t x, Double_t y){
+  // fill a QA histogram of the selection, the fill is recorded if the
+  // current selection stage is shared with other cut configurations
+  TH1 *hist = GetQAHisto(slot);
+  if(!hist) return;
+  if(hist->GetDimension() > 1) ((TH2*)hist)->Fill(x,y);
+  else hist->Fill(x);
+  if(fDecisionRecorder) fDecisionRecorder->RecordFill(slot,x,y);
+}
+
+///________________________________________________________________________
+void AliConversionPhotonCuts::ReplayQAFills(const AliConversionCutDecisionTable *decisions, Int_t iCand, Int_t iConfig, Int_t stage){
+  // repeat the QA fills recorded by the configuration which ran the selection stage
+  Int_t end = decisions->GetFillsEnd(iCand, iConfig, stage);
+  for(Int_t iFill = decisions->GetFillsBegin(iCand, iConfig, stage); iFill < end; iFill++){
+    FillQAHisto(decisions->GetFillSlot(iFill), decisions->GetFillX(iFill), decisions->GetFillY(iFill));
   }
-  
-  // Photon passed cuts
-  FillPhotonCutIndex(kPhotonOut);
-  return kTRUE;
 }
 
 ///________________________________________________________________________
@@ -1037,45 +1151,45 @@ Bool_t AliConversionPhotonCuts::AcceptanceCuts(AliConversionPhotonBase *photon)
   // Exclude certain areas for photon reconstruction
 
   Int_t cutIndex=0;
-  if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+  if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
   cutIndex++;
 
   if(photon->GetConversionRadius()>fMaxR){ // cuts on distance from collision point
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   cutIndex++;
 
   if(photon->GetConversionRadius()<fMinR){ // cuts on distance from collision point
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   cutIndex++;
 
   if(photon->GetConversionRadius() <= ((TMath::Abs(photon->GetConversionZ())*fLineCutZRSlope)-fLineCutZValue)){
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   else if (fUseEtaMinCut &&  photon->GetConversionRadius() >= ((TMath::Abs(photon->GetConversionZ())*fLineCutZRSlopeMin)-fLineCutZValueMin )){
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   cutIndex++;
 
   if(TMath::Abs(photon->GetConversionZ()) > fMaxZ ){ // cuts out regions where we do not reconstruct
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   cutIndex++;
 
 
   if( photon->GetPhotonEta() > (fEtaCut)    || photon->GetPhotonEta() < (-fEtaCut) ){
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   if(fEtaCutMin>-0.1){
     if( photon->GetPhotonEta() < (fEtaCutMin) && photon->GetPhotonEta() > (-fEtaCutMin) ){
-      if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+      if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
       return kFALSE;
     }
   }
@@ -1085,14 +1199,14 @@ Bool_t AliConversionPhotonCuts::AcceptanceCuts(AliConversionPhotonBase *photon)
     if(photon->GetPhotonEta() > fEtaForPhiCutMin && photon->GetPhotonEta() < fEtaForPhiCutMax ){
       if (fMinPhiCut < fMaxPhiCut){
         if( photon->GetPhotonPhi() > fMinPhiCut && photon->GetPhotonPhi() < fMaxPhiCut ) {
-          if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+          if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
           return kFALSE;
         }
       } else {
         Double_t photonPhi = photon->GetPhotonPhi();
         if (photon->GetPhotonPhi() < TMath::Pi()) photonPhi = photon->GetPhotonPhi() + 2*TMath::Pi();
         if( photonPhi > fMinPhiCut && photonPhi < fMaxPhiCut+2*TMath::Pi() ) {
-          if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+          if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
           return kFALSE;
         }	
       }	
@@ -1103,12 +1217,12 @@ Bool_t AliConversionPhotonCuts::AcceptanceCuts(AliConversionPhotonBase *photon)
 
   
   if(photon->GetPhotonPt()<fPtCut){
-    if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+    if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
     return kFALSE;
   }
   cutIndex++;
 
-  if(fHistoAcceptanceCuts)fHistoAcceptanceCuts->Fill(cutIndex, photon->GetPhotonPt());
+  if(fHistoAcceptanceCuts)FillQAHisto(kQAAcceptanceCuts,cutIndex, photon->GetPhotonPt());
 
   return kTRUE;
 }
@@ -1119,7 +1233,7 @@ Bool_t AliConversionPhotonCuts::SpecificTrackCuts(AliAODTrack * negTrack, AliAOD
   // Track Cuts which require AOD/ESD specific implementation
 
   if( !negTrack->IsOn(AliESDtrack::kTPCrefit)  || !posTrack->IsOn(AliESDtrack::kTPCrefit)   )  {
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   cutIndex++;
@@ -1127,7 +1241,7 @@ Bool_t AliConversionPhotonCuts::SpecificTrackCuts(AliAODTrack * negTrack, AliAOD
   AliAODVertex * NegVtxType=negTrack->GetProdVertex();
   AliAODVertex * PosVtxType=posTrack->GetProdVertex();
   if( (NegVtxType->GetType())==AliAODVertex::kKink || (PosVtxType->GetType())==AliAODVertex::kKink) {
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   return kTRUE;
@@ -1140,13 +1254,13 @@ Bool_t AliConversionPhotonCuts::SpecificTrackCuts(AliESDtrack * negTrack, AliESD
   // Track Cuts which require AOD/ESD specific implementation
 
   if( !negTrack->IsOn(AliESDtrack::kTPCrefit)  || !posTrack->IsOn(AliESDtrack::kTPCrefit)   )  {
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   cutIndex++;
 
   if(negTrack->GetKinkIndex(0) > 0  || posTrack->GetKinkIndex(0) > 0 ) {
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   return kTRUE;
@@ -1159,18 +1273,18 @@ Bool_t AliConversionPhotonCuts::TracksAreSelected(AliVTrack * negTrack, AliVTrac
   // Track Selection for Photon Reconstruction
 
   Int_t cutIndex=0;
-  if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+  if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
   cutIndex++;
 
   // avoid like sign
   if(fUseOnFlyV0FinderSameSign==0){
     if(negTrack->Charge() == posTrack->Charge()) {
-      if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+      if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
       return kFALSE;
     }
   }else if(fUseOnFlyV0FinderSameSign==1){
     if(negTrack->Charge() != posTrack->Charge()) {
-      if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+      if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
       return kFALSE;
     }
   }
@@ -1180,7 +1294,7 @@ Bool_t AliConversionPhotonCuts::TracksAreSelected(AliVTrack * negTrack, AliVTrac
 
 
   if( negTrack->GetNcls(1) < fMinClsTPC || posTrack->GetNcls(1) < fMinClsTPC ) {
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   cutIndex++;
@@ -1188,13 +1302,13 @@ Bool_t AliConversionPhotonCuts::TracksAreSelected(AliVTrack * negTrack, AliVTrac
   // Acceptance
   if( posTrack->Eta() > (fEtaCut) || posTrack->Eta() < (-fEtaCut) ||
     negTrack->Eta() > (fEtaCut) || negTrack->Eta() < (-fEtaCut) ){
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   if(fEtaCutMin>-0.1){
     if( (posTrack->Eta() < (fEtaCutMin) && posTrack->Eta() > (-fEtaCutMin)) ||
       (negTrack->Eta() < (fEtaCutMin) && negTrack->Eta() > (-fEtaCutMin)) ){
-      if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+      if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
       return kFALSE;
     }
   }
@@ -1202,7 +1316,7 @@ Bool_t AliConversionPhotonCuts::TracksAreSelected(AliVTrack * negTrack, AliVTrac
 
   // Single Pt Cut
   if( negTrack->Pt()< fSinglePtCut || posTrack->Pt()< fSinglePtCut){
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   cutIndex++;
@@ -1217,12 +1331,12 @@ Bool_t AliConversionPhotonCuts::TracksAreSelected(AliVTrack * negTrack, AliVTrac
   }
 
   if(!passCuts){
-    if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+    if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
     return kFALSE;
   }
   cutIndex++;
 
-  if(fHistoTrackCuts)fHistoTrackCuts->Fill(cutIndex);
+  if(fHistoTrackCuts)FillQAHisto(kQATrackCuts,cutIndex);
 
   return kTRUE;
 
@@ -1251,16 +1365,16 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
   if(!fPIDResponse){AliError("No PID Response"); return kTRUE;}// if still missing fatal error
 
   Int_t cutIndex=0;
-  if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
-  if(fHistoTPCdEdxSigbefore)fHistoTPCdEdxSigbefore->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTPC(fCurrentTrack, AliPID::kElectron));
-  if(fHistoTPCdEdxbefore)fHistoTPCdEdxbefore->Fill(fCurrentTrack->P(),fCurrentTrack->GetTPCsignal());
+  if(fHistodEdxCuts)FillQAHisto(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
+  if(fHistoTPCdEdxSigbefore)FillQAHisto(kQATPCdEdxSigbefore,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTPC(fCurrentTrack, AliPID::kElectron));
+  if(fHistoTPCdEdxbefore)FillQAHisto(kQATPCdEdxbefore,fCurrentTrack->P(),fCurrentTrack->GetTPCsignal());
   cutIndex++;
   if(fDodEdxSigmaCut == kTRUE && !fSwitchToKappa){
     // TPC Electron Line
     if( fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kElectron)<fPIDnSigmaBelowElectronLine ||
       fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kElectron)>fPIDnSigmaAboveElectronLine){
 
-      if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+      if(fHistodEdxCuts)FillQAHisto(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
       return kFALSE;
     }
     cutIndex++;
@@ -1271,7 +1385,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
         fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kElectron)<fPIDnSigmaAboveElectronLine&&
         fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLine){
 
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHisto(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
@@ -1283,7 +1397,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
         fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kElectron)<fPIDnSigmaAboveElectronLine &&
         fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLineHighPt){
 
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHisto(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
@@ -1295,7 +1409,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
     if(fCurrentTrack->P()<fPIDMinPKaonRejectionLowP ){
       if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kKaon))<fPIDnSigmaAtLowPAroundKaonLine){
 
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHisto(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
@@ -1305,7 +1419,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
     if( fCurrentTrack->P()<fPIDMinPProtonRejectionLowP ){
       if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kProton))<fPIDnSigmaAtLowPAroundProtonLine){
 
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHisto(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
@@ -1316,7 +1430,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
     if( fCurrentTrack->P()<fPIDMinPPionRejectionLowP ){
       if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion))<fPIDnSigmaAtLowPAroundPionLine){
 
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHisto(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
@@ -1344,31 +1458,31 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
       fCurrentTrack->GetIntegratedTimes(times,AliPID::kSPECIESC);
       Double_t TOFsignal = fCurrentTrack->GetTOFsignal();
       Double_t dT = TOFsignal - t0 - times[0];
-      fHistoTOFbefore->Fill(fCurrentTrack->P(),dT);
+      FillQAHisto(kQATOFbefore,fCurrentTrack->P(),dT);
     }
-    if(fHistoTOFSigbefore) fHistoTOFSigbefore->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
+    if(fHistoTOFSigbefore) FillQAHisto(kQATOFSigbefore,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
     if(fUseTOFpid){
       if(fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron)>fTofPIDnSigmaAboveElectronLine ||
         fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron)<fTofPIDnSigmaBelowElectronLine ){
-        if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+        if(fHistodEdxCuts)FillQAHisto(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
-    if(fHistoTOFSigafter)fHistoTOFSigafter->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
+    if(fHistoTOFSigafter)FillQAHisto(kQATOFSigafter,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
   }
   cutIndex++;
   
   if((fCurrentTrack->GetStatus() & AliESDtrack::kITSpid)){
-    if(fHistoITSSigbefore) fHistoITSSigbefore->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
+    if(fHistoITSSigbefore) FillQAHisto(kQAITSSigbefore,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
     if(fUseITSpid){
       if(fCurrentTrack->Pt()<=fMaxPtPIDITS){
         if(fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron)>fITSPIDnSigmaAboveElectronLine || fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron)<fITSPIDnSigmaBelowElectronLine ){
-          if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+          if(fHistodEdxCuts)FillQAHisto(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
       }  
     }
-    if(fHistoITSSigafter)fHistoITSSigafter->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
+    if(fHistoITSSigafter)FillQAHisto(kQAITSSigafter,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
   }
   
   cutIndex++;
@@ -1376,15 +1490,15 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack){
   // Apply TRD PID
   if(fDoTRDPID){
     if(!fPIDResponse->IdentifiedAsElectronTRD(fCurrentTrack,fPIDTRDEfficiency)){
-      if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
+      if(fHistodEdxCuts)FillQAHisto(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
       return kFALSE;
     }
   }
   cutIndex++;
 
-  if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
-  if(fHistoTPCdEdxSigafter)fHistoTPCdEdxSigafter->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTPC(fCurrentTrack, AliPID::kElectron));
-  if(fHistoTPCdEdxafter)fHistoTPCdEdxafter->Fill(fCurrentTrack->P(),fCurrentTrack->GetTPCsignal());
+  if(fHistodEdxCuts)FillQAHisto(kQAdEdxCuts,cutIndex,fCurrentTrack->Pt());
+  if(fHistoTPCdEdxSigafter)FillQAHisto(kQATPCdEdxSigafter,fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTPC(fCurrentTrack, AliPID::kElectron));
+  if(fHistoTPCdEdxafter)FillQAHisto(kQATPCdEdxafter,fCurrentTrack->P(),fCurrentTrack->GetTPCsignal());
   
   return kTRUE;
 }
@@ -3289,6 +3403,76 @@ TString AliConversionPhotonCuts::GetCutNumber(){
   return a;
 }
 
+///________________________________________________________________________
+TString AliConversionPhotonCuts::GetSelectionKey(){
+  // returns the cut number extended by the settings outside of it which change the
+  // outcome of PhotonIsSelected: two cut objects with the same key select the same photons
+  TString key = GetSelectionKey(kStageV0);
+  for(Int_t stage = kStageV0+1; stage < kNSelectionStages; stage++){
+    key.Append(Form("|%s",GetSelectionKey(stage).Data()));
+  }
+  return key;
+}
+
+///________________________________________________________________________
+TString AliConversionPhotonCuts::GetSelectionKey(Int_t stage){
+  // returns the key of one stage of PhotonIsSelected: the cut digits the stage depends on,
+  // the settings outside of the cut number used by it and the booked QA histograms,
+  // two cut objects with the same stage key take the same decision and fill the same QA
+  // fIsHeavyIon enters all stages as it changes the values decoded from several digits
+
+  static const Int_t kV0Digits[]     = {kv0FinderType};
+  static const Int_t kTracksDigits[] = {kv0FinderType, ketaCut, ksinglePtCut, kclsTPCCut};
+  static const Int_t kPIDDigits[]    = {kededxSigmaCut, kpidedxSigmaCut, kpiMomdedxSigmaCut, kpiMaxMomdedxSigmaCut,
+                                        kLowPRejectionSigmaCut, kTOFelectronPID, kITSelectronPID, kTRDelectronPID};
+  static const Int_t kPhotonDigits[] = {ketaCut, kRCut, kEtaForPhiSector, kMinPhiSector, kMaxPhiSector, ksinglePtCut,
+                                        kclsTPCCut, kQtMaxCut, kchi2GammaCut, kPsiPair, kdoPhotonAsymmetryCut, kCosPAngle,
+                                        kElecShare, kDcaRPrimVtx, kDcaZPrimVtx};
+
+  const Int_t *digits = NULL;
+  Int_t nDigits = 0;
+  TString settings;
+  switch(stage){
+    case kStageV0:
+      digits = kV0Digits; nDigits = sizeof(kV0Digits)/sizeof(Int_t);
+      settings = Form("%d%d",(Int_t)fPreSelCut,(Int_t)fProcessAODCheck);
+      break;
+    case kStageTracks:
+      digits = kTracksDigits; nDigits = sizeof(kTracksDigits)/sizeof(Int_t);
+      break;
+    case kStagePID:
+      digits = kPIDDigits; nDigits = sizeof(kPIDDigits)/sizeof(Int_t);
+      settings = Form("%d%d",(Int_t)fDodEdxSigmaCut,(Int_t)fSwitchToKappa);
+      break;
+    case kStagePhoton:
+      digits = kPhotonDigits; nDigits = sizeof(kPhotonDigits)/sizeof(Int_t);
+      break;
+    default:
+      return "";
+  }
+
+  TString key(Form("%d:",stage));
+  for(Int_t i = 0; i < nDigits; i++){
+    key.Append(Form("%d.",fCuts[digits[i]]));
+  }
+  Int_t qaMask = 0;
+  for(Int_t slot = 0; slot < kNQAHistograms; slot++){
+    if(GetQAHisto(slot)) qaMask |= 1<<slot;
+  }
+  key.Append(Form("_%s_%d_%x_%s",settings.Data(),fIsHeavyIon,qaMask,fV0ReaderName.Data()));
+  return key;
+}
+
+///________________________________________________________________________
+std::vector<TString> AliConversionPhotonCuts::GetSelectionKeys(){
+  // keys of all stages of PhotonIsSelected, as used by AliConversionCutDecisionTable
+  std::vector<TString> keys;
+  for(Int_t stage = 0; stage < kNSelectionStages; stage++){
+    keys.push_back(GetSelectionKey(stage));
+  }
+  return keys;
+}
+
 ///________________________________________________________________________
 void AliConversionPhotonCuts::FillElectonLabelArray(AliAODConversionPhoton* photon, Int_t nV0){
 
@@ -18,6 +18,7 @@
 #include "TProfile.h"
 #include "AliAnalysisUtils.h"
 #include "AliAnalysisManager.h"
+#include <vector>
 
 
 class AliESDEvent;
@@ -34,6 +35,7 @@ class iostream;
 class TList;
 class AliAnalysisManager;
 class AliAODMCParticle;
+class AliConversionCutDecisionTable;
 
 
 using namespace std;
@@ -84,6 +86,42 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
         kPhotonOut
     };
 
+    // stages of PhotonIsSelected, each stage depends on its own subset of the cut digits
+    enum selectionStages {
+        kStageV0=0,         // on-the-fly status, tracks and V0 in AOD
+        kStageTracks,       // TracksAreSelected
+        kStagePID,          // Kappa and dEdx cuts
+        kStagePhoton,       // PhotonCuts
+        kNSelectionStages
+    };
+
+    // QA histograms filled inside PhotonIsSelected
+    enum qaHistograms {
+        kQAEtaDistV0s=0,
+        kQAEtaDistV0sAfterdEdxCuts,
+        kQAdEdxCuts,
+        kQATPCdEdxbefore,
+        kQATPCdEdxafter,
+        kQATPCdEdxSigbefore,
+        kQATPCdEdxSigafter,
+        kQAKappaafter,
+        kQATOFbefore,
+        kQATOFSigbefore,
+        kQATOFSigafter,
+        kQAITSSigbefore,
+        kQAITSSigafter,
+        kQAPsiPairDeltaPhiafter,
+        kQATrackCuts,
+        kQAPhotonCuts,
+        kQAInvMassbefore,
+        kQAArmenterosbefore,
+        kQAInvMassafter,
+        kQAArmenterosafter,
+        kQAAsymmetryafter,
+        kQAAcceptanceCuts,
+        kNQAHistograms
+    };
+
 
     Bool_t SetCutIds(TString cutString); 
     Int_t fCuts[kNCuts];
@@ -115,11 +153,15 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     virtual Bool_t IsSelected(TList* /*list*/) {return kTRUE;}
 
     TString GetCutNumber();
+    TString GetSelectionKey();
+    TString GetSelectionKey(Int_t stage);
+    std::vector<TString> GetSelectionKeys();
     
     Float_t GetKappaTPC(AliConversionPhotonBase *gamma, AliVEvent *event);
     
     // Cut Selection
     Bool_t PhotonIsSelected(AliConversionPhotonBase * photon, AliVEvent  * event);
+    Bool_t PhotonIsSelected(AliConversionPhotonBase * photon, AliVEvent  * event, AliConversionCutDecisionTable *decisions, Int_t iCand, Int_t iConfig);
     Bool_t PhotonIsSelectedMC(TParticle *particle,AliStack *fMCStack,Bool_t checkForConvertedGamma=kTRUE);
     Bool_t PhotonIsSelectedAODMC(AliAODMCParticle *particle,TClonesArray *aodmcArray,Bool_t checkForConvertedGamma=kTRUE);
     Bool_t ElectronIsSelectedMC(TParticle *particle,AliStack *fMCStack);
@@ -160,6 +202,7 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
       else return kFALSE;
     }
     Bool_t PhotonCuts(AliConversionPhotonBase *photon,AliVEvent *event);
+    Int_t RunSelectionStage(Int_t stage, AliConversionPhotonBase *photon, AliVEvent *event, AliVTrack *&negTrack, AliVTrack *&posTrack);
     Bool_t CorrectedTPCClusterCut(AliConversionPhotonBase *photon, AliVEvent * event);
     Bool_t PsiPairCut(const AliConversionPhotonBase * photon) const;
     Bool_t CosinePAngleCut(const AliConversionPhotonBase * photon, AliVEvent * event) const;
@@ -344,10 +387,14 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     Bool_t            fPreSelCut;                           // Flag for preselection cut used in V0Reader
     Bool_t            fProcessAODCheck;                     // Flag for processing check for AOD to be contained in AliAODs.root and AliAODGammaConversion.root
     TProfile*         fProfileContainingMaterialBudgetWeights;      
+    AliConversionCutDecisionTable* fDecisionRecorder;       //! table recording the QA fills of a shared selection stage
 
   private:
+    TH1* GetQAHisto(Int_t slot) const;
+    void FillQAHisto(Int_t slot, Double_t x, Double_t y=0.);
+    void ReplayQAFills(const AliConversionCutDecisionTable *decisions, Int_t iCand, Int_t iConfig, Int_t stage);
   
-    ClassDef(AliConversionPhotonCuts,13)
+    ClassDef(AliConversionPhotonCuts,14)
 };
 
 #endif
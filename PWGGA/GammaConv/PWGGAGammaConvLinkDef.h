@@ -15,6 +15,7 @@
 #pragma link C++ class AliConvEventCuts+;
 #pragma link C++ class AliConversionPhotonCuts+;
 #pragma link C++ class AliConversionCuts+;
+#pragma link C++ class AliConversionCutDecisionTable+;
 #pragma link C++ class AliConversionSelection+;
 #pragma link C++ class AliV0ReaderV1+;
 #pragma link C++ class AliConversionAODBGHandlerRP+;
@@ -120,6 +120,7 @@ class AliAODRecoDecayHF : public AliAODRecoDecay {
 
   /// selection map
   void    SetSelectionBit(Int_t i) {SETBIT(fSelectionMap,i); return;}
+  void    ResetSelectionMap() {fSelectionMap=0; return;}
   Bool_t  HasSelectionBit(Int_t i) const {return TESTBIT(fSelectionMap,i);}
   ULong_t GetSelectionMap() const {return fSelectionMap;}
 
@@ -156,8 +157,7 @@ inline void AliAODRecoDecayHF::SetProngIDs(Int_t nIDs,UShort_t *id)
     printf("Wrong number of IDs, must be nProngs\n");
     return;
   }
-  if(fProngID) delete [] fProngID;
-  fProngID = new UShort_t[nIDs];
+  if(!fProngID) fProngID = new UShort_t[nIDs]; // size fixed by nProngs
   for(Int_t i=0;i<nIDs;i++) 
     fProngID[i] = id[i]; 
   return;
@@ -44,6 +44,9 @@ class AliAODRecoDecayHF4Prong : public AliAODRecoDecayHF {
   Double_t GetDist12toPrim() const {return fDist12toPrim;}
   Double_t GetDist3toPrim() const {return fDist3toPrim;}
   Double_t GetDist4toPrim() const {return fDist4toPrim;}
+  void SetDist12toPrim(Double_t d) { fDist12toPrim=d; }
+  void SetDist3toPrim(Double_t d) { fDist3toPrim=d; }
+  void SetDist4toPrim(Double_t d) { fDist4toPrim=d; }
 
   // D0->pi+K- pipi and D0bar->K+pi- pipi (in the order given) 
   Double_t ED0() const {return E(421);}
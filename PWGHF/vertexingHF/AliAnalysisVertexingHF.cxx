@@ -138,6 +138,7 @@ fFindVertexForDstar(kTRUE),
 fFindVertexForCascades(kTRUE),
 fV0TypeForCascadeVertex(0),
 fMassCutBeforeVertexing(kFALSE),
+fPreselectCombinations(kTRUE),
 fMassCalc2(0),
 fMassCalc3(0),
 fMassCalc4(0),
@@ -151,6 +152,45 @@ fOKInvMassD0to4p(kFALSE),
 fOKInvMassLctoV0(kFALSE),
 fnTrksTotal(0),
 fnSeleTrksTotal(0),
+fTwoTrackArray1(0),
+fTwoTrackArray2(0),
+fTwoTrackArrayV0(0),
+fTwoTrackArrayCasc(0),
+fThreeTrackArray(0),
+fFourTrackArray(0),
+fV0PosTrack(0),
+fV0NegTrack(0),
+fV0Track(0),
+fD0Track(0),
+fSeleBufSize(0),
+fSeleFlags(0),
+fEvtNumber(0),
+fSeleMom(0),
+fSeleKine(0),
+fPairBufSize(0),
+fPairNTrks(0),
+fPairDCABits(0),
+fVtx2Prong(0),
+fVtx2ProngB(0),
+fVtx3Prong(0),
+fVtx3ProngFor4(0),
+fVtx4Prong(0),
+fVtxCasc(0),
+fScratch2Prong(0),
+fScratchCascade(0),
+fScratch3Prong(0),
+fScratch4Prong(0),
+fPrimVtxScratch(0),
+fPrimVertexer(0),
+fPrimVertexerMode(-1),
+fPrimVertexerBz(0.),
+fRmTrksCopies(0),
+fnAllocInEvent(0),
+fnAllocTotal(0),
+fnEarlyMassCutTested(0),
+fnEarlyMassCutKept(0),
+fnPreselTested(0),
+fnPreselKept(0),
 fMakeReducedRHF(kFALSE),
 fMassDzero(0.),
 fMassDplus(0.),
@@ -167,6 +207,7 @@ fMassJpsi(0.)
   fMassCalc2 = new AliAODRecoDecay(0x0,2,0,d02);
   fMassCalc3 = new AliAODRecoDecay(0x0,3,1,d03);
   fMassCalc4 = new AliAODRecoDecay(0x0,4,0,d04);
+  for(Int_t i=0; i<4; i++) fPreselMass[i]=0.;
   SetMasses();
 }
 //--------------------------------------------------------------------------
@@ -233,6 +274,7 @@ fFindVertexForDstar(source.fFindVertexForDstar),
 fFindVertexForCascades(source.fFindVertexForCascades),
 fV0TypeForCascadeVertex(source.fV0TypeForCascadeVertex),
 fMassCutBeforeVertexing(source.fMassCutBeforeVertexing),
+fPreselectCombinations(source.fPreselectCombinations),
 fMassCalc2(source.fMassCalc2),
 fMassCalc3(source.fMassCalc3),
 fMassCalc4(source.fMassCalc4),
@@ -246,6 +288,45 @@ fOKInvMassD0to4p(source.fOKInvMassD0to4p),
 fOKInvMassLctoV0(source.fOKInvMassLctoV0),
 fnTrksTotal(0),
 fnSeleTrksTotal(0),
+fTwoTrackArray1(0),
+fTwoTrackArray2(0),
+fTwoTrackArrayV0(0),
+fTwoTrackArrayCasc(0),
+fThreeTrackArray(0),
+fFourTrackArray(0),
+fV0PosTrack(0),
+fV0NegTrack(0),
+fV0Track(0),
+fD0Track(0),
+fSeleBufSize(0),
+fSeleFlags(0),
+fEvtNumber(0),
+fSeleMom(0),
+fSeleKine(0),
+fPairBufSize(0),
+fPairNTrks(0),
+fPairDCABits(0),
+fVtx2Prong(0),
+fVtx2ProngB(0),
+fVtx3Prong(0),
+fVtx3ProngFor4(0),
+fVtx4Prong(0),
+fVtxCasc(0),
+fScratch2Prong(0),
+fScratchCascade(0),
+fScratch3Prong(0),
+fScratch4Prong(0),
+fPrimVtxScratch(0),
+fPrimVertexer(0),
+fPrimVertexerMode(-1),
+fPrimVertexerBz(0.),
+fRmTrksCopies(0),
+fnAllocInEvent(0),
+fnAllocTotal(0),
+fnEarlyMassCutTested(0),
+fnEarlyMassCutKept(0),
+fnPreselTested(0),
+fnPreselKept(0),
 fMakeReducedRHF(kFALSE),
 fMassDzero(source.fMassDzero),
 fMassDplus(source.fMassDplus),
@@ -257,6 +338,7 @@ fMassJpsi(source.fMassJpsi)
   ///
   /// Copy constructor
   ///
+  for(Int_t i=0; i<4; i++) fPreselMass[i]=0.;
 }
 //--------------------------------------------------------------------------
 AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVertexingHF &source)
@@ -327,6 +409,7 @@ AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVerte
   fFindVertexForCascades = source.fFindVertexForCascades;
   fV0TypeForCascadeVertex = source.fV0TypeForCascadeVertex;
   fMassCutBeforeVertexing = source.fMassCutBeforeVertexing;
+  fPreselectCombinations = source.fPreselectCombinations;
   fMassCalc2 = source.fMassCalc2;
   fMassCalc3 = source.fMassCalc3;
   fMassCalc4 = source.fMassCalc4;
@@ -371,6 +454,34 @@ AliAnalysisVertexingHF::~AliAnalysisVertexingHF() {
   if(fMassCalc2) { delete fMassCalc2; fMassCalc2=0; }
   if(fMassCalc3) { delete fMassCalc3; fMassCalc3=0; }
   if(fMassCalc4) { delete fMassCalc4; fMassCalc4=0; }
+  delete fTwoTrackArray1;
+  delete fTwoTrackArray2;
+  delete fTwoTrackArrayV0;
+  delete fTwoTrackArrayCasc;
+  delete fThreeTrackArray;
+  delete fFourTrackArray;
+  delete fV0PosTrack;
+  delete fV0NegTrack;
+  delete fV0Track;
+  delete fD0Track;
+  delete [] fSeleFlags;
+  delete [] fEvtNumber;
+  delete [] fSeleMom;
+  delete [] fSeleKine;
+  delete [] fPairDCABits;
+  delete fScratch2Prong;
+  delete fScratchCascade;
+  delete fScratch3Prong;
+  delete fScratch4Prong;
+  delete fVtx2Prong;
+  delete fVtx2ProngB;
+  delete fVtx3Prong;
+  delete fVtx3ProngFor4;
+  delete fVtx4Prong;
+  delete fVtxCasc;
+  delete fPrimVtxScratch;
+  delete fPrimVertexer;
+  delete fRmTrksCopies;
 }
 //----------------------------------------------------------------------------
 TList *AliAnalysisVertexingHF::FillListOfCuts() {
@@ -457,6 +568,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   } else {
     AliDebug(2,"Creating HF candidates from ESD");
   }
+  fnAllocInEvent=0;
 
   if(!aodVerticesHFTClArr) {
     printf("ERROR: no aodVerticesHFTClArr");
@@ -610,21 +722,34 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   // and retrieves primary vertex
   TObjArray seleTrksArray(trkEntries);
   TObjArray tracksAtVertex(trkEntries);
-  UChar_t  *seleFlags = new UChar_t[trkEntries]; // bit 0: displaced, bit 1: softpi, bit 2: 3 prong, bits 3-4-5: for PID
+  PrepareScratchObjects(trkEntries);
+  UChar_t  *seleFlags = fSeleFlags; // bit 0: displaced, bit 1: softpi, bit 2: 3 prong, bits 3-4-5: for PID
   Int_t     nSeleTrks=0;
-  Int_t *evtNumber    = new Int_t[trkEntries];
+  Int_t *evtNumber    = fEvtNumber;
   SelectTracksAndCopyVertex(event,trkEntries,seleTrksArray,tracksAtVertex,nSeleTrks,seleFlags,evtNumber);
 
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // momenta at the primary vertex of the selected tracks, for the
+  // invariant mass check of the 3 and 4 prong combinations (SetMassCutBeforeVertexing)
+  for(Int_t iSele=0; iSele<nSeleTrks; iSele++) {
+    ((AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iSele))->GetPxPyPz(&fSeleMom[3*iSele]);
+  }
+  Long64_t nEarlyMassCutTestedStart=fnEarlyMassCutTested;
+  Long64_t nEarlyMassCutKeptStart=fnEarlyMassCutKept;
+  // bounds and pair table of the pre-selection of the track combinations
+  if(fPreselectCombinations) PreparePreselection(nSeleTrks);
+  Long64_t nPreselTestedStart=fnPreselTested;
+  Long64_t nPreselKeptStart=fnPreselKept;
 
-  TObjArray *twoTrackArray1    = new TObjArray(2);
-  TObjArray *twoTrackArray2    = new TObjArray(2);
-  TObjArray *twoTrackArrayV0   = new TObjArray(2);
-  TObjArray *twoTrackArrayCasc = new TObjArray(2);
-  TObjArray *threeTrackArray   = new TObjArray(3);
-  TObjArray *fourTrackArray    = new TObjArray(4);
+
+  TObjArray *twoTrackArray1    = fTwoTrackArray1;
+  TObjArray *twoTrackArray2    = fTwoTrackArray2;
+  TObjArray *twoTrackArrayV0   = fTwoTrackArrayV0;
+  TObjArray *twoTrackArrayCasc = fTwoTrackArrayCasc;
+  TObjArray *threeTrackArray   = fThreeTrackArray;
+  TObjArray *fourTrackArray    = fFourTrackArray;
 
   Double_t dispersion;
   Bool_t isLikeSign2Prong=kFALSE,isLikeSign3Prong=kFALSE;
@@ -693,14 +818,16 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
           // avoid ghost TPC tracks
           if(!(posVV0track->GetStatus() & AliESDtrack::kTPCrefit) ||
              !(negVV0track->GetStatus() & AliESDtrack::kTPCrefit)) continue;
-          // Get AliExternalTrackParam out of the AliAODTracks
+          // Get AliExternalTrackParam out of the AliAODTracks (reusing the scratch objects)
           Double_t xyz[3], pxpypz[3], cv[21]; Short_t sign;
           posVV0track->PxPyPz(pxpypz); 	              posVV0track->XvYvZv(xyz);
           posVV0track->GetCovarianceXYZPxPyPz(cv);	  sign=posVV0track->Charge();
-          posV0track = new AliExternalTrackParam(xyz,pxpypz,cv,sign);
+          *fV0PosTrack = AliExternalTrackParam(xyz,pxpypz,cv,sign);
+          posV0track = fV0PosTrack;
           negVV0track->PxPyPz(pxpypz); 	              negVV0track->XvYvZv(xyz);
           negVV0track->GetCovarianceXYZPxPyPz(cv);	  sign=negVV0track->Charge();
-          negV0track = new AliExternalTrackParam(xyz,pxpypz,cv,sign);
+          *fV0NegTrack = AliExternalTrackParam(xyz,pxpypz,cv,sign);
+          negV0track = fV0NegTrack;
         }  else {
           AliESDtrack *posVV0track = (AliESDtrack*)(event->GetTrack( esdV0->GetPindex() ));
           AliESDtrack *negVV0track = (AliESDtrack*)(event->GetTrack( esdV0->GetNindex() ));
@@ -718,9 +845,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
              !(negVV0track->GetStatus() & AliESDtrack::kTPCrefit)) continue;
           //  reject kinks (only necessary on AliESDtracks)
           if (posVV0track->GetKinkIndex(0)>0  || negVV0track->GetKinkIndex(0)>0) continue;
-          // Get AliExternalTrackParam out of the AliESDtracks
-          posV0track = new AliExternalTrackParam(*posVV0track);
-          negV0track = new AliExternalTrackParam(*negVV0track);
+          // Get AliExternalTrackParam out of the AliESDtracks (reusing the scratch objects)
+          *fV0PosTrack = *posVV0track;
+          posV0track = fV0PosTrack;
+          *fV0NegTrack = *negVV0track;
+          negV0track = fV0NegTrack;
 
           // Define the AODv0 from ESDv0 if reading ESDs
           v0 = TransformESDv0toAODv0(esdV0,twoTrackArrayV0);
@@ -741,13 +870,17 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
         AliNeutralTrackParam *trackV0=NULL;
         if(fInputAOD) {
           const AliVTrack *trackVV0 = dynamic_cast<const AliVTrack*>(v0);
-          if(trackVV0)  trackV0 = new AliNeutralTrackParam(trackVV0);
+          if(trackVV0) {
+            *fV0Track = AliNeutralTrackParam(trackVV0);
+            trackV0 = fV0Track;
+          }
         } else {
           Double_t xyz[3], pxpypz[3];
           esdV0->XvYvZv(xyz);
           esdV0->PxPyPz(pxpypz);
           Double_t cv[21]; for(int i=0; i<21; i++) cv[i]=0;
-          trackV0 = new AliNeutralTrackParam(xyz,pxpypz,cv,0);
+          *fV0Track = AliNeutralTrackParam(xyz,pxpypz,cv,0);
+          trackV0 = fV0Track;
         }
 
 
@@ -760,20 +893,18 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
           // DCA between the two tracks
           dcaCasc = postrack1->GetDCA(trackV0,fBzkG,xdummy,ydummy);
           // Vertexing+
-          vertexCasc = ReconstructSecondaryVertex(twoTrackArrayCasc,dispersion,kFALSE);
+          vertexCasc = ReconstructSecondaryVertex(twoTrackArrayCasc,dispersion,kFALSE,fVtxCasc);
         } else {
           // assume Cascade decays at the primary vertex
           Double_t pos[3],cov[6],chi2perNDF;
           fV1->GetXYZ(pos);
           fV1->GetCovMatrix(cov);
           chi2perNDF = fV1->GetChi2toNDF();
-          vertexCasc = new AliAODVertex(pos,cov,chi2perNDF,0x0,-1,AliAODVertex::kUndef,2);
+          FillVertex(fVtxCasc,pos,cov,chi2perNDF);
+          vertexCasc = fVtxCasc;
           dcaCasc = 0.;
         }
         if(!vertexCasc) {
-          delete posV0track; posV0track=NULL;
-          delete negV0track; negV0track=NULL;
-          delete trackV0; trackV0=NULL;
           if(!fInputAOD) {delete v0; v0=NULL;}
           twoTrackArrayV0->Clear();
           twoTrackArrayCasc->Clear();
@@ -790,6 +921,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
             UShort_t id[2]={(UShort_t)postrack1->GetID(),(UShort_t)iv0};
             rc->SetProngIDs(2,id);
             rc->DeleteRecoD();
+            rc->SetSecondaryVtx(0x0);
           }else{
             AliAODVertex *vCasc = new(verticesHFRef[iVerticesHF++])AliAODVertex(*vertexCasc);
             rc->SetSecondaryVtx(vCasc);
@@ -802,14 +934,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
         }
 
 
-        // Clean up
-        delete posV0track; posV0track=NULL;
-        delete negV0track; negV0track=NULL;
-        delete trackV0; trackV0=NULL;
+        // Clean up (the V0 track parameters are scratch objects, not owned here)
         twoTrackArrayV0->Clear();
         twoTrackArrayCasc->Clear();
-        if(ioCascade) { delete ioCascade; ioCascade=NULL; }
-        if(vertexCasc) { delete vertexCasc; vertexCasc=NULL; }
+        ioCascade=NULL;
+        vertexCasc=NULL;
         if(!fInputAOD) {delete v0; v0=NULL;}
 
       } // end loop on V0's
@@ -859,6 +988,24 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
       }
 
+      // pre-selection: skip the pair if neither the 2 prong nor a 3/4 prong
+      // built on it can pass the mass and pt windows, or if its DCA already
+      // failed the cut
+      Bool_t reach2Prong=kTRUE, reach34Prong=kTRUE;
+      if(fPreselectCombinations) {
+	fnPreselTested++;
+	const Int_t iPair[2]={iTrkP1,iTrkN1};
+	reach2Prong = (fD0toKpi || fJPSItoEle || fDstar || fLikeSign) && Reachable2Prong(iTrkP1,iTrkN1);
+	reach34Prong = (f3Prong || f4Prong) && !(isLikeSign2Prong && !f3Prong) &&
+	  TESTBIT(seleFlags[iTrkP1],kBit3Prong) && TESTBIT(seleFlags[iTrkN1],kBit3Prong) &&
+	  ReachableAsPartOf(2,iPair,f3Prong,f4Prong && !isLikeSign2Prong);
+	if((!reach2Prong && !reach34Prong) || PairDCAFailed(iTrkP1,iTrkN1,kBitPairDCAFailed)) {
+	  negtrack1=0;
+	  continue;
+	}
+	fnPreselKept++;
+      }
+
       // back to primary vertex
       //      postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
       //      negtrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -868,21 +1015,22 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
       // DCA between the two tracks
       dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+      StorePairDCA(iTrkP1,iTrkN1,dcap1n1,dcaMax);
       if(dcap1n1>dcaMax) { negtrack1=0; continue; }
 
       // Vertexing
       twoTrackArray1->AddAt(postrack1,0);
       twoTrackArray1->AddAt(negtrack1,1);
-      AliAODVertex *vertexp1n1 = ReconstructSecondaryVertex(twoTrackArray1,dispersion);
+      AliAODVertex *vertexp1n1 = ReconstructSecondaryVertex(twoTrackArray1,dispersion,kTRUE,fVtx2Prong);
       if(!vertexp1n1) {
 	twoTrackArray1->Clear();
 	negtrack1=0;
 	continue;
       }
       // 2 prong candidate
-      if(fD0toKpi || fJPSItoEle || fDstar || fLikeSign) {
+      if((fD0toKpi || fJPSItoEle || fDstar || fLikeSign) && reach2Prong) {
 
-	io2Prong = Make2Prong(twoTrackArray1,event,vertexp1n1,dcap1n1,okD0,okJPSI,okD0fromDstar);
+	io2Prong = Make2Prong(twoTrackArray1,event,vertexp1n1,dcap1n1,okD0,okJPSI,okD0fromDstar,kFALSE,fScratch2Prong);
 
 	if((fD0toKpi && okD0) || (fJPSItoEle && okJPSI) || (isLikeSign2Prong && (okD0 || okJPSI))) {
 	  // add the vertex and the decay to the AOD
@@ -895,6 +1043,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
               if(fMakeReducedRHF){
 		rd->DeleteRecoD();
+		rd->SetSecondaryVtx(0x0);
 		rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
               }else{
 		rd->SetSecondaryVtx(v2Prong);
@@ -906,8 +1055,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	      rd = new(aodJPSItoEleRef[iJPSItoEle++])AliAODRecoDecayHF2Prong(*io2Prong);
 	      if(fMakeReducedRHF){
 		rd->DeleteRecoD();
+		rd->SetSecondaryVtx(0x0);
 		rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
 	      }else{
+		rd->SetSecondaryVtx(v2Prong);
 		if(!okD0) v2Prong->SetParent(rd); // it cannot have two mothers ...
 		AddRefs(v2Prong,rd,event,twoTrackArray1);
               }
@@ -918,6 +1069,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    if(okD0) SetSelectionBitForPID(fCutsD0toKpi,rd,AliRDHFCuts::kD0toKpiPID);
 	    if(fMakeReducedRHF){
 	      rd->DeleteRecoD();
+	      rd->SetSecondaryVtx(0x0);
 	      rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
 	    }else{
 	      rd->SetSecondaryVtx(v2Prong);
@@ -938,7 +1090,8 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  io2Prong->SetSecondaryVtx(vertexp1n1);
           //printf("--->  %d %d %d %d %d\n",vertexp1n1->GetNDaughters(),iTrkP1,iTrkN1,postrack1->Charge(),negtrack1->Charge());
 	  // create a track from the D0
-	  AliNeutralTrackParam *trackD0 = new AliNeutralTrackParam(io2Prong);
+	  *fD0Track = AliNeutralTrackParam(io2Prong);
+	  AliNeutralTrackParam *trackD0 = fD0Track;
 
 	  // LOOP ON TRACKS THAT PASSED THE SOFT PION CUTS
 	  for(iTrkSoftPi=0; iTrkSoftPi<nSeleTrks; iTrkSoftPi++) {
@@ -976,14 +1129,15 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	      // DCA between the two tracks
 	      dcaCasc = trackPi->GetDCA(trackD0,fBzkG,xdummy,ydummy);
 	      // Vertexing
-	      vertexCasc = ReconstructSecondaryVertex(twoTrackArrayCasc,dispersion,kFALSE);
+	      vertexCasc = ReconstructSecondaryVertex(twoTrackArrayCasc,dispersion,kFALSE,fVtxCasc);
 	    } else {
 	      // assume Dstar decays at the primary vertex
 	      Double_t pos[3],cov[6],chi2perNDF;
 	      fV1->GetXYZ(pos);
 	      fV1->GetCovMatrix(cov);
 	      chi2perNDF = fV1->GetChi2toNDF();
-	      vertexCasc = new AliAODVertex(pos,cov,chi2perNDF,0x0,-1,AliAODVertex::kUndef,2);
+	      FillVertex(fVtxCasc,pos,cov,chi2perNDF);
+	      vertexCasc = fVtxCasc;
 	      dcaCasc = 0.;
 	    }
 	    if(!vertexCasc) {
@@ -999,6 +1153,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	        rd = new(aodD0toKpiRef[iD0toKpi++])AliAODRecoDecayHF2Prong(*io2Prong);
                  if(fMakeReducedRHF){
 		   rd->DeleteRecoD();
+		   rd->SetSecondaryVtx(0x0);
 		   rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
 	         }else{
 		   AliAODVertex *v2Prong = new (verticesHFRef[iVerticesHF++])AliAODVertex(*vertexp1n1);
@@ -1018,6 +1173,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 		 UShort_t idCasc[2]={(UShort_t)trackPi->GetID(),(UShort_t)(iD0toKpi-1)};
 		 rc->SetProngIDs(2,idCasc);
 		 rc->DeleteRecoD();
+		 rc->SetSecondaryVtx(0x0);
 		 rc->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
 	       }else{
 		 AliAODVertex *vCasc = new(verticesHFRef[iVerticesHF++])AliAODVertex(*vertexCasc);
@@ -1030,21 +1186,18 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
             }
 	    twoTrackArrayCasc->Clear();
 	    trackPi=0;
-	    if(ioCascade) {delete ioCascade; ioCascade=NULL;}
-	    delete vertexCasc; vertexCasc=NULL;
+	    ioCascade=NULL;
+	    vertexCasc=NULL;
 	  } // end loop on soft pi tracks
 
-	  if(trackD0) {delete trackD0; trackD0=NULL;}
-
 	}
-	if(io2Prong) {delete io2Prong; io2Prong=NULL;}
+	io2Prong=NULL;
       }
 
       twoTrackArray1->Clear();
       if( (!f3Prong && !f4Prong) ||
-	  (isLikeSign2Prong && !f3Prong) ) {
+	  (isLikeSign2Prong && !f3Prong) || !reach34Prong ) {
 	negtrack1=0;
-	delete vertexp1n1;
 	continue;
       }
 
@@ -1121,6 +1274,48 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  if(!TESTBIT(seleFlags[iTrkP1],kBitKaonCompat) &&
 	     !TESTBIT(seleFlags[iTrkP2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
 	}
+
+	// check invariant mass cuts for D+,Ds,Lc
+	// (only the momenta at the primary vertex are needed, so with
+	// SetMassCutBeforeVertexing the check is done before computing any DCA)
+        massCutOK=kTRUE;
+	if(f3Prong && fMassCutBeforeVertexing) {
+	  mompos2[0]=fSeleMom[3*iTrkP2]; mompos2[1]=fSeleMom[3*iTrkP2+1]; mompos2[2]=fSeleMom[3*iTrkP2+2];
+	  Double_t pxDau[3]={mompos1[0],momneg1[0],mompos2[0]};
+	  Double_t pyDau[3]={mompos1[1],momneg1[1],mompos2[1]};
+	  Double_t pzDau[3]={mompos1[2],momneg1[2],mompos2[2]};
+	  //	  massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
+	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
+	  fnEarlyMassCutTested++;
+	  if(massCutOK) fnEarlyMassCutKept++;
+	  if(!massCutOK && !f4Prong) {
+	    threeTrackArray->Clear();
+	    postrack2=0;
+	    continue;
+	  }
+	}
+
+	// pre-selection: skip the triplet if neither the 3 prong nor a 4 prong
+	// built on it can pass the mass and pt windows, or if one of its DCAs
+	// already failed the cut
+	Bool_t reach3Prong=kTRUE, reach4Prong=kTRUE;
+	if(fPreselectCombinations) {
+	  fnPreselTested++;
+	  const Int_t iTriplet[3]={iTrkP1,iTrkN1,iTrkP2};
+	  reach3Prong = f3Prong && massCutOK && Reachable3Prong(iTrkP1,iTrkN1,iTrkP2);
+	  reach4Prong = f4Prong && !isLikeSign2Prong && !isLikeSign3Prong &&
+	    dcap1n1 < fCutsD0toKpipipi->GetDCACut() &&
+	    ReachableAsPartOf(3,iTriplet,kFALSE,kTRUE);
+	  if((!reach3Prong && !reach4Prong) ||
+	     PairDCAFailed(iTrkP2,iTrkN1,kBitPairDCAFailed) ||
+	     PairDCAFailed(iTrkP2,iTrkP1,kBitPairDCAFailed)) {
+	    threeTrackArray->Clear();
+	    postrack2=0;
+	    continue;
+	  }
+	  fnPreselKept++;
+	}
+
 	// back to primary vertex
 	//	postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
 	//	postrack2->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1132,12 +1327,12 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
 
 	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+	StorePairDCA(iTrkP2,iTrkN1,dcap2n1,dcaMax);
 	if(dcap2n1>dcaMax) { postrack2=0; continue; }
 	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
+	StorePairDCA(iTrkP2,iTrkP1,dcap1p2,dcaMax);
 	if(dcap1p2>dcaMax) { postrack2=0; continue; }
 
-	// check invariant mass cuts for D+,Ds,Lc
-        massCutOK=kTRUE;
 	if(f3Prong) {
 	  if(postrack2->Charge()>0) {
 	    threeTrackArray->AddAt(postrack1,0);
@@ -1148,14 +1343,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    threeTrackArray->AddAt(postrack1,1);
 	    threeTrackArray->AddAt(postrack2,2);
 	  }
-	  if(fMassCutBeforeVertexing){
-	    postrack2->GetPxPyPz(mompos2);
-	    Double_t pxDau[3]={mompos1[0],momneg1[0],mompos2[0]};
-	    Double_t pyDau[3]={mompos1[1],momneg1[1],mompos2[1]};
-	    Double_t pzDau[3]={mompos1[2],momneg1[2],mompos2[2]};
-	    //	    massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
-	    massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
-	  }
 	}
 
 	if(f3Prong && !massCutOK) {
@@ -1169,7 +1356,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	// Vertexing
 	twoTrackArray2->AddAt(postrack2,0);
 	twoTrackArray2->AddAt(negtrack1,1);
-	AliAODVertex *vertexp2n1 = ReconstructSecondaryVertex(twoTrackArray2,dispersion);
+	AliAODVertex *vertexp2n1 = ReconstructSecondaryVertex(twoTrackArray2,dispersion,kTRUE,fVtx2ProngB);
 	if(!vertexp2n1) {
 	  twoTrackArray2->Clear();
 	  postrack2=0;
@@ -1177,9 +1364,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	}
 
 	// 3 prong candidates
-	if(f3Prong && massCutOK) {
+	if(f3Prong && massCutOK && reach3Prong) {
 
-	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
+	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion,kTRUE,fVtx3Prong);
 	  io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,vertexp2n1,dcap1n1,dcap2n1,dcap1p2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
 	  if(ok3Prong) {
             AliAODVertex *v3Prong=0x0;
@@ -1193,6 +1380,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	      if(fMakeReducedRHF){
 		rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
                 ((AliAODRecoDecayHF3Prong*)rd)->DeleteRecoD();
+                rd->SetSecondaryVtx(0x0);
 	      }else{
                 v3Prong = new (verticesHFRef[iVerticesHF++])AliAODVertex(*secVert3PrAOD);
 		rd->SetSecondaryVtx(v3Prong);
@@ -1209,6 +1397,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
                 if(fMakeReducedRHF){
 		  rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
                   ((AliAODRecoDecayHF3Prong*)rd)->DeleteRecoD();
+                  rd->SetSecondaryVtx(0x0);
 		}else{
 		  rd->SetSecondaryVtx(v3Prong);
 		  v3Prong->SetParent(rd);
@@ -1218,12 +1407,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    }
 
 	  }
-	  if(io3Prong) {delete io3Prong; io3Prong=NULL;}
-	  if(secVert3PrAOD) {delete secVert3PrAOD; secVert3PrAOD=NULL;}
+	  io3Prong=NULL;
 	}
 
 	// 4 prong candidates
-	if(f4Prong
+	if(f4Prong && reach4Prong
 	   // don't make 4 prong with like-sign pairs and triplets
 	   && !isLikeSign2Prong && !isLikeSign3Prong
 	   // track-to-track dca cuts already now
@@ -1241,7 +1429,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
           threeTrackArray->AddAt(postrack1,0);
           threeTrackArray->AddAt(negtrack1,1);
 	  threeTrackArray->AddAt(postrack2,2);
-          AliAODVertex* vertexp1n1p2 = ReconstructSecondaryVertex(threeTrackArray,dispersion);
+          AliAODVertex* vertexp1n1p2 = ReconstructSecondaryVertex(threeTrackArray,dispersion,kTRUE,fVtx3ProngFor4);
 
 	  // 3rd LOOP  ON  NEGATIVE  TRACKS (for 4 prong)
 	  for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
@@ -1265,6 +1453,41 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 		 evtNumber[iTrkN1]==evtNumber[iTrkP2]) continue;
 	    }
 
+	    // check invariant mass cuts for D0 (before the DCAs, see above)
+	    massCutOK=kTRUE;
+	    if(fMassCutBeforeVertexing) {
+	      const Int_t iDau[4]={iTrkP1,iTrkN1,iTrkP2,iTrkN2};
+	      Double_t pxDau[4],pyDau[4],pzDau[4];
+	      for(Int_t iDa=0; iDa<4; iDa++) {
+		pxDau[iDa]=fSeleMom[3*iDau[iDa]];
+		pyDau[iDa]=fSeleMom[3*iDau[iDa]+1];
+		pzDau[iDa]=fSeleMom[3*iDau[iDa]+2];
+	      }
+	      massCutOK = SelectInvMassAndPt4prong(pxDau,pyDau,pzDau);
+	      fnEarlyMassCutTested++;
+	      if(massCutOK) fnEarlyMassCutKept++;
+	    }
+	    if(!massCutOK) {
+	      fourTrackArray->Clear();
+	      negtrack2=0;
+	      continue;
+	    }
+
+	    // pre-selection of the 4 prong (mass and pt windows, DCAs that
+	    // already failed the cut)
+	    if(fPreselectCombinations) {
+	      fnPreselTested++;
+	      const Int_t iQuad[4]={iTrkP1,iTrkN1,iTrkP2,iTrkN2};
+	      if(!Reachable4Prong(iQuad) ||
+		 PairDCAFailed(iTrkP1,iTrkN2,kBitPairDCA4ProngFailed) ||
+		 PairDCAFailed(iTrkP2,iTrkN2,kBitPairDCA4ProngFailed)) {
+		fourTrackArray->Clear();
+		negtrack2=0;
+		continue;
+	      }
+	      fnPreselKept++;
+	    }
+
 	    // back to primary vertex
 	    // postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
 	    // postrack2->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1276,8 +1499,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
 	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	    StorePairDCA(iTrkP1,iTrkN2,dcap1n2,dcaMax);
 	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
             dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	    StorePairDCA(iTrkP2,iTrkN2,dcap2n2,dcaMax);
             if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
 
 
@@ -1286,24 +1511,14 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    fourTrackArray->AddAt(postrack2,2);
 	    fourTrackArray->AddAt(negtrack2,3);
 
-	    // check invariant mass cuts for D0
-	    massCutOK=kTRUE;
-	    if(fMassCutBeforeVertexing)
-	      massCutOK = SelectInvMassAndPt4prong(fourTrackArray);
-
-	    if(!massCutOK) {
-	      fourTrackArray->Clear();
-	      negtrack2=0;
-	      continue;
-	    }
-
 	    // Vertexing
-	    AliAODVertex* secVert4PrAOD = ReconstructSecondaryVertex(fourTrackArray,dispersion);
+	    AliAODVertex* secVert4PrAOD = ReconstructSecondaryVertex(fourTrackArray,dispersion,kTRUE,fVtx4Prong);
 	    io4Prong = Make4Prong(fourTrackArray,event,secVert4PrAOD,vertexp1n1,vertexp1n1p2,dcap1n1,dcap1n2,dcap2n1,dcap2n2,ok4Prong);
 	    if(ok4Prong) {
 	      rd = new(aodCharm4ProngRef[i4Prong++])AliAODRecoDecayHF4Prong(*io4Prong);
 	      if(fMakeReducedRHF){
 		rd->DeleteRecoD();
+		rd->SetSecondaryVtx(0x0);
 		rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
 	      }else{
                 AliAODVertex *v4Prong = new(verticesHFRef[iVerticesHF++])AliAODVertex(*secVert4PrAOD);
@@ -1313,20 +1528,17 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	      }
             }
 
-	    if(io4Prong) {delete io4Prong; io4Prong=NULL;}
-	    if(secVert4PrAOD) {delete secVert4PrAOD; secVert4PrAOD=NULL;}
+	    io4Prong=NULL;
 	    fourTrackArray->Clear();
 	    negtrack2 = 0;
 
 	  } // end loop on negative tracks
 
           threeTrackArray->Clear();
-	  delete vertexp1n1p2;
 
 	}
 
 	postrack2 = 0;
-	delete vertexp2n1;
 
       } // end 2nd loop on positive tracks
 
@@ -1400,6 +1612,38 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	     !TESTBIT(seleFlags[iTrkN2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
 	}
 
+	// check invariant mass cuts for D+,Ds,Lc (before the DCAs, see above)
+        massCutOK=kTRUE;
+	if(fMassCutBeforeVertexing && f3Prong){
+	  momneg2[0]=fSeleMom[3*iTrkN2]; momneg2[1]=fSeleMom[3*iTrkN2+1]; momneg2[2]=fSeleMom[3*iTrkN2+2];
+	  Double_t pxDau[3]={momneg1[0],mompos1[0],momneg2[0]};
+	  Double_t pyDau[3]={momneg1[1],mompos1[1],momneg2[1]};
+	  Double_t pzDau[3]={momneg1[2],mompos1[2],momneg2[2]};
+	  //	  massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
+	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
+	  fnEarlyMassCutTested++;
+	  if(massCutOK) fnEarlyMassCutKept++;
+	}
+	if(!massCutOK) {
+	  threeTrackArray->Clear();
+	  negtrack2=0;
+	  continue;
+	}
+
+	// pre-selection of the 3 prong (mass and pt windows, DCAs that
+	// already failed the cut)
+	if(fPreselectCombinations) {
+	  fnPreselTested++;
+	  if(!f3Prong || !Reachable3Prong(iTrkN1,iTrkP1,iTrkN2) ||
+	     PairDCAFailed(iTrkP1,iTrkN2,kBitPairDCAFailed) ||
+	     PairDCAFailed(iTrkN1,iTrkN2,kBitPairDCAFailed)) {
+	    threeTrackArray->Clear();
+	    negtrack2=0;
+	    continue;
+	  }
+	  fnPreselKept++;
+	}
+
 	// back to primary vertex
 	// postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
 	// negtrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1410,35 +1654,21 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
 
 	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	StorePairDCA(iTrkP1,iTrkN2,dcap1n2,dcaMax);
 	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
 	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	StorePairDCA(iTrkN1,iTrkN2,dcan1n2,dcaMax);
 	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
 
 	threeTrackArray->AddAt(negtrack1,0);
 	threeTrackArray->AddAt(postrack1,1);
 	threeTrackArray->AddAt(negtrack2,2);
 
-	// check invariant mass cuts for D+,Ds,Lc
-        massCutOK=kTRUE;
-	if(fMassCutBeforeVertexing && f3Prong){
-	  negtrack2->GetPxPyPz(momneg2);
-	  Double_t pxDau[3]={momneg1[0],mompos1[0],momneg2[0]};
-	  Double_t pyDau[3]={momneg1[1],mompos1[1],momneg2[1]};
-	  Double_t pzDau[3]={momneg1[2],mompos1[2],momneg2[2]};
-	  //	  massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
-	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
-	}
-	if(!massCutOK) {
-	  threeTrackArray->Clear();
-	  negtrack2=0;
-	  continue;
-	}
-
 	// Vertexing
 	twoTrackArray2->AddAt(postrack1,0);
 	twoTrackArray2->AddAt(negtrack2,1);
 
-	AliAODVertex *vertexp1n2 = ReconstructSecondaryVertex(twoTrackArray2,dispersion);
+	AliAODVertex *vertexp1n2 = ReconstructSecondaryVertex(twoTrackArray2,dispersion,kTRUE,fVtx2ProngB);
 	if(!vertexp1n2) {
 	  twoTrackArray2->Clear();
 	  negtrack2=0;
@@ -1446,7 +1676,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	}
 
 	if(f3Prong) {
-	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
+	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion,kTRUE,fVtx3Prong);
 	  io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,vertexp1n2,dcap1n1,dcap1n2,dcan1n2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
 	  if(ok3Prong) {
 	    AliAODVertex *v3Prong = 0x0;
@@ -1459,6 +1689,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	      if(fMakeReducedRHF){
 		rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
                 ((AliAODRecoDecayHF3Prong*)rd)->DeleteRecoD();
+                rd->SetSecondaryVtx(0x0);
 	      }else{
 		rd->SetSecondaryVtx(v3Prong);
 		v3Prong->SetParent(rd);
@@ -1473,6 +1704,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	        if(fMakeReducedRHF){
 		  rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
                   ((AliAODRecoDecayHF3Prong*)rd)->DeleteRecoD();
+                  rd->SetSecondaryVtx(0x0);
 	        }else{
                   rd->SetSecondaryVtx(v3Prong);
                   v3Prong->SetParent(rd);
@@ -1482,19 +1714,16 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	    }
 	  }
-	  if(io3Prong) {delete io3Prong; io3Prong=NULL;}
-	  if(secVert3PrAOD) {delete secVert3PrAOD; secVert3PrAOD=NULL;}
+	  io3Prong=NULL;
 	}
 	threeTrackArray->Clear();
 	negtrack2 = 0;
-	delete vertexp1n2;
 
       } // end 2nd loop on negative tracks
 
       twoTrackArray2->Clear();
 
       negtrack1 = 0;
-      delete vertexp1n1;
     } // end 1st loop on negative tracks
 
     postrack1 = 0;
@@ -1537,15 +1766,13 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   }
 
 
-  twoTrackArray1->Delete();  delete twoTrackArray1;
-  twoTrackArray2->Delete();  delete twoTrackArray2;
-  twoTrackArrayCasc->Delete();  delete twoTrackArrayCasc;
-  twoTrackArrayV0->Delete();  delete twoTrackArrayV0;
+  // the scratch arrays never own their entries: only reset them for the next event
+  twoTrackArray1->Clear();
+  twoTrackArray2->Clear();
+  twoTrackArrayCasc->Clear();
+  twoTrackArrayV0->Clear();
   threeTrackArray->Clear();
-  threeTrackArray->Delete(); delete threeTrackArray;
-  fourTrackArray->Delete();  delete fourTrackArray;
-  delete [] seleFlags; seleFlags=NULL;
-  if(evtNumber) {delete [] evtNumber; evtNumber=NULL;}
+  fourTrackArray->Clear();
   tracksAtVertex.Delete();
 
   if(fInputAOD) {
@@ -1556,6 +1783,13 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
   //printf("Trks: total %d  sele %d\n",fnTrksTotal,fnSeleTrksTotal);
 
+  fnAllocTotal += fnAllocInEvent;
+  AliDebug(1,Form(" 3/4 prong combinations in mass check before vertexing: tested %lld, kept %lld",
+		  fnEarlyMassCutTested-nEarlyMassCutTestedStart,fnEarlyMassCutKept-nEarlyMassCutKeptStart));
+  AliDebug(1,Form(" 2/3/4 prong combinations in pre-selection: tested %lld, kept %lld",
+		  fnPreselTested-nPreselTestedStart,fnPreselKept-nPreselKeptStart));
+  AliDebug(1,Form(" Heap allocations of temporaries in event = %d (total %lld)",fnAllocInEvent,fnAllocTotal));
+
   return;
 }
 //----------------------------------------------------------------------------
@@ -1938,6 +2172,7 @@ Bool_t AliAnalysisVertexingHF::FillRecoCasc(AliVEvent *event,AliAODRecoCascadeHF
   rCasc->Setd0Prongs(2,d0);
   rCasc->Setd0errProngs(2,d0err);
   rCasc->SetOwnPrimaryVtx(primVertexAOD);
+  fnAllocInEvent++;
   rCasc->SetCharge(esdB->Charge());
   // get PID info from ESD
   Double_t esdpid0[5]={0.,0.,0.,0.,0.};
@@ -1953,7 +2188,7 @@ Bool_t AliAnalysisVertexingHF::FillRecoCasc(AliVEvent *event,AliAODRecoCascadeHF
 
 
   delete fV1; fV1=0;
-  if(primVertexAOD) {delete primVertexAOD; primVertexAOD=NULL;}
+  primVertexAOD=NULL; // owned by PrimaryVertex
   twoTrackArrayCasc->Clear();
   twoTrackArrayCasc->Delete();  delete twoTrackArrayCasc;
   delete esdB; esdB=NULL;
@@ -2082,6 +2317,7 @@ Bool_t AliAnalysisVertexingHF::RecoSecondaryVertexForCascades(AliVEvent *event,
   
   // - Set data members
   rc->SetOwnPrimaryVtx(primVertexAOD);
+  fnAllocInEvent++;
   rc->SetDCA(dca);
   rc->SetPxPyPzProngs(2, px, py, pz);
   rc->Setd0Prongs(2, d0);
@@ -2095,7 +2331,7 @@ Bool_t AliAnalysisVertexingHF::RecoSecondaryVertexForCascades(AliVEvent *event,
   twoTrackArrayCasc->Clear();
   twoTrackArrayCasc->Delete();  delete twoTrackArrayCasc;
   delete fV1; fV1=0;
-  delete primVertexAOD; primVertexAOD=0;
+  primVertexAOD=0; // owned by PrimaryVertex
   delete esdB;    esdB=0;
   delete trackV0; trackV0=0;
   trackB=0; v0=0;
@@ -2124,10 +2360,11 @@ AliAODRecoCascadeHF* AliAnalysisVertexingHF::MakeCascade(
   Bool_t dummy1,dummy2,dummy3;
 
   // We use Make2Prong to construct the AliAODRecoCascadeHF
-  // (which inherits from AliAODRecoDecayHF2Prong)
+  // (which inherits from AliAODRecoDecayHF2Prong) in the reused
+  // fScratchCascade; the caller copies it to the output only if selected
   AliAODRecoCascadeHF *theCascade =
     (AliAODRecoCascadeHF*)Make2Prong(twoTrackArray,event,secVert,dca,
-				     dummy1,dummy2,dummy3);
+				     dummy1,dummy2,dummy3,kFALSE,fScratchCascade);
   if(!theCascade) return 0x0;
 
   // charge
@@ -2136,38 +2373,36 @@ AliAODRecoCascadeHF* AliAnalysisVertexingHF::MakeCascade(
 
   //--- selection cuts
   //
-  AliAODRecoCascadeHF *tmpCascade = new AliAODRecoCascadeHF(*theCascade);
   if(fInputAOD){
     Int_t idSoftPi=(Int_t)trackPi->GetID();
     if (idSoftPi > -1 && idSoftPi < fAODMapSize) {
       AliAODTrack* trackPiAOD=dynamic_cast<AliAODTrack*>(event->GetTrack(fAODMap[idSoftPi]));
       if(!trackPiAOD) AliFatal("Not a standard AOD");
-      tmpCascade->GetSecondaryVtx()->AddDaughter(trackPiAOD);
+      theCascade->GetSecondaryVtx()->AddDaughter(trackPiAOD);
     }
   }else{
-    tmpCascade->GetSecondaryVtx()->AddDaughter(trackPi);
+    theCascade->GetSecondaryVtx()->AddDaughter(trackPi);
   }
-  tmpCascade->GetSecondaryVtx()->AddDaughter(rd2Prong);
+  theCascade->GetSecondaryVtx()->AddDaughter(rd2Prong);
 
   AliAODVertex *primVertexAOD=0;
   if(!fRecoPrimVtxSkippingTrks && !fRmTrksFromPrimVtx) {
     // take event primary vertex
     primVertexAOD = PrimaryVertex();
-    tmpCascade->SetOwnPrimaryVtx(primVertexAOD);
+    theCascade->SetOwnPrimaryVtx(primVertexAOD);
     rd2Prong->SetOwnPrimaryVtx(primVertexAOD);
+    fnAllocInEvent+=2; // copies made by SetOwnPrimaryVtx
   }
   // select D*->D0pi
   if(fDstar) {
-    okDstar = (Bool_t)fCutsDStartoKpipi->IsSelected(tmpCascade,AliRDHFCuts::kCandidate);
+    okDstar = (Bool_t)fCutsDStartoKpipi->IsSelected(theCascade,AliRDHFCuts::kCandidate);
     if(okDstar) theCascade->SetSelectionBit(AliRDHFCuts::kDstarCuts);
   }
-  tmpCascade->GetSecondaryVtx()->RemoveDaughters();
-  tmpCascade->UnsetOwnPrimaryVtx();
-  delete tmpCascade; tmpCascade=NULL;
+  theCascade->GetSecondaryVtx()->RemoveDaughters();
+  if(primVertexAOD) theCascade->UnsetOwnPrimaryVtx();
   if(!fRecoPrimVtxSkippingTrks && !fRmTrksFromPrimVtx && !fMixEvent) {
     rd2Prong->UnsetOwnPrimaryVtx();
   }
-  if(primVertexAOD) {delete primVertexAOD; primVertexAOD=NULL;}
   //---
 
 
@@ -2215,10 +2450,11 @@ AliAODRecoCascadeHF* AliAnalysisVertexingHF::MakeCascade(
   Bool_t dummy1,dummy2,dummy3;
 
   // We use Make2Prong to construct the AliAODRecoCascadeHF
-  // (which inherits from AliAODRecoDecayHF2Prong)
+  // (which inherits from AliAODRecoDecayHF2Prong) in the reused
+  // fScratchCascade; the caller copies it to the output only if selected
   AliAODRecoCascadeHF *theCascade =
     (AliAODRecoCascadeHF*)Make2Prong(twoTrackArray,event,secVert,dca,
-				     dummy1,dummy2,dummy3);
+				     dummy1,dummy2,dummy3,kFALSE,fScratchCascade);
   if(!theCascade) return 0x0;
 
   // bachelor track and charge
@@ -2227,8 +2463,7 @@ AliAODRecoCascadeHF* AliAnalysisVertexingHF::MakeCascade(
 
   //--- selection cuts
   //
-
-  AliAODRecoCascadeHF *tmpCascade = new AliAODRecoCascadeHF(*theCascade);
+  AliAODRecoCascadeHF *tmpCascade = theCascade;
   if(fInputAOD){
     Int_t idBachelor=(Int_t)trackBachelor->GetID();
     if (idBachelor > -1 && idBachelor < fAODMapSize) {
@@ -2247,6 +2482,7 @@ AliAODRecoCascadeHF* AliAnalysisVertexingHF::MakeCascade(
     primVertexAOD = PrimaryVertex();
     if(!primVertexAOD) primVertexAOD = (AliAODVertex*)event->GetPrimaryVertex();
     tmpCascade->SetOwnPrimaryVtx(primVertexAOD);
+    fnAllocInEvent++;
   }
 
   // select Cascades
@@ -2273,9 +2509,8 @@ AliAODRecoCascadeHF* AliAnalysisVertexingHF::MakeCascade(
     okCascades=kTRUE;
   } // no cuts implemented from ESDs
   tmpCascade->GetSecondaryVtx()->RemoveDaughters();
-  tmpCascade->UnsetOwnPrimaryVtx();
-  delete tmpCascade; tmpCascade=NULL;
-  if(primVertexAOD) {delete primVertexAOD; primVertexAOD=NULL;}
+  if(primVertexAOD) tmpCascade->UnsetOwnPrimaryVtx();
+  primVertexAOD=NULL; // owned by PrimaryVertex or by the event
   //---
 
   return theCascade;
@@ -2337,10 +2572,23 @@ AliAODRecoDecayHF2Prong *AliAnalysisVertexingHF::Make2Prong(
   d0[1] = d0z0[0];
   d0err[1] = TMath::Sqrt(covd0z0[0]);
   AliAODRecoDecayHF2Prong *the2Prong;
-  // create the object AliAODRecoDecayHF2Prong
+  // create the object AliAODRecoDecayHF2Prong, or overwrite the one given
   if(!refill){
-    the2Prong = new AliAODRecoDecayHF2Prong(secVert,px,py,pz,d0,d0err,dca);
+    if(rd) {
+      the2Prong = rd;
+      the2Prong->SetSecondaryVtx(secVert);
+      the2Prong->SetPxPyPzProngs(2,px,py,pz);
+      the2Prong->Setd0Prongs(2,d0);
+      the2Prong->Setd0errProngs(2,d0err);
+      the2Prong->SetDCA(dca);
+      the2Prong->SetCharge(0);
+      the2Prong->ResetSelectionMap();
+    } else {
+      the2Prong = new AliAODRecoDecayHF2Prong(secVert,px,py,pz,d0,d0err,dca);
+      fnAllocInEvent++;
+    }
     the2Prong->SetOwnPrimaryVtx(primVertexAOD);
+    fnAllocInEvent++;
     UShort_t id[2]={(UShort_t)postrack->GetID(),(UShort_t)negtrack->GetID()};
     the2Prong->SetProngIDs(2,id);
      if(postrack->Charge()!=0 && negtrack->Charge()!=0) { // don't apply these cuts if it's a Dstar
@@ -2371,13 +2619,14 @@ AliAODRecoDecayHF2Prong *AliAnalysisVertexingHF::Make2Prong(
     secVert->SetParent(the2Prong);
     AddDaughterRefs(secVert,(AliAODEvent*)event,twoTrackArray);
     the2Prong->SetOwnPrimaryVtx(primVertexAOD);
+    fnAllocInEvent++;
     the2Prong->SetPxPyPzProngs(2,px,py,pz);
     the2Prong->SetDCA(dca);
     the2Prong->Setd0Prongs(2,d0);
     the2Prong->Setd0errProngs(2,d0err);
     the2Prong->SetCharge(0);
   }
-  delete primVertexAOD; primVertexAOD=NULL;
+  primVertexAOD=NULL; // owned by PrimaryVertex
 
   // remove the primary vertex (was used only for selection)
   if(!fRecoPrimVtxSkippingTrks && !fRmTrksFromPrimVtx && !fMixEvent) {
@@ -2470,16 +2719,30 @@ AliAODRecoDecayHF3Prong* AliAnalysisVertexingHF::Make3Prong(
   Short_t charge=(Short_t)(postrack1->Charge()+postrack2->Charge()+negtrack->Charge());
 
 
-  // construct the candidate passing a NULL pointer for the secondary vertex to avoid creation of TRef
-  AliAODRecoDecayHF3Prong *the3Prong = new AliAODRecoDecayHF3Prong(0x0,px,py,pz,d0,d0err,dca,dispersion,dist12,dist23,charge);
+  // construct the candidate, or overwrite the reused one; the secondary
+  // vertex is a reused slot, so referencing it does not create new TRef IDs
+  AliAODRecoDecayHF3Prong *the3Prong = fScratch3Prong;
+  if(the3Prong) {
+    the3Prong->SetSecondaryVtx(secVert);
+    the3Prong->SetPxPyPzProngs(3,px,py,pz);
+    the3Prong->Setd0Prongs(3,d0);
+    the3Prong->Setd0errProngs(3,d0err);
+    the3Prong->SetDCAs(3,dca);
+    the3Prong->SetSigmaVert(dispersion);
+    the3Prong->SetDist12toPrim(dist12);
+    the3Prong->SetDist23toPrim(dist23);
+    the3Prong->SetCharge(charge);
+    the3Prong->ResetSelectionMap();
+  } else {
+    the3Prong = new AliAODRecoDecayHF3Prong(secVert,px,py,pz,d0,d0err,dca,dispersion,dist12,dist23,charge);
+    fnAllocInEvent++;
+  }
   the3Prong->SetOwnPrimaryVtx(primVertexAOD);
-  // add a pointer to the secondary vertex via SetOwnSecondaryVtx (no TRef created)
-  AliAODVertex* ownsecv=secVert->CloneWithoutRefs();
-  the3Prong->SetOwnSecondaryVtx(ownsecv);
+  fnAllocInEvent++;
   UShort_t id[3]={(UShort_t)postrack1->GetID(),(UShort_t)negtrack->GetID(),(UShort_t)postrack2->GetID()};
   the3Prong->SetProngIDs(3,id);
 
-  delete primVertexAOD; primVertexAOD=NULL;
+  primVertexAOD=NULL; // owned by PrimaryVertex
 
   // disable PID, which requires the TRefs to the daughter tracks
   fCutsDplustoKpipi->SetUsePID(kFALSE);
@@ -2508,15 +2771,15 @@ AliAODRecoDecayHF3Prong* AliAnalysisVertexingHF::Make3Prong(
     }
   }
   //if(fDebug) printf("ok3Prong: %d\n",(Int_t)ok3Prong);
-  the3Prong->UnsetOwnSecondaryVtx();
   if(!fRecoPrimVtxSkippingTrks && !fRmTrksFromPrimVtx && !fMixEvent) {
     the3Prong->UnsetOwnPrimaryVtx();
   }
 
-  // Add TRefs to secondary vertex and daughter tracks only for candidates passing the filtering cuts
+  // Keep the TRefs to secondary vertex and daughter tracks only for candidates passing the filtering cuts
   if(ok3Prong && fInputAOD){
-    the3Prong->SetSecondaryVtx(secVert);
     AddDaughterRefs(secVert,(AliAODEvent*)event,threeTrackArray);
+  } else {
+    the3Prong->SetSecondaryVtx(0x0);
   }
 
   // get PID info from ESD
@@ -2604,8 +2867,9 @@ AliAODRecoDecayHF3Prong* AliAnalysisVertexingHF::Make3Prong(
   rd->Setd0errProngs(3,d0err);
   rd->SetCharge(charge);
   rd->SetOwnPrimaryVtx(primVertexAOD);
+  fnAllocInEvent++;
   rd->SetSigmaVert(dispersion);
-  delete primVertexAOD; primVertexAOD=NULL;
+  primVertexAOD=NULL; // owned by PrimaryVertex
 
   if(!fRecoPrimVtxSkippingTrks && !fRmTrksFromPrimVtx && !fMixEvent) {
     rd->UnsetOwnPrimaryVtx();
@@ -2711,12 +2975,28 @@ AliAODRecoDecayHF4Prong* AliAnalysisVertexingHF::Make4Prong(
   Double_t dist3=TMath::Sqrt((vertexp1n1p2->GetX()-pos[0])*(vertexp1n1p2->GetX()-pos[0])+(vertexp1n1p2->GetY()-pos[1])*(vertexp1n1p2->GetY()-pos[1])+(vertexp1n1p2->GetZ()-pos[2])*(vertexp1n1p2->GetZ()-pos[2]));
   Double_t dist4=TMath::Sqrt((secVert->GetX()-pos[0])*(secVert->GetX()-pos[0])+(secVert->GetY()-pos[1])*(secVert->GetY()-pos[1])+(secVert->GetZ()-pos[2])*(secVert->GetZ()-pos[2]));
   Short_t charge=0;
-  AliAODRecoDecayHF4Prong *the4Prong = new AliAODRecoDecayHF4Prong(secVert,px,py,pz,d0,d0err,dca,dist12,dist3,dist4,charge);
+  AliAODRecoDecayHF4Prong *the4Prong = fScratch4Prong;
+  if(the4Prong) {
+    the4Prong->SetSecondaryVtx(secVert);
+    the4Prong->SetPxPyPzProngs(4,px,py,pz);
+    the4Prong->Setd0Prongs(4,d0);
+    the4Prong->Setd0errProngs(4,d0err);
+    the4Prong->SetDCAs(6,dca);
+    the4Prong->SetDist12toPrim(dist12);
+    the4Prong->SetDist3toPrim(dist3);
+    the4Prong->SetDist4toPrim(dist4);
+    the4Prong->SetCharge(charge);
+    the4Prong->ResetSelectionMap();
+  } else {
+    the4Prong = new AliAODRecoDecayHF4Prong(secVert,px,py,pz,d0,d0err,dca,dist12,dist3,dist4,charge);
+    fnAllocInEvent++;
+  }
   the4Prong->SetOwnPrimaryVtx(primVertexAOD);
+  fnAllocInEvent++;
   UShort_t id[4]={(UShort_t)postrack1->GetID(),(UShort_t)negtrack1->GetID(),(UShort_t)postrack2->GetID(),(UShort_t)negtrack2->GetID()};
   the4Prong->SetProngIDs(4,id);
 
-  delete primVertexAOD; primVertexAOD=NULL;
+  primVertexAOD=NULL; // owned by PrimaryVertex
 
   ok4Prong=(Bool_t)fCutsD0toKpipipi->IsSelected(the4Prong,AliRDHFCuts::kCandidate);
 
@@ -2779,37 +3059,52 @@ void AliAnalysisVertexingHF::MapAODtracks(AliVEvent *aod){
 AliAODVertex* AliAnalysisVertexingHF::PrimaryVertex(const TObjArray *trkArray,
 						    AliVEvent *event) const
 {
-  /// Returns primary vertex to be used for this candidate
+  /// Returns primary vertex to be used for this candidate.
+  /// The vertex is owned by this object and overwritten by the next call:
+  /// callers must copy it (e.g. SetOwnPrimaryVtx) and must not delete it
   //AliCodeTimerAuto("",0);
 
-  AliESDVertex *vertexESD = 0;
-  AliAODVertex *vertexAOD = 0;
-
+  Double_t pos[3],cov[6],chi2perNDF;
 
   if(!fRecoPrimVtxSkippingTrks && !fRmTrksFromPrimVtx) {
     // primary vertex from the input event
 
-    vertexESD = new AliESDVertex(*fV1);
+    fV1->GetXYZ(pos); // position
+    fV1->GetCovMatrix(cov); //covariance matrix
+    chi2perNDF = fV1->GetChi2toNDF();
 
   } else {
     // primary vertex specific to this candidate
 
+    AliESDVertex *vertexESD = 0;
     Int_t nTrks = trkArray->GetEntriesFast();
-    AliVertexerTracks *vertexer = new AliVertexerTracks(event->GetMagneticField());
+
+    // the vertexer is kept as long as field and configuration do not change
+    Int_t mode=3;
+    if(fRecoPrimVtxSkippingTrks) {
+      mode=0;
+      if(strstr(fV1->GetTitle(),"VertexerTracksWithConstraint")) mode=1;
+      if(strstr(fV1->GetTitle(),"VertexerTracksWithConstraintOnlyFitter")) mode=2;
+    }
+    if(!fPrimVertexer || mode!=fPrimVertexerMode || event->GetMagneticField()!=fPrimVertexerBz) {
+      delete fPrimVertexer;
+      fPrimVertexer = new AliVertexerTracks(event->GetMagneticField());
+      fnAllocInEvent++;
+      fPrimVertexerMode = mode;
+      fPrimVertexerBz = event->GetMagneticField();
+    }
 
     if(fRecoPrimVtxSkippingTrks) {
       // recalculating the vertex
 
-      if(strstr(fV1->GetTitle(),"VertexerTracksWithConstraint")) {
+      if(mode>0) {
 	Float_t diamondcovxy[3];
 	event->GetDiamondCovXY(diamondcovxy);
-	Double_t pos[3]={event->GetDiamondX(),event->GetDiamondY(),0.};
-	Double_t cov[6]={diamondcovxy[0],diamondcovxy[1],diamondcovxy[2],0.,0.,10.*10.};
-	AliESDVertex *diamond = new AliESDVertex(pos,cov,1.,1);
-	vertexer->SetVtxStart(diamond);
-	delete diamond; diamond=NULL;
-	if(strstr(fV1->GetTitle(),"VertexerTracksWithConstraintOnlyFitter"))
-	  vertexer->SetOnlyFitter();
+	Double_t posd[3]={event->GetDiamondX(),event->GetDiamondY(),0.};
+	Double_t covd[6]={diamondcovxy[0],diamondcovxy[1],diamondcovxy[2],0.,0.,10.*10.};
+	AliESDVertex diamond(posd,covd,1.,1);
+	fPrimVertexer->SetVtxStart(&diamond);
+	if(mode==2) fPrimVertexer->SetOnlyFitter();
       }
       Int_t skipped[1000];
       Int_t nTrksToSkip=0,id;
@@ -2835,19 +3130,33 @@ AliAODVertex* AliAnalysisVertexingHF::PrimaryVertex(const TObjArray *trkArray,
       }
       for(Int_t ijk=nTrksToSkip; ijk<1000; ijk++) skipped[ijk]=-1;
       //
-      vertexer->SetSkipTracks(nTrksToSkip,skipped);
-      vertexESD = (AliESDVertex*)vertexer->FindPrimaryVertex(event);
+      fPrimVertexer->SetSkipTracks(nTrksToSkip,skipped);
+      vertexESD = (AliESDVertex*)fPrimVertexer->FindPrimaryVertex(event);
 
     } else if(fRmTrksFromPrimVtx && nTrks>0) {
-      // removing the prongs tracks
+      // removing the prongs tracks (on copies, refilled by assignment)
 
+      if(!fRmTrksCopies) {
+	fRmTrksCopies = new TObjArray(4);
+	fRmTrksCopies->SetOwner(kTRUE);
+	fnAllocInEvent++;
+      }
+      const Int_t kMaxRmTrks=10;
+      if(nTrks>kMaxRmTrks) AliFatal(Form("Too many tracks to remove from the primary vertex (%d)",nTrks));
       TObjArray rmArray(nTrks);
-      UShort_t *rmId = new UShort_t[nTrks];
+      UShort_t rmId[kMaxRmTrks];
       AliESDtrack *esdTrack = 0;
       AliESDtrack *t = 0;
       for(Int_t i=0; i<nTrks; i++) {
 	t = (AliESDtrack*)trkArray->UncheckedAt(i);
-	esdTrack = new AliESDtrack(*t);
+	esdTrack = (AliESDtrack*)fRmTrksCopies->At(i);
+	if(!esdTrack) {
+	  esdTrack = new AliESDtrack(*t);
+	  fRmTrksCopies->AddAtAndExpand(esdTrack,i);
+	  fnAllocInEvent++;
+	} else {
+	  *esdTrack = *t;
+	}
 	rmArray.AddLast(esdTrack);
 	if(esdTrack->GetID()>=0) {
 	  rmId[i]=(UShort_t)esdTrack->GetID();
@@ -2856,33 +3165,34 @@ AliAODVertex* AliAnalysisVertexingHF::PrimaryVertex(const TObjArray *trkArray,
 	}
       }
       Float_t diamondxy[2]={static_cast<Float_t>(event->GetDiamondX()),static_cast<Float_t>(event->GetDiamondY())};
-      vertexESD = vertexer->RemoveTracksFromVertex(fV1,&rmArray,rmId,diamondxy);
-      delete [] rmId; rmId=NULL;
-      rmArray.Delete();
+      vertexESD = fPrimVertexer->RemoveTracksFromVertex(fV1,&rmArray,rmId,diamondxy);
 
     }
 
-    if(!vertexESD) return vertexAOD;
+    if(!vertexESD) return 0x0;
+    fnAllocInEvent++;
     if(vertexESD->GetNContributors()<=0) {
       //AliDebug(2,"vertexing failed");
       delete vertexESD; vertexESD=NULL;
-      return vertexAOD;
+      return 0x0;
     }
 
-    delete vertexer; vertexer=NULL;
+    vertexESD->GetXYZ(pos); // position
+    vertexESD->GetCovMatrix(cov); //covariance matrix
+    chi2perNDF = vertexESD->GetChi2toNDF();
+    delete vertexESD; vertexESD=NULL;
 
   }
 
   // convert to AliAODVertex
-  Double_t pos[3],cov[6],chi2perNDF;
-  vertexESD->GetXYZ(pos); // position
-  vertexESD->GetCovMatrix(cov); //covariance matrix
-  chi2perNDF = vertexESD->GetChi2toNDF();
-  delete vertexESD; vertexESD=NULL;
-
-  vertexAOD = new AliAODVertex(pos,cov,chi2perNDF);
+  if(!fPrimVtxScratch) {
+    fPrimVtxScratch = new AliAODVertex(pos,cov,chi2perNDF);
+    fnAllocInEvent++;
+  } else {
+    FillVertex(fPrimVtxScratch,pos,cov,chi2perNDF);
+  }
 
-  return vertexAOD;
+  return fPrimVtxScratch;
 }
 //-----------------------------------------------------------------------------
 void AliAnalysisVertexingHF::PrintStatus() const {
@@ -2937,25 +3247,274 @@ void AliAnalysisVertexingHF::PrintStatus() const {
     printf("  Ds -> K0s K cuts:\n");
     if(fCutsDstoK0sK) fCutsDstoK0sK->PrintAll();
   }
+  printf("Heap allocations of candidate-building temporaries: %d in last event, %lld in total\n",fnAllocInEvent,fnAllocTotal);
+  if(fMassCutBeforeVertexing) printf("Mass cut before vertexing of 3/4 prong combinations: %lld tested, %lld kept\n",fnEarlyMassCutTested,fnEarlyMassCutKept);
+  if(fPreselectCombinations) printf("Pre-selection of 2/3/4 prong combinations: %lld tested, %lld kept\n",fnPreselTested,fnPreselKept);
+
+  return;
+}
+//-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::PrepareScratchObjects(Int_t trkEntries){
+  /// Create the per-event temporaries of FindCandidates at the first call
+  /// and only grow them afterwards, so that the candidate loops do not
+  /// allocate track arrays, track parameters, secondary vertices, candidates
+  /// or selection buffers
+
+  if(!fTwoTrackArray1){
+    fTwoTrackArray1    = new TObjArray(2); fnAllocInEvent++;
+    fTwoTrackArray2    = new TObjArray(2); fnAllocInEvent++;
+    fTwoTrackArrayV0   = new TObjArray(2); fnAllocInEvent++;
+    fTwoTrackArrayCasc = new TObjArray(2); fnAllocInEvent++;
+    fThreeTrackArray   = new TObjArray(3); fnAllocInEvent++;
+    fFourTrackArray    = new TObjArray(4); fnAllocInEvent++;
+    fV0PosTrack = new AliExternalTrackParam(); fnAllocInEvent++;
+    fV0NegTrack = new AliExternalTrackParam(); fnAllocInEvent++;
+    fV0Track    = new AliNeutralTrackParam();  fnAllocInEvent++;
+    fD0Track    = new AliNeutralTrackParam();  fnAllocInEvent++;
+  }
+  if(!fVtx2Prong){
+    Double_t pos[3]={0.,0.,0.},cov[6]={0.,0.,0.,0.,0.,0.};
+    fVtx2Prong     = new AliAODVertex(pos,cov,0.,0x0,-1,AliAODVertex::kUndef,0); fnAllocInEvent++;
+    fVtx2ProngB    = new AliAODVertex(pos,cov,0.,0x0,-1,AliAODVertex::kUndef,0); fnAllocInEvent++;
+    fVtx3Prong     = new AliAODVertex(pos,cov,0.,0x0,-1,AliAODVertex::kUndef,0); fnAllocInEvent++;
+    fVtx3ProngFor4 = new AliAODVertex(pos,cov,0.,0x0,-1,AliAODVertex::kUndef,0); fnAllocInEvent++;
+    fVtx4Prong     = new AliAODVertex(pos,cov,0.,0x0,-1,AliAODVertex::kUndef,0); fnAllocInEvent++;
+    fVtxCasc       = new AliAODVertex(pos,cov,0.,0x0,-1,AliAODVertex::kUndef,2); fnAllocInEvent++;
+    Double_t px[4]={0.,0.,0.,0.},d0[4]={0.,0.,0.,0.},dca[6]={0.,0.,0.,0.,0.,0.};
+    fScratch2Prong  = new AliAODRecoDecayHF2Prong(0x0,px,px,px,d0,d0,0.); fnAllocInEvent++;
+    fScratchCascade = new AliAODRecoCascadeHF(0x0,0,px,px,px,d0,d0,0.);   fnAllocInEvent++;
+    fScratch3Prong  = new AliAODRecoDecayHF3Prong(0x0,px,px,px,d0,d0,dca,0.,0.,0.,0); fnAllocInEvent++;
+    fScratch4Prong  = new AliAODRecoDecayHF4Prong(0x0,px,px,px,d0,d0,dca,0.,0.,0.,0); fnAllocInEvent++;
+  }
+  if(trkEntries>fSeleBufSize){
+    delete [] fSeleFlags;
+    delete [] fEvtNumber;
+    delete [] fSeleMom;
+    delete [] fSeleKine;
+    fSeleBufSize = TMath::Max(trkEntries,2*fSeleBufSize);
+    fSeleFlags = new UChar_t[fSeleBufSize];    fnAllocInEvent++;
+    fEvtNumber = new Int_t[fSeleBufSize];      fnAllocInEvent++;
+    fSeleMom = new Double_t[3*fSeleBufSize];   fnAllocInEvent++;
+    fSeleKine = new Double_t[3*fSeleBufSize];  fnAllocInEvent++;
+  }
+
+  return;
+}
+//-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::PreparePreselection(Int_t nSeleTrks){
+  /// Fill the per-track quantities of the pre-selection of the track
+  /// combinations and reset the table of the pair DCAs that failed the cuts.
+  /// pt and pz do not change when a track is propagated to a secondary
+  /// vertex, only the azimuthal direction does, so bounds on the invariant
+  /// mass and pt computed from them hold for the candidate at any vertex
+
+  TDatabasePDG *pdgDB=TDatabasePDG::Instance();
+  fPreselMass[0]=pdgDB->GetParticle(211)->Mass();
+  fPreselMass[1]=pdgDB->GetParticle(321)->Mass();
+  fPreselMass[2]=pdgDB->GetParticle(2212)->Mass();
+  fPreselMass[3]=pdgDB->GetParticle(11)->Mass();
+
+  for(Int_t iSele=0; iSele<nSeleTrks; iSele++) {
+    const Double_t *mom=&fSeleMom[3*iSele];
+    fSeleKine[3*iSele]   = TMath::Sqrt(mom[0]*mom[0]+mom[1]*mom[1]);
+    fSeleKine[3*iSele+1] = mom[2];
+    fSeleKine[3*iSele+2] = mom[0]*mom[0]+mom[1]*mom[1]+mom[2]*mom[2];
+  }
+
+  // one byte per ordered pair, not used above 4000 tracks (16 MB)
+  const Int_t kMaxPairTrks=4000;
+  fPairNTrks=0;
+  if(nSeleTrks>kMaxPairTrks) return;
+  Int_t size=nSeleTrks*nSeleTrks;
+  if(size>fPairBufSize){
+    delete [] fPairDCABits;
+    fPairBufSize = TMath::Min(TMath::Max(size,2*fPairBufSize),kMaxPairTrks*kMaxPairTrks);
+    fPairDCABits = new UChar_t[fPairBufSize];  fnAllocInEvent++;
+  }
+  memset(fPairDCABits,0,size*sizeof(UChar_t));
+  fPairNTrks=nSeleTrks;
+
+  return;
+}
+//-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::StorePairDCA(Int_t iTrk1,Int_t iTrk2,Double_t dca,Double_t dcaMax){
+  /// Remember which DCA cuts the pair failed. The DCA depends only on the
+  /// two tracks at the primary vertex, in this order, so a later combination
+  /// containing the same call can be skipped without computing it again
+
+  if(fPairNTrks<=0) return;
+  UChar_t &bits=fPairDCABits[iTrk1*fPairNTrks+iTrk2];
+  if(dca>dcaMax) SETBIT(bits,kBitPairDCAFailed);
+  if(f4Prong && dca > fCutsD0toKpipipi->GetDCACut()) SETBIT(bits,kBitPairDCA4ProngFailed);
+
+  return;
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::InvMassWindowReachable(Int_t nprongs,const Int_t *iTrk,
+						      const Double_t *mass,Double_t minPt,
+						      Double_t lolim,Double_t hilim) const {
+  /// kFALSE if no direction of the prongs in the transverse plane gives a
+  /// candidate passing the pt and mass cuts of SelectInvMassAndPt*.
+  /// The candidate pt lies between max(0,2 max(pt_i)-sum(pt_i)) and sum(pt_i),
+  /// and M^2 = E^2 - pz^2 - pt^2 with E and pz fixed by the prongs
+
+  const Double_t kTol=1.e-6; // margin for the rounding, relative to E^2
+  Double_t e=0.,pz=0.,sumPt=0.,maxPt=0.;
+  for(Int_t i=0; i<nprongs; i++) {
+    const Double_t *kine=&fSeleKine[3*iTrk[i]];
+    e += TMath::Sqrt(kine[2]+mass[i]*mass[i]);
+    pz += kine[1];
+    sumPt += kine[0];
+    maxPt = TMath::Max(maxPt,kine[0]);
+  }
+  Double_t margin=kTol*e*e;
+  if(minPt>0.1 && sumPt*sumPt < minPt*minPt-margin) return kFALSE;
+  Double_t minPtCand=TMath::Max(0.,2.*maxPt-sumPt);
+  Double_t m2=e*e-pz*pz;
+  if(m2-minPtCand*minPtCand < lolim*lolim-margin) return kFALSE;
+  if(m2-sumPt*sumPt > hilim*hilim+margin) return kFALSE;
+
+  return kTRUE;
+}
+//-----------------------------------------------------------------------------
+Double_t AliAnalysisVertexingHF::MinInvMass(Int_t nprongs,const Int_t *iTrk) const {
+  /// Lower bound of the invariant mass of the prongs, as pions, at any vertex
+
+  const Double_t kTol=1.e-6;
+  Double_t e=0.,pz=0.,sumPt=0.;
+  for(Int_t i=0; i<nprongs; i++) {
+    const Double_t *kine=&fSeleKine[3*iTrk[i]];
+    e += TMath::Sqrt(kine[2]+fPreselMass[0]*fPreselMass[0]);
+    pz += kine[1];
+    sumPt += kine[0];
+  }
+  Double_t m2=e*e-pz*pz-sumPt*sumPt-kTol*e*e;
+
+  return m2>0. ? TMath::Sqrt(m2) : 0.;
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::Reachable2Prong(Int_t iTrk0,Int_t iTrk1) const {
+  /// Can the pair pass one of the invariant mass cuts of Make2Prong?
+
+  if(fCascades) return kTRUE; // the V0 hypotheses of SelectInvMassAndPtCascade are not bounded
+  const Int_t iTrk[2]={iTrk0,iTrk1};
+  const Double_t mPi=fPreselMass[0], mK=fPreselMass[1], mEle=fPreselMass[3];
+  Double_t minPt,mrange;
+  if(fD0toKpi) {
+    const Double_t massPiK[2]={mPi,mK}, massKPi[2]={mK,mPi};
+    minPt=fCutsD0toKpi->GetMinPtCandidate();
+    mrange=fCutsD0toKpi->GetMassCut();
+    if(InvMassWindowReachable(2,iTrk,massPiK,minPt,fMassDzero-mrange,fMassDzero+mrange)) return kTRUE;
+    if(InvMassWindowReachable(2,iTrk,massKPi,minPt,fMassDzero-mrange,fMassDzero+mrange)) return kTRUE;
+  }
+  if(fJPSItoEle) {
+    const Double_t massEE[2]={mEle,mEle};
+    minPt=fCutsJpsitoee->GetMinPtCandidate();
+    mrange=fCutsJpsitoee->GetMassCut();
+    if(InvMassWindowReachable(2,iTrk,massEE,minPt,fMassJpsi-mrange,fMassJpsi+mrange)) return kTRUE;
+  }
+  if(fDstar) {
+    const Double_t massPiD0[2]={mPi,fMassDzero};
+    minPt=fCutsDStartoKpipi->GetMinPtCandidate();
+    mrange=fCutsDStartoKpipi->GetMassCut();
+    if(InvMassWindowReachable(2,iTrk,massPiD0,minPt,fMassDstar-mrange,fMassDstar+mrange)) return kTRUE;
+  }
+
+  return kFALSE;
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::Reachable3Prong(Int_t iTrk0,Int_t iTrk1,Int_t iTrk2) const {
+  /// Can the triplet pass the invariant mass cut of Make3Prong?
+
+  const Int_t iTrk[3]={iTrk0,iTrk1,iTrk2};
+  const Double_t mPi=fPreselMass[0], mK=fPreselMass[1], mP=fPreselMass[2];
+  Double_t minPt=TMath::Min(fCutsDplustoKpipi->GetMinPtCandidate(),fCutsDstoKKpi->GetMinPtCandidate());
+  minPt=TMath::Min(minPt,fCutsLctopKpi->GetMinPtCandidate());
+  Double_t mrange=fCutsDplustoKpipi->GetMassCut();
+  const Double_t massPiKPi[3]={mPi,mK,mPi};
+  if(InvMassWindowReachable(3,iTrk,massPiKPi,minPt,fMassDplus-mrange,fMassDplus+mrange)) return kTRUE;
+  mrange=fCutsDstoKKpi->GetMassCut();
+  const Double_t massKKPi[3]={mK,mK,mPi}, massPiKK[3]={mPi,mK,mK};
+  if(InvMassWindowReachable(3,iTrk,massKKPi,minPt,fMassDs-mrange,fMassDs+mrange)) return kTRUE;
+  if(InvMassWindowReachable(3,iTrk,massPiKK,minPt,fMassDs-mrange,fMassDs+mrange)) return kTRUE;
+  mrange=fCutsLctopKpi->GetMassCut();
+  const Double_t massPKPi[3]={mP,mK,mPi}, massPiKP[3]={mPi,mK,mP};
+  if(InvMassWindowReachable(3,iTrk,massPKPi,minPt,fMassLambdaC-mrange,fMassLambdaC+mrange)) return kTRUE;
+  if(InvMassWindowReachable(3,iTrk,massPiKP,minPt,fMassLambdaC-mrange,fMassLambdaC+mrange)) return kTRUE;
+
+  return kFALSE;
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::Reachable4Prong(const Int_t *iTrk) const {
+  /// Can the quadruplet pass the invariant mass cut of Make4Prong?
+
+  const Double_t mPi=fPreselMass[0], mK=fPreselMass[1];
+  Double_t minPt=fCutsD0toKpipipi->GetMinPtCandidate();
+  Double_t mrange=fCutsD0toKpipipi->GetMassCut();
+  for(Int_t iKaon=0; iKaon<4; iKaon++) {
+    Double_t mass[4]={mPi,mPi,mPi,mPi};
+    mass[iKaon]=mK;
+    if(InvMassWindowReachable(4,iTrk,mass,minPt,fMassDzero-mrange,fMassDzero+mrange)) return kTRUE;
+  }
+
+  return kFALSE;
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::ReachableAsPartOf(Int_t nprongs,const Int_t *iTrk,
+						 Bool_t for3Prong,Bool_t for4Prong) const {
+  /// Can the tracks be part of a 3 or 4 prong passing the mass cut? The
+  /// mass of a system is at least the mass of a subset of it plus the
+  /// masses of the other prongs, taken as pions
+
+  Double_t mMin=MinInvMass(nprongs,iTrk);
+  if(for3Prong && nprongs<3) {
+    Double_t hilim=fMassDplus+fCutsDplustoKpipi->GetMassCut();
+    hilim=TMath::Max(hilim,fMassDs+fCutsDstoKKpi->GetMassCut());
+    hilim=TMath::Max(hilim,fMassLambdaC+fCutsLctopKpi->GetMassCut());
+    if(mMin+(3-nprongs)*fPreselMass[0] < hilim) return kTRUE;
+  }
+  if(for4Prong && nprongs<4) {
+    Double_t hilim=fMassDzero+fCutsD0toKpipipi->GetMassCut();
+    if(mMin+(4-nprongs)*fPreselMass[0] < hilim) return kTRUE;
+  }
+
+  return kFALSE;
+}
+//-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::FillVertex(AliAODVertex *vtx,const Double_t *pos,
+					const Double_t *cov,Double_t chi2perNDF) const
+{
+  /// Overwrite a reused vertex with a new position, covariance and chi2,
+  /// dropping the daughters and the parent of its previous use
+
+  vtx->RemoveDaughters();
+  vtx->SetParent(0x0);
+  vtx->SetPosition(pos[0],pos[1],pos[2]);
+  vtx->SetCovMatrix(cov);
+  vtx->SetChi2perNDF(chi2perNDF);
 
   return;
 }
 //-----------------------------------------------------------------------------
 AliAODVertex* AliAnalysisVertexingHF::ReconstructSecondaryVertex(TObjArray *trkArray,
-								 Double_t &dispersion,Bool_t useTRefArray) const
+								 Double_t &dispersion,Bool_t useTRefArray,
+								 AliAODVertex *vtxToFill) const
 {
-  /// Secondary vertex reconstruction with AliVertexerTracks or AliKFParticle
+  /// Secondary vertex reconstruction with AliVertexerTracks or AliKFParticle.
+  /// If vtxToFill is given, it is overwritten and returned instead of a new
+  /// vertex (it must have been created with the matching number of prongs)
   //AliCodeTimerAuto("",0);
 
-  AliESDVertex *vertexESD = 0;
   AliAODVertex *vertexAOD = 0;
+  Double_t pos[3],cov[6],chi2perNDF;
 
   if(!fSecVtxWithKF) { // AliVertexerTracks
 
     fVertexerTracks->SetVtxStart(fV1);
-    vertexESD = (AliESDVertex*)fVertexerTracks->VertexForSelectedESDTracks(trkArray);
+    AliESDVertex *vertexESD = (AliESDVertex*)fVertexerTracks->VertexForSelectedESDTracks(trkArray);
 
     if(!vertexESD) return vertexAOD;
+    fnAllocInEvent++;
 
     if(vertexESD->GetNContributors()!=trkArray->GetEntriesFast()) {
       //AliDebug(2,"vertexing failed");
@@ -2970,6 +3529,12 @@ AliAODVertex* AliAnalysisVertexingHF::ReconstructSecondaryVertex(TObjArray *trkA
       return vertexAOD;
     }
 
+    vertexESD->GetXYZ(pos); // position
+    vertexESD->GetCovMatrix(cov); //covariance matrix
+    chi2perNDF = vertexESD->GetChi2toNDF();
+    dispersion = vertexESD->GetDispersion();
+    delete vertexESD; vertexESD=NULL;
+
   } else { // Kalman Filter vertexer (AliKFParticle)
 
     AliKFParticle::SetField(fBzkG);
@@ -2982,23 +3547,27 @@ AliAODVertex* AliAnalysisVertexingHF::ReconstructSecondaryVertex(TObjArray *trkA
       AliKFParticle daughterKF(*esdTrack,211);
       vertexKF.AddDaughter(daughterKF);
     }
-    vertexESD = new AliESDVertex(vertexKF.Parameters(),
-				 vertexKF.CovarianceMatrix(),
-				 vertexKF.GetChi2(),
-				 vertexKF.GetNContributors());
+    AliESDVertex vertexESD(vertexKF.Parameters(),
+			   vertexKF.CovarianceMatrix(),
+			   vertexKF.GetChi2(),
+			   vertexKF.GetNContributors());
+
+    vertexESD.GetXYZ(pos); // position
+    vertexESD.GetCovMatrix(cov); //covariance matrix
+    chi2perNDF = vertexESD.GetChi2toNDF();
+    dispersion = vertexESD.GetDispersion();
 
   }
 
   // convert to AliAODVertex
-  Double_t pos[3],cov[6],chi2perNDF;
-  vertexESD->GetXYZ(pos); // position
-  vertexESD->GetCovMatrix(cov); //covariance matrix
-  chi2perNDF = vertexESD->GetChi2toNDF();
-  dispersion = vertexESD->GetDispersion();
-  delete vertexESD; vertexESD=NULL;
+  if(vtxToFill) {
+    FillVertex(vtxToFill,pos,cov,chi2perNDF);
+    return vtxToFill;
+  }
 
   Int_t nprongs= (useTRefArray ? 0 : trkArray->GetEntriesFast());
   vertexAOD = new AliAODVertex(pos,cov,chi2perNDF,0x0,-1,AliAODVertex::kUndef,nprongs);
+  fnAllocInEvent++;
 
   return vertexAOD;
 }
@@ -3638,29 +4207,24 @@ AliAODv0* AliAnalysisVertexingHF::TransformESDv0toAODv0(AliESDv0 *esdV0, TObjArr
   //AliCodeTimerAuto("",0);
   Double_t vertex[3]; esdV0->GetXYZ(vertex[0],vertex[1],vertex[2]);
   AliAODVertex *vertexV0 = new AliAODVertex(vertex,esdV0->GetChi2V0(),AliAODVertex::kV0,2);
+  fnAllocInEvent++;
 
   // create the v0 neutral track to compute the DCA to the primary vertex
   Double_t xyz[3], pxpypz[3];
   esdV0->XvYvZv(xyz);
   esdV0->PxPyPz(pxpypz);
   Double_t cv[21]; for(int i=0; i<21; i++) cv[i]=0;
-  AliNeutralTrackParam *trackesdV0 = new AliNeutralTrackParam(xyz,pxpypz,cv,0);
-  if(!trackesdV0) {
-    delete vertexV0;
-    return 0;
-  }
+  AliNeutralTrackParam trackesdV0(xyz,pxpypz,cv,0);
   Double_t d0z0[2],covd0z0[3];
   AliAODVertex *primVertexAOD = PrimaryVertex();
-  trackesdV0->PropagateToDCA(primVertexAOD,fBzkG,kVeryBig,d0z0,covd0z0);
+  trackesdV0.PropagateToDCA(primVertexAOD,fBzkG,kVeryBig,d0z0,covd0z0);
   Double_t dcaV0ToPrimVertex = TMath::Sqrt(covd0z0[0]);
   // get the v0 daughters to compute their DCA to the v0 vertex and get their momentum
   Double_t dcaV0DaughterToPrimVertex[2];
   AliExternalTrackParam *posV0track = (AliExternalTrackParam*)twoTrackArrayV0->UncheckedAt(0);
   AliExternalTrackParam *negV0track = (AliExternalTrackParam*)twoTrackArrayV0->UncheckedAt(1);
   if( !posV0track || !negV0track) {
-    if(trackesdV0) {delete trackesdV0; trackesdV0=NULL;}
     delete vertexV0;
-    delete primVertexAOD;
     return 0;
   }
   posV0track->PropagateToDCA(primVertexAOD,fBzkG,kVeryBig,d0z0,covd0z0);
@@ -3678,9 +4242,7 @@ AliAODv0* AliAnalysisVertexingHF::TransformESDv0toAODv0(AliESDv0 *esdV0, TObjArr
 
   AliAODv0 *aodV0 = new AliAODv0(vertexV0,dcaV0Daughters,dcaV0ToPrimVertex,pmom,nmom,dcaV0DaughterToPrimVertex);
   aodV0->SetOnFlyStatus(esdV0->GetOnFlyStatus());
-
-  delete trackesdV0;
-  delete primVertexAOD;
+  fnAllocInEvent++;
 
   return aodV0;
 }
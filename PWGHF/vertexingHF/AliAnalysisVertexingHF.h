@@ -21,6 +21,9 @@
 
 class AliPIDResponse;
 class AliESDVertex;
+class AliExternalTrackParam;
+class AliNeutralTrackParam;
+class TObjArray;
 class AliAODRecoDecay;
 class AliAODRecoDecayHF;
 class AliAODRecoDecayHF2Prong;
@@ -107,6 +110,13 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t GetRecoPrimVtxSkippingTrks() const {return fRecoPrimVtxSkippingTrks;}
   Bool_t GetRmTrksFromPrimVtx() const {return fRmTrksFromPrimVtx;}
   Bool_t GetMakeReducedRHF() const {return fMakeReducedRHF;}
+  Int_t GetNAllocationsInEvent() const { return fnAllocInEvent; }
+  Long64_t GetNAllocationsTotal() const { return fnAllocTotal; }
+  Long64_t GetNEarlyMassCutTested() const { return fnEarlyMassCutTested; }
+  Long64_t GetNEarlyMassCutKept() const { return fnEarlyMassCutKept; }
+  Bool_t GetPreselectCombinations() const { return fPreselectCombinations; }
+  Long64_t GetNPreselectionTested() const { return fnPreselTested; }
+  Long64_t GetNPreselectionKept() const { return fnPreselKept; }
   void SetFindVertexForDstar(Bool_t vtx=kTRUE) { fFindVertexForDstar=vtx; }
   void SetFindVertexForCascades(Bool_t vtx=kTRUE) { fFindVertexForCascades=vtx; }
 
@@ -178,7 +188,15 @@ class AliAnalysisVertexingHF : public TNamed {
   AliRDHFCutsD0toKpipipi* GetCutsD0toKpipipi() const { return fCutsD0toKpipipi; }
   void SetCutsDStartoKpipi(AliRDHFCutsDStartoKpipi* cuts) { fCutsDStartoKpipi = cuts; }
   AliRDHFCutsDStartoKpipi* GetCutsDStartoKpipi() const { return fCutsDStartoKpipi; }
+  /// apply the 3/4 prong invariant mass and pt windows with the momenta at the
+  /// primary vertex, before the track-to-track DCAs and the vertex fits
   void SetMassCutBeforeVertexing(Bool_t flag) { fMassCutBeforeVertexing=flag; }
+  /// skip, before the track-to-track DCAs and the vertex fits, the pairs,
+  /// triplets and quadruplets that cannot give a candidate: the mass and pt
+  /// windows are checked with bounds that hold at any secondary vertex and
+  /// the DCA of a pair that already failed its cut is not recomputed.
+  /// The candidates are the same as without it (on by default)
+  void SetPreselectCombinations(Bool_t flag=kTRUE) { fPreselectCombinations=flag; }
 
   void SetMasses();
   Bool_t CheckCutsConsistency();
@@ -247,6 +265,7 @@ class AliAnalysisVertexingHF : public TNamed {
  private:
   //
   enum { kBitDispl = 0, kBitSoftPi = 1, kBit3Prong = 2, kBitPionCompat = 3, kBitKaonCompat = 4, kBitProtonCompat = 5, kBitBachelor = 6};
+  enum { kBitPairDCAFailed = 0, kBitPairDCA4ProngFailed = 1};
 
   Bool_t fInputAOD; /// input from AOD (kTRUE) or ESD (kFALSE)
   Int_t fAODMapSize; /// size of fAODMap
@@ -324,6 +343,7 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t fFindVertexForCascades;  /// reconstruct a secondary vertex or assume it's from the primary vertex
   Int_t  fV0TypeForCascadeVertex;  /// Select which V0 type we want to use for the cascas
   Bool_t fMassCutBeforeVertexing; /// to go faster in PbPb
+  Bool_t fPreselectCombinations; /// skip track combinations that cannot pass the mass, pt and DCA cuts
   // dummies for invariant mass calculation
   AliAODRecoDecay *fMassCalc2; /// for 2 prong
   AliAODRecoDecay *fMassCalc3; /// for 3 prong
@@ -339,6 +359,51 @@ class AliAnalysisVertexingHF : public TNamed {
 
   Int_t  fnTrksTotal;
   Int_t  fnSeleTrksTotal;
+  // scratch objects of FindCandidates, created once and reused in all events
+  TObjArray *fTwoTrackArray1;    //! pos-neg pair
+  TObjArray *fTwoTrackArray2;    //! second pair of a 3/4 prong
+  TObjArray *fTwoTrackArrayV0;   //! V0 daughters
+  TObjArray *fTwoTrackArrayCasc; //! cascade (bachelor + V0 or soft pion + D0)
+  TObjArray *fThreeTrackArray;   //! 3 prong
+  TObjArray *fFourTrackArray;    //! 4 prong
+  AliExternalTrackParam *fV0PosTrack; //! positive V0 daughter
+  AliExternalTrackParam *fV0NegTrack; //! negative V0 daughter
+  AliNeutralTrackParam *fV0Track;     //! V0 as a neutral track
+  AliNeutralTrackParam *fD0Track;     //! D0 as a neutral track for D* building
+  Int_t    fSeleBufSize;   //! capacity of fSeleFlags and fEvtNumber
+  UChar_t *fSeleFlags;     //! [fSeleBufSize] single track selection bits
+  Int_t   *fEvtNumber;     //! [fSeleBufSize] event number of the selected tracks
+  Double_t *fSeleMom;      //! [3*fSeleBufSize] momenta of the selected tracks at the primary vertex
+  Double_t *fSeleKine;     //! [3*fSeleBufSize] pt, pz and p^2 of the selected tracks, for the pre-selection
+  Int_t    fPairBufSize;   //! capacity of fPairDCABits
+  Int_t    fPairNTrks;     //! selected tracks indexing fPairDCABits (0 if the table is not used)
+  UChar_t *fPairDCABits;   //! [fPairBufSize] DCA cuts failed by each ordered pair of selected tracks
+  Double_t fPreselMass[4]; //! pion, kaon, proton and electron masses for the pre-selection
+  // secondary vertex slots refilled by ReconstructSecondaryVertex; only
+  // candidates passing the cuts get a copy in the output vertex array
+  AliAODVertex *fVtx2Prong;     //! pos-neg pair (p1n1)
+  AliAODVertex *fVtx2ProngB;    //! second pair of a 3/4 prong (p2n1 or p1n2)
+  AliAODVertex *fVtx3Prong;     //! 3 prong
+  AliAODVertex *fVtx3ProngFor4; //! p1n1p2 triplet of a 4 prong
+  AliAODVertex *fVtx4Prong;     //! 4 prong
+  AliAODVertex *fVtxCasc;       //! cascade (V0 or D*)
+  // candidates used for the selection, copied to the output only if selected
+  AliAODRecoDecayHF2Prong *fScratch2Prong;  //! D0, J/psi and like-sign pairs
+  AliAODRecoCascadeHF     *fScratchCascade; //! D* and V0+bachelor cascades
+  AliAODRecoDecayHF3Prong *fScratch3Prong;  //! D+, Ds, Lc
+  AliAODRecoDecayHF4Prong *fScratch4Prong;  //! D0->Kpipipi
+  // state of PrimaryVertex, returned vertex is owned and overwritten on the next call
+  mutable AliAODVertex *fPrimVtxScratch;    //! vertex returned by PrimaryVertex
+  mutable AliVertexerTracks *fPrimVertexer; //! vertexer for candidate specific primary vertices
+  mutable Int_t    fPrimVertexerMode;       //! configuration fPrimVertexer was set up for
+  mutable Double_t fPrimVertexerBz;         //! magnetic field fPrimVertexer was created with
+  mutable TObjArray *fRmTrksCopies;         //! owned copies of the prongs for RemoveTracksFromVertex
+  mutable Int_t    fnAllocInEvent; //! heap allocations of temporaries since the start of the last FindCandidates
+  Long64_t fnAllocTotal;   //! heap allocations of temporaries summed over all events
+  Long64_t fnEarlyMassCutTested; //! 3 and 4 prong combinations tested by the mass cut before vertexing
+  Long64_t fnEarlyMassCutKept;   //! 3 and 4 prong combinations kept by the mass cut before vertexing
+  Long64_t fnPreselTested; //! 2, 3 and 4 prong combinations tested by the pre-selection
+  Long64_t fnPreselKept;   //! 2, 3 and 4 prong combinations kept by the pre-selection
   Bool_t fMakeReducedRHF;// switch the reduction of dAOD size on/off
 
   Double_t fMassDzero;
@@ -392,7 +457,21 @@ class AliAnalysisVertexingHF : public TNamed {
 
   void MapAODtracks(AliVEvent *aod);
   AliAODVertex* PrimaryVertex(const TObjArray *trkArray=0x0,AliVEvent *event=0x0) const;
-  AliAODVertex* ReconstructSecondaryVertex(TObjArray *trkArray,Double_t &dispersion,Bool_t useTRefArray=kTRUE) const;
+  AliAODVertex* ReconstructSecondaryVertex(TObjArray *trkArray,Double_t &dispersion,Bool_t useTRefArray=kTRUE,
+					   AliAODVertex *vtxToFill=0x0) const;
+  void FillVertex(AliAODVertex *vtx,const Double_t *pos,const Double_t *cov,Double_t chi2perNDF) const;
+  void PrepareScratchObjects(Int_t trkEntries);
+  void PreparePreselection(Int_t nSeleTrks);
+  Bool_t InvMassWindowReachable(Int_t nprongs,const Int_t *iTrk,const Double_t *mass,
+				Double_t minPt,Double_t lolim,Double_t hilim) const;
+  Double_t MinInvMass(Int_t nprongs,const Int_t *iTrk) const;
+  Bool_t Reachable2Prong(Int_t iTrk0,Int_t iTrk1) const;
+  Bool_t Reachable3Prong(Int_t iTrk0,Int_t iTrk1,Int_t iTrk2) const;
+  Bool_t Reachable4Prong(const Int_t *iTrk) const;
+  Bool_t ReachableAsPartOf(Int_t nprongs,const Int_t *iTrk,Bool_t for3Prong,Bool_t for4Prong) const;
+  Bool_t PairDCAFailed(Int_t iTrk1,Int_t iTrk2,Int_t bit) const
+    { return fPairNTrks>0 && TESTBIT(fPairDCABits[iTrk1*fPairNTrks+iTrk2],bit); }
+  void StorePairDCA(Int_t iTrk1,Int_t iTrk2,Double_t dca,Double_t dcaMax);
 
   Bool_t SelectInvMassAndPt3prong(Double_t *px,Double_t *py,Double_t *pz, Int_t pidLcStatus=3);
   Bool_t SelectInvMassAndPt4prong(Double_t *px,Double_t *py,Double_t *pz);
@@ -420,7 +499,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,27);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,31);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
@@ -43,10 +43,24 @@
 #include <TStyle.h>
 #include <TPaveText.h>
 #include <TDatabasePDG.h>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+#include <HFitInterface.h>
+#include <Foption.h>
+#include <Fit/DataRange.h>
+#include <Math/MinimizerOptions.h>
+#endif
 #include "AliHFMassFitter.h"
 #include "AliHFMassFitterVAR.h"
 #include "AliVertexingHFUtils.h"
 
+// The functions made by the fitter are kept out of the global list of
+// functions, such that several fitters can be used concurrently
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+#define ALIHFMF_NOTGLOBAL ,TF1::EAddToList::kNo
+#else
+#define ALIHFMF_NOTGLOBAL
+#endif
 
 using std::cout;
 using std::endl;
@@ -79,7 +93,9 @@ AliHFMassFitter(),
   fRawYieldHelp(0),
   fpolbackdegreeTay(4),
   fpolbackdegreeTayHelp(-1),
-  fMassParticle(1.864)
+  fMassParticle(1.864),
+  fSetDefaultFitterMinuit(kTRUE),
+  fMinimizer("")
 {
   // default constructor
  
@@ -112,7 +128,9 @@ AliHFMassFitterVAR::AliHFMassFitterVAR (const TH1F *histoToFit, Double_t minvalu
   fRawYieldHelp(0),
   fpolbackdegreeTay(4),
   fpolbackdegreeTayHelp(-1),
-  fMassParticle(1.864)
+  fMassParticle(1.864),
+  fSetDefaultFitterMinuit(kTRUE),
+  fMinimizer("")
 {
   // standard constructor
 
@@ -165,7 +183,9 @@ AliHFMassFitterVAR::AliHFMassFitterVAR(const AliHFMassFitterVAR &mfit):
   fRawYieldHelp(mfit.fRawYieldHelp),
   fpolbackdegreeTay(mfit.fpolbackdegreeTay),
   fpolbackdegreeTayHelp(mfit.fpolbackdegreeTayHelp),
-  fMassParticle(mfit.fMassParticle)
+  fMassParticle(mfit.fMassParticle),
+  fSetDefaultFitterMinuit(mfit.fSetDefaultFitterMinuit),
+  fMinimizer(mfit.fMinimizer)
 {
   //copy constructor
   fSignParNames=new TString[fNparSignal];
@@ -257,6 +277,8 @@ AliHFMassFitterVAR& AliHFMassFitterVAR::operator=(const AliHFMassFitterVAR &mfit
   fpolbackdegreeTayHelp=mfit.fpolbackdegreeTayHelp;
 
   fMassParticle=mfit.fMassParticle;
+  fSetDefaultFitterMinuit=mfit.fSetDefaultFitterMinuit;
+  fMinimizer=mfit.fMinimizer;
 
   delete [] fSignParNames;
   delete [] fBackParNames;
@@ -341,6 +363,7 @@ void AliHFMassFitterVAR::SetBackHighPolDegree(Int_t deg){
 
 TH1F*  AliHFMassFitterVAR::SetTemplateReflections(const TH1 *h, TString opt,Double_t minRange,Double_t maxRange){
   fhTemplRefl=(TH1F*)h->Clone("hTemplRefl");  
+  fhTemplRefl->SetDirectory(0);
   
   if(opt.EqualTo("templ")||opt.EqualTo("Templ")||opt.EqualTo("TEMPL")||opt.EqualTo("template")||opt.EqualTo("Template")||opt.EqualTo("TEMPLATE")){
     return fhTemplRefl;
@@ -349,15 +372,15 @@ TH1F*  AliHFMassFitterVAR::SetTemplateReflections(const TH1 *h, TString opt,Doub
   Bool_t isPoissErr=kTRUE;
   if(opt.EqualTo("1gaus")||opt.EqualTo("singlegaus")){
     if(minRange>=0&&maxRange>=0){
-      f=new TF1("mygaus","gaus",TMath::Max(minRange,h->GetBinLowEdge(1)),TMath::Min(maxRange,h->GetXaxis()->GetBinUpEdge(h->GetNbinsX())));
+      f=new TF1("mygaus","gaus",TMath::Max(minRange,h->GetBinLowEdge(1)),TMath::Min(maxRange,h->GetXaxis()->GetBinUpEdge(h->GetNbinsX())) ALIHFMF_NOTGLOBAL);
     }
-    else f=new TF1("mygaus","gaus",h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()));
+    else f=new TF1("mygaus","gaus",h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()) ALIHFMF_NOTGLOBAL);
     f->SetParameter(0,h->GetMaximum());
     //    f->SetParLimits(0,0,100.*h->Integral());
     f->SetParameter(1,1.865);
     f->SetParameter(2,0.050);
 
-    fhTemplRefl->Fit(f,"REM","");//,h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()));
+    FitHisto(fhTemplRefl,f,"REM");//,h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()));
     for(Int_t j=1;j<=fhTemplRefl->GetNbinsX();j++){
       fhTemplRefl->SetBinContent(j,f->Integral(fhTemplRefl->GetBinLowEdge(j),fhTemplRefl->GetXaxis()->GetBinUpEdge(j))/fhTemplRefl->GetBinWidth(j));
       if(fhTemplRefl->GetBinContent(j)>=0.&&TMath::Abs(h->GetBinError(j)*h->GetBinError(j)-h->GetBinContent(j))>0.1*h->GetBinContent(j))isPoissErr=kFALSE;
@@ -374,9 +397,9 @@ TH1F*  AliHFMassFitterVAR::SetTemplateReflections(const TH1 *h, TString opt,Doub
 
  if(opt.EqualTo("2gaus")||opt.EqualTo("doublegaus")){
    if(minRange>=0&&maxRange>=0){
-     f=new TF1("my2gaus","[0]*([3]/( TMath::Sqrt(2.*TMath::Pi())*[2])*TMath::Exp(-(x-[1])*(x-[1])/(2.*[2]*[2]))+(1.-[3])/( TMath::Sqrt(2.*TMath::Pi())*[5])*TMath::Exp(-(x-[4])*(x-[4])/(2.*[5]*[5])))",TMath::Max(minRange,h->GetBinLowEdge(1)),TMath::Min(maxRange,h->GetXaxis()->GetBinUpEdge(h->GetNbinsX())));
+     f=new TF1("my2gaus","[0]*([3]/( TMath::Sqrt(2.*TMath::Pi())*[2])*TMath::Exp(-(x-[1])*(x-[1])/(2.*[2]*[2]))+(1.-[3])/( TMath::Sqrt(2.*TMath::Pi())*[5])*TMath::Exp(-(x-[4])*(x-[4])/(2.*[5]*[5])))",TMath::Max(minRange,h->GetBinLowEdge(1)),TMath::Min(maxRange,h->GetXaxis()->GetBinUpEdge(h->GetNbinsX())) ALIHFMF_NOTGLOBAL);
    }
-   else f=new TF1("my2gaus","[0]*([3]/( TMath::Sqrt(2.*TMath::Pi())*[2])*TMath::Exp(-(x-[1])*(x-[1])/(2.*[2]*[2]))+(1.-[3])/( TMath::Sqrt(2.*TMath::Pi())*[5])*TMath::Exp(-(x-[4])*(x-[4])/(2.*[5]*[5])))",h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()));
+   else f=new TF1("my2gaus","[0]*([3]/( TMath::Sqrt(2.*TMath::Pi())*[2])*TMath::Exp(-(x-[1])*(x-[1])/(2.*[2]*[2]))+(1.-[3])/( TMath::Sqrt(2.*TMath::Pi())*[5])*TMath::Exp(-(x-[4])*(x-[4])/(2.*[5]*[5])))",h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()) ALIHFMF_NOTGLOBAL);
 
     f->SetParameter(0,h->GetMaximum());
     //    f->SetParLimits(0,0,100.*h->Integral());
@@ -389,7 +412,7 @@ TH1F*  AliHFMassFitterVAR::SetTemplateReflections(const TH1 *h, TString opt,Doub
     f->SetParameter(4,1.88);
     f->SetParameter(5,0.050);
 
-    fhTemplRefl->Fit(f,"REM","");//,h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()));
+    FitHisto(fhTemplRefl,f,"REM");//,h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()));
     for(Int_t j=1;j<=fhTemplRefl->GetNbinsX();j++){
       fhTemplRefl->SetBinContent(j,f->Integral(fhTemplRefl->GetBinLowEdge(j),fhTemplRefl->GetXaxis()->GetBinUpEdge(j))/fhTemplRefl->GetBinWidth(j));
       if(fhTemplRefl->GetBinContent(j)>=0.&&TMath::Abs(h->GetBinError(j)*h->GetBinError(j)-h->GetBinContent(j))>0.1*h->GetBinContent(j))isPoissErr=kFALSE;
@@ -406,15 +429,15 @@ TH1F*  AliHFMassFitterVAR::SetTemplateReflections(const TH1 *h, TString opt,Doub
 
   if(opt.EqualTo("pol3")||opt.EqualTo("POL3")){
     if(minRange>=0&&maxRange>=0){
-      f=new TF1("mypol3","pol3",TMath::Max(minRange,h->GetBinLowEdge(1)),TMath::Min(maxRange,h->GetXaxis()->GetBinUpEdge(h->GetNbinsX())));
+      f=new TF1("mypol3","pol3",TMath::Max(minRange,h->GetBinLowEdge(1)),TMath::Min(maxRange,h->GetXaxis()->GetBinUpEdge(h->GetNbinsX())) ALIHFMF_NOTGLOBAL);
     }
-    else f=new TF1("mypol3","pol3",h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()));
+    else f=new TF1("mypol3","pol3",h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()) ALIHFMF_NOTGLOBAL);
     f->SetParameter(0,h->GetMaximum());
     
     //    f->SetParLimits(0,0,100.*h->Integral());
     // Hard to initialize the other parameters...
     for(Int_t nf=0;nf<10;nf++){
-      fhTemplRefl->Fit(f,"REM","");
+      FitHisto(fhTemplRefl,f,"REM");
       //,h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()));
     }
     //    Printf("We USED %d POINTS in the Fit",f->GetNumberFitPoints());
@@ -435,14 +458,14 @@ TH1F*  AliHFMassFitterVAR::SetTemplateReflections(const TH1 *h, TString opt,Doub
   if(opt.EqualTo("pol6")||opt.EqualTo("POL6")){
 
     if(minRange>=0&&maxRange>=0){
-      f=new TF1("mypol6","pol6",TMath::Max(minRange,h->GetBinLowEdge(1)),TMath::Min(maxRange,h->GetXaxis()->GetBinUpEdge(h->GetNbinsX())));
+      f=new TF1("mypol6","pol6",TMath::Max(minRange,h->GetBinLowEdge(1)),TMath::Min(maxRange,h->GetXaxis()->GetBinUpEdge(h->GetNbinsX())) ALIHFMF_NOTGLOBAL);
     }
-    else f=new TF1("mypol6","pol6",h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()));
+    else f=new TF1("mypol6","pol6",h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()) ALIHFMF_NOTGLOBAL);
     f->SetParameter(0,h->GetMaximum());
     //    f->SetParLimits(0,0,100.*h->Integral());
     // Hard to initialize the other parameters...
 
-    fhTemplRefl->Fit(f,"RLEMI","");//,h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()));
+    FitHisto(fhTemplRefl,f,"RLEMI");//,h->GetBinLowEdge(1),h->GetXaxis()->GetBinUpEdge(h->GetNbinsX()));
     
    
     for(Int_t j=1;j<=fhTemplRefl->GetNbinsX();j++){
@@ -798,7 +821,8 @@ Bool_t AliHFMassFitterVAR::MassFitter(Bool_t draw){
   // Main method of the class: performs the fit of the histogram
   
   //Set default fitter Minuit in order to use gMinuit in the contour plots    
-  TVirtualFitter::SetDefaultFitter("Minuit");
+  //(not when fitting in parallel threads, the global fitter must not be changed)
+  if(fSetDefaultFitterMinuit) TVirtualFitter::SetDefaultFitter("Minuit");
 
   Bool_t isBkgOnly=kFALSE;
   Double_t slope1=-1,slope2=1,slope3=1;
@@ -861,7 +885,7 @@ Bool_t AliHFMassFitterVAR::MassFitter(Bool_t draw){
   }
   
   /*Fit Bkg*/
-  TF1 *funcbkg = new TF1(bkgname.Data(),this,&AliHFMassFitterVAR::FitFunction4Bkg,fminMass,fmaxMass,fNparBack,"AliHFMassFitterVAR","FitFunction4Bkg");
+  TF1 *funcbkg = new TF1(bkgname.Data(),this,&AliHFMassFitterVAR::FitFunction4Bkg,fminMass,fmaxMass,fNparBack,"AliHFMassFitterVAR","FitFunction4Bkg" ALIHFMF_NOTGLOBAL);
   //   TF1 *funcbkg = GetBackgroundFunc();
   cout<<"Function name = "<<funcbkg->GetName()<<endl<<endl;
   
@@ -904,7 +928,7 @@ Bool_t AliHFMassFitterVAR::MassFitter(Bool_t draw){
    //if only signal and reflection: skip
   if (!(ftypeOfFit4Bkg==3 && ftypeOfFit4Sgn==1)) {
     //    ftypeOfFit4Sgn=0;
-    fhistoInvMass->Fit(funcbkg,"R,E,0");
+    FitHisto(fhistoInvMass,funcbkg,"R,E,0");
    
     fSideBands = kFALSE;
     //intbkg1 = funcbkg->GetParameter(0);
@@ -949,7 +973,7 @@ Bool_t AliHFMassFitterVAR::MassFitter(Bool_t draw){
   
   //  Double_t sgnInt=diffUnderBands;
   if(sgnInt<0)sgnInt=0.1*totInt;
-  TF1 *funcmass = new TF1(massname.Data(),this,&AliHFMassFitterVAR::FitFunction4MassDistr,fminMass,fmaxMass,fNFinalPars,"AliHFMassFitterVAR","FitFunction4MassDistr");
+  TF1 *funcmass = new TF1(massname.Data(),this,&AliHFMassFitterVAR::FitFunction4MassDistr,fminMass,fmaxMass,fNFinalPars,"AliHFMassFitterVAR","FitFunction4MassDistr" ALIHFMF_NOTGLOBAL);
   cout<<"Function name = "<<funcmass->GetName()<<endl<<endl;
   funcmass->SetLineColor(4); //blue
 
@@ -999,7 +1023,7 @@ Bool_t AliHFMassFitterVAR::MassFitter(Bool_t draw){
 
   Int_t status;
   Printf("Fitting");
-  status = fhistoInvMass->Fit(massname.Data(),Form("R,%s,+,0",fFitOption.Data()));
+  status = FitHisto(fhistoInvMass,funcmass,Form("R,%s,+,0",fFitOption.Data()));
   if (status != 0){
     cout<<"Minuit returned "<<status<<endl;
     delete funcbkg;
@@ -1059,6 +1083,7 @@ Bool_t AliHFMassFitterVAR::MassFitter(Bool_t draw){
 Bool_t AliHFMassFitterVAR::PrepareHighPolFit(TF1 *fback){
   // Perform intermediate fit steps up to fpolbackdegreeTay-1
   TH1F *hCp=(TH1F*)fhistoInvMass->Clone("htemp");
+  hCp->SetDirectory(0);
   Double_t estimatecent=0.5*(hCp->GetBinContent(hCp->FindBin(fMass-3.5*fSigmaSgn))+hCp->GetBinContent(hCp->FindBin(fMass+3.5*fSigmaSgn)));// just a first rough estimate
   Double_t estimateslope=(hCp->GetBinContent(hCp->FindBin(fMass+3.5*fSigmaSgn))-hCp->GetBinContent(hCp->FindBin(fMass-3.5*fSigmaSgn)))/(7*fSigmaSgn);// first rough estimate
   
@@ -1075,7 +1100,7 @@ Bool_t AliHFMassFitterVAR::PrepareHighPolFit(TF1 *fback){
   fpolbackdegreeTayHelp=2;
   TF1 *funcbkg,*funcPrev=0x0;  
   while(fpolbackdegreeTayHelp<=fpolbackdegreeTay){        
-    funcbkg = new TF1(Form("temp%d",fpolbackdegreeTayHelp),this,&AliHFMassFitterVAR::BackFitFuncPolHelper,fminMass,fmaxMass,fpolbackdegreeTayHelp+1,"AliHFMassFitterVAR","BackFitFuncPolHelper");
+    funcbkg = new TF1(Form("temp%d",fpolbackdegreeTayHelp),this,&AliHFMassFitterVAR::BackFitFuncPolHelper,fminMass,fmaxMass,fpolbackdegreeTayHelp+1,"AliHFMassFitterVAR","BackFitFuncPolHelper" ALIHFMF_NOTGLOBAL);
     if(funcPrev){
       for(Int_t j=0;j<fpolbackdegreeTayHelp;j++){// now is +1 degree w.r.t. previous fit funct
 	funcbkg->SetParameter(j,funcPrev->GetParameter(j));
@@ -1087,7 +1112,7 @@ Bool_t AliHFMassFitterVAR::PrepareHighPolFit(TF1 *fback){
       funcbkg->SetParameter(1,estimateslope);
       
     }
-    hCp->Fit(funcbkg,"REMN","");
+    FitHisto(hCp,funcbkg,"REMN");
     funcPrev=(TF1*)funcbkg->Clone("ftemp");
     delete funcbkg;
     fpolbackdegreeTayHelp++;
@@ -1100,7 +1125,7 @@ Bool_t AliHFMassFitterVAR::PrepareHighPolFit(TF1 *fback){
     fback->SetParameter(j,funcPrev->GetParameter(j));
     fback->SetParError(j,funcPrev->GetParError(j));
   }
-  hCp->Fit(fback,"REMN","");// THIS IS JUST TO SET NOT ONLY THE PARAMETERS BUT ALSO chi2, etc...
+  FitHisto(hCp,fback,"REMN");// THIS IS JUST TO SET NOT ONLY THE PARAMETERS BUT ALSO chi2, etc...
 
 
   // The following lines might be useful for debugging
@@ -1127,7 +1152,7 @@ Bool_t AliHFMassFitterVAR::RefitWithBkgOnly(Bool_t draw){
   fSideBands = kFALSE;
   Int_t typesSave=ftypeOfFit4Sgn;
   if(ftypeOfFit4Sgn==2)ftypeOfFit4Sgn=0;
-  TF1* funcbkg = new TF1(bkgname.Data(),this,&AliHFMassFitterVAR::FitFunction4Bkg,fminMass,fmaxMass,fNparBack,"AliHFMassFitterVAR","FitFunction4Bkg");
+  TF1* funcbkg = new TF1(bkgname.Data(),this,&AliHFMassFitterVAR::FitFunction4Bkg,fminMass,fmaxMass,fNparBack,"AliHFMassFitterVAR","FitFunction4Bkg" ALIHFMF_NOTGLOBAL);
 
   funcbkg->SetLineColor(kBlue+3); //dark blue
 
@@ -1183,7 +1208,7 @@ Bool_t AliHFMassFitterVAR::RefitWithBkgOnly(Bool_t draw){
       fhistoInvMass->GetFunction(funcbkg->GetName())->SetBit(1<<9,kTRUE);
     }
   }
-  else status=fhistoInvMass->Fit(bkgname.Data(),"R,E,+,0");
+  else status=FitHisto(fhistoInvMass,funcbkg,"R,E,+,0");
   if (status != 0){
     ftypeOfFit4Sgn=typesSave;
     cout<<"Minuit returned "<<status<<endl;
@@ -1213,6 +1238,25 @@ void AliHFMassFitterVAR::IntS(Float_t *valuewitherror) const {
 }
 
 
+//_________________________________________________________________________
+TFitResultPtr AliHFMassFitterVAR::FitHisto(TH1* h, TF1* f, Option_t* option, Double_t xmin, Double_t xmax) const{
+
+  // Same as h->Fit(f,option,"",xmin,xmax), but with the minimizer fMinimizer if set
+  // (passed to this fit only, the global default minimizer is not changed)
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+  if(!fMinimizer.IsNull()){
+    Foption_t fitOption;
+    ROOT::Fit::FitOptionsMake(ROOT::Fit::kHistogram,option,fitOption);
+    ROOT::Math::MinimizerOptions minOption;
+    minOption.SetMinimizerType(fMinimizer.Data());
+    ROOT::Fit::DataRange range(xmin,xmax);
+    return ROOT::Fit::FitObject(h,f,fitOption,minOption,"",range);
+  }
+#endif
+  return h->Fit(f,option,"",xmin,xmax);
+}
+
 //_________________________________________________________________________
 void AliHFMassFitterVAR::AddFunctionsToHisto(){
 
@@ -1268,7 +1312,7 @@ void AliHFMassFitterVAR::AddFunctionsToHisto(){
     }
   
     bkgname += "FullRange";
-    TF1 *bfullrange=new TF1(bkgname.Data(),this,&AliHFMassFitterVAR::FitFunction4Bkg,fminMass,fmaxMass,fNparBack,"AliHFMassFitterVAR","FitFunction4Bkg");
+    TF1 *bfullrange=new TF1(bkgname.Data(),this,&AliHFMassFitterVAR::FitFunction4Bkg,fminMass,fmaxMass,fNparBack,"AliHFMassFitterVAR","FitFunction4Bkg" ALIHFMF_NOTGLOBAL);
     //cout<<bfullrange->GetName()<<endl;
     for(Int_t i=0;i<fNparBack;i++){
       bfullrange->SetParName(i,b->GetParName(i));
@@ -1282,8 +1326,8 @@ void AliHFMassFitterVAR::AddFunctionsToHisto(){
     bkgnamesave += "Recalc";
     
     TF1 *blastpar;
-    if(ftypeOfFit4Sgn<2)blastpar=new TF1(bkgnamesave.Data(),this,&AliHFMassFitterVAR::FitFunction4Bkg,fminMass,fmaxMass,fNparBack,"AliHFMassFitterVAR","FitFunction4Bkg");
-    else blastpar=new TF1(bkgnamesave.Data(),this,&AliHFMassFitterVAR::FitFunction4BkgAndReflDraw,fminMass,fmaxMass,fNparBack+fNparRefl,"AliHFMassFitterVAR","FitFunction4BkgAndReflDraw");
+    if(ftypeOfFit4Sgn<2)blastpar=new TF1(bkgnamesave.Data(),this,&AliHFMassFitterVAR::FitFunction4Bkg,fminMass,fmaxMass,fNparBack,"AliHFMassFitterVAR","FitFunction4Bkg" ALIHFMF_NOTGLOBAL);
+    else blastpar=new TF1(bkgnamesave.Data(),this,&AliHFMassFitterVAR::FitFunction4BkgAndReflDraw,fminMass,fmaxMass,fNparBack+fNparRefl,"AliHFMassFitterVAR","FitFunction4BkgAndReflDraw" ALIHFMF_NOTGLOBAL);
   
     TF1 *mass=fhistoInvMass->GetFunction("funcmass");
 
@@ -1522,7 +1566,7 @@ void AliHFMassFitterVAR::PlotFitVAR(TVirtualPad* pd,Double_t nsigma,Int_t writeF
 
       TF1 *fitCp;
       if(ftypeOfFit4Sgn==2){// drawing background function w/o reflection contribution
-	fitCp= new TF1("fbackcpfordrawing",this,&AliHFMassFitterVAR::FitFunction4BkgAndReflDraw,fminMass,fmaxMass,fNparBack+fNparRefl,"AliHFMassFitterVAR","FitFunction4BkgAndReflDraw");
+	fitCp= new TF1("fbackcpfordrawing",this,&AliHFMassFitterVAR::FitFunction4BkgAndReflDraw,fminMass,fmaxMass,fNparBack+fNparRefl,"AliHFMassFitterVAR","FitFunction4BkgAndReflDraw" ALIHFMF_NOTGLOBAL);
 	fitCp->SetParameter(fNparBack,0);// set to 0 reflection normalization
 	
 	for(Int_t ibk=0;ibk<fNparBack;ibk++){
@@ -2001,8 +2045,8 @@ TH1F* AliHFMassFitterVAR::GetOverBackgroundResidualsAndPulls(Double_t minrange,D
 
   // THIS LONG WAY TO CP THE FUNC IS NEEDED ONLY TO EXTEND THE RANGE OF THE FUNCTION: NOT POSSIBLE OTHERWISE (WHY??? REALLY UNCOMFORTABLE)
   TF1 *fbackCp;
-  if(ftypeOfFit4Sgn<2)fbackCp=new TF1("ftmpback",this,&AliHFMassFitterVAR::FitFunction4Bkg,fhistoInvMass->GetBinLowEdge(1),fhistoInvMass->GetBinLowEdge(fhistoInvMass->GetNbinsX()+1), fNparBack,"AliHFMassFitterVAR","FitFunction4Bkg");
-  else fbackCp=new TF1("ftmpback",this,&AliHFMassFitterVAR::FitFunction4BkgAndReflDraw,fhistoInvMass->GetBinLowEdge(1),fhistoInvMass->GetBinLowEdge(fhistoInvMass->GetNbinsX()+1),fNparBack+fNparRefl,"AliHFMassFitterVAR","FitFunction4BkgAndReflDraw");
+  if(ftypeOfFit4Sgn<2)fbackCp=new TF1("ftmpback",this,&AliHFMassFitterVAR::FitFunction4Bkg,fhistoInvMass->GetBinLowEdge(1),fhistoInvMass->GetBinLowEdge(fhistoInvMass->GetNbinsX()+1), fNparBack,"AliHFMassFitterVAR","FitFunction4Bkg" ALIHFMF_NOTGLOBAL);
+  else fbackCp=new TF1("ftmpback",this,&AliHFMassFitterVAR::FitFunction4BkgAndReflDraw,fhistoInvMass->GetBinLowEdge(1),fhistoInvMass->GetBinLowEdge(fhistoInvMass->GetNbinsX()+1),fNparBack+fNparRefl,"AliHFMassFitterVAR","FitFunction4BkgAndReflDraw" ALIHFMF_NOTGLOBAL);
   
   for(Int_t i=0;i<fback->GetNpar();i++){
     fbackCp->SetParameter(i,fback->GetParameter(i));
@@ -2018,7 +2062,7 @@ TH1F* AliHFMassFitterVAR::GetOverBackgroundResidualsAndPulls(Double_t minrange,D
   }
 
   if(hResidualTrend){  
-    TF1 *fgauss=new TF1("signalTermForRes","[0]/TMath::Sqrt(2.*TMath::Pi())/[2]*TMath::Exp(-(x-[1])*(x-[1])/2./[2]/[2])",fhistoInvMass->GetBinLowEdge(1),fhistoInvMass->GetBinLowEdge(fhistoInvMass->GetNbinsX()+1));
+    TF1 *fgauss=new TF1("signalTermForRes","[0]/TMath::Sqrt(2.*TMath::Pi())/[2]*TMath::Exp(-(x-[1])*(x-[1])/2./[2]/[2])",fhistoInvMass->GetBinLowEdge(1),fhistoInvMass->GetBinLowEdge(fhistoInvMass->GetNbinsX()+1) ALIHFMF_NOTGLOBAL);
     fgauss->SetParameter(0,fRawYield*fhistoInvMass->GetBinWidth(1));
     fgauss->SetParameter(1,fMass);
     fgauss->SetParameter(2,fSigmaSgn);
@@ -2044,7 +2088,7 @@ TH1F* AliHFMassFitterVAR::GetAllRangeResidualsAndPulls(Double_t minrange,Double_
   }
 
   // THIS LONG WAY TO CP THE FUNC IS NEEDED ONLY TO EXTEND THE RANGE OF THE FUNCTION: NOT POSSIBLE OTHERWISE (WHY??? REALLY UNCOMFORTABLE)
-  TF1 *fmassCp=new TF1("fmassCp",this,&AliHFMassFitterVAR::FitFunction4MassDistr,fhistoInvMass->GetBinLowEdge(1),fhistoInvMass->GetBinLowEdge(fhistoInvMass->GetNbinsX()+1), fNFinalPars,"AliHFMassFitterVAR","FitFunction4MassDistr");
+  TF1 *fmassCp=new TF1("fmassCp",this,&AliHFMassFitterVAR::FitFunction4MassDistr,fhistoInvMass->GetBinLowEdge(1),fhistoInvMass->GetBinLowEdge(fhistoInvMass->GetNbinsX()+1), fNFinalPars,"AliHFMassFitterVAR","FitFunction4MassDistr" ALIHFMF_NOTGLOBAL);
   for(Int_t i=0;i< f->GetNpar();i++){
     fmassCp->SetParameter(i,f->GetParameter(i));
   }
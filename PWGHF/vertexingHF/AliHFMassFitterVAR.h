@@ -16,6 +16,7 @@
 
 #include <TNamed.h>
 #include <TString.h>
+#include <TFitResultPtr.h>
 #include "AliHFMassFitter.h"
 class TF1;
 class TNtuple;
@@ -107,6 +108,8 @@ class AliHFMassFitterVAR : public AliHFMassFitter {
   Double_t BackFitFuncPolHelper(Double_t *x,Double_t *par);
   Bool_t PrepareHighPolFit(TF1 *fback);
   void SetParticlePdgMass(Double_t mass){fMassParticle=mass;}
+  void SetDefaultFitterMinuit(Bool_t opt=kTRUE){fSetDefaultFitterMinuit=opt;} /// MassFitter sets TMinuit as global default fitter (switch off for fits in parallel threads)
+  void SetMinimizer(const char* minimizer){fMinimizer=minimizer;} /// minimizer for the fits of this object only (e.g. "Minuit2"), the global default is not changed (ROOT 6)
   Double_t GetParticlePdgMass(){return fMassParticle;}
   Double_t FitFunction4MassDistr (Double_t* x, Double_t* par);
   Double_t FitFunction4Sgn (Double_t* x, Double_t* par);
@@ -141,6 +144,7 @@ class AliHFMassFitterVAR : public AliHFMassFitter {
   Bool_t   SideBandsBounds();
   Bool_t   CheckRangeFit();
   void     AddFunctionsToHisto();
+  TFitResultPtr FitHisto(TH1* h, TF1* f, Option_t* option, Double_t xmin=0, Double_t xmax=0) const;
   Int_t fNparSignal;           /// number of signal parameters
   Int_t fNparBack;           /// number of bkg parameters
   Int_t fNparRefl;          /// number of reflection parameters
@@ -163,6 +167,8 @@ class AliHFMassFitterVAR : public AliHFMassFitter {
   Int_t fpolbackdegreeTay; /// degree of polynomial expansion for back fit (option 6 for back)
   Int_t   fpolbackdegreeTayHelp; /// help variable
   Double_t fMassParticle;       /// pdg value of particle mass
+  Bool_t fSetDefaultFitterMinuit; /// set TMinuit as default fitter in MassFitter, needed for contour plots
+  TString fMinimizer;       /// minimizer used by the fits of this object (empty: ROOT default)
 /*   TH1F*     fhistoInvMass;     // histogram to fit */
 /*   Double_t  fminMass;          // lower mass limit */
 /*   Double_t  fmaxMass;          // upper mass limit */
@@ -191,7 +197,7 @@ class AliHFMassFitterVAR : public AliHFMassFitter {
 /*   TList*    fContourGraph;     // TList of TGraph containing contour plots */
 
   /// \cond CLASSIMP
-  ClassDef(AliHFMassFitterVAR,2); /// class for invariant mass fit
+  ClassDef(AliHFMassFitterVAR,4); /// class for invariant mass fit
   /// \endcond
 };
 
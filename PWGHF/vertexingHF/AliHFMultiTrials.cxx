@@ -22,6 +22,15 @@
 #include <TF1.h>
 #include <TLatex.h>
 #include <TFile.h>
+#include <TStopwatch.h>
+#include <TDirectory.h>
+#include <TROOT.h>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+# include <TVirtualMutex.h>
+# include <atomic>
+# include <thread>
+#endif
 #include "AliHFMassFitter.h"
 #include "AliHFMassFitterVAR.h"
 #include "AliHFMultiTrials.h"
@@ -65,6 +74,7 @@ AliHFMultiTrials::AliHFMultiTrials() :
   fUseFixSigFixMean(kTRUE),
   fSaveBkgVal(kFALSE),
   fDrawIndividualFits(kFALSE),
+  fNThreads(1),
   fHistoRawYieldDistAll(0x0),
   fHistoRawYieldTrialAll(0x0),
   fHistoSigmaTrialAll(0x0),
@@ -85,6 +95,7 @@ AliHFMultiTrials::AliHFMultiTrials() :
   fHistoBkgInBinEdgesTrial(0x0),
   fHistoRawYieldDistBinC(0x0),
   fHistoRawYieldTrialBinC(0x0),
+  fHistoFitTimeCase(0x0),
   fhTemplRefl(0x0),
   fFixRefloS(0),
   fNtupleMultiTrials(0x0),
@@ -136,6 +147,7 @@ Bool_t AliHFMultiTrials::CreateHistos(){
 
   fHistoRawYieldDistBinCAll = new TH1F(Form("hRawYieldDistBinCAll%s",fSuffix.Data()),"  ; Raw Yield (bin count)",5000,0.,50000.);
   fHistoRawYieldTrialBinCAll = new TH2F(Form("hRawYieldTrialBinCAll%s",fSuffix.Data())," ; Trial # ; Range for count ; Raw Yield (bin count)",totTrials,-0.5,totTrials-0.5,fNumOfnSigmaBinCSteps,-0.5,fNumOfnSigmaBinCSteps-0.5);
+  fHistoFitTimeCase = new TH1F(Form("hFitTimeCase%s",fSuffix.Data()),"  ; ; Fit time (s)",nCases,-0.5,nCases-0.5);
 
   fHistoRawYieldDist = new TH1F*[nCases];
   fHistoRawYieldTrial = new TH1F*[nCases];
@@ -154,6 +166,7 @@ Bool_t AliHFMultiTrials::CreateHistos(){
   for(Int_t ib=0; ib<kNBkgFuncCases; ib++){
     for(Int_t igs=0; igs<kNFitConfCases; igs++){
       Int_t theCase=igs*kNBkgFuncCases+ib;
+      fHistoFitTimeCase->GetXaxis()->SetBinLabel(theCase+1,Form("%s%s",funcBkg[ib].Data(),gausSig[igs].Data()));
       fHistoRawYieldDist[theCase]=new TH1F(Form("hRawYieldDist%s%s%s",funcBkg[ib].Data(),gausSig[igs].Data(),fSuffix.Data()),"  ; Raw Yield",5000,0.,50000.);
       fHistoRawYieldDistBinC[theCase]=new TH1F(Form("hRawYieldDistBinC%s%s%s",funcBkg[ib].Data(),gausSig[igs].Data(),fSuffix.Data()),"  ; Raw Yield (bin count)",5000,0.,50000.);
       fHistoRawYieldTrial[theCase]=new TH1F(Form("hRawYieldTrial%s%s%s",funcBkg[ib].Data(),gausSig[igs].Data(),fSuffix.Data())," ; Trial # ; Raw Yield",totTrials,-0.5,totTrials-0.5);
@@ -178,7 +191,7 @@ Bool_t AliHFMultiTrials::CreateHistos(){
       
     }
   }
-  fNtupleMultiTrials = new TNtuple(Form("ntuMultiTrial%s",fSuffix.Data()),Form("ntuMultiTrial%s",fSuffix.Data()),"rebin:firstb:minfit:maxfit:bkgfunc:confsig:confmean:chi2:signif:mean:emean:sigma:esigma:rawy:erawy",128000);
+  fNtupleMultiTrials = new TNtuple(Form("ntuMultiTrial%s",fSuffix.Data()),Form("ntuMultiTrial%s",fSuffix.Data()),"rebin:firstb:minfit:maxfit:bkgfunc:confsig:confmean:chi2:signif:mean:emean:sigma:esigma:rawy:erawy:fittime",128000);
   return kTRUE;
 
 }
@@ -186,18 +199,22 @@ Bool_t AliHFMultiTrials::CreateHistos(){
 //________________________________________________________________________
 Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   // perform the multiple fits
+  // the trials are independent: they are listed first, fitted (in fNThreads
+  // threads if larger than one) and then filled in the order of the list
 
   Bool_t hOK=CreateHistos();
   if(!hOK) return kFALSE;
   
   Int_t itrial=0;
-  Int_t types=0;
   Int_t itrialBC=0;
   Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
 
   fMinYieldGlob=999999.;
   fMaxYieldGlob=0.;
-  Float_t xnt[15];
+
+  // rebinned histograms, shared by all trials with the same rebin and first bin
+  std::vector<TH1F*> rebinned;
+  std::vector<Trial_t> trials;
 
   for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
     Int_t rebin=fRebinSteps[ir];
@@ -205,6 +222,7 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
       TH1F* hRebinned=0x0;
       if(fNumOfFirstBinSteps==1) hRebinned=RebinHisto(hInvMassHisto,rebin,-1);
       else hRebinned=RebinHisto(hInvMassHisto,rebin,iFirstBin);
+      rebinned.push_back(hRebinned);
       for(Int_t iMinMass=0; iMinMass<fNumOfLowLimFitSteps; iMinMass++){
 	Double_t minMassForFit=fLowLimFitSteps[iMinMass];
 	Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
@@ -228,204 +246,296 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
 	      if (igs==kFreeSigFreeMean  && !fUseFreeS) continue;
 	      if (igs==kFixSigFreeMean  && !fUseFixSigFreeMean) continue;
 	      if (igs==kFixSigFixMean   && !fUseFixSigFixMean) continue;
-	      Int_t theCase=igs*kNBkgFuncCases+typeb;
-	      Int_t globBin=itrial+theCase*totTrials;
-	      for(Int_t j=0; j<15; j++) xnt[j]=0.;
-	      
-	      AliHFMassFitterVAR*  fitter=0x0;
-	      if(typeb<=kPol2Bkg){
-		fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
-	      }else if(typeb==kPowBkg){
-		fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);		
-	      }else if(typeb==kPowTimesExpoBkg){
-		fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
-	      }else{
-		fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
-		if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
-		if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
-		if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
-	      }
-	      fitter->SetReflectionSigmaFactor(0);
-	      //if D0 Reflection
-	      if(fhTemplRefl){
-		fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
-		fitter->SetTemplateReflections((TH1*)fhTemplRefl);
-		fitter->SetFixReflOverS(fFixRefloS,kTRUE);
-	      }
-	      if(fFitOption==1) fitter->SetUseChi2Fit();
-	      fitter->SetInitialGaussianMean(fMassD);
-	      fitter->SetInitialGaussianSigma(fSigmaGausMC);
-	      xnt[0]=rebin;
-	      xnt[1]=iFirstBin;
-	      xnt[2]=minMassForFit;
-	      xnt[3]=maxMassForFit;
-	      xnt[4]=typeb;
-	      xnt[6]=0;
-	      if(igs==kFixSigFreeMean){
-		fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-		xnt[5]=1;
-	      }else if(igs==kFixSigUpFreeMean){
-		fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
-		xnt[5]=2;
-	      }else if(igs==kFixSigDownFreeMean){
-		fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
-		xnt[5]=3;
-	      }else if(igs==kFreeSigFreeMean){
-		xnt[5]=0;
-	      }else if(igs==kFixSigFixMean){
-		fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-		fitter->SetFixGaussianMean(fMassD,kTRUE);
-		xnt[5]=1;
-		xnt[6]=1;
-	      }else if(igs==kFreeSigFixMean){
-		fitter->SetFixGaussianMean(fMassD,kTRUE);	      
-		xnt[5]=0;
-		xnt[6]=1;
-	      }
-	      Bool_t out=kFALSE;
-	      Double_t chisq=-1.;
-	      Double_t sigma=0.;
-	      Double_t esigma=0.;
-	      Double_t pos=.0;
-	      Double_t epos=.0;
-	      Double_t ry=.0;
-	      Double_t ery=.0;
-	      Double_t significance=0.;
-	      Double_t erSignif=0.;
-	      Double_t bkg=0.;
-	      Double_t erbkg=0.;
-	      Double_t bkgBEdge=0;
-	      Double_t erbkgBEdge=0;
-	      TF1* fB1=0x0;
-	      if(typeb<kNBkgFuncCases){
-		printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs);
-		out=fitter->MassFitter(0);
-		chisq=fitter->GetReducedChiSquare();
-		fitter->Significance(3,significance,erSignif);
-		sigma=fitter->GetSigma();
-		pos=fitter->GetMean();
-		esigma=fitter->GetSigmaUncertainty();
-		if(esigma<0.00001) esigma=0.0001;
-		epos=fitter->GetMeanUncertainty();
-		if(epos<0.00001) epos=0.0001;
-		ry=fitter->GetRawYield(); 
-		ery=fitter->GetRawYieldError(); 
-		fB1=fitter->GetBackgroundFullRangeFunc();
-	        fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
-		Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
-		Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
-	  	fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
-		if(out && fDrawIndividualFits && thePad){
-		  thePad->Clear();
-		  fitter->DrawHere(thePad);
-		  for (auto format : fInvMassFitSaveAsFormats) {
-		    thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
-		  }
-		}
-	      }
-	      // else{
-	      //   out=DoFitWithPol3Bkg(hRebinned,hmin,hmax,igs);
-	      //   if(out && thePad){
-	      // 	thePad->Clear();
-	      // 	hRebinned->Draw();
-	      // 	TF1* fSB=(TF1*)hRebinned->GetListOfFunctions()->FindObject("fSB");
-	      // 	fB1=new TF1("fB1","[0]+[1]*x+[2]*x*x+[3]*x*x*x",hmin,hmax);
-	      // 	for(Int_t j=0; j<4; j++) fB1->SetParameter(j,fSB->GetParameter(3+j));
-	      // 	fB1->SetLineColor(2);
-	      // 	fB1->Draw("same");
-	      // 	fSB->SetLineColor(4);
-	      // 	fSB->Draw("same");
-	      // 	thePad->Update();
-	      // 	chisq=fSB->GetChisquare()/fSB->GetNDF();;
-	      // 	sigma=fSB->GetParameter(2);
-	      // 	esigma=fSB->GetParError(2);
-	      // 	if(esigma<0.00001) esigma=0.0001;
-	      // 	pos=fSB->GetParameter(1);
-	      // 	epos=fSB->GetParError(1);
-	      // 	if(epos<0.00001) epos=0.0001;
-	      // 	ry=fSB->GetParameter(0)/hRebinned->GetBinWidth(1);
-	      // 	ery=fSB->GetParError(0)/hRebinned->GetBinWidth(1);
-	      //   }
-	      // }
-	      xnt[7]=chisq;
-	      if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
-		xnt[8]=significance;
-		xnt[9]=pos;
-		xnt[10]=epos;
-		xnt[11]=sigma;
-		xnt[12]=esigma;
-		xnt[13]=ry;
-		xnt[14]=ery;
-		fHistoRawYieldDistAll->Fill(ry);
-		fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
-		fHistoRawYieldTrialAll->SetBinError(globBin,ery);
-		fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
-		fHistoSigmaTrialAll->SetBinError(globBin,esigma);
-		fHistoMeanTrialAll->SetBinContent(globBin,pos);
-		fHistoMeanTrialAll->SetBinError(globBin,epos);
-		fHistoChi2TrialAll->SetBinContent(globBin,chisq);
-		fHistoChi2TrialAll->SetBinError(globBin,0.00001);
-		fHistoSignifTrialAll->SetBinContent(globBin,significance);
-		fHistoSignifTrialAll->SetBinError(globBin,erSignif);
-	        if(fSaveBkgVal) {
-	  	  fHistoBkgTrialAll->SetBinContent(globBin,bkg);
-		  fHistoBkgTrialAll->SetBinError(globBin,erbkg);
-		  fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,bkgBEdge);
-		  fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,erbkgBEdge);
-		}
-
-		if(ry<fMinYieldGlob) fMinYieldGlob=ry;
-		if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
-		fHistoRawYieldDist[theCase]->Fill(ry);
-		fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
-		fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
-		fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
-		fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
-		fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
-		fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
-		fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
-		fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
-		fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
-		fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
-	        if(fSaveBkgVal) {
-	  	  fHistoBkgTrial[theCase]->SetBinContent(itrial,bkg);
-		  fHistoBkgTrial[theCase]->SetBinError(itrial,erbkg);
-		  fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,bkgBEdge);
-		  fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,erbkgBEdge);
-		}
-
-		for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
-		  Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
-		  Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
-		  if(minMassBC>minMassForFit && 
-		     maxMassBC<maxMassForFit && 
-			       minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
-		     maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
-		    Double_t cnts,ecnts;
-		    BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,cnts,ecnts);
-		    ++itrialBC;
-		    fHistoRawYieldDistBinCAll->Fill(cnts);
-		    fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
-		    fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
-		    fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
-		    fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);		    
-		    fHistoRawYieldDistBinC[theCase]->Fill(cnts);
-		  }
-		}
-	      }
-	      delete fitter;
-	      //	    if(typeb>4) delete fB1;
-	      fNtupleMultiTrials->Fill(xnt);
+	      Trial_t trial;
+	      trial.fRebinIndex=rebinned.size()-1;
+	      trial.fRebin=rebin;
+	      trial.fFirstBin=iFirstBin;
+	      trial.fMinMassForFit=minMassForFit;
+	      trial.fMaxMassForFit=maxMassForFit;
+	      trial.fHmin=hmin;
+	      trial.fHmax=hmax;
+	      trial.fBkgFunc=typeb;
+	      trial.fConfSig=igs;
+	      trial.fTrial=itrial;
+	      trial.fCase=igs*kNBkgFuncCases+typeb;
+	      trial.fGlobBin=itrial+trial.fCase*totTrials;
+	      trials.push_back(trial);
 	    }
 	  }
 	}
       }
-      delete hRebinned;
     }
   }
+
+  Int_t nTrials=trials.size();
+  Int_t nThreads=TMath::Min(fNThreads,nTrials);
+  // drawing the individual fits is not thread-safe
+  if(nThreads>1 && fDrawIndividualFits && thePad){
+    printf("AliHFMultiTrials::DoMultiTrials: individual fits are drawn, fitting sequentially\n");
+    nThreads=1;
+  }
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,0,0)
+  if(nThreads>1){
+    printf("AliHFMultiTrials::DoMultiTrials: concurrent fits require ROOT 6, fitting sequentially\n");
+    nThreads=1;
+  }
+#else
+  if(nThreads>1 && !gGlobalMutex){
+    // ROOT thread safety is not turned on behind the back of the caller
+    printf("AliHFMultiTrials::DoMultiTrials: concurrent fits require ROOT::EnableThreadSafety() to be called first, fitting sequentially\n");
+    nThreads=1;
+  }
+  if(nThreads>1){
+    std::atomic<Int_t> next(0);
+    auto work=[&](){
+      // no current directory in the worker, so that the histograms cloned by
+      // the fitters are never appended to a directory shared between threads
+      TDirectory::TContext ctx(nullptr);
+      Int_t i=0;
+      while((i=next++)<nTrials) DoTrial(hInvMassHisto,rebinned[trials[i].fRebinIndex],trials[i],0x0,kTRUE);
+    };
+    std::vector<std::thread> threads;
+    for(Int_t i=0; i<nThreads; i++) threads.push_back(std::thread(work));
+    for(Int_t i=0; i<nThreads; i++) threads[i].join();
+  }
+#endif
+  if(nThreads<=1){
+    for(Int_t i=0; i<nTrials; i++) DoTrial(hInvMassHisto,rebinned[trials[i].fRebinIndex],trials[i],thePad,kFALSE);
+  }
+
+  for(Int_t i=0; i<nTrials; i++) FillTrial(trials[i],itrialBC);
+
+  for(UInt_t ih=0; ih<rebinned.size(); ih++) delete rebinned[ih];
   return kTRUE;
 }
 
+//________________________________________________________________________
+void AliHFMultiTrials::DoTrial(TH1D* hInvMassHisto, TH1F* hRebinned, Trial_t& trial, TPad* thePad, Bool_t inThread) const{
+  // fit one trial, the outcome is stored in trial
+  // does not modify the data members nor the histograms, so that the
+  // trials can be fitted in parallel
+
+  TStopwatch timer;
+  timer.Start();
+
+  Int_t types=0;
+  Int_t typeb=trial.fBkgFunc;
+  Int_t igs=trial.fConfSig;
+  Double_t hmin=trial.fHmin;
+  Double_t hmax=trial.fHmax;
+
+  AliHFMassFitterVAR*  fitter=0x0;
+  if(typeb<=kPol2Bkg){
+    fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
+  }else if(typeb==kPowBkg){
+    fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);		
+  }else if(typeb==kPowTimesExpoBkg){
+    fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
+  }else{
+    fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
+    if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
+    if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
+    if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
+  }
+  fitter->SetReflectionSigmaFactor(0);
+  //if D0 Reflection
+  if(fhTemplRefl){
+    delete fitter;
+    fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
+    fitter->SetTemplateReflections((TH1*)fhTemplRefl);
+    fitter->SetFixReflOverS(fFixRefloS,kTRUE);
+  }
+  // in threads: leave the global fitter alone and use the thread-safe Minuit2
+  // (TMinuit is not) for the fits of this fitter only
+  if(inThread){
+    fitter->SetDefaultFitterMinuit(kFALSE);
+    fitter->SetMinimizer("Minuit2");
+  }
+  if(fFitOption==1) fitter->SetUseChi2Fit();
+  fitter->SetInitialGaussianMean(fMassD);
+  fitter->SetInitialGaussianSigma(fSigmaGausMC);
+  trial.fConfMeanFlag=0;
+  if(igs==kFixSigFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+    trial.fConfSigFlag=1;
+  }else if(igs==kFixSigUpFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
+    trial.fConfSigFlag=2;
+  }else if(igs==kFixSigDownFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
+    trial.fConfSigFlag=3;
+  }else if(igs==kFreeSigFreeMean){
+    trial.fConfSigFlag=0;
+  }else if(igs==kFixSigFixMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+    trial.fConfSigFlag=1;
+    trial.fConfMeanFlag=1;
+  }else if(igs==kFreeSigFixMean){
+    fitter->SetFixGaussianMean(fMassD,kTRUE);	      
+    trial.fConfSigFlag=0;
+    trial.fConfMeanFlag=1;
+  }
+  trial.fOut=kFALSE;
+  trial.fChisq=-1.;
+  trial.fSigma=0.;
+  trial.fESigma=0.;
+  trial.fMean=.0;
+  trial.fEMean=.0;
+  trial.fRawY=.0;
+  trial.fERawY=.0;
+  trial.fSignif=0.;
+  trial.fErSignif=0.;
+  trial.fBkg=0.;
+  trial.fErBkg=0.;
+  trial.fBkgBEdge=0;
+  trial.fErBkgBEdge=0;
+  trial.fBinCDone.assign(fNumOfnSigmaBinCSteps,kFALSE);
+  trial.fBinCCounts.assign(fNumOfnSigmaBinCSteps,0.);
+  trial.fBinCErrors.assign(fNumOfnSigmaBinCSteps,0.);
+  TF1* fB1=0x0;
+  if(typeb<kNBkgFuncCases){
+    printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),trial.fRebin,trial.fFirstBin,trial.fMinMassForFit,trial.fMaxMassForFit,typeb,igs);
+    trial.fOut=fitter->MassFitter(0);
+    trial.fChisq=fitter->GetReducedChiSquare();
+    fitter->Significance(3,trial.fSignif,trial.fErSignif);
+    trial.fSigma=fitter->GetSigma();
+    trial.fMean=fitter->GetMean();
+    trial.fESigma=fitter->GetSigmaUncertainty();
+    if(trial.fESigma<0.00001) trial.fESigma=0.0001;
+    trial.fEMean=fitter->GetMeanUncertainty();
+    if(trial.fEMean<0.00001) trial.fEMean=0.0001;
+    trial.fRawY=fitter->GetRawYield(); 
+    trial.fERawY=fitter->GetRawYieldError(); 
+    fB1=fitter->GetBackgroundFullRangeFunc();
+    fitter->Background(fnSigmaForBkgEval,trial.fBkg,trial.fErBkg);
+    Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(trial.fMean-fnSigmaForBkgEval*trial.fSigma));
+    Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(trial.fMean+fnSigmaForBkgEval*trial.fSigma));
+    fitter->Background(minval,maxval,trial.fBkgBEdge,trial.fErBkgBEdge);
+    if(trial.fOut && fDrawIndividualFits && thePad){
+      thePad->Clear();
+      fitter->DrawHere(thePad);
+      for (auto format : fInvMassFitSaveAsFormats) {
+	thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),trial.fGlobBin, format.c_str()));
+      }
+    }
+  }
+  // the background function belongs to the fitter: do the bin counting before deleting it
+  Double_t sigma=trial.fSigma;
+  if(trial.fOut && trial.fChisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
+      Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
+      if(minMassBC>trial.fMinMassForFit && 
+	 maxMassBC<trial.fMaxMassForFit && 
+	 minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
+	 maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
+	BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,trial.fBinCCounts[iStepBC],trial.fBinCErrors[iStepBC]);
+	trial.fBinCDone[iStepBC]=kTRUE;
+      }
+    }
+  }
+  delete fitter;
+
+  timer.Stop();
+  trial.fTime=timer.RealTime();
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::FillTrial(const Trial_t& trial, Int_t& itrialBC){
+  // fill the output histograms and ntuple with the outcome of one trial
+
+  Int_t itrial=trial.fTrial;
+  Int_t theCase=trial.fCase;
+  Int_t globBin=trial.fGlobBin;
+  Double_t chisq=trial.fChisq;
+  Double_t sigma=trial.fSigma;
+  Double_t esigma=trial.fESigma;
+  Double_t pos=trial.fMean;
+  Double_t epos=trial.fEMean;
+  Double_t ry=trial.fRawY;
+  Double_t ery=trial.fERawY;
+  Double_t significance=trial.fSignif;
+  Double_t erSignif=trial.fErSignif;
+  Double_t bkg=trial.fBkg;
+  Double_t erbkg=trial.fErBkg;
+  Double_t bkgBEdge=trial.fBkgBEdge;
+  Double_t erbkgBEdge=trial.fErBkgBEdge;
+
+  Float_t xnt[16];
+  for(Int_t j=0; j<16; j++) xnt[j]=0.;
+  xnt[0]=trial.fRebin;
+  xnt[1]=trial.fFirstBin;
+  xnt[2]=trial.fMinMassForFit;
+  xnt[3]=trial.fMaxMassForFit;
+  xnt[4]=trial.fBkgFunc;
+  xnt[5]=trial.fConfSigFlag;
+  xnt[6]=trial.fConfMeanFlag;
+  xnt[7]=chisq;
+  xnt[15]=trial.fTime;
+  fHistoFitTimeCase->AddBinContent(theCase+1,trial.fTime);
+  if(trial.fOut && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
+    xnt[8]=significance;
+    xnt[9]=pos;
+    xnt[10]=epos;
+    xnt[11]=sigma;
+    xnt[12]=esigma;
+    xnt[13]=ry;
+    xnt[14]=ery;
+    fHistoRawYieldDistAll->Fill(ry);
+    fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
+    fHistoRawYieldTrialAll->SetBinError(globBin,ery);
+    fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
+    fHistoSigmaTrialAll->SetBinError(globBin,esigma);
+    fHistoMeanTrialAll->SetBinContent(globBin,pos);
+    fHistoMeanTrialAll->SetBinError(globBin,epos);
+    fHistoChi2TrialAll->SetBinContent(globBin,chisq);
+    fHistoChi2TrialAll->SetBinError(globBin,0.00001);
+    fHistoSignifTrialAll->SetBinContent(globBin,significance);
+    fHistoSignifTrialAll->SetBinError(globBin,erSignif);
+    if(fSaveBkgVal) {
+      fHistoBkgTrialAll->SetBinContent(globBin,bkg);
+      fHistoBkgTrialAll->SetBinError(globBin,erbkg);
+      fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,bkgBEdge);
+      fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,erbkgBEdge);
+    }
+
+    if(ry<fMinYieldGlob) fMinYieldGlob=ry;
+    if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
+    fHistoRawYieldDist[theCase]->Fill(ry);
+    fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
+    fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
+    fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
+    fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
+    fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
+    fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
+    fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
+    fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
+    fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
+    fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
+    if(fSaveBkgVal) {
+      fHistoBkgTrial[theCase]->SetBinContent(itrial,bkg);
+      fHistoBkgTrial[theCase]->SetBinError(itrial,erbkg);
+      fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,bkgBEdge);
+      fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,erbkgBEdge);
+    }
+
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      if(!trial.fBinCDone[iStepBC]) continue;
+      Double_t cnts=trial.fBinCCounts[iStepBC];
+      Double_t ecnts=trial.fBinCErrors[iStepBC];
+      ++itrialBC;
+      fHistoRawYieldDistBinCAll->Fill(cnts);
+      fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
+      fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
+      fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
+      fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);		    
+      fHistoRawYieldDistBinC[theCase]->Fill(cnts);
+    }
+  }
+  fNtupleMultiTrials->Fill(xnt);
+}
+
 //________________________________________________________________________
 void AliHFMultiTrials::SaveToRoot(TString fileName, TString option) const{
   // save histos in a root file for further analysis
@@ -442,6 +552,7 @@ void AliHFMultiTrials::SaveToRoot(TString fileName, TString option) const{
   }
   fHistoRawYieldDistBinCAll->Write(); 
   fHistoRawYieldTrialBinCAll->Write(); 
+  fHistoFitTimeCase->Write();
   for(Int_t ic=0; ic<nCases; ic++){
     fHistoRawYieldTrial[ic]->Write();
     fHistoSigmaTrial[ic]->Write();    
@@ -7,6 +7,7 @@
 #include <TString.h>
 #include <TPad.h>
 #include <set>
+#include <vector>
 
 class TNtuple;
 
@@ -84,6 +85,11 @@ class AliHFMultiTrials : public TNamed {
 
   void SetDrawIndividualFits(Bool_t opt=kTRUE){fDrawIndividualFits=opt;}
 
+  /// Number of threads running the trials, 1 for the serial loop.
+  /// With more threads (ROOT 6 only, and ROOT::EnableThreadSafety() must have been called by the
+  /// application) each fitter uses Minuit2, since TMinuit is not thread-safe.
+  void SetNThreads(Int_t n=1){fNThreads=(n<1 ? 1 : n);}
+
   Bool_t DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad=0x0);
   void SaveToRoot(TString fileName, TString option="recreate") const;
   void DrawHistos(TCanvas* cry) const;
@@ -100,7 +106,34 @@ class AliHFMultiTrials : public TNamed {
 
  private:
 
+  /// One trial of the grid: fit configuration and outcome
+  struct Trial_t {
+    Int_t    fRebinIndex;    /// index of the shared rebinned histogram
+    Int_t    fRebin;         /// rebin value
+    Int_t    fFirstBin;      /// first bin used for rebin
+    Double_t fMinMassForFit; /// lower limit of the fit range step
+    Double_t fMaxMassForFit; /// upper limit of the fit range step
+    Double_t fHmin;          /// lower fit limit within the histogram
+    Double_t fHmax;          /// upper fit limit within the histogram
+    Int_t    fBkgFunc;       /// background function case
+    Int_t    fConfSig;       /// signal configuration case
+    Int_t    fTrial;         /// trial index within a case, from 1
+    Int_t    fCase;          /// case index
+    Int_t    fGlobBin;       /// bin in the histograms of all trials
+    Bool_t   fOut;           /// fit status
+    Double_t fChisq, fSignif, fErSignif, fMean, fEMean, fSigma, fESigma, fRawY, fERawY;
+    Double_t fBkg, fErBkg, fBkgBEdge, fErBkgBEdge;
+    Float_t  fConfSigFlag;   /// ntuple value of confsig
+    Float_t  fConfMeanFlag;  /// ntuple value of confmean
+    Double_t fTime;          /// real time of the trial (s)
+    std::vector<Bool_t>   fBinCDone;   /// bin counting done for each n sigma step
+    std::vector<Double_t> fBinCCounts; /// bin counting yield for each n sigma step
+    std::vector<Double_t> fBinCErrors; /// bin counting error for each n sigma step
+  };
+
   Bool_t CreateHistos();
+  void DoTrial(TH1D* hInvMassHisto, TH1F* hRebinned, Trial_t& trial, TPad* thePad, Bool_t inThread) const;
+  void FillTrial(const Trial_t& trial, Int_t& itrialBC);
   TH1F* RebinHisto(TH1D* hOrig, Int_t reb, Int_t firstUse) const;
   void BinCount(TH1F* h, TF1* fB, Int_t rebin, Double_t minMass, Double_t maxMass, Double_t& count, Double_t& ecount) const;
   Bool_t DoFitWithPol3Bkg(TH1F* histoToFit, Double_t  hmin, Double_t  hmax,
@@ -145,6 +178,8 @@ class AliHFMultiTrials : public TNamed {
 
   Bool_t fDrawIndividualFits; /// flag for drawing fits
 
+  Int_t fNThreads;           /// number of threads running the trials
+
   TH1F* fHistoRawYieldDistAll;  /// histo with yield from all trials
   TH1F* fHistoRawYieldTrialAll; /// histo with yield from all trials
   TH1F* fHistoSigmaTrialAll;    /// histo with gauss sigma from all trials
@@ -168,6 +203,7 @@ class AliHFMultiTrials : public TNamed {
 
   TH1F** fHistoRawYieldDistBinC;  /// histo with bin counts from subsamples of trials
   TH2F** fHistoRawYieldTrialBinC; /// histo with bin counts from subsamples of trials
+  TH1F* fHistoFitTimeCase;      /// histo with summed fit time (s) per case
   TH1F *fhTemplRefl;        /// template of reflection contribution
   Float_t fFixRefloS;
   TNtuple* fNtupleMultiTrials; /// tree
@@ -176,7 +212,7 @@ class AliHFMultiTrials : public TNamed {
   Double_t fMaxYieldGlob;   /// maximum yield
 
   /// \cond CLASSIMP
-  ClassDef(AliHFMultiTrials,5); /// class for multiple trials of invariant mass fit
+  ClassDef(AliHFMultiTrials,6); /// class for multiple trials of invariant mass fit
   /// \endcond
 };
 
@@ -14,6 +14,7 @@
  **************************************************************************/
 
 #include <vector>
+#include <thread>
 
 #include <TClonesArray.h>
 #include <TMath.h>
@@ -70,6 +71,11 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fAddJetAlgo(),
+  fAddRadius(),
+  fAddRecombScheme(),
+  fAddMinJetPt(),
+  fParallelJetFinding(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -79,7 +85,10 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fJets(0),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
-  fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask")
+  fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
+  fAddJets(),
+  fAddFastJetWrappers(),
+  fGhosts()
 {
 }
 
@@ -105,6 +114,11 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fAddJetAlgo(),
+  fAddRadius(),
+  fAddRecombScheme(),
+  fAddMinJetPt(),
+  fParallelJetFinding(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -114,7 +128,10 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fJets(0),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
-  fFastJetWrapper(name,name)
+  fFastJetWrapper(name,name),
+  fAddJets(),
+  fAddFastJetWrappers(),
+  fGhosts()
 {
 }
 
@@ -123,6 +140,37 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+  for (UInt_t i = 0; i < fAddFastJetWrappers.size(); i++) delete fAddFastJetWrappers[i];
+}
+
+/**
+ * Add a jet definition, found on the same constituents as the main jet definition of the task.
+ * The jet type, ghost area, eta/phi acceptance and minimum area of the jets are those of the task.
+ * @param algo Jet algorithm
+ * @param radius Jet resolution parameter
+ * @param scheme Recombination scheme
+ * @param minJetPt Minimum jet pt (if negative, the one of the main jet definition)
+ */
+void AliEmcalJetTask::AddJetDefinition(EJetAlgo_t algo, Double_t radius, ERecoScheme_t scheme, Double_t minJetPt)
+{
+  if (IsLocked()) return;
+
+  fAddJetAlgo.push_back(algo);
+  fAddRadius.push_back(radius);
+  fAddRecombScheme.push_back(scheme);
+  fAddMinJetPt.push_back(minJetPt);
+}
+
+/**
+ * Jet collection of a jet definition.
+ * @param i Index of the jet definition (0 is the main jet definition, i > 0 the additional ones in the order they were added)
+ * @return Jet collection (0 if not available)
+ */
+TClonesArray* AliEmcalJetTask::GetJets(Int_t i)
+{
+  if (i == 0) return fJets;
+  if (i < 0 || i > (Int_t)fAddJets.size()) return 0;
+  return fAddJets[i - 1];
 }
 
 /**
@@ -206,11 +254,19 @@ Bool_t AliEmcalJetTask::Run()
   InitEvent();
   // clear the jet array (normally a null operation)
   fJets->Delete();
+  for (UInt_t i = 0; i < fAddJets.size(); i++) {
+    if (fAddJets[i]) fAddJets[i]->Delete();
+  }
   Int_t n = FindJets();
 
   if (n == 0) return kFALSE;
 
   FillJetBranch();
+  for (UInt_t i = 0; i < fAddJets.size(); i++) {
+    if (!fAddJets[i]) continue;
+    Double_t minJetPt = fAddMinJetPt[i] < 0 ? fMinJetPt : fAddMinJetPt[i];
+    FillJetBranch(*fAddFastJetWrappers[i], fAddJets[i], minJetPt, fAddRadius[i], kFALSE);
+  }
 
   return kTRUE;
 }
@@ -274,12 +330,66 @@ Int_t AliEmcalJetTask::FindJets()
 
   if (fFastJetWrapper.GetInputVectors().size() == 0) return 0;
 
+  if (!fAddJets.empty()) return RunJetDefinitions();
+
   // run jet finder
   fFastJetWrapper.Run();
 
   return fFastJetWrapper.GetInclusiveJets().size();
 }
 
+/**
+ * Run the clustering of the jet definition of a wrapper on its input vectors and the shared ghosts.
+ * Executed in a separate thread if the parallel jet finding is enabled.
+ */
+static void RunJetDefinition(AliFJWrapper* wrapper, const std::vector<fastjet::PseudoJet>* ghosts, Double_t ghostArea)
+{
+  wrapper->RunWithGhosts(*ghosts, ghostArea);
+}
+
+/**
+ * This method runs all the jet definitions on the input vectors of the main FastJet wrapper.
+ * The ghosts are generated once and shared by all jet definitions. If utilities are attached,
+ * the main jet definition is run with its own ghosts, since the utilities need the cluster sequence
+ * of AliFJWrapper::Run().
+ * @return Total number of jets found.
+ */
+Int_t AliEmcalJetTask::RunJetDefinitions()
+{
+  const Double_t ghostArea = fFastJetWrapper.GenerateGhosts(fGhosts);
+
+  if (fUtilities && fUtilities->GetEntriesFast() > 0) {
+    fFastJetWrapper.Run();
+  }
+  else {
+    fFastJetWrapper.RunWithGhosts(fGhosts, ghostArea);
+  }
+
+  std::vector<AliFJWrapper*> wrappers;
+  for (UInt_t i = 0; i < fAddJets.size(); i++) {
+    if (!fAddJets[i]) continue;
+    fAddFastJetWrappers[i]->Clear();
+    fAddFastJetWrappers[i]->AddInputVectors(fFastJetWrapper.GetInputVectors());
+    wrappers.push_back(fAddFastJetWrappers[i]);
+  }
+
+  if (fParallelJetFinding && wrappers.size() > 1) {
+    std::vector<std::thread> threads;
+    for (UInt_t i = 0; i < wrappers.size(); i++) {
+      threads.push_back(std::thread(RunJetDefinition, wrappers[i], &fGhosts, ghostArea));
+    }
+    for (UInt_t i = 0; i < threads.size(); i++) threads[i].join();
+  }
+  else {
+    for (UInt_t i = 0; i < wrappers.size(); i++) RunJetDefinition(wrappers[i], &fGhosts, ghostArea);
+  }
+
+  Int_t n = fFastJetWrapper.GetInclusiveJets().size();
+  for (UInt_t i = 0; i < wrappers.size(); i++) n += wrappers[i]->GetInclusiveJets().size();
+
+  return n;
+}
+
 /**
  * This method fills the jet output branch (TClonesArray) with the jet found by the FastJet
  * wrapper. Before filling the jet branch, the utilities are prepared. Then the utilities are
@@ -287,10 +397,23 @@ Int_t AliEmcalJetTask::FindJets()
  */
 void AliEmcalJetTask::FillJetBranch()
 {
-  PrepareUtilities();
+  FillJetBranch(fFastJetWrapper, fJets, fMinJetPt, fRadius, kTRUE);
+}
+
+/**
+ * This method fills a jet output branch (TClonesArray) with the jets found by a FastJet wrapper.
+ * @param wrapper FastJet wrapper that ran the jet finding
+ * @param jets Output jet collection
+ * @param minJetPt Minimum jet pt
+ * @param radius Jet resolution parameter (for the acceptance type)
+ * @param utilities Whether the utilities are executed
+ */
+void AliEmcalJetTask::FillJetBranch(AliFJWrapper& wrapper, TClonesArray* jets, Double_t minJetPt, Double_t radius, Bool_t utilities)
+{
+  if (utilities) PrepareUtilities();
 
   // loop over fastjet jets
-  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJets();
+  std::vector<fastjet::PseudoJet> jets_incl = wrapper.GetInclusiveJets();
   // sort jets according to jet pt
   static Int_t indexes[9999] = {-1};
   GetSortedArray(indexes, jets_incl);
@@ -298,27 +421,27 @@ void AliEmcalJetTask::FillJetBranch()
   AliDebug(1,Form("%d jets found", (Int_t)jets_incl.size()));
   for (UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
     Int_t ij = indexes[ijet];
-    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), fFastJetWrapper.GetJetArea(ij)));
+    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), wrapper.GetJetArea(ij)));
 
-    if (jets_incl[ij].perp() < fMinJetPt) continue;
-    if (fFastJetWrapper.GetJetArea(ij) < fMinJetArea) continue;
+    if (jets_incl[ij].perp() < minJetPt) continue;
+    if (wrapper.GetJetArea(ij) < fMinJetArea) continue;
     if ((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax) ||
         (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
       continue;
 
-    AliEmcalJet *jet = new ((*fJets)[jetCount])
+    AliEmcalJet *jet = new ((*jets)[jetCount])
     		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
     jet->SetLabel(ij);
 
-    fastjet::PseudoJet area(fFastJetWrapper.GetJetAreaVector(ij));
+    fastjet::PseudoJet area(wrapper.GetJetAreaVector(ij));
     jet->SetArea(area.perp());
     jet->SetAreaEta(area.eta());
     jet->SetAreaPhi(area.phi());
     jet->SetAreaE(area.E());
-    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), fRadius));
+    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), radius));
 
     // Fill constituent info
-    std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituents(ij));
+    std::vector<fastjet::PseudoJet> constituents(wrapper.GetJetConstituents(ij));
     FillJetConstituents(jet, constituents, constituents);
 
     if (fGeom) {
@@ -329,13 +452,13 @@ void AliEmcalJetTask::FillJetBranch()
         jet->SetAxisInEmcal(kTRUE);
     }
 
-    ExecuteUtilities(jet, ij);
+    if (utilities) ExecuteUtilities(jet, ij);
 
     AliDebug(2,Form("Added jet n. %d, pt = %f, area = %f, constituents = %d", jetCount, jet->Pt(), jet->Area(), jet->GetNumberOfConstituents()));
     jetCount++;
   }
 
-  TerminateUtilities();
+  if (utilities) TerminateUtilities();
 }
 
 /**
@@ -401,6 +524,33 @@ void AliEmcalJetTask::ExecOnce()
     fFastJetWrapper.SetLegacyMode(kTRUE);
   }
 
+  // additional jet definitions: same settings and constituents, own algorithm, radius and recombination scheme
+  for (UInt_t i = 0; i < fAddJetAlgo.size(); i++) {
+    EJetAlgo_t algo = static_cast<EJetAlgo_t>(fAddJetAlgo[i]);
+    ERecoScheme_t scheme = static_cast<ERecoScheme_t>(fAddRecombScheme[i]);
+    TString jetsName = AliJetContainer::GenerateJetName(fJetType, algo, scheme, fAddRadius[i], GetParticleContainer(0), GetClusterContainer(0), fJetsTag);
+
+    TClonesArray *jets = 0;
+    AliFJWrapper *wrapper = 0;
+    if (!(InputEvent()->FindListObject(jetsName))) {
+      jets = new TClonesArray("AliEmcalJet");
+      jets->SetName(jetsName);
+      ::Info("AliEmcalJetTask::ExecOnce", "Jet collection with name '%s' has been added to the event.", jetsName.Data());
+      InputEvent()->AddObject(jets);
+
+      wrapper = new AliFJWrapper(jetsName, jetsName);
+      wrapper->CopySettingsFrom(fFastJetWrapper);
+      wrapper->SetR(fAddRadius[i]);
+      wrapper->SetAlgorithm(ConvertToFJAlgo(algo));
+      wrapper->SetRecombScheme(ConvertToFJRecoScheme(scheme));
+    }
+    else {
+      AliError(Form("%s: Object with name %s already in event! Skipping this jet definition", GetName(), jetsName.Data()));
+    }
+    fAddJets.push_back(jets);
+    fAddFastJetWrappers.push_back(wrapper);
+  }
+
   InitUtilities();
 
   AliAnalysisTaskEmcal::ExecOnce();
@@ -9,6 +9,8 @@ class TObjArray;
 class AliVEvent;
 class AliEmcalJetUtility;
 
+#include <vector>
+
 #include <AliLog.h>
 
 #include "AliAnalysisTaskEmcal.h"
@@ -44,6 +46,14 @@ namespace fastjet {
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
  * deriving a new class from AliEmcalJetUtility to interface functionalities of the FastJet contribs.
+ *
+ * Additional jet definitions (algorithm, radius, recombination scheme) on the same constituents
+ * can be added with AddJetDefinition(), instead of running one task per definition. The constituents
+ * are then read from the containers once per event, and a single set of ghosts is generated and
+ * shared by all definitions. Each definition publishes its own jet collection, named as if it was
+ * found by a separate task with the same constituents and tag. The clustering of the additional
+ * definitions can run in parallel threads (SetParallelJetFinding()), which requires a thread-safe
+ * FastJet build. The utilities are only executed for the main jet definition.
  */
 class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  public:
@@ -79,6 +89,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetLegacyMode(Bool_t mode)                 { if (IsLocked()) return; fLegacyMode       = mode  ; }
   void                   SetFillGhost(Bool_t b=kTRUE)               { if (IsLocked()) return; fFillGhost        = b     ; }
   void                   SetRadius(Double_t r)                      { if (IsLocked()) return; fRadius           = r     ; }
+  void                   SetParallelJetFinding(Bool_t b)            { if (IsLocked()) return; fParallelJetFinding = b   ; }
+  void                   AddJetDefinition(EJetAlgo_t algo, Double_t radius, ERecoScheme_t scheme, Double_t minJetPt = -1);
 
   void                   SetEtaRange(Double_t emi, Double_t ema);
   void                   SetMinJetClusPt(Double_t min);
@@ -107,6 +119,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
+  Int_t                  GetNJetDefinitions() const       { return fAddJetAlgo.size() + 1; }
+  TClonesArray*          GetJets(Int_t i);
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
 
   void                   FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet::PseudoJet>& constituents,
@@ -144,6 +158,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   Int_t                  FindJets();
   void                   FillJetBranch();
+  void                   FillJetBranch(AliFJWrapper& wrapper, TClonesArray* jets, Double_t minJetPt, Double_t radius, Bool_t utilities);
+  Int_t                  RunJetDefinitions();
   void                   ExecOnce();
   void                   InitEvent();
   void                   InitUtilities();
@@ -173,6 +189,11 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   TObjArray             *fUtilities;              // jet utilities (gen subtractor, constituent subtractor etc.)
   Bool_t                 fTrackEfficiencyOnlyForEmbedding; // Apply aritificial tracking inefficiency only for embedded tracks
   Bool_t                 fLocked;                 // true if lock is set
+  std::vector<Int_t>     fAddJetAlgo;             // algorithms of the additional jet definitions
+  std::vector<Double_t>  fAddRadius;              // radii of the additional jet definitions
+  std::vector<Int_t>     fAddRecombScheme;        // recombination schemes of the additional jet definitions
+  std::vector<Double_t>  fAddMinJetPt;            // min jet pt of the additional jet definitions (<0: same as main)
+  Bool_t                 fParallelJetFinding;     // run the clustering of the additional jet definitions in parallel
 
   TString                fJetsName;               //!name of jet collection
   Bool_t                 fIsInit;                 //!=true if already initialized
@@ -183,6 +204,11 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   TClonesArray          *fJets;                   //!jet collection
   AliFJWrapper           fFastJetWrapper;         //!fastjet wrapper
+  std::vector<TClonesArray*> fAddJets;            //!jet collections of the additional jet definitions
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+  std::vector<AliFJWrapper*> fAddFastJetWrappers; //!<!fastjet wrappers of the additional jet definitions
+  std::vector<fastjet::PseudoJet> fGhosts;        //!<!ghosts shared by all jet definitions
+#endif
 
   static const Int_t     fgkConstIndexShift;      //!contituent index shift
 
@@ -197,7 +223,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 24);
+  ClassDef(AliEmcalJetTask, 25);
   /// \endcond
 };
 #endif
@@ -79,6 +79,8 @@ class AliFJWrapper
   virtual void RemoveLastInputVector();
 
   virtual Int_t Run();
+  virtual Int_t RunWithGhosts(const std::vector<fastjet::PseudoJet>& ghosts, Double_t ghostArea);
+  Double_t      GenerateGhosts(std::vector<fastjet::PseudoJet>& ghosts) const;
   virtual Int_t Filter();
   virtual Int_t DoGenericSubtractionJetMass();
   virtual Int_t DoGenericSubtractionGR(Int_t ijet);
@@ -474,7 +476,8 @@ Double_t AliFJWrapper::GetJetArea(UInt_t idx) const
 
   Double_t retval = -1; // really wrong area..
   if ( idx < fInclusiveJets.size() ) {
-    retval = fClustSeq->area(fInclusiveJets[idx]);
+    if (fClustSeq) retval = fClustSeq->area(fInclusiveJets[idx]);
+    else           retval = fClustSeqActGhosts->area(fInclusiveJets[idx]);
   } else {
     AliError(Form("[e] ::GetJetArea wrong index: %d",idx));
   }
@@ -514,7 +517,8 @@ fastjet::PseudoJet AliFJWrapper::GetJetAreaVector(UInt_t idx) const
   // Get the jet area as vector.
   fastjet::PseudoJet retval;
   if ( idx < fInclusiveJets.size() ) {
-    retval = fClustSeq->area_4vector(fInclusiveJets[idx]);
+    if (fClustSeq) retval = fClustSeq->area_4vector(fInclusiveJets[idx]);
+    else           retval = fClustSeqActGhosts->area_4vector(fInclusiveJets[idx]);
   } else {
     AliError(Form("[e] ::GetJetArea wrong index: %d",idx));
   }
@@ -581,7 +585,8 @@ AliFJWrapper::GetJetConstituents(UInt_t idx) const
   std::vector<fastjet::PseudoJet> retval;
 
   if ( idx < fInclusiveJets.size() ) {
-    retval = fClustSeq->constituents(fInclusiveJets[idx]);
+    if (fClustSeq) retval = fClustSeq->constituents(fInclusiveJets[idx]);
+    else           retval = fClustSeqActGhosts->constituents(fInclusiveJets[idx]);
   } else {
     AliError(Form("[e] ::GetJetConstituents wrong index: %d",idx));
   }
@@ -733,6 +738,49 @@ Int_t AliFJWrapper::Run()
   return 0;
 }
 
+//_________________________________________________________________________________________________
+Int_t AliFJWrapper::RunWithGhosts(const std::vector<fastjet::PseudoJet>& ghosts, Double_t ghostArea)
+{
+  // Run the jet finder on the input vectors together with explicit ghosts generated beforehand
+  // with GenerateGhosts(), such that several jet definitions can share the same ghosts.
+  // Jet areas and constituents are then taken from the explicit ghosts cluster sequence.
+  // Plugin algorithms and the event-wise subtraction are not supported.
+
+  if (fAlgor == fj::plugin_algorithm || fEventSub) {
+    AliError("[e] RunWithGhosts does not support plugin algorithms and event-wise subtraction!");
+    return -1;
+  }
+
+  fJetDef = new fj::JetDefinition(fAlgor, fR, fScheme, fStrategy);
+
+  try {
+    fClustSeqActGhosts = new fj::ClusterSequenceActiveAreaExplicitGhosts(fInputVectors, *fJetDef, ghosts, ghostArea);
+  } catch (fj::Error) {
+    AliError(" [w] FJ Exception caught.");
+    return -1;
+  }
+
+  fInclusiveJets.clear();
+  fInclusiveJets = fClustSeqActGhosts->inclusive_jets(0.0);
+
+  return 0;
+}
+
+//_________________________________________________________________________________________________
+Double_t AliFJWrapper::GenerateGhosts(std::vector<fastjet::PseudoJet>& ghosts) const
+{
+  // Generate the ghosts of the active area with the settings of this wrapper.
+  // Returns the actual area of a ghost, to be given to RunWithGhosts().
+
+  ghosts.clear();
+  fj::GhostedAreaSpec spec(fMaxRap, 1, fGhostArea, fGridScatter, fKtScatter, fMeanGhostKt);
+#ifdef FASTJET_VERSION
+  if (fLegacyMode) spec.set_fj2_placement(kTRUE);
+#endif
+  spec.add_ghosts(ghosts);
+  return spec.actual_ghost_area();
+}
+
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::Filter()
 {
@@ -16,8 +16,16 @@
 #include <TFitResult.h>
 #include <THStack.h>
 #include <TROOT.h>
+#include <TArrayI.h>
+#include <RVersion.h>
 #include <iostream>
 #include <iomanip>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+# include <TVirtualMutex.h>
+# include <atomic>
+# include <thread>
+# include <vector>
+#endif
 
 ClassImp(AliFMDEnergyFitter)
 #if 0
@@ -49,7 +57,8 @@ AliFMDEnergyFitter::AliFMDEnergyFitter()
     fDebug(0),
     fResidualMethod(kNoResiduals),
     fSkips(0),
-    fRegularizationCut(3e6)
+    fRegularizationCut(3e6),
+    fNThreads(1)
 {
   // 
   // Default Constructor - do not use 
@@ -79,7 +88,8 @@ AliFMDEnergyFitter::AliFMDEnergyFitter(const char* title)
     fDebug(0),
     fResidualMethod(kNoResiduals),
     fSkips(0),
-    fRegularizationCut(3e6)
+    fRegularizationCut(3e6),
+    fNThreads(1)
 {
   // 
   // Constructor 
@@ -297,6 +307,12 @@ AliFMDEnergyFitter::SetEnableDeltaShift(Bool_t use)
 {
   AliLandauGaus::EnableSigmaShift(use ? 1 : 0);
 }
+//____________________________________________________________________
+void
+AliFMDEnergyFitter::SetEnableTabulatedLandauGaus(Bool_t use) 
+{
+  AliLandauGaus::EnableTable(use ? 1 : 0);
+}
 
 //____________________________________________________________________
 Bool_t
@@ -415,6 +431,7 @@ AliFMDEnergyFitter::Fit(const TList* dir)
       continue;
     }
     
+    o->fNThreads = fNThreads;
     TObjArray* l = o->Fit(d, fLowCut, fNParticles,
 			  fMinEntries, fFitRangeBinWidth,
 			  fMaxRelParError, fMaxChi2PerNDF,
@@ -582,6 +599,8 @@ AliFMDEnergyFitter::Print(Option_t*) const
   PFV("max(chi^2/nu)",	        fMaxChi2PerNDF);
   PFV("min(a_i)",	        fMinWeight);
   PFV("Regularization cut",     fRegularizationCut);
+  PFB("Tabulated Landau-Gauss",  AliLandauGaus::EnableTable());
+  PFV("Fit threads",            fNThreads);
   TString r = "";
   switch (fResidualMethod) { 
   case kNoResiduals:              r = "None";       break;
@@ -602,8 +621,8 @@ AliFMDEnergyFitter::RingHistos::RingHistos()
     fHist(0),
     fList(0),
     fBest(0),
-    fFits("AliFMDCorrELossFit::ELossFit", 200),
-    fDebug(0)
+    fDebug(0),
+    fNThreads(1)
 {
   // 
   // Default CTOR
@@ -621,8 +640,8 @@ AliFMDEnergyFitter::RingHistos::RingHistos(UShort_t d, Char_t r)
     fHist(0),
     fList(0),
     fBest(0),
-    fFits("AliFMDCorrELossFit::ELossFit", 200),
-    fDebug(0)
+    fDebug(0),
+    fNThreads(1)
 {
   // 
   // Constructor
@@ -1056,36 +1075,42 @@ AliFMDEnergyFitter::RingHistos::FitSlices(TList*           dir,
     best->Clear();
     best->SetOwner(false);
   }
+  // Get the distributions to fit.  The full-ring histogram is put
+  // last, so that it is fitted together with the eta bins.
+  TObjArray hists(nDists+1);
   for (Int_t i = 0; i < nDists; i++) { 
     // Ignore empty histograms altoghether 
     Int_t b    = i+1;
     TH1D* dist = (h ? h->ProjectionY(Form(fgkEDistFormat,GetName(),b),b,b,"e") 
 		  : static_cast<TH1D*>(dists->At(i)));
-    if (!dist) { 
-      // If we got the null pointer, return 0
-      nEmpty++;
-      continue;
-    }
+    if (!dist) continue;
     // Then releasing the histogram from the it's directory
     dist->SetDirectory(0);
     // Set a meaningful title
     dist->SetTitle(Form("#Delta/#Delta_{mip} for %s in %6.2f<#eta<%6.2f",
 			GetName(), eta.GetBinLowEdge(b),
 			eta.GetBinUpEdge(b)));
+    hists.AddAt(dist, i);
+  }
+  TH1* total = GetOutputHist(l, Form("%s_edist", fName.Data()));
+  hists.AddAt(total, nDists);
+
+  // Now fit 
+  TObjArray results(nDists+1);
+  TArrayI   statuses(nDists+1);
+  FitHists(hists, results, statuses, lowCut, nParticles, minEntries, 
+	   minusBins, relErrorCut, chi2nuCut, minWeight, regCut, scaleToPeak);
 
-    // Now fit 
-    UShort_t    status1 = 0;
-    ELossFit_t* res     = FitHist(dist,
-				  lowCut, 
-				  nParticles,
-				  minEntries,
-				  minusBins,   
-				  relErrorCut,
-				  chi2nuCut,
-				  minWeight,
-				  regCut,
-				  scaleToPeak,
-				  status1);
+  for (Int_t i = 0; i < nDists; i++) { 
+    Int_t b    = i+1;
+    TH1D* dist = static_cast<TH1D*>(hists.At(i));
+    if (!dist) { 
+      // If we got the null pointer, return 0
+      nEmpty++;
+      continue;
+    }
+    UShort_t    status1 = statuses[i];
+    ELossFit_t* res     = static_cast<ELossFit_t*>(results.At(i));
     if (!res) {
       switch (status1) { 
       case 1: nEmpty++; break;
@@ -1143,21 +1168,9 @@ AliFMDEnergyFitter::RingHistos::FitSlices(TList*           dir,
 	 "leaving %d to be fitted, of which %d succeeded\n",  
 	 GetName(), nDists, nEmpty, nLow, nDists-nEmpty-nLow, nFitted);
 
-  // Fit the full-ring histogram 
-  TH1*        total   = GetOutputHist(l, Form("%s_edist", fName.Data()));
+  // Results of the fit of the full-ring histogram 
   if (total) {
-    UShort_t    statusT = 0;
-    ELossFit_t* resT    = FitHist(total,
-				  lowCut, 
-				  nParticles,
-				  minEntries, 
-				  minusBins,
-				  relErrorCut,
-				  chi2nuCut,
-				  minWeight,
-				  regCut,
-				  scaleToPeak,
-				  statusT);
+    ELossFit_t* resT    = static_cast<ELossFit_t*>(results.At(nDists));
     if (resT) { 
       // Make histograms for the result of this fit 
       Double_t chi2 = resT->GetChi2();
@@ -1206,6 +1219,83 @@ AliFMDEnergyFitter::RingHistos::FitSlices(TList*           dir,
 }
 
 
+//____________________________________________________________________
+void
+AliFMDEnergyFitter::RingHistos::FitHists(const TObjArray& hists,
+					 TObjArray&       results,
+					 TArrayI&         statuses,
+					 Double_t         lowCut, 
+					 UShort_t         nParticles,
+					 UShort_t         minEntries,
+					 UShort_t         minusBins, 
+					 Double_t         relErrorCut, 
+					 Double_t         chi2nuCut,
+					 Double_t         minWeight,
+					 Double_t         regCut,
+					 Bool_t           scaleToPeak) const
+{
+  // 
+  // Fit each histogram in hists with FitHist, and store the best fit
+  // and the status code at the same index in results and statuses.
+  // The fits of different histograms are independent, and are done
+  // in fNThreads threads if that is larger than one.
+  // 
+  Int_t n        = hists.GetSize();
+  Int_t nThreads = TMath::Min(fNThreads, n);
+  statuses.Set(n);
+  statuses.Reset(0);
+  results.Expand(n);
+  results.Clear();
+
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,0,0)
+  if (nThreads > 1) {
+    AliWarning("Concurrent fits require ROOT 6 - fitting sequentially");
+    nThreads = 1;
+  }
+#else
+  if (nThreads > 1 && !gGlobalMutex) {
+    // We do not turn on ROOT's thread safety behind the users back 
+    AliWarning("Concurrent fits require ROOT::EnableThreadSafety() to "
+	       "be called first - fitting sequentially");
+    nThreads = 1;
+  }
+  if (nThreads > 1) { 
+    std::vector<ELossFit_t*> fits(n, 0);
+    std::vector<UShort_t>    codes(n, 0);
+    std::atomic<Int_t>       next(0);
+    auto work = [&]() {
+      Int_t i = 0;
+      while ((i = next++) < n) {
+	TH1* dist = static_cast<TH1*>(hists.At(i));
+	if (!dist) continue;
+	fits[i] = FitHist(dist, lowCut, nParticles, minEntries, minusBins, 
+			  relErrorCut, chi2nuCut, minWeight, regCut, 
+			  scaleToPeak, codes[i]);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (Int_t i = 0; i < nThreads; i++) threads.push_back(std::thread(work));
+    for (Int_t i = 0; i < nThreads; i++) threads[i].join();
+
+    for (Int_t i = 0; i < n; i++) { 
+      results.AddAt(fits[i], i);
+      statuses[i] = codes[i];
+    }
+    return;
+  }
+#endif
+
+  for (Int_t i = 0; i < n; i++) { 
+    TH1* dist = static_cast<TH1*>(hists.At(i));
+    if (!dist) continue;
+    UShort_t status = 0;
+    results.AddAt(FitHist(dist, lowCut, nParticles, minEntries, minusBins, 
+			  relErrorCut, chi2nuCut, minWeight, regCut, 
+			  scaleToPeak, status), i);
+    statuses[i] = status;
+  }
+}
+
 //____________________________________________________________________
 void
 AliFMDEnergyFitter::RingHistos::Scale(TH1* dist) const
@@ -1297,6 +1387,8 @@ AliFMDEnergyFitter::RingHistos::FitHist(TH1*      dist,
   AliLandauGausFitter f(lowCut, maxRange, minusBins); 
   f.Clear();
   f.SetDebug(fDebug > 3); 
+  // TMinuit is not thread-safe, so use Minuit2 for these fits only 
+  if (fNThreads > 1) f.SetMinimizer("Minuit2");
 
   // regularization cut - should be a parameter of the class 
   if (dist->GetEntries() > regCut) { 
@@ -1369,7 +1461,8 @@ AliFMDEnergyFitter::RingHistos::FindBestFit(const TH1* dist,
   TF1*   func  = 0;
   Int_t  i     = 0;
   TIter  next(funcs);
-  fFits.Clear(); // This is only ever used here
+  // Local, since fits of several histograms may be done concurrently
+  TClonesArray fits("AliFMDCorrELossFit::ELossFit", 10);
 
   if (fDebug) printf("Find best fit for %s ... ", dist->GetName());
   if (fDebug > 2) printf("\n");
@@ -1377,7 +1470,7 @@ AliFMDEnergyFitter::RingHistos::FindBestFit(const TH1* dist,
   // Loop over all functions stored in distribution, 
   // and calculate the quality 
   while ((func = static_cast<TF1*>(next()))) { 
-    ELossFit_t* fit = new(fFits[i++]) ELossFit_t(0,*func);
+    ELossFit_t* fit = new(fits[i++]) ELossFit_t(0,*func);
     fit->fDet  = fDet;
     fit->fRing = fRing;
     // fit->fBin  = b;
@@ -1389,11 +1482,11 @@ AliFMDEnergyFitter::RingHistos::FindBestFit(const TH1* dist,
   }
 
   // Sort all the found fit objects in increasing quality 
-  fFits.Sort();
-  if (fDebug > 2) fFits.Print("s");
+  fits.Sort();
+  if (fDebug > 2) fits.Print("s");
 
   // Get the top-most fit
-  ELossFit_t* ret = static_cast<ELossFit_t*>(fFits.At(i-1));
+  ELossFit_t* ret = static_cast<ELossFit_t*>(fits.At(i-1));
   if (!ret) {
     AliWarningF("No fit found for %s", GetName());
     return 0;
@@ -18,7 +18,6 @@
 #include <TAxis.h>
 #include <TList.h>
 #include <TObjArray.h>
-#include <TClonesArray.h>
 #include "AliFMDCorrELossFit.h"
 #include "AliForwardUtil.h"
 #include "AliLandauGaus.h"
@@ -28,6 +27,7 @@ class AliESDFMD;
 class TFitResult;
 class TF1;
 class TArrayD;
+class TArrayI;
 
 /**
  * Class to fit the energy distribution.  
@@ -299,6 +299,25 @@ public:
    * @param use If true, enable extra shift @f$\delta\Delta_p(\sigma/\xi)@f$  
    */
   void SetEnableDeltaShift(Bool_t use=true);
+  /**
+   * Whether to evaluate the Landau-Gauss convolutions from an
+   * interpolated table (see AliLandauGaus::EnableTable).  This makes
+   * the fits considerably faster.
+   *
+   * @param use If true, use the tabulated convolution 
+   */
+  void SetEnableTabulatedLandauGaus(Bool_t use=true);
+  /** 
+   * Set the number of threads used to fit the @f$\Delta@f$
+   * distributions of each ring.  The @f$\eta@f$ bins (and the full
+   * ring distribution) are fitted concurrently.  This requires ROOT 6
+   * and that the application has called ROOT::EnableThreadSafety() -
+   * otherwise the fits are done sequentially.  If @a n is larger than
+   * one, the fits use the Minuit2 minimizer (set per fit, not globally).
+   * 
+   * @param n Number of threads (1 means sequential fits)
+   */
+  void SetNThreads(Int_t n=1) { fNThreads = (n < 1 ? 1 : n); }
 
   /* @} */
   // -----------------------------------------------------------------
@@ -607,6 +626,36 @@ public:
      * 
      * @return Best fit 
      */
+    /** 
+     * Fit a list of histograms with FitHist.  If fNThreads is larger
+     * than one, the histograms are fitted concurrently.
+     * 
+     * @param hists       Histograms to fit (null entries are skipped)
+     * @param results     On return, the best fit of each histogram, or null
+     * @param statuses    On return, the status code of each fit 
+     * @param lowCut      Lower cut @f$ E_{min}@f$ on signal 
+     * @param nParticles  Max number @f$ N@f$ of convolved landaus to fit
+     * @param minEntries  Least number of entries required
+     * @param minusBins   Number of bins @f$ \Delta b@f$ from peak to 
+     *                    subtract to get the fit range 
+     * @param relErrorCut Cut applied to relative error of parameter. 
+     * @param chi2nuCut   Cut on @f$ \chi^2/\nu@f$ 
+     * @param minWeight   Least weight ot consider
+     * @param regCut      Regularization cut-off
+     * @param scaleToPeak If true, scale distribution to peak value
+     */
+    void FitHists(const TObjArray& hists,
+		  TObjArray&       results, 
+		  TArrayI&         statuses,
+		  Double_t         lowCut, 
+		  UShort_t         nParticles,
+		  UShort_t         minEntries,
+		  UShort_t         minusBins,
+		  Double_t         relErrorCut, 
+		  Double_t         chi2nuCut,
+		  Double_t         minWeight,
+		  Double_t         regCut,
+		  Bool_t           scaleToPeak) const;
     virtual ELossFit_t* FindBestFit(const TH1* dist,
 				    Double_t   relErrorCut, 
 				    Double_t   chi2nuCut,
@@ -677,9 +726,9 @@ public:
     // TList*               fEtaEDists; // Energy distributions per eta bin. 
     TList*               fList;
     mutable TObjArray    fBest;
-    mutable TClonesArray fFits;
     Int_t                fDebug;
-    ClassDef(RingHistos,4);
+    Int_t                fNThreads;  // Number of threads for the fits
+    ClassDef(RingHistos,6);
   };
 protected:
   /** 
@@ -750,8 +799,9 @@ protected:
   EResidualMethod fResidualMethod;    // Whether to store residuals (debugging)
   UShort_t        fSkips;             // Rings to skip when fitting 
   Double_t        fRegularizationCut; // When to regularize the chi^2
+  Int_t           fNThreads;          // Number of threads for the fits
 
-  ClassDef(AliFMDEnergyFitter,8); //
+  ClassDef(AliFMDEnergyFitter,9); //
 };
 
 #endif
@@ -19,6 +19,13 @@
 #include <TArray.h>
 #include <TFitResult.h>
 #include <TError.h>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+# include <HFitInterface.h>
+# include <Foption.h>
+# include <Fit/DataRange.h>
+# include <Math/MinimizerOptions.h>
+#endif
 
 /**
  * Fit Landau-Gauss distributions to energy loss distributions 
@@ -65,7 +72,7 @@ public:
    */
   AliLandauGausFitter(Double_t lowCut, Double_t maxRange, UShort_t minusBins)
     : fLowCut(lowCut), fMaxRange(maxRange), fMinusBins(minusBins), 
-      fFitResults(0), fFunctions(0), fDebug(false) 
+      fFitResults(0), fFunctions(0), fDebug(false), fMinimizer("")
   {
     fFitResults.SetOwner();
     fFunctions.SetOwner();
@@ -85,6 +92,15 @@ public:
    * @param debug If true, enable debugging output
    */
   void SetDebug(Bool_t debug=true) { fDebug = debug; }
+  /** 
+   * Set the minimizer used by the fits of this object only (e.g.,
+   * "Minuit2").  If empty, the ROOT default minimizer is used.  The
+   * global default is not changed.  Requires ROOT 6 - ignored
+   * otherwise.
+   * 
+   * @param minimizer Minimizer type 
+   */
+  void SetMinimizer(const char* minimizer) { fMinimizer = minimizer; }
   /** 
    * Clear internal arrays
    * 
@@ -199,12 +215,40 @@ protected:
 	     f->GetParName(iPar), test, low, high);
     f->SetParLimits(iPar, low, high);
   }
+  /** 
+   * Fit the function @a f to @a dist in the range @f$[min,max]@f$.
+   * This is like TH1::Fit, but uses fMinimizer if set.
+   * 
+   * @param dist  Distribution to fit to 
+   * @param f     Function to fit 
+   * @param opts  Fit options 
+   * @param min   Least value 
+   * @param max   Largest value 
+   * 
+   * @return The fit result 
+   */
+  TFitResultPtr DoFit(TH1* dist, TF1* f, const char* opts, 
+		      Double_t min, Double_t max)
+  {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+    if (!fMinimizer.IsNull()) {
+      Foption_t fitOption;
+      ROOT::Fit::FitOptionsMake(ROOT::Fit::kHistogram, opts, fitOption);
+      ROOT::Math::MinimizerOptions minOption;
+      minOption.SetMinimizerType(fMinimizer.Data());
+      ROOT::Fit::DataRange range(min, max);
+      return ROOT::Fit::FitObject(dist, f, fitOption, minOption, "", range);
+    }
+#endif
+    return dist->Fit(f, opts, "", min, max);
+  }
   const Double_t fLowCut;     // Lower cut on data 
   const Double_t fMaxRange;   // Maximum range to fit 
   const UShort_t fMinusBins;  // Number of bins from maximum to fit 1st peak
   TObjArray fFitResults;      // Array of fit results 
   TObjArray fFunctions;       // Array of functions 
   Bool_t    fDebug;           // Debug flag
+  TString   fMinimizer;       // Minimizer of our fits (empty: default)
 };
 
 
@@ -261,7 +305,7 @@ AliLandauGausFitter::Fit1Particle(TH1* dist, Double_t sigman)
   // Do the fit, getting the result object 
   if (fDebug) 
     ::Info(/*"Fit1Particle"*/"", "Fitting in the range %f,%f", minE, maxE);
-  TFitResultPtr r = dist->Fit(f, opts, "", minE, maxE);
+  TFitResultPtr r = DoFit(dist, f, opts, minE, maxE);
   if (!r.Get()) { 
     ::Warning("Fit1Particle", 
 	      "No fit returned when processing %s in the range [%f,%f] "
@@ -335,7 +379,7 @@ AliLandauGausFitter::FitNParticle(TH1* dist, UShort_t n, Double_t sigman)
   if (fDebug) 
     ::Info(/*"FitNParticle"*/"", 
 	   "Fitting in the range %f,%f (%d)", minE, maxEi, n);
-  TFitResultPtr tr = dist->Fit(f, opts, "", minE, maxEi);
+  TFitResultPtr tr = DoFit(dist, f, opts, minE, maxEi);
   
   // f->SetRange(minE, fMaxRange);
   fFitResults.AddAtAndExpand(new TFitResult(*tr), n-1);
@@ -390,7 +434,7 @@ AliLandauGausFitter::FitComposite(TH1* dist, Double_t sigman)
   // Do the fit, getting the result object 
   if (fDebug) 
     ::Info(/*"FitComposite"*/"", "Fitting seed in the range %f,%f", minE, maxE);
-  /* TFitResultPtr r = */ dist->Fit(seed, GetFitOptions(), "", minE, maxE);
+  /* TFitResultPtr r = */ DoFit(dist, seed, GetFitOptions(), minE, maxE);
 
   maxE = dist->GetXaxis()->GetXmax();
   TF1* comp = 
@@ -414,7 +458,7 @@ AliLandauGausFitter::FitComposite(TH1* dist, Double_t sigman)
   TString opts(Form("%s%s", GetFitOptions(), fDebug ? "" : "Q"));
   if (fDebug) 
     ::Info("FitComposite", "Fitting composite in the range %f,%f", minE, maxE);
-  /* TFitResultPtr r = */ dist->Fit(comp, opts, "", minE, maxE);
+  /* TFitResultPtr r = */ DoFit(dist, comp, opts, minE, maxE);
 
 #if 0
   // This is to store the two components with the output
@@ -14,6 +14,7 @@
 //
 
 #include <Riostream.h>
+#include <algorithm>
 
 #include <TH1.h>
 #include <TList.h>
@@ -48,6 +49,36 @@
 
 #include "AliRsnMiniAnalysisTask.h"
 
+namespace {
+   // orders events by vertex z (continuous mixing)
+   struct MixKeyLess {
+      MixKeyLess(const std::vector<Float_t> &vz) : fVz(vz) {}
+      Bool_t operator()(Int_t i, Int_t j) const {return fVz[i] < fVz[j];}
+      const std::vector<Float_t> &fVz;
+   };
+   // orders events by mixing bin (binned mixing)
+   struct MixBinLess {
+      MixBinLess(const std::vector<Float_t> &vz, const std::vector<Float_t> &mult, const std::vector<Float_t> &angle,
+                 Double_t dvz, Double_t dmult, Double_t dangle) :
+         fVz(vz), fMult(mult), fAngle(angle), fDVz(dvz), fDMult(dmult), fDAngle(dangle) {}
+      Bool_t operator()(Int_t i, Int_t j) const {
+         Int_t bi = (Int_t)(fVz[i] / fDVz), bj = (Int_t)(fVz[j] / fDVz);
+         if (bi != bj) return bi < bj;
+         bi = (Int_t)(fMult[i] / fDMult); bj = (Int_t)(fMult[j] / fDMult);
+         if (bi != bj) return bi < bj;
+         return (Int_t)(fAngle[i] / fDAngle) < (Int_t)(fAngle[j] / fDAngle);
+      }
+      const std::vector<Float_t> &fVz, &fMult, &fAngle;
+      Double_t fDVz, fDMult, fDAngle;
+   };
+   // orders events as they come when looping from the event following 'main' (restarting from the first one)
+   struct MixOrderLess {
+      MixOrderLess(Int_t main, Int_t n) : fMain(main), fN(n) {}
+      Bool_t operator()(Int_t i, Int_t j) const {return (i - fMain + fN) % fN < (j - fMain + fN) % fN;}
+      Int_t fMain, fN;
+   };
+}
+
 
 ClassImp(AliRsnMiniAnalysisTask)
 
@@ -90,6 +121,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fMiniEvent(0x0),
    fBigOutput(kFALSE),
    fMixPrintRefresh(-1),
+   fMixBlockSize(100),
    fMaxNDaughters(-1),
    fCheckP(kFALSE),
    fCheckFeedDown(kFALSE),   
@@ -145,6 +177,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC) :
    fMiniEvent(0x0),
    fBigOutput(kFALSE),
    fMixPrintRefresh(-1),
+   fMixBlockSize(100),
    fMaxNDaughters(-1),
    fCheckP(kFALSE),
    fCheckFeedDown(kFALSE),   
@@ -205,6 +238,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fMiniEvent(0x0),
    fBigOutput(copy.fBigOutput),
    fMixPrintRefresh(copy.fMixPrintRefresh),
+   fMixBlockSize(copy.fMixBlockSize),
    fMaxNDaughters(copy.fMaxNDaughters),
    fCheckP(copy.fCheckP),
    fCheckFeedDown(copy.fCheckFeedDown),   
@@ -267,6 +301,7 @@ AliRsnMiniAnalysisTask &AliRsnMiniAnalysisTask::operator=(const AliRsnMiniAnalys
    fESDtrackCuts = copy.fESDtrackCuts;
    fBigOutput = copy.fBigOutput;
    fMixPrintRefresh = copy.fMixPrintRefresh;
+   fMixBlockSize = copy.fMixBlockSize;
    fMaxNDaughters = copy.fMaxNDaughters;
    fCheckP = copy.fCheckP;
    fCheckFeedDown = copy.fCheckFeedDown;
@@ -495,10 +530,16 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    // using the appropriate procedure depending on its type
    // only mother-related histograms are filled in UserExec,
    // since they require direct access to MC event
+   // the mixing keys of each event are stored on the way,
+   // so that the search for mixing partners does not need to read the buffer
+   std::vector<Float_t> mixVz(nEvents), mixMult(nEvents), mixAngle(nEvents);
    timer.Start();
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
       fEvBuffer->GetEntry(ievt);
+      mixVz[ievt]    = fMiniEvent->Vz();
+      mixMult[ievt]  = fMiniEvent->Mult();
+      mixAngle[ievt] = fMiniEvent->Angle();
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
@@ -548,82 +589,106 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       return;
    }
 
-   // initialize mixing counter
-   Int_t    nmatched[nEvents];
-   TString *smatched = new TString[nEvents];
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      smatched[ievt] = "|";
-      nmatched[ievt] = 0;
+   // initialize mixing counter:
+   // the partners found when searching for the matches of an event are stored
+   // in its own slice of 'partners', while 'nmatched' counts the mixings of each event
+   // (as a main or as a partner of another event)
+   std::vector<Int_t> nmatched(nEvents, 0);
+   std::vector<Int_t> npartners(nEvents, 0);
+   std::vector<Int_t> partners((Long64_t)nEvents * fNMix);
+
+   // sorted index of the mixing keys, used to find the candidates of each event with a range query
+   std::vector<Int_t> index(nEvents);
+   for (ievt = 0; ievt < nEvents; ievt++) index[ievt] = ievt;
+   if (fContinuousMix) {
+      std::stable_sort(index.begin(), index.end(), MixKeyLess(mixVz));
+   } else {
+      std::stable_sort(index.begin(), index.end(), MixBinLess(mixVz, mixMult, mixAngle, fMaxDiffVz, fMaxDiffMult, fMaxDiffAngle));
    }
 
-
    AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
    timer.Stop(); timer.Print(); timer.Start(); fflush(stdout);
 
    // search for good matchings
+   // candidates are checked in the same order as a loop on the following events (restarting from the first one)
+   std::vector<Int_t> candidates;
+   Int_t icand, *mainPartners, *mixPartners;
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
       if (nmatched[ievt] >= fNMix) continue;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      for (iloop = 1; iloop < nEvents; iloop++) {
-         imix = ievt + iloop;
-         if (imix >= nEvents) imix -= nEvents;
-         if (imix == ievt) continue;
-         // text next entry
-         fEvBuffer->GetEntry(imix);
-         // skip if events are not matched
-         if (!EventsMatch(&evMain, fMiniEvent)) continue;
+      FindMixCandidates(ievt, mixVz, mixMult, mixAngle, index, candidates);
+      mainPartners = &partners[(Long64_t)ievt * fNMix];
+      for (icand = 0; icand < (Int_t)candidates.size(); icand++) {
+         imix = candidates[icand];
          // check that the array of good matches for mixed does not already contain main event
-         if (smatched[imix].Contains(Form("|%d|", ievt))) continue;
+         mixPartners = &partners[(Long64_t)imix * fNMix];
+         for (iloop = 0; iloop < npartners[imix]; iloop++) if (mixPartners[iloop] == ievt) break;
+         if (iloop < npartners[imix]) continue;
          // check that the found good events has not enough matches already
          if (nmatched[imix] >= fNMix) continue;
          // add new mixing candidate
-         smatched[ievt].Append(Form("%d|", imix));
+         mainPartners[npartners[ievt]++] = imix;
          nmatched[ievt]++;
          nmatched[imix]++;
          if (nmatched[ievt] >= fNMix) break;
       }
-      AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", evMain.ID(), nmatched[ievt], smatched[ievt].Data()));
+      AliDebugClass(1, Form("Matches for event %5d = %d (%d found from this event)", ievt, nmatched[ievt], npartners[ievt]));
    }
 
    AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
 
    // perform mixing
-   TObjArray *list = 0x0;
-   TObjString *os = 0x0;
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      if (printNum&&(ievt%printNum==0)) {
-         AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
-         timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
+   // the events are processed in blocks : the mini-events needed by a block
+   // (main events and their partners) are read once, in the order of the buffer
+   Int_t blockSize = TMath::Max(fMixBlockSize, 1);
+   Int_t iblock, ilast, nLoaded;
+   std::vector<Int_t> loaded;
+   std::vector<AliRsnMiniEvent*> cache;
+   AliRsnMiniEvent *evMain = 0x0, *evMix = 0x0;
+   for (iblock = 0; iblock < nEvents; iblock += blockSize) {
+      ilast = TMath::Min(iblock + blockSize, nEvents);
+      loaded.clear();
+      for (ievt = iblock; ievt < ilast; ievt++) {
+         loaded.push_back(ievt);
+         for (iloop = 0; iloop < npartners[ievt]; iloop++) loaded.push_back(partners[(Long64_t)ievt * fNMix + iloop]);
       }
-      ifill = 0;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      list = smatched[ievt].Tokenize("|");
-      TObjArrayIter next(list);
-      while ( (os = (TObjString *)next()) ) {
-         imix = os->GetString().Atoi();
-         fEvBuffer->GetEntry(imix);
-         for (idef = 0; idef < nDefs; idef++) {
-            def = (AliRsnMiniOutput *)fHistograms[idef];
-            if (!def) continue;
-            if (!def->IsTrackPairMix()) continue;
-            ifill += def->FillPair(&evMain, fMiniEvent, &fValues, kTRUE);
-            if (!def->IsSymmetric()) {
-               AliDebugClass(2, "Reflecting non symmetric pair");
-               ifill += def->FillPair(fMiniEvent, &evMain, &fValues, kFALSE);
+      std::sort(loaded.begin(), loaded.end());
+      loaded.erase(std::unique(loaded.begin(), loaded.end()), loaded.end());
+      nLoaded = loaded.size();
+      while ((Int_t)cache.size() < nLoaded) cache.push_back(new AliRsnMiniEvent);
+      for (iloop = 0; iloop < nLoaded; iloop++) {
+         fEvBuffer->GetEntry(loaded[iloop]);
+         *cache[iloop] = *fMiniEvent;
+      }
+
+      for (ievt = iblock; ievt < ilast; ievt++) {
+         if (printNum&&(ievt%printNum==0)) {
+            AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
+            timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
+         }
+         ifill = 0;
+         evMain = cache[std::lower_bound(loaded.begin(), loaded.end(), ievt) - loaded.begin()];
+         for (icand = 0; icand < npartners[ievt]; icand++) {
+            imix = partners[(Long64_t)ievt * fNMix + icand];
+            evMix = cache[std::lower_bound(loaded.begin(), loaded.end(), imix) - loaded.begin()];
+            for (idef = 0; idef < nDefs; idef++) {
+               def = (AliRsnMiniOutput *)fHistograms[idef];
+               if (!def) continue;
+               if (!def->IsTrackPairMix()) continue;
+               ifill += def->FillPair(evMain, evMix, &fValues, kTRUE);
+               if (!def->IsSymmetric()) {
+                  AliDebugClass(2, "Reflecting non symmetric pair");
+                  ifill += def->FillPair(evMix, evMain, &fValues, kFALSE);
+               }
             }
          }
       }
-      delete list;
    }
-
-   delete [] smatched;
+   for (iloop = 0; iloop < (Int_t)cache.size(); iloop++) delete cache[iloop];
 
    AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout);
@@ -1418,13 +1483,23 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
 //
 
    if (!event1 || !event2) return kFALSE;
+   return KeysMatch(event1->Vz(), event1->Mult(), event1->Angle(), event2->Vz(), event2->Mult(), event2->Angle());
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::KeysMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2) const
+{
+//
+// Same as EventsMatch(), from the mixing keys (vz, mult and angle) of the two events.
+//
+
    Int_t ivz1, ivz2, imult1, imult2, iangle1, iangle2;
    Double_t dv, dm, da;
 
    if (fContinuousMix) {
-      dv = TMath::Abs(event1->Vz()    - event2->Vz()   );
-      dm = TMath::Abs(event1->Mult()  - event2->Mult() );
-      da = TMath::Abs(event1->Angle() - event2->Angle());
+      dv = TMath::Abs(vz1    - vz2   );
+      dm = TMath::Abs(mult1  - mult2 );
+      da = TMath::Abs(angle1 - angle2);
       if (dv > fMaxDiffVz) {
          //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Vz = %f", event1->ID(), event2->ID(), dv));
          return kFALSE;
@@ -1439,12 +1514,12 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
       }
       return kTRUE;
    } else {
-      ivz1 = (Int_t)(event1->Vz() / fMaxDiffVz);
-      ivz2 = (Int_t)(event2->Vz() / fMaxDiffVz);
-      imult1 = (Int_t)(event1->Mult() / fMaxDiffMult);
-      imult2 = (Int_t)(event2->Mult() / fMaxDiffMult);
-      iangle1 = (Int_t)(event1->Angle() / fMaxDiffAngle);
-      iangle2 = (Int_t)(event2->Angle() / fMaxDiffAngle);
+      ivz1 = (Int_t)(vz1 / fMaxDiffVz);
+      ivz2 = (Int_t)(vz2 / fMaxDiffVz);
+      imult1 = (Int_t)(mult1 / fMaxDiffMult);
+      imult2 = (Int_t)(mult2 / fMaxDiffMult);
+      iangle1 = (Int_t)(angle1 / fMaxDiffAngle);
+      iangle2 = (Int_t)(angle2 / fMaxDiffAngle);
       if (ivz1 != ivz2) return kFALSE;
       if (imult1 != imult2) return kFALSE;
       if (iangle1 != iangle2) return kFALSE;
@@ -1452,6 +1527,46 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
    }
 }
 
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::FindMixCandidates(Int_t ievt, const std::vector<Float_t> &vz, const std::vector<Float_t> &mult, const std::vector<Float_t> &angle,
+                                               const std::vector<Int_t> &index, std::vector<Int_t> &candidates) const
+{
+//
+// Fills the list of events matching event 'ievt', from the index of the events sorted by
+// mixing key (vertex z for continuous mixing, bin for binned mixing).
+// They are ordered as in a loop starting from the event following 'ievt' and restarting from the first one.
+//
+
+   candidates.clear();
+   Int_t nEvents = vz.size();
+
+   if (fContinuousMix) {
+      // range in vertex z, enlarged to be safe against rounding: the exact check is done by KeysMatch()
+      Double_t margin = 1E-6 * TMath::Abs(fMaxDiffVz);
+      Double_t vzMin = vz[ievt] - fMaxDiffVz - margin;
+      Double_t vzMax = vz[ievt] + fMaxDiffVz + margin;
+      Int_t lo = 0, hi = nEvents, mid;
+      while (lo < hi) {
+         mid = (lo + hi) / 2;
+         if (vz[index[mid]] < vzMin) lo = mid + 1; else hi = mid;
+      }
+      for (Int_t i = lo; i < nEvents && vz[index[i]] <= vzMax; i++) {
+         Int_t imix = index[i];
+         if (imix == ievt) continue;
+         if (!KeysMatch(vz[ievt], mult[ievt], angle[ievt], vz[imix], mult[imix], angle[imix])) continue;
+         candidates.push_back(imix);
+      }
+      std::sort(candidates.begin(), candidates.end(), MixOrderLess(ievt, nEvents));
+   } else {
+      // events of the same bin are contiguous in the index, sorted by event number
+      std::pair<std::vector<Int_t>::const_iterator, std::vector<Int_t>::const_iterator> bin =
+         std::equal_range(index.begin(), index.end(), ievt, MixBinLess(vz, mult, angle, fMaxDiffVz, fMaxDiffMult, fMaxDiffAngle));
+      std::vector<Int_t>::const_iterator self = std::lower_bound(bin.first, bin.second, ievt);
+      candidates.insert(candidates.end(), self + 1, bin.second);
+      candidates.insert(candidates.end(), bin.first, self);
+   }
+}
+
 //---------------------------------------------------------------------
 Double_t AliRsnMiniAnalysisTask::ApplyCentralityPatchPbPb2011(){
   //This part rejects randomly events such that the centrality gets flat for LHC11h Pb-Pb data